@@ -1507,6 +1507,107 @@ QVariantList GetVariants(ResourceFormat format, const ShaderVariableDescriptor &
   return ret;
 }
 
+int GetFloatVector(const ResourceFormat &format, const ShaderVariableDescriptor &varDesc,
+                   const byte *data, const byte *end, float out[4])
+{
+  // only simple vector layouts of regular formats are handled here - packed formats and matrices
+  // take the generic QVariant path above.
+  if(format.type != ResourceFormatType::Regular || varDesc.rows > 1)
+    return -1;
+
+  const int compCount = qMin(qMax((int)varDesc.columns, 1), 4);
+  const uint32_t byteWidth = format.compByteWidth;
+
+  // an element that reads off the end of the data decodes to nothing, as in GetVariants
+  if(data + compCount * byteWidth > end)
+    return 0;
+
+  for(int comp = 0; comp < compCount; comp++)
+  {
+    const byte *src = data + comp * byteWidth;
+
+    switch(format.compType)
+    {
+      case CompType::Float:
+        if(byteWidth == 8)
+          out[comp] = (float)*(const double *)src;
+        else if(byteWidth == 4)
+          out[comp] = *(const float *)src;
+        else if(byteWidth == 2)
+          out[comp] = RENDERDOC_HalfToFloat(*(const uint16_t *)src);
+        else
+          return -1;
+        break;
+      case CompType::Double:
+        if(byteWidth != 8)
+          return -1;
+        out[comp] = (float)*(const double *)src;
+        break;
+      case CompType::SInt:
+      case CompType::SScaled:
+        if(byteWidth == 8)
+          out[comp] = (float)*(const int64_t *)src;
+        else if(byteWidth == 4)
+          out[comp] = (float)*(const int32_t *)src;
+        else if(byteWidth == 2)
+          out[comp] = (float)*(const int16_t *)src;
+        else if(byteWidth == 1)
+          out[comp] = (float)*(const int8_t *)src;
+        else
+          return -1;
+        break;
+      case CompType::UInt:
+      case CompType::UScaled:
+        if(byteWidth == 8)
+          out[comp] = (float)*(const uint64_t *)src;
+        else if(byteWidth == 4)
+          out[comp] = (float)*(const uint32_t *)src;
+        else if(byteWidth == 2)
+          out[comp] = (float)*(const uint16_t *)src;
+        else if(byteWidth == 1)
+          out[comp] = (float)*(const uint8_t *)src;
+        else
+          return -1;
+        break;
+      case CompType::UNorm:
+      case CompType::UNormSRGB:
+        if(byteWidth == 2)
+          out[comp] = (float)*(const uint16_t *)src / (float)0xffff;
+        else if(byteWidth == 1)
+          out[comp] = (float)*(const uint8_t *)src / 255.0f;
+        else
+          return -1;
+        break;
+      case CompType::SNorm:
+        if(byteWidth == 2)
+        {
+          int16_t cast = *(const int16_t *)src;
+          out[comp] = cast == -32768 ? -1.0f : (float)cast / 32767.0f;
+        }
+        else if(byteWidth == 1)
+        {
+          int8_t cast = *(const int8_t *)src;
+          out[comp] = cast == -128 ? -1.0f : (float)cast / 127.0f;
+        }
+        else
+        {
+          return -1;
+        }
+        break;
+      default: return -1;
+    }
+  }
+
+  if(format.BGRAOrder() && compCount >= 3)
+  {
+    float tmp = out[2];
+    out[2] = out[0];
+    out[0] = tmp;
+  }
+
+  return compCount;
+}
+
 QString TypeString(const ShaderVariable &v)
 {
   if(!v.members.isEmpty() || v.isStruct)
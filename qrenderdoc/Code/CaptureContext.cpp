@@ -751,24 +751,36 @@ void CaptureContext::LoadCapture(const rdcstr &captureFile, const ReplayOptions
     else if(!m_Drawcalls->empty())
       SetEventID(viewers, m_Drawcalls->back().eventId, m_Drawcalls->back().eventId, true);
 
-    GUIInvoke::blockcall(m_MainWindow, [&viewers]() {
-      // notify all the registers viewers that a capture has been loaded
-      for(ICaptureViewer *viewer : viewers)
-      {
-        if(viewer)
-          viewer->OnCaptureLoaded();
-      }
-    });
-
-    if(newCapture && m_Notes.contains(lit("comments")) && m_Config.Comments_ShowOnLoad)
+    // notify each registered viewer in its own deferred invoke rather than all in one block. The
+    // UI processes events between them, so the first windows populated - typically the event
+    // browser - appear and paint while later ones are still filling in.
+    for(ICaptureViewer *viewer : viewers)
     {
-      if(!HasCommentView())
-        ShowCommentView();
-      RaiseDockWindow(GetCommentView()->Widget());
+      GUIInvoke::defer(m_MainWindow, [this, viewer]() {
+        // the capture might have been closed or the viewer destroyed while this was queued
+        if(!m_CaptureLoaded || !viewer || !m_CaptureViewers.contains(viewer))
+          return;
+
+        viewer->OnCaptureLoaded();
+      });
     }
 
-    // refresh the UI without forcing the replay
-    SetEventID({}, m_SelectedEventID, m_EventID, false);
+    // queued behind the viewer notifications above, so the UI is fully up to date by the time
+    // this refresh happens.
+    GUIInvoke::defer(m_MainWindow, [this, newCapture]() {
+      if(!m_CaptureLoaded)
+        return;
+
+      if(newCapture && m_Notes.contains(lit("comments")) && m_Config.Comments_ShowOnLoad)
+      {
+        if(!HasCommentView())
+          ShowCommentView();
+        RaiseDockWindow(GetCommentView()->Widget());
+      }
+
+      // refresh the UI without forcing the replay
+      SetEventID({}, m_SelectedEventID, m_EventID, false);
+    });
   }
 }
 
@@ -900,8 +912,6 @@ void CaptureContext::LoadCaptureThreaded(const QString &captureFile, const Repla
     m_CurWinSystem = WindowingSystem::MacOS;
 #endif
 
-    m_StructuredFile = &r->GetStructuredFile();
-
     m_ResourceList = r->GetResources();
 
     CacheResources();
@@ -993,11 +1003,27 @@ void CaptureContext::CacheResources()
 
   m_Resources.clear();
 
-  std::sort(m_ResourceList.begin(), m_ResourceList.end(),
-            [this](const ResourceDescription &a, const ResourceDescription &b) {
-              return GetResourceNameUnsuffixed(&a) < GetResourceNameUnsuffixed(&b);
+  // sort on names computed once up front - formatting them inside the comparator would redo the
+  // name lookup O(N log N) times over the whole resource list on every capture open and rename
+  rdcarray<rdcpair<rdcstr, size_t>> keys;
+  keys.reserve(m_ResourceList.size());
+
+  for(size_t i = 0; i < m_ResourceList.size(); i++)
+    keys.push_back(make_rdcpair(GetResourceNameUnsuffixed(&m_ResourceList[i]), i));
+
+  std::sort(keys.begin(), keys.end(),
+            [](const rdcpair<rdcstr, size_t> &a, const rdcpair<rdcstr, size_t> &b) {
+              return a.first < b.first;
             });
 
+  rdcarray<ResourceDescription> sortedList;
+  sortedList.reserve(m_ResourceList.size());
+
+  for(const rdcpair<rdcstr, size_t> &k : keys)
+    sortedList.push_back(m_ResourceList[k.second]);
+
+  m_ResourceList.swap(sortedList);
+
   for(ResourceDescription &res : m_ResourceList)
     m_Resources[res.resourceId] = &res;
 }
@@ -1262,6 +1288,7 @@ void CaptureContext::CloseCapture()
   m_ResourceList.clear();
 
   m_CustomNames.clear();
+  m_ResourceNameCache.clear();
   m_Bookmarks.clear();
   m_Notes.clear();
 
@@ -1366,7 +1393,7 @@ void CaptureContext::ExportCapture(const CaptureFileFormat &fmt, const rdcstr &e
   if(!fmt.requiresBuffers)
   {
     file = m_Replay.GetCaptureFile();
-    sdfile = m_StructuredFile;
+    sdfile = &GetStructuredFile();
   }
 
   if(!file)
@@ -1515,6 +1542,20 @@ void CaptureContext::RefreshUIStatus(const rdcarray<ICaptureViewer *> &exclude,
   }
 }
 
+const SDFile &CaptureContext::GetStructuredFile()
+{
+  // fetched on demand rather than at load. For remote replays this pulls the whole structured
+  // file across the network, which can run to gigabytes, and many sessions never open a raw
+  // chunk view - so only the first caller pays for it.
+  if(m_StructuredFile == &m_DummySDFile && m_CaptureLoaded)
+  {
+    m_Replay.BlockInvoke(
+        [this](IReplayController *r) { m_StructuredFile = &r->GetStructuredFile(); });
+  }
+
+  return *m_StructuredFile;
+}
+
 void CaptureContext::AddMessages(const rdcarray<DebugMessage> &msgs)
 {
   m_UnreadMessageCount += msgs.count();
@@ -1792,19 +1833,53 @@ bool CaptureContext::OpenRGPProfile(const rdcstr &filename)
   return true;
 }
 
-rdcstr CaptureContext::GetResourceNameUnsuffixed(ResourceId id)
+const QPair<rdcstr, rdcstr> &CaptureContext::CachedResourceName(ResourceId id)
 {
+  // any rename, shader edit or resource list update bumps the cache ID, throw the whole cache
+  // away and rebuild lazily
+  if(m_ResourceNameCacheID != m_CustomNameCachedID)
+  {
+    m_ResourceNameCacheID = m_CustomNameCachedID;
+    m_ResourceNameCache.clear();
+  }
+
+  auto it = m_ResourceNameCache.find(id);
+  if(it != m_ResourceNameCache.end())
+    return it.value();
+
+  rdcstr unsuffixed;
+
   if(id == ResourceId())
-    return tr("No Resource");
+  {
+    unsuffixed = tr("No Resource");
+  }
+  else
+  {
+    ResourceDescription *desc = GetResource(id);
 
-  ResourceDescription *desc = GetResource(id);
+    if(desc)
+    {
+      unsuffixed = GetResourceNameUnsuffixed(desc);
+    }
+    else
+    {
+      uint64_t num;
+      memcpy(&num, &id, sizeof(num));
+      unsuffixed = tr("Unknown Resource %1").arg(num);
+    }
+  }
 
-  if(desc)
-    return GetResourceNameUnsuffixed(desc);
+  rdcstr suffixed = unsuffixed;
 
-  uint64_t num;
-  memcpy(&num, &id, sizeof(num));
-  return tr("Unknown Resource %1").arg(num);
+  if(m_ReplacedResources.contains(id))
+    suffixed += tr(" (Edited)");
+
+  return *m_ResourceNameCache.insert(id, qMakePair(unsuffixed, suffixed));
+}
+
+rdcstr CaptureContext::GetResourceNameUnsuffixed(ResourceId id)
+{
+  return CachedResourceName(id).first;
 }
 
 rdcstr CaptureContext::GetResourceNameUnsuffixed(const ResourceDescription *desc)
@@ -1817,12 +1892,7 @@ rdcstr CaptureContext::GetResourceNameUnsuffixed(const ResourceDescription *desc
 
 rdcstr CaptureContext::GetResourceName(ResourceId id)
 {
-  rdcstr ret = GetResourceNameUnsuffixed(id);
-
-  if(m_ReplacedResources.contains(id))
-    ret += tr(" (Edited)");
-
-  return ret;
+  return CachedResourceName(id).second;
 }
 
 bool CaptureContext::IsAutogeneratedName(ResourceId id)
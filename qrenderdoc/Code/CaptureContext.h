@@ -174,7 +174,7 @@ public:
   {
     return GetDrawcall(*m_Drawcalls, eventId);
   }
-  const SDFile &GetStructuredFile() override { return *m_StructuredFile; }
+  const SDFile &GetStructuredFile() override;
   WindowingSystem CurWindowingSystem() override { return m_CurWinSystem; }
   WindowingData CreateWindowingData(QWidget *window) override;
 
@@ -305,6 +305,7 @@ private:
 
   void CacheResources();
   rdcstr GetResourceNameUnsuffixed(const ResourceDescription *desc);
+  const QPair<rdcstr, rdcstr> &CachedResourceName(ResourceId id);
 
   float m_LoadProgress = 0.0f;
   float m_PostloadProgress = 0.0f;
@@ -364,6 +365,12 @@ private:
   QMap<ResourceId, QString> m_CustomNames;
   int m_CustomNameCachedID = 1;
 
+  // pre-built (unsuffixed, suffixed) resource names, filled lazily and thrown away wholesale
+  // whenever m_CustomNameCachedID changes, so name lookups on paint hot paths don't rebuild
+  // strings every call
+  QMap<ResourceId, QPair<rdcstr, rdcstr>> m_ResourceNameCache;
+  int m_ResourceNameCacheID = 0;
+
   QVector<ResourceId> m_ReplacedResources;
 
   const SDFile *m_StructuredFile = NULL;
@@ -654,7 +654,8 @@ struct IPixelHistoryView
       "QWidget.");
   virtual QWidget *Widget() = 0;
 
-  DOCUMENT(R"(Set the history displayed in this window.
+  DOCUMENT(R"(Add history events to display in this window. Results can be delivered
+incrementally as they are resolved - each call appends to any previously set history.
 
 :param list history: A list of :class:`~renderdoc.PixelModification` events to display.
 )");
@@ -2076,6 +2077,10 @@ data.
 )");
 rdcstr configFilePath(const rdcstr &filename);
 
-// simple helper for the common case of 'we just need to run this on the replay thread'
-#define INVOKE_MEMFN(function) \
-  m_Ctx.Replay().AsyncInvoke([this](IReplayController *r) { function(r); });
+// simple helper for the common case of 'we just need to run this on the replay thread'. The
+// invoke is tagged with the function and instance so that if the same update is queued again
+// before the replay thread has got to it - e.g. while scrubbing quickly through events - the
+// stale queued copy is dropped and only the newest runs.
+#define INVOKE_MEMFN(function)                                                         \
+  m_Ctx.Replay().AsyncInvoke(QStringLiteral(#function ":%1").arg((qulonglong)(quintptr)this), \
+                             [this](IReplayController *r) { function(r); });
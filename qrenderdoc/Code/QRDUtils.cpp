@@ -42,6 +42,7 @@
 #include <QProcess>
 #include <QProgressBar>
 #include <QProgressDialog>
+#include <QPushButton>
 #include <QRegularExpression>
 #include <QRegularExpressionMatch>
 #include <QStandardPaths>
@@ -1969,6 +1970,18 @@ public:
   }
 
   void setPercentage(float percent) { setValue(int(maxProgress * percent)); }
+  void setCancellable(std::function<void()> callback)
+  {
+    m_CancelCallback = callback;
+
+    // the button is owned and deleted by the dialog
+    setCancelButton(new QPushButton(tr("Cancel"), this));
+
+    QObject::connect(this, &QProgressDialog::canceled, [this]() {
+      if(m_CancelCallback)
+        m_CancelCallback();
+    });
+  }
   void setInfinite(bool infinite)
   {
     if(infinite)
@@ -1995,13 +2008,15 @@ public:
 protected:
   void keyPressEvent(QKeyEvent *e) override
   {
-    if(e->key() == Qt::Key_Escape)
+    // swallow escape, unless the operation is cancellable in which case it cancels as normal
+    if(e->key() == Qt::Key_Escape && !m_CancelCallback)
       return;
 
     QProgressDialog::keyPressEvent(e);
   }
 
   QLabel m_Label;
+  std::function<void()> m_CancelCallback;
 
   static const int maxProgress = 1000;
 };
@@ -2314,7 +2329,7 @@ QStringList ParseArgsList(const QString &args)
 }
 
 void ShowProgressDialog(QWidget *window, const QString &labelText, ProgressFinishedMethod finished,
-                        ProgressUpdateMethod update)
+                        ProgressUpdateMethod update, ProgressCancelMethod cancel)
 {
   if(finished())
     return;
@@ -2324,6 +2339,11 @@ void ShowProgressDialog(QWidget *window, const QString &labelText, ProgressFinis
   // if we don't have an update function, set the progress display to be 'infinite spinner'
   dialog.setInfinite(!update);
 
+  // if the operation can be interrupted, show a cancel button. The callback signals the
+  // operation, which is still responsible for finishing as normal afterwards.
+  if(cancel)
+    dialog.setCancellable(cancel);
+
   QSemaphore tickerSemaphore(1);
 
   // start a lambda thread to tick our functions and close the progress dialog when we're done.
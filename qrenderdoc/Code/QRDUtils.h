@@ -101,6 +101,11 @@ public:
 
 QVariantList GetVariants(ResourceFormat format, const ShaderVariableDescriptor &varDesc,
                          const byte *&data, const byte *end);
+// decodes up to the first four components of a simply-laid-out element straight to floats, for
+// bulk row iteration where the QVariant boxing in GetVariants is too expensive. Returns the
+// number of components written, or -1 if the format needs the generic path.
+int GetFloatVector(const ResourceFormat &format, const ShaderVariableDescriptor &varDesc,
+                   const byte *data, const byte *end, float out[4]);
 ResourceFormat GetInterpretedResourceFormat(const ShaderConstant &elem);
 void SetInterpretedResourceFormat(ShaderConstant &elem, ResourceFormatType interpretType,
                                   CompType interpretCompType);
@@ -666,6 +671,7 @@ class QElapsedTimer;
 
 typedef std::function<float()> ProgressUpdateMethod;
 typedef std::function<bool()> ProgressFinishedMethod;
+typedef std::function<void()> ProgressCancelMethod;
 
 QStringList ParseArgsList(const QString &args);
 bool IsRunningAsAdmin();
@@ -676,7 +682,8 @@ bool RunProcessAsAdmin(const QString &fullExecutablePath, const QStringList &par
 void RevealFilenameInExternalFileBrowser(const QString &filePath);
 
 void ShowProgressDialog(QWidget *window, const QString &labelText, ProgressFinishedMethod finished,
-                        ProgressUpdateMethod update = ProgressUpdateMethod());
+                        ProgressUpdateMethod update = ProgressUpdateMethod(),
+                        ProgressCancelMethod cancel = ProgressCancelMethod());
 
 void UpdateTransferProgress(qint64 xfer, qint64 total, QElapsedTimer *timer,
                             QProgressBar *progressBar, QLabel *progressLabel, QString progressText);
@@ -454,6 +454,14 @@ void ReplayManager::run(int proxyRenderer, const QString &capturefile, const Rep
   m_Running = true;
 
   // main render command loop
+  //
+  // Note for anyone tempted to use the idle time below to speculatively prepare the next/previous
+  // event's state ahead of a single-step in the event browser: the replay has exactly one live
+  // state, so the only way to 'prepare' an adjacent event is a real SetFrameEvent. That either
+  // moves the outputs off the event the user is looking at (they repaint from live state on every
+  // vsync), or - if immediately restored - costs a full backward replay and invalidates the
+  // single-entry overlay/output caches which are keyed on the current event. Until the replay can
+  // checkpoint mid-frame state there's nothing safe to warm here.
   while(m_Running)
   {
     InvokeHandle *cmd = NULL;
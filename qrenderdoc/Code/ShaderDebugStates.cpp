@@ -0,0 +1,286 @@
+/******************************************************************************
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019-2020 Baldur Karlsson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+#include "ShaderDebugStates.h"
+#include <QDebug>
+#include <algorithm>
+#include "lz4/lz4.h"
+
+// the states are flattened into a byte buffer before compression with a trivial field-by-field
+// encoding. The encoding is only ever consumed in the same process by the matching read functions
+// below, so there are no versioning or endianness concerns.
+
+template <typename T>
+static void writeValue(bytebuf &buf, const T &val)
+{
+  buf.append((const byte *)&val, sizeof(T));
+}
+
+template <typename T>
+static void readValue(const byte *&cur, T &val)
+{
+  memcpy(&val, cur, sizeof(T));
+  cur += sizeof(T);
+}
+
+static void writeString(bytebuf &buf, const rdcstr &str)
+{
+  writeValue(buf, (uint32_t)str.size());
+  buf.append((const byte *)str.c_str(), str.size());
+}
+
+static void readString(const byte *&cur, rdcstr &str)
+{
+  uint32_t length = 0;
+  readValue(cur, length);
+  str.assign((const char *)cur, length);
+  cur += length;
+}
+
+static void writeVariable(bytebuf &buf, const ShaderVariable &var)
+{
+  writeString(buf, var.name);
+  writeValue(buf, var.rows);
+  writeValue(buf, var.columns);
+  writeValue(buf, var.displayAsHex);
+  writeValue(buf, var.isStruct);
+  writeValue(buf, var.rowMajor);
+  writeValue(buf, var.type);
+  writeValue(buf, var.value);
+  writeValue(buf, (uint32_t)var.members.size());
+  for(const ShaderVariable &member : var.members)
+    writeVariable(buf, member);
+}
+
+static void readVariable(const byte *&cur, ShaderVariable &var)
+{
+  readString(cur, var.name);
+  readValue(cur, var.rows);
+  readValue(cur, var.columns);
+  readValue(cur, var.displayAsHex);
+  readValue(cur, var.isStruct);
+  readValue(cur, var.rowMajor);
+  readValue(cur, var.type);
+  readValue(cur, var.value);
+  uint32_t count = 0;
+  readValue(cur, count);
+  var.members.resize(count);
+  for(ShaderVariable &member : var.members)
+    readVariable(cur, member);
+}
+
+static void writeSourceVar(bytebuf &buf, const SourceVariableMapping &sourceVar)
+{
+  writeString(buf, sourceVar.name);
+  writeValue(buf, sourceVar.type);
+  writeValue(buf, sourceVar.rows);
+  writeValue(buf, sourceVar.columns);
+  writeValue(buf, sourceVar.offset);
+  writeValue(buf, sourceVar.signatureIndex);
+  writeValue(buf, (uint32_t)sourceVar.variables.size());
+  for(const DebugVariableReference &ref : sourceVar.variables)
+  {
+    writeString(buf, ref.name);
+    writeValue(buf, ref.type);
+    writeValue(buf, ref.component);
+  }
+}
+
+static void readSourceVar(const byte *&cur, SourceVariableMapping &sourceVar)
+{
+  readString(cur, sourceVar.name);
+  readValue(cur, sourceVar.type);
+  readValue(cur, sourceVar.rows);
+  readValue(cur, sourceVar.columns);
+  readValue(cur, sourceVar.offset);
+  readValue(cur, sourceVar.signatureIndex);
+  uint32_t count = 0;
+  readValue(cur, count);
+  sourceVar.variables.resize(count);
+  for(DebugVariableReference &ref : sourceVar.variables)
+  {
+    readString(cur, ref.name);
+    readValue(cur, ref.type);
+    readValue(cur, ref.component);
+  }
+}
+
+static void writeState(bytebuf &buf, const ShaderDebugState &state)
+{
+  writeValue(buf, state.nextInstruction);
+  writeValue(buf, state.stepIndex);
+  writeValue(buf, state.flags);
+
+  writeValue(buf, (uint32_t)state.changes.size());
+  for(const ShaderVariableChange &change : state.changes)
+  {
+    writeVariable(buf, change.before);
+    writeVariable(buf, change.after);
+  }
+
+  writeValue(buf, (uint32_t)state.sourceVars.size());
+  for(const SourceVariableMapping &sourceVar : state.sourceVars)
+    writeSourceVar(buf, sourceVar);
+
+  writeValue(buf, (uint32_t)state.callstack.size());
+  for(const rdcstr &frame : state.callstack)
+    writeString(buf, frame);
+}
+
+static void readState(const byte *&cur, ShaderDebugState &state)
+{
+  readValue(cur, state.nextInstruction);
+  readValue(cur, state.stepIndex);
+  readValue(cur, state.flags);
+
+  uint32_t count = 0;
+  readValue(cur, count);
+  state.changes.resize(count);
+  for(ShaderVariableChange &change : state.changes)
+  {
+    readVariable(cur, change.before);
+    readVariable(cur, change.after);
+  }
+
+  readValue(cur, count);
+  state.sourceVars.resize(count);
+  for(SourceVariableMapping &sourceVar : state.sourceVars)
+    readSourceVar(cur, sourceVar);
+
+  readValue(cur, count);
+  state.callstack.resize(count);
+  for(rdcstr &frame : state.callstack)
+    readString(cur, frame);
+}
+
+void CompressedShaderDebugStates::clear()
+{
+  m_Pages.clear();
+  m_Tail.clear();
+  m_Resident.clear();
+  m_Count = 0;
+}
+
+void CompressedShaderDebugStates::append(rdcarray<ShaderDebugState> &&states)
+{
+  m_Count += states.size();
+
+  for(ShaderDebugState &state : states)
+  {
+    m_Tail.push_back(std::move(state));
+
+    if(m_Tail.size() == PageSize)
+      flushTail();
+  }
+
+  states.clear();
+}
+
+void CompressedShaderDebugStates::flushTail()
+{
+  bytebuf uncompressed;
+  for(const ShaderDebugState &state : m_Tail)
+    writeState(uncompressed, state);
+
+  Page page;
+  page.count = (uint32_t)m_Tail.size();
+  page.uncompressedSize = (uint32_t)uncompressed.size();
+  page.compressed.resize((size_t)LZ4_compressBound((int)uncompressed.size()));
+
+  int compressedSize =
+      LZ4_compress_default((const char *)uncompressed.data(), (char *)page.compressed.data(),
+                           (int)uncompressed.size(), (int)page.compressed.size());
+
+  if(compressedSize <= 0)
+  {
+    qCritical() << "Failed to compress shader debug state page";
+    compressedSize = 0;
+    page.count = 0;
+  }
+
+  page.compressed.resize((size_t)compressedSize);
+
+  m_Pages.push_back(std::move(page));
+  m_Tail.clear();
+}
+
+const ShaderDebugState &CompressedShaderDebugStates::operator[](size_t index) const
+{
+  const size_t pageIndex = index / PageSize;
+
+  // states past the last full page live uncompressed in the tail
+  if(pageIndex >= m_Pages.size())
+    return m_Tail[index - m_Pages.size() * PageSize];
+
+  return residentPage(pageIndex)[index % PageSize];
+}
+
+const rdcarray<ShaderDebugState> &CompressedShaderDebugStates::residentPage(size_t pageIndex) const
+{
+  // check the window first, moving any hit to the front. Rotating moves the arrays by pointer so
+  // references to states in other resident pages stay valid.
+  for(size_t i = 0; i < m_Resident.size(); i++)
+  {
+    if(m_Resident[i].pageIndex == pageIndex)
+    {
+      if(i > 0)
+        std::rotate(m_Resident.begin(), m_Resident.begin() + i, m_Resident.begin() + i + 1);
+      return m_Resident[0].states;
+    }
+  }
+
+  const Page &page = m_Pages[pageIndex];
+
+  bytebuf uncompressed;
+  uncompressed.resize(page.uncompressedSize);
+
+  int size = LZ4_decompress_safe((const char *)page.compressed.data(), (char *)uncompressed.data(),
+                                 (int)page.compressed.size(), (int)uncompressed.size());
+
+  ResidentPage resident;
+  resident.pageIndex = pageIndex;
+  resident.states.resize(page.count);
+
+  if(size == (int)page.uncompressedSize)
+  {
+    const byte *cur = uncompressed.data();
+    for(ShaderDebugState &state : resident.states)
+      readState(cur, state);
+  }
+  else
+  {
+    // shouldn't be possible since we compressed the data ourselves, but leave the states
+    // default-initialised rather than decoding garbage
+    qCritical() << "Failed to decompress shader debug state page" << (qulonglong)pageIndex;
+  }
+
+  m_Resident.push_back(std::move(resident));
+  std::rotate(m_Resident.begin(), m_Resident.end() - 1, m_Resident.end());
+
+  // evict the least recently used pages beyond the window
+  if(m_Resident.size() > MaxResidentPages)
+    m_Resident.resize(MaxResidentPages);
+
+  return m_Resident[0].states;
+}
@@ -0,0 +1,86 @@
+/******************************************************************************
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019-2020 Baldur Karlsson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+#pragma once
+
+#include "Code/Interface/QRDInterface.h"
+
+// Debug traces of long-running shader invocations can contain hundreds of thousands of states,
+// which costs gigabytes of memory if they are all kept resident at once. This container keeps the
+// states LZ4-compressed in fixed-size pages, decompressing a small window of pages around the most
+// recently accessed state. The shader viewer only ever walks the trace sequentially so the window
+// stays hot, and memory use is bounded regardless of the trace length.
+class CompressedShaderDebugStates
+{
+public:
+  CompressedShaderDebugStates() = default;
+
+  void clear();
+
+  // appends a batch of states from IReplayController::ContinueDebug, compressing any pages that
+  // are completed by the new states. The array is consumed.
+  void append(rdcarray<ShaderDebugState> &&states);
+
+  bool empty() const { return m_Count == 0; }
+  size_t size() const { return m_Count; }
+  // the returned reference stays valid until at least MaxResidentPages other pages have been
+  // accessed, so references around the current state are stable while processing a step.
+  const ShaderDebugState &operator[](size_t index) const;
+  const ShaderDebugState &front() const { return (*this)[0]; }
+  const ShaderDebugState &back() const { return (*this)[m_Count - 1]; }
+private:
+  // a page of states from a heavy shader is at most a few MB decompressed - small enough to page
+  // back in imperceptibly, large enough that LZ4 gets a good ratio on the repetitive variable data
+  static const size_t PageSize = 256;
+
+  // enough of a working window that references to states near the current index survive any
+  // stepping the viewer does while processing one update
+  static const size_t MaxResidentPages = 8;
+
+  struct Page
+  {
+    bytebuf compressed;
+    uint32_t uncompressedSize = 0;
+    uint32_t count = 0;
+  };
+
+  struct ResidentPage
+  {
+    size_t pageIndex;
+    rdcarray<ShaderDebugState> states;
+  };
+
+  void flushTail();
+  const rdcarray<ShaderDebugState> &residentPage(size_t pageIndex) const;
+
+  rdcarray<Page> m_Pages;
+
+  // states that don't yet fill a whole page, stored uncompressed
+  rdcarray<ShaderDebugState> m_Tail;
+
+  size_t m_Count = 0;
+
+  // decompressed working window, most recently used first
+  mutable rdcarray<ResidentPage> m_Resident;
+};
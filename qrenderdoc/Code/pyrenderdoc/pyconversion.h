@@ -493,15 +493,35 @@ struct TypeConversion<bytebuf, false>
   // nicer failure error messages out with the index that failed
   static int ConvertFromPy(PyObject *in, bytebuf &out, int *failIdx)
   {
-    if(!PyBytes_Check(in))
-      return SWIG_TypeError;
+    if(PyBytes_Check(in))
+    {
+      Py_ssize_t len = PyBytes_Size(in);
 
-    Py_ssize_t len = PyBytes_Size(in);
+      out.resize((size_t)len);
+      memcpy(out.data(), PyBytes_AsString(in), out.size());
 
-    out.resize((size_t)len);
-    memcpy(out.data(), PyBytes_AsString(in), out.size());
+      return SWIG_OK;
+    }
 
-    return SWIG_OK;
+    // accept anything else exposing the buffer protocol - memoryview, bytearray, numpy arrays -
+    // as a single contiguous copy, so callers don't have to convert to bytes first.
+    if(PyObject_CheckBuffer(in))
+    {
+      Py_buffer view;
+      if(PyObject_GetBuffer(in, &view, PyBUF_CONTIG_RO) == 0)
+      {
+        out.resize((size_t)view.len);
+        memcpy(out.data(), view.buf, out.size());
+
+        PyBuffer_Release(&view);
+
+        return SWIG_OK;
+      }
+
+      PyErr_Clear();
+    }
+
+    return SWIG_TypeError;
   }
 
   static int ConvertFromPy(PyObject *in, bytebuf &out) { return ConvertFromPy(in, out, NULL); }
@@ -586,17 +606,31 @@ struct TypeConversion<rdcarray<U>, false>
 
   static PyObject *ConvertToPy(const rdcarray<U> &in, int *failIdx)
   {
-    PyObject *list = PyList_New(0);
+    // pre-size the list and fill it directly - for large arrays the reallocation and per-call
+    // overhead of appending one element at a time is a significant part of marshalling cost.
+    PyObject *list = PyList_New(in.count());
     if(!list)
       return NULL;
 
-    PyObject *ret = ConvertToPyInPlace(list, in, failIdx);
+    for(int i = 0; i < in.count(); i++)
+    {
+      PyObject *elem = TypeConversion<U>::ConvertToPy(in[i]);
 
-    // if a failure happened, don't leak the list we created
-    if(!ret)
-      Py_XDECREF(list);
+      if(!elem)
+      {
+        if(failIdx)
+          *failIdx = i;
 
-    return ret;
+        // don't leak the list we created
+        Py_XDECREF(list);
+        return NULL;
+      }
+
+      // list takes ownership of our reference
+      PyList_SET_ITEM(list, i, elem);
+    }
+
+    return list;
   }
 
   static PyObject *ConvertToPy(const rdcarray<U> &in) { return ConvertToPy(in, NULL); }
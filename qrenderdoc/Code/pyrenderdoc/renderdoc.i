@@ -314,6 +314,7 @@ TEMPLATE_ARRAY_INSTANTIATE(rdcarray, DebugMessage)
 TEMPLATE_ARRAY_INSTANTIATE(rdcarray, EnvironmentModification)
 TEMPLATE_ARRAY_INSTANTIATE(rdcarray, EventUsage)
 TEMPLATE_ARRAY_INSTANTIATE(rdcarray, PathEntry)
+TEMPLATE_ARRAY_INSTANTIATE(rdcarray, PixelDebugTarget)
 TEMPLATE_ARRAY_INSTANTIATE(rdcarray, PixelModification)
 TEMPLATE_ARRAY_INSTANTIATE(rdcarray, ResourceDescription)
 TEMPLATE_ARRAY_INSTANTIATE(rdcarray, ResourceId)
@@ -343,6 +344,7 @@ TEMPLATE_ARRAY_INSTANTIATE(rdcarray, FloatVector)
 TEMPLATE_ARRAY_INSTANTIATE(rdcarray, GraphicsAPI)
 TEMPLATE_ARRAY_INSTANTIATE(rdcarray, GPUDevice)
 TEMPLATE_ARRAY_INSTANTIATE(rdcarray, ShaderVariableType)
+TEMPLATE_ARRAY_INSTANTIATE_PTR(rdcarray, ShaderDebugTrace)
 TEMPLATE_NAMESPACE_ARRAY_INSTANTIATE(rdcarray, VKPipe, Attachment)
 TEMPLATE_NAMESPACE_ARRAY_INSTANTIATE(rdcarray, VKPipe, BindingElement)
 TEMPLATE_NAMESPACE_ARRAY_INSTANTIATE(rdcarray, VKPipe, DescriptorBinding)
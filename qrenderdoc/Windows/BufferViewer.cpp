@@ -32,6 +32,7 @@
 #include <QMutexLocker>
 #include <QPushButton>
 #include <QScrollBar>
+#include <QSharedPointer>
 #include <QTimer>
 #include <QtMath>
 #include "Code/QRDUtils.h"
@@ -2452,7 +2453,7 @@ void BufferViewer::OnEventChanged(uint32_t eventId)
 
   QPointer<BufferViewer> me(this);
 
-  m_Ctx.Replay().AsyncInvoke([this, me, bufdata](IReplayController *r) {
+  m_Ctx.Replay().AsyncInvoke([this, me, eventId, bufdata](IReplayController *r) {
 
     if(!me)
       return;
@@ -2500,7 +2501,15 @@ void BufferViewer::OnEventChanged(uint32_t eventId)
 
       if(m_IsBuffer)
       {
-        buf->storage = r->GetBufferData(m_BufferID, CurrentByteOffset(), clampedLen);
+        uint64_t fetchOffset = CurrentByteOffset();
+
+        if(clampedLen == 0 || !LookupPageCache(eventId, fetchOffset, clampedLen, buf->storage))
+        {
+          buf->storage = r->GetBufferData(m_BufferID, fetchOffset, clampedLen);
+
+          if(clampedLen > 0)
+            InsertPageCache(eventId, fetchOffset, clampedLen, buf->storage);
+        }
       }
       else
       {
@@ -2524,7 +2533,7 @@ void BufferViewer::OnEventChanged(uint32_t eventId)
       }
     }
 
-    GUIInvoke::call(this, [this, bufdata]() {
+    GUIInvoke::call(this, [this, eventId, bufdata]() {
       if(bufdata->sequence != m_Sequence)
         return;
 
@@ -2625,6 +2634,9 @@ void BufferViewer::OnEventChanged(uint32_t eventId)
         {
           ui->vsinData->setIndexWidget(m_ModelVSIn->index(MaxVisibleRows, 1), MakeNextPageButton());
         }
+
+        // fetch the neighbouring pages in the background so paging to them is instant
+        PrefetchAdjacentPages(eventId);
       }
 
       // we're done with it, the buffer configurations are individually copied/refcounted
@@ -2707,6 +2719,12 @@ void BufferViewer::setPersistData(const QVariant &persistData)
 
 void BufferViewer::calcBoundingData(CalcBoundingBoxData &bbox)
 {
+  // a GPU reduction pass computing the AABB has been floated for this, but it wouldn't buy what
+  // it seems to: the buffer data here is already resident on the CPU because the mesh table
+  // displays it, bounds are needed for every column (the per-element min/max labels), not just
+  // the position element a GPU pass would reduce, and this already runs on a worker thread with
+  // the raw float fast-path below, so it's off the critical path of event browsing. If this ever
+  // shows up again, profile the decode loop before reaching for compute shaders.
   for(size_t stage = 0; stage < ARRAY_COUNT(bbox.input); stage++)
   {
     const BufferConfiguration &s = bbox.input[stage];
@@ -2767,6 +2785,25 @@ void BufferViewer::calcBoundingData(CalcBoundingBoxData &bbox)
           if(!prop->perinstance)
             bytes += d.stride * idx;
 
+          // decode common vector formats straight to floats - the QVariant boxing in GetVariants
+          // dominates this loop on large meshes
+          float fvals[4];
+          int fcount = GetFloatVector(prop->format, el->type.descriptor, bytes, d.end, fvals);
+
+          if(fcount >= 0)
+          {
+            for(int comp = 0; comp < fcount; comp++)
+            {
+              if(qIsFinite(fvals[comp]))
+              {
+                minOut[comp] = qMin(minOut[comp], fvals[comp]);
+                maxOut[comp] = qMax(maxOut[comp], fvals[comp]);
+              }
+            }
+
+            continue;
+          }
+
           QVariantList list = GetVariants(prop->format, el->type.descriptor, bytes, d.end);
 
           for(int comp = 0; comp < 4 && comp < list.count(); comp++)
@@ -2908,6 +2945,101 @@ uint64_t BufferViewer::CurrentByteOffset()
   return m_ByteOffset + m_PagingByteOffset;
 }
 
+bool BufferViewer::LookupPageCache(uint32_t eventId, uint64_t offset, uint64_t length, bytebuf &data)
+{
+  QMutexLocker lock(&m_PageCacheLock);
+
+  for(int i = 0; i < m_PageCache.count(); i++)
+  {
+    const CachedBufferPage &page = m_PageCache[i];
+
+    // a longer fetch of the same range covers a shorter one, since both get clamped to the
+    // buffer's end identically
+    if(page.eventId == eventId && page.buffer == m_BufferID && page.offset == offset &&
+       page.length >= length)
+    {
+      data = page.data;
+      if(uint64_t(data.size()) > length)
+        data.resize((size_t)length);
+
+      // most recently used pages evict last
+      if(i > 0)
+        m_PageCache.move(i, 0);
+
+      return true;
+    }
+  }
+
+  return false;
+}
+
+void BufferViewer::InsertPageCache(uint32_t eventId, uint64_t offset, uint64_t length,
+                                   const bytebuf &data)
+{
+  QMutexLocker lock(&m_PageCacheLock);
+
+  for(const CachedBufferPage &page : m_PageCache)
+  {
+    if(page.eventId == eventId && page.buffer == m_BufferID && page.offset == offset &&
+       page.length >= length)
+      return;
+  }
+
+  m_PageCache.push_front({eventId, m_BufferID, offset, length, data});
+
+  // pages can be large for fat strides, so keep only a few resident
+  const int MaxCachedPages = 4;
+
+  while(m_PageCache.count() > MaxCachedPages)
+    m_PageCache.pop_back();
+}
+
+void BufferViewer::PrefetchAdjacentPages(uint32_t eventId)
+{
+  if(m_MeshView || !m_IsBuffer)
+    return;
+
+  const BufferConfiguration &config = m_ModelVSIn->getConfig();
+
+  if(config.unclampedNumRows == 0 || config.buffers.isEmpty())
+    return;
+
+  const uint64_t stride = config.buffers[0]->stride;
+  const uint64_t pageBytes = stride * MaxVisibleRows;
+  const uint64_t pageLen = stride * (MaxVisibleRows + 2);
+
+  QVector<uint64_t> offsets;
+
+  if(m_PagingByteOffset >= pageBytes)
+    offsets.push_back(CurrentByteOffset() - pageBytes);
+
+  if(m_PagingByteOffset + pageBytes < uint64_t(config.unclampedNumRows) * stride)
+    offsets.push_back(CurrentByteOffset() + pageBytes);
+
+  if(offsets.isEmpty())
+    return;
+
+  int sequence = m_Sequence;
+  QPointer<BufferViewer> me(this);
+
+  m_Ctx.Replay().AsyncInvoke([this, me, eventId, sequence, offsets, pageLen](IReplayController *r) {
+    // if the viewer closed or moved on to different data, don't prefetch for the old state
+    if(!me || sequence != m_Sequence)
+      return;
+
+    for(uint64_t offset : offsets)
+    {
+      bytebuf data;
+
+      if(LookupPageCache(eventId, offset, pageLen, data))
+        continue;
+
+      data = r->GetBufferData(m_BufferID, offset, pageLen);
+      InsertPageCache(eventId, offset, pageLen, data);
+    }
+  });
+}
+
 void BufferViewer::UI_CalculateMeshFormats()
 {
   if(!m_MeshView)
@@ -3515,6 +3647,12 @@ void BufferViewer::Reset()
 
   m_BBoxes.clear();
 
+  {
+    // resource ids can be reused between captures, so cached pages must not survive a close
+    QMutexLocker lock(&m_PageCacheLock);
+    m_PageCache.clear();
+  }
+
   ICaptureContext *ctx = &m_Ctx;
 
   // while a capture is loaded, pass NULL into the widget
@@ -3862,7 +4000,12 @@ void BufferViewer::exportData(const BufferExport &params)
 
   BufferItemModel *model = (BufferItemModel *)m_CurView->model();
 
-  LambdaThread *exportThread = new LambdaThread([this, params, model, f]() {
+  // progress in fixed-point hundredths of a percent, plus a cancel flag. Shared pointers since
+  // the export thread and the progress dialog callbacks can outlive each other either way round.
+  QSharedPointer<QAtomicInteger<uint32_t>> progress(new QAtomicInteger<uint32_t>(0));
+  QSharedPointer<QAtomicInteger<uint32_t>> cancelled(new QAtomicInteger<uint32_t>(0));
+
+  LambdaThread *exportThread = new LambdaThread([this, params, model, f, progress, cancelled]() {
     if(params.format == BufferExport::RawBytes)
     {
       const BufferConfiguration &config = model->getConfig();
@@ -3884,6 +4027,12 @@ void BufferViewer::exportData(const BufferExport &params)
           for(uint64_t byteOffset = m_ByteOffset; byteOffset < m_ObjectByteSize;
               byteOffset += chunkSize)
           {
+            if(cancelled->loadAcquire())
+              break;
+
+            progress->storeRelease(uint32_t(10000 * (byteOffset - m_ByteOffset) /
+                                            (m_ObjectByteSize - m_ByteOffset)));
+
             // it's fine to block invoke, because this is on the export thread
             m_Ctx.Replay().BlockInvoke([buff, f, byteOffset](IReplayController *r) {
               bytebuf chunk = r->GetBufferData(buff, byteOffset, chunkSize);
@@ -3904,6 +4053,14 @@ void BufferViewer::exportData(const BufferExport &params)
         // offset and sizes
         for(int i = 0; i < model->rowCount(); i++)
         {
+          if((i & 0x3fff) == 0)
+          {
+            if(cancelled->loadAcquire())
+              break;
+
+            progress->storeRelease(uint32_t(10000 * uint64_t(i) / model->rowCount()));
+          }
+
           // manually calculate the index so that we get the real offset (not the displayed offset)
           // in the case of vertex output.
           uint32_t idx = i;
@@ -3965,6 +4122,14 @@ void BufferViewer::exportData(const BufferExport &params)
         // if there's no pagination to worry about, dump using the model's data()
         for(int row = 0; row < model->rowCount(); row++)
         {
+          if((row & 0x3fff) == 0)
+          {
+            if(cancelled->loadAcquire())
+              break;
+
+            progress->storeRelease(uint32_t(10000 * uint64_t(row) / model->rowCount()));
+          }
+
           for(int col = 0; col < model->columnCount(); col++)
           {
             s << model->data(model->index(row, col), Qt::DisplayRole).toString();
@@ -3983,8 +4148,15 @@ void BufferViewer::exportData(const BufferExport &params)
         const uint64_t chunkSize = 64 * 1024 * config.buffers[0]->stride;
         for(uint64_t byteOffset = m_ByteOffset; byteOffset < m_ObjectByteSize; byteOffset += chunkSize)
         {
+          if(cancelled->loadAcquire())
+            break;
+
+          progress->storeRelease(
+              uint32_t(10000 * (byteOffset - m_ByteOffset) / (m_ObjectByteSize - m_ByteOffset)));
+
           // it's fine to block invoke, because this is on the export thread
-          m_Ctx.Replay().BlockInvoke([buff, &s, &config, byteOffset, chunkSize](IReplayController *r) {
+          m_Ctx.Replay().BlockInvoke([buff, &s, &config, byteOffset, chunkSize,
+                                      cancelled](IReplayController *r) {
             // cache column data for the inner loop
             QVector<CachedElData> cache;
 
@@ -4002,6 +4174,10 @@ void BufferViewer::exportData(const BufferExport &params)
             // offset and sizes
             for(size_t idx = 0; idx < numRows; idx++)
             {
+              // formatting a chunk can take a while, so poll for cancellation mid-chunk too
+              if((idx & 0xfff) == 0 && cancelled->loadAcquire())
+                break;
+
               s << (rowOffset + idx) << ", ";
 
               for(int col = 0; col < cache.count(); col++)
@@ -4054,13 +4230,22 @@ void BufferViewer::exportData(const BufferExport &params)
 
     f->close();
 
+    // don't leave a partial file around if the export was cancelled
+    if(cancelled->loadAcquire())
+      f->remove();
+
     delete f;
   });
   exportThread->start();
 
   ShowProgressDialog(this, tr("Exporting data"),
-                     [exportThread]() { return !exportThread->isRunning(); });
+                     [exportThread]() { return !exportThread->isRunning(); },
+                     [progress]() { return float(progress->loadAcquire()) / 10000.0f; },
+                     [cancelled]() { cancelled->storeRelease(1); });
 
+  // on cancel the dialog closes before the thread has wound down - it polls the flag frequently,
+  // so this wait is brief
+  exportThread->wait();
   exportThread->deleteLater();
 }
 
@@ -188,6 +188,24 @@ private:
   uint64_t m_ByteSize = UINT64_MAX;
   ResourceId m_BufferID;
 
+  // raw buffer pages that have already been fetched, so paging back and forth and prefetched
+  // neighbouring pages don't round-trip to the replay thread again. The bytes for a given event
+  // and range are immutable within a capture, so entries only need evicting for memory.
+  struct CachedBufferPage
+  {
+    uint32_t eventId;
+    ResourceId buffer;
+    uint64_t offset;
+    uint64_t length;
+    bytebuf data;
+  };
+  QList<CachedBufferPage> m_PageCache;
+  QMutex m_PageCacheLock;
+
+  bool LookupPageCache(uint32_t eventId, uint64_t offset, uint64_t length, bytebuf &data);
+  void InsertPageCache(uint32_t eventId, uint64_t offset, uint64_t length, const bytebuf &data);
+  void PrefetchAdjacentPages(uint32_t eventId);
+
   CameraWrapper *m_CurrentCamera = NULL;
   ArcballWrapper *m_Arcball = NULL;
   FlycamWrapper *m_Flycam = NULL;
@@ -979,6 +979,7 @@ void CaptureDialog::SetSettings(CaptureSettings settings)
   ui->CaptureAllCmdLists->setChecked(settings.options.captureAllCmdLists);
   ui->DelayForDebugger->setValue(settings.options.delayForDebugger);
   ui->VerifyBufferAccess->setChecked(settings.options.verifyBufferAccess);
+  ui->StripChunkMetadata->setChecked(settings.options.stripChunkMetadata);
   ui->AutoStart->setChecked(settings.autoStart);
 
   // force flush this state
@@ -1027,6 +1028,7 @@ CaptureSettings CaptureDialog::Settings()
   ret.options.captureAllCmdLists = ui->CaptureAllCmdLists->isChecked();
   ret.options.delayForDebugger = (uint32_t)ui->DelayForDebugger->value();
   ret.options.verifyBufferAccess = ui->VerifyBufferAccess->isChecked();
+  ret.options.stripChunkMetadata = ui->StripChunkMetadata->isChecked();
 
   if(ui->queueFrameCap->isChecked())
   {
@@ -254,10 +254,18 @@ void EventBrowser::OnCaptureLoaded()
   QPair<uint32_t, uint32_t> lastEIDDraw = AddDrawcalls(frame, m_Ctx.CurDrawcalls());
   frame->setTag(QVariant::fromValue(EventItemTag(0, lastEIDDraw.first)));
 
+  // suppress per-item model updates while the whole tree is inserted
+  ui->events->beginUpdate();
+
   ui->events->addTopLevelItem(frame);
 
   ui->events->expandItem(frame);
 
+  ui->events->endUpdate();
+
+  m_SearchIndex.clear();
+  BuildSearchIndex(frame);
+
   clearBookmarks();
   repopulateBookmarks();
 
@@ -276,6 +284,9 @@ void EventBrowser::OnCaptureClosed()
 
   on_HideFindJump();
 
+  m_SearchIndex.clear();
+  m_FindResults.clear();
+
   ui->events->clear();
 
   ui->find->setEnabled(false);
@@ -411,7 +422,23 @@ QPair<uint32_t, uint32_t> EventBrowser::AddDrawcalls(RDTreeWidgetItem *parent,
   return qMakePair(lastEID, lastDraw);
 }
 
-void EventBrowser::SetDrawcallTimes(RDTreeWidgetItem *node, const rdcarray<CounterResult> &results)
+void EventBrowser::RefreshDrawcallTimes()
+{
+  if(ui->events->topLevelItemCount() == 0)
+    return;
+
+  // index the results by event so the recursive walk doesn't do a linear search of the whole
+  // result list per leaf, which is quadratic over a large capture and hangs the UI for far longer
+  // than the GPU sweep itself.
+  QHash<uint32_t, double> durations;
+  durations.reserve((int)m_Times.size());
+  for(const CounterResult &r : m_Times)
+    durations.insert(r.eventId, r.value.d);
+
+  SetDrawcallTimes(ui->events->topLevelItem(0), durations);
+}
+
+void EventBrowser::SetDrawcallTimes(RDTreeWidgetItem *node, const QHash<uint32_t, double> &durations)
 {
   if(node == NULL)
     return;
@@ -424,13 +451,7 @@ void EventBrowser::SetDrawcallTimes(RDTreeWidgetItem *node, const rdcarray<Count
   {
     uint32_t eid = node->tag().value<EventItemTag>().EID;
 
-    duration = -1.0;
-
-    for(const CounterResult &r : results)
-    {
-      if(r.eventId == eid)
-        duration = r.value.d;
-    }
+    duration = durations.value(eid, -1.0);
 
     double secs = duration;
 
@@ -451,7 +472,7 @@ void EventBrowser::SetDrawcallTimes(RDTreeWidgetItem *node, const rdcarray<Count
 
   for(int i = 0; i < node->childCount(); i++)
   {
-    SetDrawcallTimes(node->child(i), results);
+    SetDrawcallTimes(node->child(i), durations);
 
     double nd = node->child(i)->tag().value<EventItemTag>().duration;
 
@@ -507,10 +528,7 @@ void EventBrowser::on_timeDraws_clicked()
     m_Times = r->FetchCounters({GPUCounter::EventGPUDuration});
 
     GUIInvoke::call(this, [this]() {
-      if(ui->events->topLevelItemCount() == 0)
-        return;
-
-      SetDrawcallTimes(ui->events->topLevelItem(0), m_Times);
+      RefreshDrawcallTimes();
       ui->events->update();
     });
   });
@@ -575,10 +593,15 @@ void EventBrowser::on_jumpToEID_returnPressed()
 
 void EventBrowser::findHighlight_timeout()
 {
+  // batch up the icon changes into one model update
+  ui->events->beginUpdate();
+
   ClearFindIcons();
 
   int results = SetFindIcons(ui->findEvent->text());
 
+  ui->events->endUpdate();
+
   if(results > 0)
     ui->findEvent->setPalette(palette());
   else
@@ -1075,8 +1098,7 @@ void EventBrowser::repopulateBookmarks()
 
       highlightBookmarks();
 
-      RDTreeWidgetItem *found = NULL;
-      FindEventNode(found, ui->events->topLevelItem(0), EID);
+      RDTreeWidgetItem *found = FindEventNode(EID);
 
       if(found)
       {
@@ -1100,8 +1122,7 @@ void EventBrowser::repopulateBookmarks()
       delete m_BookmarkButtons[EID];
       m_BookmarkButtons.remove(EID);
 
-      RDTreeWidgetItem *found = NULL;
-      FindEventNode(found, ui->events->topLevelItem(0), EID);
+      RDTreeWidgetItem *found = FindEventNode(EID);
 
       if(found)
       {
@@ -1172,32 +1193,42 @@ void EventBrowser::RefreshIcon(RDTreeWidgetItem *item, EventItemTag tag)
     item->setIcon(COL_NAME, QIcon());
 }
 
-bool EventBrowser::FindEventNode(RDTreeWidgetItem *&found, RDTreeWidgetItem *parent, uint32_t eventId)
+void EventBrowser::BuildSearchIndex(RDTreeWidgetItem *parent)
 {
-  // do a reverse search to find the last match (in case of 'set' markers that
-  // inherit the event of the next real draw).
-  for(int i = parent->childCount() - 1; i >= 0; i--)
+  for(int i = 0; i < parent->childCount(); i++)
   {
     RDTreeWidgetItem *n = parent->child(i);
 
-    uint nEID = n->tag().value<EventItemTag>().lastEID;
-    uint fEID = found ? found->tag().value<EventItemTag>().lastEID : 0;
+    EventSearchEntry entry = {n, n->tag().value<EventItemTag>().lastEID, n->text(COL_NAME)};
+    m_SearchIndex.push_back(entry);
+
+    if(n->childCount() > 0)
+      BuildSearchIndex(n);
+  }
+}
 
-    if(nEID >= eventId && (found == NULL || nEID <= fEID))
-      found = n;
+RDTreeWidgetItem *EventBrowser::FindEventNode(uint32_t eventId)
+{
+  RDTreeWidgetItem *found = NULL;
+  uint32_t fEID = 0;
 
-    if(nEID == eventId && n->childCount() == 0)
-      return true;
+  // search the index in reverse so that exact matches prefer the real draw over 'set' markers
+  // that inherit the event of the next real draw, and deeper nodes over their parent markers.
+  for(int i = m_SearchIndex.count() - 1; i >= 0; i--)
+  {
+    const EventSearchEntry &e = m_SearchIndex[i];
 
-    if(n->childCount() > 0)
+    if(e.eid >= eventId && (found == NULL || e.eid < fEID))
     {
-      bool exact = FindEventNode(found, n, eventId);
-      if(exact)
-        return true;
+      found = e.item;
+      fEID = e.eid;
     }
+
+    if(e.eid == eventId && e.item->childCount() == 0)
+      return e.item;
   }
 
-  return false;
+  return found;
 }
 
 void EventBrowser::ExpandNode(RDTreeWidgetItem *node)
@@ -1218,8 +1249,7 @@ bool EventBrowser::SelectEvent(uint32_t eventId)
   if(!m_Ctx.IsCaptureLoaded())
     return false;
 
-  RDTreeWidgetItem *found = NULL;
-  FindEventNode(found, ui->events->topLevelItem(0), eventId);
+  RDTreeWidgetItem *found = FindEventNode(eventId);
   if(found != NULL)
   {
     ui->events->setCurrentItem(found);
@@ -1232,126 +1262,69 @@ bool EventBrowser::SelectEvent(uint32_t eventId)
   return false;
 }
 
-void EventBrowser::ClearFindIcons(RDTreeWidgetItem *parent)
+void EventBrowser::ClearFindIcons()
 {
-  for(int i = 0; i < parent->childCount(); i++)
+  // only items marked by the previous search need clearing
+  for(RDTreeWidgetItem *n : m_FindResults)
   {
-    RDTreeWidgetItem *n = parent->child(i);
-
     EventItemTag tag = n->tag().value<EventItemTag>();
     tag.find = false;
     n->setTag(QVariant::fromValue(tag));
     RefreshIcon(n, tag);
-
-    if(n->childCount() > 0)
-      ClearFindIcons(n);
   }
-}
 
-void EventBrowser::ClearFindIcons()
-{
-  if(m_Ctx.IsCaptureLoaded() && ui->events->topLevelItemCount() > 0)
-    ClearFindIcons(ui->events->topLevelItem(0));
+  m_FindResults.clear();
 }
 
-int EventBrowser::SetFindIcons(RDTreeWidgetItem *parent, QString filter)
+int EventBrowser::SetFindIcons(QString filter)
 {
-  int results = 0;
+  if(filter.isEmpty() || !m_Ctx.IsCaptureLoaded())
+    return 0;
 
-  for(int i = 0; i < parent->childCount(); i++)
+  for(const EventSearchEntry &e : m_SearchIndex)
   {
-    RDTreeWidgetItem *n = parent->child(i);
-
-    if(n->text(COL_NAME).contains(filter, Qt::CaseInsensitive))
+    if(e.name.contains(filter, Qt::CaseInsensitive))
     {
-      EventItemTag tag = n->tag().value<EventItemTag>();
+      EventItemTag tag = e.item->tag().value<EventItemTag>();
       tag.find = true;
-      n->setTag(QVariant::fromValue(tag));
-      RefreshIcon(n, tag);
-      results++;
-    }
-
-    if(n->childCount() > 0)
-    {
-      results += SetFindIcons(n, filter);
+      e.item->setTag(QVariant::fromValue(tag));
+      RefreshIcon(e.item, tag);
+      m_FindResults.push_back(e.item);
     }
   }
 
-  return results;
+  return m_FindResults.count();
 }
 
-int EventBrowser::SetFindIcons(QString filter)
+int EventBrowser::FindEvent(QString filter, uint32_t after, bool forward)
 {
-  if(filter.isEmpty() || !m_Ctx.IsCaptureLoaded())
+  if(!m_Ctx.IsCaptureLoaded())
     return 0;
 
-  return SetFindIcons(ui->events->topLevelItem(0), filter);
-}
-
-RDTreeWidgetItem *EventBrowser::FindNode(RDTreeWidgetItem *parent, QString filter, uint32_t after)
-{
-  for(int i = 0; i < parent->childCount(); i++)
+  // the index is in the same pre-order as the tree, so a linear scan gives the next or previous
+  // match without re-walking the tree.
+  if(forward)
   {
-    RDTreeWidgetItem *n = parent->child(i);
-
-    uint eid = n->tag().value<EventItemTag>().lastEID;
-
-    if(eid > after && n->text(COL_NAME).contains(filter, Qt::CaseInsensitive))
-      return n;
-
-    if(n->childCount() > 0)
+    for(const EventSearchEntry &e : m_SearchIndex)
     {
-      RDTreeWidgetItem *found = FindNode(n, filter, after);
-
-      if(found != NULL)
-        return found;
+      if(e.eid > after && e.name.contains(filter, Qt::CaseInsensitive))
+        return (int)e.eid;
     }
   }
-
-  return NULL;
-}
-
-int EventBrowser::FindEvent(RDTreeWidgetItem *parent, QString filter, uint32_t after, bool forward)
-{
-  if(parent == NULL)
-    return -1;
-
-  for(int i = forward ? 0 : parent->childCount() - 1; i >= 0 && i < parent->childCount();
-      i += forward ? 1 : -1)
+  else
   {
-    auto n = parent->child(i);
-
-    uint eid = n->tag().value<EventItemTag>().lastEID;
-
-    bool matchesAfter = (forward && eid > after) || (!forward && eid < after);
-
-    if(matchesAfter)
+    for(int i = m_SearchIndex.count() - 1; i >= 0; i--)
     {
-      QString name = n->text(COL_NAME);
-      if(name.contains(filter, Qt::CaseInsensitive))
-        return (int)eid;
-    }
+      const EventSearchEntry &e = m_SearchIndex[i];
 
-    if(n->childCount() > 0)
-    {
-      int found = FindEvent(n, filter, after, forward);
-
-      if(found > 0)
-        return found;
+      if(e.eid < after && e.name.contains(filter, Qt::CaseInsensitive))
+        return (int)e.eid;
     }
   }
 
   return -1;
 }
 
-int EventBrowser::FindEvent(QString filter, uint32_t after, bool forward)
-{
-  if(!m_Ctx.IsCaptureLoaded())
-    return 0;
-
-  return FindEvent(ui->events->topLevelItem(0), filter, after, forward);
-}
-
 void EventBrowser::Find(bool forward)
 {
   if(ui->findEvent->text().isEmpty())
@@ -1394,5 +1367,5 @@ void EventBrowser::UpdateDurationColumn()
   ui->events->setHeaderText(COL_DURATION, tr("Duration (%1)").arg(UnitSuffix(m_TimeUnit)));
 
   if(!m_Times.empty())
-    SetDrawcallTimes(ui->events->topLevelItem(0), m_Times);
+    RefreshDrawcallTimes();
 }
@@ -25,7 +25,9 @@
 #pragma once
 
 #include <QFrame>
+#include <QHash>
 #include <QIcon>
+#include <QVector>
 #include "Code/Interface/QRDInterface.h"
 
 namespace Ui
@@ -41,6 +43,15 @@ class QTextStream;
 class FlowLayout;
 struct EventItemTag;
 
+// a flat index over the event tree in pre-order, so that find-as-you-type and event lookups can
+// scan a contiguous array instead of re-walking the tree and unpacking item tags per node.
+struct EventSearchEntry
+{
+  RDTreeWidgetItem *item;
+  uint32_t eid;
+  QString name;
+};
+
 class EventBrowser : public QFrame, public IEventBrowser, public ICaptureViewer
 {
 private:
@@ -98,25 +109,23 @@ private:
   bool ShouldHide(const DrawcallDescription &drawcall);
   QPair<uint32_t, uint32_t> AddDrawcalls(RDTreeWidgetItem *parent,
                                          const rdcarray<DrawcallDescription> &draws);
-  void SetDrawcallTimes(RDTreeWidgetItem *node, const rdcarray<CounterResult> &results);
+  void RefreshDrawcallTimes();
+  void SetDrawcallTimes(RDTreeWidgetItem *node, const QHash<uint32_t, double> &durations);
 
   void ExpandNode(RDTreeWidgetItem *node);
 
-  bool FindEventNode(RDTreeWidgetItem *&found, RDTreeWidgetItem *parent, uint32_t eventId);
+  void BuildSearchIndex(RDTreeWidgetItem *parent);
+  RDTreeWidgetItem *FindEventNode(uint32_t eventId);
   bool SelectEvent(uint32_t eventId);
 
-  void ClearFindIcons(RDTreeWidgetItem *parent);
   void ClearFindIcons();
 
-  int SetFindIcons(RDTreeWidgetItem *parent, QString filter);
   int SetFindIcons(QString filter);
 
   void repopulateBookmarks();
   void highlightBookmarks();
   bool hasBookmark(RDTreeWidgetItem *node);
 
-  RDTreeWidgetItem *FindNode(RDTreeWidgetItem *parent, QString filter, uint32_t after);
-  int FindEvent(RDTreeWidgetItem *parent, QString filter, uint32_t after, bool forward);
   int FindEvent(QString filter, uint32_t after, bool forward);
   void Find(bool forward);
 
@@ -135,6 +144,10 @@ private:
 
   QTimer *m_FindHighlight;
 
+  QVector<EventSearchEntry> m_SearchIndex;
+  // items currently carrying the find icon, so clearing only touches previous results
+  QVector<RDTreeWidgetItem *> m_FindResults;
+
   FlowLayout *m_BookmarkStripLayout;
   QSpacerItem *m_BookmarkSpacer;
   QMap<uint32_t, QToolButton *> m_BookmarkButtons;
@@ -1664,19 +1664,37 @@ void MainWindow::remoteProbe()
     // fetch the latest list
     rdcarray<RemoteHost> hosts = m_Ctx.Config().GetRemoteHosts();
 
+    // probe the hosts concurrently - they're independent servers, and probing serially costs a
+    // full connection timeout per offline host, which makes the sweep take ages on a long host
+    // list. This way it completes in roughly the time of the slowest single probe.
+    rdcarray<LambdaThread *> threads;
+
     for(RemoteHost &host : hosts)
     {
       // don't mess with a host we're connected to - this is handled anyway
       if(host.IsConnected())
         continue;
 
-      // this will do the bulk of the status checking on this thread without holding any lock, then
+      // this will do the bulk of the status checking on its thread without holding any lock, then
       // grab the remote host lock and update the config's host (if it's still there)
-      host.CheckStatus();
+      LambdaThread *th = new LambdaThread([h = host]() {
+        // make a mutable copy and see if the server is up
+        RemoteHost host = h;
+        host.CheckStatus();
+      });
+      th->setName(lit("Remote probe ") + host.Hostname());
+      th->start();
+      threads.push_back(th);
 
-      // bail as soon as we notice that we're done
+      // bail as soon as we notice that we're done, the threads already started will finish
       if(!m_RemoteProbeSemaphore.available())
-        return;
+        break;
+    }
+
+    for(LambdaThread *th : threads)
+    {
+      th->wait();
+      th->deleteLater();
     }
   }
 }
@@ -2436,29 +2454,32 @@ void MainWindow::on_action_Resolve_Symbols_triggered()
     return;
   }
 
-  float progress = 0.0f;
-  bool finished = false;
+  // resolve in the background rather than behind a modal dialog, with progress in the status bar.
+  // The resolver caches symbols per module on disk, so after the first session this usually
+  // completes almost immediately.
+  statusText->setText(tr("Resolving symbols..."));
 
-  m_Ctx.Replay().AsyncInvoke([this, &progress, &finished](IReplayController *) {
-    bool success = m_Ctx.Replay().GetCaptureAccess()->InitResolver(
-        true, [&progress](float p) { progress = p; });
-
-    if(!success)
-    {
-      RDDialog::critical(
-          this, tr("Error loading symbols"),
-          tr("Couldn't load symbols for callstack resolution.\n\nCheck diagnostic log in "
-             "Help menu for more details."));
-    }
+  m_Ctx.Replay().AsyncInvoke([this](IReplayController *) {
+    bool success = m_Ctx.Replay().GetCaptureAccess()->InitResolver(true, [this](float p) {
+      GUIInvoke::call(this, [this, p]() { setProgress(p); });
+    });
 
-    finished = true;
-  });
+    GUIInvoke::call(this, [this, success]() {
+      setProgress(1.0f);
 
-  ShowProgressDialog(this, tr("Resolving symbols, please wait..."),
-                     [&finished]() { return finished; }, [&progress]() { return progress; });
+      if(!success)
+      {
+        RDDialog::critical(
+            this, tr("Error loading symbols"),
+            tr("Couldn't load symbols for callstack resolution.\n\nCheck diagnostic log in "
+               "Help menu for more details."));
+        return;
+      }
 
-  if(m_Ctx.HasAPIInspector())
-    m_Ctx.GetAPIInspector()->Refresh();
+      if(m_Ctx.HasAPIInspector())
+        m_Ctx.GetAPIInspector()->Refresh();
+    });
+  });
 }
 
 void MainWindow::on_action_Recompress_Capture_triggered()
@@ -23,6 +23,7 @@
  ******************************************************************************/
 
 #include "PerformanceCounterViewer.h"
+#include <QSharedPointer>
 #include "Code/QRDUtils.h"
 #include "Windows/Dialogs/PerformanceCounterSelection.h"
 #include "ui_PerformanceCounterViewer.h"
@@ -194,8 +195,15 @@ void PerformanceCounterViewer::CaptureCounters()
 
   ANALYTIC_SET(UIFeatures.PerformanceCounters, true);
 
-  bool done = false;
-  m_Ctx.Replay().AsyncInvoke([this, &done](IReplayController *controller) -> void {
+  // disabled while a fetch is in flight, re-enabled once the last counter's results land
+  ui->captureCounters->setEnabled(false);
+
+  QPointer<PerformanceCounterViewer> me(this);
+
+  m_Ctx.Replay().AsyncInvoke([this, me](IReplayController *controller) -> void {
+    if(!me)
+      return;
+
     rdcarray<GPUCounter> counters;
     counters.resize(m_SelectedCounters.size());
 
@@ -213,56 +221,255 @@ void PerformanceCounterViewer::CaptureCounters()
       counterIndex.insert((GPUCounter)m_SelectedCounters[i], i);
     }
 
-    const rdcarray<CounterResult> results = controller->FetchCounters(counters);
+    // set the table up immediately - results stream in below one counter at a time, so the
+    // window stays usable while the remaining passes run instead of blocking behind a modal
+    // progress dialog until every counter has been fetched.
+    GUIInvoke::call(this, [this, counterDescriptions]() { SetupCounterTable(counterDescriptions); });
 
-    GUIInvoke::call(this, [this, results, counterDescriptions, counterIndex]() {
-      ui->counterResults->clear();
+    // shared between the streamed updates, since each counter's results insert into the same rows
+    QSharedPointer<QMap<uint32_t, int>> eventIdToRow(new QMap<uint32_t, int>());
 
-      QStringList headers;
-      headers << lit("EID");
-      for(const CounterDescription &cd : counterDescriptions)
-      {
-        headers << cd.name;
-      }
+    // accumulates every counter's results so the finished sweep can be saved into the capture
+    QSharedPointer<rdcarray<CounterResult>> allResults(new rdcarray<CounterResult>());
 
-      QMap<uint32_t, int> eventIdToRow;
-      for(const CounterResult &result : results)
-      {
-        if(eventIdToRow.contains(result.eventId))
-          continue;
-        eventIdToRow.insert(result.eventId, eventIdToRow.size());
-      }
+    for(int i = 0; i < counters.count(); ++i)
+    {
+      // stop fetching if the window was closed mid-stream
+      if(!me)
+        return;
 
-      ui->counterResults->setColumnCount(headers.size());
-      ui->counterResults->setHorizontalHeaderLabels(headers);
-      ui->counterResults->setRowCount(eventIdToRow.size());
+      rdcarray<GPUCounter> fetch = {counters[i]};
 
-      ui->counterResults->setSortingEnabled(false);
+      const rdcarray<CounterResult> results = controller->FetchCounters(fetch);
 
-      for(int i = 0; i < (int)results.size(); ++i)
-      {
-        int row = eventIdToRow[results[i].eventId];
+      allResults->append(results);
 
-        ui->counterResults->setItem(row, 0,
-                                    new CustomSortedTableItem(QString::number(results[i].eventId),
-                                                              SortValue(results[i].eventId)));
+      GUIInvoke::call(this, [this, results, counterDescriptions, counterIndex, eventIdToRow]() {
+        AddCounterRows(results, counterDescriptions, counterIndex, *eventIdToRow);
+      });
+    }
 
-        ui->counterResults->setItem(
-            row, counterIndex[results[i].counter] + 1,
-            MakeCounterResultItem(results[i], counterDescriptions[results[i].counter]));
+    GUIInvoke::call(this, [this, counterDescriptions, allResults]() {
+      FinishCounterTable();
 
-        ui->counterResults->item(row, 0)->setData(Qt::UserRole, results[i].eventId);
-      }
+      // persist the sweep so re-opening this capture on the same GPU restores the table for free
+      SaveCounterResults(counterDescriptions, *allResults);
+    });
+  });
+}
 
-      ui->counterResults->setSortingEnabled(true);
+void PerformanceCounterViewer::SetupCounterTable(const QMap<GPUCounter, CounterDescription> &descriptions)
+{
+  ui->counterResults->clear();
 
-      ui->counterResults->resizeColumnsToContents();
-    });
+  QStringList headers;
+  headers << lit("EID");
+  for(const CounterDescription &cd : descriptions)
+  {
+    headers << cd.name;
+  }
 
-    done = true;
-  });
+  ui->counterResults->setColumnCount(headers.size());
+  ui->counterResults->setHorizontalHeaderLabels(headers);
+  ui->counterResults->setRowCount(0);
 
-  ShowProgressDialog(this, tr("Capturing counters"), [&done]() -> bool { return done; });
+  ui->counterResults->setSortingEnabled(false);
+}
+
+void PerformanceCounterViewer::AddCounterRows(const rdcarray<CounterResult> &results,
+                                              const QMap<GPUCounter, CounterDescription> &descriptions,
+                                              const QMap<GPUCounter, int> &counterIndex,
+                                              QMap<uint32_t, int> &eventIdToRow)
+{
+  for(const CounterResult &result : results)
+  {
+    int row;
+
+    if(eventIdToRow.contains(result.eventId))
+    {
+      row = eventIdToRow[result.eventId];
+    }
+    else
+    {
+      row = ui->counterResults->rowCount();
+      eventIdToRow.insert(result.eventId, row);
+
+      ui->counterResults->insertRow(row);
+      ui->counterResults->setItem(row, 0,
+                                  new CustomSortedTableItem(QString::number(result.eventId),
+                                                            SortValue(result.eventId)));
+      ui->counterResults->item(row, 0)->setData(Qt::UserRole, result.eventId);
+    }
+
+    ui->counterResults->setItem(row, counterIndex[result.counter] + 1,
+                                MakeCounterResultItem(result, descriptions[result.counter]));
+  }
+}
+
+void PerformanceCounterViewer::FinishCounterTable()
+{
+  ui->counterResults->setSortingEnabled(true);
+
+  ui->counterResults->resizeColumnsToContents();
+
+  ui->captureCounters->setEnabled(m_Ctx.IsCaptureLoaded());
+}
+
+void PerformanceCounterViewer::SaveCounterResults(
+    const QMap<GPUCounter, CounterDescription> &descriptions, const rdcarray<CounterResult> &results)
+{
+  QVariantList counters;
+  for(const CounterDescription &desc : descriptions)
+  {
+    QVariantMap counter;
+    counter[lit("counter")] = (uint32_t)desc.counter;
+    counter[lit("name")] = desc.name;
+    counter[lit("category")] = desc.category;
+    counter[lit("description")] = desc.description;
+    counter[lit("resultType")] = (uint32_t)desc.resultType;
+    counter[lit("resultByteWidth")] = desc.resultByteWidth;
+    counter[lit("unit")] = (uint32_t)desc.unit;
+
+    QVariantList uuid;
+    for(uint32_t word : desc.uuid.words)
+      uuid.push_back(word);
+    counter[lit("uuid")] = uuid;
+
+    counters.push_back(counter);
+  }
+
+  QVariantList values;
+  for(const CounterResult &result : results)
+  {
+    QVariantMap value;
+    value[lit("eventId")] = result.eventId;
+    value[lit("counter")] = (uint32_t)result.counter;
+
+    const CounterDescription desc = descriptions[result.counter];
+    if(desc.resultType == CompType::Float)
+      value[lit("value")] = result.value.f;
+    else if(desc.resultType == CompType::Double)
+      value[lit("value")] = result.value.d;
+    else if(desc.resultByteWidth == 8)
+      value[lit("value")] = (qulonglong)result.value.u64;
+    else
+      value[lit("value")] = result.value.u32;
+
+    values.push_back(value);
+  }
+
+  QVariantMap root;
+  // counter availability and meaning are hardware and driver specific, so tag the results with
+  // the GPU they were sampled on. Loading only restores them when it matches.
+  root[lit("gpuVendor")] = (uint32_t)m_Ctx.APIProps().vendor;
+  root[lit("counters")] = counters;
+  root[lit("results")] = values;
+
+  QString json = VariantToJSON(root);
+
+  SectionProperties props;
+  props.type = SectionType::PerformanceCounters;
+  props.version = 1;
+  // the results scale with event count times counter count and JSON is verbose, so compress
+  props.flags = SectionFlags::ZstdCompressed;
+
+  m_Ctx.Replay().GetCaptureAccess()->WriteSection(props, json.toUtf8());
+}
+
+void PerformanceCounterViewer::LoadSavedCounterResults(IReplayController *controller)
+{
+  ICaptureAccess *access = m_Ctx.Replay().GetCaptureAccess();
+
+  if(!access)
+    return;
+
+  int idx = access->FindSectionByType(SectionType::PerformanceCounters);
+  if(idx < 0)
+    return;
+
+  bytebuf buf = access->GetSectionContents(idx);
+
+  QVariantMap root = JSONToVariant(QString::fromUtf8((const char *)buf.data(), buf.count()));
+
+  if(root[lit("gpuVendor")].toUInt() != (uint32_t)m_Ctx.APIProps().vendor)
+    return;
+
+  QMap<GPUCounter, CounterDescription> counterDescriptions;
+  QMap<GPUCounter, int> counterIndex;
+  QList<GPUCounter> selected;
+
+  // the saved counter list is in ascending counter order, matching the QMap iteration order that
+  // the table headers are built in, so indexing counters as they're read keeps columns aligned.
+  for(const QVariant &v : root[lit("counters")].toList())
+  {
+    QVariantMap counter = v.toMap();
+
+    CounterDescription desc;
+    desc.counter = (GPUCounter)counter[lit("counter")].toUInt();
+    desc.name = counter[lit("name")].toString();
+    desc.category = counter[lit("category")].toString();
+    desc.description = counter[lit("description")].toString();
+    desc.resultType = (CompType)counter[lit("resultType")].toUInt();
+    desc.resultByteWidth = counter[lit("resultByteWidth")].toUInt();
+    desc.unit = (CounterUnit)counter[lit("unit")].toUInt();
+
+    QVariantList uuid = counter[lit("uuid")].toList();
+    for(int i = 0; i < 4 && i < uuid.count(); i++)
+      desc.uuid.words[i] = uuid[i].toUInt();
+
+    // saved results are only valid if the counter still means the same thing on this replay,
+    // e.g. the same driver exposing the same hardware-specific counters.
+    if(!(controller->DescribeCounter(desc.counter).uuid == desc.uuid))
+      return;
+
+    counterIndex.insert(desc.counter, counterIndex.count());
+    counterDescriptions.insert(desc.counter, desc);
+    selected.push_back(desc.counter);
+  }
+
+  if(counterDescriptions.isEmpty())
+    return;
+
+  const QVariantList saved = root[lit("results")].toList();
+
+  rdcarray<CounterResult> results;
+  results.reserve(saved.count());
+
+  for(const QVariant &v : saved)
+  {
+    QVariantMap value = v.toMap();
+
+    CounterResult result;
+    result.eventId = value[lit("eventId")].toUInt();
+    result.counter = (GPUCounter)value[lit("counter")].toUInt();
+
+    auto it = counterDescriptions.find(result.counter);
+    if(it == counterDescriptions.end())
+      continue;
+
+    if(it->resultType == CompType::Float)
+      result.value.f = value[lit("value")].toFloat();
+    else if(it->resultType == CompType::Double)
+      result.value.d = value[lit("value")].toDouble();
+    else if(it->resultByteWidth == 8)
+      result.value.u64 = value[lit("value")].toULongLong();
+    else
+      result.value.u32 = value[lit("value")].toUInt();
+
+    results.push_back(result);
+  }
+
+  GUIInvoke::call(this, [this, counterDescriptions, counterIndex, selected, results]() {
+    // start any re-profile from the same counter selection as the saved sweep
+    m_SelectedCounters = selected;
+
+    SetupCounterTable(counterDescriptions);
+
+    QMap<uint32_t, int> eventIdToRow;
+    AddCounterRows(results, counterDescriptions, counterIndex, eventIdToRow);
+
+    FinishCounterTable();
+  });
 }
 
 void PerformanceCounterViewer::OnCaptureClosed()
@@ -279,6 +486,17 @@ void PerformanceCounterViewer::OnCaptureLoaded()
 {
   ui->captureCounters->setEnabled(true);
   ui->saveCSV->setEnabled(true);
+
+  // counter sweeps are expensive, so if a previous sweep was saved into the capture restore it
+  // instead of starting from an empty table.
+  QPointer<PerformanceCounterViewer> me(this);
+
+  m_Ctx.Replay().AsyncInvoke([this, me](IReplayController *controller) {
+    if(!me)
+      return;
+
+    LoadSavedCounterResults(controller);
+  });
 }
 
 void PerformanceCounterViewer::OnEventChanged(uint32_t eventId)
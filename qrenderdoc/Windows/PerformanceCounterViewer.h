@@ -25,6 +25,7 @@
 #pragma once
 
 #include <QFrame>
+#include <QMap>
 #include "Code/Interface/QRDInterface.h"
 
 namespace Ui
@@ -58,6 +59,16 @@ private:
   QTableWidgetItem *MakeCounterResultItem(const CounterResult &result,
                                           const CounterDescription &description);
 
+  void SetupCounterTable(const QMap<GPUCounter, CounterDescription> &descriptions);
+  void AddCounterRows(const rdcarray<CounterResult> &results,
+                      const QMap<GPUCounter, CounterDescription> &descriptions,
+                      const QMap<GPUCounter, int> &counterIndex, QMap<uint32_t, int> &eventIdToRow);
+  void FinishCounterTable();
+
+  void SaveCounterResults(const QMap<GPUCounter, CounterDescription> &descriptions,
+                          const rdcarray<CounterResult> &results);
+  void LoadSavedCounterResults(IReplayController *controller);
+
   QList<GPUCounter> m_SelectedCounters;
 
   Ui::PerformanceCounterViewer *ui;
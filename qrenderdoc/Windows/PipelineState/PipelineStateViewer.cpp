@@ -126,12 +126,24 @@ void PipelineStateViewer::OnCaptureLoaded()
 
 void PipelineStateViewer::OnCaptureClosed()
 {
+  m_EventStale = false;
+
   if(m_Current)
     m_Current->OnCaptureClosed();
 }
 
 void PipelineStateViewer::OnEventChanged(uint32_t eventId)
 {
+  // repopulating every stage's widgets is expensive, and wasted work if the user is scrubbing
+  // events with this window tabbed away. Defer the update until we're next shown.
+  if(!isVisible())
+  {
+    m_EventStale = true;
+    return;
+  }
+
+  m_EventStale = false;
+
   if(m_Ctx.APIProps().pipelineType == GraphicsAPI::D3D11)
     setToD3D11();
   else if(m_Ctx.APIProps().pipelineType == GraphicsAPI::D3D12)
@@ -145,6 +157,13 @@ void PipelineStateViewer::OnEventChanged(uint32_t eventId)
     m_Current->OnEventChanged(eventId);
 }
 
+void PipelineStateViewer::showEvent(QShowEvent *event)
+{
+  // catch up with any event change that was deferred while we were hidden
+  if(m_EventStale && m_Ctx.IsCaptureLoaded())
+    OnEventChanged(m_Ctx.CurEvent());
+}
+
 QString PipelineStateViewer::GetCurrentAPI()
 {
   if(m_Current == m_D3D11)
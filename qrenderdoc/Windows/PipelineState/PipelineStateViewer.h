@@ -85,6 +85,9 @@ public:
 public slots:
   void shaderEdit_clicked();
 
+protected:
+  void showEvent(QShowEvent *event) override;
+
 private:
   Ui::PipelineStateViewer *ui;
   ICaptureContext &m_Ctx;
@@ -113,6 +116,10 @@ private:
 
   QString GetCurrentAPI();
 
+  // true when an event change arrived while we were hidden and the current viewer's widgets
+  // haven't been updated for it yet
+  bool m_EventStale = false;
+
   D3D11PipelineStateViewer *m_D3D11;
   D3D12PipelineStateViewer *m_D3D12;
   GLPipelineStateViewer *m_GL;
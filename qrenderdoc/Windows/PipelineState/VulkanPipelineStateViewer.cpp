@@ -681,6 +681,9 @@ void VulkanPipelineStateViewer::clearState()
 {
   m_CombinedImageSamplers.clear();
 
+  for(size_t i = 0; i < ARRAY_COUNT(m_StaleShaderState); i++)
+    m_StaleShaderState[i] = false;
+
   m_VBNodes.clear();
   m_BindNodes.clear();
   m_EmptyNodes.clear();
@@ -1770,6 +1773,70 @@ void VulkanPipelineStateViewer::setShaderState(const VKPipe::Shader &stage,
   ubos->applyExpansion(expansion, bindsetKeygen);
 }
 
+void VulkanPipelineStateViewer::setShaderState(int tabIndex)
+{
+  const VKPipe::State *state = m_Ctx.CurVulkanPipelineState();
+
+  if(state == NULL)
+    return;
+
+  const VKPipe::Shader *stage = NULL;
+  RDLabel *shader = NULL;
+  RDTreeWidget *res = NULL;
+  RDTreeWidget *ubo = NULL;
+
+  switch(tabIndex)
+  {
+    case 1:
+      stage = &state->vertexShader;
+      shader = ui->vsShader;
+      res = ui->vsResources;
+      ubo = ui->vsUBOs;
+      break;
+    case 2:
+      stage = &state->tessControlShader;
+      shader = ui->tcsShader;
+      res = ui->tcsResources;
+      ubo = ui->tcsUBOs;
+      break;
+    case 3:
+      stage = &state->tessEvalShader;
+      shader = ui->tesShader;
+      res = ui->tesResources;
+      ubo = ui->tesUBOs;
+      break;
+    case 4:
+      stage = &state->geometryShader;
+      shader = ui->gsShader;
+      res = ui->gsResources;
+      ubo = ui->gsUBOs;
+      break;
+    case 6:
+      stage = &state->fragmentShader;
+      shader = ui->fsShader;
+      res = ui->fsResources;
+      ubo = ui->fsUBOs;
+      break;
+    case 8:
+      stage = &state->computeShader;
+      shader = ui->csShader;
+      res = ui->csResources;
+      ubo = ui->csUBOs;
+      break;
+    default:
+      // not a shader stage tab
+      return;
+  }
+
+  if(!m_StaleShaderState[(uint32_t)stage->stage])
+    return;
+
+  m_StaleShaderState[(uint32_t)stage->stage] = false;
+
+  setShaderState(*stage, stage->stage == ShaderStage::Compute ? state->compute : state->graphics,
+                 shader, res, ubo);
+}
+
 void VulkanPipelineStateViewer::setState()
 {
   if(!m_Ctx.IsCaptureLoaded())
@@ -2060,13 +2127,13 @@ void VulkanPipelineStateViewer::setState()
   ui->viBuffers->endUpdate();
   ui->viBuffers->verticalScrollBar()->setValue(vs);
 
-  setShaderState(state.vertexShader, state.graphics, ui->vsShader, ui->vsResources, ui->vsUBOs);
-  setShaderState(state.geometryShader, state.graphics, ui->gsShader, ui->gsResources, ui->gsUBOs);
-  setShaderState(state.tessControlShader, state.graphics, ui->tcsShader, ui->tcsResources,
-                 ui->tcsUBOs);
-  setShaderState(state.tessEvalShader, state.graphics, ui->tesShader, ui->tesResources, ui->tesUBOs);
-  setShaderState(state.fragmentShader, state.graphics, ui->fsShader, ui->fsResources, ui->fsUBOs);
-  setShaderState(state.computeShader, state.compute, ui->csShader, ui->csResources, ui->csUBOs);
+  // mark every stage's shader widgets as stale and only fill in the one on the visible tab.
+  // Iterating the bindings of every descriptor set six times over dominates an event change when
+  // sets are large, and hidden tabs can be filled in when they're first selected.
+  for(size_t i = 0; i < ARRAY_COUNT(m_StaleShaderState); i++)
+    m_StaleShaderState[i] = true;
+
+  setShaderState(ui->stagesTabs->currentIndex());
 
   QToolButton *shaderButtons[] = {
       ui->vsShaderViewButton, ui->tcsShaderViewButton, ui->tesShaderViewButton,
@@ -2855,6 +2922,9 @@ void VulkanPipelineStateViewer::vertex_leave(QEvent *e)
 void VulkanPipelineStateViewer::on_pipeFlow_stageSelected(int index)
 {
   ui->stagesTabs->setCurrentIndex(index);
+
+  // fill in this stage's shader widgets if they were skipped on the last state update
+  setShaderState(index);
 }
 
 void VulkanPipelineStateViewer::shaderView_clicked()
@@ -99,6 +99,7 @@ private:
 
   void setShaderState(const VKPipe::Shader &stage, const VKPipe::Pipeline &pipe, RDLabel *shader,
                       RDTreeWidget *res, RDTreeWidget *ubo);
+  void setShaderState(int tabIndex);
   void clearShaderState(RDLabel *shader, RDTreeWidget *res, RDTreeWidget *ubo);
   void setState();
   void clearState();
@@ -138,4 +139,8 @@ private:
 
   // from an combined image to its sampler (since we de-duplicate)
   QMap<RDTreeWidgetItem *, RDTreeWidgetItem *> m_CombinedImageSamplers;
+
+  // stages whose shader widgets weren't filled in on the last state update because their tab
+  // wasn't visible, indexed by ShaderStage. They are filled in when their tab is selected.
+  bool m_StaleShaderState[6] = {};
 };
@@ -26,6 +26,7 @@
 #include <QCollator>
 #include <QKeyEvent>
 #include <QMenu>
+#include <QVector>
 #include "Code/Resources.h"
 #include "Widgets/Extended/RDHeaderView.h"
 #include "toolwindowmanager/ToolWindowManagerArea.h"
@@ -45,6 +46,24 @@ public:
   void reset()
   {
     emit beginResetModel();
+
+    // cache the name and filter strings. The filter model queries every row on each keystroke and
+    // each sort comparison, and building these on the fly from the resource name cache lags typing
+    // badly on captures with very large resource counts. reset() is called whenever names change,
+    // so the cache can't go stale.
+    const rdcarray<ResourceDescription> &resources = m_Ctx.GetResources();
+
+    m_Names.clear();
+    m_Names.reserve(resources.count());
+    m_FilterStrings.clear();
+    m_FilterStrings.reserve(resources.count());
+
+    for(const ResourceDescription &res : resources)
+    {
+      m_Names.push_back(m_Ctx.GetResourceName(res.resourceId));
+      m_FilterStrings.push_back(ToQStr(res.type) + lit(" ") + m_Names.back());
+    }
+
     emit endResetModel();
   }
 
@@ -81,13 +100,23 @@ public:
         const ResourceDescription &desc = resources[index.row()];
 
         if(role == Qt::DisplayRole)
+        {
+          if(index.row() < m_Names.count())
+            return m_Names[index.row()];
+
           return m_Ctx.GetResourceName(desc.resourceId);
+        }
 
         if(role == ResourceIdRole)
           return QVariant::fromValue(desc.resourceId);
 
         if(role == FilterRole)
+        {
+          if(index.row() < m_FilterStrings.count())
+            return m_FilterStrings[index.row()];
+
           return ToQStr(desc.type) + lit(" ") + m_Ctx.GetResourceName(desc.resourceId);
+        }
       }
     }
 
@@ -96,6 +125,10 @@ public:
 
 private:
   ICaptureContext &m_Ctx;
+
+  // cached per-row strings, rebuilt in reset() - see above
+  QVector<QString> m_Names;
+  QVector<QString> m_FilterStrings;
 };
 
 ResourceInspector::ResourceInspector(ICaptureContext &ctx, QWidget *parent)
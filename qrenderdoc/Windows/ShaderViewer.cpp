@@ -663,14 +663,17 @@ void ShaderViewer::debugShader(const ShaderBindpointMapping *bind, const ShaderR
     cacheResources();
 
     m_Ctx.Replay().AsyncInvoke([this](IReplayController *r) {
-      rdcarray<ShaderDebugState> states = r->ContinueDebug(m_Trace->debugger);
+      // compress the trace page by page as it's fetched, so that even a multi-million state trace
+      // never has all of its states resident at once
+      CompressedShaderDebugStates states;
+      states.append(r->ContinueDebug(m_Trace->debugger));
 
       bool finished = false;
       do
       {
         rdcarray<ShaderDebugState> nextStates = r->ContinueDebug(m_Trace->debugger);
-        states.append(nextStates);
         finished = nextStates.empty();
+        states.append(std::move(nextStates));
       } while(!finished);
 
       r->SetFrameEvent(m_Ctx.CurEvent(), true);
@@ -1005,7 +1008,10 @@ ScintillaEdit *ShaderViewer::MakeEditor(const QString &name, const QString &text
   ret->setScrollWidth(1);
   ret->setScrollWidthTracking(true);
 
-  ret->colourise(0, -1);
+  // if the document was small enough to style eagerly, do it all now. Otherwise
+  // SetTextAndUpdateMargin0 above enabled idle styling and it happens in the background.
+  if(ret->idleStyling() == SC_IDLESTYLING_NONE)
+    ret->colourise(0, -1);
 
   ret->emptyUndoBuffer();
 
@@ -1016,6 +1022,12 @@ void ShaderViewer::SetTextAndUpdateMargin0(ScintillaEdit *sc, const QString &tex
 {
   sc->setText(text.toUtf8().data());
 
+  // for huge documents - such as multi-megabyte disassembly - styling everything up-front blocks
+  // the UI for seconds. Style the visible screen on demand and let scintilla lex the rest in the
+  // background during idle time.
+  if(sc->length() > 1024 * 1024)
+    sc->setIdleStyling(SC_IDLESTYLING_AFTERVISIBLE);
+
   sptr_t numlines = sc->lineCount();
 
   int margin0width = 30;
@@ -1704,6 +1716,11 @@ void ShaderViewer::applyBackwardsChange()
 
     for(const ShaderVariableChange &c : GetCurrentState().changes)
     {
+      if(!c.before.name.empty())
+        m_VariablesChanged.insert(c.before.name);
+      if(!c.after.name.empty())
+        m_VariablesChanged.insert(c.after.name);
+
       // if the before name is empty, this is a variable that came into scope/was created
       if(c.before.name.empty())
       {
@@ -1725,6 +1742,8 @@ void ShaderViewer::applyBackwardsChange()
             break;
           }
         }
+
+        m_VariableListChanged = true;
       }
       else
       {
@@ -1745,9 +1764,14 @@ void ShaderViewer::applyBackwardsChange()
       }
     }
 
+    if(!newVariables.empty())
+      m_VariableListChanged = true;
+
     m_Variables.insert(0, newVariables);
 
     m_CurrentStateIdx--;
+
+    m_StepUpdate = true;
   }
 }
 
@@ -1762,6 +1786,11 @@ void ShaderViewer::applyForwardsChange()
 
     for(const ShaderVariableChange &c : GetCurrentState().changes)
     {
+      if(!c.before.name.empty())
+        m_VariablesChanged.insert(c.before.name);
+      if(!c.after.name.empty())
+        m_VariablesChanged.insert(c.after.name);
+
       // if the after name is empty, this is a variable going out of scope/being deleted
       if(c.after.name.empty())
       {
@@ -1774,6 +1803,8 @@ void ShaderViewer::applyForwardsChange()
             break;
           }
         }
+
+        m_VariableListChanged = true;
       }
       else
       {
@@ -1810,8 +1841,13 @@ void ShaderViewer::applyForwardsChange()
       }
     }
 
+    if(!newVariables.empty() || !newAccessedResources.empty())
+      m_VariableListChanged = true;
+
     m_Variables.insert(0, newVariables);
     m_AccessedResources.insert(0, newAccessedResources);
+
+    m_StepUpdate = true;
   }
 }
 
@@ -2667,117 +2703,189 @@ void ShaderViewer::updateDebugState()
     }
   }
 
+  // the set of variables modified by the current step, for highlighting
+  QSet<QString> curChanges;
+  for(const ShaderVariableChange &c : state.changes)
   {
-    RDTreeViewExpansionState expansion;
-    ui->sourceVars->saveExpansion(expansion, 0);
+    if(!c.before.name.empty())
+      curChanges.insert(c.before.name);
+    if(!c.after.name.empty())
+      curChanges.insert(c.after.name);
+  }
 
-    ui->sourceVars->beginUpdate();
+  {
+    const rdcarray<SourceVariableMapping> &sourceVars = state.sourceVars;
 
-    ui->sourceVars->clear();
+    // when stepping, the tree only needs rebuilding if the set of live locals or their mappings
+    // changed, a register one of them is built from changed, or there are highlights to clear
+    bool rebuild = !m_StepUpdate || m_SourceVarsHighlighted || !(m_PrevSourceVars == sourceVars);
 
-    RDTreeWidgetItem fakeroot;
+    for(size_t lidx = 0; !rebuild && lidx < sourceVars.size(); lidx++)
+    {
+      for(const DebugVariableReference &v : sourceVars[lidx].variables)
+      {
+        rdcstr base = v.name;
+        int offs = base.find_first_of("[.");
+        if(offs > 0)
+          base = v.name.substr(0, offs);
 
-    const rdcarray<SourceVariableMapping> &sourceVars = state.sourceVars;
+        if(m_VariablesChanged.contains(v.name) || m_VariablesChanged.contains(base))
+        {
+          rebuild = true;
+          break;
+        }
+      }
+    }
 
-    for(size_t lidx = 0; lidx < sourceVars.size(); lidx++)
+    if(rebuild)
     {
-      int32_t localVarIdx = int32_t(sourceVars.size() - 1 - lidx);
+      RDTreeViewExpansionState expansion;
+      ui->sourceVars->saveExpansion(expansion, 0);
 
-      // iterate in reverse order, so newest locals tend to end up on top
-      const SourceVariableMapping &l = sourceVars[localVarIdx];
+      ui->sourceVars->beginUpdate();
 
-      bool modified = false;
+      ui->sourceVars->clear();
 
-      // don't list any modified variables on the first step when they all come into existance
-      if(l.variables[0].type == DebugVariableType::Variable && !IsFirstState())
+      RDTreeWidgetItem fakeroot;
+
+      m_SourceVarsHighlighted = false;
+
+      for(size_t lidx = 0; lidx < sourceVars.size(); lidx++)
       {
-        for(const DebugVariableReference &v : l.variables)
-        {
-          rdcstr base = v.name;
-          int offs = base.find_first_of("[.");
-          if(offs > 0)
-            base = v.name.substr(0, offs);
+        int32_t localVarIdx = int32_t(sourceVars.size() - 1 - lidx);
 
-          for(const ShaderVariableChange &c : GetCurrentState().changes)
+        // iterate in reverse order, so newest locals tend to end up on top
+        const SourceVariableMapping &l = sourceVars[localVarIdx];
+
+        bool modified = false;
+
+        // don't list any modified variables on the first step when they all come into existance
+        if(l.variables[0].type == DebugVariableType::Variable && !IsFirstState())
+        {
+          for(const DebugVariableReference &v : l.variables)
           {
-            if(c.before.name == v.name || c.after.name == v.name || c.before.name == base ||
-               c.after.name == base)
+            rdcstr base = v.name;
+            int offs = base.find_first_of("[.");
+            if(offs > 0)
+              base = v.name.substr(0, offs);
+
+            if(curChanges.contains(v.name) || curChanges.contains(base))
             {
               modified = true;
               break;
             }
           }
-
-          if(modified)
-            break;
         }
-      }
 
-      RDTreeWidgetItem *node = makeSourceVariableNode(l, -1, localVarIdx, modified);
+        if(modified)
+          m_SourceVarsHighlighted = true;
 
-      fakeroot.addChild(node);
-    }
+        RDTreeWidgetItem *node = makeSourceVariableNode(l, -1, localVarIdx, modified);
 
-    // recursively combine nodes with the same prefix together
-    combineStructures(&fakeroot);
+        fakeroot.addChild(node);
+      }
 
-    while(fakeroot.childCount() > 0)
-      ui->sourceVars->addTopLevelItem(fakeroot.takeChild(0));
+      // recursively combine nodes with the same prefix together
+      combineStructures(&fakeroot);
+
+      while(fakeroot.childCount() > 0)
+        ui->sourceVars->addTopLevelItem(fakeroot.takeChild(0));
+
+      ui->sourceVars->endUpdate();
 
-    ui->sourceVars->endUpdate();
+      ui->sourceVars->applyExpansion(expansion, 0);
 
-    ui->sourceVars->applyExpansion(expansion, 0);
+      m_PrevSourceVars = sourceVars;
+    }
   }
 
   {
-    RDTreeViewExpansionState expansion;
-    ui->debugVars->saveExpansion(expansion, 0);
+    // the list of debug variables only changes when variables come into or go out of scope. While
+    // stepping within the same set we update the tree in place and only refresh rows whose
+    // variable changed since the last update, so the cost scales with the number of changes
+    // rather than the number of live variables.
+    bool rebuild = !m_StepUpdate || m_VariableListChanged ||
+                   ui->debugVars->topLevelItemCount() != m_Variables.count();
+
+    if(!rebuild)
+    {
+      ui->debugVars->beginUpdate();
 
-    ui->debugVars->beginUpdate();
+      for(int i = 0; i < m_Variables.count(); i++)
+      {
+        bool modified = curChanges.contains(m_Variables[i].name);
 
-    ui->debugVars->clear();
+        RDTreeWidgetItem *node = ui->debugVars->topLevelItem(i);
 
-    for(int i = 0; i < m_Variables.count(); i++)
-    {
-      bool modified = false;
+        // untouched rows keep their existing formatted values. A row needs refreshing if its
+        // variable changed since the last update, or to clear a highlight from a previous step
+        if(!modified && !m_VariablesChanged.contains(m_Variables[i].name) &&
+           node->foreground() == QBrush())
+          continue;
 
-      for(const ShaderVariableChange &c : GetCurrentState().changes)
-      {
-        if(c.before.name == m_Variables[i].name || c.after.name == m_Variables[i].name)
+        if(!updateDebugVariableNode(node, m_Variables[i], modified))
         {
-          modified = true;
-          break;
+          // the variable's structure changed - remake just this subtree
+          delete ui->debugVars->takeTopLevelItem(i);
+          ui->debugVars->invisibleRootItem()->insertChild(
+              i, makeDebugVariableNode(m_Variables[i], "", modified));
         }
       }
 
-      ui->debugVars->addTopLevelItem(makeDebugVariableNode(m_Variables[i], "", modified));
+      ui->debugVars->endUpdate();
     }
+    else
+    {
+      RDTreeViewExpansionState expansion;
+      ui->debugVars->saveExpansion(expansion, 0);
+
+      ui->debugVars->beginUpdate();
+
+      ui->debugVars->clear();
+
+      for(int i = 0; i < m_Variables.count(); i++)
+      {
+        bool modified = curChanges.contains(m_Variables[i].name);
+
+        ui->debugVars->addTopLevelItem(makeDebugVariableNode(m_Variables[i], "", modified));
+      }
 
-    ui->debugVars->endUpdate();
+      ui->debugVars->endUpdate();
 
-    ui->debugVars->applyExpansion(expansion, 0);
+      ui->debugVars->applyExpansion(expansion, 0);
+    }
   }
 
   {
+    bool rebuild = !m_StepUpdate || m_VariableListChanged ||
+                   ui->accessedResources->topLevelItemCount() != m_AccessedResources.count();
+
     ui->accessedResources->beginUpdate();
 
-    ui->accessedResources->clear();
+    if(!rebuild)
+    {
+      // the resources themselves don't change while stepping, only the highlights do
+      for(int i = 0; i < m_AccessedResources.count(); i++)
+      {
+        RDTreeWidgetItem *node = ui->accessedResources->topLevelItem(i);
 
-    for(int i = 0; i < m_AccessedResources.count(); i++)
+        if(curChanges.contains(m_AccessedResources[i].name))
+          node->setForegroundColor(QColor(Qt::red));
+        else if(node->foreground() != QBrush())
+          node->setForeground(QBrush());
+      }
+    }
+    else
     {
-      bool modified = false;
+      ui->accessedResources->clear();
 
-      for(const ShaderVariableChange &c : GetCurrentState().changes)
+      for(int i = 0; i < m_AccessedResources.count(); i++)
       {
-        if(c.before.name == m_AccessedResources[i].name || c.after.name == m_AccessedResources[i].name)
-        {
-          modified = true;
-          break;
-        }
-      }
+        bool modified = curChanges.contains(m_AccessedResources[i].name);
 
-      ui->accessedResources->addTopLevelItem(
-          makeAccessedResourceNode(m_AccessedResources[i], modified));
+        ui->accessedResources->addTopLevelItem(
+            makeAccessedResourceNode(m_AccessedResources[i], modified));
+      }
     }
 
     ui->accessedResources->endUpdate();
@@ -2789,6 +2897,11 @@ void ShaderViewer::updateDebugState()
   ui->debugVars->resizeColumnToContents(1);
 
   updateVariableTooltip();
+
+  // changes accumulated since the last update have now been consumed
+  m_VariablesChanged.clear();
+  m_VariableListChanged = false;
+  m_StepUpdate = false;
 }
 
 void ShaderViewer::updateWatchVariables()
@@ -3327,6 +3440,48 @@ RDTreeWidgetItem *ShaderViewer::makeDebugVariableNode(const ShaderVariable &v, r
   return node;
 }
 
+bool ShaderViewer::updateDebugVariableNode(RDTreeWidgetItem *node, const ShaderVariable &v,
+                                           bool modified)
+{
+  // refreshes in place a node made by makeDebugVariableNode. Returns false if the tree doesn't
+  // match the variable any more, in which case the caller remakes the node from scratch
+  if(node->text(0) != QString(v.name))
+    return false;
+
+  node->setText(1, v.rows == 1 && v.members.empty() ? stringRep(v) : QString());
+
+  int childIdx = 0;
+
+  for(const ShaderVariable &m : v.members)
+  {
+    if(childIdx >= node->childCount() || !updateDebugVariableNode(node->child(childIdx), m, modified))
+      return false;
+    childIdx++;
+  }
+
+  // matrices with no explicit row members have their rows added as children
+  if(v.members.empty() && v.rows > 1)
+  {
+    for(uint32_t row = 0; row < v.rows; row++)
+    {
+      if(childIdx >= node->childCount())
+        return false;
+      node->child(childIdx)->setText(1, stringRep(v, row));
+      childIdx++;
+    }
+  }
+
+  if(childIdx != node->childCount())
+    return false;
+
+  if(modified)
+    node->setForegroundColor(QColor(Qt::red));
+  else if(node->foreground() != QBrush())
+    node->setForeground(QBrush());
+
+  return true;
+}
+
 RDTreeWidgetItem *ShaderViewer::makeAccessedResourceNode(const ShaderVariable &v, bool modified)
 {
   BindpointIndex bp = v.GetBinding();
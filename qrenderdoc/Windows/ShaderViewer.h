@@ -25,7 +25,9 @@
 #pragma once
 
 #include <QFrame>
+#include <QSet>
 #include "Code/Interface/QRDInterface.h"
+#include "Code/ShaderDebugStates.h"
 
 namespace Ui
 {
@@ -235,10 +237,20 @@ private:
   CloseCallback m_CloseCallback;
 
   ShaderDebugTrace *m_Trace = NULL;
-  rdcarray<ShaderDebugState> m_States;
+  CompressedShaderDebugStates m_States;
   size_t m_CurrentStateIdx = 0;
   rdcarray<ShaderVariable> m_Variables;
   rdcarray<ShaderVariable> m_AccessedResources;
+  // book-keeping from applyForwardsChange/applyBackwardsChange so that updateDebugState() can
+  // refresh only the rows that changed since the last update, instead of rebuilding the variable
+  // trees from scratch on every step
+  QSet<QString> m_VariablesChanged;
+  bool m_VariableListChanged = false;
+  bool m_StepUpdate = false;
+  // the source variable mappings displayed by the last update, and whether any were highlighted as
+  // modified, so that steps which don't touch a mapped register can leave the tree alone
+  rdcarray<SourceVariableMapping> m_PrevSourceVars;
+  bool m_SourceVarsHighlighted = false;
   rdcarray<BoundResourceArray> m_ReadOnlyResources;
   rdcarray<BoundResourceArray> m_ReadWriteResources;
   QList<int> m_Breakpoints;
@@ -284,6 +296,7 @@ private:
   RDTreeWidgetItem *makeSourceVariableNode(const SourceVariableMapping &l, int globalVarIdx,
                                            int localVarIdx, bool modified);
   RDTreeWidgetItem *makeDebugVariableNode(const ShaderVariable &v, rdcstr prefix, bool modified);
+  bool updateDebugVariableNode(RDTreeWidgetItem *node, const ShaderVariable &v, bool modified);
   RDTreeWidgetItem *makeAccessedResourceNode(const ShaderVariable &v, bool modified);
 
   const ShaderVariable *GetDebugVariable(const DebugVariableReference &r);
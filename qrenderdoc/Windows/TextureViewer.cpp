@@ -2214,20 +2214,16 @@ void TextureViewer::InitResourcePreview(ResourcePreview *prev, BoundResource res
 
     if(m_Ctx.GetTexture(res.resourceId))
     {
-      m_Ctx.Replay().AsyncInvoke([this, winData, res](IReplayController *) {
-        Subresource sub = {0, 0, ~0U};
-        if(res.firstMip >= 0)
-          sub.mip = res.firstMip;
-        if(res.firstSlice >= 0)
-          sub.slice = res.firstSlice;
-        m_Output->AddThumbnail(winData, res.resourceId, sub, res.typeCast);
-      });
+      Subresource sub = {0, 0, ~0U};
+      if(res.firstMip >= 0)
+        sub.mip = res.firstMip;
+      if(res.firstSlice >= 0)
+        sub.slice = res.firstSlice;
+      m_PendingThumbnails.push_back({winData, res.resourceId, sub, res.typeCast});
     }
     else
     {
-      m_Ctx.Replay().AsyncInvoke([this, winData](IReplayController *) {
-        m_Output->AddThumbnail(winData, ResourceId(), {0, 0, ~0U}, CompType::Typeless);
-      });
+      m_PendingThumbnails.push_back({winData, ResourceId(), {0, 0, ~0U}, CompType::Typeless});
     }
 
     prev->setProperty("f", QVariant::fromValue(follow));
@@ -2242,9 +2238,7 @@ void TextureViewer::InitResourcePreview(ResourcePreview *prev, BoundResource res
     prev->setSelected(true);
 
     WindowingData winData = m_Ctx.CreateWindowingData(prev->thumbWidget());
-    m_Ctx.Replay().AsyncInvoke([this, winData](IReplayController *) {
-      m_Output->AddThumbnail(winData, ResourceId(), {0, 0, ~0U}, CompType::Typeless);
-    });
+    m_PendingThumbnails.push_back({winData, ResourceId(), {0, 0, ~0U}, CompType::Typeless});
   }
   else
   {
@@ -2254,6 +2248,20 @@ void TextureViewer::InitResourcePreview(ResourcePreview *prev, BoundResource res
   }
 }
 
+void TextureViewer::FlushThumbnailUpdates()
+{
+  if(m_PendingThumbnails.isEmpty())
+    return;
+
+  QVector<PendingThumbnail> thumbs;
+  thumbs.swap(m_PendingThumbnails);
+
+  m_Ctx.Replay().AsyncInvoke([this, thumbs](IReplayController *) {
+    for(const PendingThumbnail &t : thumbs)
+      m_Output->AddThumbnail(t.winData, t.id, t.sub, t.typeCast);
+  });
+}
+
 void TextureViewer::InitStageResourcePreviews(ShaderStage stage,
                                               const rdcarray<ShaderResource> &resourceDetails,
                                               const rdcarray<Bindpoint> &mapping,
@@ -3059,6 +3067,10 @@ void TextureViewer::OnEventChanged(uint32_t eventId)
 
   ui->inputThumbs->refreshLayout();
 
+  // push all the thumbnail updates in one replay invoke, so an event change doesn't serialise
+  // behind a dozen individually queued texture renders
+  FlushThumbnailUpdates();
+
   INVOKE_MEMFN(RT_UpdateAndDisplay);
 
   if(ui->autoFit->isChecked())
@@ -3854,14 +3866,70 @@ void TextureViewer::on_pixelHistory_clicked()
   LambdaThread *thread = new LambdaThread([this, texptr, x, y, hist, histWidget]() {
     QThread::msleep(150);
     m_Ctx.Replay().AsyncInvoke([this, texptr, x, y, hist, histWidget](IReplayController *r) {
-      rdcarray<PixelModification> history =
-          r->PixelHistory(texptr->resourceId, (uint32_t)x, (int32_t)y, m_TexDisplay.subresource,
-                          m_TexDisplay.typeCast);
+      uint32_t curEvent = m_Ctx.CurEvent();
 
-      GUIInvoke::call(this, [hist, histWidget, history] {
-        if(histWidget)
-          hist->SetHistory(history);
-      });
+      // find an event splitting off the first few potential modifications, so the top of the
+      // history can be displayed while the rest of the (possibly very long) search runs.
+      rdcarray<EventUsage> usage = r->GetUsage(texptr->resourceId);
+
+      uint32_t splitEventId = 0;
+      int writes = 0;
+      for(const EventUsage &u : usage)
+      {
+        if(u.eventId > curEvent)
+          break;
+
+        // count potential writes - the same classification the timeline bar uses
+        if(((int)u.usage >= (int)ResourceUsage::VS_RWResource &&
+            (int)u.usage <= (int)ResourceUsage::All_RWResource) ||
+           u.usage == ResourceUsage::ColorTarget || u.usage == ResourceUsage::DepthStencilTarget ||
+           u.usage == ResourceUsage::Clear || u.usage == ResourceUsage::GenMips ||
+           u.usage == ResourceUsage::Copy || u.usage == ResourceUsage::CopyDst ||
+           u.usage == ResourceUsage::Resolve || u.usage == ResourceUsage::ResolveDst ||
+           u.usage == ResourceUsage::StreamOut)
+        {
+          splitEventId = u.eventId;
+          writes++;
+
+          if(writes >= 8)
+            break;
+        }
+      }
+
+      if(writes >= 8 && splitEventId < curEvent)
+      {
+        // resolve and display the first few modifications immediately, then fill in the rest.
+        // This costs one extra partial pass over the frame but the first results appear orders
+        // of magnitude sooner on heavily-written targets.
+        rdcarray<PixelModification> history =
+            r->PixelHistoryRange(texptr->resourceId, (uint32_t)x, (int32_t)y,
+                                 m_TexDisplay.subresource, m_TexDisplay.typeCast, 0, splitEventId);
+
+        GUIInvoke::call(this, [hist, histWidget, history] {
+          if(histWidget)
+            hist->SetHistory(history);
+        });
+
+        rdcarray<PixelModification> remainder = r->PixelHistoryRange(
+            texptr->resourceId, (uint32_t)x, (int32_t)y, m_TexDisplay.subresource,
+            m_TexDisplay.typeCast, splitEventId + 1, curEvent);
+
+        GUIInvoke::call(this, [hist, histWidget, remainder] {
+          if(histWidget)
+            hist->SetHistory(remainder);
+        });
+      }
+      else
+      {
+        rdcarray<PixelModification> history =
+            r->PixelHistory(texptr->resourceId, (uint32_t)x, (int32_t)y, m_TexDisplay.subresource,
+                            m_TexDisplay.typeCast);
+
+        GUIInvoke::call(this, [hist, histWidget, history] {
+          if(histWidget)
+            hist->SetHistory(history);
+        });
+      }
     });
   });
   thread->selfDelete(true);
@@ -28,6 +28,7 @@
 #include <QMenu>
 #include <QMouseEvent>
 #include <QTime>
+#include <QVector>
 #include "Code/Interface/QRDInterface.h"
 
 namespace Ui
@@ -252,6 +253,7 @@ private:
   void UI_CreateThumbnails();
   void InitResourcePreview(ResourcePreview *prev, BoundResource res, bool force, Following &follow,
                            const QString &bindName, const QString &slotName);
+  void FlushThumbnailUpdates();
 
   void InitStageResourcePreviews(ShaderStage stage, const rdcarray<ShaderResource> &resourceDetails,
                                  const rdcarray<Bindpoint> &mapping,
@@ -340,6 +342,17 @@ private:
   rdcarray<BoundResourceArray> m_ReadOnlyResources[(uint32_t)ShaderStage::Count];
   rdcarray<BoundResourceArray> m_ReadWriteResources[(uint32_t)ShaderStage::Count];
 
+  // thumbnail updates gathered during an event change, flushed in one replay invoke rather than
+  // queueing one invoke per preview
+  struct PendingThumbnail
+  {
+    WindowingData winData;
+    ResourceId id;
+    Subresource sub;
+    CompType typeCast;
+  };
+  QVector<PendingThumbnail> m_PendingThumbnails;
+
   QTime m_CustomShaderTimer;
   int m_CustomShaderWriteTime = 0;
 
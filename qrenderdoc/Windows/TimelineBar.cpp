@@ -568,9 +568,16 @@ void TimelineBar::paintEvent(QPaintEvent *e)
   QRectF labelRect = eidAxisRect;
   labelRect.setWidth(m_eidAxisLabelWidth);
 
-  // iterate through the EIDs from 0, starting from possible a negative offset if the user has
+  // start from the first label that could be visible rather than walking up from EID 0, so a
+  // heavily zoomed-in view doesn't iterate thousands of off-screen labels each paint
+  uint32_t firstLabelEID =
+      (eventAt(m_eidAxisRect.left()) / m_eidAxisLabelStep) * m_eidAxisLabelStep;
+  if(firstLabelEID >= (uint32_t)m_eidAxisLabelStep)
+    firstLabelEID -= m_eidAxisLabelStep;
+
+  // iterate through the EIDs, starting from possible a negative offset if the user has
   // panned to the right.
-  for(uint32_t i = 0; i <= maxEID; i += m_eidAxisLabelStep)
+  for(uint32_t i = firstLabelEID; i <= maxEID; i += m_eidAxisLabelStep)
   {
     labelRect.moveLeft(offsetOf(i) - labelRect.width() / 2 + m_eidWidth / 2);
 
@@ -779,14 +786,23 @@ void TimelineBar::paintEvent(QPaintEvent *e)
     qreal leftClip = -triRadius * 2.0;
     qreal rightClip = pipsRect.width() + triRadius * 10.0;
 
+    // both event lists are sorted, so binary search to the first pip that reaches the visible
+    // area and stop once past the right clip, instead of testing every event each paint
     if(!m_HistoryEvents.isEmpty())
     {
-      for(const PixelModification &mod : m_HistoryEvents)
+      auto first = std::lower_bound(m_HistoryEvents.begin(), m_HistoryEvents.end(), leftClip,
+                                    [this, triRadius](const PixelModification &mod, qreal x) {
+                                      return offsetOf(mod.eventId) + m_eidWidth / 2 - triRadius < x;
+                                    });
+
+      for(auto it = first; it != m_HistoryEvents.end(); ++it)
       {
+        const PixelModification &mod = *it;
+
         qreal pos = offsetOf(mod.eventId) + m_eidWidth / 2 - triRadius;
 
-        if(pos < leftClip || pos > rightClip)
-          continue;
+        if(pos > rightClip)
+          break;
 
         if(mod.Passed())
           pipranges[HistoryPassed].push(pos, triRadius);
@@ -796,12 +812,19 @@ void TimelineBar::paintEvent(QPaintEvent *e)
     }
     else
     {
-      for(const EventUsage &use : m_UsageEvents)
+      auto first = std::lower_bound(m_UsageEvents.begin(), m_UsageEvents.end(), leftClip,
+                                    [this, triRadius](const EventUsage &use, qreal x) {
+                                      return offsetOf(use.eventId) + m_eidWidth / 2 - triRadius < x;
+                                    });
+
+      for(auto it = first; it != m_UsageEvents.end(); ++it)
       {
+        const EventUsage &use = *it;
+
         qreal pos = offsetOf(use.eventId) + m_eidWidth / 2 - triRadius;
 
-        if(pos < leftClip || pos > rightClip)
-          continue;
+        if(pos > rightClip)
+          break;
 
         if(((int)use.usage >= (int)ResourceUsage::VS_RWResource &&
             (int)use.usage <= (int)ResourceUsage::All_RWResource) ||
@@ -906,6 +929,10 @@ void TimelineBar::paintMarkers(QPainter &p, const QVector<Marker> &markers,
 
   for(const Marker &m : markers)
   {
+    // markers are sorted by start EID, so once one begins past the right edge we're done
+    if(offsetOf(m.eidStart) > m_dataArea.right())
+      break;
+
     QRectF r = markerRect;
     r.setLeft(qMax(m_dataArea.left() + borderWidth * 3, offsetOf(m.eidStart)));
     r.setRight(qMin(m_dataArea.right() - borderWidth, offsetOf(m.eidEnd + 1)));
@@ -962,10 +989,23 @@ void TimelineBar::paintMarkers(QPainter &p, const QVector<Marker> &markers,
 
   p.setRenderHint(QPainter::Antialiasing);
 
-  for(uint32_t d : draws)
+  // the draws are sorted by EID, so binary search to the first one that reaches the visible area
+  // and stop once past the right edge - painting is then proportional to the visible width
+  // instead of the total draw count
+  const qreal drawsLeftEdge = m_dataArea.left() + borderWidth * 3;
+
+  auto firstDraw = std::lower_bound(draws.begin(), draws.end(), drawsLeftEdge,
+                                    [this](uint32_t d, qreal x) { return offsetOf(d + 1) < x; });
+
+  for(auto it = firstDraw; it != draws.end(); ++it)
   {
+    uint32_t d = *it;
+
+    if(offsetOf(d) > m_dataArea.right())
+      break;
+
     QRectF r = markerRect;
-    r.setLeft(qMax(m_dataArea.left() + borderWidth * 3, offsetOf(d)));
+    r.setLeft(qMax(drawsLeftEdge, offsetOf(d)));
     r.setRight(qMin(m_dataArea.right() - borderWidth, offsetOf(d + 1)));
     r.setHeight(fm.height() + borderWidth * 2);
 
@@ -24,6 +24,9 @@ INCLUDEPATH += $$_PRO_FILE_PWD_/
 # And relative to 3rdparty
 INCLUDEPATH += $$_PRO_FILE_PWD_/3rdparty
 
+# For lz4, which we compile in from the core renderdoc module for compressing shader debug traces
+INCLUDEPATH += $$_PRO_FILE_PWD_/../renderdoc/3rdparty
+
 # For Scintilla source builds - we unfortunately are not able to scope these to only
 # those source files
 INCLUDEPATH += $$_PRO_FILE_PWD_/3rdparty/scintilla/include/qt
@@ -172,6 +175,8 @@ SOURCES += Code/qrenderdoc.cpp \
     Code/BufferFormatter.cpp \
     Code/Resources.cpp \
     Code/RGPInterop.cpp \
+    Code/ShaderDebugStates.cpp \
+    ../renderdoc/3rdparty/lz4/lz4.c \
     Code/pyrenderdoc/PythonContext.cpp \
     Code/Interface/QRDInterface.cpp \
     Code/Interface/Analytics.cpp \
@@ -249,6 +254,7 @@ HEADERS += Code/CaptureContext.h \
     Code/QRDUtils.h \
     Code/Resources.h \
     Code/RGPInterop.h \
+    Code/ShaderDebugStates.h \
     Code/pyrenderdoc/PythonContext.h \
     Code/pyrenderdoc/pyconversion.h \
     Code/pyrenderdoc/interface_check.h \
@@ -574,10 +574,42 @@ struct AndroidRemoteServer : public RemoteServer
     {
       SCOPED_TIMER("Fetching android packages and activities");
 
-      rdcstr adbStdout = Android::adbExecCommand(m_deviceID, "shell pm list packages -3").strStdout;
+      // the package list queries are independent adb round trips, so issue them concurrently.
+      // dumpsys package can take seconds on package-heavy devices, so it's only re-queried when
+      // the package lists have changed since we last parsed it.
+      rdcstr thirdpartyOutput, systemOutput, dumpsysOutput;
+
+      {
+        Threading::TaskGroup adbQueries;
+        adbQueries.Add([this, &thirdpartyOutput]() {
+          thirdpartyOutput =
+              Android::adbExecCommand(m_deviceID, "shell pm list packages -3").strStdout;
+        });
+        adbQueries.Add([this, &systemOutput]() {
+          systemOutput = Android::adbExecCommand(m_deviceID, "shell pm list packages -s").strStdout;
+        });
+
+        // on the first enumeration there's no cache to hope for, so overlap the expensive dumpsys
+        // with the package lists too
+        if(m_PackageListCacheKey.empty())
+        {
+          adbQueries.Add([this, &dumpsysOutput]() {
+            dumpsysOutput = Android::adbExecCommand(m_deviceID, "shell dumpsys package").strStdout;
+          });
+        }
+
+        adbQueries.Wait();
+      }
+
+      // if the installed packages haven't changed, the cached list and parsed activities are
+      // still valid
+      rdcstr cacheKey = thirdpartyOutput + systemOutput;
+
+      if(!m_PackageCache.empty() && cacheKey == m_PackageListCacheKey)
+        return m_PackageCache;
 
       rdcarray<rdcstr> lines;
-      split(adbStdout, lines, '\n');
+      split(thirdpartyOutput, lines, '\n');
 
       rdcarray<PathEntry> packages;
       for(const rdcstr &line : lines)
@@ -598,10 +630,8 @@ struct AndroidRemoteServer : public RemoteServer
         }
       }
 
-      // also fetch the system packages but mark them as hidden folders
-      adbStdout = Android::adbExecCommand(m_deviceID, "shell pm list packages -s").strStdout;
-
-      split(adbStdout, lines, '\n');
+      // also the system packages, but mark them as hidden folders
+      split(systemOutput, lines, '\n');
 
       for(const rdcstr &line : lines)
       {
@@ -617,9 +647,13 @@ struct AndroidRemoteServer : public RemoteServer
         }
       }
 
-      adbStdout = Android::adbExecCommand(m_deviceID, "shell dumpsys package").strStdout;
+      if(dumpsysOutput.empty())
+        dumpsysOutput = Android::adbExecCommand(m_deviceID, "shell dumpsys package").strStdout;
 
-      split(adbStdout, lines, '\n');
+      split(dumpsysOutput, lines, '\n');
+
+      // the activities are re-parsed from scratch so entries for removed packages don't linger
+      m_AndroidActivities.clear();
 
       // not everything that looks like it's an activity is actually an activity, because of course
       // nothing is ever simple on Android. Watch out for the activity sections and only parse
@@ -694,6 +728,9 @@ struct AndroidRemoteServer : public RemoteServer
         m_AndroidActivities.insert({package, rdcstr(c, end - c)});
       }
 
+      m_PackageListCacheKey = cacheKey;
+      m_PackageCache = packages;
+
       return packages;
     }
     else
@@ -767,6 +804,10 @@ private:
   };
 
   std::set<Activity> m_AndroidActivities;
+
+  // cached root folder listing, valid while the pm list output it was parsed from is unchanged
+  rdcstr m_PackageListCacheKey;
+  rdcarray<PathEntry> m_PackageCache;
 };
 
 struct AndroidController : public IDeviceProtocolHandler
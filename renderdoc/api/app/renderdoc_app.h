@@ -213,6 +213,16 @@ typedef enum RENDERDOC_CaptureOption {
   // necessary as directed by a RenderDoc developer.
   eRENDERDOC_Option_AllowUnsupportedVendorExtensions = 12,
 
+  // Strip the per-API-call metadata (calling thread ID, CPU duration,
+  // timestamp) that is normally recorded into the capture, for smaller
+  // captures and lower per-call capture overhead.
+  //
+  // Default - disabled
+  //
+  // 1 - API calls are recorded with minimal headers and no metadata
+  // 0 - Thread ID, duration and timestamp are recorded for each API call
+  eRENDERDOC_Option_StripChunkMetadata = 13,
+
 } RENDERDOC_CaptureOption;
 
 // Sets an option that controls how RenderDoc behaves on capture.
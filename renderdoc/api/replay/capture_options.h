@@ -204,6 +204,19 @@ Default - enabled
 ``False`` - API debugging is displayed as normal.
 )");
   bool debugOutputMute;
+
+  DOCUMENT(R"(Strip the per-API-call metadata - calling thread ID, CPU duration and timestamp - that
+is normally recorded into the capture. This reduces both the cost of each recorded call and the
+size of the resulting capture, at the cost of losing that information on replay. Callstack capture,
+if enabled, is not affected by this option.
+
+Default - disabled
+
+``True`` - API calls are recorded with minimal headers and no metadata.
+
+``False`` - thread ID, duration and timestamp are recorded for each API call.
+)");
+  bool stripChunkMetadata;
 };
 
 DECLARE_REFLECTION_STRUCT(CaptureOptions);
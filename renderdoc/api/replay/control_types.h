@@ -40,6 +40,19 @@ struct MeshFormat
   MeshFormat(const MeshFormat &o) = default;
   MeshFormat &operator=(const MeshFormat &) = default;
 
+  bool operator==(const MeshFormat &o) const
+  {
+    return indexResourceId == o.indexResourceId && indexByteOffset == o.indexByteOffset &&
+           indexByteStride == o.indexByteStride && baseVertex == o.baseVertex &&
+           vertexResourceId == o.vertexResourceId && vertexByteOffset == o.vertexByteOffset &&
+           vertexByteStride == o.vertexByteStride && format == o.format &&
+           meshColor == o.meshColor && topology == o.topology && numIndices == o.numIndices &&
+           instStepRate == o.instStepRate && restartIndex == o.restartIndex &&
+           nearPlane == o.nearPlane && farPlane == o.farPlane && unproject == o.unproject &&
+           instanced == o.instanced && showAlpha == o.showAlpha && allowRestart == o.allowRestart;
+  }
+  bool operator!=(const MeshFormat &o) const { return !(*this == o); }
+
   DOCUMENT("The :class:`ResourceId` of the index buffer that goes with this mesh element.");
   ResourceId indexResourceId;
   DOCUMENT("The offset in bytes where the indices start in idxbuf.");
@@ -109,6 +122,20 @@ struct MeshDisplay
   MeshDisplay(const MeshDisplay &) = default;
   MeshDisplay &operator=(const MeshDisplay &) = default;
 
+  // NOTE: the camera is compared by pointer only - it can mutate behind the pointer, so callers
+  // that care about camera movement must check its state separately.
+  bool operator==(const MeshDisplay &o) const
+  {
+    return type == o.type && cam == o.cam && ortho == o.ortho && fov == o.fov &&
+           aspect == o.aspect && showPrevInstances == o.showPrevInstances &&
+           showAllInstances == o.showAllInstances && showWholePass == o.showWholePass &&
+           curInstance == o.curInstance && curView == o.curView &&
+           highlightVert == o.highlightVert && position == o.position && second == o.second &&
+           minBounds == o.minBounds && maxBounds == o.maxBounds && showBBox == o.showBBox &&
+           solidShadeMode == o.solidShadeMode && wireframeDraw == o.wireframeDraw;
+  }
+  bool operator!=(const MeshDisplay &o) const { return !(*this == o); }
+
   DOCUMENT("The :class:`MeshDataStage` where this mesh data comes from.");
   MeshDataStage type = MeshDataStage::Unknown;
 
@@ -185,6 +212,18 @@ struct TextureDisplay
   TextureDisplay(const TextureDisplay &) = default;
   TextureDisplay &operator=(const TextureDisplay &) = default;
 
+  bool operator==(const TextureDisplay &o) const
+  {
+    return resourceId == o.resourceId && typeCast == o.typeCast && rangeMin == o.rangeMin &&
+           rangeMax == o.rangeMax && scale == o.scale && red == o.red && green == o.green &&
+           blue == o.blue && alpha == o.alpha && flipY == o.flipY &&
+           hdrMultiplier == o.hdrMultiplier && decodeYUV == o.decodeYUV &&
+           linearDisplayAsGamma == o.linearDisplayAsGamma && customShaderId == o.customShaderId &&
+           subresource == o.subresource && rawOutput == o.rawOutput && xOffset == o.xOffset &&
+           yOffset == o.yOffset && backgroundColor == o.backgroundColor && overlay == o.overlay;
+  }
+  bool operator!=(const TextureDisplay &o) const { return !(*this == o); }
+
   DOCUMENT("The :class:`ResourceId` of the texture to display.");
   ResourceId resourceId;
 
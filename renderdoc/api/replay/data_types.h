@@ -1139,7 +1139,9 @@ DECLARE_REFLECTION_STRUCT(OutputTargetStats);
 
 DOCUMENT(R"(Contains all the available statistics about the captured frame.
 
-Currently this information is only available on D3D11 and is fairly API-centric.
+Currently the full set of information is only available on D3D11 and is fairly API-centric. Vulkan
+gathers the subset that can be read directly from the capture - draws, dispatches, buffer updates
+and vertex/index/viewport binds.
 )");
 struct FrameStatistics
 {
@@ -1260,6 +1262,39 @@ this counts the frame number when the capture was made.
 
 DECLARE_REFLECTION_STRUCT(FrameDescription);
 
+DOCUMENT(R"(Contains the wall-clock time spent in each stage of the most recent
+:meth:`ReplayController.SetFrameEvent` call, in milliseconds.
+
+This can be used to determine whether a slow event change was dominated by replaying the capture
+commands, updating active outputs, or fetching pipeline state.)");
+struct FrameEventTimings
+{
+  DOCUMENT("");
+  FrameEventTimings()
+      : replayTime(0.0f), outputsTime(0.0f), eventTime(0.0f), pipelineTime(0.0f), totalTime(0.0f)
+  {
+  }
+  FrameEventTimings(const FrameEventTimings &) = default;
+  FrameEventTimings &operator=(const FrameEventTimings &) = default;
+
+  DOCUMENT("The time spent replaying the capture commands up to the selected event.");
+  float replayTime;
+
+  DOCUMENT("The time spent updating any active outputs for the new event.");
+  float outputsTime;
+
+  DOCUMENT("The time spent replaying the selected event itself.");
+  float eventTime;
+
+  DOCUMENT("The time spent fetching the pipeline state at the selected event.");
+  float pipelineTime;
+
+  DOCUMENT("The total time spent moving to the new event.");
+  float totalTime;
+};
+
+DECLARE_REFLECTION_STRUCT(FrameEventTimings);
+
 DOCUMENT(
     "Describes a particular use of a resource at a specific :data:`eventId <APIEvent.eventId>`.");
 struct EventUsage
@@ -1340,7 +1375,9 @@ struct DrawcallDescription
   DOCUMENT("");
   DrawcallDescription() { Reset(); }
   DrawcallDescription(const DrawcallDescription &) = default;
+  DrawcallDescription(DrawcallDescription &&) = default;
   DrawcallDescription &operator=(const DrawcallDescription &) = default;
+  DrawcallDescription &operator=(DrawcallDescription &&) = default;
 
   DOCUMENT("Resets the drawcall back to a default/empty state.");
   void Reset()
@@ -1880,6 +1917,44 @@ pixel.
 
 DECLARE_REFLECTION_STRUCT(PixelModification);
 
+DOCUMENT("Identifies a single pixel shader invocation to debug, for batched pixel debugging.");
+struct PixelDebugTarget
+{
+  DOCUMENT("");
+  PixelDebugTarget(uint32_t x = 0, uint32_t y = 0, uint32_t sample = 0, uint32_t primitive = ~0U)
+      : x(x), y(y), sample(sample), primitive(primitive)
+  {
+  }
+  PixelDebugTarget(const PixelDebugTarget &) = default;
+  PixelDebugTarget &operator=(const PixelDebugTarget &) = default;
+
+  bool operator==(const PixelDebugTarget &o) const
+  {
+    return x == o.x && y == o.y && sample == o.sample && primitive == o.primitive;
+  }
+  bool operator<(const PixelDebugTarget &o) const
+  {
+    if(!(x == o.x))
+      return x < o.x;
+    if(!(y == o.y))
+      return y < o.y;
+    if(!(sample == o.sample))
+      return sample < o.sample;
+    return primitive < o.primitive;
+  }
+  DOCUMENT("The x co-ordinate, top-left based.");
+  uint32_t x;
+  DOCUMENT("The y co-ordinate, top-left based.");
+  uint32_t y;
+  DOCUMENT("The multi-sampled sample. Ignored if non-multisampled texture.");
+  uint32_t sample;
+  DOCUMENT(R"(Debug the pixel from this primitive if there's ambiguity. If set to
+:data:`NoPreference` then a random fragment writing to the given co-ordinate is debugged.)");
+  uint32_t primitive;
+};
+
+DECLARE_REFLECTION_STRUCT(PixelDebugTarget);
+
 DOCUMENT("Contains the bytes and metadata describing a thumbnail.");
 struct Thumbnail
 {
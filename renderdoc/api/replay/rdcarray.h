@@ -288,6 +288,16 @@ public:
     setUsedCount(usedCount + 1);
   }
 
+  // move overload of the above, to avoid deep copies of types with allocating members (e.g.
+  // arrays of arrays or structs containing strings)
+  void push_back(T &&el)
+  {
+    const size_t lastIdx = size();
+    reserve(size() + 1);
+    new(elems + lastIdx) T(std::move(el));
+    setUsedCount(usedCount + 1);
+  }
+
   // fill the string with 'count' copies of 'el'
   void fill(size_t count, const T &el)
   {
@@ -457,6 +457,14 @@ function must be called from another thread.
 )");
   virtual void SetFrameEvent(uint32_t eventId, bool force) = 0;
 
+  DOCUMENT(R"(Retrieve the per-stage timings of the most recent :meth:`SetFrameEvent` call, to help
+identify where time is being spent when moving between events.
+
+:return: The timings of the last event change.
+:rtype: FrameEventTimings
+)");
+  virtual FrameEventTimings GetFrameEventTimings() = 0;
+
   DOCUMENT(R"(Retrieve the current :class:`D3D11State` pipeline state.
 
 The return value will be ``None`` if the capture is not using the D3D11 API.
@@ -829,6 +837,29 @@ bucket when the pixel values are divided between ``minval`` and ``maxval``.
   virtual rdcarray<PixelModification> PixelHistory(ResourceId texture, uint32_t x, uint32_t y,
                                                    const Subresource &sub, CompType typeCast) = 0;
 
+  DOCUMENT(R"(Retrieve the history of modifications to the selected pixel on the selected texture,
+restricted to a range of events. This is identical to :meth:`PixelHistory` except that only
+potential modifications between the two eventIds inclusive are resolved, which allows the results
+for a long history to be fetched incrementally.
+
+:param ResourceId texture: The texture to search for modifications.
+:param int x: The x co-ordinate.
+:param int y: The y co-ordinate.
+:param Subresource sub: The subresource within this texture to use.
+:param CompType typeCast: If possible interpret the texture with this type instead of its normal
+  type. If set to :data:`CompType.Typeless` then no cast is applied, otherwise where allowed the
+  texture data will be reinterpreted - e.g. from unsigned integers to floats, or to unsigned
+  normalised values.
+:param int firstEventId: The first eventId to include in the results.
+:param int lastEventId: The last eventId to include in the results.
+:return: The list of pixel history events within the given range.
+:rtype: ``list`` of :class:`PixelModification`
+)");
+  virtual rdcarray<PixelModification> PixelHistoryRange(ResourceId texture, uint32_t x, uint32_t y,
+                                                        const Subresource &sub, CompType typeCast,
+                                                        uint32_t firstEventId,
+                                                        uint32_t lastEventId) = 0;
+
   DOCUMENT(R"(Retrieve a debugging trace from running a vertex shader.
 
 :param int vertid: The vertex ID as a 0-based index up to the number of vertices in the draw.
@@ -861,6 +892,20 @@ bucket when the pixel values are divided between ``minval`` and ``maxval``.
   virtual ShaderDebugTrace *DebugPixel(uint32_t x, uint32_t y, uint32_t sample,
                                        uint32_t primitive) = 0;
 
+  DOCUMENT(R"(Retrieve debugging traces from running a pixel shader at several pixels. Equivalent
+to calling :meth:`DebugPixel` once per entry, but batched so that the replayed state is only
+restored once rather than after every invocation, and so that implementations can share the
+input-gathering work between invocations.
+
+See the note on co-ordinate systems in :meth:`DebugPixel`.
+
+:param list targets: The list of :class:`PixelDebugTarget` invocations to debug.
+:return: One trace per entry in ``targets``, in the same order. Destroy each with
+  :meth:`FreeTrace`.
+:rtype: ``list`` of :class:`ShaderDebugTrace`
+)");
+  virtual rdcarray<ShaderDebugTrace *> DebugPixels(const rdcarray<PixelDebugTarget> &targets) = 0;
+
   DOCUMENT(R"(Retrieve a debugging trace from running a compute thread.
 
 :param groupid: A list containing the 3D workgroup index.
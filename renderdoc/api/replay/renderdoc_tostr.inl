@@ -1013,6 +1013,10 @@ rdcstr DoStringise(const SectionType &el)
     STRINGISE_ENUM_CLASS_NAMED(ResourceRenames, "renderdoc/ui/resrenames");
     STRINGISE_ENUM_CLASS_NAMED(AMDRGPProfile, "amd/rgp/profile");
     STRINGISE_ENUM_CLASS_NAMED(ExtendedThumbnail, "renderdoc/internal/exthumb");
+    STRINGISE_ENUM_CLASS_NAMED(FrameCaptureIndex, "renderdoc/internal/framecapture_index");
+    STRINGISE_ENUM_CLASS_NAMED(EventThumbnails, "renderdoc/ui/event_thumbs");
+    STRINGISE_ENUM_CLASS_NAMED(StringTable, "renderdoc/internal/stringtable");
+    STRINGISE_ENUM_CLASS_NAMED(PerformanceCounters, "renderdoc/ui/counters");
   }
   END_ENUM_STRINGISE();
 }
@@ -86,6 +86,39 @@ version of RenderDoc that addes a new section type. They should be considered eq
   lossless.
 
   The name for this section will be "renderdoc/internal/exthumb".
+
+.. data:: FrameCaptureIndex
+
+  This section contains an index of the chunks in the frame capture section, mapping each chunk to
+  its byte offset in the uncompressed stream so that readers can seek directly to a given chunk
+  instead of walking the whole stream.
+
+  The name for this section will be "renderdoc/internal/framecapture_index".
+
+.. data:: EventThumbnails
+
+  This section contains pre-rendered thumbnails of output targets at selected events, stored by the
+  UI at save time so that re-opening a capture can show thumbnail strips without replaying to each
+  event first.
+
+  The name for this section will be "renderdoc/ui/event_thumbs".
+
+.. data:: StringTable
+
+  This section contains a table of strings referenced by id from chunks in the frame capture
+  section, so that strings which repeat many times (debug names, shader entry points, file paths)
+  are stored once instead of inline in every chunk.
+
+  The name for this section will be "renderdoc/internal/stringtable".
+
+.. data:: PerformanceCounters
+
+  This section contains a JSON document with the results of a performance counter sweep, stored by
+  the UI after fetching counters so that re-opening the capture can show the previous results
+  without replaying every counter pass again. The results are keyed by the GPU they were sampled
+  on, so they are ignored when the capture is replayed on different hardware.
+
+  The name for this section will be "renderdoc/ui/counters".
 )");
 enum class SectionType : uint32_t
 {
@@ -98,6 +131,10 @@ enum class SectionType : uint32_t
   ResourceRenames,
   AMDRGPProfile,
   ExtendedThumbnail,
+  FrameCaptureIndex,
+  EventThumbnails,
+  StringTable,
+  PerformanceCounters,
   Count,
 };
 
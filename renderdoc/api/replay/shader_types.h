@@ -230,7 +230,9 @@ struct ShaderVariable
     memset(&value, 0, sizeof(value));
   }
   ShaderVariable(const ShaderVariable &) = default;
+  ShaderVariable(ShaderVariable &&) = default;
   ShaderVariable &operator=(const ShaderVariable &) = default;
+  ShaderVariable &operator=(ShaderVariable &&) = default;
   ShaderVariable(const rdcstr &n, float x, float y, float z, float w)
   {
     name = n;
@@ -594,7 +596,9 @@ struct ShaderVariableChange
   DOCUMENT("");
   ShaderVariableChange() = default;
   ShaderVariableChange(const ShaderVariableChange &) = default;
+  ShaderVariableChange(ShaderVariableChange &&) = default;
   ShaderVariableChange &operator=(const ShaderVariableChange &) = default;
+  ShaderVariableChange &operator=(ShaderVariableChange &&) = default;
 
   bool operator==(const ShaderVariableChange &o) const
   {
@@ -629,7 +633,9 @@ struct ShaderDebugState
   DOCUMENT("");
   ShaderDebugState() = default;
   ShaderDebugState(const ShaderDebugState &) = default;
+  ShaderDebugState(ShaderDebugState &&) = default;
   ShaderDebugState &operator=(const ShaderDebugState &) = default;
+  ShaderDebugState &operator=(ShaderDebugState &&) = default;
 
   bool operator==(const ShaderDebugState &o) const
   {
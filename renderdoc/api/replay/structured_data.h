@@ -370,6 +370,13 @@ private:
 
 DECLARE_REFLECTION_STRUCT(SDObjectData);
 
+#ifdef RENDERDOC_EXPORTS
+// in-module pooled allocation for structured objects, since they are allocated in their millions
+// when generating structured data for a capture. Implemented in replay/entry_points.cpp
+void *RENDERDOC_AllocStructuredMem(size_t sz);
+void RENDERDOC_FreeStructuredMem(void *mem, size_t sz);
+#endif
+
 DOCUMENT("Defines a single structured object.");
 struct SDObject
 {
@@ -379,18 +386,18 @@ struct SDObject
   {
     void *ret = NULL;
 #ifdef RENDERDOC_EXPORTS
-    ret = malloc(sz);
-    if(ret == NULL)
-      RENDERDOC_OutOfMemory(sz);
+    ret = RENDERDOC_AllocStructuredMem(sz);
 #else
     ret = RENDERDOC_AllocArrayMem(sz);
 #endif
     return ret;
   }
-  void operator delete(void *p)
+  // sized form so the pooled allocator can return the block to the right freelist without needing
+  // a block header
+  void operator delete(void *p, size_t sz)
   {
 #ifdef RENDERDOC_EXPORTS
-    free(p);
+    RENDERDOC_FreeStructuredMem(p, sz);
 #else
     RENDERDOC_FreeArrayMem(p);
 #endif
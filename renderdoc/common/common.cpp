@@ -26,6 +26,8 @@
 #include "common.h"
 #include <stdarg.h>
 #include <string.h>
+#include "api/replay/rdcarray.h"
+#include "api/replay/rdcpair.h"
 #include "common/threading.h"
 #include "os/os_specific.h"
 #include "strings/string_utils.h"
@@ -39,33 +41,37 @@ void rdcassert(const char *msg, const char *file, unsigned int line, const char
                 "Assertion failed: %s", msg);
 }
 
-#if 0
-static __m128 zero = {0};
+#if defined(__x86_64__) || defined(_M_X64) || defined(__SSE2__) || \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+
+#include <emmintrin.h>
+
+#define DIFF_SSE2 1
+
+#elif defined(__aarch64__) || defined(_M_ARM64)
+
+#include <arm_neon.h>
+
+#define DIFF_NEON 1
+
 #endif
 
 // assumes a and b both point to 16-byte aligned 16-byte chunks of memory.
 // Returns if they're equal or different
 bool Vec16NotEqual(void *a, void *b)
 {
-// disabled SSE version as it's acting dodgy
-#if 0
-	__m128 avec = _mm_load_ps(aflt);
-	__m128 bvec = _mm_load_ps(bflt);
-
-	__m128 diff = _mm_xor_ps(avec, bvec);
-
-	__m128 eq = _mm_cmpeq_ps(diff, zero);
-	int mask = _mm_movemask_ps(eq);
-	int signMask = _mm_movemask_ps(diff);
-
-	// first check ensures that diff is floatequal to zero (ie. avec bitwise equal to bvec).
-	// HOWEVER -0 is floatequal to 0, so we ensure no sign bits are set on diff
-	if((mask^0xf) || signMask != 0)
-	{
-		return true;
-	}
-	
-	return false;
+#if defined(DIFF_SSE2)
+  // integer compares don't have the -0.0f and NaN pitfalls that an earlier float SSE version of
+  // this check ran into
+  __m128i avec = _mm_load_si128((const __m128i *)a);
+  __m128i bvec = _mm_load_si128((const __m128i *)b);
+
+  return _mm_movemask_epi8(_mm_cmpeq_epi8(avec, bvec)) != 0xffff;
+#elif defined(DIFF_NEON)
+  uint8x16_t avec = vld1q_u8((const uint8_t *)a);
+  uint8x16_t bvec = vld1q_u8((const uint8_t *)b);
+
+  return vminvq_u8(vceqq_u8(avec, bvec)) != 0xff;
 #elif ENABLED(RDOC_X64)
   uint64_t *a64 = (uint64_t *)a;
   uint64_t *b64 = (uint64_t *)b;
@@ -79,6 +85,26 @@ bool Vec16NotEqual(void *a, void *b)
 #endif
 }
 
+// as Vec16NotEqual above, but without any alignment requirement on a or b. Used for comparing
+// buffers whose allocations we don't control, e.g. serialised contents being delta-transferred.
+static bool Vec16NotEqualUnaligned(const void *a, const void *b)
+{
+#if defined(DIFF_SSE2)
+  __m128i avec = _mm_loadu_si128((const __m128i *)a);
+  __m128i bvec = _mm_loadu_si128((const __m128i *)b);
+
+  return _mm_movemask_epi8(_mm_cmpeq_epi8(avec, bvec)) != 0xffff;
+#elif defined(DIFF_NEON)
+  // NEON loads have no alignment requirement
+  uint8x16_t avec = vld1q_u8((const uint8_t *)a);
+  uint8x16_t bvec = vld1q_u8((const uint8_t *)b);
+
+  return vminvq_u8(vceqq_u8(avec, bvec)) != 0xff;
+#else
+  return memcmp(a, b, 16) != 0;
+#endif
+}
+
 bool FindDiffRange(void *a, void *b, size_t bufSize, size_t &diffStart, size_t &diffEnd)
 {
   RDCASSERT(uintptr_t(a) % 16 == 0);
@@ -178,6 +204,82 @@ bool FindDiffRange(void *a, void *b, size_t bufSize, size_t &diffStart, size_t &
   return diffStart < bufSize;
 }
 
+bool FindDiffRanges(void *a, void *b, size_t bufSize, size_t granularity,
+                    rdcarray<rdcpair<size_t, size_t>> &ranges)
+{
+  byte *abytes = (byte *)a;
+  byte *bbytes = (byte *)b;
+
+  const size_t firstRange = ranges.size();
+
+  size_t alignedSize = bufSize & (~0xf);
+
+  bool inRange = false;
+  size_t rangeStart = 0, rangeEnd = 0;
+
+  // collect runs of differing 16-byte chunks, closing a run only once the clean gap after it
+  // exceeds the merge granularity
+  for(size_t offs = 0; offs < alignedSize; offs += 16)
+  {
+    if(!Vec16NotEqualUnaligned(abytes + offs, bbytes + offs))
+      continue;
+
+    if(inRange && offs - rangeEnd <= granularity)
+    {
+      rangeEnd = offs + 16;
+    }
+    else
+    {
+      if(inRange)
+        ranges.push_back(make_rdcpair(rangeStart, rangeEnd));
+
+      inRange = true;
+      rangeStart = offs;
+      rangeEnd = offs + 16;
+    }
+  }
+
+  // compare any unaligned bytes at the end of the buffer individually
+  for(size_t offs = alignedSize; offs < bufSize; offs++)
+  {
+    if(abytes[offs] == bbytes[offs])
+      continue;
+
+    if(inRange && offs - rangeEnd <= granularity)
+    {
+      rangeEnd = offs + 1;
+    }
+    else
+    {
+      if(inRange)
+        ranges.push_back(make_rdcpair(rangeStart, rangeEnd));
+
+      inRange = true;
+      rangeStart = offs;
+      rangeEnd = offs + 1;
+    }
+  }
+
+  if(inRange)
+    ranges.push_back(make_rdcpair(rangeStart, rangeEnd));
+
+  // narrow each range's boundaries to be byte-accurate, to comply with WRITE_NO_OVERWRITE. This
+  // can't walk past the boundary chunk since that chunk is known to contain a difference.
+  for(size_t i = firstRange; i < ranges.size(); i++)
+  {
+    size_t &start = ranges[i].first;
+    size_t &end = ranges[i].second;
+
+    while(abytes[start] == bbytes[start])
+      start++;
+
+    while(abytes[end - 1] == bbytes[end - 1])
+      end--;
+  }
+
+  return ranges.size() > firstRange;
+}
+
 uint32_t CalcNumMips(int w, int h, int d)
 {
   int mipLevels = 1;
@@ -292,14 +394,156 @@ void rdclog_enableoutput()
   log_output_enabled = true;
 }
 
+// Asynchronous logging.
+//
+// Messages are always formatted on the calling thread - deferring the formatting isn't possible
+// since %s arguments routinely point at temporaries that are dead by the time a background thread
+// could format them. Once formatted though, the writes to the output sinks go through a
+// fixed-size multi-producer single-consumer ring drained by a background thread, so with verbose
+// logging enabled the calling threads don't serialise on disk I/O.
+//
+// When the writer thread isn't running - before RenderDoc::Initialise(), or after shutdown -
+// messages are written synchronously exactly as before.
+
+static const int32_t SlotFree = 0, SlotWriting = 1, SlotReady = 2;
+
+struct rdclog_slot
+{
+  // Free -> Writing when claimed by a producer, Writing -> Ready once the message is copied in,
+  // Ready -> Free once the writer thread has drained it.
+  volatile int32_t state;
+  LogType type;
+  rdcstr fullMsg;
+  rdcstr noPrefixMsg;
+};
+
+// must be a power of two, since slots are indexed by monotonic counters masked down
+static const uint64_t rdclog_ringMask = 1024 - 1;
+static rdclog_slot rdclog_ring[rdclog_ringMask + 1];
+
+// total slots claimed by producers / written out by the writer thread. Only ever read through
+// ExchAdd64(x, 0) off the owning thread, to avoid torn reads on 32-bit.
+static volatile int64_t rdclog_ringClaimed = 0;
+static volatile int64_t rdclog_ringDrained = 0;
+
+static volatile int32_t rdclog_asyncActive = 0;     // producers may enqueue to the ring
+static volatile int32_t rdclog_asyncShutdown = 0;   // writer thread should drain and exit
+static volatile int32_t rdclog_asyncExited = 0;     // writer thread has exited
+static Threading::ThreadHandle rdclog_asyncThread = 0;
+
+static void rdclog_asyncwriter()
+{
+  Threading::SetCurrentThreadName("rdclog writer");
+
+  Threading::KeepModuleAlive();
+
+  while(true)
+  {
+    if(rdclog_ringDrained == Atomic::ExchAdd64(&rdclog_ringClaimed, 0))
+    {
+      // ring is empty - exit if we've been asked to, otherwise idle
+      if(Atomic::CmpExch32(&rdclog_asyncShutdown, 1, 1) == 1)
+        break;
+
+      Threading::Sleep(5);
+      continue;
+    }
+
+    rdclog_slot &slot = rdclog_ring[rdclog_ringDrained & rdclog_ringMask];
+
+    // the claiming producer may not have finished copying the message in yet
+    if(Atomic::CmpExch32(&slot.state, SlotReady, SlotReady) != SlotReady)
+    {
+      Threading::Sleep(0);
+      continue;
+    }
+
+    rdclogprint_int(slot.type, slot.fullMsg.c_str(), slot.noPrefixMsg.c_str());
+
+    // release the message storage rather than letting it linger in the ring
+    slot.fullMsg = rdcstr();
+    slot.noPrefixMsg = rdcstr();
+
+    Atomic::CmpExch32(&slot.state, SlotReady, SlotFree);
+    Atomic::ExchAdd64(&rdclog_ringDrained, 1);
+  }
+
+  Atomic::CmpExch32(&rdclog_asyncExited, 0, 1);
+
+  Threading::ReleaseModuleExitThread();
+}
+
+// called from rdclog_direct with each formatted message - enqueues to the ring when the writer
+// thread is running, and falls back to the synchronous path when it isn't.
+static void rdclog_queueprint(LogType type, const char *fullMsg, const char *msg)
+{
+  if(Atomic::CmpExch32(&rdclog_asyncActive, 1, 1) == 1)
+  {
+    const int64_t idx = Atomic::ExchAdd64(&rdclog_ringClaimed, 1);
+
+    rdclog_slot &slot = rdclog_ring[idx & rdclog_ringMask];
+
+    // if the ring is full, wait for the writer thread to free up our slot. This keeps message
+    // ordering intact, at the cost of stalling like the old synchronous path when flooded.
+    while(Atomic::CmpExch32(&slot.state, SlotFree, SlotWriting) != SlotFree)
+      Threading::Sleep(0);
+
+    slot.type = type;
+    slot.fullMsg = fullMsg;
+    slot.noPrefixMsg = msg;
+
+    Atomic::CmpExch32(&slot.state, SlotWriting, SlotReady);
+
+    return;
+  }
+
+  rdclogprint_int(type, fullMsg, msg);
+}
+
+void rdclog_begin_async()
+{
+  if(rdclog_asyncThread != 0)
+    return;
+
+  rdclog_asyncShutdown = 0;
+  rdclog_asyncThread = Threading::CreateThread(&rdclog_asyncwriter);
+
+  Atomic::CmpExch32(&rdclog_asyncActive, 0, 1);
+}
+
 void rdclog_closelog(const char *filename)
 {
   log_output_enabled = false;
+
+  if(rdclog_asyncThread != 0)
+  {
+    // stop new messages entering the ring, give any producer that's already past the check a
+    // moment to finish claiming its slot, then tell the writer to drain and exit.
+    Atomic::CmpExch32(&rdclog_asyncActive, 1, 0);
+    Threading::Sleep(10);
+    Atomic::CmpExch32(&rdclog_asyncShutdown, 0, 1);
+
+    // We can't join here - on windows this can be called during module unload where joining
+    // deadlocks. The writer holds a module reference via KeepModuleAlive(), so as with the
+    // target control thread just give it a little while to notice the signal and drain.
+    for(int i = 0; i < 200 && Atomic::CmpExch32(&rdclog_asyncExited, 1, 1) != 1; i++)
+      Threading::Sleep(5);
+
+    Threading::CloseThread(rdclog_asyncThread);
+    rdclog_asyncThread = 0;
+  }
+
   FileIO::logfile_close(logfileHandle, filename);
 }
 
 void rdclog_flush()
 {
+  // wait for the writer thread to drain anything queued in the ring. This is called on fatal
+  // error paths, so bound the wait in case the writer thread is dead or wedged.
+  for(int i = 0; i < 1000 && Atomic::ExchAdd64(&rdclog_ringDrained, 0) !=
+                                 Atomic::ExchAdd64(&rdclog_ringClaimed, 0);
+      i++)
+    Threading::Sleep(1);
 }
 
 void rdclogprint_int(LogType type, const char *fullMsg, const char *msg)
@@ -331,7 +575,6 @@ void rdclogprint_int(LogType type, const char *fullMsg, const char *msg)
 }
 
 const int rdclog_outBufSize = 4 * 1024;
-static char rdclog_outputBuffer[rdclog_outBufSize + 3];
 
 static void write_newline(char *output)
 {
@@ -376,13 +619,13 @@ void rdclog_direct(time_t utcTime, uint32_t pid, LogType type, const char *proje
       "Debug  ", "Log    ", "Warning", "Error  ", "Fatal  ",
   };
 
-  static Threading::CriticalSection *lock = new Threading::CriticalSection();
-
-  SCOPED_LOCK(*lock);
+  // formatted on the stack so that threads logging concurrently don't serialise on a shared
+  // buffer - any contention left is in the output sinks, behind the async ring
+  char outputBuffer[rdclog_outBufSize + 3];
 
-  rdclog_outputBuffer[rdclog_outBufSize] = rdclog_outputBuffer[0] = 0;
+  outputBuffer[rdclog_outBufSize] = outputBuffer[0] = 0;
 
-  char *output = rdclog_outputBuffer;
+  char *output = outputBuffer;
   size_t available = rdclog_outBufSize;
 
   char *base = output;
@@ -454,7 +697,7 @@ void rdclog_direct(time_t utcTime, uint32_t pid, LogType type, const char *proje
     // append newline
     write_newline(output);
 
-    rdclogprint_int(type, base, noPrefixOutput);
+    rdclog_queueprint(type, base, noPrefixOutput);
   }
   else
   {
@@ -474,9 +717,9 @@ void rdclog_direct(time_t utcTime, uint32_t pid, LogType type, const char *proje
       write_newline(nl);
 
       if(first)
-        rdclogprint_int(type, base, noPrefixOutput);
+        rdclog_queueprint(type, base, noPrefixOutput);
       else
-        rdclogprint_int(type, (prefixText + base).c_str(), noPrefixOutput);
+        rdclog_queueprint(type, (prefixText + base).c_str(), noPrefixOutput);
 
       // restore the characters
       nl[1] = backup[0];
@@ -494,9 +737,9 @@ void rdclog_direct(time_t utcTime, uint32_t pid, LogType type, const char *proje
     write_newline(output);
 
     if(first)
-      rdclogprint_int(type, base, noPrefixOutput);
+      rdclog_queueprint(type, base, noPrefixOutput);
     else
-      rdclogprint_int(type, (prefixText + base).c_str(), noPrefixOutput);
+      rdclog_queueprint(type, (prefixText + base).c_str(), noPrefixOutput);
   }
 
   SAFE_DELETE_ARRAY(oversizedBuffer);
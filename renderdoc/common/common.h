@@ -178,6 +178,12 @@ inline T AlignUp(T x, T a)
   return (x + (a - 1)) & (~(a - 1));
 }
 
+template <typename T>
+inline T AlignDown(T x, T a)
+{
+  return x & (~(a - 1));
+}
+
 template <typename T, typename A>
 inline T AlignUpPtr(T x, A a)
 {
@@ -188,6 +194,18 @@ inline T AlignUpPtr(T x, A a)
   (((uint32_t)(d) << 24) | ((uint32_t)(c) << 16) | ((uint32_t)(b) << 8) | (uint32_t)(a))
 
 bool FindDiffRange(void *a, void *b, size_t bufSize, size_t &diffStart, size_t &diffEnd);
+
+template <typename T>
+struct rdcarray;
+template <typename A, typename B>
+struct rdcpair;
+
+// Compares two equal-sized buffers in one pass and appends each differing [start, end) byte range
+// to `ranges`, merging ranges separated by `granularity` bytes or fewer. Returns true if any
+// difference was found. No alignment requirement on either buffer.
+bool FindDiffRanges(void *a, void *b, size_t bufSize, size_t granularity,
+                    rdcarray<rdcpair<size_t, size_t>> &ranges);
+
 uint32_t CalcNumMips(int Width, int Height, int Depth);
 
 typedef uint8_t byte;
@@ -346,12 +364,14 @@ void rdclog_direct(time_t utcTime, uint32_t pid, LogType type, const char *proje
 const char *rdclog_getfilename();
 void rdclog_filename(const char *filename);
 void rdclog_enableoutput();
+void rdclog_begin_async();
 void rdclog_closelog(const char *filename);
 
 #define RDCLOGFILE(fn) rdclog_filename(fn)
 #define RDCGETLOGFILE() rdclog_getfilename()
 
 #define RDCLOGOUTPUT() rdclog_enableoutput()
+#define RDCLOGASYNC() rdclog_begin_async()
 #define RDCSTOPLOGGING(filename) rdclog_closelog(filename)
 
 #if(ENABLED(RDOC_DEVEL) || ENABLED(FORCE_DEBUG_LOGS)) && DISABLED(STRIP_DEBUG_LOGS)
@@ -0,0 +1,201 @@
+/******************************************************************************
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019-2020 Baldur Karlsson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+#include "common/common.h"
+#include "api/replay/rdcarray.h"
+#include "api/replay/rdcpair.h"
+
+#if ENABLED(ENABLE_UNIT_TESTS)
+
+#include "catch/catch.hpp"
+
+struct DiffBuffers
+{
+  DiffBuffers(size_t size)
+  {
+    a = AllocAlignedBuffer(size);
+    b = AllocAlignedBuffer(size);
+
+    for(size_t i = 0; i < size; i++)
+      a[i] = b[i] = byte(i * 13);
+  }
+  ~DiffBuffers()
+  {
+    FreeAlignedBuffer(a);
+    FreeAlignedBuffer(b);
+  }
+  byte *a;
+  byte *b;
+};
+
+TEST_CASE("Test FindDiffRanges", "[common]")
+{
+  const size_t size = 4096 + 5;
+
+  SECTION("identical buffers")
+  {
+    DiffBuffers bufs(size);
+
+    rdcarray<rdcpair<size_t, size_t>> ranges;
+    CHECK_FALSE(FindDiffRanges(bufs.a, bufs.b, size, 0, ranges));
+    CHECK(ranges.empty());
+  };
+
+  SECTION("single byte difference is found byte-accurately")
+  {
+    DiffBuffers bufs(size);
+    bufs.a[1000] ^= 0xff;
+
+    rdcarray<rdcpair<size_t, size_t>> ranges;
+    CHECK(FindDiffRanges(bufs.a, bufs.b, size, 0, ranges));
+    REQUIRE(ranges.size() == 1);
+    CHECK(ranges[0].first == 1000);
+    CHECK(ranges[0].second == 1001);
+  };
+
+  SECTION("differences at the very start and end")
+  {
+    DiffBuffers bufs(size);
+    bufs.a[0] ^= 0xff;
+    bufs.a[size - 1] ^= 0xff;
+
+    rdcarray<rdcpair<size_t, size_t>> ranges;
+    CHECK(FindDiffRanges(bufs.a, bufs.b, size, 0, ranges));
+    REQUIRE(ranges.size() == 2);
+    CHECK(ranges[0].first == 0);
+    CHECK(ranges[0].second == 1);
+    CHECK(ranges[1].first == size - 1);
+    CHECK(ranges[1].second == size);
+  };
+
+  SECTION("difference in the unaligned tail bytes")
+  {
+    DiffBuffers bufs(size);
+    bufs.a[size - 2] ^= 0xff;
+
+    rdcarray<rdcpair<size_t, size_t>> ranges;
+    CHECK(FindDiffRanges(bufs.a, bufs.b, size, 0, ranges));
+    REQUIRE(ranges.size() == 1);
+    CHECK(ranges[0].first == size - 2);
+    CHECK(ranges[0].second == size - 1);
+  };
+
+  SECTION("distant differences stay separate with zero granularity")
+  {
+    DiffBuffers bufs(size);
+    bufs.a[100] ^= 0xff;
+    bufs.a[2000] ^= 0xff;
+
+    rdcarray<rdcpair<size_t, size_t>> ranges;
+    CHECK(FindDiffRanges(bufs.a, bufs.b, size, 0, ranges));
+    REQUIRE(ranges.size() == 2);
+    CHECK(ranges[0].first == 100);
+    CHECK(ranges[0].second == 101);
+    CHECK(ranges[1].first == 2000);
+    CHECK(ranges[1].second == 2001);
+  };
+
+  SECTION("granularity merges nearby differences")
+  {
+    DiffBuffers bufs(size);
+    bufs.a[100] ^= 0xff;
+    bufs.a[2000] ^= 0xff;
+
+    rdcarray<rdcpair<size_t, size_t>> ranges;
+    CHECK(FindDiffRanges(bufs.a, bufs.b, size, size, ranges));
+    REQUIRE(ranges.size() == 1);
+    CHECK(ranges[0].first == 100);
+    CHECK(ranges[0].second == 2001);
+  };
+
+  SECTION("contiguous dirty chunks form one range regardless of granularity")
+  {
+    DiffBuffers bufs(size);
+    for(size_t i = 64; i < 256; i++)
+      bufs.a[i] ^= 0xff;
+
+    rdcarray<rdcpair<size_t, size_t>> ranges;
+    CHECK(FindDiffRanges(bufs.a, bufs.b, size, 0, ranges));
+    REQUIRE(ranges.size() == 1);
+    CHECK(ranges[0].first == 64);
+    CHECK(ranges[0].second == 256);
+  };
+
+  SECTION("appends to existing contents")
+  {
+    DiffBuffers bufs(size);
+    bufs.a[10] ^= 0xff;
+
+    rdcarray<rdcpair<size_t, size_t>> ranges;
+    ranges.push_back(make_rdcpair<size_t, size_t>(1, 2));
+    CHECK(FindDiffRanges(bufs.a, bufs.b, size, 0, ranges));
+    REQUIRE(ranges.size() == 2);
+    CHECK(ranges[1].first == 10);
+    CHECK(ranges[1].second == 11);
+  };
+
+  SECTION("unaligned buffers give the same results")
+  {
+    DiffBuffers bufs(size);
+    bufs.a[100] ^= 0xff;
+    bufs.a[3000] ^= 0xff;
+
+    for(size_t offs : {1, 3, 7, 13})
+    {
+      rdcarray<rdcpair<size_t, size_t>> ranges;
+      CHECK(FindDiffRanges(bufs.a + offs, bufs.b + offs, size - offs, 0, ranges));
+      REQUIRE(ranges.size() == 2);
+      CHECK(ranges[0].first == 100 - offs);
+      CHECK(ranges[0].second == 101 - offs);
+      CHECK(ranges[1].first == 3000 - offs);
+      CHECK(ranges[1].second == 3001 - offs);
+    }
+  };
+
+  SECTION("agrees with FindDiffRange on the overall span")
+  {
+    DiffBuffers bufs(size);
+    for(size_t i = 0; i < 40; i++)
+      bufs.a[(i * 179) % size] ^= 0xff;
+
+    size_t diffStart = 0, diffEnd = 0;
+    REQUIRE(FindDiffRange(bufs.a, bufs.b, size, diffStart, diffEnd));
+
+    rdcarray<rdcpair<size_t, size_t>> ranges;
+    REQUIRE(FindDiffRanges(bufs.a, bufs.b, size, 0, ranges));
+
+    CHECK(ranges.front().first == diffStart);
+    CHECK(ranges.back().second == diffEnd);
+
+    // every reported range must contain a real difference at both boundaries
+    for(const rdcpair<size_t, size_t> &r : ranges)
+    {
+      CHECK(r.first < r.second);
+      CHECK(bufs.a[r.first] != bufs.b[r.first]);
+      CHECK(bufs.a[r.second - 1] != bufs.b[r.second - 1]);
+    }
+  };
+};
+
+#endif    // ENABLED(ENABLE_UNIT_TESTS)
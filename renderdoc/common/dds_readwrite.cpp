@@ -672,7 +672,65 @@ DXGI_FORMAT ResourceFormat2DXGIFormat(ResourceFormat format)
   return DXGI_FORMAT_UNKNOWN;
 }
 
-bool write_dds_to_file(FILE *f, const dds_data &data)
+// bytes per pixel as written to a DDS file for non-block formats, or 0 if the format can't be
+// written to DDS
+static uint32_t dds_bytes_per_pixel(const ResourceFormat &format)
+{
+  switch(format.type)
+  {
+    case ResourceFormatType::S8:
+    case ResourceFormatType::A8: return 1;
+    case ResourceFormatType::R10G10B10A2:
+    case ResourceFormatType::R9G9B9E5:
+    case ResourceFormatType::R11G11B10:
+    case ResourceFormatType::D24S8: return 4;
+    case ResourceFormatType::R5G6B5:
+    case ResourceFormatType::R5G5B5A1:
+    case ResourceFormatType::R4G4B4A4: return 2;
+    case ResourceFormatType::D32S8: return 8;
+    case ResourceFormatType::D16S8:
+    case ResourceFormatType::YUV8:
+    case ResourceFormatType::YUV10:
+    case ResourceFormatType::YUV12:
+    case ResourceFormatType::YUV16:
+    case ResourceFormatType::R4G4: RDCERR("Unsupported file format %u", format.type); return 0;
+    default: return format.compCount * format.compByteWidth;
+  }
+}
+
+static bool dds_block_format(const ResourceFormat &format)
+{
+  switch(format.type)
+  {
+    case ResourceFormatType::BC1:
+    case ResourceFormatType::BC2:
+    case ResourceFormatType::BC3:
+    case ResourceFormatType::BC4:
+    case ResourceFormatType::BC5:
+    case ResourceFormatType::BC6:
+    case ResourceFormatType::BC7: return true;
+    default: return false;
+  }
+}
+
+uint64_t dds_subresource_size(const ResourceFormat &format, uint32_t width, uint32_t height,
+                              uint32_t mip)
+{
+  uint32_t rowlen = RDCMAX(1U, width >> mip);
+  uint32_t numRows = RDCMAX(1U, height >> mip);
+
+  if(dds_block_format(format))
+  {
+    uint32_t blockSize =
+        (format.type == ResourceFormatType::BC1 || format.type == ResourceFormatType::BC4) ? 8 : 16;
+    uint32_t pitch = RDCMAX(blockSize, ((rowlen + 3) / 4) * blockSize);
+    return uint64_t(pitch) * RDCMAX(1U, numRows / 4);
+  }
+
+  return uint64_t(RDCMAX(1U, rowlen * dds_bytes_per_pixel(format))) * numRows;
+}
+
+bool write_dds_header(FILE *f, const dds_data &data)
 {
   if(!f)
     return false;
@@ -773,28 +831,10 @@ bool write_dds_to_file(FILE *f, const dds_data &data)
   }
   else
   {
-    switch(data.format.type)
-    {
-      case ResourceFormatType::S8:
-      case ResourceFormatType::A8: bytesPerPixel = 1; break;
-      case ResourceFormatType::R10G10B10A2:
-      case ResourceFormatType::R9G9B9E5:
-      case ResourceFormatType::R11G11B10:
-      case ResourceFormatType::D24S8: bytesPerPixel = 4; break;
-      case ResourceFormatType::R5G6B5:
-      case ResourceFormatType::R5G5B5A1:
-      case ResourceFormatType::R4G4B4A4: bytesPerPixel = 2; break;
-      case ResourceFormatType::D32S8: bytesPerPixel = 8; break;
-      case ResourceFormatType::D16S8:
-      case ResourceFormatType::YUV8:
-      case ResourceFormatType::YUV10:
-      case ResourceFormatType::YUV12:
-      case ResourceFormatType::YUV16:
-      case ResourceFormatType::R4G4:
-        RDCERR("Unsupported file format %u", data.format.type);
-        return false;
-      default: bytesPerPixel = data.format.compCount * data.format.compByteWidth;
-    }
+    bytesPerPixel = dds_bytes_per_pixel(data.format);
+
+    if(bytesPerPixel == 0)
+      return false;
 
     header.dwPitchOrLinearSize = header.dwWidth * bytesPerPixel;
   }
@@ -862,48 +902,33 @@ bool write_dds_to_file(FILE *f, const dds_data &data)
     header.ddspf.dwFourCC = MAKE_FOURCC('D', 'X', '1', '0');
   }
 
-  {
-    FileIO::fwrite(&magic, sizeof(magic), 1, f);
-    FileIO::fwrite(&header, sizeof(header), 1, f);
-    if(dx10Header)
-      FileIO::fwrite(&headerDXT10, sizeof(headerDXT10), 1, f);
-
-    int i = 0;
-    for(uint32_t slice = 0; slice < RDCMAX(1U, data.slices); slice++)
-    {
-      for(uint32_t mip = 0; mip < RDCMAX(1U, data.mips); mip++)
-      {
-        uint32_t numdepths = RDCMAX(1U, data.depth >> mip);
-        for(uint32_t d = 0; d < numdepths; d++)
-        {
-          byte *bytedata = data.subdata[i];
-
-          uint32_t rowlen = RDCMAX(1U, data.width >> mip);
-          uint32_t numRows = RDCMAX(1U, data.height >> mip);
-          uint32_t pitch = RDCMAX(1U, rowlen * bytesPerPixel);
-
-          // pitch/rows are in blocks, not pixels, for block formats.
-          if(blockFormat)
-          {
-            numRows = RDCMAX(1U, numRows / 4);
+  FileIO::fwrite(&magic, sizeof(magic), 1, f);
+  FileIO::fwrite(&header, sizeof(header), 1, f);
+  if(dx10Header)
+    FileIO::fwrite(&headerDXT10, sizeof(headerDXT10), 1, f);
 
-            uint32_t blockSize = (data.format.type == ResourceFormatType::BC1 ||
-                                  data.format.type == ResourceFormatType::BC4)
-                                     ? 8
-                                     : 16;
+  return true;
+}
 
-            pitch = RDCMAX(blockSize, (((rowlen + 3) / 4)) * blockSize);
-          }
+bool write_dds_to_file(FILE *f, const dds_data &data)
+{
+  if(!write_dds_header(f, data))
+    return false;
 
-          for(uint32_t row = 0; row < numRows; row++)
-          {
-            FileIO::fwrite(bytedata, 1, pitch, f);
+  int i = 0;
+  for(uint32_t slice = 0; slice < RDCMAX(1U, data.slices); slice++)
+  {
+    for(uint32_t mip = 0; mip < RDCMAX(1U, data.mips); mip++)
+    {
+      uint32_t numdepths = RDCMAX(1U, data.depth >> mip);
+      for(uint32_t d = 0; d < numdepths; d++)
+      {
+        // each depth-slice is tightly packed, so it can go out in a single write
+        uint64_t size = dds_subresource_size(data.format, data.width, data.height, mip);
 
-            bytedata += pitch;
-          }
+        FileIO::fwrite(data.subdata[i], 1, (size_t)size, f);
 
-          i++;
-        }
+        i++;
       }
     }
   }
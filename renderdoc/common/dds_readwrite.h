@@ -48,3 +48,13 @@ struct dds_data
 extern bool is_dds_file(byte *headerBuffer, size_t size);
 extern dds_data load_dds_from_file(StreamReader *reader);
 extern bool write_dds_to_file(FILE *f, const dds_data &data);
+
+// streaming interface: write just the magic number and headers, for callers that append the
+// subresource data themselves in the order write_dds_to_file writes it - slice-major, then mips,
+// with volume depth slices expanded. subdata is not accessed. Returns false for formats that
+// can't be written to DDS.
+extern bool write_dds_header(FILE *f, const dds_data &data);
+
+// the number of tightly-packed bytes in one depth-slice of the given mip as stored in the file
+extern uint64_t dds_subresource_size(const ResourceFormat &format, uint32_t width, uint32_t height,
+                                     uint32_t mip);
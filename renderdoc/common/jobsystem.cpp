@@ -0,0 +1,208 @@
+/******************************************************************************
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019-2020 Baldur Karlsson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+#include "common/threading.h"
+#include "common/formatting.h"
+#include "os/os_specific.h"
+
+namespace Threading
+{
+struct Job
+{
+  std::function<void()> func;
+  volatile int32_t *counter = NULL;
+};
+
+// all state is guarded by jobLock except the counters, which are atomic. The queue is LIFO -
+// ordering between jobs is explicitly not guaranteed, anything order-dependent synchronises via
+// TaskGroup::Wait().
+static CriticalSection jobLock;
+static rdcarray<Job> jobQueue;
+static rdcarray<ThreadHandle> jobWorkers;
+static volatile int32_t jobKill = 0;
+static bool jobWorkersStarted = false;
+
+static bool PopJob(Job &job)
+{
+  SCOPED_LOCK(jobLock);
+
+  if(jobQueue.empty())
+    return false;
+
+  job = std::move(jobQueue.back());
+  jobQueue.pop_back();
+  return true;
+}
+
+static void RunJob(Job &job)
+{
+  job.func();
+
+  // destroy anything captured by the job before signalling completion, so that a waiter can't
+  // return (and unwind state the capture refers to) while the function is still alive.
+  job.func = std::function<void()>();
+
+  Atomic::Dec32(job.counter);
+}
+
+static void JobWorkerEntry(uint32_t idx)
+{
+  SetCurrentThreadName(StringFormat::Fmt("JobSystem Worker %u", idx));
+
+  uint32_t idleSpins = 0;
+
+  while(jobKill == 0)
+  {
+    Job job;
+    if(PopJob(job))
+    {
+      RunJob(job);
+      idleSpins = 0;
+      continue;
+    }
+
+    // briefly yield between polls when work just ran dry, then back off to sleeping so idle
+    // workers don't burn a core.
+    idleSpins++;
+    if(idleSpins < 64)
+      Sleep(0);
+    else
+      Sleep(2);
+  }
+}
+
+size_t JobWorkerCount()
+{
+  SCOPED_LOCK(jobLock);
+
+  if(!jobWorkersStarted)
+  {
+    jobWorkersStarted = true;
+
+    // leave a core for the calling thread, which always participates, and don't spawn an army
+    // on very wide machines - the workloads queued here don't scale past this.
+    uint32_t count = RDCMIN(GetCPUCoreCount(), 8U) - 1;
+
+    for(uint32_t i = 0; i < count; i++)
+      jobWorkers.push_back(CreateThread([i]() { JobWorkerEntry(i); }));
+  }
+
+  return jobWorkers.size();
+}
+
+void ShutdownJobSystem()
+{
+  {
+    SCOPED_LOCK(jobLock);
+
+    if(!jobWorkersStarted)
+      return;
+
+    RDCASSERT(jobQueue.empty());
+  }
+
+  Atomic::Inc32(&jobKill);
+
+  for(ThreadHandle t : jobWorkers)
+  {
+    JoinThread(t);
+    CloseThread(t);
+  }
+
+  SCOPED_LOCK(jobLock);
+  jobWorkers.clear();
+  jobWorkersStarted = false;
+  jobKill = 0;
+}
+
+void TaskGroup::Add(std::function<void()> job)
+{
+  Atomic::Inc32(&m_Outstanding);
+
+  // with no workers (single core machine, or shutdown) just run the job in place
+  if(JobWorkerCount() == 0)
+  {
+    job();
+    Atomic::Dec32(&m_Outstanding);
+    return;
+  }
+
+  Job queued;
+  queued.func = std::move(job);
+  queued.counter = &m_Outstanding;
+
+  SCOPED_LOCK(jobLock);
+  jobQueue.push_back(std::move(queued));
+}
+
+void TaskGroup::Wait()
+{
+  while(m_Outstanding > 0)
+  {
+    // execute queued jobs on this thread while waiting, rather than blocking. Note this can run
+    // jobs belonging to other groups, which is fine - they'd have to run somewhere anyway and
+    // jobs never block on their own group.
+    Job job;
+    if(PopJob(job))
+      RunJob(job);
+    else
+      Sleep(0);
+  }
+}
+
+void ParallelFor(size_t count, const std::function<void(size_t index)> &func)
+{
+  if(count == 0)
+    return;
+
+  const size_t workerCount = JobWorkerCount();
+
+  if(workerCount == 0 || count == 1)
+  {
+    for(size_t i = 0; i < count; i++)
+      func(i);
+    return;
+  }
+
+  // one strided batch per thread, including the calling thread. Striding rather than slicing
+  // keeps the batches balanced when cost varies smoothly across the index range.
+  const size_t numBatches = RDCMIN(count, workerCount + 1);
+
+  TaskGroup group;
+
+  for(size_t batch = 1; batch < numBatches; batch++)
+  {
+    group.Add([batch, numBatches, count, &func]() {
+      for(size_t i = batch; i < count; i += numBatches)
+        func(i);
+    });
+  }
+
+  for(size_t i = 0; i < count; i += numBatches)
+    func(i);
+
+  group.Wait();
+}
+
+};    // namespace Threading
@@ -26,6 +26,7 @@
 
 #include <map>
 #include "common/common.h"
+#include "common/timing.h"
 #include "serialise/streamio.h"
 #include "serialise/zstdio.h"
 
@@ -35,6 +36,8 @@ template <typename ResultType, typename ShaderCallbacks>
 bool LoadShaderCache(const char *filename, const uint32_t magicNumber, const uint32_t versionNumber,
                      std::map<uint32_t, ResultType> &resultCache, const ShaderCallbacks &callbacks)
 {
+  PROFILE_ZONE("LoadShaderCache");
+
   rdcstr shadercache = FileIO::GetAppFolderFilename(filename);
 
   StreamReader fileReader(FileIO::fopen(shadercache.c_str(), "rb"));
@@ -89,6 +92,8 @@ template <typename ResultType, typename ShaderCallbacks>
 void SaveShaderCache(const char *filename, uint32_t magicNumber, uint32_t versionNumber,
                      const std::map<uint32_t, ResultType> &cache, const ShaderCallbacks &callbacks)
 {
+  PROFILE_ZONE("SaveShaderCache");
+
   rdcstr shadercache = FileIO::GetAppFolderFilename(filename);
 
   FILE *f = FileIO::fopen(shadercache.c_str(), "wb");
@@ -109,9 +114,16 @@ void SaveShaderCache(const char *filename, uint32_t magicNumber, uint32_t versio
 
   uint64_t uncompressedSize = sizeof(numentries);    // number of entries
 
+  // the size of an entry isn't necessarily trivial for the callbacks to compute, so only ask once
+  rdcarray<uint32_t> sizes;
+  sizes.reserve(numentries);
+
   // hash + length + data for each entry
   for(auto it = cache.begin(); it != cache.end(); ++it)
-    uncompressedSize += sizeof(uint32_t) * 2 + callbacks.GetSize(it->second);
+  {
+    sizes.push_back(callbacks.GetSize(it->second));
+    uncompressedSize += sizeof(uint32_t) * 2 + sizes.back();
+  }
 
   fileWriter.Write(uncompressedSize);
 
@@ -120,10 +132,11 @@ void SaveShaderCache(const char *filename, uint32_t magicNumber, uint32_t versio
 
   compressedWriter.Write(numentries);
 
+  size_t entryIdx = 0;
   for(auto it = cache.begin(); it != cache.end(); ++it)
   {
     uint32_t hash = it->first;
-    uint32_t len = callbacks.GetSize(it->second);
+    uint32_t len = sizes[entryIdx++];
     const byte *data = callbacks.GetData(it->second);
 
     compressedWriter.Write(hash);
@@ -82,6 +82,40 @@ private:
   volatile int32_t val = 0;
 };
 
+// A small shared job scheduler, used by both capture and replay so one-off parallel work doesn't
+// have to spin up its own threads. Worker threads are started lazily on first use (one fewer than
+// the core count, capped) and run until ShutdownJobSystem(). The queue makes no ordering
+// guarantees between jobs - synchronise through TaskGroup::Wait().
+class TaskGroup
+{
+public:
+  TaskGroup() = default;
+  ~TaskGroup() { Wait(); }
+  TaskGroup(const TaskGroup &) = delete;
+  TaskGroup &operator=(const TaskGroup &) = delete;
+
+  // queue a job on the shared workers. If there are none it runs immediately on this thread.
+  void Add(std::function<void()> job);
+
+  // block until every job added to this group has finished. Queued jobs (from any group) are
+  // executed on the calling thread while it waits, so jobs must never block on their own group.
+  void Wait();
+
+private:
+  volatile int32_t m_Outstanding = 0;
+};
+
+// calls func(index) for every index in [0, count), parallelised across the shared workers with
+// the calling thread participating. Returns once every index has been processed.
+void ParallelFor(size_t count, const std::function<void(size_t index)> &func);
+
+// the number of shared worker threads that run jobs, not counting calling threads. Starts the
+// workers if they haven't been yet.
+size_t JobWorkerCount();
+
+// stops and joins the shared workers. All queued jobs must have completed.
+void ShutdownJobSystem();
+
 class ScopedSpinLock
 {
 public:
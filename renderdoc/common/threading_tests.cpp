@@ -23,6 +23,7 @@
  ******************************************************************************/
 
 #include "common/threading.h"
+#include "common/timing.h"
 #include "os/os_specific.h"
 
 #if ENABLED(ENABLE_UNIT_TESTS)
@@ -71,4 +72,90 @@ TEST_CASE("Test spin lock", "[threading]")
   CHECK(finalValue == value);
 }
 
+TEST_CASE("Test job system", "[threading]")
+{
+  SECTION("ParallelFor processes every index exactly once")
+  {
+    rdcarray<int32_t> hits;
+    hits.resize(10000);
+
+    Threading::ParallelFor(hits.size(), [&hits](size_t i) { hits[i]++; });
+
+    for(size_t i = 0; i < hits.size(); i++)
+    {
+      if(hits[i] != 1)
+      {
+        INFO("index " << i);
+        CHECK(hits[i] == 1);
+      }
+    }
+
+    // trivial counts shouldn't break
+    Threading::ParallelFor(0, [&hits](size_t i) { hits[i]++; });
+    Threading::ParallelFor(1, [&hits](size_t i) { hits[i]++; });
+
+    CHECK(hits[0] == 2);
+    CHECK(hits[1] == 1);
+  }
+
+  SECTION("TaskGroup completes every job before Wait returns")
+  {
+    volatile int32_t counter = 0;
+
+    Threading::TaskGroup group;
+
+    for(int i = 0; i < 1000; i++)
+      group.Add([&counter]() { Atomic::Inc32(&counter); });
+
+    group.Wait();
+
+    CHECK(counter == 1000);
+
+    // the group can be reused after a Wait
+    group.Add([&counter]() { Atomic::Inc32(&counter); });
+    group.Wait();
+
+    CHECK(counter == 1001);
+  }
+
+  SECTION("Job system restarts after shutdown")
+  {
+    volatile int32_t counter = 0;
+
+    Threading::ParallelFor(100, [&counter](size_t) { Atomic::Inc32(&counter); });
+
+    CHECK(counter == 100);
+
+    Threading::ShutdownJobSystem();
+
+    Threading::ParallelFor(100, [&counter](size_t) { Atomic::Inc32(&counter); });
+
+    CHECK(counter == 200);
+  }
+}
+
+// hidden behind the benchmark tag - run with 'renderdoccmd test unit --benchmark'
+TEST_CASE("Benchmark job system", "[.][benchmark][threading]")
+{
+  SECTION("ParallelFor dispatch overhead")
+  {
+    // trivial work, so this measures scheduling cost rather than throughput
+    const size_t count = 10000;
+    const int passes = 100;
+
+    volatile int32_t counter = 0;
+
+    PerformanceTimer timer;
+
+    for(int pass = 0; pass < passes; pass++)
+      Threading::ParallelFor(count, [&counter](size_t) { Atomic::Inc32(&counter); });
+
+    WARN("ParallelFor: " << passes << " dispatches of " << count << " trivial tasks in "
+                         << timer.GetMilliseconds() << " ms on " << Threading::JobWorkerCount()
+                         << " workers");
+
+    CHECK(uint32_t(counter) == uint32_t(count * passes));
+  };
+};
+
 #endif    // ENABLED(ENABLE_UNIT_TESTS)
@@ -0,0 +1,72 @@
+/******************************************************************************
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019-2020 Baldur Karlsson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+#include "common/timing.h"
+#include "common/threading.h"
+
+namespace ZoneProfiler
+{
+volatile int32_t active = 0;
+
+static Threading::CriticalSection zoneLock;
+static rdcarray<ZoneEvent> zoneEvents;
+static uint64_t zoneBaseTick = 0;
+
+void Start()
+{
+  SCOPED_LOCK(zoneLock);
+
+  zoneEvents.clear();
+  zoneBaseTick = Timing::GetTick();
+  active = 1;
+}
+
+void StopAndGather(rdcarray<ZoneEvent> &events)
+{
+  SCOPED_LOCK(zoneLock);
+
+  active = 0;
+  events.swap(zoneEvents);
+  zoneEvents.clear();
+}
+
+void Record(const char *name, uint64_t startTick, uint64_t endTick)
+{
+  // tick frequency is in ticks per millisecond
+  const double ticksPerMicro = Timing::GetTickFrequency() / 1000.0;
+
+  ZoneEvent ev;
+  ev.name = name;
+  ev.timestampMicro = uint64_t(double(startTick - zoneBaseTick) / ticksPerMicro);
+  ev.durationMicro = uint64_t(double(endTick - startTick) / ticksPerMicro);
+  ev.threadID = Threading::GetCurrentID();
+
+  SCOPED_LOCK(zoneLock);
+
+  // recording may have stopped between this zone opening and closing
+  if(active)
+    zoneEvents.push_back(ev);
+}
+
+};    // namespace ZoneProfiler
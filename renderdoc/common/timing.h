@@ -126,3 +126,60 @@ private:
 
 #define SCOPED_TIMER(...) \
   ScopedTimer CONCAT(timer, __LINE__)(__FILE__, __LINE__, StringFormat::Fmt(__VA_ARGS__));
+
+// a single completed profiling zone. Zone names must be string literals (or otherwise outlive the
+// recording) - only the pointer is stored.
+struct ZoneEvent
+{
+  const char *name;
+  uint64_t timestampMicro;
+  uint64_t durationMicro;
+  uint64_t threadID;
+};
+
+// scoped instrumentation zones for profiling capture and replay. Recording is off by default and
+// zones only pay for a read of the flag, so PROFILE_ZONE() can sit on hot paths permanently.
+// While recording, completed zones are accumulated from all threads and can be gathered for
+// export - see the chrome trace dump in core.cpp.
+namespace ZoneProfiler
+{
+extern volatile int32_t active;
+
+inline bool Recording()
+{
+  return active != 0;
+}
+
+// begins recording zones, with timestamps relative to this call
+void Start();
+// stops recording and moves all accumulated events into the given array
+void StopAndGather(rdcarray<ZoneEvent> &events);
+
+// called by ScopedProfileZone, use PROFILE_ZONE() instead
+void Record(const char *name, uint64_t startTick, uint64_t endTick);
+};
+
+class ScopedProfileZone
+{
+public:
+  ScopedProfileZone(const char *name)
+  {
+    if(ZoneProfiler::Recording())
+    {
+      m_Name = name;
+      m_Start = Timing::GetTick();
+    }
+  }
+
+  ~ScopedProfileZone()
+  {
+    if(m_Name)
+      ZoneProfiler::Record(m_Name, m_Start, Timing::GetTick());
+  }
+
+private:
+  const char *m_Name = NULL;
+  uint64_t m_Start = 0;
+};
+
+#define PROFILE_ZONE(name) ScopedProfileZone CONCAT(zone, __LINE__)(name);
@@ -48,45 +48,80 @@ public:
   typedef C Type;
 };
 
-// allocate each class in its own pool so we can identify the type by the pointer
+// allocate each class in its own pool so we can identify the type by the pointer.
+//
+// allocations and frees are served from a small per-thread magazine of free slots, so the common
+// case takes only a TLS lookup and an uncontended spinlock. The central pools are only touched
+// (under m_Lock) once per magazine refill/flush, amortising the lock across many allocations.
+// The lock order is always m_Lock before a magazine's spinlock.
 template <typename WrapType, int PoolCount = 8192, int MaxPoolByteSize = 1024 * 1024, bool DebugClear = true>
 class WrappingPool
 {
 public:
   void *Allocate()
   {
-    SCOPED_LOCK(m_Lock);
-
-    // try and allocate from immediate pool
-    void *ret = m_ImmediatePool.Allocate();
-    if(ret != NULL)
-      return ret;
+    Magazine *mag = GetMagazine();
 
-    // fall back to additional pools, if there are any
-    for(size_t i = 0; i < m_AdditionalPools.size(); i++)
     {
-      ret = m_AdditionalPools[i]->Allocate();
-      if(ret != NULL)
+      Threading::ScopedSpinLock scoped(mag->lock);
+
+      if(mag->count > 0)
+      {
+        void *ret = mag->slots[--mag->count];
+
+#if ENABLED(RDOC_DEVEL)
+        memset(ret, 0xb0, AllocByteSize);
+#endif
+
         return ret;
+      }
     }
 
+    // magazine was empty, hit the central pools
+    SCOPED_LOCK(m_Lock);
+
+    void *ret = AllocateFromPools();
+
+    // if the pools are exhausted, slots may still be cached in other threads' magazines
+    if(ret == NULL)
+      ret = StealFromMagazines();
+
+    if(ret == NULL)
+    {
 // warn when we need to allocate an additional pool
 #if ENABLED(INCLUDE_TYPE_NAMES)
-    RDCWARN("Ran out of free slots in %s pool!", GetTypeName<WrapType>::Name());
+      RDCWARN("Ran out of free slots in %s pool!", GetTypeName<WrapType>::Name());
 #else
-    RDCWARN("Ran out of free slots in pool 0x%p!", &m_ImmediatePool.items[0]);
+      RDCWARN("Ran out of free slots in pool 0x%p!", &m_ImmediatePool.items[0]);
 #endif
 
-    // allocate a new additional pool and use that to allocate from
-    m_AdditionalPools.push_back(new ItemPool());
+      // allocate a new additional pool and use that to allocate from
+      m_AdditionalPools.push_back(new ItemPool());
 
 #if ENABLED(INCLUDE_TYPE_NAMES)
-    RDCDEBUG("WrappingPool[%d]<%s>: %p -> %p", (uint32_t)m_AdditionalPools.size() - 1,
-             GetTypeName<WrapType>::Name(), &m_AdditionalPools.back()->items[0],
-             &m_AdditionalPools.back()->items[AllocCount - 1]);
+      RDCDEBUG("WrappingPool[%d]<%s>: %p -> %p", (uint32_t)m_AdditionalPools.size() - 1,
+               GetTypeName<WrapType>::Name(), &m_AdditionalPools.back()->items[0],
+               &m_AdditionalPools.back()->items[AllocCount - 1]);
 #endif
 
-    return m_AdditionalPools.back()->Allocate();
+      ret = m_AdditionalPools.back()->Allocate();
+    }
+
+    // refill the magazine while we hold the central lock, so the next allocations on this
+    // thread don't come back here
+    {
+      Threading::ScopedSpinLock scoped(mag->lock);
+
+      while(mag->count < MagazineCapacity / 2)
+      {
+        void *slot = AllocateFromPools();
+        if(slot == NULL)
+          break;
+        mag->slots[mag->count++] = slot;
+      }
+    }
+
+    return ret;
   }
 
   bool IsAlloc(const void *p)
@@ -114,35 +149,50 @@ public:
     if(p == NULL)
       return;
 
-    SCOPED_LOCK(m_Lock);
-
-    // try immediate pool
-    if(m_ImmediatePool.IsAlloc(p))
+    if(!IsAlloc(p))
     {
-      m_ImmediatePool.Deallocate(p);
+// this is an error - deleting an object that we don't recognise
+#if ENABLED(INCLUDE_TYPE_NAMES)
+      RDCERR("Resource being deleted through wrong pool - 0x%p not a member of %s", p,
+             GetTypeName<WrapType>::Name());
+#else
+      RDCERR("Resource being deleted through wrong pool - 0x%p not a member of 0x%p", p,
+             &m_ImmediatePool.items[0]);
+#endif
       return;
     }
-    else if(!m_AdditionalPools.empty())
+
+    Magazine *mag = GetMagazine();
+
     {
-      // fall back and try additional pools
-      for(size_t i = 0; i < m_AdditionalPools.size(); i++)
+      Threading::ScopedSpinLock scoped(mag->lock);
+
+      if(mag->count < MagazineCapacity)
       {
-        if(m_AdditionalPools[i]->IsAlloc(p))
-        {
-          m_AdditionalPools[i]->Deallocate(p);
-          return;
-        }
+#if ENABLED(RDOC_DEVEL)
+        if(DebugClear)
+          memset(p, 0xfe, AllocByteSize);
+#endif
+
+        mag->slots[mag->count++] = p;
+        return;
       }
     }
 
-// this is an error - deleting an object that we don't recognise
-#if ENABLED(INCLUDE_TYPE_NAMES)
-    RDCERR("Resource being deleted through wrong pool - 0x%p not a member of %s", p,
-           GetTypeName<WrapType>::Name());
-#else
-    RDCERR("Resource being deleted through wrong pool - 0x%p not a member of 0x%p", p,
-           &m_ImmediatePool.items[0]);
+    // magazine is full - flush half of it back to the central pools, then cache p. The central
+    // lock is taken first to keep the lock order consistent with Allocate().
+    SCOPED_LOCK(m_Lock);
+    Threading::ScopedSpinLock scoped(mag->lock);
+
+    while(mag->count > MagazineCapacity / 2)
+      DeallocateToPools(mag->slots[--mag->count]);
+
+#if ENABLED(RDOC_DEVEL)
+    if(DebugClear)
+      memset(p, 0xfe, AllocByteSize);
 #endif
+
+    mag->slots[mag->count++] = p;
   }
 
   static const size_t AllocCount = PoolCount;
@@ -152,6 +202,9 @@ public:
 private:
   WrappingPool()
   {
+    // only reserves an index with an atomic increment, safe during static initialisation
+    m_MagazineTLSSlot = Threading::AllocateTLSSlot();
+
 #if ENABLED(INCLUDE_TYPE_NAMES)
     // hack - print in kB because float printing relies on statics that might not be initialised
     // yet in loading order. Ugly :(
@@ -162,14 +215,117 @@ private:
   }
   ~WrappingPool()
   {
+    for(size_t i = 0; i < m_Magazines.size(); i++)
+      delete m_Magazines[i];
+
+    m_Magazines.clear();
+
     for(size_t i = 0; i < m_AdditionalPools.size(); i++)
       delete m_AdditionalPools[i];
 
     m_AdditionalPools.clear();
   }
 
+  // cap the cache so that slots idling in magazines can't consume a meaningful fraction of a
+  // small pool.
+  static const size_t MagazineCapacity =
+      AllocCount / 4 > 32 ? 32 : (AllocCount / 4 > 0 ? AllocCount / 4 : 1);
+
+  // per-thread cache of free slots. Only the owning thread pushes and pops, but Allocate() on
+  // another thread can steal from it when the central pools run dry, so every access takes the
+  // (almost always uncontended) spinlock.
+  struct Magazine
+  {
+    Threading::SpinLock lock;
+    void *slots[MagazineCapacity];
+    size_t count = 0;
+  };
+
+  Magazine *GetMagazine()
+  {
+    Magazine *mag = (Magazine *)Threading::GetTLSValue(m_MagazineTLSSlot);
+
+    if(mag == NULL)
+    {
+      mag = new Magazine;
+      Threading::SetTLSValue(m_MagazineTLSSlot, mag);
+
+      // magazines are never destroyed before the pool itself - a thread that exits leaves at
+      // most MagazineCapacity slots cached until then, same as other per-thread state we keep.
+      SCOPED_LOCK(m_Lock);
+      m_Magazines.push_back(mag);
+    }
+
+    return mag;
+  }
+
+  // the below helpers must be called with m_Lock held
+
+  void *AllocateFromPools()
+  {
+    // try and allocate from immediate pool
+    void *ret = m_ImmediatePool.Allocate();
+    if(ret != NULL)
+      return ret;
+
+    // fall back to additional pools, if there are any
+    for(size_t i = 0; i < m_AdditionalPools.size(); i++)
+    {
+      ret = m_AdditionalPools[i]->Allocate();
+      if(ret != NULL)
+        return ret;
+    }
+
+    return NULL;
+  }
+
+  void DeallocateToPools(void *p)
+  {
+    // try immediate pool
+    if(m_ImmediatePool.IsAlloc(p))
+    {
+      m_ImmediatePool.Deallocate(p);
+      return;
+    }
+
+    // fall back and try additional pools. Deallocate() already verified the pointer belongs to
+    // one of them.
+    for(size_t i = 0; i < m_AdditionalPools.size(); i++)
+    {
+      if(m_AdditionalPools[i]->IsAlloc(p))
+      {
+        m_AdditionalPools[i]->Deallocate(p);
+        return;
+      }
+    }
+  }
+
+  void *StealFromMagazines()
+  {
+    for(size_t i = 0; i < m_Magazines.size(); i++)
+    {
+      Threading::ScopedSpinLock scoped(m_Magazines[i]->lock);
+
+      if(m_Magazines[i]->count > 0)
+      {
+        void *ret = m_Magazines[i]->slots[--m_Magazines[i]->count];
+
+#if ENABLED(RDOC_DEVEL)
+        memset(ret, 0xb0, AllocByteSize);
+#endif
+
+        return ret;
+      }
+    }
+
+    return NULL;
+  }
+
   Threading::CriticalSection m_Lock;
 
+  uint64_t m_MagazineTLSSlot;
+  rdcarray<Magazine *> m_Magazines;
+
   struct ItemPool
   {
     ItemPool()
@@ -0,0 +1,143 @@
+/******************************************************************************
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019-2020 Baldur Karlsson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+#include "common/globalconfig.h"
+
+#if ENABLED(ENABLE_UNIT_TESTS)
+
+#include <algorithm>
+#include "common/timing.h"
+#include "common/wrapped_pool.h"
+#include "os/os_specific.h"
+
+#include "catch/catch.hpp"
+
+// sized like a typical wrapped handle
+class PoolTestAlloc
+{
+public:
+  uint64_t payload[8];
+
+  ALLOCATE_WITH_WRAPPED_POOL(PoolTestAlloc);
+};
+
+WRAPPED_POOL_INST(PoolTestAlloc);
+
+TEST_CASE("Test WrappedPool", "[wrapped_pool]")
+{
+  SECTION("allocations are live, distinct and reusable")
+  {
+    rdcarray<PoolTestAlloc *> ptrs;
+
+    // deliberately more than one pool's worth
+    for(int i = 0; i < (int)PoolTestAlloc::PoolType::AllocCount + 100; i++)
+      ptrs.push_back(new PoolTestAlloc);
+
+    for(size_t i = 0; i < ptrs.size(); i++)
+      CHECK(PoolTestAlloc::IsAlloc(ptrs[i]));
+
+    std::sort(ptrs.begin(), ptrs.end());
+    for(size_t i = 1; i < ptrs.size(); i++)
+      CHECK(ptrs[i - 1] != ptrs[i]);
+
+    int stackLocal = 0;
+    CHECK_FALSE(PoolTestAlloc::IsAlloc(&stackLocal));
+
+    for(PoolTestAlloc *p : ptrs)
+      delete p;
+
+    // everything can be allocated again after freeing
+    ptrs.clear();
+    for(int i = 0; i < (int)PoolTestAlloc::PoolType::AllocCount; i++)
+      ptrs.push_back(new PoolTestAlloc);
+    for(PoolTestAlloc *p : ptrs)
+      delete p;
+  };
+};
+
+// hidden behind the benchmark tag - run with 'renderdoccmd test unit --benchmark'.
+// note that in development builds these numbers include the debug clearing memsets.
+TEST_CASE("Benchmark WrappedPool", "[.][benchmark][wrapped_pool]")
+{
+  const int iters = 1000000;
+
+  SECTION("single threaded alloc/free rate")
+  {
+    // churn with a small working set, like transient object wrapping
+    PoolTestAlloc *live[16] = {};
+
+    PerformanceTimer timer;
+
+    for(int i = 0; i < iters; i++)
+    {
+      PoolTestAlloc *&slot = live[i % 16];
+      delete slot;
+      slot = new PoolTestAlloc;
+    }
+
+    double ms = timer.GetMilliseconds();
+
+    for(int i = 0; i < 16; i++)
+      delete live[i];
+
+    WARN("WrappedPool single threaded: " << iters << " alloc/free pairs in " << ms << " ms");
+  };
+
+  SECTION("multithreaded alloc/free rate")
+  {
+    const int numThreads = 4;
+
+    rdcarray<Threading::ThreadHandle> threads;
+
+    PerformanceTimer timer;
+
+    for(int t = 0; t < numThreads; t++)
+    {
+      threads.push_back(Threading::CreateThread([]() {
+        PoolTestAlloc *live[16] = {};
+
+        for(int i = 0; i < iters / numThreads; i++)
+        {
+          PoolTestAlloc *&slot = live[i % 16];
+          delete slot;
+          slot = new PoolTestAlloc;
+        }
+
+        for(int i = 0; i < 16; i++)
+          delete live[i];
+      }));
+    }
+
+    for(Threading::ThreadHandle t : threads)
+    {
+      Threading::JoinThread(t);
+      Threading::CloseThread(t);
+    }
+
+    WARN("WrappedPool " << numThreads << " threads: " << iters << " alloc/free pairs in "
+                        << timer.GetMilliseconds() << " ms");
+  };
+};
+
+#endif    // ENABLED(ENABLE_UNIT_TESTS)
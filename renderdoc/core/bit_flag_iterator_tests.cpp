@@ -28,6 +28,7 @@
 
 #include "api/replay/rdcarray.h"
 #include "bit_flag_iterator.h"
+#include "common/timing.h"
 
 #include "catch/catch.hpp"
 
@@ -129,4 +130,30 @@ TEST_CASE("Test BitFlagIterator type", "[bit_flag_iterator]")
   };
 };
 
+// hidden behind the benchmark tag - run with 'renderdoccmd test unit --benchmark'
+TEST_CASE("Benchmark BitFlagIterator", "[.][benchmark][bit_flag_iterator]")
+{
+  // deterministic mix of empty, sparse and dense words
+  rdcarray<uint32_t> words;
+  words.resize(100000);
+  for(size_t i = 0; i < words.size(); i++)
+    words[i] = uint32_t(i * 2654435761U) & uint32_t(i * 0x9E3779B9U);
+
+  const int passes = 100;
+
+  PerformanceTimer timer;
+
+  uint64_t checksum = 0;
+  for(int pass = 0; pass < passes; pass++)
+    for(size_t i = 0; i < words.size(); i++)
+      for(TestFlagIter it = TestFlagIter::begin(words[i]); it != TestFlagIter::end(); ++it)
+        checksum += *it;
+
+  WARN("BitFlagIterator: " << passes << " passes over " << words.size() << " words in "
+                           << timer.GetMilliseconds() << " ms");
+
+  // keep the loop from being optimised away
+  CHECK(checksum != 0);
+};
+
 #endif    // ENABLED(ENABLE_UNIT_TESTS)
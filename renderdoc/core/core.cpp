@@ -243,6 +243,7 @@ rdcstr DoStringise(const SystemChunk &el)
     STRINGISE_ENUM_CLASS_NAMED(CaptureBegin, "Internal: Beginning of Capture");
     STRINGISE_ENUM_CLASS_NAMED(CaptureScope, "Internal: Frame Metadata");
     STRINGISE_ENUM_CLASS_NAMED(CaptureEnd, "Internal: End of Capture");
+    STRINGISE_ENUM_CLASS_NAMED(InitialContentsReference, "Internal: Initial Contents Reference");
   }
   END_ENUM_STRINGISE();
 }
@@ -345,6 +346,10 @@ void RenderDoc::Initialise()
 
   Threading::Init();
 
+  // hand log writing off to a background thread now that threading is initialised. Anything
+  // logged before this point was written synchronously.
+  RDCLOGASYNC();
+
   m_RemoteIdent = 0;
   m_RemoteThread = 0;
 
@@ -456,10 +461,66 @@ void RenderDoc::Initialise()
     RDCLOGOUTPUT();
 
   ProcessConfig();
+
+  // record profiling zones for the lifetime of the process if requested, the trace is written to
+  // the given path on shutdown where it can be attached to a bug report.
+  if(Process::GetEnvVariable("RENDERDOC_PROFILE_TRACE"))
+  {
+    RDCLOG("Recording profiling zones");
+    ZoneProfiler::Start();
+  }
+}
+
+// writes recorded profiling zones out through the chrome trace exporter, by packing them into a
+// structured file the same way capture chunks are stored - name plus timestamp/duration/thread
+// metadata is all the exporter reads.
+static void WriteProfileTrace(const char *path)
+{
+  rdcarray<ZoneEvent> zones;
+  ZoneProfiler::StopAndGather(zones);
+
+  // order by start time, with longer (enclosing) zones first on ties, so begin/end event pairs
+  // nest properly in the trace
+  std::sort(zones.begin(), zones.end(), [](const ZoneEvent &a, const ZoneEvent &b) {
+    if(a.timestampMicro != b.timestampMicro)
+      return a.timestampMicro < b.timestampMicro;
+    return a.durationMicro > b.durationMicro;
+  });
+
+  SDFile structData;
+
+  for(const ZoneEvent &zone : zones)
+  {
+    SDChunk *chunk = new SDChunk(zone.name);
+    chunk->metadata.timestampMicro = zone.timestampMicro;
+    chunk->metadata.durationMicro = int64_t(zone.durationMicro);
+    chunk->metadata.threadID = zone.threadID;
+    structData.chunks.push_back(chunk);
+  }
+
+  CaptureExporter exporter = RenderDoc::Inst().GetCaptureExporter("chrome.json");
+
+  if(!exporter)
+  {
+    RDCERR("Couldn't get chrome.json exporter to write profile trace");
+    return;
+  }
+
+  RDCFile rdc;
+  ReplayStatus status = exporter(path, rdc, structData, RENDERDOC_ProgressCallback());
+
+  if(status == ReplayStatus::Succeeded)
+    RDCLOG("Wrote profile trace with %zu zones to %s", zones.size(), path);
+  else
+    RDCERR("Failed writing profile trace to %s", path);
 }
 
 RenderDoc::~RenderDoc()
 {
+  const char *tracePath = Process::GetEnvVariable("RENDERDOC_PROFILE_TRACE");
+  if(tracePath && ZoneProfiler::Recording())
+    WriteProfileTrace(tracePath);
+
   if(m_ExHandler)
   {
     UnloadCrashHandler();
@@ -502,6 +563,8 @@ RenderDoc::~RenderDoc()
 
   Network::Shutdown();
 
+  Threading::ShutdownJobSystem();
+
   Threading::Shutdown();
 
   StringFormat::Shutdown();
@@ -1159,6 +1222,16 @@ RDCFile *RenderDoc::CreateRDC(RDCDriver driver, uint32_t frameNum, const FramePi
 
   ret->SetData(driver, ToStr(driver).c_str(), OSUtility::GetMachineIdent(), &outPng);
 
+  // fill in the header's capture summary so browsers can list this file without touching any
+  // compressed sections. Everything here is known before the frame contents are serialised.
+  {
+    RDCCaptureSummary summary;
+    summary.frameNumber = frameNum;
+    summary.frameTimeMicroseconds = uint32_t(m_FrameTimer.GetAvgFrameTime() * 1000.0);
+    summary.captureTimeUnix = Timing::GetUnixTimestamp();
+    ret->SetCaptureSummary(summary);
+  }
+
   FileIO::CreateParentDirectory(m_CurrentLogFile);
 
   ret->Create(m_CurrentLogFile.c_str());
@@ -168,6 +168,9 @@ enum class SystemChunk : uint32_t
   CaptureBegin,
   CaptureScope,
   CaptureEnd,
+  // no initial data - the resource's initial contents are identical to another resource's, and
+  // the chunk just references the resource that was serialised with the shared data
+  InitialContentsReference,
 
   FirstDriverChunk = 1000,
 };
@@ -301,6 +304,23 @@ inline constexpr float ProgressWeight(CaptureProgress section)
                                      : section == CaptureProgress::FileWriting ? 0.02f : 0.0f;
 }
 
+// counter fetches replay the frame once for the built-in queries, plus however many passes the IHV
+// counter library schedules, so the only meaningful granularity is per replay pass.
+enum class CounterProgress
+{
+  FetchPass,
+  First = FetchPass,
+  Count,
+};
+
+DECLARE_REFLECTION_ENUM(CounterProgress);
+ITERABLE_OPERATORS(CounterProgress);
+
+inline constexpr float ProgressWeight(CounterProgress section)
+{
+  return section == CounterProgress::FetchPass ? 1.0f : 0.0f;
+}
+
 // utility function to fake progress with x going from 0 to infinity, mapping to 0% to 100% in an
 // inverse curve. For x from 0 to maxX the progress is reasonably spaced, past that it will be quite
 // crushed.
@@ -546,6 +566,15 @@ public:
     wnd = m_ActiveWindow.wnd;
   }
 
+  // begins capturing the next numFrames frames. Each frame becomes its own self-contained
+  // capture - storing frames 2..N as deltas against the previous frame's end state would shrink
+  // multi-frame captures considerably, but self-containment is load-bearing: every .rdc can be
+  // opened, replayed and shared on its own, and replay only has frame N-1's end state after
+  // fully replaying it. Dirty tracking is whole-resource too, so a 'delta' would be the full
+  // initial state of everything written anyway - the real saving is sharing the initial-state
+  // blobs of resources untouched by the preceding frame, and that needs per-driver retention
+  // work first since prepared initial contents don't survive EndFrameCapture (Vulkan, for one,
+  // frees the whole MemoryScope::InitialContents arena there).
   void TriggerCapture(uint32_t numFrames) { m_Cap = numFrames; }
   uint32_t GetOverlayBits() { return m_Overlay; }
   void MaskOverlayBits(uint32_t And, uint32_t Or) { m_Overlay = (m_Overlay & And) | Or; }
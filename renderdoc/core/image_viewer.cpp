@@ -23,6 +23,7 @@
  ******************************************************************************/
 
 #include "common/dds_readwrite.h"
+#include "common/threading.h"
 #include "core/core.h"
 #include "replay/replay_driver.h"
 #include "serialise/rdcfile.h"
@@ -257,6 +258,13 @@ public:
   {
     return rdcarray<PixelModification>();
   }
+  rdcarray<rdcarray<PixelModification>> PixelHistoryRegion(rdcarray<EventUsage> events,
+                                                           ResourceId target, uint32_t x, uint32_t y,
+                                                           uint32_t width, uint32_t height,
+                                                           const Subresource &sub, CompType typeCast)
+  {
+    return rdcarray<rdcarray<PixelModification>>();
+  }
   ShaderDebugTrace *DebugVertex(uint32_t eventId, uint32_t vertid, uint32_t instid, uint32_t idx)
   {
     return new ShaderDebugTrace();
@@ -266,6 +274,10 @@ public:
   {
     return new ShaderDebugTrace();
   }
+  rdcarray<ShaderDebugTrace *> DebugPixels(uint32_t eventId, const rdcarray<PixelDebugTarget> &targets)
+  {
+    return StandardDebugPixels(this, eventId, targets);
+  }
   ShaderDebugTrace *DebugThread(uint32_t eventId, const uint32_t groupid[3],
                                 const uint32_t threadid[3])
   {
@@ -344,17 +356,31 @@ ReplayStatus IMG_CreateReplayDevice(RDCFile *rdc, IReplayDriver **driver)
     uint64_t size = FileIO::ftell64(f);
     FileIO::fseek64(f, 0, SEEK_SET);
 
+    // tinyexr only parses from memory, so map the file rather than copying it onto the heap
+    const byte *exrData = NULL;
     bytebuf buffer;
-    buffer.resize((size_t)size);
 
-    FileIO::fread(&buffer[0], 1, buffer.size(), f);
+    FileIO::FileMapping *mapping = FileIO::map_region(f, 0, size);
+
+    if(mapping)
+    {
+      exrData = FileIO::map_data(mapping);
+    }
+    else
+    {
+      buffer.resize((size_t)size);
+      FileIO::fread(&buffer[0], 1, buffer.size(), f);
+      exrData = buffer.data();
+    }
 
     EXRVersion exrVersion;
-    int ret = ParseEXRVersionFromMemory(&exrVersion, buffer.data(), buffer.size());
+    int ret = ParseEXRVersionFromMemory(&exrVersion, exrData, (size_t)size);
 
     if(ret != 0)
     {
       RDCERR("EXR file detected, but couldn't load with ParseEXRVersionFromMemory: %d", ret);
+      if(mapping)
+        FileIO::map_close(mapping);
       FileIO::fclose(f);
       return ReplayStatus::ImageUnsupported;
     }
@@ -362,6 +388,8 @@ ReplayStatus IMG_CreateReplayDevice(RDCFile *rdc, IReplayDriver **driver)
     if(exrVersion.multipart || exrVersion.non_image || exrVersion.tiled)
     {
       RDCERR("Unsupported EXR file detected - multipart or similar.");
+      if(mapping)
+        FileIO::map_close(mapping);
       FileIO::fclose(f);
       return ReplayStatus::ImageUnsupported;
     }
@@ -369,7 +397,10 @@ ReplayStatus IMG_CreateReplayDevice(RDCFile *rdc, IReplayDriver **driver)
     EXRHeader exrHeader;
     InitEXRHeader(&exrHeader);
 
-    ret = ParseEXRHeaderFromMemory(&exrHeader, &exrVersion, buffer.data(), buffer.size(), &err);
+    ret = ParseEXRHeaderFromMemory(&exrHeader, &exrVersion, exrData, (size_t)size, &err);
+
+    if(mapping)
+      FileIO::map_close(mapping);
 
     if(ret != 0)
     {
@@ -531,17 +562,32 @@ void ImageViewer::RefreshFile()
 
     FileIO::fseek64(f, 0, SEEK_SET);
 
+    // map the file rather than copying it onto the heap - tinyexr only reads from memory, and for
+    // large renders the copy doubles peak memory before decoding even starts
+    const byte *exrData = NULL;
     bytebuf buffer;
-    buffer.resize((size_t)fileSize);
 
-    FileIO::fread(buffer.data(), 1, buffer.size(), f);
+    FileIO::FileMapping *mapping = FileIO::map_region(f, 0, fileSize);
+
+    if(mapping)
+    {
+      exrData = FileIO::map_data(mapping);
+    }
+    else
+    {
+      buffer.resize((size_t)fileSize);
+      FileIO::fread(buffer.data(), 1, buffer.size(), f);
+      exrData = buffer.data();
+    }
 
     EXRVersion exrVersion;
-    int ret = ParseEXRVersionFromMemory(&exrVersion, buffer.data(), buffer.size());
+    int ret = ParseEXRVersionFromMemory(&exrVersion, exrData, (size_t)fileSize);
 
     if(ret != 0)
     {
       RDCERR("EXR file detected, but couldn't load with ParseEXRVersionFromMemory: %d", ret);
+      if(mapping)
+        FileIO::map_close(mapping);
       FileIO::fclose(f);
       return;
     }
@@ -549,6 +595,8 @@ void ImageViewer::RefreshFile()
     if(exrVersion.multipart || exrVersion.non_image || exrVersion.tiled)
     {
       RDCERR("Unsupported EXR file detected - multipart or similar.");
+      if(mapping)
+        FileIO::map_close(mapping);
       FileIO::fclose(f);
       return;
     }
@@ -558,10 +606,12 @@ void ImageViewer::RefreshFile()
 
     const char *err = NULL;
 
-    ret = ParseEXRHeaderFromMemory(&exrHeader, &exrVersion, buffer.data(), buffer.size(), &err);
+    ret = ParseEXRHeaderFromMemory(&exrHeader, &exrVersion, exrData, (size_t)fileSize, &err);
     if(ret != 0)
     {
       RDCERR("EXR file detected, but couldn't load with ParseEXRHeaderFromMemory %d: '%s'", ret, err);
+      if(mapping)
+        FileIO::map_close(mapping);
       FileIO::fclose(f);
       return;
     }
@@ -572,7 +622,12 @@ void ImageViewer::RefreshFile()
     EXRImage exrImage;
     InitEXRImage(&exrImage);
 
-    ret = LoadEXRImageFromMemory(&exrImage, &exrHeader, buffer.data(), buffer.size(), &err);
+    ret = LoadEXRImageFromMemory(&exrImage, &exrHeader, exrData, (size_t)fileSize, &err);
+
+    // the decoded planes are independent of the source data now
+    if(mapping)
+      FileIO::map_close(mapping);
+
     if(ret != 0)
     {
       RDCERR("EXR file detected, but couldn't load with LoadEXRImageFromMemory %d: '%s'", ret, err);
@@ -601,18 +656,24 @@ void ImageViewer::RefreshFile()
     float *rgba = (float *)data;
     float **src = (float **)exrImage.images;
 
-    for(uint32_t i = 0; i < texDetails.width * texDetails.height; i++)
-    {
-      for(int c = 0; c < 4; c++)
+    // each row writes a disjoint range, so interleave the planes in parallel
+    const uint32_t exrWidth = texDetails.width;
+    Threading::ParallelFor(texDetails.height, [rgba, src, &channels, exrWidth](size_t y) {
+      for(uint32_t x = 0; x < exrWidth; x++)
       {
-        if(channels[c] >= 0)
-          rgba[i * 4 + c] = src[channels[c]][i];
-        else if(c < 3)    // RGB channels default to 0
-          rgba[i * 4 + c] = 0.0f;
-        else    // alpha defaults to 1
-          rgba[i * 4 + c] = 1.0f;
+        const uint32_t i = uint32_t(y) * exrWidth + x;
+
+        for(int c = 0; c < 4; c++)
+        {
+          if(channels[c] >= 0)
+            rgba[i * 4 + c] = src[channels[c]][i];
+          else if(c < 3)    // RGB channels default to 0
+            rgba[i * 4 + c] = 0.0f;
+          else    // alpha defaults to 1
+            rgba[i * 4 + c] = 1.0f;
+        }
       }
-    }
+    });
 
     ret = FreeEXRImage(&exrImage);
 
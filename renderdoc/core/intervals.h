@@ -24,7 +24,9 @@
 
 #pragma once
 
+#include <algorithm>
 #include <map>
+#include "api/replay/rdcarray.h"
 #include "common/common.h"
 
 template <typename T>
@@ -246,6 +248,61 @@ public:
       i->mergeLeft();
   }
 
+  // A single range in a batch update - the interval [start, finish) with the value to compose.
+  struct RangeValue
+  {
+    uint64_t start;
+    uint64_t finish;
+    T value;
+  };
+
+  // Apply a batch of `update`s in a single pass.
+  // The ranges are sorted by start point and applied with a cursor that only walks forwards where
+  // possible, so applying many small ranges (e.g. per-binding memory references) avoids a map
+  // lookup per range. Where ranges overlap, their values are composed in order of ascending start
+  // point rather than in array order, so `comp` should be commutative if the batch may contain
+  // overlaps.
+  template <typename Compose>
+  void updateMany(rdcarray<RangeValue> &ranges, Compose comp)
+  {
+    std::stable_sort(ranges.begin(), ranges.end(),
+                     [](const RangeValue &a, const RangeValue &b) { return a.start < b.start; });
+
+    iterator i = begin();
+
+    for(const RangeValue &r : ranges)
+    {
+      if(r.finish <= r.start)
+        continue;
+
+      // advance the cursor to the interval containing `r.start`. Because the ranges are sorted
+      // this almost always moves forwards; if the previous range overlapped this one the cursor
+      // may have ended up past `r.start`, in which case fall back to a fresh lookup.
+      while(i != end() && i->finish() <= r.start)
+        i++;
+
+      if(i == end() || i->start() > r.start)
+        i = find(r.start);
+
+      // the rest mirrors update() exactly
+      i->split(r.start);
+
+      for(; i != end() && i->start() < r.finish; i++)
+      {
+        if(i->finish() > r.finish)
+        {
+          i->split(r.finish);
+          i--;
+        }
+        i->setValue(comp(i->value(), r.value));
+        i->mergeLeft();
+      }
+
+      if(i != end())
+        i->mergeLeft();
+    }
+  }
+
   // Update `this` by composing the value of each interval with the value of the
   // corresponding interval in `other`.
   // If the intervals in `this` and `other` do not line up, then the intervals in
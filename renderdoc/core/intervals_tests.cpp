@@ -27,6 +27,7 @@
 #if ENABLED(ENABLE_UNIT_TESTS)
 
 #include "api/replay/rdcarray.h"
+#include "common/timing.h"
 #include "intervals.h"
 
 #include "catch/catch.hpp"
@@ -439,6 +440,199 @@ TEST_CASE("Test Intervals type", "[intervals]")
       check_intervals(test, {{0, 0, 10}, {10, 1, 50}, {50, 0, UINT64_MAX}});
     };
   };
+
+  SECTION("updateMany tests")
+  {
+    SECTION("empty batch")
+    {
+      Intervals<uint64_t> test;
+      rdcarray<Intervals<uint64_t>::RangeValue> ranges;
+      test.updateMany(ranges, [](uint64_t x, uint64_t y) -> uint64_t { return x + y; });
+      check_intervals(test, {{0, 0, UINT64_MAX}});
+    };
+
+    SECTION("single range matches update")
+    {
+      Intervals<uint64_t> test;
+      rdcarray<Intervals<uint64_t>::RangeValue> ranges = {{5, 10, 1}};
+      test.updateMany(ranges, [](uint64_t x, uint64_t y) -> uint64_t { return x + y; });
+      check_intervals(test, {{0, 0, 5}, {5, 1, 10}, {10, 0, UINT64_MAX}});
+    };
+
+    SECTION("disjoint ranges in sorted order")
+    {
+      Intervals<uint64_t> test;
+      rdcarray<Intervals<uint64_t>::RangeValue> ranges = {{5, 10, 1}, {20, 30, 2}, {40, 50, 3}};
+      test.updateMany(ranges, [](uint64_t x, uint64_t y) -> uint64_t { return x + y; });
+      check_intervals(test, {{0, 0, 5},
+                             {5, 1, 10},
+                             {10, 0, 20},
+                             {20, 2, 30},
+                             {30, 0, 40},
+                             {40, 3, 50},
+                             {50, 0, UINT64_MAX}});
+    };
+
+    SECTION("disjoint ranges in reverse order")
+    {
+      Intervals<uint64_t> test;
+      rdcarray<Intervals<uint64_t>::RangeValue> ranges = {{40, 50, 3}, {20, 30, 2}, {5, 10, 1}};
+      test.updateMany(ranges, [](uint64_t x, uint64_t y) -> uint64_t { return x + y; });
+      check_intervals(test, {{0, 0, 5},
+                             {5, 1, 10},
+                             {10, 0, 20},
+                             {20, 2, 30},
+                             {30, 0, 40},
+                             {40, 3, 50},
+                             {50, 0, UINT64_MAX}});
+    };
+
+    SECTION("touching ranges with equal values merge")
+    {
+      Intervals<uint64_t> test;
+      rdcarray<Intervals<uint64_t>::RangeValue> ranges = {{5, 10, 1}, {10, 15, 1}, {15, 20, 1}};
+      test.updateMany(ranges, [](uint64_t x, uint64_t y) -> uint64_t { return x + y; });
+      check_intervals(test, {{0, 0, 5}, {5, 1, 20}, {20, 0, UINT64_MAX}});
+    };
+
+    SECTION("overlapping ranges compose")
+    {
+      Intervals<uint64_t> test;
+      rdcarray<Intervals<uint64_t>::RangeValue> ranges = {{5, 15, 1}, {10, 20, 1}};
+      test.updateMany(ranges, [](uint64_t x, uint64_t y) -> uint64_t { return x + y; });
+      check_intervals(test, {{0, 0, 5}, {5, 1, 10}, {10, 2, 15}, {15, 1, 20}, {20, 0, UINT64_MAX}});
+    };
+
+    SECTION("duplicate ranges compose")
+    {
+      Intervals<uint64_t> test;
+      rdcarray<Intervals<uint64_t>::RangeValue> ranges = {{5, 10, 1}, {5, 10, 1}, {5, 10, 1}};
+      test.updateMany(ranges, [](uint64_t x, uint64_t y) -> uint64_t { return x + y; });
+      check_intervals(test, {{0, 0, 5}, {5, 3, 10}, {10, 0, UINT64_MAX}});
+    };
+
+    SECTION("range contained in previous range")
+    {
+      Intervals<uint64_t> test;
+      rdcarray<Intervals<uint64_t>::RangeValue> ranges = {{5, 30, 1}, {10, 20, 1}};
+      test.updateMany(ranges, [](uint64_t x, uint64_t y) -> uint64_t { return x + y; });
+      check_intervals(test, {{0, 0, 5}, {5, 1, 10}, {10, 2, 20}, {20, 1, 30}, {30, 0, UINT64_MAX}});
+    };
+
+    SECTION("empty ranges are ignored")
+    {
+      Intervals<uint64_t> test;
+      rdcarray<Intervals<uint64_t>::RangeValue> ranges = {{5, 5, 1}, {10, 20, 2}, {30, 25, 3}};
+      test.updateMany(ranges, [](uint64_t x, uint64_t y) -> uint64_t { return x + y; });
+      check_intervals(test, {{0, 0, 10}, {10, 2, 20}, {20, 0, UINT64_MAX}});
+    };
+
+    SECTION("batch into existing intervals")
+    {
+      Intervals<uint64_t> test = make_intervals({{0, 0, 5}, {5, 1, 10}, {10, 0, UINT64_MAX}});
+      rdcarray<Intervals<uint64_t>::RangeValue> ranges = {{7, 12, 1}, {20, 30, 1}};
+      test.updateMany(ranges, [](uint64_t x, uint64_t y) -> uint64_t { return x + y; });
+      check_intervals(test, {{0, 0, 5},
+                             {5, 1, 7},
+                             {7, 2, 10},
+                             {10, 1, 12},
+                             {12, 0, 20},
+                             {20, 1, 30},
+                             {30, 0, UINT64_MAX}});
+    };
+
+    SECTION("range finishing at UINT64_MAX")
+    {
+      Intervals<uint64_t> test;
+      rdcarray<Intervals<uint64_t>::RangeValue> ranges = {{0, UINT64_MAX, 1}, {5, 10, 1}};
+      test.updateMany(ranges, [](uint64_t x, uint64_t y) -> uint64_t { return x + y; });
+      check_intervals(test, {{0, 1, 5}, {5, 2, 10}, {10, 1, UINT64_MAX}});
+    };
+
+    SECTION("matches repeated update calls")
+    {
+      rdcarray<Intervals<uint64_t>::RangeValue> ranges;
+      for(uint64_t i = 0; i < 100; i++)
+        ranges.push_back({(i * 37) % 512, (i * 37) % 512 + 16 + (i % 7), 1 + (i % 3)});
+
+      Intervals<uint64_t> expected;
+      for(const Intervals<uint64_t>::RangeValue &r : ranges)
+        expected.update(r.start, r.finish, r.value,
+                        [](uint64_t x, uint64_t y) -> uint64_t { return x + y; });
+
+      Intervals<uint64_t> test;
+      test.updateMany(ranges, [](uint64_t x, uint64_t y) -> uint64_t { return x + y; });
+
+      rdcarray<Interval> expectedIntervals;
+      for(auto it = expected.begin(); it != expected.end(); it++)
+        expectedIntervals.push_back({it->start(), it->value(), it->finish()});
+      check_intervals(test, expectedIntervals);
+    };
+  };
+};
+
+// hidden behind the benchmark tag - run with 'renderdoccmd test unit --benchmark'
+TEST_CASE("Benchmark Intervals", "[.][benchmark][intervals]")
+{
+  // overlapping windows over a re-used address range, similar to the memory references merged
+  // during capture - updates constantly split and re-merge existing intervals
+  const uint64_t numRanges = 100000;
+
+  rdcarray<Intervals<uint64_t>::RangeValue> ranges;
+  ranges.reserve(numRanges);
+  for(uint64_t i = 0; i < numRanges; i++)
+  {
+    uint64_t start = (i * 37) % 100000;
+    ranges.push_back({start, start + 64 + (i % 17), 1 + (i % 3)});
+  }
+
+  SECTION("update merge throughput")
+  {
+    Intervals<uint64_t> test;
+
+    PerformanceTimer timer;
+
+    for(const Intervals<uint64_t>::RangeValue &r : ranges)
+      test.update(r.start, r.finish, r.value,
+                  [](uint64_t x, uint64_t y) -> uint64_t { return x | y; });
+
+    WARN("Intervals::update: " << numRanges << " updates in " << timer.GetMilliseconds() << " ms");
+  };
+
+  SECTION("updateMany merge throughput")
+  {
+    Intervals<uint64_t> test;
+
+    PerformanceTimer timer;
+
+    test.updateMany(ranges, [](uint64_t x, uint64_t y) -> uint64_t { return x | y; });
+
+    WARN("Intervals::updateMany: " << numRanges << " updates in " << timer.GetMilliseconds()
+                                   << " ms");
+  };
+
+  SECTION("iteration throughput")
+  {
+    // disjoint ranges so the interval count matches the update count
+    Intervals<uint64_t> test;
+    for(uint64_t i = 0; i < numRanges; i++)
+      test.update(i * 10, i * 10 + 5, i, [](uint64_t x, uint64_t y) -> uint64_t { return x + y; });
+
+    const int passes = 10;
+
+    PerformanceTimer timer;
+
+    uint64_t checksum = 0;
+    for(int pass = 0; pass < passes; pass++)
+      for(auto it = test.begin(); it != test.end(); it++)
+        checksum += it->value() + (it->finish() - it->start());
+
+    WARN("Intervals iteration: " << passes << " passes over " << numRanges * 2 + 1
+                                 << " intervals in " << timer.GetMilliseconds() << " ms");
+
+    // keep the loop from being optimised away
+    CHECK(checksum != 0);
+  };
 };
 
 #endif    // ENABLED(ENABLE_UNIT_TESTS)
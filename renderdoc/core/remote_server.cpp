@@ -24,6 +24,7 @@
  ******************************************************************************/
 
 #include "remote_server.h"
+#include <algorithm>
 #include <utility>
 #include "android/android.h"
 #include "api/replay/renderdoc_replay.h"
@@ -32,14 +33,30 @@
 #include "core/settings.h"
 #include "os/os_specific.h"
 #include "replay/replay_controller.h"
+#include "serialise/lz4io.h"
 #include "serialise/rdcfile.h"
 #include "serialise/serialiser.h"
 #include "strings/string_utils.h"
+#include "zstd/xxhash.h"
 #include "replay_proxy.h"
 
 RDOC_CONFIG(uint32_t, RemoteServer_TimeoutMS, 5000,
             "Timeout in milliseconds for remote server operations.");
 
+RDOC_CONFIG(uint32_t, RemoteServer_CaptureCacheSize, 8,
+            "Number of uploaded capture files the remote server keeps cached on disk, keyed by "
+            "content hash, so re-opening a recently analysed capture doesn't re-upload it.");
+
+RDOC_CONFIG(uint32_t, RemoteServer_ListDirPrefetchDepth, 3,
+            "Number of directory levels a remote file listing fetches in one request. Deeper "
+            "directories are prefetched alongside the one requested and answered from a local "
+            "cache when the user browses into them.");
+
+RDOC_CONFIG(uint32_t, RemoteServer_ListDirMaxEntries, 20000,
+            "Cap applied by the remote server on the total number of entries returned by a single "
+            "recursive listing request, so a request rooted near a huge tree can't produce an "
+            "unbounded response.");
+
 RDOC_DEBUG_CONFIG(bool, RemoteServer_DebugLogging, false,
                   "Output a verbose logging file in the system's temporary folder containing the "
                   "traffic to and from the remote server.");
@@ -79,6 +96,8 @@ enum RemoteServerPacket
   eRemoteServer_GetSectionContents,
   eRemoteServer_WriteSection,
   eRemoteServer_GetAvailableGPUs,
+  eRemoteServer_CaptureCached,
+  eRemoteServer_ListDirRecursive,
   eRemoteServer_RemoteServerCount,
 };
 
@@ -122,6 +141,8 @@ rdcstr DoStringise(const RemoteServerPacket &el)
     STRINGISE_ENUM_NAMED(eRemoteServer_GetSectionContents, "GetSectionContents");
     STRINGISE_ENUM_NAMED(eRemoteServer_WriteSection, "WriteSection");
     STRINGISE_ENUM_NAMED(eRemoteServer_GetAvailableGPUs, "GetAvailableGPUs");
+    STRINGISE_ENUM_NAMED(eRemoteServer_CaptureCached, "CaptureCached");
+    STRINGISE_ENUM_NAMED(eRemoteServer_ListDirRecursive, "ListDirRecursive");
     STRINGISE_ENUM_NAMED(eRemoteServer_RemoteServerCount, "RemoteServerCount");
   }
   END_ENUM_STRINGISE();
@@ -138,6 +159,134 @@ rdcstr GetRemoteServerChunkName(uint32_t idx)
 #define WRITE_DATA_SCOPE() WriteSerialiser &ser = writer;
 #define READ_DATA_SCOPE() ReadSerialiser &ser = reader;
 
+// sends the contents of fileStream through a block-compressed lz4 stream inside the current chunk,
+// so that capture files don't cross the network uncompressed - over e.g. USB to an android device
+// this is usually the difference between minutes and tens of seconds for a large capture. Since the
+// decompression chain on the receiving side needs to know the exact uncompressed size, we
+// over-estimate (to allow for length/padding/etc) and then pad to this amount, the same way the
+// replay proxy transfers bulk data.
+static void SendCompressedStream(WriteSerialiser &ser, const rdcstr &name, StreamReader &fileStream,
+                                 RENDERDOC_ProgressCallback progress)
+{
+  uint64_t dataSize = fileStream.GetSize() + 2 * ser.GetChunkAlignment();
+  ser.Serialise("dataSize"_lit, dataSize);
+
+  WriteSerialiser streamser(new StreamWriter(new LZ4Compressor(ser.GetWriter(), Ownership::Nothing),
+                                             Ownership::Stream),
+                            Ownership::Stream);
+
+  streamser.SerialiseStream(name, fileStream, progress);
+
+  char empty[128] = {};
+
+  uint64_t offs = streamser.GetWriter()->GetOffset();
+  RDCASSERT(offs <= dataSize, offs, dataSize);
+  RDCASSERT(dataSize - offs < sizeof(empty), offs, dataSize);
+
+  if(offs < dataSize)
+    streamser.GetWriter()->Write(empty, dataSize - offs);
+}
+
+// receiving side of SendCompressedStream above.
+static void ReceiveCompressedStream(ReadSerialiser &ser, const rdcstr &name,
+                                    StreamWriter &fileStream, RENDERDOC_ProgressCallback progress)
+{
+  uint64_t dataSize = 0;
+  ser.Serialise("dataSize"_lit, dataSize);
+
+  ReadSerialiser streamser(new StreamReader(new LZ4Decompressor(ser.GetReader(), Ownership::Nothing),
+                                            dataSize, Ownership::Stream),
+                           Ownership::Stream);
+
+  streamser.SerialiseStream(name, fileStream, progress);
+
+  char empty[128] = {};
+
+  uint64_t offs = streamser.GetReader()->GetOffset();
+  RDCASSERT(offs <= dataSize, offs, dataSize);
+  RDCASSERT(dataSize - offs < sizeof(empty), offs, dataSize);
+
+  if(offs < dataSize)
+    streamser.GetReader()->Read(empty, dataSize - offs);
+}
+
+// captures uploaded to the server are stored here keyed by content hash, and deliberately persist
+// across connections (pruned oldest-first to RemoteServer_CaptureCacheSize entries) so that
+// disconnecting and later re-opening a capture we already analysed skips the whole upload.
+static rdcstr GetCachedCapturePath(uint64_t hash)
+{
+  return FileIO::GetTempFolderFilename() +
+         StringFormat::Fmt("/RenderDoc/remotecache/%016llx.rdc", hash);
+}
+
+// hashes a range of a file's contents, clamped to EOF. Returns 0 on failure, which disables
+// caching and resume for this copy.
+static uint64_t HashFileRange(const rdcstr &filename, uint64_t offset, uint64_t length)
+{
+  FILE *f = FileIO::fopen(filename.c_str(), "rb");
+
+  if(!f)
+    return 0;
+
+  FileIO::fseek64(f, offset, SEEK_SET);
+
+  XXH64_state_t *state = XXH64_createState();
+  XXH64_reset(state, 0);
+
+  byte buf[64 * 1024];
+
+  uint64_t remaining = length;
+  size_t numRead = 0;
+  do
+  {
+    numRead = FileIO::fread(buf, 1, (size_t)RDCMIN((uint64_t)sizeof(buf), remaining), f);
+    XXH64_update(state, buf, numRead);
+    remaining -= numRead;
+  } while(numRead == sizeof(buf) && remaining > 0);
+
+  FileIO::fclose(f);
+
+  uint64_t hash = XXH64_digest(state);
+  XXH64_freeState(state);
+
+  return hash;
+}
+
+// hashes a capture file's contents. Returns 0 on failure, which disables caching for this copy.
+static uint64_t HashCaptureFile(const rdcstr &filename)
+{
+  return HashFileRange(filename, 0, ~0ULL);
+}
+
+static void PruneCaptureCache(uint64_t keepHash)
+{
+  rdcstr keepPath = GetCachedCapturePath(keepHash);
+  rdcstr dir = get_dirname(keepPath);
+  rdcstr keepFile = get_basename(keepPath);
+
+  rdcarray<PathEntry> files;
+  FileIO::GetFilesInDirectory(dir.c_str(), files);
+
+  std::sort(files.begin(), files.end(),
+            [](const PathEntry &a, const PathEntry &b) { return a.lastmod < b.lastmod; });
+
+  // delete oldest-first until we're within the cache size, never deleting the file we just
+  // received. Note entries aren't re-dated on a cache hit, so a heavily reused capture can still
+  // age out - that only costs a redundant upload next time, not any correctness.
+  size_t count = files.size();
+  for(const PathEntry &f : files)
+  {
+    if(count <= RemoteServer_CaptureCacheSize)
+      break;
+
+    if(f.filename == keepFile)
+      continue;
+
+    FileIO::Delete((dir + "/" + f.filename).c_str());
+    count--;
+  }
+}
+
 struct ClientThread
 {
   ClientThread()
@@ -154,59 +303,54 @@ struct ClientThread
   Threading::ThreadHandle thread;
 };
 
-static void InactiveRemoteClientThread(ClientThread *threadData)
+// A replay loaded on behalf of one client and shared with any later clients that open the same
+// capture path. The first client pays for the load; the rest attach to the already-initialised
+// driver and only pay for their own readbacks. GPU access is serialised via the lock, and each
+// proxy's event cursor is restored before its commands run if another client moved the replay
+// in the meantime.
+struct SharedReplay
 {
-  Threading::SetCurrentThreadName("InactiveRemoteClientThread");
-
-  uint32_t ip = threadData->socket->GetRemoteIP();
-
-  {
-    uint32_t version = 0;
+  rdcstr path;
+  int refcount = 0;
+  Threading::CriticalSection lock;
+  ReplayProxy *lastProxy = NULL;
+  RDCFile *rdc = NULL;
+  IRemoteDriver *remoteDriver = NULL;
+  IReplayDriver *replayDriver = NULL;
+  ReplayStatus status = ReplayStatus::InternalError;
+};
 
-    {
-      ReadSerialiser ser(new StreamReader(threadData->socket, Ownership::Nothing), Ownership::Stream);
+static Threading::CriticalSection sharedReplaysLock;
+static rdcarray<SharedReplay *> sharedReplays;
 
-      // this thread just handles receiving the handshake and sending a busy signal without blocking
-      // the server thread
-      RemoteServerPacket type = ser.ReadChunk<RemoteServerPacket>();
+static void ReleaseSharedReplay(SharedReplay *share)
+{
+  if(!share)
+    return;
 
-      if(ser.IsErrored() || type != eRemoteServer_Handshake)
-      {
-        RDCWARN("Didn't receive proper handshake");
-        SAFE_DELETE(threadData->socket);
-        return;
-      }
+  bool last = false;
 
-      SERIALISE_ELEMENT(version);
+  {
+    SCOPED_LOCK(sharedReplaysLock);
 
-      ser.EndChunk();
-    }
+    share->refcount--;
 
+    if(share->refcount == 0)
     {
-      WriteSerialiser ser(new StreamWriter(threadData->socket, Ownership::Nothing),
-                          Ownership::Stream);
-
-      ser.SetStreamingMode(true);
-
-      if(version != RemoteServerProtocolVersion)
-      {
-        RDCLOG("Connection using protocol %u, but we are running %u", version,
-               RemoteServerProtocolVersion);
-
-        {
-          SCOPED_SERIALISE_CHUNK(eRemoteServer_VersionMismatch);
-        }
-      }
-      else
-      {
-        SCOPED_SERIALISE_CHUNK(eRemoteServer_Busy);
-      }
+      last = true;
+      sharedReplays.removeOne(share);
     }
+  }
 
-    SAFE_DELETE(threadData->socket);
+  if(last)
+  {
+    // shut down outside the registry lock - driver teardown can be slow
+    if(share->remoteDriver)
+      share->remoteDriver->Shutdown();
 
-    RDCLOG("Closed inactive connection from %u.%u.%u.%u.", Network::GetIPOctet(ip, 0),
-           Network::GetIPOctet(ip, 1), Network::GetIPOctet(ip, 2), Network::GetIPOctet(ip, 3));
+    SAFE_DELETE(share->rdc);
+
+    delete share;
   }
 }
 
@@ -270,6 +414,7 @@ static void ActiveRemoteClientThread(ClientThread *threadData,
   IReplayDriver *replayDriver = NULL;
   ReplayProxy *proxy = NULL;
   RDCFile *rdc = NULL;
+  SharedReplay *share = NULL;
   Callstack::StackResolver *resolver = NULL;
 
   WriteSerialiser writer(new StreamWriter(client, Ownership::Nothing), Ownership::Stream);
@@ -360,56 +505,208 @@ static void ActiveRemoteClientThread(ClientThread *threadData,
         SERIALISE_ELEMENT(files);
       }
     }
-    else if(type == eRemoteServer_CopyCaptureFromRemote)
+    else if(type == eRemoteServer_ListDirRecursive)
     {
       rdcstr path;
+      uint32_t maxDepth = 1;
 
       {
         READ_DATA_SCOPE();
         SERIALISE_ELEMENT(path);
+        SERIALISE_ELEMENT(maxDepth);
       }
 
       reader.EndChunk();
 
+      // sanity bound on the client-requested depth - the entry cap below is the real limit
+      maxDepth = RDCMAX(1U, RDCMIN(maxDepth, 16U));
+
+      // walk breadth-first so that if the entry cap hits, the listings nearest the requested
+      // directory are complete and only the deepest prefetches get dropped
+      rdcarray<rdcstr> paths;
+      rdcarray<uint32_t> depths;
+      rdcarray<rdcarray<PathEntry>> listings;
+
+      paths.push_back(path);
+      depths.push_back(1);
+
+      size_t totalEntries = 0;
+
+      for(size_t i = 0; i < paths.size(); i++)
+      {
+        listings.push_back(rdcarray<PathEntry>());
+        rdcarray<PathEntry> &files = listings.back();
+        FileIO::GetFilesInDirectory(paths[i].c_str(), files);
+
+        totalEntries += files.size();
+
+        if(depths[i] >= maxDepth || totalEntries >= RemoteServer_ListDirMaxEntries)
+          continue;
+
+        for(const PathEntry &f : files)
+        {
+          // don't spend the entry budget on hidden directories, they're fetched on demand if the
+          // user does browse into them
+          if(!(f.flags & PathProperty::Directory) || bool(f.flags & PathProperty::Hidden))
+            continue;
+
+          rdcstr subdir = paths[i];
+          if(!subdir.empty() && subdir.back() != '/' && subdir.back() != '\\')
+            subdir += "/";
+          subdir += f.filename;
+
+          paths.push_back(subdir);
+          depths.push_back(depths[i] + 1);
+        }
+      }
+
+      // serialise the batch to memory so the whole response crosses the wire in one compressed
+      // stream - listings are mostly repeated path prefixes and compress very well
+      StreamWriter data(64 * 1024);
+
+      {
+        WriteSerialiser dataser(&data, Ownership::Nothing);
+
+        uint32_t numDirs = (uint32_t)paths.size();
+        dataser.Serialise("numDirs"_lit, numDirs);
+
+        for(size_t i = 0; i < paths.size(); i++)
+        {
+          dataser.Serialise("path"_lit, paths[i]);
+          dataser.Serialise("files"_lit, listings[i]);
+        }
+      }
+
       {
         WRITE_DATA_SCOPE();
-        SCOPED_SERIALISE_CHUNK(eRemoteServer_CopyCaptureFromRemote);
+        SCOPED_SERIALISE_CHUNK(eRemoteServer_ListDirRecursive);
 
-        StreamReader fileStream(FileIO::fopen(path.c_str(), "rb"));
-        ser.SerialiseStream(path, fileStream);
+        StreamReader dataStream(data.GetData(), data.GetOffset());
+        SendCompressedStream(ser, path, dataStream, RENDERDOC_ProgressCallback());
       }
     }
-    else if(type == eRemoteServer_CopyCaptureToRemote)
+    else if(type == eRemoteServer_CopyCaptureFromRemote)
     {
       rdcstr path;
-      rdcstr dummy, dummy2;
-      FileIO::GetDefaultFiles("remotecopy", path, dummy, dummy2);
+      uint64_t resumeOffset = 0;
+      uint64_t resumeHash = 0;
 
-      RDCLOG("Copying file to local path '%s'.", path.c_str());
+      {
+        READ_DATA_SCOPE();
+        SERIALISE_ELEMENT(path);
+        SERIALISE_ELEMENT(resumeOffset);
+        SERIALISE_ELEMENT(resumeHash);
+      }
 
-      FileIO::CreateParentDirectory(path);
+      reader.EndChunk();
+
+      FILE *f = FileIO::fopen(path.c_str(), "rb");
 
+      uint64_t fileSize = 0;
+      if(f)
       {
-        READ_DATA_SCOPE();
+        FileIO::fseek64(f, 0, SEEK_END);
+        fileSize = FileIO::ftell64(f);
+        FileIO::fseek64(f, 0, SEEK_SET);
+      }
+
+      // if the client has a partial file from an interrupted copy, resume after it - but only if
+      // its contents match ours, otherwise restart from the beginning. The checksum lets the
+      // client verify the bytes it appends, so a retry never builds on corrupt data.
+      uint64_t resumedFrom = 0;
+      if(resumeHash != 0 && resumeOffset > 0 && resumeOffset <= fileSize &&
+         HashFileRange(path, 0, resumeOffset) == resumeHash)
+        resumedFrom = resumeOffset;
+
+      uint64_t remainderHash = HashFileRange(path, resumedFrom, fileSize - resumedFrom);
+
+      if(f && resumedFrom > 0)
+        FileIO::fseek64(f, resumedFrom, SEEK_SET);
+
+      {
+        WRITE_DATA_SCOPE();
+        SCOPED_SERIALISE_CHUNK(eRemoteServer_CopyCaptureFromRemote);
+        SERIALISE_ELEMENT(resumedFrom);
+        SERIALISE_ELEMENT(remainderHash);
 
-        StreamWriter streamWriter(FileIO::fopen(path.c_str(), "wb"), Ownership::Stream);
+        StreamReader fileStream(f, fileSize - resumedFrom, Ownership::Stream);
+        SendCompressedStream(ser, path, fileStream, RENDERDOC_ProgressCallback());
+      }
+    }
+    else if(type == eRemoteServer_CopyCaptureToRemote)
+    {
+      uint64_t hash = 0;
 
-        ser.SerialiseStream(path.c_str(), streamWriter, NULL);
+      {
+        READ_DATA_SCOPE();
+        SERIALISE_ELEMENT(hash);
       }
 
       reader.EndChunk();
 
-      if(reader.IsErrored())
+      rdcstr path;
+
+      // hash of 0 means the client couldn't hash the file, fall back to an uncached temporary copy
+      bool cacheable = hash != 0;
+
+      if(cacheable)
+        path = GetCachedCapturePath(hash);
+      else
       {
-        FileIO::Delete(path.c_str());
+        rdcstr dummy, dummy2;
+        FileIO::GetDefaultFiles("remotecopy", path, dummy, dummy2);
+      }
 
-        RDCERR("Network error receiving file");
-        break;
+      bool cached = cacheable && FileIO::exists(path.c_str());
+
+      {
+        WRITE_DATA_SCOPE();
+        SCOPED_SERIALISE_CHUNK(eRemoteServer_CaptureCached);
+        SERIALISE_ELEMENT(cached);
       }
 
-      RDCLOG("File received.");
+      if(cached)
+      {
+        RDCLOG("Reusing cached capture at '%s'.", path.c_str());
+      }
+      else
+      {
+        RDCLOG("Copying file to local path '%s'.", path.c_str());
 
-      tempFiles.push_back(path);
+        FileIO::CreateParentDirectory(path);
+
+        {
+          READ_DATA_SCOPE();
+
+          RemoteServerPacket streamType = ser.ReadChunk<RemoteServerPacket>();
+
+          if(streamType != eRemoteServer_CopyCaptureToRemote)
+            RDCERR("Unexpected chunk instead of capture contents");
+
+          StreamWriter streamWriter(FileIO::fopen(path.c_str(), "wb"), Ownership::Stream);
+
+          ReceiveCompressedStream(ser, path, streamWriter, RENDERDOC_ProgressCallback());
+        }
+
+        reader.EndChunk();
+
+        if(reader.IsErrored())
+        {
+          FileIO::Delete(path.c_str());
+
+          RDCERR("Network error receiving file");
+          break;
+        }
+
+        RDCLOG("File received.");
+      }
+
+      // cached copies persist across connections so that re-opening a recent capture is cheap -
+      // they are pruned by count rather than deleted with the connection's temporary files.
+      if(cacheable)
+        PruneCaptureCache(hash);
+      else
+        tempFiles.push_back(path);
 
       {
         WRITE_DATA_SCOPE();
@@ -496,62 +793,124 @@ static void ActiveRemoteClientThread(ClientThread *threadData,
       {
         if(RenderDoc::Inst().HasRemoteDriver(rdc->GetDriver()))
         {
-          bool kill = false;
-          float progress = 0.0f;
+          // look up or create the shared replay for this path. The registry lock is only held
+          // for the lookup itself - the load happens under the share's own lock, so a second
+          // client opening the same capture waits for the load instead of duplicating it.
+          bool attach = false;
 
-          RenderDoc::Inst().SetProgressCallback<LoadProgress>([&progress](float p) { progress = p; });
+          {
+            SCOPED_LOCK(sharedReplaysLock);
 
-          Threading::ThreadHandle ticker = Threading::CreateThread([&writer, &kill, &progress]() {
-            while(!kill)
+            for(SharedReplay *s : sharedReplays)
             {
+              if(s->path == path)
               {
-                WRITE_DATA_SCOPE();
-                SCOPED_SERIALISE_CHUNK(eRemoteServer_LogOpenProgress);
-                SERIALISE_ELEMENT(progress);
+                share = s;
+                attach = true;
+                break;
               }
-              Threading::Sleep(100);
             }
-          });
 
-          // if we have a replay driver, try to create it so we can display a local preview e.g.
-          if(RenderDoc::Inst().HasReplayDriver(rdc->GetDriver()))
-          {
-            status = RenderDoc::Inst().CreateReplayDriver(rdc, opts, &replayDriver);
-            if(replayDriver)
-              remoteDriver = replayDriver;
-          }
-          else
-          {
-            status = RenderDoc::Inst().CreateRemoteDriver(rdc, opts, &remoteDriver);
-          }
+            if(!share)
+            {
+              share = new SharedReplay();
+              share->path = path;
+              sharedReplays.push_back(share);
+            }
 
-          if(status != ReplayStatus::Succeeded || remoteDriver == NULL)
-          {
-            RDCERR("Failed to create remote driver for driver '%s'", rdc->GetDriverName().c_str());
+            share->refcount++;
           }
-          else
+
+          if(!attach)
           {
-            status = remoteDriver->ReadLogInitialisation(rdc, false);
+            SCOPED_LOCK(share->lock);
+
+            bool kill = false;
+            float progress = 0.0f;
+
+            RenderDoc::Inst().SetProgressCallback<LoadProgress>(
+                [&progress](float p) { progress = p; });
+
+            Threading::ThreadHandle ticker = Threading::CreateThread([&writer, &kill, &progress]() {
+              while(!kill)
+              {
+                {
+                  WRITE_DATA_SCOPE();
+                  SCOPED_SERIALISE_CHUNK(eRemoteServer_LogOpenProgress);
+                  SERIALISE_ELEMENT(progress);
+                }
+                Threading::Sleep(100);
+              }
+            });
+
+            // the share keeps its own handle on the file for the driver to stream from, so the
+            // replay stays valid if this client disconnects while others are still attached.
+            share->rdc = new RDCFile();
+            share->rdc->Open(path.c_str());
+
+            // if we have a replay driver, try to create it so we can display a local preview e.g.
+            if(RenderDoc::Inst().HasReplayDriver(share->rdc->GetDriver()))
+            {
+              status = RenderDoc::Inst().CreateReplayDriver(share->rdc, opts, &share->replayDriver);
+              if(share->replayDriver)
+                share->remoteDriver = share->replayDriver;
+            }
+            else
+            {
+              status = RenderDoc::Inst().CreateRemoteDriver(share->rdc, opts, &share->remoteDriver);
+            }
 
-            if(status != ReplayStatus::Succeeded)
+            if(status != ReplayStatus::Succeeded || share->remoteDriver == NULL)
             {
-              RDCERR("Failed to initialise remote driver.");
+              RDCERR("Failed to create remote driver for driver '%s'", rdc->GetDriverName().c_str());
+            }
+            else
+            {
+              status = share->remoteDriver->ReadLogInitialisation(share->rdc, false);
+
+              if(status != ReplayStatus::Succeeded)
+              {
+                RDCERR("Failed to initialise remote driver.");
 
-              remoteDriver->Shutdown();
-              remoteDriver = NULL;
+                share->remoteDriver->Shutdown();
+                share->remoteDriver = NULL;
+                share->replayDriver = NULL;
+              }
             }
+
+            RenderDoc::Inst().SetProgressCallback<LoadProgress>(RENDERDOC_ProgressCallback());
+
+            kill = true;
+            Threading::JoinThread(ticker);
+            Threading::CloseThread(ticker);
+
+            share->status = status;
           }
+          else
+          {
+            // blocks until the loading client has finished initialisation
+            SCOPED_LOCK(share->lock);
 
-          RenderDoc::Inst().SetProgressCallback<LoadProgress>(RENDERDOC_ProgressCallback());
+            status = share->status;
 
-          kill = true;
-          Threading::JoinThread(ticker);
-          Threading::CloseThread(ticker);
+            RDCLOG("Attached to already-loaded replay of '%s' (%d clients).", path.c_str(),
+                   share->refcount);
+          }
+
+          remoteDriver = share->remoteDriver;
+          replayDriver = share->replayDriver;
 
           if(status == ReplayStatus::Succeeded && remoteDriver)
           {
             proxy = new ReplayProxy(reader, writer, remoteDriver, replayDriver, previewWindow);
           }
+          else
+          {
+            ReleaseSharedReplay(share);
+            share = NULL;
+            remoteDriver = NULL;
+            replayDriver = NULL;
+          }
         }
         else
         {
@@ -561,10 +920,32 @@ static void ActiveRemoteClientThread(ClientThread *threadData,
         }
       }
 
+      // stable identity for this capture, which the client uses to key its disk cache of
+      // immutable queries. Hashed from the container metadata rather than the file contents, so
+      // it's free to compute even for huge captures.
+      uint64_t captureIdent = 0;
+      if(status == ReplayStatus::Succeeded && rdc)
+      {
+        bytebuf identData;
+        uint64_t machineIdent = rdc->GetMachineIdent();
+        identData.append((const byte *)&machineIdent, sizeof(machineIdent));
+        identData.append((const byte *)rdc->GetDriverName().c_str(), rdc->GetDriverName().size());
+        for(int i = 0; i < rdc->NumSections(); i++)
+        {
+          const SectionProperties &props = rdc->GetSectionProperties(i);
+          identData.append((const byte *)props.name.c_str(), props.name.size());
+          const uint64_t nums[4] = {(uint64_t)props.type, props.version, props.uncompressedSize,
+                                    props.compressedSize};
+          identData.append((const byte *)nums, sizeof(nums));
+        }
+        captureIdent = XXH64(identData.data(), identData.size(), 0);
+      }
+
       {
         WRITE_DATA_SCOPE();
         SCOPED_SERIALISE_CHUNK(eRemoteServer_LogOpened);
         SERIALISE_ELEMENT(status);
+        SERIALISE_ELEMENT(captureIdent);
       }
     }
     else if(type == eRemoteServer_HasCallstacks)
@@ -817,10 +1198,27 @@ static void ActiveRemoteClientThread(ClientThread *threadData,
     {
       reader.EndChunk();
 
-      SAFE_DELETE(proxy);
+      if(share)
+      {
+        {
+          SCOPED_LOCK(share->lock);
+          if(share->lastProxy == proxy)
+            share->lastProxy = NULL;
+        }
+
+        SAFE_DELETE(proxy);
+
+        ReleaseSharedReplay(share);
+        share = NULL;
+      }
+      else
+      {
+        SAFE_DELETE(proxy);
+
+        if(remoteDriver)
+          remoteDriver->Shutdown();
+      }
 
-      if(remoteDriver)
-        remoteDriver->Shutdown();
       remoteDriver = NULL;
       replayDriver = NULL;
 
@@ -867,7 +1265,27 @@ static void ActiveRemoteClientThread(ClientThread *threadData,
     }
     else if((int)type >= eReplayProxy_First && proxy)
     {
-      bool ok = proxy->Tick(type);
+      bool ok = false;
+
+      if(share)
+      {
+        SCOPED_LOCK(share->lock);
+
+        // another client may have moved the shared replay to its own event since we last ran, so
+        // restore our cursor first to give this command the state it expects. If the incoming
+        // command is itself a replay there's no point, it's about to move the replay anyway.
+        if(share->lastProxy != proxy && share->lastProxy != NULL && remoteDriver &&
+           (int)type != (int)eReplayProxy_ReplayLog)
+          remoteDriver->ReplayLog(proxy->GetEventID(), eReplay_Full);
+
+        share->lastProxy = proxy;
+
+        ok = proxy->Tick(type);
+      }
+      else
+      {
+        ok = proxy->Tick(type);
+      }
 
       if(!ok)
         break;
@@ -876,10 +1294,27 @@ static void ActiveRemoteClientThread(ClientThread *threadData,
     }
   }
 
-  SAFE_DELETE(proxy);
+  if(share)
+  {
+    {
+      SCOPED_LOCK(share->lock);
+      if(share->lastProxy == proxy)
+        share->lastProxy = NULL;
+    }
+
+    SAFE_DELETE(proxy);
+
+    ReleaseSharedReplay(share);
+    share = NULL;
+  }
+  else
+  {
+    SAFE_DELETE(proxy);
+
+    if(remoteDriver)
+      remoteDriver->Shutdown();
+  }
 
-  if(remoteDriver)
-    remoteDriver->Shutdown();
   remoteDriver = NULL;
   replayDriver = NULL;
   SAFE_DELETE(rdc);
@@ -887,7 +1322,24 @@ static void ActiveRemoteClientThread(ClientThread *threadData,
 
   for(size_t i = 0; i < tempFiles.size(); i++)
   {
-    FileIO::Delete(tempFiles[i].c_str());
+    // don't delete a temporary that still backs a shared replay another client is attached to
+    bool inUse = false;
+
+    {
+      SCOPED_LOCK(sharedReplaysLock);
+
+      for(SharedReplay *s : sharedReplays)
+      {
+        if(s->path == tempFiles[i])
+        {
+          inUse = true;
+          break;
+        }
+      }
+    }
+
+    if(!inUse)
+      FileIO::Delete(tempFiles[i].c_str());
   }
 
   RDCLOG("Closing active connection from %u.%u.%u.%u.", Network::GetIPOctet(ip, 0),
@@ -1000,40 +1452,33 @@ void RenderDoc::BecomeRemoteServer(const char *listenhost, uint16_t port,
 
   RDCLOG("Replay host ready for requests...");
 
-  ClientThread *activeClientData = NULL;
+  rdcarray<ClientThread *> actives;
 
-  rdcarray<ClientThread *> inactives;
+  bool serverKilled = false;
 
-  while(!killReplay())
+  while(!killReplay() && !serverKilled)
   {
     Network::Socket *client = sock->AcceptClient(0);
 
-    if(activeClientData && activeClientData->killServer)
+    for(ClientThread *active : actives)
+      serverKilled |= active->killServer;
+
+    if(serverKilled)
       break;
 
-    // reap any dead inactive threads
-    for(size_t i = 0; i < inactives.size(); i++)
+    // reap any dead client threads
+    for(size_t i = 0; i < actives.size(); i++)
     {
-      if(inactives[i]->socket == NULL)
+      if(actives[i]->socket == NULL)
       {
-        Threading::JoinThread(inactives[i]->thread);
-        Threading::CloseThread(inactives[i]->thread);
-        delete inactives[i];
-        inactives.erase(i);
+        Threading::JoinThread(actives[i]->thread);
+        Threading::CloseThread(actives[i]->thread);
+        delete actives[i];
+        actives.erase(i);
         break;
       }
     }
 
-    // reap our active connection possibly
-    if(activeClientData && activeClientData->socket == NULL)
-    {
-      Threading::JoinThread(activeClientData->thread);
-      Threading::CloseThread(activeClientData->thread);
-
-      delete activeClientData;
-      activeClientData = NULL;
-    }
-
     if(client == NULL)
     {
       if(!sock->Connected())
@@ -1075,49 +1520,36 @@ void RenderDoc::BecomeRemoteServer(const char *listenhost, uint16_t port,
       continue;
     }
 
-    if(activeClientData == NULL)
+    // every valid client becomes an active connection. Clients sharing a capture are serialised
+    // against each other per-command; only the first connection gets the preview window since
+    // there's only one of those.
     {
-      activeClientData = new ClientThread();
-      activeClientData->socket = client;
-      activeClientData->allowExecution = allowExecution;
+      ClientThread *active = new ClientThread();
+      active->socket = client;
+      active->allowExecution = allowExecution;
 
-      activeClientData->thread = Threading::CreateThread([activeClientData, previewWindow]() {
-        ActiveRemoteClientThread(activeClientData, previewWindow);
-      });
+      RENDERDOC_PreviewWindowCallback preview;
 
-      RDCLOG("Making active connection");
-    }
-    else
-    {
-      ClientThread *inactive = new ClientThread();
-      inactive->socket = client;
-      inactive->allowExecution = false;
+      if(actives.empty())
+        preview = previewWindow;
 
-      inactive->thread =
-          Threading::CreateThread([inactive]() { InactiveRemoteClientThread(inactive); });
+      active->thread = Threading::CreateThread(
+          [active, preview]() { ActiveRemoteClientThread(active, preview); });
 
-      inactives.push_back(inactive);
+      actives.push_back(active);
 
-      RDCLOG("Refusing inactive connection");
+      RDCLOG("Making active connection (%zu total)", actives.size());
     }
   }
 
-  if(activeClientData && activeClientData->socket != NULL)
-  {
-    activeClientData->killThread = true;
-
-    Threading::JoinThread(activeClientData->thread);
-    Threading::CloseThread(activeClientData->thread);
-
-    delete activeClientData;
-  }
-
   // shut down client threads
-  for(size_t i = 0; i < inactives.size(); i++)
+  for(size_t i = 0; i < actives.size(); i++)
   {
-    Threading::JoinThread(inactives[i]->thread);
-    Threading::CloseThread(inactives[i]->thread);
-    delete inactives[i];
+    actives[i]->killThread = true;
+
+    Threading::JoinThread(actives[i]->thread);
+    Threading::CloseThread(actives[i]->thread);
+    delete actives[i];
   }
 
   SAFE_DELETE(sock);
@@ -1388,12 +1820,41 @@ rdcstr RemoteServer::GetHomeFolder()
   return home;
 }
 
+// cache keys use forward slashes so that hits don't depend on which separator the UI joined
+// paths with
+static rdcstr ListDirCacheKey(const rdcstr &path)
+{
+  rdcstr key = path;
+  for(char &c : key)
+    if(c == '\\')
+      c = '/';
+  return key;
+}
+
 rdcarray<PathEntry> RemoteServer::ListFolder(const char *path)
 {
+  // each request prefetches listings several levels below the requested directory, so browsing
+  // into one we've already been sent is answered locally with no round trip. Cached listings are
+  // consumed on use - asking for the same path again goes back to the server, so a refresh is
+  // never more than one fetch stale.
+  {
+    auto it = m_ListDirCache.find(ListDirCacheKey(path));
+
+    if(it != m_ListDirCache.end())
+    {
+      rdcarray<PathEntry> files = it->second;
+      m_ListDirCache.erase(it);
+      return files;
+    }
+  }
+
+  uint32_t maxDepth = RDCMAX(1U, RemoteServer_ListDirPrefetchDepth);
+
   {
     WRITE_DATA_SCOPE();
-    SCOPED_SERIALISE_CHUNK(eRemoteServer_ListDir);
+    SCOPED_SERIALISE_CHUNK(eRemoteServer_ListDirRecursive);
     SERIALISE_ELEMENT(path);
+    SERIALISE_ELEMENT(maxDepth);
   }
 
   rdcarray<PathEntry> files;
@@ -1403,9 +1864,29 @@ rdcarray<PathEntry> RemoteServer::ListFolder(const char *path)
 
     RemoteServerPacket type = ser.ReadChunk<RemoteServerPacket>();
 
-    if(type == eRemoteServer_ListDir)
+    if(type == eRemoteServer_ListDirRecursive)
     {
-      SERIALISE_ELEMENT(files);
+      StreamWriter data(64 * 1024);
+      ReceiveCompressedStream(ser, path, data, RENDERDOC_ProgressCallback());
+
+      ReadSerialiser dataser(new StreamReader(data.GetData(), data.GetOffset()), Ownership::Stream);
+
+      uint32_t numDirs = 0;
+      dataser.Serialise("numDirs"_lit, numDirs);
+
+      for(uint32_t i = 0; i < numDirs; i++)
+      {
+        rdcstr dir;
+        rdcarray<PathEntry> listing;
+        dataser.Serialise("path"_lit, dir);
+        dataser.Serialise("files"_lit, listing);
+
+        // the first listing is the directory we asked for, the rest are prefetches
+        if(i == 0)
+          files = listing;
+        else
+          m_ListDirCache[ListDirCacheKey(dir)] = listing;
+      }
     }
     else
     {
@@ -1465,10 +1946,34 @@ void RemoteServer::CopyCaptureFromRemote(const char *remotepath, const char *loc
 {
   rdcstr path = remotepath;
 
+  // if a previous interrupted copy left a partial file behind, offer its contents back to the
+  // server so the transfer can resume where it left off instead of starting over.
+  uint64_t resumeOffset = 0;
+  uint64_t resumeHash = 0;
+
+  if(FileIO::exists(localpath))
+  {
+    FILE *f = FileIO::fopen(localpath, "rb");
+    if(f)
+    {
+      FileIO::fseek64(f, 0, SEEK_END);
+      resumeOffset = FileIO::ftell64(f);
+      FileIO::fclose(f);
+    }
+
+    if(resumeOffset > 0)
+      resumeHash = HashFileRange(localpath, 0, resumeOffset);
+
+    if(resumeHash == 0)
+      resumeOffset = 0;
+  }
+
   {
     WRITE_DATA_SCOPE();
     SCOPED_SERIALISE_CHUNK(eRemoteServer_CopyCaptureFromRemote);
     SERIALISE_ELEMENT(path);
+    SERIALISE_ELEMENT(resumeOffset);
+    SERIALISE_ELEMENT(resumeHash);
   }
 
   {
@@ -1477,15 +1982,33 @@ void RemoteServer::CopyCaptureFromRemote(const char *remotepath, const char *loc
 
     if(type == eRemoteServer_CopyCaptureFromRemote)
     {
-      StreamWriter streamWriter(FileIO::fopen(localpath, "wb"), Ownership::Stream);
+      uint64_t resumedFrom = 0;
+      uint64_t remainderHash = 0;
+      SERIALISE_ELEMENT(resumedFrom);
+      SERIALISE_ELEMENT(remainderHash);
 
-      ser.SerialiseStream(localpath, streamWriter, progress);
+      {
+        // append to the validated prefix if the server accepted the resume, otherwise start over
+        StreamWriter streamWriter(FileIO::fopen(localpath, resumedFrom > 0 ? "ab" : "wb"),
+                                  Ownership::Stream);
+
+        ReceiveCompressedStream(ser, localpath, streamWriter, progress);
+      }
 
       if(ser.IsErrored())
       {
+        // deliberately leave the partial file on disk - a retried copy will resume from it
         RDCERR("Network error receiving file");
         return;
       }
+
+      // check what we received against the server's hash. On mismatch remove the file entirely,
+      // so a retry starts clean rather than resuming from corrupt data.
+      if(remainderHash != 0 && HashFileRange(localpath, resumedFrom, ~0ULL) != remainderHash)
+      {
+        RDCERR("Checksum mismatch in received file, removing '%s'", localpath);
+        FileIO::Delete(localpath);
+      }
     }
     else
     {
@@ -1506,13 +2029,49 @@ rdcstr RemoteServer::CopyCaptureToRemote(const char *filename, RENDERDOC_Progres
     return "";
   }
 
+  // send the content hash first - if the server still has this capture cached from a previous
+  // session we can skip the upload entirely.
+  uint64_t hash = HashCaptureFile(filename);
+
+  {
+    WRITE_DATA_SCOPE();
+    SCOPED_SERIALISE_CHUNK(eRemoteServer_CopyCaptureToRemote);
+    SERIALISE_ELEMENT(hash);
+  }
+
+  bool cached = false;
+
+  {
+    READ_DATA_SCOPE();
+    RemoteServerPacket type = ser.ReadChunk<RemoteServerPacket>();
+
+    if(type == eRemoteServer_CaptureCached)
+    {
+      SERIALISE_ELEMENT(cached);
+    }
+    else
+    {
+      RDCERR("Unexpected response to capture copy request");
+    }
+
+    ser.EndChunk();
+  }
+
+  if(cached)
+  {
+    FileIO::fclose(fileHandle);
+
+    if(progress)
+      progress(1.0f);
+  }
+  else
   {
     WRITE_DATA_SCOPE();
     SCOPED_SERIALISE_CHUNK(eRemoteServer_CopyCaptureToRemote);
 
     // this will take ownership of and close the file
     StreamReader fileStream(fileHandle);
-    ser.SerialiseStream(filename, fileStream, progress);
+    SendCompressedStream(ser, filename, fileStream, progress);
   }
 
   rdcstr path;
@@ -1605,9 +2164,11 @@ rdcpair<ReplayStatus, IReplayController *> RemoteServer::OpenCapture(
   }
 
   ReplayStatus status = ReplayStatus::Succeeded;
+  uint64_t captureIdent = 0;
   {
     READ_DATA_SCOPE();
     SERIALISE_ELEMENT(status);
+    SERIALISE_ELEMENT(captureIdent);
     ser.EndChunk();
   }
 
@@ -1637,7 +2198,7 @@ rdcpair<ReplayStatus, IReplayController *> RemoteServer::OpenCapture(
 
   ReplayController *rend = new ReplayController();
 
-  ReplayProxy *proxy = new ReplayProxy(*reader, *writer, proxyDriver);
+  ReplayProxy *proxy = new ReplayProxy(*reader, *writer, proxyDriver, captureIdent);
   status = rend->SetDevice(proxy);
 
   if(status != ReplayStatus::Succeeded)
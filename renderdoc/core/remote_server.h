@@ -24,6 +24,7 @@
 
 #pragma once
 
+#include <map>
 #include "api/replay/renderdoc_replay.h"
 #include "os/os_specific.h"
 
@@ -107,4 +108,7 @@ protected:
   rdcstr m_deviceID;
 
   rdcarray<rdcpair<RDCDriver, rdcstr>> m_Proxies;
+
+  // directory listings prefetched by ListFolder's batched recursive request, consumed on use
+  std::map<rdcstr, rdcarray<PathEntry>> m_ListDirCache;
 };
@@ -24,9 +24,14 @@
  ******************************************************************************/
 
 #include "replay_proxy.h"
-#include <list>
-#include "lz4/lz4.h"
-#include "serialise/lz4io.h"
+#include "api/replay/version.h"
+#include "common/threading.h"
+#include "core/settings.h"
+#include "serialise/zstdio.h"
+
+RDOC_CONFIG(bool, Replay_Debug_DisableImmutableQueryCache, false,
+            "Disable the client-side disk cache of immutable queries on remote replay "
+            "connections, so they are always fetched over the network.");
 
 template <>
 rdcstr DoStringise(const ReplayProxyPacket &el)
@@ -188,8 +193,146 @@ struct RemoteExecution
   else                                                                \
     return CONCAT(Proxied_, name)(m_Writer, m_Reader, ##__VA_ARGS__);
 
+// file format for the client-side immutable query cache: magic, version and the exact build's
+// commit hash (the payloads are raw serialised replies, whose layout can change between builds),
+// then a count of entries, each being the packet id, byte size and payload.
+static const uint32_t ImmutableCacheMagic = MAKE_FOURCC('R', 'D', 'I', 'Q');
+static const uint32_t ImmutableCacheVersion = 1;
+
+void ReplayProxy::LoadImmutableCacheFile()
+{
+  if(Replay_Debug_DisableImmutableQueryCache)
+    m_CaptureIdent = 0;
+
+  if(m_RemoteServer || m_CaptureIdent == 0)
+    return;
+
+  rdcstr filename =
+      FileIO::GetAppFolderFilename(StringFormat::Fmt("proxycache_%016llx.bin", m_CaptureIdent));
+
+  FILE *f = FileIO::fopen(filename.c_str(), "rb");
+  if(!f)
+    return;
+
+  StreamReader reader(f);
+
+  uint32_t magic = 0, version = 0;
+  char commit[41] = {};
+  reader.Read(magic);
+  reader.Read(version);
+  reader.Read(commit, sizeof(commit));
+
+  if(magic != ImmutableCacheMagic || version != ImmutableCacheVersion ||
+     memcmp(commit, GitVersionHash, sizeof(commit)) != 0)
+    return;
+
+  uint32_t count = 0;
+  reader.Read(count);
+
+  for(uint32_t i = 0; i < count; i++)
+  {
+    uint32_t packet = 0;
+    uint64_t size = 0;
+    reader.Read(packet);
+    reader.Read(size);
+
+    bytebuf data;
+    data.resize((size_t)size);
+    reader.Read(data.data(), size);
+
+    // if the file is truncated or corrupt, throw away whatever we got and fetch over the wire
+    if(reader.IsErrored())
+    {
+      m_ImmutableCache.clear();
+      return;
+    }
+
+    m_ImmutableCache[packet] = data;
+  }
+}
+
+void ReplayProxy::SaveImmutableCacheFile()
+{
+  if(!m_ImmutableCacheDirty || m_CaptureIdent == 0)
+    return;
+
+  rdcstr filename =
+      FileIO::GetAppFolderFilename(StringFormat::Fmt("proxycache_%016llx.bin", m_CaptureIdent));
+
+  FILE *f = FileIO::fopen(filename.c_str(), "wb");
+  if(!f)
+    return;
+
+  StreamWriter writer(f, Ownership::Stream);
+
+  writer.Write(ImmutableCacheMagic);
+  writer.Write(ImmutableCacheVersion);
+  writer.Write(GitVersionHash, sizeof(GitVersionHash));
+
+  uint32_t count = (uint32_t)m_ImmutableCache.size();
+  writer.Write(count);
+
+  for(auto it = m_ImmutableCache.begin(); it != m_ImmutableCache.end(); ++it)
+  {
+    writer.Write(it->first);
+    uint64_t size = it->second.size();
+    writer.Write(size);
+    writer.Write(it->second.data(), size);
+  }
+}
+
+template <typename T>
+bool ReplayProxy::LoadImmutableReply(ReplayProxyPacket packet, T &ret)
+{
+  if(m_RemoteServer || m_CaptureIdent == 0)
+    return false;
+
+  auto it = m_ImmutableCache.find((uint32_t)packet);
+  if(it == m_ImmutableCache.end())
+    return false;
+
+  bool success = false;
+
+  {
+    ReadSerialiser ser(new StreamReader(it->second), Ownership::Stream);
+    ser.Serialise("ret"_lit, ret);
+    success = !ser.IsErrored();
+  }
+
+  if(!success)
+  {
+    m_ImmutableCache.erase(it);
+    ret = T();
+    return false;
+  }
+
+  PROXY_DEBUG("Serving %s from the immutable query cache", ToStr(packet).c_str());
+
+  return true;
+}
+
+template <typename T>
+void ReplayProxy::SaveImmutableReply(ReplayProxyPacket packet, const T &ret)
+{
+  if(m_RemoteServer || m_CaptureIdent == 0 || m_IsErrored)
+    return;
+
+  if(m_ImmutableCache.find((uint32_t)packet) != m_ImmutableCache.end())
+    return;
+
+  WriteSerialiser ser(new StreamWriter(64 * 1024), Ownership::Stream);
+  ser.Serialise("ret"_lit, (T &)ret);
+
+  bytebuf data;
+  data.assign(ser.GetWriter()->GetData(), (size_t)ser.GetWriter()->GetOffset());
+  m_ImmutableCache[(uint32_t)packet] = data;
+  m_ImmutableCacheDirty = true;
+}
+
 ReplayProxy::~ReplayProxy()
 {
+  SaveImmutableCacheFile();
+
   ShutdownRemoteExecutionThread();
 
   ShutdownPreviewWindow();
@@ -382,6 +525,16 @@ rdcarray<DebugMessage> ReplayProxy::Proxied_GetDebugMessages(ParamSerialiser &pa
 
 rdcarray<DebugMessage> ReplayProxy::GetDebugMessages()
 {
+  // messages are batched into the ReplayLog return packet (see Proxied_ReplayLog) so the client
+  // answers this locally. The remote side keeps its handler for the packet, but up-to-date
+  // clients never send it.
+  if(!m_RemoteServer)
+  {
+    rdcarray<DebugMessage> ret;
+    ret.swap(m_PendingDebugMessages);
+    return ret;
+  }
+
   PROXY_FUNCTION(GetDebugMessages);
 }
 
@@ -410,6 +563,8 @@ rdcarray<TextureDescription> ReplayProxy::Proxied_GetTextures(ParamSerialiser &p
   {
     for(const TextureDescription &tex : ret)
       m_TextureInfo[tex.resourceId] = tex;
+
+    SaveImmutableReply(eReplayProxy_GetTextures, ret);
   }
 
   return ret;
@@ -417,6 +572,14 @@ rdcarray<TextureDescription> ReplayProxy::Proxied_GetTextures(ParamSerialiser &p
 
 rdcarray<TextureDescription> ReplayProxy::GetTextures()
 {
+  rdcarray<TextureDescription> ret;
+  if(LoadImmutableReply(eReplayProxy_GetTextures, ret))
+  {
+    for(const TextureDescription &tex : ret)
+      m_TextureInfo[tex.resourceId] = tex;
+    return ret;
+  }
+
   PROXY_FUNCTION(GetTextures);
 }
 
@@ -474,11 +637,18 @@ rdcarray<BufferDescription> ReplayProxy::Proxied_GetBuffers(ParamSerialiser &par
 
   SERIALISE_RETURN(ret);
 
+  if(retser.IsReading())
+    SaveImmutableReply(eReplayProxy_GetBuffers, ret);
+
   return ret;
 }
 
 rdcarray<BufferDescription> ReplayProxy::GetBuffers()
 {
+  rdcarray<BufferDescription> ret;
+  if(LoadImmutableReply(eReplayProxy_GetBuffers, ret))
+    return ret;
+
   PROXY_FUNCTION(GetBuffers);
 }
 
@@ -503,11 +673,18 @@ rdcarray<ResourceDescription> ReplayProxy::Proxied_GetResources(ParamSerialiser
 
   SERIALISE_RETURN(ret);
 
+  if(retser.IsReading())
+    SaveImmutableReply(eReplayProxy_GetResources, ret);
+
   return ret;
 }
 
 rdcarray<ResourceDescription> ReplayProxy::GetResources()
 {
+  rdcarray<ResourceDescription> ret;
+  if(LoadImmutableReply(eReplayProxy_GetResources, ret))
+    return ret;
+
   PROXY_FUNCTION(GetResources);
 }
 
@@ -625,6 +802,8 @@ FrameRecord ReplayProxy::Proxied_GetFrameRecord(ParamSerialiser &paramser, Retur
   {
     // re-configure the drawcall pointers, since they will be invalid
     SetupDrawcallPointers(m_Drawcalls, ret.drawcallList);
+
+    SaveImmutableReply(eReplayProxy_GetFrameRecord, ret);
   }
 
   return ret;
@@ -632,6 +811,13 @@ FrameRecord ReplayProxy::Proxied_GetFrameRecord(ParamSerialiser &paramser, Retur
 
 FrameRecord ReplayProxy::GetFrameRecord()
 {
+  FrameRecord ret;
+  if(LoadImmutableReply(eReplayProxy_GetFrameRecord, ret))
+  {
+    SetupDrawcallPointers(m_Drawcalls, ret.drawcallList);
+    return ret;
+  }
+
   PROXY_FUNCTION(GetFrameRecord);
 }
 
@@ -842,12 +1028,16 @@ void ReplayProxy::Proxied_GetBufferData(ParamSerialiser &paramser, ReturnSeriali
 
   char empty[128] = {};
 
-  // lz4 compress
+  // zstd compress. These transfers are usually bandwidth-bound (VPNs, adb forwarding) so the
+  // better ratio beats a faster codec. Single-threaded mode both avoids spinning up a worker pool
+  // per packet and only reads one frame at a time, so it can't consume socket data beyond this
+  // message.
   if(retser.IsReading())
   {
-    ReadSerialiser ser(new StreamReader(new LZ4Decompressor(retser.GetReader(), Ownership::Nothing),
-                                        dataSize, Ownership::Stream),
-                       Ownership::Stream);
+    ReadSerialiser ser(
+        new StreamReader(new ZSTDDecompressor(retser.GetReader(), Ownership::Nothing, false),
+                         dataSize, Ownership::Stream),
+        Ownership::Stream);
 
     SERIALISE_ELEMENT(retData);
 
@@ -860,9 +1050,10 @@ void ReplayProxy::Proxied_GetBufferData(ParamSerialiser &paramser, ReturnSeriali
   }
   else
   {
-    WriteSerialiser ser(new StreamWriter(new LZ4Compressor(retser.GetWriter(), Ownership::Nothing),
-                                         Ownership::Stream),
-                        Ownership::Stream);
+    WriteSerialiser ser(
+        new StreamWriter(new ZSTDCompressor(retser.GetWriter(), Ownership::Nothing, false),
+                         Ownership::Stream),
+        Ownership::Stream);
 
     SERIALISE_ELEMENT(retData);
 
@@ -920,12 +1111,13 @@ void ReplayProxy::Proxied_GetTextureData(ParamSerialiser &paramser, ReturnSerial
 
   char empty[128] = {};
 
-  // lz4 compress
+  // zstd compress, single-threaded for the same reasons as Proxied_GetBufferData
   if(retser.IsReading())
   {
-    ReadSerialiser ser(new StreamReader(new LZ4Decompressor(retser.GetReader(), Ownership::Nothing),
-                                        dataSize, Ownership::Stream),
-                       Ownership::Stream);
+    ReadSerialiser ser(
+        new StreamReader(new ZSTDDecompressor(retser.GetReader(), Ownership::Nothing, false),
+                         dataSize, Ownership::Stream),
+        Ownership::Stream);
 
     SERIALISE_ELEMENT(data);
 
@@ -938,9 +1130,10 @@ void ReplayProxy::Proxied_GetTextureData(ParamSerialiser &paramser, ReturnSerial
   }
   else
   {
-    WriteSerialiser ser(new StreamWriter(new LZ4Compressor(retser.GetWriter(), Ownership::Nothing),
-                                         Ownership::Stream),
-                        Ownership::Stream);
+    WriteSerialiser ser(
+        new StreamWriter(new ZSTDCompressor(retser.GetWriter(), Ownership::Nothing, false),
+                         Ownership::Stream),
+        Ownership::Stream);
 
     SERIALISE_ELEMENT(data);
 
@@ -1747,10 +1940,17 @@ void ReplayProxy::Proxied_ReplayLog(ParamSerialiser &paramser, ReturnSerialiser
     END_PARAMS();
   }
 
+  // drain any debug messages the replay generated on the remote into the return packet, so the
+  // per-event poll of GetDebugMessages doesn't need its own round trip.
+  rdcarray<DebugMessage> debugMessages;
+
   {
     REMOTE_EXECUTION();
     if(paramser.IsReading() && !paramser.IsErrored() && !m_IsErrored)
+    {
       m_Remote->ReplayLog(endEventID, replayType);
+      debugMessages = m_Remote->GetDebugMessages();
+    }
   }
 
   if(retser.IsReading())
@@ -1761,7 +1961,10 @@ void ReplayProxy::Proxied_ReplayLog(ParamSerialiser &paramser, ReturnSerialiser
 
   m_EventID = endEventID;
 
-  SERIALISE_RETURN_VOID();
+  SERIALISE_RETURN(debugMessages);
+
+  if(retser.IsReading())
+    m_PendingDebugMessages.append(debugMessages);
 }
 
 void ReplayProxy::ReplayLog(uint32_t endEventID, ReplayLogType replayType)
@@ -1857,9 +2060,9 @@ void DoSerialise(SerialiserType &ser, DeltaSection &el)
 }
 
 template <typename SerialiserType>
-void ReplayProxy::DeltaTransferBytes(SerialiserType &xferser, bytebuf &referenceData, bytebuf &newData)
+bool ReplayProxy::DeltaTransferBytes(SerialiserType &xferser, bytebuf &referenceData, bytebuf &newData)
 {
-  // lz4 compress
+  // zstd compress, single-threaded for the same reasons as Proxied_GetBufferData
   if(xferser.IsReading())
   {
     uint64_t uncompSize = 0;
@@ -1869,7 +2072,7 @@ void ReplayProxy::DeltaTransferBytes(SerialiserType &xferser, bytebuf &reference
     {
       // fast path - no changes.
       RDCDEBUG("Unchanged");
-      return;
+      return false;
     }
     else
     {
@@ -1877,7 +2080,7 @@ void ReplayProxy::DeltaTransferBytes(SerialiserType &xferser, bytebuf &reference
 
       {
         ReadSerialiser ser(
-            new StreamReader(new LZ4Decompressor(xferser.GetReader(), Ownership::Nothing),
+            new StreamReader(new ZSTDDecompressor(xferser.GetReader(), Ownership::Nothing, false),
                              uncompSize, Ownership::Stream),
             Ownership::Stream);
 
@@ -1898,6 +2101,7 @@ void ReplayProxy::DeltaTransferBytes(SerialiserType &xferser, bytebuf &reference
       if(deltas.empty())
       {
         RDCERR("Unexpected empty delta list");
+        return false;
       }
       else if(referenceData.empty())
       {
@@ -1935,133 +2139,106 @@ void ReplayProxy::DeltaTransferBytes(SerialiserType &xferser, bytebuf &reference
         RDCDEBUG("Applied %u deltas data, %llu total delta bytes to %llu resource size",
                  (uint32_t)deltas.size(), deltaBytes, (uint64_t)referenceData.size());
       }
+
+      return true;
     }
   }
   else
   {
     uint64_t uncompSize = 0;
 
-    // we use a list so that we don't have to reserve and pushing new sections will never cause
-    // previous ones to be reallocated and move around lots of data.
-    std::list<DeltaSection> deltasList;
+    rdcarray<DeltaSection> deltas;
 
     if(referenceData.empty())
     {
       // no previous reference data, need to transfer the whole object.
-      deltasList.resize(1);
-      deltasList.back().contents = newData;
+      deltas.resize(1);
+      deltas.back().contents = newData;
+    }
+    else if(referenceData.size() != newData.size())
+    {
+      RDCERR("Reference data existed at %llu bytes, but new data is now %llu bytes",
+             referenceData.size(), newData.size());
+
+      // re-transfer the whole block, something went seriously wrong if the resource changed size.
+      deltas.resize(1);
+      deltas.back().contents = newData;
     }
     else
     {
-      if(referenceData.size() != newData.size())
+      // do the actual diff. Ranges are byte-accurate at their boundaries, but we merge ranges
+      // separated by small clean gaps since each delta costs an offset/length on the wire plus a
+      // separate memcpy when applying. The granularity is tuned to not be too large (causing us
+      // to send too much unchanged data between nearby changes) and not too small (causing us to
+      // devolve into lots of tiny deltas). The current value as of this comment of 128 is
+      // definitely on the small end of the range - consider e.g. an android image of 1440x2560
+      // and a pixel-wide line that goes vertically from top to bottom. Reading horizontally that
+      // will mean 2560 different deltas, and only actually one pixel changed per row.
+      const size_t mergeGranularity = 128;
+
+      // diff large resources in parallel, with each job diffing an independent slice. A changed
+      // range that straddles a slice boundary just becomes two adjacent deltas, which costs one
+      // extra offset/length on the wire and nothing else. Below the threshold the scheduling
+      // costs more than the diff itself, so stay on this thread.
+      const size_t parallelDiffThreshold = 16 * 1024 * 1024;
+
+      if(newData.size() >= parallelDiffThreshold)
       {
-        RDCERR("Reference data existed at %llu bytes, but new data is now %llu bytes",
-               referenceData.size(), newData.size());
+        const size_t numSlices = 4;
 
-        // re-transfer the whole block, something went seriously wrong if the resource changed size.
-        deltasList.resize(1);
-        deltasList.back().contents = newData;
-      }
-      else
-      {
-        // do actual diff.
-        const byte *srcBegin = newData.data();
-        const byte *src = srcBegin;
-        const byte *dst = referenceData.data();
-        size_t bytesRemain = newData.size();
-
-        // we only care about large-ish chunks at a time. This prevents us generating lots of tiny
-        // deltas where we could batch changes together. This is tuned to not be too large (and
-        // thus causing us to miss too many sections we could skip) and not too small (causing us
-        // to devolve into lots of byte-wise deltas). The current value as of this comment of 128
-        // is definitely on the small end of the range, but consider e.g. an android image of
-        // 1440x2560 and a pixel-wide line that goes vertically from top to bottom. Reading
-        // horizontally that will mean 2560 different diffs, and only actually one pixel changed.
-        // The larger this value gets, the more redundant data we'll send along with.
-        const size_t chunkSize = 128;
-
-        // we use a simple state machine. Start in state 1
-        //
-        // State 1: No active delta. Look at the current chunk, if there's no difference move to the
-        //          next chunk and stay in this state. If there is a difference, push a delta onto
-        //          the list at the current offset. Copy the current chunk into the contents of the
-        //          delta. Move to state 2.
-        // State 2. Active delta. Look at the current chunk, if there is a difference then append
-        //          the current chunk to the last delta's contents, move to the next chunk, and stay
-        //          in this state. If there isn't a difference, move back to state 1 (the delta is
-        //          already 'finished' so we have no need to do anything more on it).
-        //
-        // At any point we can end the loop, both states are 'complete' at all points.
-
-        enum DeltaState
-        {
-          None,
-          Active
-        };
-        DeltaState state = DeltaState::None;
+        // slice on 16-byte boundaries so each worker's vectorised sweep stays aligned
+        const size_t sliceSize = AlignUp16(newData.size() / numSlices);
 
-        // loop over whole chunks
-        while(bytesRemain > chunkSize)
-        {
-          // check if there's a difference in this chunk.
-          bool chunkDiff = memcmp(src, dst, chunkSize) != 0;
+        rdcarray<DeltaSection> sliceDeltas[numSlices];
 
-          // if we're in state 1
-          if(state == DeltaState::None)
-          {
-            // if there's a difference, append a new delta with the current offset and chunk
-            // contents and move to state 2
-            if(chunkDiff)
-            {
-              deltasList.push_back(DeltaSection());
-              deltasList.back().offs = src - srcBegin;
-              deltasList.back().contents.append(src, chunkSize);
-
-              state = DeltaState::Active;
-            }
-          }
-          // if we're in state 2
-          else if(state == DeltaState::Active)
+        Threading::ParallelFor(numSlices, [sliceSize, mergeGranularity, &sliceDeltas,
+                                           &referenceData, &newData](size_t t) {
+          const size_t sliceStart = RDCMIN(t * sliceSize, newData.size());
+          const size_t sliceEnd = RDCMIN(sliceStart + sliceSize, newData.size());
+
+          if(sliceStart >= sliceEnd)
+            return;
+
+          rdcarray<rdcpair<size_t, size_t>> sliceRanges;
+          FindDiffRanges(newData.data() + sliceStart, referenceData.data() + sliceStart,
+                         sliceEnd - sliceStart, mergeGranularity, sliceRanges);
+
+          sliceDeltas[t].resize(sliceRanges.size());
+
+          for(size_t i = 0; i < sliceRanges.size(); i++)
           {
-            // continue to append to the delta if there's another difference in this chunk.
-            if(chunkDiff)
-            {
-              deltasList.back().contents.append(src, chunkSize);
-            }
-            else
-            {
-              state = DeltaState::None;
-            }
+            sliceDeltas[t][i].offs = sliceStart + sliceRanges[i].first;
+            sliceDeltas[t][i].contents.append(newData.data() + sliceStart + sliceRanges[i].first,
+                                              sliceRanges[i].second - sliceRanges[i].first);
           }
+        });
 
-          // move to the next chunk
-          bytesRemain -= chunkSize;
-          src += chunkSize;
-          dst += chunkSize;
-        }
+        size_t numDeltas = 0;
 
-        // if there are still some bytes remaining at the end of the image, smaller than the chunk
-        // size, just diff directly and send if needed. We could combine this with the last delta if
-        // we ended in the active state.
-        if(bytesRemain > 0 && memcmp(src, dst, bytesRemain) != 0)
-        {
-          deltasList.push_back(DeltaSection());
-          deltasList.back().offs = src - srcBegin;
-          deltasList.back().contents.append(src, bytesRemain);
-        }
-      }
-    }
+        for(size_t t = 0; t < numSlices; t++)
+          numDeltas += sliceDeltas[t].size();
 
-    // serialise as an array, move the storage from the list into here
-    rdcarray<DeltaSection> deltas(deltasList.size());
+        deltas.resize(numDeltas);
 
-    {
-      // swap between the list and array, so all the buffers just move storage
-      size_t i = 0;
-      for(auto it = deltasList.begin(); it != deltasList.end(); it++)
+        size_t d = 0;
+        for(size_t t = 0; t < numSlices; t++)
+          for(size_t i = 0; i < sliceDeltas[t].size(); i++)
+            deltas[d++].swap(sliceDeltas[t][i]);
+      }
+      else
       {
-        deltas[i].swap(*it);
-        i++;
+        rdcarray<rdcpair<size_t, size_t>> ranges;
+        FindDiffRanges(newData.data(), referenceData.data(), newData.size(), mergeGranularity,
+                       ranges);
+
+        deltas.resize(ranges.size());
+
+        for(size_t i = 0; i < ranges.size(); i++)
+        {
+          deltas[i].offs = ranges[i].first;
+          deltas[i].contents.append(newData.data() + ranges[i].first,
+                                    ranges[i].second - ranges[i].first);
+        }
       }
     }
 
@@ -2084,9 +2261,10 @@ void ReplayProxy::DeltaTransferBytes(SerialiserType &xferser, bytebuf &reference
 
     if(uncompSize > 0)
     {
-      WriteSerialiser ser(new StreamWriter(new LZ4Compressor(xferser.GetWriter(), Ownership::Nothing),
-                                           Ownership::Stream),
-                          Ownership::Stream);
+      WriteSerialiser ser(
+          new StreamWriter(new ZSTDCompressor(xferser.GetWriter(), Ownership::Nothing, false),
+                           Ownership::Stream),
+          Ownership::Stream);
 
       SERIALISE_ELEMENT(deltas);
 
@@ -2104,6 +2282,8 @@ void ReplayProxy::DeltaTransferBytes(SerialiserType &xferser, bytebuf &reference
     // This is the proxy side, so we have the complete newest contents in data. Swap the new data
     // into refData for next time.
     referenceData.swap(newData);
+
+    return uncompSize > 0;
   }
 }
 
@@ -2134,7 +2314,12 @@ void ReplayProxy::Proxied_CacheBufferData(ParamSerialiser &paramser, ReturnSeria
     SERIALISE_ELEMENT(packet);
   }
 
-  DeltaTransferBytes(retser, m_ProxyBufferData[buff], data);
+  bool changed = DeltaTransferBytes(retser, m_ProxyBufferData[buff], data);
+
+  // on the client side, note that the proxy GPU copy of this buffer is now stale so that
+  // EnsureBufCached re-uploads it. If nothing changed the previous upload is still valid.
+  if(retser.IsReading() && changed)
+    m_ProxyBufferDataUpToDate.erase(buff);
 
   retser.EndChunk();
 
@@ -2146,21 +2331,28 @@ void ReplayProxy::CacheBufferData(ResourceId buff)
   PROXY_FUNCTION(CacheBufferData, buff);
 }
 
-template <typename ParamSerialiser, typename ReturnSerialiser>
-void ReplayProxy::Proxied_CacheTextureData(ParamSerialiser &paramser, ReturnSerialiser &retser,
-                                           ResourceId tex, const Subresource &sub,
-                                           const GetTextureDataParams &params)
+template <typename ParamSerialiser>
+void ReplayProxy::CacheTextureData_SendRequest(ParamSerialiser &paramser, ResourceId &tex,
+                                               const Subresource &sub,
+                                               const GetTextureDataParams &params)
 {
   const ReplayProxyPacket expectedPacket = eReplayProxy_CacheTextureData;
   ReplayProxyPacket packet = eReplayProxy_CacheTextureData;
 
-  {
-    BEGIN_PARAMS();
-    SERIALISE_ELEMENT(tex);
-    SERIALISE_ELEMENT(sub);
-    SERIALISE_ELEMENT(params);
-    END_PARAMS();
-  }
+  BEGIN_PARAMS();
+  SERIALISE_ELEMENT(tex);
+  SERIALISE_ELEMENT(sub);
+  SERIALISE_ELEMENT(params);
+  END_PARAMS();
+}
+
+template <typename ParamSerialiser, typename ReturnSerialiser>
+void ReplayProxy::CacheTextureData_ReceiveReply(ParamSerialiser &paramser, ReturnSerialiser &retser,
+                                                ResourceId tex, const Subresource &sub,
+                                                const GetTextureDataParams &params)
+{
+  const ReplayProxyPacket expectedPacket = eReplayProxy_CacheTextureData;
+  ReplayProxyPacket packet = eReplayProxy_CacheTextureData;
 
   bytebuf data;
 
@@ -2184,6 +2376,15 @@ void ReplayProxy::Proxied_CacheTextureData(ParamSerialiser &paramser, ReturnSeri
   CheckError(packet, expectedPacket);
 }
 
+template <typename ParamSerialiser, typename ReturnSerialiser>
+void ReplayProxy::Proxied_CacheTextureData(ParamSerialiser &paramser, ReturnSerialiser &retser,
+                                           ResourceId tex, const Subresource &sub,
+                                           const GetTextureDataParams &params)
+{
+  CacheTextureData_SendRequest(paramser, tex, sub, params);
+  CacheTextureData_ReceiveReply(paramser, retser, tex, sub, params);
+}
+
 void ReplayProxy::CacheTextureData(ResourceId tex, const Subresource &sub,
                                    const GetTextureDataParams &params)
 {
@@ -2340,19 +2541,33 @@ void ReplayProxy::EnsureTexCached(ResourceId &texid, CompType typeCast, const Su
 
     const ProxyTextureProperties &proxy = proxyit->second;
 
+    GetTextureDataParams params = proxy.params;
+
+    params.typeCast = typeCast;
+
+#if ENABLED(TRANSFER_RESOURCE_CONTENTS_DELTAS)
+    // pipeline the requests - send one for every sample up-front so they're all in flight, then
+    // process the replies in order below. The remote side executes commands strictly in sequence
+    // off one reader so this is identical on the wire, we just don't pay a full round-trip of
+    // latency per sample.
     for(uint32_t sample = 0; sample < proxy.msSamp; sample++)
     {
       Subresource s = sub;
       s.sample = sample;
 
-      TextureCacheEntry sampleArrayEntry = {texid, s};
+      CacheTextureData_SendRequest(m_Writer, texid, s, params);
+    }
+#endif
 
-      GetTextureDataParams params = proxy.params;
+    for(uint32_t sample = 0; sample < proxy.msSamp; sample++)
+    {
+      Subresource s = sub;
+      s.sample = sample;
 
-      params.typeCast = typeCast;
+      TextureCacheEntry sampleArrayEntry = {texid, s};
 
 #if ENABLED(TRANSFER_RESOURCE_CONTENTS_DELTAS)
-      CacheTextureData(texid, s, params);
+      CacheTextureData_ReceiveReply(m_Writer, m_Reader, texid, s, params);
 #else
       GetTextureData(texid, s, params, m_ProxyTextureData[entry]);
 #endif
@@ -2388,11 +2603,21 @@ void ReplayProxy::EnsureBufCached(ResourceId bufid)
     CacheBufferData(bufid);
 #else
     GetBufferData(bufid, 0, 0, m_ProxyBufferData[bufid]);
+
+    // with full transfers we can't tell whether the contents changed, so always re-upload
+    m_ProxyBufferDataUpToDate.erase(bufid);
 #endif
 
+    // only re-upload to the proxy GPU buffer if the data changed since the last upload - stepping
+    // between events re-fetches every referenced buffer, but e.g. large mesh buffers rarely
+    // actually change and the upload cost is very visible on 10M+ vertex meshes.
     auto it = m_ProxyBufferData.find(bufid);
-    if(it != m_ProxyBufferData.end())
+    if(it != m_ProxyBufferData.end() &&
+       m_ProxyBufferDataUpToDate.find(bufid) == m_ProxyBufferDataUpToDate.end())
+    {
       m_Proxy->SetProxyBufferData(proxyid, it->second.data(), it->second.size());
+      m_ProxyBufferDataUpToDate.insert(bufid);
+    }
 
     m_BufferProxyCache.insert(bufid);
   }
@@ -121,7 +121,8 @@ DECLARE_REFLECTION_ENUM(ReplayProxyPacket);
 class ReplayProxy : public IReplayDriver
 {
 public:
-  ReplayProxy(ReadSerialiser &reader, WriteSerialiser &writer, IReplayDriver *proxy)
+  ReplayProxy(ReadSerialiser &reader, WriteSerialiser &writer, IReplayDriver *proxy,
+              uint64_t captureIdent = 0)
       : m_Reader(reader),
         m_Writer(writer),
         m_Proxy(proxy),
@@ -129,8 +130,10 @@ public:
         m_Replay(NULL),
         m_RemoteServer(false)
   {
+    m_CaptureIdent = captureIdent;
+    LoadImmutableCacheFile();
+
     GetAPIProperties();
-    FetchStructuredFile();
   }
 
   ReplayProxy(ReadSerialiser &reader, WriteSerialiser &writer, IRemoteDriver *remoteDriver,
@@ -453,11 +456,27 @@ public:
 
   bool Tick(int type);
 
+  // the event the last ReplayLog through this proxy ended on - used on the server side to
+  // restore a client's cursor when several clients share one replay.
+  uint32_t GetEventID() { return m_EventID; }
+
   const D3D11Pipe::State *GetD3D11PipelineState() { return &m_D3D11PipelineState; }
   const D3D12Pipe::State *GetD3D12PipelineState() { return &m_D3D12PipelineState; }
   const GLPipe::State *GetGLPipelineState() { return &m_GLPipelineState; }
   const VKPipe::State *GetVulkanPipelineState() { return &m_VulkanPipelineState; }
-  const SDFile &GetStructuredFile() { return m_StructuredFile; }
+  const SDFile &GetStructuredFile()
+  {
+    // only fetched the first time it's asked for - transferring the whole structured file from
+    // the remote server can take a long time and a lot of memory, and many sessions never look
+    // at raw chunks.
+    if(!m_StructuredFetched && !m_RemoteServer)
+    {
+      m_StructuredFetched = true;
+      FetchStructuredFile();
+    }
+
+    return m_StructuredFile;
+  }
   IMPLEMENT_FUNCTION_PROXIED(void, FetchStructuredFile);
 
   IMPLEMENT_FUNCTION_PROXIED(rdcarray<ResourceDescription>, GetResources);
@@ -522,10 +541,23 @@ public:
   IMPLEMENT_FUNCTION_PROXIED(rdcarray<PixelModification>, PixelHistory, rdcarray<EventUsage> events,
                              ResourceId target, uint32_t x, uint32_t y, const Subresource &sub,
                              CompType typeCast);
+  // not proxied itself - each pixel is gathered with a proxied PixelHistory call
+  rdcarray<rdcarray<PixelModification>> PixelHistoryRegion(rdcarray<EventUsage> events,
+                                                           ResourceId target, uint32_t x, uint32_t y,
+                                                           uint32_t width, uint32_t height,
+                                                           const Subresource &sub, CompType typeCast)
+  {
+    return StandardPixelHistoryRegion(this, events, target, x, y, width, height, sub, typeCast);
+  }
   IMPLEMENT_FUNCTION_PROXIED(ShaderDebugTrace *, DebugVertex, uint32_t eventId, uint32_t vertid,
                              uint32_t instid, uint32_t idx);
   IMPLEMENT_FUNCTION_PROXIED(ShaderDebugTrace *, DebugPixel, uint32_t eventId, uint32_t x,
                              uint32_t y, uint32_t sample, uint32_t primitive);
+  // not proxied itself - each invocation is gathered with a proxied DebugPixel call
+  rdcarray<ShaderDebugTrace *> DebugPixels(uint32_t eventId, const rdcarray<PixelDebugTarget> &targets)
+  {
+    return StandardDebugPixels(this, eventId, targets);
+  }
   IMPLEMENT_FUNCTION_PROXIED(ShaderDebugTrace *, DebugThread, uint32_t eventId,
                              const uint32_t groupid[3], const uint32_t threadid[3]);
   IMPLEMENT_FUNCTION_PROXIED(rdcarray<ShaderDebugState>, ContinueDebug, ShaderDebugger *debugger);
@@ -545,10 +577,24 @@ public:
   IMPLEMENT_FUNCTION_PROXIED(void, CacheTextureData, ResourceId tex, const Subresource &sub,
                              const GetTextureDataParams &params);
 
+  // the request/reply halves of CacheTextureData, split out so that the host side can pipeline
+  // several independent requests - sending them all up-front and then processing the replies in
+  // order - instead of paying a full network round-trip of latency per request. The remote side
+  // executes commands strictly in sequence off one reader, so in-order replies are sufficient and
+  // the combined Proxied_CacheTextureData is dispatched there as normal.
+  template <typename ParamSerialiser>
+  void CacheTextureData_SendRequest(ParamSerialiser &paramser, ResourceId &tex,
+                                    const Subresource &sub, const GetTextureDataParams &params);
+  template <typename ParamSerialiser, typename ReturnSerialiser>
+  void CacheTextureData_ReceiveReply(ParamSerialiser &paramser, ReturnSerialiser &retser,
+                                     ResourceId tex, const Subresource &sub,
+                                     const GetTextureDataParams &params);
+
   // utility function to serialise the contents of a byte array given the previous contents that's
-  // available on both sides of the communication.
+  // available on both sides of the communication. Returns true if the contents actually changed -
+  // when reading, false means referenceData was already up to date and nothing was applied.
   template <typename SerialiserType>
-  void DeltaTransferBytes(SerialiserType &xferser, bytebuf &referenceData, bytebuf &newData);
+  bool DeltaTransferBytes(SerialiserType &xferser, bytebuf &referenceData, bytebuf &newData);
 
   void FileChanged() {}
   // will never be used
@@ -604,6 +650,10 @@ private:
   std::set<TextureCacheEntry> m_TextureProxyCache;
   std::set<ResourceId> m_BufferProxyCache;
 
+  // client-side only - debug messages drained from the remote in each ReplayLog return packet,
+  // served by GetDebugMessages without an extra round trip.
+  rdcarray<DebugMessage> m_PendingDebugMessages;
+
   struct ProxyTextureProperties
   {
     ResourceId id;
@@ -626,6 +676,12 @@ private:
   std::map<TextureCacheEntry, bytebuf> m_ProxyTextureData;
   std::map<ResourceId, bytebuf> m_ProxyBufferData;
 
+  // buffers whose proxy GPU copy matches m_ProxyBufferData. The buffer proxy cache above is
+  // flushed on every replay so that changed data is re-fetched, but when the delta transfer
+  // reports a buffer's contents didn't change we can skip re-uploading it - stepping events while
+  // orbiting a large mesh shouldn't re-upload identical vertex data every event.
+  std::set<ResourceId> m_ProxyBufferDataUpToDate;
+
   // this lists any textures which are only created locally (e.g. custom visualisation shaders) and
   // should not be treated as proxied.
   std::set<ResourceId> m_LocalTextures;
@@ -659,6 +715,20 @@ private:
 
   std::map<ShaderReflKey, ShaderReflection *> m_ShaderReflectionCache;
 
+  // client-side only - disk cache of immutable whole-capture queries (resource lists and the
+  // frame record), keyed by the capture ident the server sent at open. Loaded once at creation,
+  // written back at shutdown if any entries were fetched over the wire this session.
+  void LoadImmutableCacheFile();
+  void SaveImmutableCacheFile();
+  template <typename T>
+  bool LoadImmutableReply(ReplayProxyPacket packet, T &ret);
+  template <typename T>
+  void SaveImmutableReply(ReplayProxyPacket packet, const T &ret);
+
+  uint64_t m_CaptureIdent = 0;
+  std::map<uint32_t, bytebuf> m_ImmutableCache;
+  bool m_ImmutableCacheDirty = false;
+
   // reader from the other side of the host <-> remote connection
   ReadSerialiser &m_Reader;
   // writer to the other side of the host <-> remote connection
@@ -714,6 +784,7 @@ private:
   rdcarray<DrawcallDescription *> m_Drawcalls;
 
   SDFile m_StructuredFile;
+  bool m_StructuredFetched = false;
 
   D3D11Pipe::State m_D3D11PipelineState;
   D3D12Pipe::State m_D3D12PipelineState;
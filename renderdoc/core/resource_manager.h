@@ -619,6 +619,7 @@ public:
   // when asked for a given id, return the resource for a replacement id
   void ReplaceResource(ResourceId from, ResourceId to);
   bool HasReplacement(ResourceId from);
+  bool HasReplacements();
   void RemoveReplacement(ResourceId id);
 
   // get the original ID for a real ID that may be a replacement. i.e. if ID 123 is ID 10000005
@@ -633,6 +634,10 @@ public:
   // Serialise in which resources need initial contents and set them up.
   void CreateInitialContents(ReadSerialiser &ser);
 
+  // Serialise in a reference to another resource's initial contents, for resources that were
+  // deduplicated at capture time because their contents hashed identically.
+  void CreateInitialContentsReference(ReadSerialiser &ser);
+
   // Free any initial contents that are prepared (for after capture is complete)
   void FreeInitialContents();
 
@@ -669,11 +674,31 @@ protected:
     return true;
   }
   virtual bool Prepare_InitialState(WrappedResourceType res) = 0;
+  // drivers whose Prepare_InitialState is safe to call from multiple threads simultaneously (i.e.
+  // it doesn't record into shared command buffers or submit to a queue without its own locking) can
+  // return a count greater than 1 here to have dirty resources prepared on a pool of worker threads
+  // at capture time. The driver must also guarantee resources can't be destroyed while
+  // PrepareInitialContents is running, since the workers run outside m_Lock.
+  virtual uint32_t PrepareInitialStateThreadCount() { return 1; }
+  // drivers that can cheaply read back the raw bytes of a prepared initial state can return a
+  // content hash here, to opt into deduplication when the capture is written - initial states
+  // that hash identically are stored once and referenced by the other resources. The hash must
+  // only ever match where serialising either initial state would produce an interchangeable
+  // chunk, so any type information that affects serialisation or apply must be folded in.
+  virtual bool Hash_InitialState(ResourceId id, const InitialContentData &initial, uint64_t &hash)
+  {
+    return false;
+  }
   virtual uint64_t GetSize_InitialState(ResourceId id, const InitialContentData &initial) = 0;
   virtual bool Serialise_InitialState(WriteSerialiser &ser, ResourceId id, RecordType *record,
                                       const InitialContentData *initialData) = 0;
   virtual void Create_InitialState(ResourceId id, WrappedResourceType live, bool hasData) = 0;
   virtual void Apply_InitialState(WrappedResourceType live, const InitialContentData &initial) = 0;
+  // equivalent of PrepareInitialStateThreadCount() for the replay side - drivers whose
+  // Apply_InitialState only does CPU-side copies, or batches its GPU uploads with its own locking,
+  // can return a count greater than 1 to apply initial states on a pool of worker threads at the
+  // start of each replay loop.
+  virtual uint32_t ApplyInitialStateThreadCount() { return 1; }
   virtual rdcarray<ResourceId> InitialContentResources();
 
   // very coarse lock, protects EVERYTHING. This could certainly be improved and it may be a
@@ -719,9 +744,26 @@ protected:
   // used during capture or replay - holds initial contents
   std::map<ResourceId, InitialContentDataOrChunk> m_InitialContents;
 
+  // used during replay - resources whose initial contents were deduplicated at capture time,
+  // mapped to the resource whose serialised data they share
+  std::map<ResourceId, ResourceId> m_InitialContentsDuplicates;
+
+  // the current-resource and record maps are queried on every wrapped API call from all of the
+  // application's threads, so unlike everything else they're sharded by ID with a lock per shard
+  // to spread the contention. ResourceIds are sequential, so contiguous ids distribute evenly.
+  // Lock order: m_Lock (if held at all) is always taken before a shard lock, never after.
+  static const uint64_t ShardCount = 16;
+
+  static uint64_t ShardFor(ResourceId id) { return ((uint64_t &)id) % ShardCount; }
+
   // used during capture or replay - map of resources currently alive with their real IDs, used in
   // capture and replay.
-  std::map<ResourceId, WrappedResourceType> m_CurrentResourceMap;
+  struct ResourceShard
+  {
+    Threading::CriticalSection lock;
+    std::map<ResourceId, WrappedResourceType> resources;
+  };
+  ResourceShard m_CurrentResourceShards[ShardCount];
 
   // used during replay - maps back and forth from original id to live id and vice-versa
   std::map<ResourceId, ResourceId> m_OriginalIDs, m_LiveIDs;
@@ -730,11 +772,19 @@ protected:
   std::map<ResourceId, WrappedResourceType> m_LiveResourceMap;
 
   // used during capture - holds resource records by id.
-  std::map<ResourceId, RecordType *> m_ResourceRecords;
+  struct RecordShard
+  {
+    Threading::CriticalSection lock;
+    std::map<ResourceId, RecordType *> records;
+  };
+  RecordShard m_RecordShards[ShardCount];
 
   // used during replay - holds current resource replacements
   // replaced -> replacement
   std::map<ResourceId, ResourceId> m_Replacements;
+  // count of active replacements, so the capture hot path can skip taking m_Lock to check
+  // m_Replacements when there are none (they only exist during replay shader/resource editing)
+  volatile int32_t m_NumReplacements = 0;
   // replacement -> replaced (for looking up original IDs)
   std::map<ResourceId, ResourceId> m_Replaced;
 
@@ -780,7 +830,8 @@ void ResourceManager<Configuration>::Shutdown()
       m_LiveResourceMap.erase(removeit);
   }
 
-  RDCASSERT(m_ResourceRecords.empty());
+  for(RecordShard &shard : m_RecordShards)
+    RDCASSERT(shard.records.empty());
 }
 
 template <typename Configuration>
@@ -788,7 +839,9 @@ ResourceManager<Configuration>::~ResourceManager()
 {
   RDCASSERT(m_LiveResourceMap.empty());
   RDCASSERT(m_InitialContents.empty());
-  RDCASSERT(m_ResourceRecords.empty());
+
+  for(RecordShard &shard : m_RecordShards)
+    RDCASSERT(shard.records.empty());
 
   if(RenderDoc::Inst().GetCrashHandler())
     RenderDoc::Inst().GetCrashHandler()->UnregisterMemoryRegion(this);
@@ -971,6 +1024,7 @@ void ResourceManager<Configuration>::FreeInitialContents()
     if(!m_InitialContents.empty())
       m_InitialContents.erase(m_InitialContents.begin());
   }
+  m_InitialContentsDuplicates.clear();
   m_PostponedResourceIDs.clear();
 }
 
@@ -1099,6 +1153,34 @@ void ResourceManager<Configuration>::CreateInitialContents(ReadSerialiser &ser)
       ++it;
     }
   }
+
+  for(auto it = m_InitialContentsDuplicates.begin(); it != m_InitialContentsDuplicates.end();)
+  {
+    if(neededInitials.find(it->first) == neededInitials.end())
+      it = m_InitialContentsDuplicates.erase(it);
+    else
+      ++it;
+  }
+}
+
+template <typename Configuration>
+void ResourceManager<Configuration>::CreateInitialContentsReference(ReadSerialiser &ser)
+{
+  SERIALISE_ELEMENT_LOCAL(Id, ResourceId());
+  SERIALISE_ELEMENT_LOCAL(SourceId, ResourceId());
+
+  SCOPED_LOCK(m_Lock);
+
+  // if the driver already created default contents for this resource (because the contents list
+  // chunk was processed first), drop them - the real contents come from the source resource.
+  auto it = m_InitialContents.find(Id);
+  if(it != m_InitialContents.end())
+  {
+    it->second.Free(this);
+    m_InitialContents.erase(Id);
+  }
+
+  m_InitialContentsDuplicates[Id] = SourceId;
 }
 
 template <typename Configuration>
@@ -1106,13 +1188,82 @@ void ResourceManager<Configuration>::ApplyInitialContents()
 {
   RDCDEBUG("Applying initial contents");
   rdcarray<ResourceId> resources = InitialContentResources();
-  for(auto it = resources.begin(); it != resources.end(); ++it)
+
+  uint32_t threadCount = RDCMIN((uint32_t)resources.size(), ApplyInitialStateThreadCount());
+
+  if(threadCount > 1)
+  {
+    // resolve the live resources and initial data up front so the workers don't touch the maps,
+    // then let each worker pull the next unclaimed resource. The initial contents themselves don't
+    // change during replay so the workers can read them freely.
+    rdcarray<rdcpair<WrappedResourceType, const InitialContentData *>> worklist;
+    worklist.reserve(resources.size());
+
+    for(ResourceId id : resources)
+      worklist.push_back(make_rdcpair<WrappedResourceType, const InitialContentData *>(
+          GetLiveResource(id), &m_InitialContents[id].data));
+
+    // deduplicated resources share the source resource's data, which is only read during apply
+    for(auto dup = m_InitialContentsDuplicates.begin(); dup != m_InitialContentsDuplicates.end();
+        ++dup)
+    {
+      auto src = m_InitialContents.find(dup->second);
+
+      if(!HasLiveResource(dup->first) || src == m_InitialContents.end())
+        continue;
+
+      worklist.push_back(make_rdcpair<WrappedResourceType, const InitialContentData *>(
+          GetLiveResource(dup->first), &src->second.data));
+    }
+
+    volatile int32_t nextIdx = 0;
+
+    rdcarray<Threading::ThreadHandle> threads;
+    threads.resize(threadCount);
+
+    for(uint32_t i = 0; i < threadCount; i++)
+    {
+      threads[i] = Threading::CreateThread([this, &worklist, &nextIdx]() {
+        for(;;)
+        {
+          int32_t idx = Atomic::Inc32(&nextIdx) - 1;
+
+          if(idx >= worklist.count())
+            break;
+
+          Apply_InitialState(worklist[idx].first, *worklist[idx].second);
+        }
+      });
+    }
+
+    for(Threading::ThreadHandle thread : threads)
+    {
+      Threading::JoinThread(thread);
+      Threading::CloseThread(thread);
+    }
+  }
+  else
   {
-    ResourceId id = *it;
-    const InitialContentDataOrChunk &data = m_InitialContents[id];
-    WrappedResourceType live = GetLiveResource(id);
-    Apply_InitialState(live, data.data);
+    for(auto it = resources.begin(); it != resources.end(); ++it)
+    {
+      ResourceId id = *it;
+      const InitialContentDataOrChunk &data = m_InitialContents[id];
+      WrappedResourceType live = GetLiveResource(id);
+      Apply_InitialState(live, data.data);
+    }
+
+    for(auto dup = m_InitialContentsDuplicates.begin(); dup != m_InitialContentsDuplicates.end();
+        ++dup)
+    {
+      auto src = m_InitialContents.find(dup->second);
+
+      if(!HasLiveResource(dup->first) || src == m_InitialContents.end())
+        continue;
+
+      Apply_InitialState(GetLiveResource(dup->first), src->second.data);
+    }
   }
+
   RDCDEBUG("Applied %d", (uint32_t)resources.size());
 }
 
@@ -1137,9 +1288,12 @@ void ResourceManager<Configuration>::MarkUnwrittenResources()
 {
   SCOPED_LOCK(m_Lock);
 
-  for(auto it = m_ResourceRecords.begin(); it != m_ResourceRecords.end(); ++it)
+  for(RecordShard &shard : m_RecordShards)
   {
-    it->second->MarkDataUnwritten();
+    SCOPED_LOCK(shard.lock);
+
+    for(auto it = shard.records.begin(); it != shard.records.end(); ++it)
+      it->second->MarkDataUnwritten();
   }
 }
 
@@ -1154,19 +1308,29 @@ void ResourceManager<Configuration>::InsertReferencedChunks(WriteSerialiser &ser
 
   if(RenderDoc::Inst().GetCaptureOptions().refAllResources)
   {
-    float num = float(m_ResourceRecords.size());
+    float num = 0.0f;
+    for(RecordShard &shard : m_RecordShards)
+    {
+      SCOPED_LOCK(shard.lock);
+      num += float(shard.records.size());
+    }
     float idx = 0.0f;
 
-    for(auto it = m_ResourceRecords.begin(); it != m_ResourceRecords.end(); ++it)
+    for(RecordShard &shard : m_RecordShards)
     {
-      RenderDoc::Inst().SetProgress(CaptureProgress::AddReferencedResources, idx / num);
-      idx += 1.0f;
+      SCOPED_LOCK(shard.lock);
 
-      if(m_FrameReferencedResources.find(it->first) == m_FrameReferencedResources.end() &&
-         it->second->InternalResource)
-        continue;
+      for(auto it = shard.records.begin(); it != shard.records.end(); ++it)
+      {
+        RenderDoc::Inst().SetProgress(CaptureProgress::AddReferencedResources, idx / num);
+        idx += 1.0f;
 
-      it->second->Insert(sortedChunks);
+        if(m_FrameReferencedResources.find(it->first) == m_FrameReferencedResources.end() &&
+           it->second->InternalResource)
+          continue;
+
+        it->second->Insert(sortedChunks);
+      }
     }
   }
   else
@@ -1196,52 +1360,104 @@ void ResourceManager<Configuration>::InsertReferencedChunks(WriteSerialiser &ser
 template <typename Configuration>
 void ResourceManager<Configuration>::PrepareInitialContents()
 {
-  SCOPED_LOCK(m_Lock);
+  rdcarray<WrappedResourceType> worklist;
 
-  RDCDEBUG("Preparing up to %u potentially dirty resources", (uint32_t)m_DirtyResources.size());
-  uint32_t prepared = 0;
+  {
+    SCOPED_LOCK(m_Lock);
 
-  float num = float(m_DirtyResources.size());
-  float idx = 0.0f;
+    RDCDEBUG("Preparing up to %u potentially dirty resources", (uint32_t)m_DirtyResources.size());
+
+    for(auto it = m_DirtyResources.begin(); it != m_DirtyResources.end(); ++it)
+    {
+      ResourceId id = *it;
 
-  for(auto it = m_DirtyResources.begin(); it != m_DirtyResources.end(); ++it)
+      // if somehow this resource has been deleted but is still dirty, we can't prepare it.
+      // Resources deleted prior to beginning the frame capture cannot linger and be needed - we
+      // only need to care about resources deleted after this point (mid-capture)
+      if(!HasCurrentResource(id))
+        continue;
+
+      RecordType *record = GetResourceRecord(id);
+
+      // don't prepare internal resources, or those without a record
+      if(record == NULL || record->InternalResource)
+        continue;
+
+      if(IsResourcePersistent(id))
+      {
+        m_PostponedResourceIDs.insert(id);
+        // Set empty contents here, it'll be prepared on serialization.
+        SetInitialContents(id, InitialContentData());
+        continue;
+      }
+
+#if ENABLED(VERBOSE_DIRTY_RESOURCES)
+      RDCDEBUG("Prepare Resource %s", ToStr(id).c_str());
+#endif
+
+      worklist.push_back(GetCurrentResource(id));
+    }
+  }
+
+  uint32_t threadCount = RDCMIN((uint32_t)worklist.size(), PrepareInitialStateThreadCount());
+
+  if(threadCount > 1)
   {
-    ResourceId id = *it;
+    // the driver has declared Prepare_InitialState thread-safe, so fan the worklist out to a pool
+    // of workers each pulling the next unclaimed resource. Prepare_InitialState implementations may
+    // take m_Lock themselves (e.g. via SetInitialContents) so the workers must run outside it.
+    volatile int32_t nextIdx = 0;
+    volatile int32_t doneCount = 0;
 
-    RenderDoc::Inst().SetProgress(CaptureProgress::PrepareInitialStates, idx / num);
-    idx += 1.0f;
+    rdcarray<Threading::ThreadHandle> threads;
+    threads.resize(threadCount);
 
-    // if somehow this resource has been deleted but is still dirty, we can't prepare it. Resources
-    // deleted prior to beginning the frame capture cannot linger and be needed - we only need to
-    // care about resources deleted after this point (mid-capture)
-    if(!HasCurrentResource(id))
-      continue;
+    for(uint32_t i = 0; i < threadCount; i++)
+    {
+      threads[i] = Threading::CreateThread([this, &worklist, &nextIdx, &doneCount]() {
+        for(;;)
+        {
+          int32_t idx = Atomic::Inc32(&nextIdx) - 1;
 
-    RecordType *record = GetResourceRecord(id);
-    WrappedResourceType res = GetCurrentResource(id);
+          if(idx >= worklist.count())
+            break;
 
-    // don't prepare internal resources, or those without a record
-    if(record == NULL || record->InternalResource)
-      continue;
+          Prepare_InitialState(worklist[idx]);
+
+          Atomic::Inc32(&doneCount);
+        }
+      });
+    }
 
-    if(IsResourcePersistent(id))
+    // the calling thread only reports progress while the workers drain the queue
+    while(doneCount < worklist.count())
     {
-      m_PostponedResourceIDs.insert(id);
-      // Set empty contents here, it'll be prepared on serialization.
-      SetInitialContents(id, InitialContentData());
-      continue;
+      RenderDoc::Inst().SetProgress(CaptureProgress::PrepareInitialStates,
+                                    float(doneCount) / float(worklist.count()));
+      Threading::Sleep(1);
     }
 
-    prepared++;
+    for(Threading::ThreadHandle thread : threads)
+    {
+      Threading::JoinThread(thread);
+      Threading::CloseThread(thread);
+    }
+  }
+  else
+  {
+    float num = float(worklist.size());
+    float idx = 0.0f;
 
-#if ENABLED(VERBOSE_DIRTY_RESOURCES)
-    RDCDEBUG("Prepare Resource %s", ToStr(id).c_str());
-#endif
+    for(WrappedResourceType res : worklist)
+    {
+      RenderDoc::Inst().SetProgress(CaptureProgress::PrepareInitialStates, idx / num);
+      idx += 1.0f;
 
-    Prepare_InitialState(res);
+      Prepare_InitialState(res);
+    }
   }
 
-  RDCDEBUG("Prepared %u dirty resources", prepared);
+  RDCDEBUG("Prepared %u dirty resources", (uint32_t)worklist.size());
 }
 
 template <typename Configuration>
@@ -1251,6 +1467,13 @@ void ResourceManager<Configuration>::InsertInitialContentsChunks(WriteSerialiser
 
   uint32_t dirty = 0;
   uint32_t skipped = 0;
+  uint32_t deduplicated = 0;
+
+  // content hash of each serialised initial state to the id that owns the data and the state's
+  // size - if a later resource hashes identically we write a reference chunk instead of
+  // repeating the data. Applications commonly clone identical buffers, so this can be a large
+  // fraction of the initial states.
+  std::map<uint64_t, rdcpair<ResourceId, uint64_t>> contentHashes;
 
   RDCDEBUG("Checking %u resources with initial contents", (uint32_t)m_InitialContents.size());
 
@@ -1316,16 +1539,43 @@ void ResourceManager<Configuration>::InsertInitialContentsChunks(WriteSerialiser
     {
       uint64_t size = GetSize_InitialState(id, it->second.data);
 
-      SCOPED_SERIALISE_CHUNK(SystemChunk::InitialContents, size);
+      uint64_t hash = 0;
+      ResourceId source;
 
-      Serialise_InitialState(ser, id, record, &it->second.data);
+      if(Hash_InitialState(id, it->second.data, hash))
+      {
+        auto ins = contentHashes.insert(
+            std::make_pair(hash, make_rdcpair<ResourceId, uint64_t>(id, size)));
+
+        // only dedup if the sizes also match - a hash collision between different sizes is
+        // certainly not the same data, we just lose the dedup for the second blob.
+        if(!ins.second && ins.first->second.second == size)
+          source = ins.first->second.first;
+      }
+
+      if(source != ResourceId())
+      {
+        deduplicated++;
+
+        SCOPED_SERIALISE_CHUNK(SystemChunk::InitialContentsReference, 64);
+
+        SERIALISE_ELEMENT_LOCAL(Id, id);
+        SERIALISE_ELEMENT_LOCAL(SourceId, source);
+      }
+      else
+      {
+        SCOPED_SERIALISE_CHUNK(SystemChunk::InitialContents, size);
+
+        Serialise_InitialState(ser, id, record, &it->second.data);
+      }
     }
 
     // Reset back to empty contents, unloading the actual resource.
     SetInitialContents(id, InitialContentData());
   }
 
-  RDCDEBUG("Serialised %u resources, skipped %u unreferenced", dirty, skipped);
+  RDCDEBUG("Serialised %u resources (%u deduplicated), skipped %u unreferenced", dirty,
+           deduplicated, skipped);
 }
 
 template <typename Configuration>
@@ -1380,6 +1630,9 @@ void ResourceManager<Configuration>::ReplaceResource(ResourceId from, ResourceId
 
   if(HasLiveResource(to))
   {
+    if(m_Replacements.find(from) == m_Replacements.end())
+      Atomic::Inc32(&m_NumReplacements);
+
     m_Replacements[from] = to;
     m_Replaced[to] = from;
   }
@@ -1393,6 +1646,13 @@ bool ResourceManager<Configuration>::HasReplacement(ResourceId from)
   return m_Replacements.find(from) != m_Replacements.end();
 }
 
+template <typename Configuration>
+bool ResourceManager<Configuration>::HasReplacements()
+{
+  // the count is updated atomically so we don't need to take the lock just to check for presence
+  return m_NumReplacements > 0;
+}
+
 template <typename Configuration>
 void ResourceManager<Configuration>::RemoveReplacement(ResourceId id)
 {
@@ -1405,16 +1665,20 @@ void ResourceManager<Configuration>::RemoveReplacement(ResourceId id)
 
   m_Replaced.erase(it->second);
   m_Replacements.erase(it);
+
+  Atomic::Dec32(&m_NumReplacements);
 }
 
 template <typename Configuration>
 typename Configuration::RecordType *ResourceManager<Configuration>::GetResourceRecord(ResourceId id)
 {
-  SCOPED_LOCK(m_Lock);
+  RecordShard &shard = m_RecordShards[ShardFor(id)];
 
-  auto it = m_ResourceRecords.find(id);
+  SCOPED_LOCK(shard.lock);
 
-  if(it == m_ResourceRecords.end())
+  auto it = shard.records.find(id);
+
+  if(it == shard.records.end())
     return NULL;
 
   return it->second;
@@ -1423,11 +1687,13 @@ typename Configuration::RecordType *ResourceManager<Configuration>::GetResourceR
 template <typename Configuration>
 bool ResourceManager<Configuration>::HasResourceRecord(ResourceId id)
 {
-  SCOPED_LOCK(m_Lock);
+  RecordShard &shard = m_RecordShards[ShardFor(id)];
 
-  auto it = m_ResourceRecords.find(id);
+  SCOPED_LOCK(shard.lock);
 
-  if(it == m_ResourceRecords.end())
+  auto it = shard.records.find(id);
+
+  if(it == shard.records.end())
     return false;
 
   return true;
@@ -1436,21 +1702,25 @@ bool ResourceManager<Configuration>::HasResourceRecord(ResourceId id)
 template <typename Configuration>
 typename Configuration::RecordType *ResourceManager<Configuration>::AddResourceRecord(ResourceId id)
 {
-  SCOPED_LOCK(m_Lock);
+  RecordShard &shard = m_RecordShards[ShardFor(id)];
 
-  RDCASSERT(m_ResourceRecords.find(id) == m_ResourceRecords.end(), id);
+  SCOPED_LOCK(shard.lock);
 
-  return (m_ResourceRecords[id] = new RecordType(id));
+  RDCASSERT(shard.records.find(id) == shard.records.end(), id);
+
+  return (shard.records[id] = new RecordType(id));
 }
 
 template <typename Configuration>
 void ResourceManager<Configuration>::RemoveResourceRecord(ResourceId id)
 {
-  SCOPED_LOCK(m_Lock);
+  RecordShard &shard = m_RecordShards[ShardFor(id)];
 
-  RDCASSERT(m_ResourceRecords.find(id) != m_ResourceRecords.end(), id);
+  SCOPED_LOCK(shard.lock);
 
-  m_ResourceRecords.erase(id);
+  RDCASSERT(shard.records.find(id) != shard.records.end(), id);
+
+  shard.records.erase(id);
 }
 
 template <typename Configuration>
@@ -1597,34 +1867,46 @@ void ResourceManager<Configuration>::EraseLiveResource(ResourceId origid)
 template <typename Configuration>
 void ResourceManager<Configuration>::AddCurrentResource(ResourceId id, WrappedResourceType res)
 {
-  SCOPED_LOCK(m_Lock);
+  ResourceShard &shard = m_CurrentResourceShards[ShardFor(id)];
+
+  SCOPED_LOCK(shard.lock);
 
-  RDCASSERT(m_CurrentResourceMap.find(id) == m_CurrentResourceMap.end(), id);
-  m_CurrentResourceMap[id] = res;
+  RDCASSERT(shard.resources.find(id) == shard.resources.end(), id);
+  shard.resources[id] = res;
 }
 
 template <typename Configuration>
 bool ResourceManager<Configuration>::HasCurrentResource(ResourceId id)
 {
-  SCOPED_LOCK(m_Lock);
+  ResourceShard &shard = m_CurrentResourceShards[ShardFor(id)];
+
+  SCOPED_LOCK(shard.lock);
 
-  return m_CurrentResourceMap.find(id) != m_CurrentResourceMap.end();
+  return shard.resources.find(id) != shard.resources.end();
 }
 
 template <typename Configuration>
 typename Configuration::WrappedResourceType ResourceManager<Configuration>::GetCurrentResource(
     ResourceId id)
 {
-  SCOPED_LOCK(m_Lock);
-
   if(id == ResourceId())
     return (WrappedResourceType)RecordType::NullResource;
 
-  if(m_Replacements.find(id) != m_Replacements.end())
-    return GetCurrentResource(m_Replacements[id]);
+  // replacements only exist during replay, so on the capture hot path skip taking the main lock
+  if(m_NumReplacements > 0)
+  {
+    SCOPED_LOCK(m_Lock);
+
+    if(m_Replacements.find(id) != m_Replacements.end())
+      return GetCurrentResource(m_Replacements[id]);
+  }
+
+  ResourceShard &shard = m_CurrentResourceShards[ShardFor(id)];
+
+  SCOPED_LOCK(shard.lock);
 
-  RDCASSERT(m_CurrentResourceMap.find(id) != m_CurrentResourceMap.end(), id);
-  return m_CurrentResourceMap[id];
+  RDCASSERT(shard.resources.find(id) != shard.resources.end(), id);
+  return shard.resources[id];
 }
 
 template <typename Configuration>
@@ -1632,13 +1914,19 @@ void ResourceManager<Configuration>::ReleaseCurrentResource(ResourceId id)
 {
   SCOPED_LOCK(m_Lock);
 
-  RDCASSERT(m_CurrentResourceMap.find(id) != m_CurrentResourceMap.end(), id);
-
   // We potentially need to prepare this resource on Active Capture,
   // if it was postponed, but is about to go away.
   Prepare_ResourceIfActivePostponed(id);
 
-  m_CurrentResourceMap.erase(id);
+  {
+    ResourceShard &shard = m_CurrentResourceShards[ShardFor(id)];
+
+    SCOPED_LOCK(shard.lock);
+
+    RDCASSERT(shard.resources.find(id) != shard.resources.end(), id);
+    shard.resources.erase(id);
+  }
+
   m_DirtyResources.erase(id);
   m_LastWriteTime.erase(id);
 }
@@ -32,7 +32,7 @@
 #include "replay/replay_driver.h"
 #include "serialise/serialiser.h"
 
-static const uint32_t TargetControlProtocolVersion = 6;
+static const uint32_t TargetControlProtocolVersion = 7;
 
 static bool IsProtocolVersionSupported(const uint32_t protocolVersion)
 {
@@ -52,6 +52,10 @@ static bool IsProtocolVersionSupported(const uint32_t protocolVersion)
   if(protocolVersion == 5)
     return true;
 
+  // 6 -> 7 report queued captures in one batched packet
+  if(protocolVersion == 6)
+    return true;
+
   if(protocolVersion == TargetControlProtocolVersion)
     return true;
 
@@ -72,7 +76,8 @@ enum PacketType : uint32_t
   ePacket_NewChild,
   ePacket_CaptureProgress,
   ePacket_CycleActiveWindow,
-  ePacket_CapturableWindowCount
+  ePacket_CapturableWindowCount,
+  ePacket_NewCaptureList
 };
 
 DECLARE_REFLECTION_ENUM(PacketType);
@@ -95,6 +100,7 @@ rdcstr DoStringise(const PacketType &el)
     STRINGISE_ENUM_NAMED(ePacket_CaptureProgress, "Capture Progress");
     STRINGISE_ENUM_NAMED(ePacket_CycleActiveWindow, "Cycle Active Window");
     STRINGISE_ENUM_NAMED(ePacket_CapturableWindowCount, "Capturable Window Count");
+    STRINGISE_ENUM_NAMED(ePacket_NewCaptureList, "New Capture List");
   }
   END_ENUM_STRINGISE();
 }
@@ -204,6 +210,54 @@ void RenderDoc::TargetControlClientThread(uint32_t version, Network::Socket *cli
         SERIALISE_ELEMENT(supported);
       }
     }
+    else if(caps.size() != captures.size() && version >= 7)
+    {
+      // report every capture we haven't sent yet in one batched packet. Connecting to a session
+      // with a large backlog of queued captures used to report one per tick, which took seconds
+      // to enumerate. Thumbnails are only decoded for the most recent few - each one means
+      // opening the capture file, and the UI can't usefully show hundreds for a backlog anyway,
+      // so older entries send an empty thumbnail.
+      const size_t maxThumbnails = 8;
+
+      uint32_t numCaptures = uint32_t(caps.size() - captures.size());
+
+      WRITE_DATA_SCOPE();
+      {
+        SCOPED_SERIALISE_CHUNK(ePacket_NewCaptureList);
+        SERIALISE_ELEMENT(numCaptures);
+
+        for(uint32_t i = 0; i < numCaptures; i++)
+        {
+          uint32_t idx = (uint32_t)captures.size();
+
+          captures.push_back(caps[idx]);
+
+          rdcstr path = FileIO::GetFullPathname(captures.back().path);
+
+          bytebuf buf;
+
+          if(numCaptures - i <= maxThumbnails)
+          {
+            ICaptureFile *file = RENDERDOC_OpenCaptureFile();
+            if(file->OpenFile(captures.back().path.c_str(), "rdc", NULL) == ReplayStatus::Succeeded)
+            {
+              buf = file->GetThumbnail(FileType::JPG, 0).data;
+            }
+            file->Shutdown();
+          }
+
+          uint64_t byteSize = FileIO::GetFileSize(captures.back().path);
+
+          SERIALISE_ELEMENT(idx);
+          SERIALISE_ELEMENT(captures.back().timestamp);
+          SERIALISE_ELEMENT(path);
+          SERIALISE_ELEMENT(buf);
+          SERIALISE_ELEMENT(captures.back().driver);
+          SERIALISE_ELEMENT(captures.back().frameNumber);
+          SERIALISE_ELEMENT(byteSize);
+        }
+      }
+    }
     else if(caps.size() != captures.size())
     {
       uint32_t idx = (uint32_t)captures.size();
@@ -667,6 +721,15 @@ public:
   TargetControlMessage ReceiveMessage(RENDERDOC_ProgressCallback progress)
   {
     TargetControlMessage msg;
+
+    // drain any messages decoded from an earlier batched packet before reading more off the wire
+    if(!m_PendingMessages.empty())
+    {
+      msg = m_PendingMessages.front();
+      m_PendingMessages.erase(0);
+      return msg;
+    }
+
     if(m_Socket == NULL)
     {
       msg.type = TargetControlMessageType::Disconnected;
@@ -783,27 +846,59 @@ public:
              msg.newCapture.captureId, msg.newCapture.frameNumber, msg.newCapture.byteSize,
              msg.newCapture.timestamp, thumbnail.count());
 
-      int w = 0;
-      int h = 0;
-      int comp = 3;
-      byte *thumbpixels = jpgd::decompress_jpeg_image_from_memory(
-          thumbnail.data(), thumbnail.count(), &w, &h, &comp, 3);
+      DecodeThumbnail(msg.newCapture, thumbnail);
+
+      reader.EndChunk();
+      return msg;
+    }
+    else if(type == ePacket_NewCaptureList)
+    {
+      uint32_t numCaptures = 0;
 
-      if(w > 0 && h > 0 && thumbpixels)
+      READ_DATA_SCOPE();
+      SERIALISE_ELEMENT(numCaptures);
+
+      RDCLOG("Got a batch of %u new captures", numCaptures);
+
+      for(uint32_t i = 0; i < numCaptures; i++)
       {
-        msg.newCapture.thumbWidth = w;
-        msg.newCapture.thumbHeight = h;
-        msg.newCapture.thumbnail.assign(thumbpixels, w * h * 3);
+        TargetControlMessage cap;
+        cap.type = TargetControlMessageType::NewCapture;
+
+        bytebuf thumbnail;
+        RDCDriver driver = RDCDriver::Unknown;
+        uint64_t byteSize = 0;
+
+        SERIALISE_ELEMENT(cap.newCapture.captureId).Named("Capture ID"_lit);
+        SERIALISE_ELEMENT(cap.newCapture.timestamp).Named("timestamp"_lit);
+        SERIALISE_ELEMENT(cap.newCapture.path).Named("path"_lit);
+        SERIALISE_ELEMENT(thumbnail);
+        SERIALISE_ELEMENT(driver);
+        SERIALISE_ELEMENT(cap.newCapture.frameNumber);
+        SERIALISE_ELEMENT(byteSize);
+
+        cap.newCapture.byteSize = byteSize;
+
+        if(driver != RDCDriver::Unknown)
+          cap.newCapture.api = ToStr(driver);
+
+        cap.newCapture.local = FileIO::exists(cap.newCapture.path.c_str());
+
+        DecodeThumbnail(cap.newCapture, thumbnail);
+
+        m_PendingMessages.push_back(cap);
       }
-      else
+
+      reader.EndChunk();
+
+      if(m_PendingMessages.empty())
       {
-        msg.newCapture.thumbWidth = 0;
-        msg.newCapture.thumbHeight = 0;
+        msg.type = TargetControlMessageType::Noop;
+        return msg;
       }
 
-      free(thumbpixels);
-
-      reader.EndChunk();
+      msg = m_PendingMessages.front();
+      m_PendingMessages.erase(0);
       return msg;
     }
     else if(type == ePacket_APIUse)
@@ -880,12 +975,38 @@ public:
   }
 
 private:
+  static void DecodeThumbnail(NewCaptureData &cap, const bytebuf &thumbnail)
+  {
+    int w = 0;
+    int h = 0;
+    int comp = 3;
+    byte *thumbpixels = jpgd::decompress_jpeg_image_from_memory(thumbnail.data(),
+                                                                thumbnail.count(), &w, &h, &comp, 3);
+
+    if(w > 0 && h > 0 && thumbpixels)
+    {
+      cap.thumbWidth = w;
+      cap.thumbHeight = h;
+      cap.thumbnail.assign(thumbpixels, w * h * 3);
+    }
+    else
+    {
+      cap.thumbWidth = 0;
+      cap.thumbHeight = 0;
+    }
+
+    free(thumbpixels);
+  }
+
   Network::Socket *m_Socket;
   WriteSerialiser writer;
   ReadSerialiser reader;
   rdcstr m_Target, m_API, m_BusyClient;
   uint32_t m_Version, m_PID;
 
+  // messages decoded from a batched packet, waiting to be returned from ReceiveMessage
+  rdcarray<TargetControlMessage> m_PendingMessages;
+
   std::map<uint32_t, rdcstr> m_CaptureCopies;
 };
 
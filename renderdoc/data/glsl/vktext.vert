@@ -40,10 +40,13 @@ void main(void)
   vec3 pos = verts[vert];
   uint strindex = uint(gl_VertexIndex) / 6u;
 
-  vec2 charPos =
-      vec2(float(strindex) + pos.x + general.TextPosition.x, pos.y + general.TextPosition.y);
+  // .x is the glyph, .y and .z are the character's column and row within the text block
+  uvec4 c = str.chars[strindex];
 
-  FontGlyphData G = glyphs.data[str.chars[strindex].x];
+  vec2 charPos = vec2(float(c.y) + pos.x + general.TextPosition.x,
+                      float(c.z) + pos.y + general.TextPosition.y);
+
+  FontGlyphData G = glyphs.data[c.x];
 
   gl_Position =
       vec4(charPos.xy * 2.0f * general.TextSize * general.FontScreenAspect.xy + vec2(-1, -1), 1, 1);
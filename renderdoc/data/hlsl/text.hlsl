@@ -51,11 +51,13 @@ struct v2f
   float2 glyphuv : GLYPH;
 };
 
-v2f Text(float2 pos, int charidx, int glyphidx)
+v2f Text(float2 pos, int2 charidx, int glyphidx)
 {
   v2f OUT = (v2f)0;
 
-  float2 charPos = float2(float(charidx) + pos.x + TextPosition.x, -pos.y - TextPosition.y);
+  // charidx is the character's column and row within the text block
+  float2 charPos = float2(float(charidx.x) + pos.x + TextPosition.x,
+                          -float(charidx.y) - pos.y - TextPosition.y);
   glyph G = glyphs[glyphidx];
 
   OUT.pos = float4(charPos.xy * 2.0f * TextSize * FontScreenAspect.xy + float2(-1, 1), 1, 1);
@@ -72,13 +74,13 @@ v2f RENDERDOC_TextVS(uint vid : SV_VertexID, uint inst : SV_InstanceID)
       float2(0.0, 0.0), float2(1.0, 0.0), float2(0.0, 1.0), float2(1.0, 1.0),
   };
 
-  return Text(verts[vid], int(inst), chars[inst].x);
+  return Text(verts[vid], chars[inst].yz, chars[inst].x);
 }
 
 v2f RENDERDOC_Text9VS(float4 pos : POSITION)
 {
-  // hard mode on FL9, fetch from vertex inputs
-  return Text(pos.xy, int(pos.z + 0.1f), int(pos.w + 0.1f));
+  // hard mode on FL9, fetch from vertex inputs. FL9 draws line by line, so the row is always 0
+  return Text(pos.xy, int2(int(pos.z + 0.1f), 0), int(pos.w + 0.1f));
 }
 
 SamplerState pointSample : register(s0);
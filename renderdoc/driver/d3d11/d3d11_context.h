@@ -313,7 +313,13 @@ public:
   void SetFrameReader(StreamReader *reader) { m_FrameReader = reader; }
   void MarkResourceReferenced(ResourceId id, FrameRefType refType);
 
-  rdcarray<EventUsage> GetUsage(ResourceId id) { return m_ResourceUses[id]; }
+  rdcarray<EventUsage> GetUsage(ResourceId id)
+  {
+    auto it = m_ResourceUses.find(id);
+    if(it == m_ResourceUses.end())
+      return rdcarray<EventUsage>();
+    return it->second;
+  }
   void ClearMaps();
 
   uint32_t GetEventID() { return m_CurEventID; }
@@ -5170,6 +5170,11 @@ bool WrappedID3D11DeviceContext::Serialise_ExecuteCommandList(SerialiserType &se
     // The serialise of exec happens at the start of the inserted linearised commands from the
     // deferred command list. So if we're going to restore context state afterwards, save off our
     // current state. This will be restored in the Serialise_PostExecuteCommandList chunk.
+    //
+    // Note that because the deferred commands are linearised into the immediate context's stream
+    // at capture time, there is no separate per-command-list stream on replay that could be
+    // decoded independently - the commands between this chunk and PostExecuteCommandList are
+    // replayed in-line exactly like immediate commands.
     if(RestoreContextState)
     {
       SAFE_DELETE(m_DeferredSavedState);
@@ -7498,6 +7503,11 @@ bool WrappedID3D11DeviceContext::Serialise_Map(SerialiserType &ser, ID3D11Resour
       if(RenderDoc::Inst().GetCaptureOptions().verifyBufferAccess)
         memset(appMem, 0xcc, mapLength);
       memcpy(record->GetShadowPtr(ctxMapID, 1), appMem, mapLength);
+
+      // from here on only the application writes into appMem, so clear the page write records -
+      // Unmap() then serialises just the pages it actually touched rather than the whole buffer.
+      if(record->IsShadowWriteTracked(ctxMapID))
+        WriteWatch::ResetRange(appMem, mapLength);
     }
 
     intercept = MapIntercept();
@@ -7777,13 +7787,51 @@ bool WrappedID3D11DeviceContext::Serialise_Unmap(SerialiserType &ser, ID3D11Reso
     // while actively capturing, on large buffers being updated, try to locate the range of data
     // being
     // updated and update the diffStart/diffEnd/len variables
-    if(IsActiveCapturing(m_State) && len > 512 && intercept.MapType != D3D11_MAP_WRITE_DISCARD)
+    rdcarray<rdcpair<size_t, size_t>> diffRanges;
+
+    // discarded maps have no previous contents to diff against, but if the OS tracked page writes
+    // on our intercept allocation we can serialise just the written pages - the untouched remainder
+    // of a discarded buffer is undefined anyway. This matters for ring-buffer style usage where a
+    // large buffer is discarded many times per frame with only a small region written each time.
+    bool writeTracked = IsActiveCapturing(m_State) &&
+                        intercept.MapType == D3D11_MAP_WRITE_DISCARD &&
+                        record->IsShadowWriteTracked(ctxMapID);
+
+    if(IsActiveCapturing(m_State) && len > 512 &&
+       (intercept.MapType != D3D11_MAP_WRITE_DISCARD || writeTracked))
     {
-      size_t s = diffStart;
-      size_t e = diffEnd;
-      bool found = FindDiffRange(MapWrittenData, record->GetShadowPtr(ctxMapID, 1), len, s, e);
-      diffStart = (uint32_t)s;
-      diffEnd = (uint32_t)e;
+      bool found = false;
+
+      if(writeTracked)
+      {
+        // if the query fails we have to assume every byte was written
+        if(!WriteWatch::FetchAndReset(record->GetShadowPtr(ctxMapID, 0), len, diffRanges))
+        {
+          diffRanges.clear();
+          diffRanges.push_back(make_rdcpair((size_t)0, len));
+        }
+
+        found = !diffRanges.empty();
+      }
+      else
+      {
+        // the serialised data is one contiguous span, but the individual ranges let us update only
+        // the written parts of the shadow store below. Merge ranges with small gaps so scattered
+        // writes don't produce thousands of entries.
+        found =
+            FindDiffRanges(MapWrittenData, record->GetShadowPtr(ctxMapID, 1), len, 512, diffRanges);
+      }
+
+      if(found)
+      {
+        diffStart = (uint32_t)diffRanges.front().first;
+        diffEnd = (uint32_t)diffRanges.back().second;
+      }
+      else
+      {
+        diffStart = (uint32_t)len;
+        diffEnd = 0;
+      }
 
       // structured buffers must have copies aligned to their structure width, so we align down and
       // up the detected diff start/end region to match.
@@ -7829,7 +7877,18 @@ bool WrappedID3D11DeviceContext::Serialise_Unmap(SerialiserType &ser, ID3D11Reso
     // update shadow stores for future diff'ing
     if(IsActiveCapturing(m_State) && record->GetShadowPtr(ctxMapID, 1))
     {
-      memcpy(record->GetShadowPtr(ctxMapID, 1) + diffStart, MapWrittenData, diffEnd - diffStart);
+      if(!diffRanges.empty())
+      {
+        // only the differing ranges need copying - the bytes in between are identical by
+        // definition
+        for(const rdcpair<size_t, size_t> &r : diffRanges)
+          memcpy(record->GetShadowPtr(ctxMapID, 1) + r.first,
+                 (byte *)intercept.app.pData + r.first, r.second - r.first);
+      }
+      else
+      {
+        memcpy(record->GetShadowPtr(ctxMapID, 1) + diffStart, MapWrittenData, diffEnd - diffStart);
+      }
     }
   }    // if(ser.IsWriting())
 
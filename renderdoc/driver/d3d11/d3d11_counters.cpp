@@ -35,6 +35,8 @@
 
 rdcarray<GPUCounter> D3D11Replay::EnumerateCounters()
 {
+  InitIHVCounters();
+
   rdcarray<GPUCounter> ret;
 
   ret.push_back(GPUCounter::EventGPUDuration);
@@ -463,6 +465,8 @@ rdcarray<CounterResult> D3D11Replay::FetchCountersAMD(const rdcarray<GPUCounter>
 
   for(uint32_t p = 0; p < passCount; p++)
   {
+    RenderDoc::Inst().SetProgress(CounterProgress::FetchPass, float(p) / float(passCount));
+
     m_pAMDCounters->BeginPass();
     m_pAMDCounters->BeginCommandList();
     uint32_t eventStartID = 0;
@@ -476,6 +480,8 @@ rdcarray<CounterResult> D3D11Replay::FetchCountersAMD(const rdcarray<GPUCounter>
     m_pAMDCounters->EndPass();
   }
 
+  RenderDoc::Inst().SetProgress(CounterProgress::FetchPass, 1.0f);
+
   m_pAMDCounters->EndSesssion(sessionID);
 
   rdcarray<CounterResult> ret =
@@ -504,6 +510,8 @@ rdcarray<CounterResult> D3D11Replay::FetchCountersNV(const rdcarray<GPUCounter>
 
     for(uint32_t passIdx = 0; passIdx < passCount; ++passIdx)
     {
+      RenderDoc::Inst().SetProgress(CounterProgress::FetchPass, float(passIdx) / float(passCount));
+
       m_pNVCounters->BeginPass(passIdx);
 
       uint32_t eventStartID = 0;
@@ -515,6 +523,8 @@ rdcarray<CounterResult> D3D11Replay::FetchCountersNV(const rdcarray<GPUCounter>
       m_pNVCounters->EndPass(passIdx);
     }
 
+    RenderDoc::Inst().SetProgress(CounterProgress::FetchPass, 1.0f);
+
     m_pNVCounters->EndExperiment(eventIDs, ret);
   }
   return ret;
@@ -543,6 +553,8 @@ rdcarray<CounterResult> D3D11Replay::FetchCountersIntel(const rdcarray<GPUCounte
 
   for(uint32_t p = 0; p < passCount; p++)
   {
+    RenderDoc::Inst().SetProgress(CounterProgress::FetchPass, float(p) / float(passCount));
+
     m_pIntelCounters->BeginPass();
     uint32_t eventStartID = 0;
 
@@ -554,6 +566,8 @@ rdcarray<CounterResult> D3D11Replay::FetchCountersIntel(const rdcarray<GPUCounte
     m_pIntelCounters->EndPass();
   }
 
+  RenderDoc::Inst().SetProgress(CounterProgress::FetchPass, 1.0f);
+
   m_pIntelCounters->EndSession();
 
   return m_pIntelCounters->GetCounterData(eventIDs, counters);
@@ -69,8 +69,11 @@ WrappedID3D11Device::WrappedID3D11Device(ID3D11Device *realDevice, D3D11InitPara
 
   m_SectionVersion = D3D11InitParams::CurrentVersion;
 
-  uint32_t flags = WriteSerialiser::ChunkDuration | WriteSerialiser::ChunkTimestamp |
-                   WriteSerialiser::ChunkThreadID;
+  uint32_t flags = 0;
+
+  if(!RenderDoc::Inst().GetCaptureOptions().stripChunkMetadata)
+    flags = WriteSerialiser::ChunkDuration | WriteSerialiser::ChunkTimestamp |
+            WriteSerialiser::ChunkThreadID;
 
   if(RenderDoc::Inst().GetCaptureOptions().captureCallstacks)
     flags |= WriteSerialiser::ChunkCallstack;
@@ -1156,6 +1159,12 @@ bool WrappedID3D11Device::ProcessChunk(ReadSerialiser &ser, D3D11Chunk context)
     {
       return Serialise_InitialState(ser, ResourceId(), NULL, NULL);
     }
+    else if(system == SystemChunk::InitialContentsReference)
+    {
+      GetResourceManager()->CreateInitialContentsReference(ser);
+
+      SERIALISE_CHECK_READ_ERRORS();
+    }
     else if(system == SystemChunk::CaptureScope)
     {
       return Serialise_CaptureScope(ser);
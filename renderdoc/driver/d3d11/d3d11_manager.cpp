@@ -61,14 +61,19 @@ void D3D11ResourceManager::SetInternalResource(ID3D11DeviceChild *res)
 
 void D3D11ResourceManager::FreeCaptureData()
 {
-  for(auto it = m_ResourceRecords.begin(); it != m_ResourceRecords.end(); ++it)
+  for(RecordShard &shard : m_RecordShards)
   {
-    D3D11ResourceRecord *record = it->second;
+    SCOPED_LOCK(shard.lock);
 
-    if(record == NULL || m_Device->GetImmediateContext()->ShadowStorageInUse(record))
-      continue;
+    for(auto it = shard.records.begin(); it != shard.records.end(); ++it)
+    {
+      D3D11ResourceRecord *record = it->second;
 
-    record->FreeShadowStorage();
+      if(record == NULL || m_Device->GetImmediateContext()->ShadowStorageInUse(record))
+        continue;
+
+      record->FreeShadowStorage();
+    }
   }
 }
 
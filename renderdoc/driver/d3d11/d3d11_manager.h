@@ -123,6 +123,14 @@ struct D3D11ResourceRecord : public ResourceRecord
     return DeferredShadow[ctx - 1].ptr[p];
   }
 
+  bool IsShadowWriteTracked(size_t ctx)
+  {
+    if(ctx == 0)
+      return ImmediateShadow.tracked;
+
+    return DeferredShadow[ctx - 1].tracked;
+  }
+
   size_t GetContextID()
   {
     SCOPED_LOCK(DeferredShadowLock);
@@ -193,6 +201,7 @@ private:
     byte *ptr[2];
     size_t size;
     bool used;
+    bool tracked;
 
     void Alloc(size_t s)
     {
@@ -200,7 +209,14 @@ private:
       {
         size = s;
 
-        ptr[0] = AllocAlignedBuffer(size + sizeof(markerValue));
+        // the application writes into ptr[0], so if the OS can track page writes on our own
+        // allocations we use that for it - Unmap() can then serialise only the written pages of
+        // discarded maps instead of the whole buffer.
+        ptr[0] = WriteWatch::AllocTracked(size + sizeof(markerValue));
+        tracked = ptr[0] != NULL;
+
+        if(!tracked)
+          ptr[0] = AllocAlignedBuffer(size + sizeof(markerValue));
         ptr[1] = AllocAlignedBuffer(size + sizeof(markerValue));
 
         memcpy(ptr[0] + size, markerValue, sizeof(markerValue));
@@ -223,11 +239,15 @@ private:
     {
       if(ptr[0])
       {
-        FreeAlignedBuffer(ptr[0]);
+        if(tracked)
+          WriteWatch::FreeTracked(ptr[0]);
+        else
+          FreeAlignedBuffer(ptr[0]);
         FreeAlignedBuffer(ptr[1]);
       }
 
       ptr[0] = ptr[1] = NULL;
+      tracked = false;
     }
   };
 
@@ -2470,3 +2470,248 @@ rdcarray<PixelModification> D3D11Replay::PixelHistory(rdcarray<EventUsage> event
 
   return history;
 }
+
+rdcarray<rdcarray<PixelModification>> D3D11Replay::PixelHistoryRegion(
+    rdcarray<EventUsage> events, ResourceId target, uint32_t x, uint32_t y, uint32_t width,
+    uint32_t height, const Subresource &sub, CompType typeCast)
+{
+  rdcarray<rdcarray<PixelModification>> history;
+
+  if(width == 0 || height == 0)
+    return history;
+
+  if(events.empty() || (width == 1 && height == 1))
+    return StandardPixelHistoryRegion(this, events, target, x, y, width, height, sub, typeCast);
+
+  TextureShaderDetails details = GetDebugManager()->GetShaderDetails(target, typeCast, true);
+
+  if(details.texFmt == DXGI_FORMAT_UNKNOWN)
+    return history;
+
+  D3D11MarkerRegion regionMarker(StringFormat::Fmt(
+      "Doing PixelHistoryRegion on %s, (%u,%u) %ux%u over %u events", ToStr(target).c_str(), x, y,
+      width, height, (uint32_t)events.size()));
+
+  SCOPED_TIMER("D3D11DebugManager::PixelHistoryRegion");
+
+  uint32_t sampleIdx = sub.sample;
+
+  if(sampleIdx > details.sampleCount)
+    sampleIdx = 0;
+
+  uint32_t sampleMask = ~0U;
+  if(sampleIdx < 32)
+    sampleMask = 1U << sampleIdx;
+
+  // Before gathering each pixel's history we replay the frame once with an occlusion predicate
+  // around every draw, scissored to the whole region. A draw that doesn't rasterise anywhere in
+  // the region can't appear in the history of any pixel inside it, so the per-pixel gathers below
+  // only need to consider the events that survive. Direct writes (clears, copies, UAV writes)
+  // don't rasterise so they are always kept.
+
+  rdcarray<ID3D11Query *> occl;
+  occl.reserve(events.size());
+
+  const D3D11_QUERY_DESC occlDesc = {D3D11_QUERY_OCCLUSION_PREDICATE, 0};
+
+  bool allCreated = true;
+
+  for(size_t i = 0; i < events.size(); i++)
+  {
+    ID3D11Query *q = NULL;
+    m_pDevice->CreateQuery(&occlDesc, &q);
+    if(!q)
+      allCreated = false;
+    occl.push_back(q);
+  }
+
+  if(!allCreated)
+  {
+    RDCERR("Failed to create region occlusion queries");
+
+    for(size_t i = 0; i < occl.size(); i++)
+      SAFE_RELEASE(occl[i]);
+
+    // gather with the unculled event list instead
+    return StandardPixelHistoryRegion(this, events, target, x, y, width, height, sub, typeCast);
+  }
+
+  {
+    D3D11MarkerRegion pristine(
+        StringFormat::Fmt("Replaying up to first event %u for pristine start", events[0].eventId));
+    m_pDevice->ReplayLog(0, events[0].eventId, eReplay_WithoutDraw);
+  }
+
+  ID3D11RasterizerState *curRS = NULL;
+  ID3D11RasterizerState *newRS = NULL;
+  ID3D11PixelShader *curPS = NULL;
+  ID3D11ClassInstance *curInst[D3D11_SHADER_MAX_INTERFACES] = {NULL};
+  UINT curNumInst = 0;
+  UINT curNumViews = 0;
+  UINT curNumScissors = 0;
+  D3D11_VIEWPORT curViewports[16] = {0};
+  D3D11_RECT curScissors[16] = {0};
+  D3D11_RECT newScissors[16] = {0};
+  ID3D11BlendState *curBS = NULL;
+  float blendFactor[4] = {0};
+  UINT curSample = 0;
+  ID3D11DepthStencilState *curDS = NULL;
+  UINT stencilRef = 0;
+
+  for(size_t ev = 0; ev < events.size(); ev++)
+  {
+    curNumInst = D3D11_SHADER_MAX_INTERFACES;
+    curNumScissors = curNumViews = 16;
+
+    D3D11MarkerRegion evmarker(
+        StringFormat::Fmt("Region culling check for %u", events[ev].eventId));
+
+    bool uavOutput =
+        ((events[ev].usage >= ResourceUsage::VS_RWResource &&
+          events[ev].usage <= ResourceUsage::CS_RWResource) ||
+         events[ev].usage == ResourceUsage::CopyDst || events[ev].usage == ResourceUsage::Copy ||
+         events[ev].usage == ResourceUsage::Resolve ||
+         events[ev].usage == ResourceUsage::ResolveDst || events[ev].usage == ResourceUsage::GenMips);
+
+    m_pImmediateContext->RSGetState(&curRS);
+    m_pImmediateContext->OMGetBlendState(&curBS, blendFactor, &curSample);
+    m_pImmediateContext->OMGetDepthStencilState(&curDS, &stencilRef);
+    m_pImmediateContext->PSGetShader(&curPS, curInst, &curNumInst);
+    m_pImmediateContext->RSGetViewports(&curNumViews, curViewports);
+    m_pImmediateContext->RSGetScissorRects(&curNumScissors, curScissors);
+
+    // as in PixelHistory above, disable all tests/clips and enable scissor to clip visibility to
+    // just the region
+    D3D11_RASTERIZER_DESC rd = {
+        /*FillMode =*/D3D11_FILL_SOLID,
+        /*CullMode =*/D3D11_CULL_NONE,
+        /*FrontCounterClockwise =*/FALSE,
+        /*DepthBias =*/D3D11_DEFAULT_DEPTH_BIAS,
+        /*DepthBiasClamp =*/D3D11_DEFAULT_DEPTH_BIAS_CLAMP,
+        /*SlopeScaledDepthBias =*/D3D11_DEFAULT_SLOPE_SCALED_DEPTH_BIAS,
+        /*DepthClipEnable =*/FALSE,
+        /*ScissorEnable =*/TRUE,
+        /*MultisampleEnable =*/FALSE,
+        /*AntialiasedLineEnable =*/FALSE,
+    };
+
+    if(curRS)
+    {
+      curRS->GetDesc(&rd);
+
+      rd.CullMode = D3D11_CULL_NONE;
+      rd.DepthClipEnable = FALSE;
+      rd.ScissorEnable = TRUE;
+    }
+
+    m_pDevice->CreateRasterizerState(&rd, &newRS);
+    m_pImmediateContext->RSSetState(newRS);
+    SAFE_RELEASE(newRS);
+
+    m_pImmediateContext->PSSetShader(m_General.FixedColPS, NULL, 0);
+
+    m_pImmediateContext->OMSetBlendState(m_PixelHistory.NopBlendState, blendFactor, sampleMask);
+    m_pImmediateContext->OMSetDepthStencilState(m_PixelHistory.NopDepthState, stencilRef);
+
+    for(UINT i = 0; i < curNumViews; i++)
+    {
+      // calculate scissor, relative to this viewport, that encloses the intersection of the
+      // region and the viewport
+
+      LONG l = RDCMAX(LONG(x), LONG(curViewports[i].TopLeftX));
+      LONG t = RDCMAX(LONG(y), LONG(curViewports[i].TopLeftY));
+      LONG r = RDCMIN(LONG(x + width), LONG(curViewports[i].TopLeftX + curViewports[i].Width));
+      LONG b = RDCMIN(LONG(y + height), LONG(curViewports[i].TopLeftY + curViewports[i].Height));
+
+      // if the region doesn't intersect the viewport, make an empty rect
+      if(r <= l || b <= t)
+      {
+        newScissors[i].left = newScissors[i].top = newScissors[i].bottom = newScissors[i].right = 0;
+      }
+      else
+      {
+        newScissors[i].left = l;
+        newScissors[i].top = t;
+        newScissors[i].right = r;
+        newScissors[i].bottom = b;
+      }
+    }
+
+    m_pImmediateContext->RSSetScissorRects(curNumViews, newScissors);
+
+    m_pImmediateContext->Begin(occl[ev]);
+
+    if(!uavOutput)
+      m_pDevice->ReplayLog(0, events[ev].eventId, eReplay_OnlyDraw);
+
+    m_pImmediateContext->End(occl[ev]);
+
+    m_pImmediateContext->PSSetShader(curPS, curInst, curNumInst);
+    m_pImmediateContext->RSSetState(curRS);
+    m_pImmediateContext->RSSetScissorRects(curNumScissors, curScissors);
+    m_pImmediateContext->OMSetBlendState(curBS, blendFactor, curSample);
+    m_pImmediateContext->OMSetDepthStencilState(curDS, stencilRef);
+
+    for(UINT i = 0; i < curNumInst; i++)
+      SAFE_RELEASE(curInst[i]);
+
+    SAFE_RELEASE(curPS);
+    SAFE_RELEASE(curRS);
+    SAFE_RELEASE(curBS);
+    SAFE_RELEASE(curDS);
+
+    // replay the event as normal so that later events see its modifications
+    m_pDevice->ReplayLog(events[ev].eventId, events[ev].eventId, eReplay_OnlyDraw);
+
+    if(ev < events.size() - 1)
+    {
+      D3D11MarkerRegion continuation(
+          StringFormat::Fmt("Replaying partial continuation from %u to %u", events[ev].eventId + 1,
+                            events[ev + 1].eventId));
+      m_pDevice->ReplayLog(events[ev].eventId + 1, events[ev + 1].eventId, eReplay_WithoutDraw);
+    }
+  }
+
+  rdcarray<EventUsage> visibleEvents;
+  visibleEvents.reserve(events.size());
+
+  for(size_t i = 0; i < events.size(); i++)
+  {
+    BOOL occlData = 0;
+    HRESULT hr = S_OK;
+
+    do
+    {
+      hr = m_pImmediateContext->GetData(occl[i], &occlData, sizeof(occlData), 0);
+    } while(hr == S_FALSE);
+    RDCASSERTEQUAL(hr, S_OK);
+
+    const DrawcallDescription *draw = m_pDevice->GetDrawcall(events[i].eventId);
+
+    bool clear = bool(draw->flags & DrawFlags::Clear);
+
+    bool uavWrite =
+        ((events[i].usage >= ResourceUsage::VS_RWResource &&
+          events[i].usage <= ResourceUsage::CS_RWResource) ||
+         events[i].usage == ResourceUsage::CopyDst || events[i].usage == ResourceUsage::Copy ||
+         events[i].usage == ResourceUsage::Resolve ||
+         events[i].usage == ResourceUsage::ResolveDst || events[i].usage == ResourceUsage::GenMips);
+
+    if(occlData || clear || uavWrite)
+      visibleEvents.push_back(events[i]);
+
+    SAFE_RELEASE(occl[i]);
+  }
+
+  RDCDEBUG("Region culling pass kept %u of %u events", (uint32_t)visibleEvents.size(),
+           (uint32_t)events.size());
+
+  // gather each pixel's history over only the events that could touch the region
+  history.reserve(width * height);
+
+  for(uint32_t py = 0; py < height; py++)
+    for(uint32_t px = 0; px < width; px++)
+      history.push_back(PixelHistory(visibleEvents, target, x + px, y + py, sub, typeCast));
+
+  return history;
+}
@@ -344,14 +344,24 @@ void D3D11TextRenderer::SetOutputWindow(HWND w)
 
 void D3D11TextRenderer::RenderText(float x, float y, const rdcstr &text)
 {
-  rdcarray<rdcstr> lines;
-  split(text, lines, '\n');
-
-  for(const rdcstr &line : lines)
+  // FL9 can't carry a row per character in its vertex data, so its text still draws line by line.
+  // On FL10+ the shader positions each character from a column and row in the character data, so
+  // the whole block - newlines included - goes through as a single draw.
+  if(FL9Buffer)
   {
-    RenderTextInternal(x, y, line);
-    y += 1.0f;
+    rdcarray<rdcstr> lines;
+    split(text, lines, '\n');
+
+    for(const rdcstr &line : lines)
+    {
+      RenderTextInternal(x, y, line);
+      y += 1.0f;
+    }
+
+    return;
   }
+
+  RenderTextInternal(x, y, text);
 }
 
 void D3D11TextRenderer::RenderTextInternal(float x, float y, const rdcstr &text)
@@ -359,11 +369,30 @@ void D3D11TextRenderer::RenderTextInternal(float x, float y, const rdcstr &text)
   if(text.empty())
     return;
 
-  RDCASSERT(text.size() < FONT_MAX_CHARS);
-
   if(!VS || !PS)
     return;
 
+  // lay the text out as a glyph, column and row per character, consuming newlines
+  rdcarray<Vec4u> glyphs;
+  glyphs.reserve(text.size());
+
+  uint32_t col = 0, row = 0;
+
+  for(const char c : text)
+  {
+    if(c == '\n')
+    {
+      col = 0;
+      row++;
+      continue;
+    }
+
+    glyphs.push_back(Vec4u(uint32_t(c - ' '), col++, row, 0));
+  }
+
+  if(glyphs.empty())
+    return;
+
   FontCBuffer data = {};
 
   data.TextPosition.x = x;
@@ -397,45 +426,6 @@ void D3D11TextRenderer::RenderTextInternal(float x, float y, const rdcstr &text)
   // are we in fl9? need to upload the characters as floats into a VB instead of uints into a CB
   bool modern = (FL9Buffer == NULL);
 
-  if(modern)
-    hr = m_pImmediateContext->Map(CharBuffer, 0, D3D11_MAP_WRITE_DISCARD, 0, &mapped);
-  else
-    hr = m_pImmediateContext->Map(FL9Buffer, 0, D3D11_MAP_WRITE_DISCARD, 0, &mapped);
-
-  if(FAILED(hr))
-  {
-    RDCERR("Failed to map charbuffer HRESULT: %s", ToStr(hr).c_str());
-    return;
-  }
-
-  if(modern)
-  {
-    unsigned long *texs = (unsigned long *)mapped.pData;
-
-    for(size_t i = 0; i < text.size(); i++)
-      texs[i * 4] = (text[i] - ' ');
-  }
-  else
-  {
-    Vec4f *texs = (Vec4f *)mapped.pData;
-
-    for(size_t i = 0; i < text.size(); i++)
-    {
-      texs[i * 6 + 0] = Vec4f(quadPos[0].x, quadPos[0].y, float(i), float(text[i] - ' '));
-      texs[i * 6 + 1] = Vec4f(quadPos[1].x, quadPos[1].y, float(i), float(text[i] - ' '));
-      texs[i * 6 + 2] = Vec4f(quadPos[2].x, quadPos[2].y, float(i), float(text[i] - ' '));
-
-      texs[i * 6 + 3] = Vec4f(quadPos[1].x, quadPos[1].y, float(i), float(text[i] - ' '));
-      texs[i * 6 + 4] = Vec4f(quadPos[3].x, quadPos[3].y, float(i), float(text[i] - ' '));
-      texs[i * 6 + 5] = Vec4f(quadPos[2].x, quadPos[2].y, float(i), float(text[i] - ' '));
-    }
-  }
-
-  if(modern)
-    m_pImmediateContext->Unmap(CharBuffer, 0);
-  else
-    m_pImmediateContext->Unmap(FL9Buffer, 0);
-
   // can't just clear state because we need to keep things like render targets.
   {
     m_pImmediateContext->IASetPrimitiveTopology(modern ? D3D11_PRIMITIVE_TOPOLOGY_TRIANGLESTRIP
@@ -477,9 +467,61 @@ void D3D11TextRenderer::RenderTextInternal(float x, float y, const rdcstr &text)
     float factor[4] = {1.0f, 1.0f, 1.0f, 1.0f};
     m_pImmediateContext->OMSetBlendState(BlendState, factor, 0xffffffff);
 
-    if(modern)
-      m_pImmediateContext->DrawInstanced(4, (uint32_t)text.size(), 0, 0);
-    else
-      m_pImmediateContext->Draw(6 * (uint32_t)text.size(), 0);
+    // draw in chunks if the block is too long for one upload of character data
+    for(size_t start = 0; start < glyphs.size(); start += FONT_MAX_CHARS)
+    {
+      size_t chars = RDCMIN(glyphs.size() - start, (size_t)FONT_MAX_CHARS);
+
+      if(modern)
+        hr = m_pImmediateContext->Map(CharBuffer, 0, D3D11_MAP_WRITE_DISCARD, 0, &mapped);
+      else
+        hr = m_pImmediateContext->Map(FL9Buffer, 0, D3D11_MAP_WRITE_DISCARD, 0, &mapped);
+
+      if(FAILED(hr))
+      {
+        RDCERR("Failed to map charbuffer HRESULT: %s", ToStr(hr).c_str());
+        return;
+      }
+
+      if(modern)
+      {
+        unsigned long *texs = (unsigned long *)mapped.pData;
+
+        for(size_t i = 0; i < chars; i++)
+        {
+          texs[i * 4 + 0] = glyphs[start + i].x;
+          texs[i * 4 + 1] = glyphs[start + i].y;
+          texs[i * 4 + 2] = glyphs[start + i].z;
+        }
+      }
+      else
+      {
+        Vec4f *texs = (Vec4f *)mapped.pData;
+
+        for(size_t i = 0; i < chars; i++)
+        {
+          float glyphcol = float(glyphs[start + i].y);
+          float glyphidx = float(glyphs[start + i].x);
+
+          texs[i * 6 + 0] = Vec4f(quadPos[0].x, quadPos[0].y, glyphcol, glyphidx);
+          texs[i * 6 + 1] = Vec4f(quadPos[1].x, quadPos[1].y, glyphcol, glyphidx);
+          texs[i * 6 + 2] = Vec4f(quadPos[2].x, quadPos[2].y, glyphcol, glyphidx);
+
+          texs[i * 6 + 3] = Vec4f(quadPos[1].x, quadPos[1].y, glyphcol, glyphidx);
+          texs[i * 6 + 4] = Vec4f(quadPos[3].x, quadPos[3].y, glyphcol, glyphidx);
+          texs[i * 6 + 5] = Vec4f(quadPos[2].x, quadPos[2].y, glyphcol, glyphidx);
+        }
+      }
+
+      if(modern)
+        m_pImmediateContext->Unmap(CharBuffer, 0);
+      else
+        m_pImmediateContext->Unmap(FL9Buffer, 0);
+
+      if(modern)
+        m_pImmediateContext->DrawInstanced(4, (uint32_t)chars, 0, 0);
+      else
+        m_pImmediateContext->Draw(6 * (uint32_t)chars, 0);
+    }
   }
 }
@@ -174,6 +174,18 @@ void D3D11Replay::CreateResources(IDXGIFactory *factory)
 
   m_pDevice->GetShaderCache()->SetCaching(false);
 
+  RenderDoc::Inst().SetProgress(LoadProgress::DebugManagerInit, 1.0f);
+}
+
+void D3D11Replay::InitIHVCounters()
+{
+  // only try once, and only after the UI first asks for counters - GPUPerfAPI and friends can take
+  // seconds to load and initialise, which we don't want to pay on every capture open.
+  if(m_IHVCountersTried)
+    return;
+
+  m_IHVCountersTried = true;
+
   if(!m_Proxy && D3D11_HardwareCounters)
   {
     AMDCounters *countersAMD = NULL;
@@ -231,10 +243,7 @@ void D3D11Replay::CreateResources(IDXGIFactory *factory)
       delete countersIntel;
       m_pIntelCounters = NULL;
     }
-  }
-
-  RenderDoc::Inst().SetProgress(LoadProgress::DebugManagerInit, 1.0f);
-}
+  }}
 
 void D3D11Replay::DestroyResources()
 {
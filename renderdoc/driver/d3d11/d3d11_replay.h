@@ -111,6 +111,7 @@ public:
 
   void CreateResources(IDXGIFactory *factory);
   void DestroyResources();
+  void InitIHVCounters();
 
   DriverInformation GetDriverInfo() { return m_DriverInfo; }
   rdcarray<GPUDevice> GetAvailableGPUs();
@@ -231,9 +232,15 @@ public:
 
   rdcarray<PixelModification> PixelHistory(rdcarray<EventUsage> events, ResourceId target, uint32_t x,
                                            uint32_t y, const Subresource &sub, CompType typeCast);
+  rdcarray<rdcarray<PixelModification>> PixelHistoryRegion(rdcarray<EventUsage> events,
+                                                           ResourceId target, uint32_t x, uint32_t y,
+                                                           uint32_t width, uint32_t height,
+                                                           const Subresource &sub, CompType typeCast);
   ShaderDebugTrace *DebugVertex(uint32_t eventId, uint32_t vertid, uint32_t instid, uint32_t idx);
   ShaderDebugTrace *DebugPixel(uint32_t eventId, uint32_t x, uint32_t y, uint32_t sample,
                                uint32_t primitive);
+  rdcarray<ShaderDebugTrace *> DebugPixels(uint32_t eventId,
+                                           const rdcarray<PixelDebugTarget> &targets);
   ShaderDebugTrace *DebugThread(uint32_t eventId, const uint32_t groupid[3],
                                 const uint32_t threadid[3]);
   rdcarray<ShaderDebugState> ContinueDebug(ShaderDebugger *debugger);
@@ -327,6 +334,9 @@ private:
   NVCounters *m_pNVCounters = NULL;
   IntelCounters *m_pIntelCounters = NULL;
 
+  // IHV counter libraries are loaded lazily on the first counter enumeration, not at replay init
+  bool m_IHVCountersTried = false;
+
   WrappedID3D11Device *m_pDevice = NULL;
   WrappedID3D11DeviceContext *m_pImmediateContext = NULL;
 
@@ -184,7 +184,21 @@ void WrappedShader::ShaderEntry::BuildReflection()
       D3Dx_IA_VERTEX_INPUT_RESOURCE_SLOT_COUNT == D3D11_IA_VERTEX_INPUT_RESOURCE_SLOT_COUNT,
       "Mismatched vertex input count");
 
+  // substitute any unstripped bytecode before hashing, so cached reflection matches what we'd get
+  // by parsing (including any source files from debug info).
+  TryReplaceOriginalByteCode();
+
+  if(TryFetchCachedShaderReflection(m_Bytecode.data(), m_Bytecode.size(), &m_Details, &m_Mapping))
+  {
+    m_Details.resourceId = m_ID;
+    return;
+  }
+
+  if(GetDXBC() == NULL)
+    return;
+
   MakeShaderReflection(m_DXBCFile, &m_Details, &m_Mapping);
+  CacheShaderReflection(m_Bytecode.data(), m_Bytecode.size(), m_Details, m_Mapping);
   m_Details.resourceId = m_ID;
 }
 
@@ -26,9 +26,14 @@
 #include <algorithm>
 #include "driver/dxgi/dxgi_common.h"
 #include "driver/ihv/amd/official/DXExt/AmdExtD3DCommandListMarkerApi.h"
+#include "core/settings.h"
 #include "d3d12_command_queue.h"
 #include "d3d12_debug.h"
 
+RDOC_DEBUG_CONFIG(bool, D3D12_Debug_DisableRerecordCaching, false,
+                  "Disable caching and re-use of fully re-recorded command lists between replays, "
+                  "re-recording every command list from scratch on each replay.");
+
 ID3D12GraphicsCommandList *WrappedID3D12GraphicsCommandList::GetCrackedList()
 {
   return Unwrap(m_Cmd->m_BakedCmdListInfo[m_Cmd->m_LastCmdListID].crackedLists.back());
@@ -109,6 +114,17 @@ bool WrappedID3D12GraphicsCommandList::Serialise_Close(SerialiserType &ser)
 
         list->Close();
 
+        // now that the recording has completed it's safe to re-use on subsequent replays, so move
+        // it from the per-replay list into the cache.
+        if(m_Cmd->m_RerecordCachePending == BakedCommandList && !m_Cmd->m_RerecordCmdList.empty() &&
+           m_Cmd->m_RerecordCmdList.back() == list)
+        {
+          m_Cmd->m_RerecordCachedCmds[BakedCommandList] = m_Cmd->m_RerecordCmdList.back();
+          m_Cmd->m_RerecordCmdList.pop_back();
+        }
+
+        m_Cmd->m_RerecordCachePending = ResourceId();
+
         if(m_Cmd->m_Partial[D3D12CommandData::Primary].partialParent == CommandList)
           m_Cmd->m_Partial[D3D12CommandData::Primary].partialParent = ResourceId();
       }
@@ -254,7 +270,47 @@ bool WrappedID3D12GraphicsCommandList::Serialise_Reset(SerialiserType &ser,
         }
       }
 
-      if(rerecord)
+      // command lists that are completely contained within the replayed range re-record
+      // identically on every replay, so we cache them across replays and when we see one again we
+      // re-use it and skip over its serialised commands entirely. We can't re-use recordings
+      // while a drawcall callback is registered since callbacks modify the commands as they're
+      // recorded, nor for lists containing indirect executes which are patched per-replay.
+      bool cacheable = rerecord && !partial && m_Cmd->m_DrawcallCallback == NULL &&
+                       !D3D12_Debug_DisableRerecordCaching &&
+                       m_Cmd->m_BakedCmdListInfo[BakedCommandList].postEndChunkOffset > 0 &&
+                       m_Cmd->m_BakedCmdListInfo[BakedCommandList].executeEvents.empty();
+
+      // better still, if no resources are currently replaced the baked command list recorded
+      // while loading can be executed again verbatim - then even the first replay after a load
+      // doesn't need to re-record it.
+      bool reusable = cacheable && !GetResourceManager()->HasReplacements() &&
+                      GetResourceManager()->HasLiveResource(BakedCommandList);
+
+      auto cachedIt = cacheable ? m_Cmd->m_RerecordCachedCmds.find(BakedCommandList)
+                                : m_Cmd->m_RerecordCachedCmds.end();
+
+      if(reusable || (cacheable && cachedIt != m_Cmd->m_RerecordCachedCmds.end()))
+      {
+        ID3D12GraphicsCommandListX *list =
+            reusable
+                ? GetResourceManager()->GetLiveAs<WrappedID3D12GraphicsCommandList>(BakedCommandList)
+                : cachedIt->second;
+
+#if ENABLED(VERBOSE_PARTIAL_REPLAY)
+        RDCDEBUG("Reset() - re-using %s of %s -> %s",
+                 reusable ? "baked command list" : "cached re-recording",
+                 ToStr(CommandList).c_str(), ToStr(BakedCommandList).c_str());
+#endif
+
+        // store under both baked and non baked ID, see below for reasoning
+        m_Cmd->m_RerecordCmds[BakedCommandList] = list;
+        m_Cmd->m_RerecordCmds[CommandList] = list;
+
+        // nothing needs re-recording, so tell the replay loop to jump the reader past all of this
+        // command list's chunks, including the Close().
+        m_Cmd->m_RerecordSkipOffset = m_Cmd->m_BakedCmdListInfo[BakedCommandList].postEndChunkOffset;
+      }
+      else if(rerecord)
       {
         ID3D12GraphicsCommandList *listptr = NULL;
         HRESULT hr =
@@ -284,6 +340,11 @@ bool WrappedID3D12GraphicsCommandList::Serialise_Reset(SerialiserType &ser,
 
         m_Cmd->m_RerecordCmdList.push_back(list);
 
+        // if this recording can be re-used on subsequent replays, remember it. Once the recording
+        // completes in Close() it moves from the per-replay list above into the cache.
+        if(cacheable)
+          m_Cmd->m_RerecordCachePending = BakedCommandList;
+
         if(m_Cmd->IsPartialCmdList(m_Cmd->m_LastCmdListID))
           m_Cmd->m_RenderState.pipe = GetResID(pInitialState);
       }
@@ -3459,13 +3520,19 @@ void WrappedID3D12GraphicsCommandList::PatchExecuteIndirect(BakedCmdListInfo &in
 
   WrappedID3D12CommandSignature *comSig = exec.sig;
 
+  D3D12_RANGE range = {0, D3D12CommandData::m_IndirectSize};
+  byte *mapPtr = NULL;
+  exec.argBuf->Map(0, &range, (void **)&mapPtr);
+
   uint32_t count = exec.maxCount;
 
   if(exec.countBuf)
   {
-    bytebuf data;
-    m_pDevice->GetDebugManager()->GetBufferData(exec.countBuf, exec.countOffs, 4, data);
-    count = RDCMIN(count, *(uint32_t *)&data[0]);
+    // the count was copied in-stream just after the arguments in the same CPU-mappable buffer, so
+    // read it from the map rather than doing a GPU readback per execute.
+    uint32_t bufCount =
+        *(uint32_t *)(mapPtr + exec.argOffs + comSig->sig.ByteStride * exec.maxCount);
+    count = RDCMIN(count, bufCount);
   }
 
   exec.realCount = count;
@@ -3477,10 +3544,6 @@ void WrappedID3D12GraphicsCommandList::PatchExecuteIndirect(BakedCmdListInfo &in
   // + 1 is because baseEvent refers to the marker before the commands
   exec.lastEvent = exec.baseEvent + 1 + sigSize * count;
 
-  D3D12_RANGE range = {0, D3D12CommandData::m_IndirectSize};
-  byte *mapPtr = NULL;
-  exec.argBuf->Map(0, &range, (void **)&mapPtr);
-
   rdcarray<D3D12DrawcallTreeNode> &draws = info.draw->children;
 
   size_t idx = 0;
@@ -4271,8 +4334,11 @@ bool WrappedID3D12GraphicsCommandList::Serialise_ExecuteIndirect(
       exec.countBuf = pCountBuffer;
       exec.countOffs = CountBufferOffset;
 
-      // allocate space for patched indirect buffer
-      m_Cmd->GetIndirectBuffer(comSig->sig.ByteStride * MaxCommandCount, &exec.argBuf, &exec.argOffs);
+      // allocate space for patched indirect buffer, plus room for the count to be copied after the
+      // arguments so PatchExecuteIndirect can read everything from the one mapped buffer
+      m_Cmd->GetIndirectBuffer(
+          comSig->sig.ByteStride * MaxCommandCount + (pCountBuffer ? 16 : 0), &exec.argBuf,
+          &exec.argOffs);
 
       // transition buffer to COPY_SOURCE/COPY_DEST, copy, and back to INDIRECT_ARG
       D3D12_RESOURCE_BARRIER barriers[2] = {};
@@ -4294,6 +4360,35 @@ bool WrappedID3D12GraphicsCommandList::Serialise_ExecuteIndirect(
       cracked->CopyBufferRegion(Unwrap(exec.argBuf), exec.argOffs, Unwrap(pArgumentBuffer),
                                 ArgumentBufferOffset, comSig->sig.ByteStride * MaxCommandCount);
 
+      if(pCountBuffer)
+      {
+        // snapshot the count after the arguments, so it can be read from the same mapped buffer
+        // later instead of being read back from the GPU per execute.
+        D3D12_RESOURCE_BARRIER countBarrier = {};
+        countBarrier.Transition.pResource = Unwrap(pCountBuffer);
+        countBarrier.Transition.StateBefore = D3D12_RESOURCE_STATE_INDIRECT_ARGUMENT;
+        countBarrier.Transition.StateAfter = D3D12_RESOURCE_STATE_COPY_SOURCE;
+
+        // no barrier needed if this is the argument buffer (transitioned above), or it's already
+        // in a state including COPY_SOURCE
+        bool countBarrierNeeded = pCountBuffer != pArgumentBuffer &&
+                                  !(m_pDevice->GetSubresourceStates(GetResID(pCountBuffer))[0] &
+                                    D3D12_RESOURCE_STATE_COPY_SOURCE);
+
+        if(countBarrierNeeded)
+          cracked->ResourceBarrier(1, &countBarrier);
+
+        cracked->CopyBufferRegion(Unwrap(exec.argBuf),
+                                  exec.argOffs + comSig->sig.ByteStride * MaxCommandCount,
+                                  Unwrap(pCountBuffer), CountBufferOffset, 4);
+
+        if(countBarrierNeeded)
+        {
+          std::swap(countBarrier.Transition.StateBefore, countBarrier.Transition.StateAfter);
+          cracked->ResourceBarrier(1, &countBarrier);
+        }
+      }
+
       std::swap(barriers[0].Transition.StateBefore, barriers[0].Transition.StateAfter);
       std::swap(barriers[1].Transition.StateBefore, barriers[1].Transition.StateAfter);
       cracked->ResourceBarrier(barrierCount, barriers);
@@ -160,7 +160,13 @@ public:
                          bool partial);
   void SetFrameReader(StreamReader *reader) { m_FrameReader = reader; }
   D3D12CommandData *GetCommandData() { return &m_Cmd; }
-  const rdcarray<EventUsage> &GetUsage(ResourceId id) { return m_Cmd.m_ResourceUses[id]; }
+  const rdcarray<EventUsage> &GetUsage(ResourceId id)
+  {
+    auto it = m_Cmd.m_ResourceUses.find(id);
+    if(it == m_Cmd.m_ResourceUses.end())
+      return m_Cmd.m_EmptyUses;
+    return it->second;
+  }
   // interface for DXGI
   virtual IUnknown *GetRealIUnknown() { return GetReal(); }
   virtual IID GetBackbufferUUID() { return __uuidof(ID3D12Resource); }
@@ -383,6 +383,8 @@ WrappedID3D12CommandQueue::~WrappedID3D12CommandQueue()
   for(size_t i = 0; i < m_Cmd.m_IndirectBuffers.size(); i++)
     SAFE_RELEASE(m_Cmd.m_IndirectBuffers[i]);
 
+  m_Cmd.FreeRerecordCache();
+
   SAFE_RELEASE(m_WrappedDebug.m_pReal);
   SAFE_RELEASE(m_pReal);
 }
@@ -941,6 +943,23 @@ ReplayStatus WrappedID3D12CommandQueue::ReplayLog(CaptureState readType, uint32_
     if(!success)
       return m_FailedReplayStatus;
 
+    if(IsLoading(m_State))
+    {
+      // record where each baked command list's serialised commands end, so that during active
+      // replay we can jump over all of them when re-using a cached re-recording.
+      if(context == D3D12Chunk::List_Close && m_Cmd.m_LastCmdListID != ResourceId())
+        m_Cmd.m_BakedCmdListInfo[m_Cmd.m_LastCmdListID].postEndChunkOffset =
+            ser.GetReader()->GetOffset();
+    }
+    else if(m_Cmd.m_RerecordSkipOffset > 0)
+    {
+      // the Reset() chunk re-used a cached re-recording of its command list, so there's nothing
+      // to do for any of its commands - skip the reader past the whole range, including the
+      // Close() chunk.
+      ser.GetReader()->SetOffset(m_Cmd.m_RerecordSkipOffset);
+      m_Cmd.m_RerecordSkipOffset = 0;
+    }
+
     RenderDoc::Inst().SetProgress(
         LoadProgress::FrameEventsRead,
         float(m_Cmd.m_CurChunkOffset - startOffset) / float(ser.GetReader()->GetSize()));
@@ -984,6 +1003,11 @@ ReplayStatus WrappedID3D12CommandQueue::ReplayLog(CaptureState readType, uint32_
   m_Cmd.m_RerecordCmds.clear();
   m_Cmd.m_RerecordCmdList.clear();
 
+  // these should only persist within a replay - if a cacheable command list's recording never
+  // completed we mustn't mistake a future replay's recording for it.
+  m_Cmd.m_RerecordCachePending = ResourceId();
+  m_Cmd.m_RerecordSkipOffset = 0;
+
   return ReplayStatus::Succeeded;
 }
 
@@ -1499,6 +1523,14 @@ ID3D12GraphicsCommandListX *D3D12CommandData::RerecordCmdList(ResourceId cmdid,
   return it->second;
 }
 
+void D3D12CommandData::FreeRerecordCache()
+{
+  for(auto it = m_RerecordCachedCmds.begin(); it != m_RerecordCachedCmds.end(); ++it)
+    SAFE_RELEASE(it->second);
+
+  m_RerecordCachedCmds.clear();
+}
+
 bool D3D12CommandData::HasNonMarkerEvents(ResourceId cmdBuffer)
 {
   for(const APIEvent &ev : m_BakedCmdListInfo[cmdBuffer].curEvents)
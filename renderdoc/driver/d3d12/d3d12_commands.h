@@ -94,7 +94,9 @@ struct D3D12DrawcallTreeNode
     ret.resize(children.size());
     for(size_t i = 0; i < children.size(); i++)
     {
-      ret[i] = children[i].draw;
+      // this node tree is cleared once it's been baked, so the draws can be moved instead of
+      // copied - copying duplicates every draw's name and child array just to free them again
+      ret[i] = std::move(children[i].draw);
       ret[i].children = children[i].Bake();
     }
 
@@ -213,6 +215,11 @@ struct BakedCmdListInfo
   uint32_t beginChunk = 0;
   uint32_t endChunk = 0;
 
+  // the file offset just after this command list's Close() chunk, recorded while loading. During
+  // active replay we skip the reader straight to this offset when re-using a cached re-recording,
+  // since none of the commands need to be processed.
+  uint64_t postEndChunkOffset = 0;
+
   D3D12DrawcallTreeNode *draw = NULL;    // the root draw to copy from when submitting
   uint32_t eventCount;                   // how many events are in this cmd list, for quick skipping
   uint32_t curEventID;                   // current event ID while reading or executing
@@ -329,6 +336,23 @@ struct D3D12CommandData
   std::map<ResourceId, ID3D12GraphicsCommandListX *> m_RerecordCmds;
   rdcarray<ID3D12GraphicsCommandListX *> m_RerecordCmdList;
 
+  // command lists that are completely within the replayed range (i.e. not the partial one being
+  // truncated) re-record identically on every replay, so we keep them here across replays instead
+  // of re-recording them from the serialised commands each time we scrub. Keyed by bake ID. The
+  // cache is flushed whenever resource replacements change, since the recorded commands bake in
+  // the current pipelines.
+  std::map<ResourceId, ID3D12GraphicsCommandListX *> m_RerecordCachedCmds;
+
+  // the bake ID of a cacheable command list that's currently re-recording. It only moves into the
+  // cache above once its Close() completes the recording.
+  ResourceId m_RerecordCachePending;
+
+  // when non-zero, the replay loop skips the reader ahead to this offset after the current chunk.
+  // Set when re-using a cached re-recording, to jump over the command list's serialised commands.
+  uint64_t m_RerecordSkipOffset = 0;
+
+  void FreeRerecordCache();
+
   bool m_AddedDrawcall;
 
   rdcarray<APIEvent> m_RootEvents, m_Events;
@@ -344,6 +368,8 @@ struct D3D12CommandData
   SDFile *m_StructuredFile;
 
   std::map<ResourceId, rdcarray<EventUsage> > m_ResourceUses;
+  // returned by reference for lookups of resources with no usage
+  rdcarray<EventUsage> m_EmptyUses;
 
   D3D12DrawcallTreeNode m_ParentDrawcall;
 
@@ -215,6 +215,11 @@ bool D3D12InitParams::IsSupportedVersion(uint64_t ver)
   if(ver == 0x7)
     return true;
 
+  // 0x8 -> 0x9 - descriptor heap initial contents only serialise descriptors that have been
+  //              written, as heap index + descriptor pairs
+  if(ver == 0x8)
+    return true;
+
   return false;
 }
 
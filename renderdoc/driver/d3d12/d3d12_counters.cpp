@@ -33,6 +33,8 @@
 
 rdcarray<GPUCounter> D3D12Replay::EnumerateCounters()
 {
+  InitIHVCounters();
+
   rdcarray<GPUCounter> ret;
 
   ret.push_back(GPUCounter::EventGPUDuration);
@@ -313,6 +315,8 @@ rdcarray<CounterResult> D3D12Replay::FetchCountersAMD(const rdcarray<GPUCounter>
 
   for(uint32_t i = 0; i < passCount; i++)
   {
+    RenderDoc::Inst().SetProgress(CounterProgress::FetchPass, float(i) / float(passCount));
+
     m_pAMDCounters->BeginPass();
 
     uint32_t eventStartID = 0;
@@ -326,6 +330,8 @@ rdcarray<CounterResult> D3D12Replay::FetchCountersAMD(const rdcarray<GPUCounter>
     m_pAMDCounters->EndPass();
   }
 
+  RenderDoc::Inst().SetProgress(CounterProgress::FetchPass, 1.0f);
+
   m_pAMDCounters->EndSesssion(sessionID);
 
   rdcarray<CounterResult> ret =
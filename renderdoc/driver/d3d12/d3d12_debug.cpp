@@ -368,6 +368,36 @@ D3D12DebugManager::D3D12DebugManager(WrappedID3D12Device *wrapper)
 
   if(m_DebugList)
     m_DebugList->Close();
+
+  hr = m_pDevice->CreateFence(0, D3D12_FENCE_FLAG_NONE, __uuidof(ID3D12Fence),
+                              (void **)&m_ReadbackFence);
+  m_pDevice->InternalRef();
+
+  if(FAILED(hr))
+  {
+    RDCERR("Failed to create readback fence, HRESULT: %s", ToStr(hr).c_str());
+    return;
+  }
+
+  rm->SetInternalResource(m_ReadbackFence);
+
+  m_ReadbackFenceHandle = ::CreateEvent(NULL, FALSE, FALSE, NULL);
+
+  for(size_t i = 0; i < ARRAY_COUNT(m_ReadbackAlloc); i++)
+  {
+    hr = m_pDevice->CreateCommandAllocator(D3D12_COMMAND_LIST_TYPE_DIRECT,
+                                           __uuidof(ID3D12CommandAllocator),
+                                           (void **)&m_ReadbackAlloc[i]);
+    m_pDevice->InternalRef();
+
+    if(FAILED(hr))
+    {
+      RDCERR("Failed to create readback command allocator, HRESULT: %s", ToStr(hr).c_str());
+      return;
+    }
+
+    rm->SetInternalResource(m_ReadbackAlloc[i]);
+  }
 }
 
 D3D12DebugManager::~D3D12DebugManager()
@@ -376,6 +406,9 @@ D3D12DebugManager::~D3D12DebugManager()
     for(size_t p = 0; p < MeshDisplayPipelines::ePipe_Count; p++)
       SAFE_RELEASE(it->second.pipes[p]);
 
+  for(auto it = m_ArrayMSAAPipes.begin(); it != m_ArrayMSAAPipes.end(); ++it)
+    SAFE_RELEASE(it->second);
+
   SAFE_RELEASE(dsvHeap);
   SAFE_RELEASE(rtvHeap);
   SAFE_RELEASE(cbvsrvuavHeap);
@@ -404,6 +437,12 @@ D3D12DebugManager::~D3D12DebugManager()
 
   SAFE_RELEASE(m_ReadbackBuffer);
 
+  SAFE_RELEASE(m_ReadbackFence);
+  if(m_ReadbackFenceHandle)
+    CloseHandle(m_ReadbackFenceHandle);
+  for(size_t i = 0; i < ARRAY_COUNT(m_ReadbackAlloc); i++)
+    SAFE_RELEASE(m_ReadbackAlloc[i]);
+
   SAFE_RELEASE(m_RingConstantBuffer);
 
   SAFE_RELEASE(m_TexResource);
@@ -866,7 +905,7 @@ void D3D12DebugManager::GetBufferData(ID3D12Resource *buffer, uint64_t offset, u
     return;
   }
 
-  m_DebugList->Reset(m_DebugAlloc, NULL);
+  m_DebugList->Reset(m_ReadbackAlloc[0], NULL);
 
   D3D12_RESOURCE_BARRIER barrier = {};
 
@@ -877,57 +916,107 @@ void D3D12DebugManager::GetBufferData(ID3D12Resource *buffer, uint64_t offset, u
   if(barrier.Transition.StateBefore != D3D12_RESOURCE_STATE_COPY_SOURCE)
     m_DebugList->ResourceBarrier(1, &barrier);
 
+  // map the readback buffer once up-front instead of mapping and unmapping around every chunk.
+  // Readback heaps can legally stay mapped while the GPU writes to them - the fence wait in the
+  // loop is what makes each chunk's data visible before we read it.
+  D3D12_RANGE mapRange = {0, (size_t)RDCMIN(length, m_ReadbackSize)};
+
+  void *data = NULL;
+  HRESULT hr = m_ReadbackBuffer->Map(0, &mapRange, &data);
+
+  if(FAILED(hr))
+  {
+    RDCERR("Failed to map bufferdata buffer HRESULT: %s", ToStr(hr).c_str());
+    return;
+  }
+
+  // double-buffer the chunked readback: while the GPU copies chunk N into one half of the
+  // readback buffer, we read chunk N-1 out of the other half. Each chunk signals its own fence
+  // value, so we only wait for the chunk we want to read rather than for the GPU to drain.
+  const uint64_t windowSize = m_ReadbackSize / 2;
+
+  uint32_t chunkIdx = 0;
+
+  uint64_t prevChunkSize = 0;
+  uint64_t prevOutOffs = 0;
+
   while(length > 0)
   {
-    uint64_t chunkSize = RDCMIN(length, m_ReadbackSize);
+    uint64_t chunkSize = RDCMIN(length, windowSize);
+    uint64_t windowOffset = (chunkIdx & 1) * windowSize;
 
-    m_DebugList->CopyBufferRegion(m_ReadbackBuffer, 0, buffer, offset + outOffs, chunkSize);
+    if(chunkIdx > 0)
+    {
+      // this allocator's previous chunk finished before the last chunk we waited on below, so
+      // it's safe to reset
+      if(chunkIdx > 1)
+        m_ReadbackAlloc[chunkIdx & 1]->Reset();
+
+      m_DebugList->Reset(m_ReadbackAlloc[chunkIdx & 1], NULL);
+    }
+
+    m_DebugList->CopyBufferRegion(m_ReadbackBuffer, windowOffset, buffer, offset + outOffs,
+                                  chunkSize);
 
     m_DebugList->Close();
 
     ID3D12CommandList *l = m_DebugList;
     m_pDevice->GetQueue()->ExecuteCommandLists(1, &l);
-    m_pDevice->GPUSync();
-    m_DebugAlloc->Reset();
 
-    D3D12_RANGE range = {0, (size_t)chunkSize};
+    m_ReadbackFenceCounter++;
+    m_pDevice->GetQueue()->Signal(m_ReadbackFence, m_ReadbackFenceCounter);
 
-    void *data = NULL;
-    HRESULT hr = m_ReadbackBuffer->Map(0, &range, &data);
-
-    if(FAILED(hr))
+    // with this chunk's copy in flight, read back the previous chunk from the other half
+    if(chunkIdx > 0)
     {
-      RDCERR("Failed to map bufferdata buffer HRESULT: %s", ToStr(hr).c_str());
-      return;
-    }
-    else
-    {
-      memcpy(&ret[(size_t)outOffs], data, (size_t)chunkSize);
-
-      range.End = 0;
+      if(m_ReadbackFence->GetCompletedValue() < m_ReadbackFenceCounter - 1)
+      {
+        m_ReadbackFence->SetEventOnCompletion(m_ReadbackFenceCounter - 1, m_ReadbackFenceHandle);
+        WaitForSingleObject(m_ReadbackFenceHandle, 10000);
+      }
 
-      m_ReadbackBuffer->Unmap(0, &range);
+      memcpy(&ret[(size_t)prevOutOffs], (byte *)data + ((chunkIdx - 1) & 1) * windowSize,
+             (size_t)prevChunkSize);
     }
 
+    prevChunkSize = chunkSize;
+    prevOutOffs = outOffs;
+
     outOffs += chunkSize;
     length -= chunkSize;
+    chunkIdx++;
+  }
 
-    m_DebugList->Reset(m_DebugAlloc, NULL);
+  // the last chunk is still in flight - wait for it and read it back
+  if(m_ReadbackFence->GetCompletedValue() < m_ReadbackFenceCounter)
+  {
+    m_ReadbackFence->SetEventOnCompletion(m_ReadbackFenceCounter, m_ReadbackFenceHandle);
+    WaitForSingleObject(m_ReadbackFenceHandle, 10000);
   }
 
+  memcpy(&ret[(size_t)prevOutOffs], (byte *)data + ((chunkIdx - 1) & 1) * windowSize,
+         (size_t)prevChunkSize);
+
+  D3D12_RANGE empty = {0, 0};
+  m_ReadbackBuffer->Unmap(0, &empty);
+
+  // all the chunk copies have completed, so the allocators are free to reset
+  for(size_t i = 0; i < ARRAY_COUNT(m_ReadbackAlloc); i++)
+    m_ReadbackAlloc[i]->Reset();
+
   if(barrier.Transition.StateBefore != D3D12_RESOURCE_STATE_COPY_SOURCE)
   {
     std::swap(barrier.Transition.StateBefore, barrier.Transition.StateAfter);
 
+    m_DebugList->Reset(m_DebugAlloc, NULL);
     m_DebugList->ResourceBarrier(1, &barrier);
-  }
-
-  m_DebugList->Close();
+    m_DebugList->Close();
 
-  ID3D12CommandList *l = m_DebugList;
-  m_pDevice->GetQueue()->ExecuteCommandLists(1, &l);
-  m_pDevice->GPUSync();
-  m_DebugAlloc->Reset();
+    ID3D12CommandList *l = m_DebugList;
+    m_pDevice->GetQueue()->ExecuteCommandLists(1, &l);
+    m_pDevice->GPUSync();
+    m_DebugAlloc->Reset();
+  }
 }
 
 void D3D12Replay::GeneralMisc::Init(WrappedID3D12Device *device, D3D12DebugManager *debug)
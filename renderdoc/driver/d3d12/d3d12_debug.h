@@ -202,6 +202,13 @@ private:
 
   ID3D12Resource *m_ReadbackBuffer = NULL;
 
+  // fence and per-half allocators for double-buffering the chunked readback in GetBufferData,
+  // so each chunk only waits on its own copy rather than a full GPUSync()
+  ID3D12Fence *m_ReadbackFence = NULL;
+  HANDLE m_ReadbackFenceHandle = NULL;
+  UINT64 m_ReadbackFenceCounter = 0;
+  ID3D12CommandAllocator *m_ReadbackAlloc[2] = {NULL, NULL};
+
   // Array <-> MSAA copying
   ID3D12RootSignature *m_ArrayMSAARootSig = NULL;
   ID3DBlob *m_FullscreenVS = NULL;
@@ -214,6 +221,13 @@ private:
   ID3DBlob *m_FloatArray2MS = NULL;
   ID3DBlob *m_DepthArray2MS = NULL;
 
+  // cached pipelines for the conversions above, keyed on the state that varies between them.
+  // Stepping events with an MSAA target selected re-runs the conversion on every event change, so
+  // we don't want to pay a pipeline compile each time.
+  ID3D12PipelineState *GetArrayMSAACopyPipe(const D3D12_GRAPHICS_PIPELINE_STATE_DESC &pipeDesc,
+                                            bool ms2array, bool stencilPass);
+  std::map<uint64_t, ID3D12PipelineState *> m_ArrayMSAAPipes;
+
   // Debug lists
   ID3D12GraphicsCommandListX *m_DebugList = NULL;
   ID3D12CommandAllocator *m_DebugAlloc = NULL;
@@ -2656,8 +2656,11 @@ WriteSerialiser &WrappedID3D12Device::GetThreadSerialiser()
 
   ser = new WriteSerialiser(new StreamWriter(1024), Ownership::Stream);
 
-  uint32_t flags = WriteSerialiser::ChunkDuration | WriteSerialiser::ChunkTimestamp |
-                   WriteSerialiser::ChunkThreadID;
+  uint32_t flags = 0;
+
+  if(!RenderDoc::Inst().GetCaptureOptions().stripChunkMetadata)
+    flags = WriteSerialiser::ChunkDuration | WriteSerialiser::ChunkTimestamp |
+            WriteSerialiser::ChunkThreadID;
 
   if(RenderDoc::Inst().GetCaptureOptions().captureCallstacks)
     flags |= WriteSerialiser::ChunkCallstack;
@@ -2810,6 +2813,20 @@ void WrappedID3D12Device::DestroyInternalResources()
 
   SAFE_RELEASE(m_RTVHeap);
 
+  if(m_PipeLibrary)
+  {
+    if(m_PipeLibraryDirty)
+    {
+      bytebuf data;
+      data.resize(m_PipeLibrary->GetSerializedSize());
+      if(SUCCEEDED(m_PipeLibrary->Serialize(data.data(), data.size())))
+        FileIO::WriteAll(FileIO::GetAppFolderFilename("d3d12pipelines.cache"), data);
+      else
+        RDCERR("Couldn't serialise pipeline library");
+    }
+    SAFE_RELEASE(m_PipeLibrary);
+  }
+
   SAFE_DELETE(m_TextRenderer);
   SAFE_DELETE(m_ShaderCache);
 
@@ -2821,6 +2838,182 @@ void WrappedID3D12Device::DestroyInternalResources()
   CloseHandle(m_GPUSyncHandle);
 }
 
+ID3D12PipelineLibrary *WrappedID3D12Device::GetPipeLibrary()
+{
+  if(m_PipeLibraryInit)
+    return m_PipeLibrary;
+
+  m_PipeLibraryInit = true;
+
+  // only used on replay, and pipeline libraries need ID3D12Device1
+  if(!IsReplayMode(m_State) || m_pDevice1 == NULL)
+    return NULL;
+
+  FileIO::ReadAll(FileIO::GetAppFolderFilename("d3d12pipelines.cache"), m_PipeLibraryData);
+
+  HRESULT hr = m_pDevice1->CreatePipelineLibrary(
+      m_PipeLibraryData.data(), m_PipeLibraryData.size(), __uuidof(ID3D12PipelineLibrary),
+      (void **)&m_PipeLibrary);
+
+  if(FAILED(hr) && !m_PipeLibraryData.empty())
+  {
+    // the cached data is for another adapter or driver version, start from scratch
+    RDCLOG("Existing pipeline library data rejected (HRESULT: %s), creating empty library",
+           ToStr(hr).c_str());
+    m_PipeLibraryData.clear();
+    hr = m_pDevice1->CreatePipelineLibrary(NULL, 0, __uuidof(ID3D12PipelineLibrary),
+                                           (void **)&m_PipeLibrary);
+  }
+
+  if(FAILED(hr))
+  {
+    // DXGI_ERROR_UNSUPPORTED on runtimes without pipeline library support
+    m_PipeLibrary = NULL;
+  }
+
+  return m_PipeLibrary;
+}
+
+// accumulate a simple FNV-1a hash over a block of state. We use this to give PSOs stable names in
+// the pipeline library - a collision only costs us a cache miss, since the library validates the
+// desc against the stored pipeline on load.
+static uint64_t HashPipeState(const void *data, size_t size, uint64_t hash)
+{
+  const byte *bytes = (const byte *)data;
+  for(size_t i = 0; i < size; i++)
+    hash = (hash ^ bytes[i]) * 0x100000001b3ULL;
+  return hash;
+}
+
+static uint64_t HashPipeShader(const D3D12_SHADER_BYTECODE &sh, uint64_t hash)
+{
+  hash = HashPipeState(&sh.BytecodeLength, sizeof(sh.BytecodeLength), hash);
+  if(sh.BytecodeLength > 0 && sh.pShaderBytecode)
+    hash = HashPipeState(sh.pShaderBytecode, sh.BytecodeLength, hash);
+  return hash;
+}
+
+HRESULT WrappedID3D12Device::CreatePipeFromLibrary(const D3D12_GRAPHICS_PIPELINE_STATE_DESC &desc,
+                                                   const D3D12_GRAPHICS_PIPELINE_STATE_DESC &unwrappedDesc,
+                                                   REFIID riid, void **ppPipelineState)
+{
+  ID3D12PipelineLibrary *lib = GetPipeLibrary();
+
+  if(lib == NULL)
+    return m_pDevice->CreateGraphicsPipelineState(&unwrappedDesc, riid, ppPipelineState);
+
+  // name the PSO by hashing the desc contents. We hash the wrapped desc so any pointers we do
+  // fold in (original resource IDs, string/bytecode contents) are stable from one load to the
+  // next - raw pointer values never are.
+  uint64_t hash = 0xcbf29ce484222325ULL;
+
+  ResourceId rootsig = GetResID(desc.pRootSignature);
+  rootsig = GetResourceManager()->GetOriginalID(rootsig);
+  hash = HashPipeState(&rootsig, sizeof(rootsig), hash);
+
+  hash = HashPipeShader(desc.VS, hash);
+  hash = HashPipeShader(desc.HS, hash);
+  hash = HashPipeShader(desc.DS, hash);
+  hash = HashPipeShader(desc.GS, hash);
+  hash = HashPipeShader(desc.PS, hash);
+
+  for(UINT i = 0; i < desc.StreamOutput.NumEntries; i++)
+  {
+    const D3D12_SO_DECLARATION_ENTRY &e = desc.StreamOutput.pSODeclaration[i];
+    if(e.SemanticName)
+      hash = HashPipeState(e.SemanticName, strlen(e.SemanticName), hash);
+    hash = HashPipeState(&e.Stream, sizeof(e.Stream), hash);
+    hash = HashPipeState(&e.SemanticIndex, sizeof(e.SemanticIndex), hash);
+    hash = HashPipeState(&e.StartComponent, sizeof(e.StartComponent), hash);
+    hash = HashPipeState(&e.ComponentCount, sizeof(e.ComponentCount), hash);
+    hash = HashPipeState(&e.OutputSlot, sizeof(e.OutputSlot), hash);
+  }
+  for(UINT i = 0; i < desc.StreamOutput.NumStrides; i++)
+    hash = HashPipeState(&desc.StreamOutput.pBufferStrides[i], sizeof(UINT), hash);
+  hash = HashPipeState(&desc.StreamOutput.RasterizedStream,
+                       sizeof(desc.StreamOutput.RasterizedStream), hash);
+
+  // BlendState through DepthStencilState are plain data with no padding, hash them as one block
+  hash = HashPipeState(&desc.BlendState,
+                       offsetof(D3D12_GRAPHICS_PIPELINE_STATE_DESC, InputLayout) -
+                           offsetof(D3D12_GRAPHICS_PIPELINE_STATE_DESC, BlendState),
+                       hash);
+
+  for(UINT i = 0; i < desc.InputLayout.NumElements; i++)
+  {
+    const D3D12_INPUT_ELEMENT_DESC &e = desc.InputLayout.pInputElementDescs[i];
+    if(e.SemanticName)
+      hash = HashPipeState(e.SemanticName, strlen(e.SemanticName), hash);
+    // everything after the semantic name is contiguous plain data
+    hash = HashPipeState(&e.SemanticIndex,
+                         sizeof(D3D12_INPUT_ELEMENT_DESC) -
+                             offsetof(D3D12_INPUT_ELEMENT_DESC, SemanticIndex),
+                         hash);
+  }
+
+  // IBStripCutValue through SampleDesc, skipping NodeMask and CachedPSO which don't affect the
+  // compiled pipeline
+  hash = HashPipeState(&desc.IBStripCutValue,
+                       offsetof(D3D12_GRAPHICS_PIPELINE_STATE_DESC, NodeMask) -
+                           offsetof(D3D12_GRAPHICS_PIPELINE_STATE_DESC, IBStripCutValue),
+                       hash);
+  hash = HashPipeState(&desc.Flags, sizeof(desc.Flags), hash);
+
+  rdcwstr name = StringFormat::UTF82Wide(StringFormat::Fmt("G%016llx", hash));
+
+  HRESULT hr = lib->LoadGraphicsPipeline(name.c_str(), &unwrappedDesc, riid, ppPipelineState);
+
+  if(SUCCEEDED(hr))
+    return hr;
+
+  // not in the library (or a hash collision with a different desc) - create and store it
+  hr = m_pDevice->CreateGraphicsPipelineState(&unwrappedDesc, riid, ppPipelineState);
+
+  if(SUCCEEDED(hr))
+  {
+    if(SUCCEEDED(lib->StorePipeline(name.c_str(), (ID3D12PipelineState *)*ppPipelineState)))
+      m_PipeLibraryDirty = true;
+  }
+
+  return hr;
+}
+
+HRESULT WrappedID3D12Device::CreatePipeFromLibrary(const D3D12_COMPUTE_PIPELINE_STATE_DESC &desc,
+                                                   const D3D12_COMPUTE_PIPELINE_STATE_DESC &unwrappedDesc,
+                                                   REFIID riid, void **ppPipelineState)
+{
+  ID3D12PipelineLibrary *lib = GetPipeLibrary();
+
+  if(lib == NULL)
+    return m_pDevice->CreateComputePipelineState(&unwrappedDesc, riid, ppPipelineState);
+
+  uint64_t hash = 0xcbf29ce484222325ULL;
+
+  ResourceId rootsig = GetResID(desc.pRootSignature);
+  rootsig = GetResourceManager()->GetOriginalID(rootsig);
+  hash = HashPipeState(&rootsig, sizeof(rootsig), hash);
+
+  hash = HashPipeShader(desc.CS, hash);
+  hash = HashPipeState(&desc.Flags, sizeof(desc.Flags), hash);
+
+  rdcwstr name = StringFormat::UTF82Wide(StringFormat::Fmt("C%016llx", hash));
+
+  HRESULT hr = lib->LoadComputePipeline(name.c_str(), &unwrappedDesc, riid, ppPipelineState);
+
+  if(SUCCEEDED(hr))
+    return hr;
+
+  hr = m_pDevice->CreateComputePipelineState(&unwrappedDesc, riid, ppPipelineState);
+
+  if(SUCCEEDED(hr))
+  {
+    if(SUCCEEDED(lib->StorePipeline(name.c_str(), (ID3D12PipelineState *)*ppPipelineState)))
+      m_PipeLibraryDirty = true;
+  }
+
+  return hr;
+}
+
 void WrappedID3D12Device::GPUSync(ID3D12CommandQueue *queue, ID3D12Fence *fence)
 {
   m_GPUSyncCounter++;
@@ -2905,9 +3098,27 @@ ID3D12GraphicsCommandListX *WrappedID3D12Device::GetInitialStateList()
     }
   }
 
+  initStateCurBatch++;
+
   return initStateCurList;
 }
 
+void WrappedID3D12Device::DeferInitialStateEviction(ID3D12Pageable *pageable)
+{
+  initStateEvictions.push_back(pageable);
+
+  // flush periodically so a long run of nonresident resources doesn't blow the residency budget
+  // while they wait for the batched copies to execute
+  if(initStateEvictions.size() >= 8)
+  {
+    if(initStateCurList)
+      CloseInitialStateList();
+
+    ExecuteLists(NULL, true);
+    FlushLists();
+  }
+}
+
 void WrappedID3D12Device::CloseInitialStateList()
 {
   D3D12MarkerRegion::End(initStateCurList);
@@ -2966,6 +3177,14 @@ void WrappedID3D12Device::FlushLists(bool forceSync, ID3D12CommandQueue *queue)
 
     if(m_InternalCmds.pendingcmds.empty())
       m_Alloc->Reset();
+
+    // now that the GPU has idled, any resources kept resident only for batched initial state
+    // copies can be evicted.
+    if(!initStateEvictions.empty())
+    {
+      Evict((UINT)initStateEvictions.size(), initStateEvictions.data());
+      initStateEvictions.clear();
+    }
   }
 }
 
@@ -3155,6 +3374,12 @@ bool WrappedID3D12Device::ProcessChunk(ReadSerialiser &ser, D3D12Chunk context)
     {
       return GetResourceManager()->Serialise_InitialState(ser, ResourceId(), NULL, NULL);
     }
+    else if(system == SystemChunk::InitialContentsReference)
+    {
+      GetResourceManager()->CreateInitialContentsReference(ser);
+
+      SERIALISE_CHECK_READ_ERRORS();
+    }
     else if(system == SystemChunk::CaptureScope)
     {
       return Serialise_CaptureScope(ser);
@@ -44,7 +44,7 @@ struct D3D12InitParams
   DXGI_ADAPTER_DESC AdapterDesc = {};
 
   // check if a frame capture section version is supported
-  static const uint64_t CurrentVersion = 0x8;
+  static const uint64_t CurrentVersion = 0x9;
 
   static bool IsSupportedVersion(uint64_t ver);
 };
@@ -404,6 +404,21 @@ private:
   D3D12ShaderCache *m_ShaderCache = NULL;
   D3D12TextRenderer *m_TextRenderer = NULL;
 
+  // on replay, PSO creation is routed through a pipeline library persisted to disk, so repeated
+  // loads of the same capture (or captures sharing pipelines) skip driver compilation. The
+  // serialised blob must stay resident while the library exists, so we keep it as a member.
+  ID3D12PipelineLibrary *m_PipeLibrary = NULL;
+  bytebuf m_PipeLibraryData;
+  bool m_PipeLibraryInit = false, m_PipeLibraryDirty = false;
+
+  ID3D12PipelineLibrary *GetPipeLibrary();
+  HRESULT CreatePipeFromLibrary(const D3D12_GRAPHICS_PIPELINE_STATE_DESC &desc,
+                                const D3D12_GRAPHICS_PIPELINE_STATE_DESC &unwrappedDesc,
+                                REFIID riid, void **ppPipelineState);
+  HRESULT CreatePipeFromLibrary(const D3D12_COMPUTE_PIPELINE_STATE_DESC &desc,
+                                const D3D12_COMPUTE_PIPELINE_STATE_DESC &unwrappedDesc,
+                                REFIID riid, void **ppPipelineState);
+
   std::set<ResourceId> m_UploadResourceIds;
   std::map<uint64_t, ID3D12Resource *> m_UploadBuffers;
 
@@ -641,9 +656,15 @@ public:
   int initStateCurBatch;
   ID3D12GraphicsCommandListX *initStateCurList;
 
+  // nonresident resources made resident for batched initial state copies. They must stay resident
+  // until the copies execute, so they're evicted on the next FlushLists() once the GPU is idle,
+  // instead of paying a full execute+sync per resource just to evict it immediately.
+  rdcarray<ID3D12Pageable *> initStateEvictions;
+
   ID3D12GraphicsCommandListX *GetNewList();
   ID3D12GraphicsCommandListX *GetInitialStateList();
   void CloseInitialStateList();
+  void DeferInitialStateEviction(ID3D12Pageable *pageable);
   ID3D12Resource *GetUploadBuffer(uint64_t chunkOffset, uint64_t byteSize);
   void ApplyInitialContents();
 
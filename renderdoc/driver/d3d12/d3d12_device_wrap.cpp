@@ -431,7 +431,7 @@ bool WrappedID3D12Device::Serialise_CreateGraphicsPipelineState(
     }
 
     ID3D12PipelineState *ret = NULL;
-    HRESULT hr = m_pDevice->CreateGraphicsPipelineState(&unwrappedDesc, guid, (void **)&ret);
+    HRESULT hr = CreatePipeFromLibrary(Descriptor, unwrappedDesc, guid, (void **)&ret);
 
     if(FAILED(hr))
     {
@@ -686,7 +686,7 @@ bool WrappedID3D12Device::Serialise_CreateComputePipelineState(
     }
 
     ID3D12PipelineState *ret = NULL;
-    HRESULT hr = m_pDevice->CreateComputePipelineState(&unwrappedDesc, guid, (void **)&ret);
+    HRESULT hr = CreatePipeFromLibrary(Descriptor, unwrappedDesc, guid, (void **)&ret);
 
     if(FAILED(hr))
     {
@@ -150,12 +150,9 @@ bool D3D12ResourceManager::Prepare_InitialState(ID3D12DeviceChild *res)
 
       if(nonresident)
       {
-        m_Device->CloseInitialStateList();
-
-        m_Device->ExecuteLists(NULL, true);
-        m_Device->FlushLists();
-
-        m_Device->Evict(1, &pageable);
+        // stay on the batched list - the resource is kept resident until the copies execute and
+        // is evicted on the next FlushLists(), rather than paying an execute+sync here
+        m_Device->DeferInitialStateEviction(pageable);
       }
       else
       {
@@ -341,8 +338,9 @@ bool D3D12ResourceManager::Prepare_InitialState(ID3D12DeviceChild *res)
       if(!barriers.empty())
         list->ResourceBarrier((UINT)barriers.size(), &barriers[0]);
 
-      if(nonresident || arrayTexture)
+      if(arrayTexture)
       {
+        // the MSAA array texture is released below, so its copies must complete now
         m_Device->CloseInitialStateList();
 
         m_Device->ExecuteLists(NULL, true);
@@ -351,6 +349,11 @@ bool D3D12ResourceManager::Prepare_InitialState(ID3D12DeviceChild *res)
         if(nonresident)
           m_Device->Evict(1, &pageable);
       }
+      else if(nonresident)
+      {
+        // stay on the batched list and evict on the next FlushLists() as above
+        m_Device->DeferInitialStateEviction(pageable);
+      }
       else
       {
 #if ENABLED(SINGLE_FLUSH_VALIDATE)
@@ -382,8 +385,14 @@ uint64_t D3D12ResourceManager::GetSize_InitialState(ResourceId id, const D3D12In
     // the initial contents are just the descriptors. Estimate the serialise size here
     const uint64_t descriptorSerSize = 40 + sizeof(D3D12_SAMPLER_DESC);
 
+    // only descriptors that have ever been written get serialised, plus their heap index
+    uint64_t numWritten = 0;
+    for(uint32_t i = 0; i < data.numDescriptors; i++)
+      if(data.descriptors[i].GetType() != D3D12DescriptorType::Undefined)
+        numWritten++;
+
     // add a little extra room for fixed overhead
-    return 64 + data.numDescriptors * descriptorSerSize;
+    return 64 + numWritten * (descriptorSerSize + sizeof(uint32_t));
   }
   else if(data.resourceType == Resource_Resource)
   {
@@ -425,7 +434,43 @@ bool D3D12ResourceManager::Serialise_InitialState(SerialiserType &ser, ResourceI
     D3D12Descriptor *Descriptors = initial ? initial->descriptors : NULL;
     uint32_t numElems = initial ? initial->numDescriptors : 0;
 
-    SERIALISE_ELEMENT_ARRAY(Descriptors, numElems);
+    // from version 0x9 only descriptors that have ever been written are serialised, stored as
+    // their index in the heap plus the packed descriptor. Shader-visible bindless heaps are
+    // commonly allocated at a worst-case size with only a fraction of the slots in use, and
+    // untouched slots are still at their initial Undefined state.
+    uint32_t *WrittenIndices = NULL;
+    uint32_t NumWritten = 0;
+
+    rdcarray<uint32_t> indices;
+    rdcarray<D3D12Descriptor> packed;
+
+    if(ser.IsWriting())
+    {
+      for(uint32_t i = 0; i < numElems; i++)
+      {
+        if(Descriptors[i].GetType() == D3D12DescriptorType::Undefined)
+          continue;
+
+        indices.push_back(i);
+        packed.push_back(Descriptors[i]);
+      }
+
+      WrittenIndices = indices.data();
+      NumWritten = (uint32_t)indices.size();
+    }
+
+    if(ser.VersionAtLeast(0x9))
+    {
+      if(ser.IsWriting())
+        Descriptors = packed.data();
+
+      SERIALISE_ELEMENT_ARRAY(WrittenIndices, NumWritten);
+      SERIALISE_ELEMENT_ARRAY(Descriptors, NumWritten);
+    }
+    else
+    {
+      SERIALISE_ELEMENT_ARRAY(Descriptors, numElems);
+    }
     SERIALISE_ELEMENT(numElems);
 
     SERIALISE_CHECK_READ_ERRORS();
@@ -450,7 +495,10 @@ bool D3D12ResourceManager::Serialise_InitialState(SerialiserType &ser, ResourceI
         return false;
       }
 
-      if(Descriptors == NULL)
+      const bool packedFormat = ser.VersionAtLeast(0x9);
+
+      // in the packed format a fully-empty heap legitimately serialises no descriptors
+      if(Descriptors == NULL && !(packedFormat && NumWritten == 0))
       {
         RDCERR("Failed to correctly serialise descriptor heap initial state");
         return false;
@@ -462,9 +510,30 @@ bool D3D12ResourceManager::Serialise_InitialState(SerialiserType &ser, ResourceI
 
       UINT increment = m_Device->GetDescriptorHandleIncrementSize(desc.Type);
 
+      // never-written slots still get a null descriptor created so the heap is safe to copy from,
+      // the same as the Undefined case when every slot was serialised
+      D3D12Descriptor empty;
+      empty.Setup(NULL, 0);
+
+      uint32_t w = 0;
       for(uint32_t i = 0; i < RDCMIN(numElems, desc.NumDescriptors); i++)
       {
-        Descriptors[i].Create(desc.Type, m_Device, handle);
+        if(packedFormat)
+        {
+          if(w < NumWritten && WrittenIndices[w] == i)
+          {
+            Descriptors[w].Create(desc.Type, m_Device, handle);
+            w++;
+          }
+          else
+          {
+            empty.Create(desc.Type, m_Device, handle);
+          }
+        }
+        else
+        {
+          Descriptors[i].Create(desc.Type, m_Device, handle);
+        }
 
         handle.ptr += increment;
       }
@@ -755,9 +755,35 @@ bool D3D12ResourceManager::ResourceTypeRelease(ID3D12DeviceChild *res)
   return true;
 }
 
+GPUAddressRangeTracker::~GPUAddressRangeTracker()
+{
+  for(LastHit *hit : threadCaches)
+    delete hit;
+}
+
+GPUAddressRangeTracker::LastHit *GPUAddressRangeTracker::GetLastHit()
+{
+  LastHit *hit = (LastHit *)Threading::GetTLSValue(lastHitSlot);
+
+  if(hit == NULL)
+  {
+    hit = new LastHit;
+    Threading::SetTLSValue(lastHitSlot, hit);
+
+    // remember the cache so it can be freed with the tracker
+    SCOPED_WRITELOCK(addressLock);
+    threadCaches.push_back(hit);
+  }
+
+  return hit;
+}
+
 void GPUAddressRangeTracker::AddTo(const GPUAddressRange &range)
 {
   SCOPED_WRITELOCK(addressLock);
+
+  Atomic::Inc32(&generation);
+
   auto it = std::lower_bound(addresses.begin(), addresses.end(), range.start);
 
   addresses.insert(it - addresses.begin(), range);
@@ -767,6 +793,9 @@ void GPUAddressRangeTracker::RemoveFrom(const GPUAddressRange &range)
 {
   {
     SCOPED_WRITELOCK(addressLock);
+
+    Atomic::Inc32(&generation);
+
     size_t i = std::lower_bound(addresses.begin(), addresses.end(), range.start) - addresses.begin();
 
     // there might be multiple buffers with the same range start, find the exact range for this
@@ -795,9 +824,21 @@ void GPUAddressRangeTracker::GetResIDFromAddr(D3D12_GPU_VIRTUAL_ADDRESS addr, Re
   if(addr == 0)
     return;
 
+  LastHit *hit = GetLastHit();
+
+  // fast path - if nothing has modified the table since this thread cached its last hit, the
+  // cached range is still valid and the lock can be skipped. The generation is bumped before any
+  // modification, so worst case a range removed in the tiny window after this check resolves as
+  // if the lookup had happened just before the removal.
+  if(hit->generation == generation && addr >= hit->range.start && addr < hit->range.end)
+  {
+    id = hit->range.id;
+    offs = addr - hit->range.start;
+    return;
+  }
+
   GPUAddressRange range;
 
-  // this should really be a read-write lock
   {
     SCOPED_READLOCK(addressLock);
 
@@ -806,6 +847,13 @@ void GPUAddressRangeTracker::GetResIDFromAddr(D3D12_GPU_VIRTUAL_ADDRESS addr, Re
       return;
 
     range = *it;
+
+    if(addr >= range.start && addr < range.end)
+    {
+      // cache under the read lock, so the generation matches the snapshot we copied
+      hit->generation = generation;
+      hit->range = range;
+    }
   }
 
   if(addr < range.start || addr >= range.end)
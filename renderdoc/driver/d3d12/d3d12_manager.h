@@ -457,7 +457,8 @@ struct GPUAddressRange
 
 struct GPUAddressRangeTracker
 {
-  GPUAddressRangeTracker() {}
+  GPUAddressRangeTracker() { lastHitSlot = Threading::AllocateTLSSlot(); }
+  ~GPUAddressRangeTracker();
   // no copying
   GPUAddressRangeTracker(const GPUAddressRangeTracker &);
   GPUAddressRangeTracker &operator=(const GPUAddressRangeTracker &);
@@ -468,6 +469,24 @@ struct GPUAddressRangeTracker
   void AddTo(const GPUAddressRange &range);
   void RemoveFrom(const GPUAddressRange &range);
   void GetResIDFromAddr(D3D12_GPU_VIRTUAL_ADDRESS addr, ResourceId &id, UINT64 &offs);
+
+  // per-thread cache of the last range hit. Root descriptor binds resolve the same few buffers
+  // over and over, so each thread validates its last hit against the generation counter and skips
+  // the lock entirely on a match.
+  struct LastHit
+  {
+    int32_t generation = -1;
+    GPUAddressRange range = {};
+  };
+
+  LastHit *GetLastHit();
+
+  // bumped inside the write lock before any modification to addresses, invalidating every
+  // per-thread cache
+  volatile int32_t generation = 0;
+  uint64_t lastHitSlot = 0;
+  // all caches handed out to threads, so they can be freed with the tracker
+  rdcarray<LastHit *> threadCaches;
 };
 
 struct MapState
@@ -30,6 +30,66 @@
 
 #include "driver/dx/official/d3dcompiler.h"
 
+ID3D12PipelineState *D3D12DebugManager::GetArrayMSAACopyPipe(
+    const D3D12_GRAPHICS_PIPELINE_STATE_DESC &pipeDesc, bool ms2array, bool stencilPass)
+{
+  // generate a key from the state that varies between conversions. The choice of shader is implied
+  // by the direction and the RTV/DSV formats so it doesn't need to be included.
+  uint64_t key = 0;
+
+  uint64_t bit = 0;
+
+  if(ms2array)
+    key |= 1ULL << bit;
+  bit++;
+
+  if(stencilPass)
+    key |= 1ULL << bit;
+  bit++;
+
+  key |= uint64_t((uint32_t)pipeDesc.RTVFormats[0] & 0xff) << bit;
+  bit += 8;
+
+  key |= uint64_t((uint32_t)pipeDesc.DSVFormat & 0xff) << bit;
+  bit += 8;
+
+  RDCASSERT(pipeDesc.SampleDesc.Count <= 32);
+  key |= uint64_t(pipeDesc.SampleDesc.Count & 0x3f) << bit;
+  bit += 6;
+
+  key |= uint64_t(pipeDesc.SampleDesc.Quality & 0xff) << bit;
+  bit += 8;
+
+  key |= uint64_t(pipeDesc.SampleMask) << bit;
+  bit += 32;
+
+  auto it = m_ArrayMSAAPipes.find(key);
+  if(it != m_ArrayMSAAPipes.end())
+    return it->second;
+
+  ID3D12PipelineState *pso = NULL;
+
+  // MS -> array runs during capture, so its pipeline is created on the real device with already
+  // unwrapped state. Array -> MS runs on replay with wrapped objects.
+  HRESULT hr;
+  if(ms2array)
+    hr = m_pDevice->GetReal()->CreateGraphicsPipelineState(&pipeDesc, __uuidof(ID3D12PipelineState),
+                                                           (void **)&pso);
+  else
+    hr = m_pDevice->CreateGraphicsPipelineState(&pipeDesc, __uuidof(ID3D12PipelineState),
+                                                (void **)&pso);
+
+  if(FAILED(hr))
+  {
+    RDCERR("Couldn't create MSAA conversion pipeline! HRESULT: %s", ToStr(hr).c_str());
+    return NULL;
+  }
+
+  m_ArrayMSAAPipes[key] = pso;
+
+  return pso;
+}
+
 void D3D12DebugManager::CopyTex2DMSToArray(ID3D12Resource *destArray, ID3D12Resource *srcMS)
 {
   // this function operates during capture so we work on unwrapped objects
@@ -176,15 +236,10 @@ void D3D12DebugManager::CopyTex2DMSToArray(ID3D12Resource *destArray, ID3D12Reso
   pipeDesc.BlendState.RenderTarget[0].BlendOpAlpha = D3D12_BLEND_OP_ADD;
   pipeDesc.BlendState.RenderTarget[0].RenderTargetWriteMask = D3D12_COLOR_WRITE_ENABLE_ALL;
 
-  ID3D12PipelineState *pso = NULL, *psoStencil = NULL;
-  HRESULT hr = m_pDevice->GetReal()->CreateGraphicsPipelineState(
-      &pipeDesc, __uuidof(ID3D12PipelineState), (void **)&pso);
+  ID3D12PipelineState *pso = GetArrayMSAACopyPipe(pipeDesc, true, false);
 
-  if(FAILED(hr))
-  {
-    RDCERR("Couldn't create MSAA conversion pipeline! HRESULT: %s", ToStr(hr).c_str());
+  if(pso == NULL)
     return;
-  }
 
   ID3D12GraphicsCommandList *list = Unwrap(m_DebugList);
 
@@ -244,9 +299,7 @@ void D3D12DebugManager::CopyTex2DMSToArray(ID3D12Resource *destArray, ID3D12Reso
     pipeDesc.DepthStencilState.StencilReadMask = 0xff;
     pipeDesc.DepthStencilState.StencilWriteMask = 0xff;
 
-    hr = m_pDevice->GetReal()->CreateGraphicsPipelineState(&pipeDesc, __uuidof(ID3D12PipelineState),
-                                                           (void **)&psoStencil);
-    RDCASSERTEQUAL(hr, S_OK);
+    ID3D12PipelineState *psoStencil = GetArrayMSAACopyPipe(pipeDesc, true, true);
 
     list->SetPipelineState(psoStencil);
 
@@ -291,8 +344,6 @@ void D3D12DebugManager::CopyTex2DMSToArray(ID3D12Resource *destArray, ID3D12Reso
   m_DebugAlloc->Reset();
 
   SAFE_RELEASE(tmpFence);
-  SAFE_RELEASE(pso);
-  SAFE_RELEASE(psoStencil);
 }
 
 void D3D12DebugManager::CopyArrayToTex2DMS(ID3D12Resource *destMS, ID3D12Resource *srcArray,
@@ -456,15 +507,10 @@ void D3D12DebugManager::CopyArrayToTex2DMS(ID3D12Resource *destMS, ID3D12Resourc
   pipeDesc.BlendState.RenderTarget[0].BlendOpAlpha = D3D12_BLEND_OP_ADD;
   pipeDesc.BlendState.RenderTarget[0].RenderTargetWriteMask = D3D12_COLOR_WRITE_ENABLE_ALL;
 
-  ID3D12PipelineState *pso = NULL, *psoStencil = NULL;
-  HRESULT hr = m_pDevice->CreateGraphicsPipelineState(&pipeDesc, __uuidof(ID3D12PipelineState),
-                                                      (void **)&pso);
+  ID3D12PipelineState *pso = GetArrayMSAACopyPipe(pipeDesc, false, false);
 
-  if(FAILED(hr))
-  {
-    RDCERR("Couldn't create MSAA conversion pipeline! HRESULT: %s", ToStr(hr).c_str());
+  if(pso == NULL)
     return;
-  }
 
   ID3D12GraphicsCommandList *list = m_DebugList;
 
@@ -525,9 +571,7 @@ void D3D12DebugManager::CopyArrayToTex2DMS(ID3D12Resource *destMS, ID3D12Resourc
     pipeDesc.DepthStencilState.StencilReadMask = 0xff;
     pipeDesc.DepthStencilState.StencilWriteMask = 0xff;
 
-    hr = m_pDevice->CreateGraphicsPipelineState(&pipeDesc, __uuidof(ID3D12PipelineState),
-                                                (void **)&psoStencil);
-    RDCASSERTEQUAL(hr, S_OK);
+    ID3D12PipelineState *psoStencil = GetArrayMSAACopyPipe(pipeDesc, false, true);
 
     dsvDesc.Flags = D3D12_DSV_FLAG_READ_ONLY_DEPTH;
     dsvDesc.Texture2DMSArray.ArraySize = 1;
@@ -565,7 +609,4 @@ void D3D12DebugManager::CopyArrayToTex2DMS(ID3D12Resource *destMS, ID3D12Resourc
   m_pDevice->GetQueue()->ExecuteCommandLists(1, &l);
   m_pDevice->GPUSync();
   m_DebugAlloc->Reset();
-
-  SAFE_RELEASE(pso);
-  SAFE_RELEASE(psoStencil);
 }
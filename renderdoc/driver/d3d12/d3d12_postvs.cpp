@@ -23,6 +23,7 @@
  ******************************************************************************/
 
 #include <algorithm>
+#include "core/settings.h"
 #include "driver/dxgi/dxgi_common.h"
 #include "strings/string_utils.h"
 #include "d3d12_command_list.h"
@@ -32,6 +33,10 @@
 #include "d3d12_replay.h"
 #include "d3d12_shader_cache.h"
 
+RDOC_CONFIG(uint32_t, D3D12_PostVSCacheBudgetMB, 1024,
+            "Budget in MB for post-VS geometry data kept resident on the GPU. Once over budget "
+            "the least recently used draws are evicted, and re-fetched on demand.");
+
 bool D3D12Replay::CreateSOBuffers()
 {
   HRESULT hr = S_OK;
@@ -159,9 +164,76 @@ void D3D12Replay::ClearPostVSCache()
   }
 
   m_PostVSData.clear();
+  m_PostVSUsageOrder.clear();
+  m_PostVSTotalBytes = 0;
+}
+
+void D3D12Replay::TrimPostVSCache(uint32_t eventId)
+{
+  auto entry = m_PostVSData.find(eventId);
+
+  if(entry == m_PostVSData.end())
+    return;
+
+  D3D12PostVSData &data = entry->second;
+
+  // account the entry against the budget the first time we see it
+  if(!m_PostVSUsageOrder.contains(eventId))
+  {
+    if(data.vsout.buf)
+      data.totalBytes += data.vsout.buf->GetDesc().Width;
+    if(data.vsout.idxBuf)
+      data.totalBytes += data.vsout.idxBuf->GetDesc().Width;
+    if(data.gsout.buf)
+      data.totalBytes += data.gsout.buf->GetDesc().Width;
+    if(data.gsout.idxBuf)
+      data.totalBytes += data.gsout.idxBuf->GetDesc().Width;
+
+    m_PostVSTotalBytes += data.totalBytes;
+  }
+
+  // mark as most recently used
+  m_PostVSUsageOrder.removeOne(eventId);
+  m_PostVSUsageOrder.push_back(eventId);
+
+  const uint64_t budget = uint64_t(D3D12_PostVSCacheBudgetMB) * 1024 * 1024;
+
+  // evict least recently used entries until we're back under budget. Evicted draws are re-fetched
+  // on demand if they're selected again. The entry just used always stays resident, even if it's
+  // over budget on its own.
+  while(m_PostVSTotalBytes > budget && m_PostVSUsageOrder.size() > 1)
+  {
+    uint32_t evict = m_PostVSUsageOrder[0];
+
+    auto it = m_PostVSData.find(evict);
+
+    if(it != m_PostVSData.end())
+    {
+      SAFE_RELEASE(it->second.vsout.buf);
+      SAFE_RELEASE(it->second.vsout.idxBuf);
+      SAFE_RELEASE(it->second.gsout.buf);
+      SAFE_RELEASE(it->second.gsout.idxBuf);
+
+      m_PostVSTotalBytes -= it->second.totalBytes;
+      m_PostVSData.erase(it);
+    }
+
+    m_PostVSUsageOrder.erase(0);
+  }
 }
 
 void D3D12Replay::InitPostVSBuffers(uint32_t eventId)
+{
+  FetchPostVSData(eventId);
+
+  // go through any aliasing
+  if(m_PostVSAlias.find(eventId) != m_PostVSAlias.end())
+    eventId = m_PostVSAlias[eventId];
+
+  TrimPostVSCache(eventId);
+}
+
+void D3D12Replay::FetchPostVSData(uint32_t eventId)
 {
   // go through any aliasing
   if(m_PostVSAlias.find(eventId) != m_PostVSAlias.end())
@@ -1371,8 +1443,14 @@ MeshFormat D3D12Replay::GetPostVSBuffers(uint32_t eventId, uint32_t instID, uint
   (void)viewID;
 
   if(m_PostVSData.find(eventId) != m_PostVSData.end())
+  {
     postvs = m_PostVSData[eventId];
 
+    // mark as most recently used, so it's the last to be evicted
+    m_PostVSUsageOrder.removeOne(eventId);
+    m_PostVSUsageOrder.push_back(eventId);
+  }
+
   const D3D12PostVSData::StageData &s = postvs.GetStage(stage);
 
   MeshFormat ret;
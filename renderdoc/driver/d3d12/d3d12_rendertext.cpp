@@ -448,14 +448,9 @@ D3D12TextRenderer::~D3D12TextRenderer()
 void D3D12TextRenderer::RenderText(ID3D12GraphicsCommandList *list, float x, float y,
                                    const rdcstr &text)
 {
-  rdcarray<rdcstr> lines;
-  split(text, lines, '\n');
-
-  for(const rdcstr &line : lines)
-  {
-    RenderTextInternal(list, x, y, line);
-    y += 1.0f;
-  }
+  // the shader positions each character from a column and row in the character data, so the
+  // whole block - newlines included - goes through as a single draw rather than one per line.
+  RenderTextInternal(list, x, y, text);
 }
 
 void D3D12TextRenderer::RenderTextInternal(ID3D12GraphicsCommandList *list, float x, float y,
@@ -464,7 +459,26 @@ void D3D12TextRenderer::RenderTextInternal(ID3D12GraphicsCommandList *list, floa
   if(text.empty())
     return;
 
-  RDCASSERT(text.size() < FONT_MAX_CHARS);
+  // lay the text out as a glyph, column and row per character, consuming newlines
+  rdcarray<Vec4u> glyphs;
+  glyphs.reserve(text.size());
+
+  uint32_t col = 0, row = 0;
+
+  for(const char c : text)
+  {
+    if(c == '\n')
+    {
+      col = 0;
+      row++;
+      continue;
+    }
+
+    glyphs.push_back(Vec4u(uint32_t(c - ' '), col++, row, 0));
+  }
+
+  if(glyphs.empty())
+    return;
 
   FontCBuffer data = {};
 
@@ -500,33 +514,6 @@ void D3D12TextRenderer::RenderTextInternal(ID3D12GraphicsCommandList *list, floa
     Constants->Unmap(0, &range);
   }
 
-  size_t chars = text.size();
-
-  size_t charOffset = CharOffset;
-
-  if(CharOffset + chars >= FONT_BUFFER_CHARS)
-    charOffset = 0;
-
-  CharOffset = charOffset + chars;
-
-  CharOffset = AlignUp(CharOffset, constantAlignment / sizeof(Vec4f));
-
-  unsigned long *texs = NULL;
-  hr = CharBuffer->Map(0, NULL, (void **)&texs);
-
-  if(FAILED(hr) || texs == NULL)
-  {
-    RDCERR("Failed to map charbuffer HRESULT: %s", ToStr(hr).c_str());
-    return;
-  }
-
-  texs += charOffset * 4;
-
-  for(size_t i = 0; i < chars; i++)
-    texs[i * 4] = (text[i] - ' ');
-
-  CharBuffer->Unmap(0, NULL);
-
   // the list is used unwrapped to avoid weird ordering bugs and potentially 'poisoning' the
   // resource record on 12On7 with our own rendering
   {
@@ -554,12 +541,48 @@ void D3D12TextRenderer::RenderTextInternal(ID3D12GraphicsCommandList *list, floa
     Unwrap(list)->SetGraphicsRootConstantBufferView(
         0, Constants->GetGPUVirtualAddress() + ConstRingIdx * constantAlignment);
     Unwrap(list)->SetGraphicsRootConstantBufferView(1, GlyphData->GetGPUVirtualAddress());
-    Unwrap(list)->SetGraphicsRootConstantBufferView(
-        2, CharBuffer->GetGPUVirtualAddress() + charOffset * sizeof(Vec4f));
     Unwrap(list)->SetGraphicsRootDescriptorTable(
         3, Unwrap(descHeap->GetGPUDescriptorHandleForHeapStart()));
 
-    Unwrap(list)->DrawInstanced(4, (uint32_t)chars, 0, 0);
+    // draw in chunks if the block is too long for one stringdata cbuffer
+    for(size_t start = 0; start < glyphs.size(); start += FONT_MAX_CHARS)
+    {
+      size_t chars = RDCMIN(glyphs.size() - start, (size_t)FONT_MAX_CHARS);
+
+      size_t charOffset = CharOffset;
+
+      if(CharOffset + chars >= FONT_BUFFER_CHARS)
+        charOffset = 0;
+
+      CharOffset = charOffset + chars;
+
+      CharOffset = AlignUp(CharOffset, constantAlignment / sizeof(Vec4f));
+
+      unsigned long *texs = NULL;
+      hr = CharBuffer->Map(0, NULL, (void **)&texs);
+
+      if(FAILED(hr) || texs == NULL)
+      {
+        RDCERR("Failed to map charbuffer HRESULT: %s", ToStr(hr).c_str());
+        return;
+      }
+
+      texs += charOffset * 4;
+
+      for(size_t i = 0; i < chars; i++)
+      {
+        texs[i * 4 + 0] = glyphs[start + i].x;
+        texs[i * 4 + 1] = glyphs[start + i].y;
+        texs[i * 4 + 2] = glyphs[start + i].z;
+      }
+
+      CharBuffer->Unmap(0, NULL);
+
+      Unwrap(list)->SetGraphicsRootConstantBufferView(
+          2, CharBuffer->GetGPUVirtualAddress() + charOffset * sizeof(Vec4f));
+
+      Unwrap(list)->DrawInstanced(4, (uint32_t)chars, 0, 0);
+    }
   }
 
   ConstRingIdx++;
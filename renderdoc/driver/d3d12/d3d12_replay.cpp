@@ -122,37 +122,47 @@ void D3D12Replay::CreateResources()
     m_VertexPick.Init(m_pDevice, m_DebugManager);
     m_PixelPick.Init(m_pDevice, m_DebugManager);
     m_Histogram.Init(m_pDevice, m_DebugManager);
+  }
+  else
+  {
+    m_pAMDCounters = NULL;
+  }
+}
 
-    if(!m_Proxy && D3D12_HardwareCounters)
-    {
-      AMDCounters *counters = NULL;
+void D3D12Replay::InitIHVCounters()
+{
+  // only try once, and only after the UI first asks for counters - GPUPerfAPI can take seconds to
+  // load and initialise, which we don't want to pay on every capture open.
+  if(m_IHVCountersTried)
+    return;
 
-      if(m_DriverInfo.vendor == GPUVendor::AMD)
-      {
-        RDCLOG("AMD GPU detected - trying to initialise AMD counters");
-        counters = new AMDCounters(m_pDevice->IsDebugLayerEnabled());
-      }
-      else
-      {
-        RDCLOG("%s GPU detected - no counters available", ToStr(m_DriverInfo.vendor).c_str());
-      }
+  m_IHVCountersTried = true;
 
-      ID3D12Device *d3dDevice = m_pDevice->GetReal();
+  if(RenderDoc::Inst().IsReplayApp() && !m_Proxy && D3D12_HardwareCounters)
+  {
+    AMDCounters *counters = NULL;
 
-      if(counters && counters->Init(AMDCounters::ApiType::Dx12, (void *)d3dDevice))
-      {
-        m_pAMDCounters = counters;
-      }
-      else
-      {
-        delete counters;
-        m_pAMDCounters = NULL;
-      }
+    if(m_DriverInfo.vendor == GPUVendor::AMD)
+    {
+      RDCLOG("AMD GPU detected - trying to initialise AMD counters");
+      counters = new AMDCounters(m_pDevice->IsDebugLayerEnabled());
+    }
+    else
+    {
+      RDCLOG("%s GPU detected - no counters available", ToStr(m_DriverInfo.vendor).c_str());
+    }
+
+    ID3D12Device *d3dDevice = m_pDevice->GetReal();
+
+    if(counters && counters->Init(AMDCounters::ApiType::Dx12, (void *)d3dDevice))
+    {
+      m_pAMDCounters = counters;
+    }
+    else
+    {
+      delete counters;
+      m_pAMDCounters = NULL;
     }
-  }
-  else
-  {
-    m_pAMDCounters = NULL;
   }
 }
 
@@ -2892,6 +2902,10 @@ void D3D12Replay::RemoveReplacement(ResourceId id)
 
 void D3D12Replay::RefreshDerivedReplacements()
 {
+  // cached re-recorded command lists bake in the current pipeline bindings, so they can't be
+  // re-used across a change in resource replacements.
+  m_pDevice->GetQueue()->GetCommandData()->FreeRerecordCache();
+
   D3D12ResourceManager *rm = m_pDevice->GetResourceManager();
 
   // we defer deletes of old replaced resources since it will invalidate elements in the vector
@@ -3493,22 +3507,9 @@ void D3D12Replay::GetTextureData(ResourceId tex, const Subresource &sub,
           uint8_t *sSrc =
               (uint8_t *)(pData + layouts[1].Offset + layouts[1].Footprint.RowPitch * row);
 
-          uint32_t *dDst = (uint32_t *)(data.data() + dstRowPitch * row);
-          uint32_t *sDst = dDst + 1;    // interleaved, next pixel
-
-          for(UINT i = 0; i < layouts[0].Footprint.Width; i++)
-          {
-            *dDst = *dSrc;
-            *sDst = *sSrc;
-
-            // increment source pointers by 1 since they're separate, and dest pointers by 2 since
-            // they're interleaved
-            dDst += 2;
-            sDst += 2;
+          uint32_t *dst = (uint32_t *)(data.data() + dstRowPitch * row);
 
-            sSrc++;
-            dSrc++;
-          }
+          InterleaveD32S8(dst, dSrc, sSrc, layouts[0].Footprint.Width);
         }
       }
     }
@@ -3529,15 +3530,8 @@ void D3D12Replay::GetTextureData(ResourceId tex, const Subresource &sub,
 
           uint32_t *dst = (uint32_t *)(data.data() + dstRowPitch * row);
 
-          for(UINT i = 0; i < layouts[0].Footprint.Width; i++)
-          {
-            // pack the data together again, stencil in top bits
-            *dst = (*dSrc & 0x00ffffff) | (uint32_t(*sSrc) << 24);
-
-            dst++;
-            sSrc++;
-            dSrc++;
-          }
+          // pack the data together again, stencil in top bits
+          InterleaveD24S8(dst, dSrc, sSrc, layouts[0].Footprint.Width);
         }
       }
     }
@@ -3707,6 +3701,13 @@ rdcarray<PixelModification> D3D12Replay::PixelHistory(rdcarray<EventUsage> event
   return {};
 }
 
+rdcarray<rdcarray<PixelModification>> D3D12Replay::PixelHistoryRegion(
+    rdcarray<EventUsage> events, ResourceId target, uint32_t x, uint32_t y, uint32_t width,
+    uint32_t height, const Subresource &sub, CompType typeCast)
+{
+  return StandardPixelHistoryRegion(this, events, target, x, y, width, height, sub, typeCast);
+}
+
 ResourceId D3D12Replay::CreateProxyTexture(const TextureDescription &templateTex)
 {
   return ResourceId();
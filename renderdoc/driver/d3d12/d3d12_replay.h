@@ -65,6 +65,7 @@ public:
 
   void CreateResources();
   void DestroyResources();
+  void InitIHVCounters();
   DriverInformation GetDriverInfo() { return m_DriverInfo; }
   rdcarray<GPUDevice> GetAvailableGPUs();
   APIProperties GetAPIProperties();
@@ -186,9 +187,15 @@ public:
 
   rdcarray<PixelModification> PixelHistory(rdcarray<EventUsage> events, ResourceId target, uint32_t x,
                                            uint32_t y, const Subresource &sub, CompType typeCast);
+  rdcarray<rdcarray<PixelModification>> PixelHistoryRegion(rdcarray<EventUsage> events,
+                                                           ResourceId target, uint32_t x, uint32_t y,
+                                                           uint32_t width, uint32_t height,
+                                                           const Subresource &sub, CompType typeCast);
   ShaderDebugTrace *DebugVertex(uint32_t eventId, uint32_t vertid, uint32_t instid, uint32_t idx);
   ShaderDebugTrace *DebugPixel(uint32_t eventId, uint32_t x, uint32_t y, uint32_t sample,
                                uint32_t primitive);
+  rdcarray<ShaderDebugTrace *> DebugPixels(uint32_t eventId,
+                                           const rdcarray<PixelDebugTarget> &targets);
   ShaderDebugTrace *DebugThread(uint32_t eventId, const uint32_t groupid[3],
                                 const uint32_t threadid[3]);
   rdcarray<ShaderDebugState> ContinueDebug(ShaderDebugger *debugger);
@@ -267,6 +274,9 @@ private:
       float farPlane = 0.0f;
     } vsin, vsout, gsout;
 
+    // total GPU memory held by the stage buffers above, used for cache budgeting
+    uint64_t totalBytes = 0;
+
     const StageData &GetStage(MeshDataStage type)
     {
       if(type == MeshDataStage::VSOut)
@@ -283,6 +293,14 @@ private:
   std::map<uint32_t, D3D12PostVSData> m_PostVSData;
   std::map<uint32_t, uint32_t> m_PostVSAlias;
 
+  // running total of GPU memory held by m_PostVSData, and eventIds from least to most recently
+  // used, for evicting old entries once over budget
+  uint64_t m_PostVSTotalBytes = 0;
+  rdcarray<uint32_t> m_PostVSUsageOrder;
+
+  void FetchPostVSData(uint32_t eventId);
+  void TrimPostVSCache(uint32_t eventId);
+
   uint64_t m_SOBufferSize = 128;
   ID3D12Resource *m_SOBuffer = NULL;
   ID3D12Resource *m_SOStagingBuffer = NULL;
@@ -428,6 +446,9 @@ private:
   IDXGIFactory1 *m_pFactory = NULL;
 
   AMDCounters *m_pAMDCounters = NULL;
+
+  // IHV counter libraries are loaded lazily on the first counter enumeration, not at replay init
+  bool m_IHVCountersTried = false;
   AMDRGPControl *m_RGP = NULL;
 
   DriverInformation m_DriverInfo;
@@ -515,7 +515,21 @@ void WrappedID3D12PipelineState::ShaderEntry::BuildReflection()
       D3Dx_IA_VERTEX_INPUT_RESOURCE_SLOT_COUNT == D3D12_IA_VERTEX_INPUT_RESOURCE_SLOT_COUNT,
       "Mismatched vertex input count");
 
+  // substitute any unstripped bytecode before hashing, so cached reflection matches what we'd get
+  // by parsing (including any source files from debug info).
+  TryReplaceOriginalByteCode();
+
+  if(TryFetchCachedShaderReflection(m_Bytecode.data(), m_Bytecode.size(), &m_Details, &m_Mapping))
+  {
+    m_Details.resourceId = GetResourceID();
+    return;
+  }
+
+  if(GetDXBC() == NULL)
+    return;
+
   MakeShaderReflection(m_DXBCFile, &m_Details, &m_Mapping);
+  CacheShaderReflection(m_Bytecode.data(), m_Bytecode.size(), m_Details, m_Mapping);
   m_Details.resourceId = GetResourceID();
 }
 
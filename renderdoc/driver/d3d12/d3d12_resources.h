@@ -758,7 +758,9 @@ public:
     }
     ShaderReflection &GetDetails()
     {
-      if(!m_Built && GetDXBC() != NULL)
+      // deliberately not using GetDXBC() here - on a reflection cache hit BuildReflection()
+      // doesn't need to parse the container at all.
+      if(!m_Built && !m_Bytecode.empty())
         BuildReflection();
       m_Built = true;
       return m_Details;
@@ -766,7 +768,7 @@ public:
 
     const ShaderBindpointMapping &GetMapping()
     {
-      if(!m_Built && GetDXBC() != NULL)
+      if(!m_Built && !m_Bytecode.empty())
         BuildReflection();
       m_Built = true;
       return m_Mapping;
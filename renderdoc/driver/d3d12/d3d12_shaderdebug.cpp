@@ -2842,6 +2842,12 @@ void ExtractInputsPS(PSInput IN, float4 debug_pixelPos : SV_Position,
   return ret;
 }
 
+rdcarray<ShaderDebugTrace *> D3D12Replay::DebugPixels(uint32_t eventId,
+                                                      const rdcarray<PixelDebugTarget> &targets)
+{
+  return StandardDebugPixels(this, eventId, targets);
+}
+
 ShaderDebugTrace *D3D12Replay::DebugThread(uint32_t eventId, const uint32_t groupid[3],
                                            const uint32_t threadid[3])
 {
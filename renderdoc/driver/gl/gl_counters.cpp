@@ -32,6 +32,8 @@
 
 rdcarray<GPUCounter> GLReplay::EnumerateCounters()
 {
+  InitIHVCounters();
+
   rdcarray<GPUCounter> ret;
 
   if(HasExt[ARB_timer_query])
@@ -620,8 +620,11 @@ WrappedOpenGL::WrappedOpenGL(GLPlatform &platform)
 
   m_StructuredFile = &m_StoredStructuredData;
 
-  uint32_t flags = WriteSerialiser::ChunkDuration | WriteSerialiser::ChunkTimestamp |
-                   WriteSerialiser::ChunkThreadID;
+  uint32_t flags = 0;
+
+  if(!RenderDoc::Inst().GetCaptureOptions().stripChunkMetadata)
+    flags = WriteSerialiser::ChunkDuration | WriteSerialiser::ChunkTimestamp |
+            WriteSerialiser::ChunkThreadID;
 
   if(RenderDoc::Inst().GetCaptureOptions().captureCallstacks)
     flags |= WriteSerialiser::ChunkCallstack;
@@ -957,6 +960,8 @@ WrappedOpenGL::~WrappedOpenGL()
     m_DeviceRecord->Delete(GetResourceManager());
   }
 
+  m_ResourceManager->SaveProgramBinaryCache();
+
   m_ResourceManager->Shutdown();
 
   SAFE_DELETE(m_ResourceManager);
@@ -980,6 +985,10 @@ ContextPair &WrappedOpenGL::GetCtx()
 
 GLResourceRecord *WrappedOpenGL::GetContextRecord()
 {
+  // flush any coalesced pending buffer update first, so its chunk stays ordered ahead of
+  // whatever is about to be recorded against the context.
+  FlushPendingBufferUpdate();
+
   GLContextTLSData *ret = (GLContextTLSData *)Threading::GetTLSValue(m_CurCtxDataTLS);
   if(ret && ret->ctxRecord)
   {
@@ -1150,13 +1159,15 @@ void WrappedOpenGL::CreateContext(GLWindowingData winData, void *shareContext,
 
   RenderDoc::Inst().AddDeviceFrameCapturer(ctxdata.ctx, this);
 
-  // re-configure callstack capture, since WrappedOpenGL constructor may run too early
-  uint32_t flags = m_ScratchSerialiser.GetChunkMetadataRecording();
+  // re-configure chunk metadata recording, since WrappedOpenGL constructor may run too early
+  uint32_t flags = 0;
+
+  if(!RenderDoc::Inst().GetCaptureOptions().stripChunkMetadata)
+    flags = WriteSerialiser::ChunkDuration | WriteSerialiser::ChunkTimestamp |
+            WriteSerialiser::ChunkThreadID;
 
   if(RenderDoc::Inst().GetCaptureOptions().captureCallstacks)
     flags |= WriteSerialiser::ChunkCallstack;
-  else
-    flags &= ~WriteSerialiser::ChunkCallstack;
 
   m_ScratchSerialiser.SetChunkMetadataRecording(flags);
 }
@@ -2717,6 +2728,10 @@ void WrappedOpenGL::CleanupCapture()
   m_SuccessfulCapture = true;
   m_FailureReason = CaptureSucceeded;
 
+  // drop any coalesced buffer update that didn't get flushed before the capture ended
+  m_PendingBufferUpdate.record = NULL;
+  m_PendingBufferUpdate.data.clear();
+
   CleanupResourceRecord(m_ContextRecord, true);
 
   for(auto it = m_ContextData.begin(); it != m_ContextData.end(); ++it)
@@ -3419,6 +3434,12 @@ bool WrappedOpenGL::ProcessChunk(ReadSerialiser &ser, GLChunk chunk)
     {
       return GetResourceManager()->Serialise_InitialState(ser, ResourceId(), NULL, NULL);
     }
+    else if(system == SystemChunk::InitialContentsReference)
+    {
+      GetResourceManager()->CreateInitialContentsReference(ser);
+
+      SERIALISE_CHECK_READ_ERRORS();
+    }
     else if(system == SystemChunk::CaptureScope)
     {
       return Serialise_CaptureScope(ser);
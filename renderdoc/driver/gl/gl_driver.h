@@ -228,6 +228,22 @@ private:
 
   std::set<ResourceId> m_HighTrafficResources;
 
+  // pending buffer update during active capture. Consecutive glBufferSubData-style updates to
+  // the same buffer get coalesced here and flushed as a single chunk when any other chunk is
+  // about to be recorded, since UI middleware commonly streams thousands of tiny updates per
+  // frame. See TryCoalesceBufferUpdate in gl_buffer_funcs.cpp.
+  struct
+  {
+    GLResourceRecord *record = NULL;
+    GLuint buffer = 0;
+    uint64_t offset = 0;
+    bytebuf data;
+  } m_PendingBufferUpdate;
+
+  bool TryCoalesceBufferUpdate(GLResourceRecord *record, GLuint buffer, GLintptr offset,
+                               GLsizeiptr size, const void *data);
+  void FlushPendingBufferUpdate();
+
   int m_ReplayEventCount = 0;
 
   // we store two separate sets of maps, since for an explicit glMemoryBarrier
@@ -640,7 +656,13 @@ public:
   const DrawcallDescription *GetDrawcall(uint32_t eventId);
 
   void SuppressDebugMessages(bool suppress) { m_SuppressDebugMessages = suppress; }
-  rdcarray<EventUsage> GetUsage(ResourceId id) { return m_ResourceUses[id]; }
+  rdcarray<EventUsage> GetUsage(ResourceId id)
+  {
+    auto it = m_ResourceUses.find(id);
+    if(it == m_ResourceUses.end())
+      return rdcarray<EventUsage>();
+    return it->second;
+  }
   void CreateContext(GLWindowingData winData, void *shareContext, GLInitParams initParams,
                      bool core, bool attribsCreate);
   void RegisterReplayContext(GLWindowingData winData, void *shareContext, bool core,
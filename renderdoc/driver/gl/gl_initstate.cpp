@@ -23,6 +23,8 @@
  ******************************************************************************/
 
 #include <algorithm>
+#include "common/shader_cache.h"
+#include "strings/string_utils.h"
 #include "gl_driver.h"
 #include "gl_manager.h"
 
@@ -36,6 +38,70 @@ void APIENTRY _glCopyImageSubData(GLuint srcName, GLenum srcTarget, GLint srcLev
                                   GLsizei srcWidth, GLsizei srcHeight, GLsizei srcDepth);
 };
 
+static const uint32_t ProgramBinaryCacheMagic = MAKE_FOURCC('G', 'L', 'P', 'B');
+static const uint32_t ProgramBinaryCacheVersion = 1;
+
+struct GLProgramBinaryCallbacks
+{
+  bool Create(uint32_t size, byte *data, bytebuf **ret) const
+  {
+    bytebuf *blob = new bytebuf;
+    blob->resize(size);
+    memcpy(blob->data(), data, size);
+    *ret = blob;
+    return true;
+  }
+  void Destroy(bytebuf *blob) const { delete blob; }
+  uint32_t GetSize(bytebuf *blob) const { return (uint32_t)blob->size(); }
+  const byte *GetData(bytebuf *blob) const { return blob->data(); }
+} GLProgramBinaryCacheCallbacks;
+
+bytebuf *GLResourceManager::GetCachedProgramBinary(uint32_t key)
+{
+  if(!m_ProgramBinaryCacheLoaded)
+  {
+    m_ProgramBinaryCacheLoaded = true;
+    LoadShaderCache("glprograms.cache", ProgramBinaryCacheMagic, ProgramBinaryCacheVersion,
+                    m_ProgramBinaryCache, GLProgramBinaryCacheCallbacks);
+  }
+
+  auto it = m_ProgramBinaryCache.find(key);
+
+  if(it != m_ProgramBinaryCache.end())
+    return it->second;
+
+  return NULL;
+}
+
+void GLResourceManager::SetCachedProgramBinary(uint32_t key, bytebuf *blob)
+{
+  bytebuf *&entry = m_ProgramBinaryCache[key];
+
+  if(entry)
+    delete entry;
+
+  entry = blob;
+  m_ProgramBinaryCacheDirty = true;
+}
+
+void GLResourceManager::SaveProgramBinaryCache()
+{
+  if(m_ProgramBinaryCacheDirty)
+  {
+    // this destroys the entries for us
+    SaveShaderCache("glprograms.cache", ProgramBinaryCacheMagic, ProgramBinaryCacheVersion,
+                    m_ProgramBinaryCache, GLProgramBinaryCacheCallbacks);
+  }
+  else
+  {
+    for(auto it = m_ProgramBinaryCache.begin(); it != m_ProgramBinaryCache.end(); ++it)
+      GLProgramBinaryCacheCallbacks.Destroy(it->second);
+  }
+
+  m_ProgramBinaryCache.clear();
+  m_ProgramBinaryCacheDirty = false;
+}
+
 const GLenum FramebufferInitialData::attachmentNames[10] = {
     eGL_COLOR_ATTACHMENT0, eGL_COLOR_ATTACHMENT1,  eGL_COLOR_ATTACHMENT2, eGL_COLOR_ATTACHMENT3,
     eGL_COLOR_ATTACHMENT4, eGL_COLOR_ATTACHMENT5,  eGL_COLOR_ATTACHMENT6, eGL_COLOR_ATTACHMENT7,
@@ -1151,6 +1217,9 @@ bool GLResourceManager::Serialise_InitialState(SerialiserType &ser, ResourceId i
 
     bool IsProgramSPIRV = false;
 
+    uint32_t binaryKey = 0;
+    bool cacheBinary = false, restoredBinary = false;
+
     if(IsReplayingAndReading())
     {
       WrappedOpenGL::ProgramData &details = m_Driver->m_Programs[GetLiveID(id)];
@@ -1161,6 +1230,23 @@ bool GLResourceManager::Serialise_InitialState(SerialiserType &ser, ResourceId i
 
       uint32_t numShaders = 0;
 
+      // hash the shader sources as we go, to key a cache of linked program binaries - on some
+      // drivers the link below dominates capture load time. The binary is only valid for the
+      // driver that produced it, so fold the driver's identity strings into the key.
+      if(GL.glGetProgramBinary && GL.glProgramBinary)
+      {
+        GLint numFormats = 0;
+        GL.glGetIntegerv(eGL_NUM_PROGRAM_BINARY_FORMATS, &numFormats);
+
+        if(numFormats > 0)
+        {
+          cacheBinary = true;
+          binaryKey = strhash((const char *)GL.glGetString(eGL_VENDOR));
+          binaryKey = strhash((const char *)GL.glGetString(eGL_RENDERER), binaryKey);
+          binaryKey = strhash((const char *)GL.glGetString(eGL_VERSION), binaryKey);
+        }
+      }
+
       rdcarray<rdcstr> vertexOutputs;
       for(size_t i = 0; i < ARRAY_COUNT(details.stageShaders); i++)
       {
@@ -1173,6 +1259,11 @@ bool GLResourceManager::Serialise_InitialState(SerialiserType &ser, ResourceId i
 
         IsProgramSPIRV |= shadDetails.reflection.encoding == ShaderEncoding::SPIRV;
 
+        char stagestr[2] = {char('a' + ShaderIdx(shadDetails.type)), 0};
+        binaryKey = strhash(stagestr, binaryKey);
+        for(size_t s = 0; s < shadDetails.sources.size(); s++)
+          binaryKey = strhash(shadDetails.sources[s].c_str(), binaryKey);
+
         GLuint shad = drv.glCreateShader(shadDetails.type);
 
         if(shadDetails.type == eGL_VERTEX_SHADER)
@@ -1241,36 +1332,73 @@ bool GLResourceManager::Serialise_InitialState(SerialiserType &ser, ResourceId i
       if(!IsProgramSPIRV)
         drv.glTransformFeedbackVaryings(initProg, (GLsizei)vertexOutputsPtr.size(),
                                         &vertexOutputsPtr[0], eGL_INTERLEAVED_ATTRIBS);
-      drv.glLinkProgram(initProg);
+
+      // SPIR-V programs are never cached - their link cost is low and specialisation constants
+      // aren't covered by the source hash
+      cacheBinary = cacheBinary && !IsProgramSPIRV && numShaders > 0;
 
       GLint status = 0;
-      drv.glGetProgramiv(initProg, eGL_LINK_STATUS, &status);
 
-      // if it failed to link, first remove the varyings hack above as maybe the driver is barfing
-      // on trying to make some output a varying
-      if(status == 0 && !IsProgramSPIRV)
+      if(cacheBinary)
       {
-        drv.glTransformFeedbackVaryings(initProg, 0, NULL, eGL_INTERLEAVED_ATTRIBS);
-        drv.glLinkProgram(initProg);
+        bytebuf *cached = GetCachedProgramBinary(binaryKey);
 
-        drv.glGetProgramiv(initProg, eGL_LINK_STATUS, &status);
+        if(cached && cached->size() > sizeof(uint32_t))
+        {
+          // the first four bytes are the binary format, the rest is the binary itself. The
+          // shaders stay attached above so that if anything needs a re-link later (e.g. changed
+          // attrib bindings) we can still do a full link from source.
+          GLenum format = eGL_NONE;
+          memcpy(&format, cached->data(), sizeof(uint32_t));
+
+          GL.glProgramBinary(initProg, format, cached->data() + sizeof(uint32_t),
+                             (GLsizei)(cached->size() - sizeof(uint32_t)));
+
+          drv.glGetProgramiv(initProg, eGL_LINK_STATUS, &status);
+
+          // if the driver rejected the binary we fall through to a normal link below
+          restoredBinary = (status == 1);
+        }
+
+        // ask for a retrievable binary before linking so we can store this link for next time
+        if(!restoredBinary)
+          drv.glProgramParameteri(initProg, eGL_PROGRAM_BINARY_RETRIEVABLE_HINT, 1);
       }
 
-      // if it failed to link, try again as a separable program.
-      // we can't do this by default because of the silly rules meaning
-      // shaders need fixup to be separable-compatible.
-      if(status == 0)
+      if(!restoredBinary)
       {
-        drv.glProgramParameteri(initProg, eGL_PROGRAM_SEPARABLE, 1);
         drv.glLinkProgram(initProg);
 
         drv.glGetProgramiv(initProg, eGL_LINK_STATUS, &status);
+
+        // if it failed to link, first remove the varyings hack above as maybe the driver is
+        // barfing on trying to make some output a varying
+        if(status == 0 && !IsProgramSPIRV)
+        {
+          drv.glTransformFeedbackVaryings(initProg, 0, NULL, eGL_INTERLEAVED_ATTRIBS);
+          drv.glLinkProgram(initProg);
+
+          drv.glGetProgramiv(initProg, eGL_LINK_STATUS, &status);
+        }
+
+        // if it failed to link, try again as a separable program.
+        // we can't do this by default because of the silly rules meaning
+        // shaders need fixup to be separable-compatible.
+        if(status == 0)
+        {
+          drv.glProgramParameteri(initProg, eGL_PROGRAM_SEPARABLE, 1);
+          drv.glLinkProgram(initProg);
+
+          drv.glGetProgramiv(initProg, eGL_LINK_STATUS, &status);
+        }
       }
 
       m_Driver->SuppressDebugMessages(false);
 
       if(status == 0)
       {
+        cacheBinary = false;
+
         if(numShaders == 0)
         {
           RDCWARN("No shaders attached to program");
@@ -1322,6 +1450,39 @@ bool GLResourceManager::Serialise_InitialState(SerialiserType &ser, ResourceId i
       // identical)
       CopyProgramUniforms(stages, uniformsProgram, stages, bindingsProgram);
 
+      if(cacheBinary && !restoredBinary)
+      {
+        // store the final linked binary, with this capture's attrib bindings applied, so the next
+        // load skips the link. Any baked-in uniform values are harmless since the uniform copy
+        // above always runs. If another capture's program shares the sources with different
+        // bindings, the serialised bindings won't match the restored binary and the re-link above
+        // puts things right, costing only the cache benefit.
+        GLint len = 0;
+        GL.glGetProgramiv(bindingsProgram, eGL_PROGRAM_BINARY_LENGTH, &len);
+
+        if(len > 0)
+        {
+          bytebuf *blob = new bytebuf;
+          blob->resize((size_t)len + sizeof(uint32_t));
+
+          GLenum format = eGL_NONE;
+          GLsizei retLen = 0;
+          GL.glGetProgramBinary(bindingsProgram, len, &retLen, &format,
+                                blob->data() + sizeof(uint32_t));
+
+          if(retLen > 0 && format != eGL_NONE)
+          {
+            memcpy(blob->data(), &format, sizeof(uint32_t));
+            blob->resize((size_t)retLen + sizeof(uint32_t));
+            SetCachedProgramBinary(binaryKey, blob);
+          }
+          else
+          {
+            delete blob;
+          }
+        }
+      }
+
       SetInitialContents(id, GLInitialContents(ProgramRes(m_Driver->GetCtx(), bindingsProgram), 0));
     }
   }
@@ -1599,6 +1760,73 @@ bool GLResourceManager::Serialise_InitialState(SerialiserType &ser, ResourceId i
           // to avoid repeated new/free.
           byte *scratchBuf = AllocAlignedBuffer(size);
 
+          // on desktop GL when writing, stage the readbacks through a pair of pixel pack buffers
+          // with fences: the fetch of the next subresource is issued before the current one is
+          // consumed, so the GPU transfers into one pack buffer while the CPU serialises and
+          // compresses the other, instead of a full pipeline sync inside every glGetTexImage.
+          GLuint packBufs[2] = {0, 0};
+          GLsync packFences[2] = {NULL, NULL};
+
+          struct PackedFetch
+          {
+            GLenum target;
+            int mip;
+            uint32_t size;
+          };
+          rdcarray<PackedFetch> fetchOrder;
+          uint32_t fetchIssued = 0, fetchConsumed = 0;
+
+          bool asyncReadback = ser.IsWriting() && !IsGLES;
+
+          if(asyncReadback)
+          {
+            // flatten the subresource traversal below so we can look one fetch ahead
+            for(int i = 0; i < TextureState.mips; i++)
+            {
+              uint32_t w = RDCMAX(TextureState.width >> i, 1U);
+              uint32_t h = RDCMAX(TextureState.height >> i, 1U);
+              uint32_t d = RDCMAX(TextureState.depth >> i, 1U);
+
+              if(targets[0] == eGL_TEXTURE_CUBE_MAP_ARRAY || targets[0] == eGL_TEXTURE_2D_ARRAY)
+                d = copySlices;
+
+              if(targets[0] == eGL_TEXTURE_1D_ARRAY)
+                h = TextureState.height;
+
+              uint32_t subSize;
+              if(isCompressed)
+                subSize = (uint32_t)GetCompressedByteSize(w, h, d, TextureState.internalformat);
+              else
+                subSize = (uint32_t)GetByteSize(w, h, d, fmt, type);
+
+              for(int trg = 0; trg < targetcount; trg++)
+                fetchOrder.push_back({targets[trg], i, subSize});
+            }
+
+            // both pack buffers are sized for the largest subresource, like the scratch buffer
+            GL.glGenBuffers(2, packBufs);
+            GL.glNamedBufferDataEXT(packBufs[0], (GLsizeiptr)size, NULL, eGL_STREAM_READ);
+            GL.glNamedBufferDataEXT(packBufs[1], (GLsizeiptr)size, NULL, eGL_STREAM_READ);
+          }
+
+          auto issueFetch = [&fetchOrder, &fetchIssued, &packBufs, &packFences, isCompressed, tex,
+                             fmt, type]() {
+            const PackedFetch &fetch = fetchOrder[fetchIssued];
+
+            GL.glBindBuffer(eGL_PIXEL_PACK_BUFFER, packBufs[fetchIssued % 2]);
+
+            if(isCompressed)
+              GL.glGetCompressedTextureImageEXT(tex, fetch.target, fetch.mip, NULL);
+            else
+              GL.glGetTexImage(fetch.target, fetch.mip, fmt, type, NULL);
+
+            packFences[fetchIssued % 2] = GL.glFenceSync(eGL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+
+            GL.glBindBuffer(eGL_PIXEL_PACK_BUFFER, 0);
+
+            fetchIssued++;
+          };
+
           // loop over all the available mips
           for(int i = 0; i < TextureState.mips; i++)
           {
@@ -1624,7 +1852,25 @@ bool GLResourceManager::Serialise_InitialState(SerialiserType &ser, ResourceId i
               // when writing, fetch the source data out of the texture
               if(ser.IsWriting())
               {
-                if(isCompressed)
+                if(asyncReadback)
+                {
+                  // issue this subresource's fetch (if the previous iteration's lookahead didn't
+                  // already) plus the next one, then wait for this one's transfer and copy it out
+                  // of its pack buffer
+                  while(fetchIssued <= fetchConsumed + 1 && fetchIssued < fetchOrder.size())
+                    issueFetch();
+
+                  uint32_t bufIdx = fetchConsumed % 2;
+
+                  GL.glClientWaitSync(packFences[bufIdx], eGL_SYNC_FLUSH_COMMANDS_BIT, ~0ULL);
+                  GL.glDeleteSync(packFences[bufIdx]);
+                  packFences[bufIdx] = NULL;
+
+                  GL.glGetNamedBufferSubDataEXT(packBufs[bufIdx], 0, (GLsizeiptr)size, scratchBuf);
+
+                  fetchConsumed++;
+                }
+                else if(isCompressed)
                 {
                   if(IsGLES)
                     details.GetCompressedImageDataGLES(i, targets[trg], size, scratchBuf);
@@ -1683,6 +1929,14 @@ bool GLResourceManager::Serialise_InitialState(SerialiserType &ser, ResourceId i
             }
           }
 
+          if(asyncReadback)
+          {
+            for(size_t b = 0; b < 2; b++)
+              if(packFences[b])
+                GL.glDeleteSync(packFences[b]);
+            GL.glDeleteBuffers(2, packBufs);
+          }
+
           // free our scratch buffer
           FreeAlignedBuffer(scratchBuf);
         }
@@ -276,6 +276,14 @@ public:
   bool Serialise_InitialState(WriteSerialiser &ser, ResourceId id, GLResourceRecord *record,
                               const GLInitialContents *initial);
 
+  // cache of linked program binaries used when applying program initial state on replay, keyed by
+  // a hash of the shader sources and persisted to disk so repeat loads skip the driver's link.
+  // Each blob stores the binary format in its first four bytes. A NULL return means no cached
+  // binary - the caller links as normal and stores the result.
+  bytebuf *GetCachedProgramBinary(uint32_t key);
+  void SetCachedProgramBinary(uint32_t key, bytebuf *blob);
+  void SaveProgramBinaryCache();
+
   void ContextPrepare_InitialState(GLResource res);
 
   void SetInternalResource(GLResource res);
@@ -301,5 +309,8 @@ private:
   std::map<ResourceId, rdcstr> m_Names;
   volatile int64_t m_SyncName;
 
+  std::map<uint32_t, bytebuf *> m_ProgramBinaryCache;
+  bool m_ProgramBinaryCacheLoaded = false, m_ProgramBinaryCacheDirty = false;
+
   WrappedOpenGL *m_Driver;
 };
@@ -176,7 +176,10 @@ void WrappedOpenGL::CopyTex2DMSToArray(GLuint &destArray, GLuint srcMS, GLint wi
   GLMarkerRegion renderoverlay("CopyTex2DMSToArray");
 
   GLRenderState rs;
-  rs.FetchState(this);
+  // the compute copy below only disturbs the program, the first texture unit and image bindings
+  rs.FetchState(this, GLRenderState::ePart_Textures | GLRenderState::ePart_Images |
+                          GLRenderState::ePart_Program,
+                1);
 
   GLenum viewClass;
   GL.glGetInternalformativ(eGL_TEXTURE_2D_ARRAY, intFormat, eGL_VIEW_COMPATIBILITY_CLASS,
@@ -236,7 +239,14 @@ void WrappedOpenGL::CopyDepthTex2DMSToArray(GLuint &destArray, GLuint srcMS, GLi
   const ArrayMSPrograms &arrms = GetArrayMS();
 
   GLRenderState rs;
-  rs.FetchState(this);
+  // the draws below touch most fixed-function state but no buffer or image bindings, and only the
+  // first two texture units
+  rs.FetchState(this,
+                GLRenderState::ePart_Enables | GLRenderState::ePart_Textures |
+                    GLRenderState::ePart_Vertex | GLRenderState::ePart_Program |
+                    GLRenderState::ePart_ViewScissor | GLRenderState::ePart_Framebuffers |
+                    GLRenderState::ePart_PixelOps | GLRenderState::ePart_Raster,
+                2);
 
   GLuint vao = 0;
   drv.glGenVertexArrays(1, &vao);
@@ -397,7 +407,10 @@ void WrappedOpenGL::CopyArrayToTex2DMS(GLuint destMS, GLuint srcArray, GLint wid
   bool singleSliceMode = (selectedSlice != ~0U);
 
   GLRenderState rs;
-  rs.FetchState(this);
+  // the compute copy below only disturbs the program, the first texture unit and image bindings
+  rs.FetchState(this, GLRenderState::ePart_Textures | GLRenderState::ePart_Images |
+                          GLRenderState::ePart_Program,
+                1);
 
   GLenum viewClass;
   drv.glGetInternalformativ(eGL_TEXTURE_2D_ARRAY, intFormat, eGL_VIEW_COMPATIBILITY_CLASS,
@@ -474,7 +487,14 @@ void WrappedOpenGL::CopyDepthArrayToTex2DMS(GLuint destMS, GLuint srcArray, GLin
   const ArrayMSPrograms &arrms = GetArrayMS();
 
   GLRenderState rs;
-  rs.FetchState(this);
+  // the draws below touch most fixed-function state but no buffer or image bindings, and only the
+  // first two texture units
+  rs.FetchState(this,
+                GLRenderState::ePart_Enables | GLRenderState::ePart_Textures |
+                    GLRenderState::ePart_Vertex | GLRenderState::ePart_Program |
+                    GLRenderState::ePart_ViewScissor | GLRenderState::ePart_Framebuffers |
+                    GLRenderState::ePart_PixelOps | GLRenderState::ePart_Raster,
+                2);
 
   GLuint vao = 0;
   drv.glGenVertexArrays(1, &vao);
@@ -1411,6 +1411,8 @@ bool SerialiseProgramBindings(SerialiserType &ser, CaptureState state,
   SERIALISE_ELEMENT(InputBindings);
   SERIALISE_ELEMENT(OutputBindings);
 
+  bool changed = false;
+
   if(ser.IsReading() && IsReplayMode(state) && !IsProgramSPIRV)
   {
     for(int sigType = 0; sigType < 2; sigType++)
@@ -1441,13 +1443,24 @@ bool SerialiseProgramBindings(SerialiserType &ser, CaptureState state,
 
           if(sigType == 0)
           {
+            // skip the bind if the location already matches, so that when nothing changes the
+            // caller can skip an expensive re-link of the program
+            if(GL.glGetAttribLocation(prog, bind.Name.c_str()) == bind.Binding)
+              continue;
+
             GL.glBindAttribLocation(prog, (GLuint)bind.Binding, bind.Name.c_str());
+            changed = true;
           }
           else
           {
             if(GL.glBindFragDataLocation)
             {
+              if(GL.glGetFragDataLocation &&
+                 GL.glGetFragDataLocation(prog, bind.Name.c_str()) == bind.Binding)
+                continue;
+
               GL.glBindFragDataLocation(prog, (GLuint)bind.Binding, bind.Name.c_str());
+              changed = true;
             }
             else
             {
@@ -1461,7 +1474,7 @@ bool SerialiseProgramBindings(SerialiserType &ser, CaptureState state,
     }
   }
 
-  return !IsProgramSPIRV && (!InputBindings.empty() || !OutputBindings.empty());
+  return !IsProgramSPIRV && changed;
 }
 
 template bool SerialiseProgramBindings(ReadSerialiser &ser, CaptureState state,
@@ -721,7 +721,7 @@ bool GLRenderState::CheckEnableDisableParam(GLenum pname)
   return true;
 }
 
-void GLRenderState::FetchState(WrappedOpenGL *driver)
+void GLRenderState::FetchState(WrappedOpenGL *driver, uint32_t parts, uint32_t texUnits)
 {
   ContextPair &ctx = driver->GetCtx();
 
@@ -731,19 +731,23 @@ void GLRenderState::FetchState(WrappedOpenGL *driver)
     return;
   }
 
-  for(GLuint i = 0; i < eEnabled_Count; i++)
+  FetchedParts = parts;
+  FetchedTexUnits = texUnits;
+
+  if(parts & ePart_Enables)
   {
-    if(!CheckEnableDisableParam(enable_disable_cap[i].cap))
+    for(GLuint i = 0; i < eEnabled_Count; i++)
     {
-      Enabled[i] = false;
-      continue;
-    }
+      if(!CheckEnableDisableParam(enable_disable_cap[i].cap))
+      {
+        Enabled[i] = false;
+        continue;
+      }
 
-    Enabled[i] = (GL.glIsEnabled(enable_disable_cap[i].cap) == GL_TRUE);
+      Enabled[i] = (GL.glIsEnabled(enable_disable_cap[i].cap) == GL_TRUE);
+    }
   }
 
-  GL.glGetIntegerv(eGL_ACTIVE_TEXTURE, (GLint *)&ActiveTexture);
-
   GLuint maxTextures = 0;
   GL.glGetIntegerv(eGL_MAX_COMBINED_TEXTURE_IMAGE_UNITS, (GLint *)&maxTextures);
 
@@ -756,72 +760,79 @@ void GLRenderState::FetchState(WrappedOpenGL *driver)
           sizeof(Tex2DMSArray) == sizeof(Samplers),
       "All texture arrays should be identically sized");
 
-  for(GLuint i = 0; i < RDCMIN(maxTextures, (GLuint)ARRAY_COUNT(Tex2D)); i++)
+  if(parts & ePart_Textures)
   {
-    GL.glActiveTexture(GLenum(eGL_TEXTURE0 + i));
-
-    // textures are always shared
-    Tex1D[i].ContextShareGroup = ctx.shareGroup;
-    Tex2D[i].ContextShareGroup = ctx.shareGroup;
-    Tex3D[i].ContextShareGroup = ctx.shareGroup;
-    Tex1DArray[i].ContextShareGroup = ctx.shareGroup;
-    Tex2DArray[i].ContextShareGroup = ctx.shareGroup;
-    TexCube[i].ContextShareGroup = ctx.shareGroup;
-    TexRect[i].ContextShareGroup = ctx.shareGroup;
-    TexBuffer[i].ContextShareGroup = ctx.shareGroup;
-    Tex2DMS[i].ContextShareGroup = ctx.shareGroup;
-    Tex2DMSArray[i].ContextShareGroup = ctx.shareGroup;
-    TexCubeArray[i].ContextShareGroup = ctx.shareGroup;
-    Samplers[i].ContextShareGroup = ctx.shareGroup;
+    GL.glGetIntegerv(eGL_ACTIVE_TEXTURE, (GLint *)&ActiveTexture);
 
-    if(!IsGLES)
-      GL.glGetIntegerv(eGL_TEXTURE_BINDING_1D, (GLint *)&Tex1D[i].name);
-    else
-      Tex1D[i].name = 0;
+    for(GLuint i = 0; i < RDCMIN(RDCMIN(maxTextures, (GLuint)ARRAY_COUNT(Tex2D)), texUnits); i++)
+    {
+      GL.glActiveTexture(GLenum(eGL_TEXTURE0 + i));
 
-    GL.glGetIntegerv(eGL_TEXTURE_BINDING_2D, (GLint *)&Tex2D[i].name);
-    GL.glGetIntegerv(eGL_TEXTURE_BINDING_3D, (GLint *)&Tex3D[i].name);
+      // textures are always shared
+      Tex1D[i].ContextShareGroup = ctx.shareGroup;
+      Tex2D[i].ContextShareGroup = ctx.shareGroup;
+      Tex3D[i].ContextShareGroup = ctx.shareGroup;
+      Tex1DArray[i].ContextShareGroup = ctx.shareGroup;
+      Tex2DArray[i].ContextShareGroup = ctx.shareGroup;
+      TexCube[i].ContextShareGroup = ctx.shareGroup;
+      TexRect[i].ContextShareGroup = ctx.shareGroup;
+      TexBuffer[i].ContextShareGroup = ctx.shareGroup;
+      Tex2DMS[i].ContextShareGroup = ctx.shareGroup;
+      Tex2DMSArray[i].ContextShareGroup = ctx.shareGroup;
+      TexCubeArray[i].ContextShareGroup = ctx.shareGroup;
+      Samplers[i].ContextShareGroup = ctx.shareGroup;
+
+      if(!IsGLES)
+        GL.glGetIntegerv(eGL_TEXTURE_BINDING_1D, (GLint *)&Tex1D[i].name);
+      else
+        Tex1D[i].name = 0;
 
-    if(!IsGLES)
-      GL.glGetIntegerv(eGL_TEXTURE_BINDING_1D_ARRAY, (GLint *)&Tex1DArray[i].name);
-    else
-      Tex1DArray[i].name = 0;
+      GL.glGetIntegerv(eGL_TEXTURE_BINDING_2D, (GLint *)&Tex2D[i].name);
+      GL.glGetIntegerv(eGL_TEXTURE_BINDING_3D, (GLint *)&Tex3D[i].name);
 
-    GL.glGetIntegerv(eGL_TEXTURE_BINDING_2D_ARRAY, (GLint *)&Tex2DArray[i].name);
-    GL.glGetIntegerv(eGL_TEXTURE_BINDING_CUBE_MAP, (GLint *)&TexCube[i].name);
+      if(!IsGLES)
+        GL.glGetIntegerv(eGL_TEXTURE_BINDING_1D_ARRAY, (GLint *)&Tex1DArray[i].name);
+      else
+        Tex1DArray[i].name = 0;
 
-    if(!IsGLES)
-      GL.glGetIntegerv(eGL_TEXTURE_BINDING_RECTANGLE, (GLint *)&TexRect[i].name);
-    else
-      TexRect[i].name = 0;
+      GL.glGetIntegerv(eGL_TEXTURE_BINDING_2D_ARRAY, (GLint *)&Tex2DArray[i].name);
+      GL.glGetIntegerv(eGL_TEXTURE_BINDING_CUBE_MAP, (GLint *)&TexCube[i].name);
 
-    if(HasExt[ARB_texture_buffer_object])
-      GL.glGetIntegerv(eGL_TEXTURE_BINDING_BUFFER, (GLint *)&TexBuffer[i].name);
-    else
-      TexBuffer[i].name = 0;
+      if(!IsGLES)
+        GL.glGetIntegerv(eGL_TEXTURE_BINDING_RECTANGLE, (GLint *)&TexRect[i].name);
+      else
+        TexRect[i].name = 0;
 
-    if(HasExt[ARB_texture_multisample_no_array] || HasExt[ARB_texture_multisample])
-      GL.glGetIntegerv(eGL_TEXTURE_BINDING_2D_MULTISAMPLE, (GLint *)&Tex2DMS[i].name);
-    else
-      Tex2DMS[i].name = 0;
+      if(HasExt[ARB_texture_buffer_object])
+        GL.glGetIntegerv(eGL_TEXTURE_BINDING_BUFFER, (GLint *)&TexBuffer[i].name);
+      else
+        TexBuffer[i].name = 0;
 
-    if(HasExt[ARB_texture_multisample])
-      GL.glGetIntegerv(eGL_TEXTURE_BINDING_2D_MULTISAMPLE_ARRAY, (GLint *)&Tex2DMSArray[i].name);
-    else
-      Tex2DMSArray[i].name = 0;
+      if(HasExt[ARB_texture_multisample_no_array] || HasExt[ARB_texture_multisample])
+        GL.glGetIntegerv(eGL_TEXTURE_BINDING_2D_MULTISAMPLE, (GLint *)&Tex2DMS[i].name);
+      else
+        Tex2DMS[i].name = 0;
 
-    if(HasExt[ARB_texture_cube_map_array])
-      GL.glGetIntegerv(eGL_TEXTURE_BINDING_CUBE_MAP_ARRAY, (GLint *)&TexCubeArray[i].name);
-    else
-      TexCubeArray[i].name = 0;
+      if(HasExt[ARB_texture_multisample])
+        GL.glGetIntegerv(eGL_TEXTURE_BINDING_2D_MULTISAMPLE_ARRAY, (GLint *)&Tex2DMSArray[i].name);
+      else
+        Tex2DMSArray[i].name = 0;
 
-    if(HasExt[ARB_sampler_objects])
-      GL.glGetIntegerv(eGL_SAMPLER_BINDING, (GLint *)&Samplers[i].name);
-    else
-      Samplers[i].name = 0;
+      if(HasExt[ARB_texture_cube_map_array])
+        GL.glGetIntegerv(eGL_TEXTURE_BINDING_CUBE_MAP_ARRAY, (GLint *)&TexCubeArray[i].name);
+      else
+        TexCubeArray[i].name = 0;
+
+      if(HasExt[ARB_sampler_objects])
+        GL.glGetIntegerv(eGL_SAMPLER_BINDING, (GLint *)&Samplers[i].name);
+      else
+        Samplers[i].name = 0;
+    }
+
+    GL.glActiveTexture(ActiveTexture);
   }
 
-  if(HasExt[ARB_shader_image_load_store])
+  if((parts & ePart_Images) && HasExt[ARB_shader_image_load_store])
   {
     GLuint maxImages = 0;
     GL.glGetIntegerv(eGL_MAX_IMAGE_UNITS, (GLint *)&maxImages);
@@ -844,465 +855,494 @@ void GLRenderState::FetchState(WrappedOpenGL *driver)
     }
   }
 
-  GL.glActiveTexture(ActiveTexture);
-
-  {
-    GLuint name = 0;
-    GL.glGetIntegerv(eGL_VERTEX_ARRAY_BINDING, (GLint *)&name);
-    VAO = VertexArrayRes(ctx, name);
-  }
-
-  if(HasExt[ARB_transform_feedback2])
+  if(parts & ePart_Vertex)
   {
-    GLuint name = 0;
-    GL.glGetIntegerv(eGL_TRANSFORM_FEEDBACK_BINDING, (GLint *)&name);
-    FeedbackObj = FeedbackRes(ctx, name);
-  }
+    {
+      GLuint name = 0;
+      GL.glGetIntegerv(eGL_VERTEX_ARRAY_BINDING, (GLint *)&name);
+      VAO = VertexArrayRes(ctx, name);
+    }
 
-  // the spec says that you can only query for the format that was previously set, or you get
-  // undefined results. Ie. if someone set ints, this might return anything. However there's also
-  // no way to query for the type so we just have to hope for the best and hope most people are
-  // sane and don't use these except for a default "all 0s" attrib.
+    if(HasExt[ARB_transform_feedback2])
+    {
+      GLuint name = 0;
+      GL.glGetIntegerv(eGL_TRANSFORM_FEEDBACK_BINDING, (GLint *)&name);
+      FeedbackObj = FeedbackRes(ctx, name);
+    }
 
-  GLuint maxNumAttribs = 0;
-  GL.glGetIntegerv(eGL_MAX_VERTEX_ATTRIBS, (GLint *)&maxNumAttribs);
-  for(GLuint i = 0; i < RDCMIN(maxNumAttribs, (GLuint)ARRAY_COUNT(GenericVertexAttribs)); i++)
-    GL.glGetVertexAttribfv(i, eGL_CURRENT_VERTEX_ATTRIB, &GenericVertexAttribs[i].x);
+    // the spec says that you can only query for the format that was previously set, or you get
+    // undefined results. Ie. if someone set ints, this might return anything. However there's also
+    // no way to query for the type so we just have to hope for the best and hope most people are
+    // sane and don't use these except for a default "all 0s" attrib.
 
-  GL.glGetFloatv(eGL_LINE_WIDTH, &LineWidth);
-  if(!IsGLES)
-  {
-    GL.glGetFloatv(eGL_POINT_FADE_THRESHOLD_SIZE, &PointFadeThresholdSize);
-    GL.glGetIntegerv(eGL_POINT_SPRITE_COORD_ORIGIN, (GLint *)&PointSpriteOrigin);
-    GL.glGetFloatv(eGL_POINT_SIZE, &PointSize);
+    GLuint maxNumAttribs = 0;
+    GL.glGetIntegerv(eGL_MAX_VERTEX_ATTRIBS, (GLint *)&maxNumAttribs);
+    for(GLuint i = 0; i < RDCMIN(maxNumAttribs, (GLuint)ARRAY_COUNT(GenericVertexAttribs)); i++)
+      GL.glGetVertexAttribfv(i, eGL_CURRENT_VERTEX_ATTRIB, &GenericVertexAttribs[i].x);
   }
 
-  if(!IsGLES)
-    GL.glGetIntegerv(eGL_PRIMITIVE_RESTART_INDEX, (GLint *)&PrimitiveRestartIndex);
-  if(HasExt[ARB_clip_control])
+  if(parts & ePart_Raster)
   {
-    GL.glGetIntegerv(eGL_CLIP_ORIGIN, (GLint *)&ClipOrigin);
-    GL.glGetIntegerv(eGL_CLIP_DEPTH_MODE, (GLint *)&ClipDepth);
-  }
-  else
-  {
-    ClipOrigin = eGL_LOWER_LEFT;
-    ClipDepth = eGL_NEGATIVE_ONE_TO_ONE;
-  }
-  if(!IsGLES)
-    GL.glGetIntegerv(eGL_PROVOKING_VERTEX, (GLint *)&ProvokingVertex);
+    GL.glGetFloatv(eGL_LINE_WIDTH, &LineWidth);
+    if(!IsGLES)
+    {
+      GL.glGetFloatv(eGL_POINT_FADE_THRESHOLD_SIZE, &PointFadeThresholdSize);
+      GL.glGetIntegerv(eGL_POINT_SPRITE_COORD_ORIGIN, (GLint *)&PointSpriteOrigin);
+      GL.glGetFloatv(eGL_POINT_SIZE, &PointSize);
+    }
 
-  {
-    GLuint name = 0;
-    GL.glGetIntegerv(eGL_CURRENT_PROGRAM, (GLint *)&name);
-    Program = ProgramRes(ctx, name);
+    if(!IsGLES)
+      GL.glGetIntegerv(eGL_PRIMITIVE_RESTART_INDEX, (GLint *)&PrimitiveRestartIndex);
+    if(HasExt[ARB_clip_control])
+    {
+      GL.glGetIntegerv(eGL_CLIP_ORIGIN, (GLint *)&ClipOrigin);
+      GL.glGetIntegerv(eGL_CLIP_DEPTH_MODE, (GLint *)&ClipDepth);
+    }
+    else
+    {
+      ClipOrigin = eGL_LOWER_LEFT;
+      ClipDepth = eGL_NEGATIVE_ONE_TO_ONE;
+    }
+    if(!IsGLES)
+      GL.glGetIntegerv(eGL_PROVOKING_VERTEX, (GLint *)&ProvokingVertex);
   }
 
-  if(HasExt[ARB_separate_shader_objects])
-  {
-    GLuint name = 0;
-    GL.glGetIntegerv(eGL_PROGRAM_PIPELINE_BINDING, (GLint *)&name);
-    Pipeline = ProgramPipeRes(ctx, name);
-  }
-  else
+  if(parts & ePart_Program)
   {
-    Pipeline = ProgramRes(ctx, 0);
-  }
+    {
+      GLuint name = 0;
+      GL.glGetIntegerv(eGL_CURRENT_PROGRAM, (GLint *)&name);
+      Program = ProgramRes(ctx, name);
+    }
 
-  const GLenum shs[] = {
-      eGL_VERTEX_SHADER,   eGL_TESS_CONTROL_SHADER, eGL_TESS_EVALUATION_SHADER,
-      eGL_GEOMETRY_SHADER, eGL_FRAGMENT_SHADER,     eGL_COMPUTE_SHADER,
-  };
+    if(HasExt[ARB_separate_shader_objects])
+    {
+      GLuint name = 0;
+      GL.glGetIntegerv(eGL_PROGRAM_PIPELINE_BINDING, (GLint *)&name);
+      Pipeline = ProgramPipeRes(ctx, name);
+    }
+    else
+    {
+      Pipeline = ProgramRes(ctx, 0);
+    }
 
-  if(HasExt[ARB_shader_subroutine])
-  {
-    RDCCOMPILE_ASSERT(ARRAY_COUNT(shs) == ARRAY_COUNT(Subroutines),
-                      "Subroutine array not the right size");
+    const GLenum shs[] = {
+        eGL_VERTEX_SHADER,   eGL_TESS_CONTROL_SHADER, eGL_TESS_EVALUATION_SHADER,
+        eGL_GEOMETRY_SHADER, eGL_FRAGMENT_SHADER,     eGL_COMPUTE_SHADER,
+    };
 
-    for(size_t s = 0; s < ARRAY_COUNT(shs); s++)
+    if(HasExt[ARB_shader_subroutine])
     {
-      if(shs[s] == eGL_COMPUTE_SHADER && !HasExt[ARB_compute_shader])
-        continue;
-
-      if((shs[s] == eGL_TESS_CONTROL_SHADER || shs[s] == eGL_TESS_EVALUATION_SHADER) &&
-         !HasExt[ARB_tessellation_shader])
-        continue;
+      RDCCOMPILE_ASSERT(ARRAY_COUNT(shs) == ARRAY_COUNT(Subroutines),
+                        "Subroutine array not the right size");
 
-      GLuint prog = Program.name;
-      if(prog == 0 && Pipeline.name != 0)
+      for(size_t s = 0; s < ARRAY_COUNT(shs); s++)
       {
-        // can't query for GL_COMPUTE_SHADER on some AMD cards
-        if(shs[s] != eGL_COMPUTE_SHADER || !VendorCheck[VendorCheck_AMD_pipeline_compute_query])
-          GL.glGetProgramPipelineiv(Pipeline.name, shs[s], (GLint *)&prog);
-      }
+        if(shs[s] == eGL_COMPUTE_SHADER && !HasExt[ARB_compute_shader])
+          continue;
 
-      if(prog == 0)
-        continue;
+        if((shs[s] == eGL_TESS_CONTROL_SHADER || shs[s] == eGL_TESS_EVALUATION_SHADER) &&
+           !HasExt[ARB_tessellation_shader])
+          continue;
+
+        GLuint prog = Program.name;
+        if(prog == 0 && Pipeline.name != 0)
+        {
+          // can't query for GL_COMPUTE_SHADER on some AMD cards
+          if(shs[s] != eGL_COMPUTE_SHADER || !VendorCheck[VendorCheck_AMD_pipeline_compute_query])
+            GL.glGetProgramPipelineiv(Pipeline.name, shs[s], (GLint *)&prog);
+        }
 
-      GLint numSubroutines = 0;
-      GL.glGetProgramStageiv(prog, shs[s], eGL_ACTIVE_SUBROUTINES, &numSubroutines);
+        if(prog == 0)
+          continue;
 
-      if(numSubroutines == 0)
-        continue;
+        GLint numSubroutines = 0;
+        GL.glGetProgramStageiv(prog, shs[s], eGL_ACTIVE_SUBROUTINES, &numSubroutines);
 
-      GL.glGetProgramStageiv(prog, shs[s], eGL_ACTIVE_SUBROUTINE_UNIFORM_LOCATIONS,
-                             &Subroutines[s].numSubroutines);
+        if(numSubroutines == 0)
+          continue;
 
-      for(GLint i = 0; i < Subroutines[s].numSubroutines; i++)
-        GL.glGetUniformSubroutineuiv(shs[s], i, &Subroutines[s].Values[0]);
+        GL.glGetProgramStageiv(prog, shs[s], eGL_ACTIVE_SUBROUTINE_UNIFORM_LOCATIONS,
+                               &Subroutines[s].numSubroutines);
+
+        for(GLint i = 0; i < Subroutines[s].numSubroutines; i++)
+          GL.glGetUniformSubroutineuiv(shs[s], i, &Subroutines[s].Values[0]);
+      }
+    }
+    else
+    {
+      RDCEraseEl(Subroutines);
     }
-  }
-  else
-  {
-    RDCEraseEl(Subroutines);
   }
 
-  // buffers are always shared
-  for(size_t i = 0; i < ARRAY_COUNT(BufferBindings); i++)
-    BufferBindings[i].ContextShareGroup = ctx.shareGroup;
-
-  GL.glGetIntegerv(eGL_ARRAY_BUFFER_BINDING, (GLint *)&BufferBindings[eBufIdx_Array].name);
-  GL.glGetIntegerv(eGL_COPY_READ_BUFFER_BINDING, (GLint *)&BufferBindings[eBufIdx_Copy_Read].name);
-  GL.glGetIntegerv(eGL_COPY_WRITE_BUFFER_BINDING, (GLint *)&BufferBindings[eBufIdx_Copy_Write].name);
-  GL.glGetIntegerv(eGL_PIXEL_PACK_BUFFER_BINDING, (GLint *)&BufferBindings[eBufIdx_Pixel_Pack].name);
-  GL.glGetIntegerv(eGL_PIXEL_UNPACK_BUFFER_BINDING,
-                   (GLint *)&BufferBindings[eBufIdx_Pixel_Unpack].name);
-  if(HasExt[ARB_texture_buffer_object])
-    GL.glGetIntegerv(eGL_TEXTURE_BUFFER_BINDING, (GLint *)&BufferBindings[eBufIdx_Texture].name);
-
-  if(HasExt[ARB_draw_indirect])
-    GL.glGetIntegerv(eGL_DRAW_INDIRECT_BUFFER_BINDING,
-                     (GLint *)&BufferBindings[eBufIdx_Draw_Indirect].name);
-  if(HasExt[ARB_compute_shader])
-    GL.glGetIntegerv(eGL_DISPATCH_INDIRECT_BUFFER_BINDING,
-                     (GLint *)&BufferBindings[eBufIdx_Dispatch_Indirect].name);
-  if(HasExt[ARB_query_buffer_object])
-    GL.glGetIntegerv(eGL_QUERY_BUFFER_BINDING, (GLint *)&BufferBindings[eBufIdx_Query].name);
-  if(HasExt[ARB_indirect_parameters])
-    GL.glGetIntegerv(eGL_PARAMETER_BUFFER_BINDING_ARB,
-                     (GLint *)&BufferBindings[eBufIdx_Parameter].name);
-
-  struct
+  if(parts & ePart_Buffers)
   {
-    IdxRangeBuffer *bufs;
-    int count;
-    GLenum binding;
-    GLenum start;
-    GLenum size;
-    GLenum maxcount;
-  } idxBufs[] = {
-      {
-          AtomicCounter, ARRAY_COUNT(AtomicCounter), eGL_ATOMIC_COUNTER_BUFFER_BINDING,
-          eGL_ATOMIC_COUNTER_BUFFER_START, eGL_ATOMIC_COUNTER_BUFFER_SIZE,
-          eGL_MAX_ATOMIC_COUNTER_BUFFER_BINDINGS,
-      },
-      {
-          ShaderStorage, ARRAY_COUNT(ShaderStorage), eGL_SHADER_STORAGE_BUFFER_BINDING,
-          eGL_SHADER_STORAGE_BUFFER_START, eGL_SHADER_STORAGE_BUFFER_SIZE,
-          eGL_MAX_SHADER_STORAGE_BUFFER_BINDINGS,
-      },
-      {
-          TransformFeedback, ARRAY_COUNT(TransformFeedback), eGL_TRANSFORM_FEEDBACK_BUFFER_BINDING,
-          eGL_TRANSFORM_FEEDBACK_BUFFER_START, eGL_TRANSFORM_FEEDBACK_BUFFER_SIZE,
-          eGL_MAX_TRANSFORM_FEEDBACK_SEPARATE_ATTRIBS,
-      },
-      {
-          UniformBinding, ARRAY_COUNT(UniformBinding), eGL_UNIFORM_BUFFER_BINDING,
-          eGL_UNIFORM_BUFFER_START, eGL_UNIFORM_BUFFER_SIZE, eGL_MAX_UNIFORM_BUFFER_BINDINGS,
-      },
-  };
+    // buffers are always shared
+    for(size_t i = 0; i < ARRAY_COUNT(BufferBindings); i++)
+      BufferBindings[i].ContextShareGroup = ctx.shareGroup;
 
-  for(GLuint b = 0; b < (GLuint)ARRAY_COUNT(idxBufs); b++)
-  {
-    if(idxBufs[b].binding == eGL_ATOMIC_COUNTER_BUFFER_BINDING && !HasExt[ARB_shader_atomic_counters])
-      continue;
+    GL.glGetIntegerv(eGL_ARRAY_BUFFER_BINDING, (GLint *)&BufferBindings[eBufIdx_Array].name);
+    GL.glGetIntegerv(eGL_COPY_READ_BUFFER_BINDING, (GLint *)&BufferBindings[eBufIdx_Copy_Read].name);
+    GL.glGetIntegerv(eGL_COPY_WRITE_BUFFER_BINDING, (GLint *)&BufferBindings[eBufIdx_Copy_Write].name);
+    GL.glGetIntegerv(eGL_PIXEL_PACK_BUFFER_BINDING, (GLint *)&BufferBindings[eBufIdx_Pixel_Pack].name);
+    GL.glGetIntegerv(eGL_PIXEL_UNPACK_BUFFER_BINDING,
+                     (GLint *)&BufferBindings[eBufIdx_Pixel_Unpack].name);
+    if(HasExt[ARB_texture_buffer_object])
+      GL.glGetIntegerv(eGL_TEXTURE_BUFFER_BINDING, (GLint *)&BufferBindings[eBufIdx_Texture].name);
+
+    if(HasExt[ARB_draw_indirect])
+      GL.glGetIntegerv(eGL_DRAW_INDIRECT_BUFFER_BINDING,
+                       (GLint *)&BufferBindings[eBufIdx_Draw_Indirect].name);
+    if(HasExt[ARB_compute_shader])
+      GL.glGetIntegerv(eGL_DISPATCH_INDIRECT_BUFFER_BINDING,
+                       (GLint *)&BufferBindings[eBufIdx_Dispatch_Indirect].name);
+    if(HasExt[ARB_query_buffer_object])
+      GL.glGetIntegerv(eGL_QUERY_BUFFER_BINDING, (GLint *)&BufferBindings[eBufIdx_Query].name);
+    if(HasExt[ARB_indirect_parameters])
+      GL.glGetIntegerv(eGL_PARAMETER_BUFFER_BINDING_ARB,
+                       (GLint *)&BufferBindings[eBufIdx_Parameter].name);
+
+    struct
+    {
+      IdxRangeBuffer *bufs;
+      int count;
+      GLenum binding;
+      GLenum start;
+      GLenum size;
+      GLenum maxcount;
+    } idxBufs[] = {
+        {
+            AtomicCounter, ARRAY_COUNT(AtomicCounter), eGL_ATOMIC_COUNTER_BUFFER_BINDING,
+            eGL_ATOMIC_COUNTER_BUFFER_START, eGL_ATOMIC_COUNTER_BUFFER_SIZE,
+            eGL_MAX_ATOMIC_COUNTER_BUFFER_BINDINGS,
+        },
+        {
+            ShaderStorage, ARRAY_COUNT(ShaderStorage), eGL_SHADER_STORAGE_BUFFER_BINDING,
+            eGL_SHADER_STORAGE_BUFFER_START, eGL_SHADER_STORAGE_BUFFER_SIZE,
+            eGL_MAX_SHADER_STORAGE_BUFFER_BINDINGS,
+        },
+        {
+            TransformFeedback, ARRAY_COUNT(TransformFeedback), eGL_TRANSFORM_FEEDBACK_BUFFER_BINDING,
+            eGL_TRANSFORM_FEEDBACK_BUFFER_START, eGL_TRANSFORM_FEEDBACK_BUFFER_SIZE,
+            eGL_MAX_TRANSFORM_FEEDBACK_SEPARATE_ATTRIBS,
+        },
+        {
+            UniformBinding, ARRAY_COUNT(UniformBinding), eGL_UNIFORM_BUFFER_BINDING,
+            eGL_UNIFORM_BUFFER_START, eGL_UNIFORM_BUFFER_SIZE, eGL_MAX_UNIFORM_BUFFER_BINDINGS,
+        },
+    };
+
+    for(GLuint b = 0; b < (GLuint)ARRAY_COUNT(idxBufs); b++)
+    {
+      if(idxBufs[b].binding == eGL_ATOMIC_COUNTER_BUFFER_BINDING && !HasExt[ARB_shader_atomic_counters])
+        continue;
 
-    if(idxBufs[b].binding == eGL_SHADER_STORAGE_BUFFER_BINDING &&
-       !HasExt[ARB_shader_storage_buffer_object])
-      continue;
+      if(idxBufs[b].binding == eGL_SHADER_STORAGE_BUFFER_BINDING &&
+         !HasExt[ARB_shader_storage_buffer_object])
+        continue;
 
-    if(idxBufs[b].binding == eGL_TRANSFORM_FEEDBACK_BUFFER_BINDING && !HasExt[ARB_transform_feedback2])
-      continue;
+      if(idxBufs[b].binding == eGL_TRANSFORM_FEEDBACK_BUFFER_BINDING && !HasExt[ARB_transform_feedback2])
+        continue;
 
-    GLint maxCount = 0;
-    GL.glGetIntegerv(idxBufs[b].maxcount, &maxCount);
-    for(int i = 0; i < idxBufs[b].count && i < maxCount; i++)
-    {
-      // buffers are always shared
-      idxBufs[b].bufs[i].res.ContextShareGroup = ctx.shareGroup;
+      GLint maxCount = 0;
+      GL.glGetIntegerv(idxBufs[b].maxcount, &maxCount);
+      for(int i = 0; i < idxBufs[b].count && i < maxCount; i++)
+      {
+        // buffers are always shared
+        idxBufs[b].bufs[i].res.ContextShareGroup = ctx.shareGroup;
 
-      GL.glGetIntegeri_v(idxBufs[b].binding, i, (GLint *)&idxBufs[b].bufs[i].res.name);
-      GL.glGetInteger64i_v(idxBufs[b].start, i, (GLint64 *)&idxBufs[b].bufs[i].start);
-      GL.glGetInteger64i_v(idxBufs[b].size, i, (GLint64 *)&idxBufs[b].bufs[i].size);
+        GL.glGetIntegeri_v(idxBufs[b].binding, i, (GLint *)&idxBufs[b].bufs[i].res.name);
+        GL.glGetInteger64i_v(idxBufs[b].start, i, (GLint64 *)&idxBufs[b].bufs[i].start);
+        GL.glGetInteger64i_v(idxBufs[b].size, i, (GLint64 *)&idxBufs[b].bufs[i].size);
+      }
     }
   }
 
   GLuint maxDraws = 0;
   GL.glGetIntegerv(eGL_MAX_DRAW_BUFFERS, (GLint *)&maxDraws);
 
-  if(HasExt[ARB_draw_buffers_blend])
+  if(parts & ePart_PixelOps)
   {
-    for(GLuint i = 0; i < RDCMIN(maxDraws, (GLuint)ARRAY_COUNT(Blends)); i++)
+    if(HasExt[ARB_draw_buffers_blend])
     {
-      GL.glGetIntegeri_v(eGL_BLEND_EQUATION_RGB, i, (GLint *)&Blends[i].EquationRGB);
-      GL.glGetIntegeri_v(eGL_BLEND_EQUATION_ALPHA, i, (GLint *)&Blends[i].EquationAlpha);
+      for(GLuint i = 0; i < RDCMIN(maxDraws, (GLuint)ARRAY_COUNT(Blends)); i++)
+      {
+        GL.glGetIntegeri_v(eGL_BLEND_EQUATION_RGB, i, (GLint *)&Blends[i].EquationRGB);
+        GL.glGetIntegeri_v(eGL_BLEND_EQUATION_ALPHA, i, (GLint *)&Blends[i].EquationAlpha);
 
-      GL.glGetIntegeri_v(eGL_BLEND_SRC_RGB, i, (GLint *)&Blends[i].SourceRGB);
-      GL.glGetIntegeri_v(eGL_BLEND_SRC_ALPHA, i, (GLint *)&Blends[i].SourceAlpha);
+        GL.glGetIntegeri_v(eGL_BLEND_SRC_RGB, i, (GLint *)&Blends[i].SourceRGB);
+        GL.glGetIntegeri_v(eGL_BLEND_SRC_ALPHA, i, (GLint *)&Blends[i].SourceAlpha);
 
-      GL.glGetIntegeri_v(eGL_BLEND_DST_RGB, i, (GLint *)&Blends[i].DestinationRGB);
-      GL.glGetIntegeri_v(eGL_BLEND_DST_ALPHA, i, (GLint *)&Blends[i].DestinationAlpha);
+        GL.glGetIntegeri_v(eGL_BLEND_DST_RGB, i, (GLint *)&Blends[i].DestinationRGB);
+        GL.glGetIntegeri_v(eGL_BLEND_DST_ALPHA, i, (GLint *)&Blends[i].DestinationAlpha);
 
-      Blends[i].Enabled = (GL.glIsEnabledi(eGL_BLEND, i) == GL_TRUE);
+        Blends[i].Enabled = (GL.glIsEnabledi(eGL_BLEND, i) == GL_TRUE);
+      }
     }
-  }
-  else
-  {
-    // if we don't have separate blending, then replicate across all from 0
+    else
+    {
+      // if we don't have separate blending, then replicate across all from 0
 
-    GL.glGetIntegerv(eGL_BLEND_EQUATION_RGB, (GLint *)&Blends[0].EquationRGB);
-    GL.glGetIntegerv(eGL_BLEND_EQUATION_ALPHA, (GLint *)&Blends[0].EquationAlpha);
+      GL.glGetIntegerv(eGL_BLEND_EQUATION_RGB, (GLint *)&Blends[0].EquationRGB);
+      GL.glGetIntegerv(eGL_BLEND_EQUATION_ALPHA, (GLint *)&Blends[0].EquationAlpha);
 
-    GL.glGetIntegerv(eGL_BLEND_SRC_RGB, (GLint *)&Blends[0].SourceRGB);
-    GL.glGetIntegerv(eGL_BLEND_SRC_ALPHA, (GLint *)&Blends[0].SourceAlpha);
+      GL.glGetIntegerv(eGL_BLEND_SRC_RGB, (GLint *)&Blends[0].SourceRGB);
+      GL.glGetIntegerv(eGL_BLEND_SRC_ALPHA, (GLint *)&Blends[0].SourceAlpha);
 
-    GL.glGetIntegerv(eGL_BLEND_DST_RGB, (GLint *)&Blends[0].DestinationRGB);
-    GL.glGetIntegerv(eGL_BLEND_DST_ALPHA, (GLint *)&Blends[0].DestinationAlpha);
+      GL.glGetIntegerv(eGL_BLEND_DST_RGB, (GLint *)&Blends[0].DestinationRGB);
+      GL.glGetIntegerv(eGL_BLEND_DST_ALPHA, (GLint *)&Blends[0].DestinationAlpha);
 
-    Blends[0].Enabled = (GL.glIsEnabled(eGL_BLEND) == GL_TRUE);
+      Blends[0].Enabled = (GL.glIsEnabled(eGL_BLEND) == GL_TRUE);
 
-    for(GLuint i = 1; i < (GLuint)ARRAY_COUNT(Blends); i++)
-      memcpy(&Blends[i], &Blends[0], sizeof(Blends[i]));
-  }
+      for(GLuint i = 1; i < (GLuint)ARRAY_COUNT(Blends); i++)
+        memcpy(&Blends[i], &Blends[0], sizeof(Blends[i]));
+    }
 
-  GL.glGetFloatv(eGL_BLEND_COLOR, &BlendColor[0]);
+    GL.glGetFloatv(eGL_BLEND_COLOR, &BlendColor[0]);
+  }
 
-  if(HasExt[ARB_viewport_array])
+  if(parts & ePart_ViewScissor)
   {
-    GLuint maxViews = 0;
-    GL.glGetIntegerv(eGL_MAX_VIEWPORTS, (GLint *)&maxViews);
+    if(HasExt[ARB_viewport_array])
+    {
+      GLuint maxViews = 0;
+      GL.glGetIntegerv(eGL_MAX_VIEWPORTS, (GLint *)&maxViews);
 
-    for(GLuint i = 0; i < RDCMIN(maxViews, (GLuint)ARRAY_COUNT(Viewports)); i++)
-      GL.glGetFloati_v(eGL_VIEWPORT, i, &Viewports[i].x);
+      for(GLuint i = 0; i < RDCMIN(maxViews, (GLuint)ARRAY_COUNT(Viewports)); i++)
+        GL.glGetFloati_v(eGL_VIEWPORT, i, &Viewports[i].x);
 
-    for(GLuint i = 0; i < RDCMIN(maxViews, (GLuint)ARRAY_COUNT(Scissors)); i++)
-    {
-      GL.glGetIntegeri_v(eGL_SCISSOR_BOX, i, &Scissors[i].x);
-      Scissors[i].enabled = (GL.glIsEnabledi(eGL_SCISSOR_TEST, i) == GL_TRUE);
-    }
+      for(GLuint i = 0; i < RDCMIN(maxViews, (GLuint)ARRAY_COUNT(Scissors)); i++)
+      {
+        GL.glGetIntegeri_v(eGL_SCISSOR_BOX, i, &Scissors[i].x);
+        Scissors[i].enabled = (GL.glIsEnabledi(eGL_SCISSOR_TEST, i) == GL_TRUE);
+      }
 
-    for(GLuint i = 0; i < RDCMIN(maxViews, (GLuint)ARRAY_COUNT(DepthRanges)); i++)
+      for(GLuint i = 0; i < RDCMIN(maxViews, (GLuint)ARRAY_COUNT(DepthRanges)); i++)
+      {
+        if(IsGLES)
+        {
+          float v[2];
+          GL.glGetFloati_v(eGL_DEPTH_RANGE, i, v);
+          DepthRanges[i] = {(double)v[0], (double)v[1]};
+        }
+        else
+        {
+          GL.glGetDoublei_v(eGL_DEPTH_RANGE, i, &DepthRanges[i].nearZ);
+        }
+      }
+    }
+    else
     {
+      // if we don't have separate viewport/etc, then replicate across all from 0
+      // note that the same extension introduced indexed viewports, scissors and
+      // depth ranges. Convenient!
+
+      GL.glGetFloatv(eGL_VIEWPORT, &Viewports[0].x);
+      GL.glGetIntegerv(eGL_SCISSOR_BOX, &Scissors[0].x);
+      Scissors[0].enabled = (GL.glIsEnabled(eGL_SCISSOR_TEST) == GL_TRUE);
       if(IsGLES)
       {
         float v[2];
-        GL.glGetFloati_v(eGL_DEPTH_RANGE, i, v);
-        DepthRanges[i] = {(double)v[0], (double)v[1]};
+        GL.glGetFloatv(eGL_DEPTH_RANGE, v);
+        DepthRanges[0] = {(double)v[0], (double)v[1]};
       }
       else
       {
-        GL.glGetDoublei_v(eGL_DEPTH_RANGE, i, &DepthRanges[i].nearZ);
+        GL.glGetDoublev(eGL_DEPTH_RANGE, &DepthRanges[0].nearZ);
       }
-    }
-  }
-  else
-  {
-    // if we don't have separate viewport/etc, then replicate across all from 0
-    // note that the same extension introduced indexed viewports, scissors and
-    // depth ranges. Convenient!
-
-    GL.glGetFloatv(eGL_VIEWPORT, &Viewports[0].x);
-    GL.glGetIntegerv(eGL_SCISSOR_BOX, &Scissors[0].x);
-    Scissors[0].enabled = (GL.glIsEnabled(eGL_SCISSOR_TEST) == GL_TRUE);
-    if(IsGLES)
-    {
-      float v[2];
-      GL.glGetFloatv(eGL_DEPTH_RANGE, v);
-      DepthRanges[0] = {(double)v[0], (double)v[1]};
-    }
-    else
-    {
-      GL.glGetDoublev(eGL_DEPTH_RANGE, &DepthRanges[0].nearZ);
-    }
 
-    for(GLuint i = 1; i < (GLuint)ARRAY_COUNT(Viewports); i++)
-      memcpy(&Viewports[i], &Viewports[0], sizeof(Viewports[i]));
+      for(GLuint i = 1; i < (GLuint)ARRAY_COUNT(Viewports); i++)
+        memcpy(&Viewports[i], &Viewports[0], sizeof(Viewports[i]));
 
-    for(GLuint i = 1; i < (GLuint)ARRAY_COUNT(Scissors); i++)
-      memcpy(&Scissors[i], &Scissors[0], sizeof(Scissors[i]));
+      for(GLuint i = 1; i < (GLuint)ARRAY_COUNT(Scissors); i++)
+        memcpy(&Scissors[i], &Scissors[0], sizeof(Scissors[i]));
 
-    for(GLuint i = 1; i < (GLuint)ARRAY_COUNT(DepthRanges); i++)
-      memcpy(&DepthRanges[i], &DepthRanges[0], sizeof(DepthRanges[i]));
+      for(GLuint i = 1; i < (GLuint)ARRAY_COUNT(DepthRanges); i++)
+        memcpy(&DepthRanges[i], &DepthRanges[0], sizeof(DepthRanges[i]));
+    }
   }
 
+  if(parts & ePart_Framebuffers)
   {
-    GLuint draw, read;
-    GL.glGetIntegerv(eGL_DRAW_FRAMEBUFFER_BINDING, (GLint *)&draw);
-    GL.glGetIntegerv(eGL_READ_FRAMEBUFFER_BINDING, (GLint *)&read);
-    DrawFBO = FramebufferRes(ctx, draw);
-    ReadFBO = FramebufferRes(ctx, read);
-
-    // if the default FBO is bound, we must force the use of the context itself, rather than the
-    // sharegroup (if FBOs are normally shared).
-    if(draw == 0)
-      DrawFBO = FramebufferRes({ctx.ctx, ctx.ctx}, draw);
-    if(read == 0)
-      ReadFBO = FramebufferRes({ctx.ctx, ctx.ctx}, read);
-  }
-
-  GL.glBindFramebuffer(eGL_DRAW_FRAMEBUFFER, 0);
-  GL.glBindFramebuffer(eGL_READ_FRAMEBUFFER, 0);
+    {
+      GLuint draw, read;
+      GL.glGetIntegerv(eGL_DRAW_FRAMEBUFFER_BINDING, (GLint *)&draw);
+      GL.glGetIntegerv(eGL_READ_FRAMEBUFFER_BINDING, (GLint *)&read);
+      DrawFBO = FramebufferRes(ctx, draw);
+      ReadFBO = FramebufferRes(ctx, read);
+
+      // if the default FBO is bound, we must force the use of the context itself, rather than the
+      // sharegroup (if FBOs are normally shared).
+      if(draw == 0)
+        DrawFBO = FramebufferRes({ctx.ctx, ctx.ctx}, draw);
+      if(read == 0)
+        ReadFBO = FramebufferRes({ctx.ctx, ctx.ctx}, read);
+    }
 
-  for(GLuint i = 0; i < RDCMIN(maxDraws, (GLuint)ARRAY_COUNT(DrawBuffers)); i++)
-    GL.glGetIntegerv(GLenum(eGL_DRAW_BUFFER0 + i), (GLint *)&DrawBuffers[i]);
+    GL.glBindFramebuffer(eGL_DRAW_FRAMEBUFFER, 0);
+    GL.glBindFramebuffer(eGL_READ_FRAMEBUFFER, 0);
 
-  GL.glGetIntegerv(eGL_READ_BUFFER, (GLint *)&ReadBuffer);
+    for(GLuint i = 0; i < RDCMIN(maxDraws, (GLuint)ARRAY_COUNT(DrawBuffers)); i++)
+      GL.glGetIntegerv(GLenum(eGL_DRAW_BUFFER0 + i), (GLint *)&DrawBuffers[i]);
 
-  GL.glBindFramebuffer(eGL_DRAW_FRAMEBUFFER, DrawFBO.name);
-  GL.glBindFramebuffer(eGL_READ_FRAMEBUFFER, ReadFBO.name);
+    GL.glGetIntegerv(eGL_READ_BUFFER, (GLint *)&ReadBuffer);
 
-  GL.glGetIntegerv(eGL_FRAGMENT_SHADER_DERIVATIVE_HINT, (GLint *)&Hints.Derivatives);
-  if(!IsGLES)
-  {
-    GL.glGetIntegerv(eGL_LINE_SMOOTH_HINT, (GLint *)&Hints.LineSmooth);
-    GL.glGetIntegerv(eGL_POLYGON_SMOOTH_HINT, (GLint *)&Hints.PolySmooth);
-    GL.glGetIntegerv(eGL_TEXTURE_COMPRESSION_HINT, (GLint *)&Hints.TexCompression);
+    GL.glBindFramebuffer(eGL_DRAW_FRAMEBUFFER, DrawFBO.name);
+    GL.glBindFramebuffer(eGL_READ_FRAMEBUFFER, ReadFBO.name);
   }
 
-  GL.glGetBooleanv(eGL_DEPTH_WRITEMASK, &DepthWriteMask);
-  GL.glGetFloatv(eGL_DEPTH_CLEAR_VALUE, &DepthClearValue);
-  GL.glGetIntegerv(eGL_DEPTH_FUNC, (GLint *)&DepthFunc);
-
-  if(HasExt[EXT_depth_bounds_test])
-  {
-    GL.glGetDoublev(eGL_DEPTH_BOUNDS_EXT, &DepthBounds.nearZ);
-  }
-  else
+  if(parts & ePart_Raster)
   {
-    DepthBounds.nearZ = 0.0f;
-    DepthBounds.farZ = 1.0f;
+    GL.glGetIntegerv(eGL_FRAGMENT_SHADER_DERIVATIVE_HINT, (GLint *)&Hints.Derivatives);
+    if(!IsGLES)
+    {
+      GL.glGetIntegerv(eGL_LINE_SMOOTH_HINT, (GLint *)&Hints.LineSmooth);
+      GL.glGetIntegerv(eGL_POLYGON_SMOOTH_HINT, (GLint *)&Hints.PolySmooth);
+      GL.glGetIntegerv(eGL_TEXTURE_COMPRESSION_HINT, (GLint *)&Hints.TexCompression);
+    }
   }
 
+  if(parts & ePart_PixelOps)
   {
-    GL.glGetIntegerv(eGL_STENCIL_FUNC, (GLint *)&StencilFront.func);
-    GL.glGetIntegerv(eGL_STENCIL_BACK_FUNC, (GLint *)&StencilBack.func);
+    GL.glGetBooleanv(eGL_DEPTH_WRITEMASK, &DepthWriteMask);
+    GL.glGetFloatv(eGL_DEPTH_CLEAR_VALUE, &DepthClearValue);
+    GL.glGetIntegerv(eGL_DEPTH_FUNC, (GLint *)&DepthFunc);
 
-    GL.glGetIntegerv(eGL_STENCIL_REF, (GLint *)&StencilFront.ref);
-    GL.glGetIntegerv(eGL_STENCIL_BACK_REF, (GLint *)&StencilBack.ref);
+    if(HasExt[EXT_depth_bounds_test])
+    {
+      GL.glGetDoublev(eGL_DEPTH_BOUNDS_EXT, &DepthBounds.nearZ);
+    }
+    else
+    {
+      DepthBounds.nearZ = 0.0f;
+      DepthBounds.farZ = 1.0f;
+    }
 
-    GLint maskval;
-    GL.glGetIntegerv(eGL_STENCIL_VALUE_MASK, &maskval);
-    StencilFront.valuemask = uint8_t(maskval & 0xff);
-    GL.glGetIntegerv(eGL_STENCIL_BACK_VALUE_MASK, &maskval);
-    StencilBack.valuemask = uint8_t(maskval & 0xff);
+    {
+      GL.glGetIntegerv(eGL_STENCIL_FUNC, (GLint *)&StencilFront.func);
+      GL.glGetIntegerv(eGL_STENCIL_BACK_FUNC, (GLint *)&StencilBack.func);
 
-    GL.glGetIntegerv(eGL_STENCIL_WRITEMASK, &maskval);
-    StencilFront.writemask = uint8_t(maskval & 0xff);
-    GL.glGetIntegerv(eGL_STENCIL_BACK_WRITEMASK, &maskval);
-    StencilBack.writemask = uint8_t(maskval & 0xff);
+      GL.glGetIntegerv(eGL_STENCIL_REF, (GLint *)&StencilFront.ref);
+      GL.glGetIntegerv(eGL_STENCIL_BACK_REF, (GLint *)&StencilBack.ref);
 
-    GL.glGetIntegerv(eGL_STENCIL_FAIL, (GLint *)&StencilFront.stencilFail);
-    GL.glGetIntegerv(eGL_STENCIL_BACK_FAIL, (GLint *)&StencilBack.stencilFail);
+      GLint maskval;
+      GL.glGetIntegerv(eGL_STENCIL_VALUE_MASK, &maskval);
+      StencilFront.valuemask = uint8_t(maskval & 0xff);
+      GL.glGetIntegerv(eGL_STENCIL_BACK_VALUE_MASK, &maskval);
+      StencilBack.valuemask = uint8_t(maskval & 0xff);
 
-    GL.glGetIntegerv(eGL_STENCIL_PASS_DEPTH_FAIL, (GLint *)&StencilFront.depthFail);
-    GL.glGetIntegerv(eGL_STENCIL_BACK_PASS_DEPTH_FAIL, (GLint *)&StencilBack.depthFail);
+      GL.glGetIntegerv(eGL_STENCIL_WRITEMASK, &maskval);
+      StencilFront.writemask = uint8_t(maskval & 0xff);
+      GL.glGetIntegerv(eGL_STENCIL_BACK_WRITEMASK, &maskval);
+      StencilBack.writemask = uint8_t(maskval & 0xff);
 
-    GL.glGetIntegerv(eGL_STENCIL_PASS_DEPTH_PASS, (GLint *)&StencilFront.pass);
-    GL.glGetIntegerv(eGL_STENCIL_BACK_PASS_DEPTH_PASS, (GLint *)&StencilBack.pass);
-  }
+      GL.glGetIntegerv(eGL_STENCIL_FAIL, (GLint *)&StencilFront.stencilFail);
+      GL.glGetIntegerv(eGL_STENCIL_BACK_FAIL, (GLint *)&StencilBack.stencilFail);
 
-  GL.glGetIntegerv(eGL_STENCIL_CLEAR_VALUE, (GLint *)&StencilClearValue);
+      GL.glGetIntegerv(eGL_STENCIL_PASS_DEPTH_FAIL, (GLint *)&StencilFront.depthFail);
+      GL.glGetIntegerv(eGL_STENCIL_BACK_PASS_DEPTH_FAIL, (GLint *)&StencilBack.depthFail);
 
-  if(HasExt[EXT_draw_buffers2] || HasExt[ARB_draw_buffers_blend])
-  {
-    for(GLuint i = 0; i < RDCMIN(maxDraws, (GLuint)ARRAY_COUNT(ColorMasks)); i++)
-      GL.glGetBooleani_v(eGL_COLOR_WRITEMASK, i, &ColorMasks[i].red);
-  }
-  else
-  {
-    GL.glGetBooleanv(eGL_COLOR_WRITEMASK, &ColorMasks[0].red);
-    for(size_t i = 1; i < ARRAY_COUNT(ColorMasks); i++)
-      memcpy(&ColorMasks[i], &ColorMasks[0], sizeof(ColorMask));
-  }
+      GL.glGetIntegerv(eGL_STENCIL_PASS_DEPTH_PASS, (GLint *)&StencilFront.pass);
+      GL.glGetIntegerv(eGL_STENCIL_BACK_PASS_DEPTH_PASS, (GLint *)&StencilBack.pass);
+    }
 
-  if(HasExt[ARB_texture_multisample_no_array] || HasExt[ARB_texture_multisample])
-    GL.glGetIntegeri_v(eGL_SAMPLE_MASK_VALUE, 0, (GLint *)&SampleMask[0]);
+    GL.glGetIntegerv(eGL_STENCIL_CLEAR_VALUE, (GLint *)&StencilClearValue);
 
-  GL.glGetFloatv(eGL_SAMPLE_COVERAGE_VALUE, &SampleCoverage);
+    if(HasExt[EXT_draw_buffers2] || HasExt[ARB_draw_buffers_blend])
+    {
+      for(GLuint i = 0; i < RDCMIN(maxDraws, (GLuint)ARRAY_COUNT(ColorMasks)); i++)
+        GL.glGetBooleani_v(eGL_COLOR_WRITEMASK, i, &ColorMasks[i].red);
+    }
+    else
+    {
+      GL.glGetBooleanv(eGL_COLOR_WRITEMASK, &ColorMasks[0].red);
+      for(size_t i = 1; i < ARRAY_COUNT(ColorMasks); i++)
+        memcpy(&ColorMasks[i], &ColorMasks[0], sizeof(ColorMask));
+    }
 
-  {
-    GLint invert = 0;
-    GL.glGetIntegerv(eGL_SAMPLE_COVERAGE_INVERT, (GLint *)&invert);
-    SampleCoverageInvert = (invert != 0);
-  }
+    if(HasExt[ARB_texture_multisample_no_array] || HasExt[ARB_texture_multisample])
+      GL.glGetIntegeri_v(eGL_SAMPLE_MASK_VALUE, 0, (GLint *)&SampleMask[0]);
 
-  if(HasExt[ARB_sample_shading])
-    GL.glGetFloatv(eGL_MIN_SAMPLE_SHADING_VALUE, &MinSampleShading);
-  else
-    MinSampleShading = 0;
+    GL.glGetFloatv(eGL_SAMPLE_COVERAGE_VALUE, &SampleCoverage);
 
-  if(HasExt[EXT_raster_multisample])
-    GL.glGetIntegerv(eGL_RASTER_SAMPLES_EXT, (GLint *)&RasterSamples);
-  else
-    RasterSamples = 0;
+    {
+      GLint invert = 0;
+      GL.glGetIntegerv(eGL_SAMPLE_COVERAGE_INVERT, (GLint *)&invert);
+      SampleCoverageInvert = (invert != 0);
+    }
 
-  if(HasExt[EXT_raster_multisample])
-    GL.glGetIntegerv(eGL_RASTER_FIXED_SAMPLE_LOCATIONS_EXT, (GLint *)&RasterFixed);
-  else
-    RasterFixed = false;
+    if(HasExt[ARB_sample_shading])
+      GL.glGetFloatv(eGL_MIN_SAMPLE_SHADING_VALUE, &MinSampleShading);
+    else
+      MinSampleShading = 0;
 
-  if(!IsGLES)
-    GL.glGetIntegerv(eGL_LOGIC_OP_MODE, (GLint *)&LogicOp);
+    if(HasExt[EXT_raster_multisample])
+      GL.glGetIntegerv(eGL_RASTER_SAMPLES_EXT, (GLint *)&RasterSamples);
+    else
+      RasterSamples = 0;
 
-  GL.glGetFloatv(eGL_COLOR_CLEAR_VALUE, &ColorClearValue.red);
+    if(HasExt[EXT_raster_multisample])
+      GL.glGetIntegerv(eGL_RASTER_FIXED_SAMPLE_LOCATIONS_EXT, (GLint *)&RasterFixed);
+    else
+      RasterFixed = false;
 
-  if(HasExt[ARB_tessellation_shader])
-    GL.glGetIntegerv(eGL_PATCH_VERTICES, &PatchParams.numVerts);
-  else
-    PatchParams.numVerts = 3;
+    if(!IsGLES)
+      GL.glGetIntegerv(eGL_LOGIC_OP_MODE, (GLint *)&LogicOp);
 
-  if(!IsGLES && HasExt[ARB_tessellation_shader])
-  {
-    GL.glGetFloatv(eGL_PATCH_DEFAULT_INNER_LEVEL, &PatchParams.defaultInnerLevel[0]);
-    GL.glGetFloatv(eGL_PATCH_DEFAULT_OUTER_LEVEL, &PatchParams.defaultOuterLevel[0]);
-  }
-  else
-  {
-    PatchParams.defaultInnerLevel[0] = PatchParams.defaultInnerLevel[1] = 1.0f;
-    PatchParams.defaultOuterLevel[0] = PatchParams.defaultOuterLevel[1] =
-        PatchParams.defaultOuterLevel[2] = PatchParams.defaultOuterLevel[3] = 1.0f;
+    GL.glGetFloatv(eGL_COLOR_CLEAR_VALUE, &ColorClearValue.red);
   }
 
-  if(!VendorCheck[VendorCheck_AMD_polygon_mode_query] && !IsGLES)
-  {
-    // This was listed in docs as enumeration[2] even though polygon mode can't be set independently
-    // for front
-    // and back faces for a while, so pass large enough array to be sure.
-    // AMD driver claims this doesn't exist anymore in core, so don't return any value, set to
-    // default GL_FILL to be safe
-    GLenum dummy[2] = {eGL_FILL, eGL_FILL};
-    GL.glGetIntegerv(eGL_POLYGON_MODE, (GLint *)&dummy);
-    PolygonMode = dummy[0];
-  }
-  else
+  if(parts & ePart_Raster)
   {
-    PolygonMode = eGL_FILL;
-  }
+    if(HasExt[ARB_tessellation_shader])
+      GL.glGetIntegerv(eGL_PATCH_VERTICES, &PatchParams.numVerts);
+    else
+      PatchParams.numVerts = 3;
 
-  GL.glGetFloatv(eGL_POLYGON_OFFSET_FACTOR, &PolygonOffset[0]);
-  GL.glGetFloatv(eGL_POLYGON_OFFSET_UNITS, &PolygonOffset[1]);
-  if(HasExt[ARB_polygon_offset_clamp])
-    GL.glGetFloatv(eGL_POLYGON_OFFSET_CLAMP, &PolygonOffset[2]);
-  else
-    PolygonOffset[2] = 0.0f;
+    if(!IsGLES && HasExt[ARB_tessellation_shader])
+    {
+      GL.glGetFloatv(eGL_PATCH_DEFAULT_INNER_LEVEL, &PatchParams.defaultInnerLevel[0]);
+      GL.glGetFloatv(eGL_PATCH_DEFAULT_OUTER_LEVEL, &PatchParams.defaultOuterLevel[0]);
+    }
+    else
+    {
+      PatchParams.defaultInnerLevel[0] = PatchParams.defaultInnerLevel[1] = 1.0f;
+      PatchParams.defaultOuterLevel[0] = PatchParams.defaultOuterLevel[1] =
+          PatchParams.defaultOuterLevel[2] = PatchParams.defaultOuterLevel[3] = 1.0f;
+    }
+
+    if(!VendorCheck[VendorCheck_AMD_polygon_mode_query] && !IsGLES)
+    {
+      // This was listed in docs as enumeration[2] even though polygon mode can't be set independently
+      // for front
+      // and back faces for a while, so pass large enough array to be sure.
+      // AMD driver claims this doesn't exist anymore in core, so don't return any value, set to
+      // default GL_FILL to be safe
+      GLenum dummy[2] = {eGL_FILL, eGL_FILL};
+      GL.glGetIntegerv(eGL_POLYGON_MODE, (GLint *)&dummy);
+      PolygonMode = dummy[0];
+    }
+    else
+    {
+      PolygonMode = eGL_FILL;
+    }
+
+    GL.glGetFloatv(eGL_POLYGON_OFFSET_FACTOR, &PolygonOffset[0]);
+    GL.glGetFloatv(eGL_POLYGON_OFFSET_UNITS, &PolygonOffset[1]);
+    if(HasExt[ARB_polygon_offset_clamp])
+      GL.glGetFloatv(eGL_POLYGON_OFFSET_CLAMP, &PolygonOffset[2]);
+    else
+      PolygonOffset[2] = 0.0f;
 
-  GL.glGetIntegerv(eGL_FRONT_FACE, (GLint *)&FrontFace);
-  GL.glGetIntegerv(eGL_CULL_FACE_MODE, (GLint *)&CullFace);
+    GL.glGetIntegerv(eGL_FRONT_FACE, (GLint *)&FrontFace);
+    GL.glGetIntegerv(eGL_CULL_FACE_MODE, (GLint *)&CullFace);
 
-  if(IsGLES && (HasExt[EXT_primitive_bounding_box] || HasExt[OES_primitive_bounding_box]))
-    GL.glGetFloatv(eGL_PRIMITIVE_BOUNDING_BOX_EXT, (GLfloat *)&PrimitiveBoundingBox);
+    if(IsGLES && (HasExt[EXT_primitive_bounding_box] || HasExt[OES_primitive_bounding_box]))
+      GL.glGetFloatv(eGL_PRIMITIVE_BOUNDING_BOX_EXT, (GLfloat *)&PrimitiveBoundingBox);
+  }
 
-  Unpack.Fetch(true);
+  if(parts & ePart_PixelStorage)
+    Unpack.Fetch(true);
 
   ClearGLErrors();
 }
@@ -1314,57 +1354,68 @@ void GLRenderState::ApplyState(WrappedOpenGL *driver)
   if(!ContextPresent || ctx.ctx == NULL)
     return;
 
-  for(GLuint i = 0; i < eEnabled_Count; i++)
+  const uint32_t parts = FetchedParts;
+
+  if(parts & ePart_Enables)
   {
-    if(!CheckEnableDisableParam(enable_disable_cap[i].cap))
-      continue;
+    for(GLuint i = 0; i < eEnabled_Count; i++)
+    {
+      if(!CheckEnableDisableParam(enable_disable_cap[i].cap))
+        continue;
 
-    if(Enabled[i])
-      GL.glEnable(enable_disable_cap[i].cap);
-    else
-      GL.glDisable(enable_disable_cap[i].cap);
+      if(Enabled[i])
+        GL.glEnable(enable_disable_cap[i].cap);
+      else
+        GL.glDisable(enable_disable_cap[i].cap);
+    }
   }
 
-  GLuint maxTextures = 0;
-  GL.glGetIntegerv(eGL_MAX_COMBINED_TEXTURE_IMAGE_UNITS, (GLint *)&maxTextures);
-
-  for(GLuint i = 0; i < RDCMIN(maxTextures, (GLuint)ARRAY_COUNT(Tex2D)); i++)
+  if(parts & ePart_Textures)
   {
-    GL.glActiveTexture(GLenum(eGL_TEXTURE0 + i));
+    GLuint maxTextures = 0;
+    GL.glGetIntegerv(eGL_MAX_COMBINED_TEXTURE_IMAGE_UNITS, (GLint *)&maxTextures);
+    maxTextures = RDCMIN(maxTextures, FetchedTexUnits);
 
-    if(!IsGLES)
-      GL.glBindTexture(eGL_TEXTURE_1D, Tex1D[i].name);
+    for(GLuint i = 0; i < RDCMIN(maxTextures, (GLuint)ARRAY_COUNT(Tex2D)); i++)
+    {
+      GL.glActiveTexture(GLenum(eGL_TEXTURE0 + i));
 
-    GL.glBindTexture(eGL_TEXTURE_2D, Tex2D[i].name);
-    GL.glBindTexture(eGL_TEXTURE_3D, Tex3D[i].name);
+      if(!IsGLES)
+        GL.glBindTexture(eGL_TEXTURE_1D, Tex1D[i].name);
 
-    if(!IsGLES)
-      GL.glBindTexture(eGL_TEXTURE_1D_ARRAY, Tex1DArray[i].name);
+      GL.glBindTexture(eGL_TEXTURE_2D, Tex2D[i].name);
+      GL.glBindTexture(eGL_TEXTURE_3D, Tex3D[i].name);
 
-    GL.glBindTexture(eGL_TEXTURE_2D_ARRAY, Tex2DArray[i].name);
+      if(!IsGLES)
+        GL.glBindTexture(eGL_TEXTURE_1D_ARRAY, Tex1DArray[i].name);
 
-    if(!IsGLES)
-      GL.glBindTexture(eGL_TEXTURE_RECTANGLE, TexRect[i].name);
+      GL.glBindTexture(eGL_TEXTURE_2D_ARRAY, Tex2DArray[i].name);
 
-    if(HasExt[ARB_texture_buffer_object])
-      GL.glBindTexture(eGL_TEXTURE_BUFFER, TexBuffer[i].name);
+      if(!IsGLES)
+        GL.glBindTexture(eGL_TEXTURE_RECTANGLE, TexRect[i].name);
 
-    GL.glBindTexture(eGL_TEXTURE_CUBE_MAP, TexCube[i].name);
+      if(HasExt[ARB_texture_buffer_object])
+        GL.glBindTexture(eGL_TEXTURE_BUFFER, TexBuffer[i].name);
 
-    if(HasExt[ARB_texture_multisample_no_array] || HasExt[ARB_texture_multisample])
-      GL.glBindTexture(eGL_TEXTURE_2D_MULTISAMPLE, Tex2DMS[i].name);
+      GL.glBindTexture(eGL_TEXTURE_CUBE_MAP, TexCube[i].name);
+
+      if(HasExt[ARB_texture_multisample_no_array] || HasExt[ARB_texture_multisample])
+        GL.glBindTexture(eGL_TEXTURE_2D_MULTISAMPLE, Tex2DMS[i].name);
+
+      if(HasExt[ARB_texture_multisample])
+        GL.glBindTexture(eGL_TEXTURE_2D_MULTISAMPLE_ARRAY, Tex2DMSArray[i].name);
 
-    if(HasExt[ARB_texture_multisample])
-      GL.glBindTexture(eGL_TEXTURE_2D_MULTISAMPLE_ARRAY, Tex2DMSArray[i].name);
+      if(HasExt[ARB_sampler_objects])
+        GL.glBindSampler(i, Samplers[i].name);
 
-    if(HasExt[ARB_sampler_objects])
-      GL.glBindSampler(i, Samplers[i].name);
+      if(HasExt[ARB_texture_cube_map_array])
+        GL.glBindTexture(eGL_TEXTURE_CUBE_MAP_ARRAY, TexCubeArray[i].name);
+    }
 
-    if(HasExt[ARB_texture_cube_map_array])
-      GL.glBindTexture(eGL_TEXTURE_CUBE_MAP_ARRAY, TexCubeArray[i].name);
+    GL.glActiveTexture(ActiveTexture);
   }
 
-  if(HasExt[ARB_shader_image_load_store])
+  if((parts & ePart_Images) && HasExt[ARB_shader_image_load_store])
   {
     GLuint maxImages = 0;
     GL.glGetIntegerv(eGL_MAX_IMAGE_UNITS, (GLint *)&maxImages);
@@ -1380,359 +1431,388 @@ void GLRenderState::ApplyState(WrappedOpenGL *driver)
     }
   }
 
-  GL.glActiveTexture(ActiveTexture);
-
-  if(VAO.name)
-    GL.glBindVertexArray(VAO.name);
-  else
-    GL.glBindVertexArray(driver->GetFakeVAO0());
+  if(parts & ePart_Vertex)
+  {
+    if(VAO.name)
+      GL.glBindVertexArray(VAO.name);
+    else
+      GL.glBindVertexArray(driver->GetFakeVAO0());
 
-  if(HasExt[ARB_transform_feedback2])
-    GL.glBindTransformFeedback(eGL_TRANSFORM_FEEDBACK, FeedbackObj.name);
+    if(HasExt[ARB_transform_feedback2])
+      GL.glBindTransformFeedback(eGL_TRANSFORM_FEEDBACK, FeedbackObj.name);
 
-  // See FetchState(). The spec says that you have to SET the right format for the shader too,
-  // but we couldn't query for the format so we can't set it here.
-  GLuint maxNumAttribs = 0;
-  GL.glGetIntegerv(eGL_MAX_VERTEX_ATTRIBS, (GLint *)&maxNumAttribs);
-  for(GLuint i = 0; i < RDCMIN(maxNumAttribs, (GLuint)ARRAY_COUNT(GenericVertexAttribs)); i++)
-    GL.glVertexAttrib4fv(i, &GenericVertexAttribs[i].x);
+    // See FetchState(). The spec says that you have to SET the right format for the shader too,
+    // but we couldn't query for the format so we can't set it here.
+    GLuint maxNumAttribs = 0;
+    GL.glGetIntegerv(eGL_MAX_VERTEX_ATTRIBS, (GLint *)&maxNumAttribs);
+    for(GLuint i = 0; i < RDCMIN(maxNumAttribs, (GLuint)ARRAY_COUNT(GenericVertexAttribs)); i++)
+      GL.glVertexAttrib4fv(i, &GenericVertexAttribs[i].x);
+  }
 
-  GL.glLineWidth(LineWidth);
-  if(!IsGLES)
+  if(parts & ePart_Raster)
   {
-    GL.glPointParameterf(eGL_POINT_FADE_THRESHOLD_SIZE, PointFadeThresholdSize);
-    GL.glPointParameteri(eGL_POINT_SPRITE_COORD_ORIGIN, (GLint)PointSpriteOrigin);
-    GL.glPointSize(PointSize);
-  }
+    GL.glLineWidth(LineWidth);
+    if(!IsGLES)
+    {
+      GL.glPointParameterf(eGL_POINT_FADE_THRESHOLD_SIZE, PointFadeThresholdSize);
+      GL.glPointParameteri(eGL_POINT_SPRITE_COORD_ORIGIN, (GLint)PointSpriteOrigin);
+      GL.glPointSize(PointSize);
+    }
 
-  if(!IsGLES)
-    GL.glPrimitiveRestartIndex(PrimitiveRestartIndex);
-  if(GL.glClipControl && HasExt[ARB_clip_control])
-    GL.glClipControl(ClipOrigin, ClipDepth);
-  if(!IsGLES)
-    GL.glProvokingVertex(ProvokingVertex);
+    if(!IsGLES)
+      GL.glPrimitiveRestartIndex(PrimitiveRestartIndex);
+    if(GL.glClipControl && HasExt[ARB_clip_control])
+      GL.glClipControl(ClipOrigin, ClipDepth);
+    if(!IsGLES)
+      GL.glProvokingVertex(ProvokingVertex);
+  }
 
-  GL.glUseProgram(Program.name);
-  if(HasExt[ARB_separate_shader_objects])
-    GL.glBindProgramPipeline(Pipeline.name);
+  if(parts & ePart_Program)
+  {
+    GL.glUseProgram(Program.name);
+    if(HasExt[ARB_separate_shader_objects])
+      GL.glBindProgramPipeline(Pipeline.name);
 
-  GLenum shs[] = {eGL_VERTEX_SHADER,   eGL_TESS_CONTROL_SHADER, eGL_TESS_EVALUATION_SHADER,
-                  eGL_GEOMETRY_SHADER, eGL_FRAGMENT_SHADER,     eGL_COMPUTE_SHADER};
+    GLenum shs[] = {eGL_VERTEX_SHADER,   eGL_TESS_CONTROL_SHADER, eGL_TESS_EVALUATION_SHADER,
+                    eGL_GEOMETRY_SHADER, eGL_FRAGMENT_SHADER,     eGL_COMPUTE_SHADER};
 
-  RDCCOMPILE_ASSERT(ARRAY_COUNT(shs) == ARRAY_COUNT(Subroutines),
-                    "Subroutine array not the right size");
-  for(size_t s = 0; s < ARRAY_COUNT(shs); s++)
-  {
-    if(shs[s] == eGL_COMPUTE_SHADER && !HasExt[ARB_compute_shader])
-      continue;
+    RDCCOMPILE_ASSERT(ARRAY_COUNT(shs) == ARRAY_COUNT(Subroutines),
+                      "Subroutine array not the right size");
+    for(size_t s = 0; s < ARRAY_COUNT(shs); s++)
+    {
+      if(shs[s] == eGL_COMPUTE_SHADER && !HasExt[ARB_compute_shader])
+        continue;
 
-    if((shs[s] == eGL_TESS_CONTROL_SHADER || shs[s] == eGL_TESS_EVALUATION_SHADER) &&
-       !HasExt[ARB_tessellation_shader])
-      continue;
+      if((shs[s] == eGL_TESS_CONTROL_SHADER || shs[s] == eGL_TESS_EVALUATION_SHADER) &&
+         !HasExt[ARB_tessellation_shader])
+        continue;
 
-    if(Subroutines[s].numSubroutines > 0)
-      GL.glUniformSubroutinesuiv(shs[s], Subroutines[s].numSubroutines, Subroutines[s].Values);
+      if(Subroutines[s].numSubroutines > 0)
+        GL.glUniformSubroutinesuiv(shs[s], Subroutines[s].numSubroutines, Subroutines[s].Values);
+    }
   }
 
-  GL.glBindBuffer(eGL_ARRAY_BUFFER, BufferBindings[eBufIdx_Array].name);
-  GL.glBindBuffer(eGL_COPY_READ_BUFFER, BufferBindings[eBufIdx_Copy_Read].name);
-  GL.glBindBuffer(eGL_COPY_WRITE_BUFFER, BufferBindings[eBufIdx_Copy_Write].name);
-  GL.glBindBuffer(eGL_PIXEL_PACK_BUFFER, BufferBindings[eBufIdx_Pixel_Pack].name);
-  GL.glBindBuffer(eGL_PIXEL_UNPACK_BUFFER, BufferBindings[eBufIdx_Pixel_Unpack].name);
-  if(HasExt[ARB_texture_buffer_object])
-    GL.glBindBuffer(eGL_TEXTURE_BUFFER, BufferBindings[eBufIdx_Texture].name);
-  if(HasExt[ARB_draw_indirect])
-    GL.glBindBuffer(eGL_DRAW_INDIRECT_BUFFER, BufferBindings[eBufIdx_Draw_Indirect].name);
-  if(HasExt[ARB_compute_shader])
-    GL.glBindBuffer(eGL_DISPATCH_INDIRECT_BUFFER, BufferBindings[eBufIdx_Dispatch_Indirect].name);
-  if(HasExt[ARB_query_buffer_object])
-    GL.glBindBuffer(eGL_QUERY_BUFFER, BufferBindings[eBufIdx_Query].name);
-  if(HasExt[ARB_indirect_parameters])
-    GL.glBindBuffer(eGL_PARAMETER_BUFFER_ARB, BufferBindings[eBufIdx_Parameter].name);
-
-  struct
+  if(parts & ePart_Buffers)
   {
-    IdxRangeBuffer *bufs;
-    int count;
-    GLenum binding;
-    GLenum maxcount;
-  } idxBufs[] = {
-      {
-          AtomicCounter, ARRAY_COUNT(AtomicCounter), eGL_ATOMIC_COUNTER_BUFFER,
-          eGL_MAX_ATOMIC_COUNTER_BUFFER_BINDINGS,
-      },
-      {
-          ShaderStorage, ARRAY_COUNT(ShaderStorage), eGL_SHADER_STORAGE_BUFFER,
-          eGL_MAX_SHADER_STORAGE_BUFFER_BINDINGS,
-      },
-      {
-          TransformFeedback, ARRAY_COUNT(TransformFeedback), eGL_TRANSFORM_FEEDBACK_BUFFER,
-          eGL_MAX_TRANSFORM_FEEDBACK_SEPARATE_ATTRIBS,
-      },
-      {
-          UniformBinding, ARRAY_COUNT(UniformBinding), eGL_UNIFORM_BUFFER,
-          eGL_MAX_UNIFORM_BUFFER_BINDINGS,
-      },
-  };
+    GL.glBindBuffer(eGL_ARRAY_BUFFER, BufferBindings[eBufIdx_Array].name);
+    GL.glBindBuffer(eGL_COPY_READ_BUFFER, BufferBindings[eBufIdx_Copy_Read].name);
+    GL.glBindBuffer(eGL_COPY_WRITE_BUFFER, BufferBindings[eBufIdx_Copy_Write].name);
+    GL.glBindBuffer(eGL_PIXEL_PACK_BUFFER, BufferBindings[eBufIdx_Pixel_Pack].name);
+    GL.glBindBuffer(eGL_PIXEL_UNPACK_BUFFER, BufferBindings[eBufIdx_Pixel_Unpack].name);
+    if(HasExt[ARB_texture_buffer_object])
+      GL.glBindBuffer(eGL_TEXTURE_BUFFER, BufferBindings[eBufIdx_Texture].name);
+    if(HasExt[ARB_draw_indirect])
+      GL.glBindBuffer(eGL_DRAW_INDIRECT_BUFFER, BufferBindings[eBufIdx_Draw_Indirect].name);
+    if(HasExt[ARB_compute_shader])
+      GL.glBindBuffer(eGL_DISPATCH_INDIRECT_BUFFER, BufferBindings[eBufIdx_Dispatch_Indirect].name);
+    if(HasExt[ARB_query_buffer_object])
+      GL.glBindBuffer(eGL_QUERY_BUFFER, BufferBindings[eBufIdx_Query].name);
+    if(HasExt[ARB_indirect_parameters])
+      GL.glBindBuffer(eGL_PARAMETER_BUFFER_ARB, BufferBindings[eBufIdx_Parameter].name);
+
+    struct
+    {
+      IdxRangeBuffer *bufs;
+      int count;
+      GLenum binding;
+      GLenum maxcount;
+    } idxBufs[] = {
+        {
+            AtomicCounter, ARRAY_COUNT(AtomicCounter), eGL_ATOMIC_COUNTER_BUFFER,
+            eGL_MAX_ATOMIC_COUNTER_BUFFER_BINDINGS,
+        },
+        {
+            ShaderStorage, ARRAY_COUNT(ShaderStorage), eGL_SHADER_STORAGE_BUFFER,
+            eGL_MAX_SHADER_STORAGE_BUFFER_BINDINGS,
+        },
+        {
+            TransformFeedback, ARRAY_COUNT(TransformFeedback), eGL_TRANSFORM_FEEDBACK_BUFFER,
+            eGL_MAX_TRANSFORM_FEEDBACK_SEPARATE_ATTRIBS,
+        },
+        {
+            UniformBinding, ARRAY_COUNT(UniformBinding), eGL_UNIFORM_BUFFER,
+            eGL_MAX_UNIFORM_BUFFER_BINDINGS,
+        },
+    };
 
-  for(size_t b = 0; b < ARRAY_COUNT(idxBufs); b++)
-  {
-    // only restore buffer bindings here if we were using the default transform feedback object
-    if(idxBufs[b].binding == eGL_TRANSFORM_FEEDBACK_BUFFER && FeedbackObj.name)
-      continue;
+    for(size_t b = 0; b < ARRAY_COUNT(idxBufs); b++)
+    {
+      // only restore buffer bindings here if we were using the default transform feedback object
+      if(idxBufs[b].binding == eGL_TRANSFORM_FEEDBACK_BUFFER && FeedbackObj.name)
+        continue;
 
-    if(idxBufs[b].binding == eGL_ATOMIC_COUNTER_BUFFER && !HasExt[ARB_shader_atomic_counters])
-      continue;
+      if(idxBufs[b].binding == eGL_ATOMIC_COUNTER_BUFFER && !HasExt[ARB_shader_atomic_counters])
+        continue;
 
-    if(idxBufs[b].binding == eGL_SHADER_STORAGE_BUFFER && !HasExt[ARB_shader_storage_buffer_object])
-      continue;
+      if(idxBufs[b].binding == eGL_SHADER_STORAGE_BUFFER && !HasExt[ARB_shader_storage_buffer_object])
+        continue;
 
-    if(idxBufs[b].binding == eGL_TRANSFORM_FEEDBACK_BUFFER && !HasExt[ARB_transform_feedback2])
-      continue;
+      if(idxBufs[b].binding == eGL_TRANSFORM_FEEDBACK_BUFFER && !HasExt[ARB_transform_feedback2])
+        continue;
 
-    GLint maxCount = 0;
-    GL.glGetIntegerv(idxBufs[b].maxcount, &maxCount);
-    for(int i = 0; i < idxBufs[b].count && i < maxCount; i++)
-    {
-      if(idxBufs[b].bufs[i].res.name == 0 ||
-         (idxBufs[b].bufs[i].start == 0 && idxBufs[b].bufs[i].size == 0))
-        GL.glBindBufferBase(idxBufs[b].binding, i, idxBufs[b].bufs[i].res.name);
-      else
-        GL.glBindBufferRange(idxBufs[b].binding, i, idxBufs[b].bufs[i].res.name,
-                             (GLintptr)idxBufs[b].bufs[i].start, (GLsizeiptr)idxBufs[b].bufs[i].size);
+      GLint maxCount = 0;
+      GL.glGetIntegerv(idxBufs[b].maxcount, &maxCount);
+      for(int i = 0; i < idxBufs[b].count && i < maxCount; i++)
+      {
+        if(idxBufs[b].bufs[i].res.name == 0 ||
+           (idxBufs[b].bufs[i].start == 0 && idxBufs[b].bufs[i].size == 0))
+          GL.glBindBufferBase(idxBufs[b].binding, i, idxBufs[b].bufs[i].res.name);
+        else
+          GL.glBindBufferRange(idxBufs[b].binding, i, idxBufs[b].bufs[i].res.name,
+                               (GLintptr)idxBufs[b].bufs[i].start, (GLsizeiptr)idxBufs[b].bufs[i].size);
+      }
     }
   }
 
   GLuint maxDraws = 0;
   GL.glGetIntegerv(eGL_MAX_DRAW_BUFFERS, (GLint *)&maxDraws);
 
-  if(HasExt[ARB_draw_buffers_blend])
+  if(parts & ePart_PixelOps)
   {
-    for(GLuint i = 0; i < RDCMIN(maxDraws, (GLuint)ARRAY_COUNT(Blends)); i++)
+    if(HasExt[ARB_draw_buffers_blend])
     {
-      // not set, possibly there were lesser draw buffers during capture
-      if(Blends[i].EquationRGB == eGL_NONE)
-        continue;
+      for(GLuint i = 0; i < RDCMIN(maxDraws, (GLuint)ARRAY_COUNT(Blends)); i++)
+      {
+        // not set, possibly there were lesser draw buffers during capture
+        if(Blends[i].EquationRGB == eGL_NONE)
+          continue;
 
-      GL.glBlendFuncSeparatei(i, Blends[i].SourceRGB, Blends[i].DestinationRGB,
-                              Blends[i].SourceAlpha, Blends[i].DestinationAlpha);
-      GL.glBlendEquationSeparatei(i, Blends[i].EquationRGB, Blends[i].EquationAlpha);
+        GL.glBlendFuncSeparatei(i, Blends[i].SourceRGB, Blends[i].DestinationRGB,
+                                Blends[i].SourceAlpha, Blends[i].DestinationAlpha);
+        GL.glBlendEquationSeparatei(i, Blends[i].EquationRGB, Blends[i].EquationAlpha);
 
-      if(Blends[i].Enabled)
-        GL.glEnablei(eGL_BLEND, i);
-      else
-        GL.glDisablei(eGL_BLEND, i);
+        if(Blends[i].Enabled)
+          GL.glEnablei(eGL_BLEND, i);
+        else
+          GL.glDisablei(eGL_BLEND, i);
+      }
     }
-  }
-  else
-  {
-    // not set, possibly there were lesser draw buffers during capture
-    if(Blends[0].EquationRGB != eGL_NONE)
+    else
     {
-      GL.glBlendFuncSeparate(Blends[0].SourceRGB, Blends[0].DestinationRGB, Blends[0].SourceAlpha,
-                             Blends[0].DestinationAlpha);
-      GL.glBlendEquationSeparate(Blends[0].EquationRGB, Blends[0].EquationAlpha);
+      // not set, possibly there were lesser draw buffers during capture
+      if(Blends[0].EquationRGB != eGL_NONE)
+      {
+        GL.glBlendFuncSeparate(Blends[0].SourceRGB, Blends[0].DestinationRGB, Blends[0].SourceAlpha,
+                               Blends[0].DestinationAlpha);
+        GL.glBlendEquationSeparate(Blends[0].EquationRGB, Blends[0].EquationAlpha);
 
-      if(Blends[0].Enabled)
-        GL.glEnable(eGL_BLEND);
-      else
-        GL.glDisable(eGL_BLEND);
+        if(Blends[0].Enabled)
+          GL.glEnable(eGL_BLEND);
+        else
+          GL.glDisable(eGL_BLEND);
+      }
     }
-  }
 
-  GL.glBlendColor(BlendColor[0], BlendColor[1], BlendColor[2], BlendColor[3]);
+    GL.glBlendColor(BlendColor[0], BlendColor[1], BlendColor[2], BlendColor[3]);
+  }
 
-  if(HasExt[ARB_viewport_array])
+  if(parts & ePart_ViewScissor)
   {
-    GLuint maxViews = 0;
-    GL.glGetIntegerv(eGL_MAX_VIEWPORTS, (GLint *)&maxViews);
-
-    GL.glViewportArrayv(0, RDCMIN(maxViews, (GLuint)ARRAY_COUNT(Viewports)), &Viewports[0].x);
-
-    for(GLuint s = 0; s < RDCMIN(maxViews, (GLuint)ARRAY_COUNT(Scissors)); ++s)
+    if(HasExt[ARB_viewport_array])
     {
-      GL.glScissorIndexedv(s, &Scissors[s].x);
+      GLuint maxViews = 0;
+      GL.glGetIntegerv(eGL_MAX_VIEWPORTS, (GLint *)&maxViews);
 
-      if(Scissors[s].enabled)
-        GL.glEnablei(eGL_SCISSOR_TEST, s);
-      else
-        GL.glDisablei(eGL_SCISSOR_TEST, s);
-    }
+      GL.glViewportArrayv(0, RDCMIN(maxViews, (GLuint)ARRAY_COUNT(Viewports)), &Viewports[0].x);
 
-    for(GLuint i = 0; i < RDCMIN(maxViews, (GLuint)ARRAY_COUNT(DepthRanges)); i++)
-    {
-      if(IsGLES)
+      for(GLuint s = 0; s < RDCMIN(maxViews, (GLuint)ARRAY_COUNT(Scissors)); ++s)
       {
-        float v[2] = {(float)DepthRanges[i].nearZ, (float)DepthRanges[i].farZ};
-        GL.glDepthRangeArrayfvOES(i, 1, v);
+        GL.glScissorIndexedv(s, &Scissors[s].x);
+
+        if(Scissors[s].enabled)
+          GL.glEnablei(eGL_SCISSOR_TEST, s);
+        else
+          GL.glDisablei(eGL_SCISSOR_TEST, s);
       }
-      else
+
+      for(GLuint i = 0; i < RDCMIN(maxViews, (GLuint)ARRAY_COUNT(DepthRanges)); i++)
       {
-        GL.glDepthRangeArrayv(i, 1, &DepthRanges[i].nearZ);
+        if(IsGLES)
+        {
+          float v[2] = {(float)DepthRanges[i].nearZ, (float)DepthRanges[i].farZ};
+          GL.glDepthRangeArrayfvOES(i, 1, v);
+        }
+        else
+        {
+          GL.glDepthRangeArrayv(i, 1, &DepthRanges[i].nearZ);
+        }
       }
     }
-  }
-  else
-  {
-    GL.glViewport((GLint)Viewports[0].x, (GLint)Viewports[0].y, (GLsizei)Viewports[0].width,
-                  (GLsizei)Viewports[0].height);
+    else
+    {
+      GL.glViewport((GLint)Viewports[0].x, (GLint)Viewports[0].y, (GLsizei)Viewports[0].width,
+                    (GLsizei)Viewports[0].height);
 
-    GL.glScissor(Scissors[0].x, Scissors[0].y, Scissors[0].width, Scissors[0].height);
+      GL.glScissor(Scissors[0].x, Scissors[0].y, Scissors[0].width, Scissors[0].height);
 
-    if(Scissors[0].enabled)
-      GL.glEnable(eGL_SCISSOR_TEST);
-    else
-      GL.glDisable(eGL_SCISSOR_TEST);
+      if(Scissors[0].enabled)
+        GL.glEnable(eGL_SCISSOR_TEST);
+      else
+        GL.glDisable(eGL_SCISSOR_TEST);
 
-    if(IsGLES)
-      GL.glDepthRangef((float)DepthRanges[0].nearZ, (float)DepthRanges[0].farZ);
-    else
-      GL.glDepthRange(DepthRanges[0].nearZ, DepthRanges[0].farZ);
+      if(IsGLES)
+        GL.glDepthRangef((float)DepthRanges[0].nearZ, (float)DepthRanges[0].farZ);
+      else
+        GL.glDepthRange(DepthRanges[0].nearZ, DepthRanges[0].farZ);
+    }
   }
 
-  GLenum DBs[8] = {eGL_NONE};
-  uint32_t numDBs = 0;
-  for(GLuint i = 0; i < RDCMIN(maxDraws, (GLuint)ARRAY_COUNT(DrawBuffers)); i++)
+  if(parts & ePart_Framebuffers)
   {
-    if(DrawBuffers[i] != eGL_NONE)
+    GLenum DBs[8] = {eGL_NONE};
+    uint32_t numDBs = 0;
+    for(GLuint i = 0; i < RDCMIN(maxDraws, (GLuint)ARRAY_COUNT(DrawBuffers)); i++)
     {
-      numDBs++;
-      DBs[i] = DrawBuffers[i];
+      if(DrawBuffers[i] != eGL_NONE)
+      {
+        numDBs++;
+        DBs[i] = DrawBuffers[i];
 
-      if(IsReplayMode(driver->GetState()))
+        if(IsReplayMode(driver->GetState()))
+        {
+          // since we are faking the default framebuffer with our own
+          // to see the results, replace back/front/left/right with color attachment 0
+          if(DBs[i] == eGL_BACK_LEFT || DBs[i] == eGL_BACK_RIGHT || DBs[i] == eGL_FRONT_LEFT ||
+             DBs[i] == eGL_FRONT_RIGHT)
+            DBs[i] = eGL_COLOR_ATTACHMENT0;
+
+          // These aren't valid for glDrawBuffers but can be returned when we call glGet,
+          // assume they mean left implicitly
+          if(DBs[i] == eGL_BACK || DBs[i] == eGL_FRONT || DBs[i] == eGL_FRONT_AND_BACK)
+            DBs[i] = eGL_COLOR_ATTACHMENT0;
+        }
+      }
+      else
       {
-        // since we are faking the default framebuffer with our own
-        // to see the results, replace back/front/left/right with color attachment 0
-        if(DBs[i] == eGL_BACK_LEFT || DBs[i] == eGL_BACK_RIGHT || DBs[i] == eGL_FRONT_LEFT ||
-           DBs[i] == eGL_FRONT_RIGHT)
-          DBs[i] = eGL_COLOR_ATTACHMENT0;
-
-        // These aren't valid for glDrawBuffers but can be returned when we call glGet,
-        // assume they mean left implicitly
-        if(DBs[i] == eGL_BACK || DBs[i] == eGL_FRONT || DBs[i] == eGL_FRONT_AND_BACK)
-          DBs[i] = eGL_COLOR_ATTACHMENT0;
+        break;
       }
     }
-    else
-    {
-      break;
-    }
-  }
-
-  // this will always return true during capture, but on replay we only do
-  // this work if we're on the replay context
-  if(driver->GetReplay()->IsReplayContext(ctx.ctx))
-  {
-    GLuint fbo = driver->GetCurrentDefaultFBO();
 
-    if(fbo)
+    // this will always return true during capture, but on replay we only do
+    // this work if we're on the replay context
+    if(driver->GetReplay()->IsReplayContext(ctx.ctx))
     {
-      // apply drawbuffers/readbuffer to default framebuffer
-      GL.glBindFramebuffer(eGL_READ_FRAMEBUFFER, driver->GetCurrentDefaultFBO());
-      GL.glBindFramebuffer(eGL_DRAW_FRAMEBUFFER, driver->GetCurrentDefaultFBO());
-      GL.glDrawBuffers(numDBs, DBs);
+      GLuint fbo = driver->GetCurrentDefaultFBO();
 
-      // see above for reasoning for this
-      GL.glReadBuffer(eGL_COLOR_ATTACHMENT0);
-    }
+      if(fbo)
+      {
+        // apply drawbuffers/readbuffer to default framebuffer
+        GL.glBindFramebuffer(eGL_READ_FRAMEBUFFER, driver->GetCurrentDefaultFBO());
+        GL.glBindFramebuffer(eGL_DRAW_FRAMEBUFFER, driver->GetCurrentDefaultFBO());
+        GL.glDrawBuffers(numDBs, DBs);
 
-    if(ReadFBO.name)
-      GL.glBindFramebuffer(eGL_READ_FRAMEBUFFER, ReadFBO.name);
-    else if(fbo)
-      GL.glBindFramebuffer(eGL_READ_FRAMEBUFFER, fbo);
+        // see above for reasoning for this
+        GL.glReadBuffer(eGL_COLOR_ATTACHMENT0);
+      }
+
+      if(ReadFBO.name)
+        GL.glBindFramebuffer(eGL_READ_FRAMEBUFFER, ReadFBO.name);
+      else if(fbo)
+        GL.glBindFramebuffer(eGL_READ_FRAMEBUFFER, fbo);
 
-    if(DrawFBO.name)
-      GL.glBindFramebuffer(eGL_DRAW_FRAMEBUFFER, DrawFBO.name);
-    else if(fbo)
-      GL.glBindFramebuffer(eGL_DRAW_FRAMEBUFFER, fbo);
+      if(DrawFBO.name)
+        GL.glBindFramebuffer(eGL_DRAW_FRAMEBUFFER, DrawFBO.name);
+      else if(fbo)
+        GL.glBindFramebuffer(eGL_DRAW_FRAMEBUFFER, fbo);
+    }
   }
 
-  GL.glHint(eGL_FRAGMENT_SHADER_DERIVATIVE_HINT, Hints.Derivatives);
-  if(!IsGLES)
+  if(parts & ePart_Raster)
   {
-    GL.glHint(eGL_LINE_SMOOTH_HINT, Hints.LineSmooth);
-    GL.glHint(eGL_POLYGON_SMOOTH_HINT, Hints.PolySmooth);
-    GL.glHint(eGL_TEXTURE_COMPRESSION_HINT, Hints.TexCompression);
+    GL.glHint(eGL_FRAGMENT_SHADER_DERIVATIVE_HINT, Hints.Derivatives);
+    if(!IsGLES)
+    {
+      GL.glHint(eGL_LINE_SMOOTH_HINT, Hints.LineSmooth);
+      GL.glHint(eGL_POLYGON_SMOOTH_HINT, Hints.PolySmooth);
+      GL.glHint(eGL_TEXTURE_COMPRESSION_HINT, Hints.TexCompression);
+    }
   }
 
-  GL.glDepthMask(DepthWriteMask);
-  GL.glClearDepthf(DepthClearValue);
-  GL.glDepthFunc(DepthFunc);
+  if(parts & ePart_PixelOps)
+  {
+    GL.glDepthMask(DepthWriteMask);
+    GL.glClearDepthf(DepthClearValue);
+    GL.glDepthFunc(DepthFunc);
 
-  if(HasExt[EXT_depth_bounds_test] && GL.glDepthBoundsEXT)
-    GL.glDepthBoundsEXT(DepthBounds.nearZ, DepthBounds.farZ);
+    if(HasExt[EXT_depth_bounds_test] && GL.glDepthBoundsEXT)
+      GL.glDepthBoundsEXT(DepthBounds.nearZ, DepthBounds.farZ);
 
-  {
-    GL.glStencilFuncSeparate(eGL_FRONT, StencilFront.func, StencilFront.ref, StencilFront.valuemask);
-    GL.glStencilFuncSeparate(eGL_BACK, StencilBack.func, StencilBack.ref, StencilBack.valuemask);
+    {
+      GL.glStencilFuncSeparate(eGL_FRONT, StencilFront.func, StencilFront.ref, StencilFront.valuemask);
+      GL.glStencilFuncSeparate(eGL_BACK, StencilBack.func, StencilBack.ref, StencilBack.valuemask);
 
-    GL.glStencilMaskSeparate(eGL_FRONT, StencilFront.writemask);
-    GL.glStencilMaskSeparate(eGL_BACK, StencilBack.writemask);
+      GL.glStencilMaskSeparate(eGL_FRONT, StencilFront.writemask);
+      GL.glStencilMaskSeparate(eGL_BACK, StencilBack.writemask);
 
-    GL.glStencilOpSeparate(eGL_FRONT, StencilFront.stencilFail, StencilFront.depthFail,
-                           StencilFront.pass);
-    GL.glStencilOpSeparate(eGL_BACK, StencilBack.stencilFail, StencilBack.depthFail,
-                           StencilBack.pass);
-  }
+      GL.glStencilOpSeparate(eGL_FRONT, StencilFront.stencilFail, StencilFront.depthFail,
+                             StencilFront.pass);
+      GL.glStencilOpSeparate(eGL_BACK, StencilBack.stencilFail, StencilBack.depthFail,
+                             StencilBack.pass);
+    }
 
-  GL.glClearStencil((GLint)StencilClearValue);
+    GL.glClearStencil((GLint)StencilClearValue);
 
-  if(HasExt[EXT_draw_buffers2] || HasExt[ARB_draw_buffers_blend])
-  {
-    for(GLuint i = 0; i < RDCMIN(maxDraws, (GLuint)ARRAY_COUNT(ColorMasks)); i++)
-      GL.glColorMaski(i, ColorMasks[i].red, ColorMasks[i].green, ColorMasks[i].blue,
-                      ColorMasks[i].alpha);
-  }
-  else
-  {
-    GL.glColorMask(ColorMasks[0].red, ColorMasks[0].green, ColorMasks[0].blue, ColorMasks[0].alpha);
-  }
+    if(HasExt[EXT_draw_buffers2] || HasExt[ARB_draw_buffers_blend])
+    {
+      for(GLuint i = 0; i < RDCMIN(maxDraws, (GLuint)ARRAY_COUNT(ColorMasks)); i++)
+        GL.glColorMaski(i, ColorMasks[i].red, ColorMasks[i].green, ColorMasks[i].blue,
+                        ColorMasks[i].alpha);
+    }
+    else
+    {
+      GL.glColorMask(ColorMasks[0].red, ColorMasks[0].green, ColorMasks[0].blue, ColorMasks[0].alpha);
+    }
 
-  if(HasExt[ARB_texture_multisample_no_array] || HasExt[ARB_texture_multisample])
-    GL.glSampleMaski(0, (GLbitfield)SampleMask[0]);
+    if(HasExt[ARB_texture_multisample_no_array] || HasExt[ARB_texture_multisample])
+      GL.glSampleMaski(0, (GLbitfield)SampleMask[0]);
 
-  GL.glSampleCoverage(SampleCoverage, SampleCoverageInvert ? GL_TRUE : GL_FALSE);
+    GL.glSampleCoverage(SampleCoverage, SampleCoverageInvert ? GL_TRUE : GL_FALSE);
 
-  if(HasExt[ARB_sample_shading])
-    GL.glMinSampleShading(MinSampleShading);
+    if(HasExt[ARB_sample_shading])
+      GL.glMinSampleShading(MinSampleShading);
 
-  if(HasExt[EXT_raster_multisample] && GL.glRasterSamplesEXT)
-    GL.glRasterSamplesEXT(RasterSamples, RasterFixed);
+    if(HasExt[EXT_raster_multisample] && GL.glRasterSamplesEXT)
+      GL.glRasterSamplesEXT(RasterSamples, RasterFixed);
 
-  if(!IsGLES)
-    GL.glLogicOp(LogicOp);
+    if(!IsGLES)
+      GL.glLogicOp(LogicOp);
 
-  GL.glClearColor(ColorClearValue.red, ColorClearValue.green, ColorClearValue.blue,
-                  ColorClearValue.alpha);
+    GL.glClearColor(ColorClearValue.red, ColorClearValue.green, ColorClearValue.blue,
+                    ColorClearValue.alpha);
+  }
 
-  if(HasExt[ARB_tessellation_shader])
+  if(parts & ePart_Raster)
   {
-    GL.glPatchParameteri(eGL_PATCH_VERTICES, PatchParams.numVerts);
-    if(!IsGLES)
+    if(HasExt[ARB_tessellation_shader])
     {
-      GL.glPatchParameterfv(eGL_PATCH_DEFAULT_INNER_LEVEL, PatchParams.defaultInnerLevel);
-      GL.glPatchParameterfv(eGL_PATCH_DEFAULT_OUTER_LEVEL, PatchParams.defaultOuterLevel);
+      GL.glPatchParameteri(eGL_PATCH_VERTICES, PatchParams.numVerts);
+      if(!IsGLES)
+      {
+        GL.glPatchParameterfv(eGL_PATCH_DEFAULT_INNER_LEVEL, PatchParams.defaultInnerLevel);
+        GL.glPatchParameterfv(eGL_PATCH_DEFAULT_OUTER_LEVEL, PatchParams.defaultOuterLevel);
+      }
     }
-  }
 
-  if(!IsGLES)
-    GL.glPolygonMode(eGL_FRONT_AND_BACK, PolygonMode);
+    if(!IsGLES)
+      GL.glPolygonMode(eGL_FRONT_AND_BACK, PolygonMode);
 
-  if(HasExt[ARB_polygon_offset_clamp])
-    GL.glPolygonOffsetClamp(PolygonOffset[0], PolygonOffset[1], PolygonOffset[2]);
-  else
-    GL.glPolygonOffset(PolygonOffset[0], PolygonOffset[1]);
+    if(HasExt[ARB_polygon_offset_clamp])
+      GL.glPolygonOffsetClamp(PolygonOffset[0], PolygonOffset[1], PolygonOffset[2]);
+    else
+      GL.glPolygonOffset(PolygonOffset[0], PolygonOffset[1]);
 
-  GL.glFrontFace(FrontFace);
-  GL.glCullFace(CullFace);
+    GL.glFrontFace(FrontFace);
+    GL.glCullFace(CullFace);
 
-  if(IsGLES && (HasExt[EXT_primitive_bounding_box] || HasExt[OES_primitive_bounding_box]))
-    GL.glPrimitiveBoundingBox(PrimitiveBoundingBox.minX, PrimitiveBoundingBox.minY,
-                              PrimitiveBoundingBox.minZ, PrimitiveBoundingBox.minW,
-                              PrimitiveBoundingBox.maxX, PrimitiveBoundingBox.maxY,
-                              PrimitiveBoundingBox.maxZ, PrimitiveBoundingBox.maxW);
+    if(IsGLES && (HasExt[EXT_primitive_bounding_box] || HasExt[OES_primitive_bounding_box]))
+      GL.glPrimitiveBoundingBox(PrimitiveBoundingBox.minX, PrimitiveBoundingBox.minY,
+                                PrimitiveBoundingBox.minZ, PrimitiveBoundingBox.minW,
+                                PrimitiveBoundingBox.maxX, PrimitiveBoundingBox.maxY,
+                                PrimitiveBoundingBox.maxZ, PrimitiveBoundingBox.maxW);
+  }
 
-  Unpack.Apply(true);
+  if(parts & ePart_PixelStorage)
+    Unpack.Apply(true);
 
   ClearGLErrors();
 }
@@ -1741,6 +1821,9 @@ void GLRenderState::Clear()
 {
   ContextPresent = true;
 
+  FetchedParts = ePart_All;
+  FetchedTexUnits = ~0U;
+
   RDCEraseEl(Enabled);
 
   RDCEraseEl(Tex1D);
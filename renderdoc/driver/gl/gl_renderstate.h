@@ -73,10 +73,37 @@ struct GLRenderState
   GLRenderState();
   ~GLRenderState();
 
-  void FetchState(WrappedOpenGL *driver);
+  // coarse parts of the state vector, so internal passes that only touch a known subset can
+  // snapshot and restore just that subset instead of paying for the full glGet storm every time.
+  enum StateParts : uint32_t
+  {
+    ePart_Enables = 0x0001,         // glEnable/glDisable caps
+    ePart_Textures = 0x0002,        // per-unit texture/sampler bindings and active texture
+    ePart_Images = 0x0004,          // image unit bindings
+    ePart_Vertex = 0x0008,          // VAO, transform feedback object, generic vertex attribs
+    ePart_Program = 0x0010,         // program, pipeline and subroutine state
+    ePart_Buffers = 0x0020,         // buffer bindings, including indexed ranges
+    ePart_ViewScissor = 0x0040,     // viewports, scissors and depth ranges
+    ePart_Framebuffers = 0x0080,    // read/draw framebuffers and read/draw buffer selection
+    ePart_PixelOps = 0x0100,        // blend, depth, stencil, masks, sample and clear state
+    ePart_Raster = 0x0200,          // fixed-function raster state, hints and patch params
+    ePart_PixelStorage = 0x0400,    // pixel pack/unpack state
+    ePart_All = 0xffffffff,
+  };
+
+  // fetches the selected parts of the state vector, limited to the first texUnits texture units.
+  // ApplyState restores exactly what was fetched. Partial snapshots are only safe around
+  // RenderDoc's own internal passes where the touched state is known - serialisation always takes
+  // the full state.
+  void FetchState(WrappedOpenGL *driver, uint32_t parts = ePart_All, uint32_t texUnits = ~0U);
   void ApplyState(WrappedOpenGL *driver);
   void Clear();
 
+  // which parts and texture units FetchState captured, so ApplyState restores only those.
+  // Deserialised states apply everything.
+  uint32_t FetchedParts;
+  uint32_t FetchedTexUnits;
+
   void MarkReferenced(WrappedOpenGL *driver, bool initial) const;
   void MarkDirty(WrappedOpenGL *driver) const;
 
@@ -285,13 +285,22 @@ void WrappedOpenGL::RenderText(float x, float y, const rdcstr &text)
 
   textState.Push(ctxdata.Modern());
 
-  rdcarray<rdcstr> lines;
-  split(text, lines, '\n');
-
-  for(const rdcstr &line : lines)
+  if(ctxdata.Modern())
   {
-    RenderTextInternal(x, y, line);
-    y += 1.0f;
+    // the modern path lays out newlines itself so the whole block draws in one go
+    RenderTextInternal(x, y, text);
+  }
+  else
+  {
+    // the immediate mode fallback positions each line separately
+    rdcarray<rdcstr> lines;
+    split(text, lines, '\n');
+
+    for(const rdcstr &line : lines)
+    {
+      RenderTextInternal(x, y, line);
+      y += 1.0f;
+    }
   }
 
   textState.Pop(ctxdata.Modern());
@@ -302,8 +311,6 @@ void WrappedOpenGL::RenderTextInternal(float x, float y, const rdcstr &text)
   if(text.empty())
     return;
 
-  RDCASSERT(text.size() < FONT_MAX_CHARS);
-
   ContextData &ctxdata = GetCtxData();
 
   if(!ctxdata.built || !ctxdata.ready || (ctxdata.Modern() && ctxdata.Program == 0))
@@ -314,22 +321,6 @@ void WrappedOpenGL::RenderTextInternal(float x, float y, const rdcstr &text)
   {
     GL.glBindBuffer(eGL_ARRAY_BUFFER, ctxdata.ArrayBuffer);
 
-    size_t len = text.size();
-
-    if((int)len > FONT_MAX_CHARS)
-    {
-      static bool printedWarning = false;
-
-      // this could be called once a frame, don't want to spam the log
-      if(!printedWarning)
-      {
-        printedWarning = true;
-        RDCWARN("log string '%s' is too long", text.c_str(), (int)len);
-      }
-
-      len = FONT_MAX_CHARS;
-    }
-
     static const Vec2f basePos[] = {
         Vec2f(0.0, 0.0), Vec2f(1.0, 0.0), Vec2f(0.0, 1.0),
         Vec2f(1.0, 0.0), Vec2f(0.0, 1.0), Vec2f(1.0, 1.0),
@@ -338,17 +329,29 @@ void WrappedOpenGL::RenderTextInternal(float x, float y, const rdcstr &text)
     const Vec2f FontScreenAspect(ctxdata.CharAspect / RDCMAX(1.0f, float(ctxdata.initParams.width)),
                                  1.0f / RDCMAX(1.0f, float(ctxdata.initParams.height)));
 
-    float *vertexData = new float[5 * len * 6];
+    // lay the whole block out on the CPU, consuming newlines, so it draws with one upload and
+    // draw per chunk of the array buffer rather than one per line
+    rdcarray<float> vertexData;
+    vertexData.reserve(5 * 6 * text.size());
 
-    for(size_t i = 0; i < len; i++)
+    float col = 0.0f, row = 0.0f;
+
+    for(size_t i = 0; i < text.size(); i++)
     {
+      if(text[i] == '\n')
+      {
+        col = 0.0f;
+        row += 1.0f;
+        continue;
+      }
+
       for(int ch = 0; ch < 6; ch++)
       {
         Vec2f uv = basePos[ch];
 
         Vec2f pos = uv;
-        pos.x += float(i) + x;
-        pos.y += y;
+        pos.x += col + x;
+        pos.y += row + y;
 
         pos.x *= 2.0f * ctxdata.CharSize * FontScreenAspect.x;
         pos.y *= 2.0f * ctxdata.CharSize * FontScreenAspect.y;
@@ -356,18 +359,20 @@ void WrappedOpenGL::RenderTextInternal(float x, float y, const rdcstr &text)
         pos.x -= 1.0f;
         pos.y -= 1.0f;
 
-        vertexData[(i * 6 + ch) * 5 + 0] = pos.x;
-        vertexData[(i * 6 + ch) * 5 + 1] = ctxdata.initParams.isYFlipped ? pos.y : -pos.y;
-        vertexData[(i * 6 + ch) * 5 + 2] = uv.x;
-        vertexData[(i * 6 + ch) * 5 + 3] = uv.y;
-        vertexData[(i * 6 + ch) * 5 + 4] = float(text[i] - FONT_FIRST_CHAR);
+        vertexData.push_back(pos.x);
+        vertexData.push_back(ctxdata.initParams.isYFlipped ? pos.y : -pos.y);
+        vertexData.push_back(uv.x);
+        vertexData.push_back(uv.y);
+        vertexData.push_back(float(text[i] - FONT_FIRST_CHAR));
       }
+
+      col += 1.0f;
     }
 
-    // we read 6 * len vec2 positions and 6 * len float characters
-    GL.glBufferSubData(eGL_ARRAY_BUFFER, 0, sizeof(float) * 5 * len * 6, vertexData);
+    size_t len = vertexData.size() / (5 * 6);
 
-    delete[] vertexData;
+    if(len == 0)
+      return;
 
     //////////////////////////////////////////////////////////////////////////////////
     // Make sure if you change any other state in here, that you also update the push
@@ -445,8 +450,17 @@ void WrappedOpenGL::RenderTextInternal(float x, float y, const rdcstr &text)
     // bind program
     GL.glUseProgram(ctxdata.Program);
 
-    // draw string
-    GL.glDrawArrays(eGL_TRIANGLES, 0, 6 * (GLsizei)len);
+    // upload and draw the string, in chunks if it's too long for the array buffer
+    for(size_t start = 0; start < len; start += FONT_MAX_CHARS)
+    {
+      size_t chars = RDCMIN(len - start, (size_t)FONT_MAX_CHARS);
+
+      // we read 6 * chars vec2 positions and 6 * chars float characters
+      GL.glBufferSubData(eGL_ARRAY_BUFFER, 0, sizeof(float) * 5 * chars * 6,
+                         vertexData.data() + start * 5 * 6);
+
+      GL.glDrawArrays(eGL_TRIANGLES, 0, 6 * (GLsizei)chars);
+    }
   }
   else
   {
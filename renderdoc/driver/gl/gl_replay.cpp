@@ -227,10 +227,22 @@ void GLReplay::SetReplayData(GLWindowingData data)
   m_pDriver->RegisterDebugCallback();
 
   InitDebugData();
+}
+
+void GLReplay::InitIHVCounters()
+{
+  // only try once, and only after the UI first asks for counters - GPUPerfAPI and friends can take
+  // seconds to load and initialise, which we don't want to pay on every capture open.
+  if(m_IHVCountersTried)
+    return;
+
+  m_IHVCountersTried = true;
 
   if(!HasDebugContext())
     return;
 
+  MakeCurrentReplayContext(&m_ReplayCtx);
+
   if(!m_Proxy && OpenGL_HardwareCounters)
   {
     AMDCounters *countersAMD = NULL;
@@ -3436,6 +3448,16 @@ rdcarray<PixelModification> GLReplay::PixelHistory(rdcarray<EventUsage> events,
   return {};
 }
 
+rdcarray<rdcarray<PixelModification>> GLReplay::PixelHistoryRegion(rdcarray<EventUsage> events,
+                                                                   ResourceId target, uint32_t x,
+                                                                   uint32_t y, uint32_t width,
+                                                                   uint32_t height,
+                                                                   const Subresource &sub,
+                                                                   CompType typeCast)
+{
+  return StandardPixelHistoryRegion(this, events, target, x, y, width, height, sub, typeCast);
+}
+
 ShaderDebugTrace *GLReplay::DebugVertex(uint32_t eventId, uint32_t vertid, uint32_t instid,
                                         uint32_t idx)
 {
@@ -3450,6 +3472,12 @@ ShaderDebugTrace *GLReplay::DebugPixel(uint32_t eventId, uint32_t x, uint32_t y,
   return new ShaderDebugTrace();
 }
 
+rdcarray<ShaderDebugTrace *> GLReplay::DebugPixels(uint32_t eventId,
+                                                   const rdcarray<PixelDebugTarget> &targets)
+{
+  return StandardDebugPixels(this, eventId, targets);
+}
+
 ShaderDebugTrace *GLReplay::DebugThread(uint32_t eventId, const uint32_t groupid[3],
                                         const uint32_t threadid[3])
 {
@@ -217,9 +217,15 @@ public:
 
   rdcarray<PixelModification> PixelHistory(rdcarray<EventUsage> events, ResourceId target, uint32_t x,
                                            uint32_t y, const Subresource &sub, CompType typeCast);
+  rdcarray<rdcarray<PixelModification>> PixelHistoryRegion(rdcarray<EventUsage> events,
+                                                           ResourceId target, uint32_t x, uint32_t y,
+                                                           uint32_t width, uint32_t height,
+                                                           const Subresource &sub, CompType typeCast);
   ShaderDebugTrace *DebugVertex(uint32_t eventId, uint32_t vertid, uint32_t instid, uint32_t idx);
   ShaderDebugTrace *DebugPixel(uint32_t eventId, uint32_t x, uint32_t y, uint32_t sample,
                                uint32_t primitive);
+  rdcarray<ShaderDebugTrace *> DebugPixels(uint32_t eventId,
+                                           const rdcarray<PixelDebugTarget> &targets);
   ShaderDebugTrace *DebugThread(uint32_t eventId, const uint32_t groupid[3],
                                 const uint32_t threadid[3]);
   rdcarray<ShaderDebugState> ContinueDebug(ShaderDebugger *debugger);
@@ -244,6 +250,7 @@ public:
 
   void FileChanged() {}
   void SetReplayData(GLWindowingData data);
+  void InitIHVCounters();
 
   bool IsReplayContext(void *ctx) { return m_ReplayCtx.ctx == NULL || ctx == m_ReplayCtx.ctx; }
   bool HasDebugContext() { return m_DebugCtx != NULL; }
@@ -449,6 +456,9 @@ private:
 
   std::map<CompleteCacheKey, rdcstr> m_CompleteCache;
 
+  // IHV counter libraries are loaded lazily on the first counter enumeration, not at replay init
+  bool m_IHVCountersTried = false;
+
   // AMD counter instance
   AMDCounters *m_pAMDCounters = NULL;
 
@@ -22,6 +22,7 @@
  * THE SOFTWARE.
  ******************************************************************************/
 
+#include <algorithm>
 #include "gl_common.h"
 #include "gl_dispatch_table_defs.h"
 #include "gl_driver.h"
@@ -168,11 +169,20 @@ rdcstr DoStringise(const RDCGLenum &el)
   RDCCOMPILE_ASSERT(sizeof(RDCGLenum) == sizeof(uint32_t),
                     "Enum isn't 32bits - serialising is a problem!");
 
-#define TOSTR_CASE_STRINGIZE_GLENUM(a) \
-  case e##a: return #a;
-
-  switch((unsigned int)el)
+  // GLenum values are far too sparse for a switch over them to become a jump table - it compiles
+  // to a large tree of immediate compares that gets re-walked on every call, which adds up when
+  // stringising whole captures. Instead we put the values in a table, sort it once on first use,
+  // and binary search. As a bonus the names are returned as literals rather than allocating a new
+  // string for each call.
+  struct GLEnumName
   {
+    uint32_t value;
+    rdcliteral name;
+  };
+
+#define TOSTR_CASE_STRINGIZE_GLENUM(a) {uint32_t(e##a), STRING_LITERAL(#a)},
+
+  static GLEnumName names[] = {
     TOSTR_CASE_STRINGIZE_GLENUM(GL_NONE)
     TOSTR_CASE_STRINGIZE_GLENUM(GL_LINES)
     TOSTR_CASE_STRINGIZE_GLENUM(GL_LINE_LOOP)
@@ -4114,8 +4124,23 @@ rdcstr DoStringise(const RDCGLenum &el)
     TOSTR_CASE_STRINGIZE_GLENUM(EGL_NATIVE_BUFFER_TIZEN)
     TOSTR_CASE_STRINGIZE_GLENUM(EGL_NATIVE_SURFACE_TIZEN)
     TOSTR_CASE_STRINGIZE_GLENUM(KHRONOS_MAX_ENUM)
-    default: break;
-  }
+  };
+
+  static bool sorted = []() {
+    std::sort(names, names + ARRAY_COUNT(names),
+              [](const GLEnumName &a, const GLEnumName &b) { return a.value < b.value; });
+    return true;
+  }();
+  (void)sorted;
+
+  const uint32_t value = (uint32_t)el;
+
+  const GLEnumName *it =
+      std::lower_bound(names, names + ARRAY_COUNT(names), value,
+                       [](const GLEnumName &entry, uint32_t v) { return entry.value < v; });
+
+  if(it != names + ARRAY_COUNT(names) && it->value == value)
+    return it->name;
 
   return StringFormat::Fmt("GLenum(%x)", el);
 
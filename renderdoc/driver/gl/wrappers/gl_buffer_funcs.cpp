@@ -925,6 +925,71 @@ bool WrappedOpenGL::Serialise_glNamedBufferSubDataEXT(SerialiserType &ser, GLuin
   return true;
 }
 
+bool WrappedOpenGL::TryCoalesceBufferUpdate(GLResourceRecord *record, GLuint buffer,
+                                            GLintptr offsetPtr, GLsizeiptr size, const void *data)
+{
+  // cap on how much update data we'll hold back in one pending chunk
+  const uint64_t maxPendingSize = 4 * 1024 * 1024;
+
+  if(record == NULL || uint64_t(size) > maxPendingSize)
+  {
+    FlushPendingBufferUpdate();
+    return false;
+  }
+
+  uint64_t start = uint64_t(offsetPtr);
+  uint64_t end = start + uint64_t(size);
+
+  if(m_PendingBufferUpdate.record == record)
+  {
+    uint64_t pendStart = m_PendingBufferUpdate.offset;
+    uint64_t pendEnd = pendStart + m_PendingBufferUpdate.data.size();
+
+    // merge updates that overlap or directly append. A gap would have to be filled with buffer
+    // data we don't have, and updates below the pending start would need a prepend - both rare
+    // for the sequential streaming patterns this is aimed at, so just flush in those cases.
+    if(start >= pendStart && start <= pendEnd && end - pendStart <= maxPendingSize)
+    {
+      if(end > pendEnd)
+        m_PendingBufferUpdate.data.resize(size_t(end - pendStart));
+
+      memcpy(m_PendingBufferUpdate.data.data() + (start - pendStart), data, size_t(size));
+      return true;
+    }
+  }
+
+  // can't merge - flush whatever was pending and start a new pending update for this one
+  FlushPendingBufferUpdate();
+
+  m_PendingBufferUpdate.record = record;
+  m_PendingBufferUpdate.buffer = buffer;
+  m_PendingBufferUpdate.offset = start;
+  m_PendingBufferUpdate.data.assign((const byte *)data, size_t(size));
+
+  return true;
+}
+
+void WrappedOpenGL::FlushPendingBufferUpdate()
+{
+  if(m_PendingBufferUpdate.record == NULL)
+    return;
+
+  // clear the pending state before serialising - fetching the context record to add the chunk
+  // to would otherwise recurse back into this flush.
+  GLuint buffer = m_PendingBufferUpdate.buffer;
+  uint64_t offset = m_PendingBufferUpdate.offset;
+  bytebuf data;
+  data.swap(m_PendingBufferUpdate.data);
+  m_PendingBufferUpdate.record = NULL;
+
+  USE_SCRATCH_SERIALISER();
+  SCOPED_SERIALISE_CHUNK(GLChunk::glNamedBufferSubDataEXT);
+  Serialise_glNamedBufferSubDataEXT(ser, buffer, (GLintptr)offset, (GLsizeiptr)data.size(),
+                                    data.data());
+
+  GetContextRecord()->AddChunk(scope.Get());
+}
+
 void WrappedOpenGL::glNamedBufferSubDataEXT(GLuint buffer, GLintptr offset, GLsizeiptr size,
                                             const void *data)
 {
@@ -950,22 +1015,30 @@ void WrappedOpenGL::glNamedBufferSubDataEXT(GLuint buffer, GLintptr offset, GLsi
        IsBackgroundCapturing(m_State))
       return;
 
-    USE_SCRATCH_SERIALISER();
-    SCOPED_SERIALISE_CHUNK(gl_CurChunk);
-    Serialise_glNamedBufferSubDataEXT(ser, buffer, offset, size, data);
-
-    Chunk *chunk = scope.Get();
-
     if(IsActiveCapturing(m_State))
     {
-      GetContextRecord()->AddChunk(chunk);
       GetResourceManager()->MarkDirtyResource(record->GetResourceID());
       GetResourceManager()->MarkResourceFrameReferenced(record->GetResourceID(),
                                                         eFrameRef_ReadBeforeWrite);
+
+      // batch consecutive updates to the same buffer into one chunk. Anything else being
+      // recorded flushes the pending update, preserving ordering.
+      if(TryCoalesceBufferUpdate(record, buffer, offset, size, data))
+        return;
+
+      USE_SCRATCH_SERIALISER();
+      SCOPED_SERIALISE_CHUNK(gl_CurChunk);
+      Serialise_glNamedBufferSubDataEXT(ser, buffer, offset, size, data);
+
+      GetContextRecord()->AddChunk(scope.Get());
     }
     else
     {
-      record->AddChunk(chunk);
+      USE_SCRATCH_SERIALISER();
+      SCOPED_SERIALISE_CHUNK(gl_CurChunk);
+      Serialise_glNamedBufferSubDataEXT(ser, buffer, offset, size, data);
+
+      record->AddChunk(scope.Get());
       record->UpdateCount++;
 
       if(record->UpdateCount > 10)
@@ -1011,22 +1084,30 @@ void WrappedOpenGL::glBufferSubData(GLenum target, GLintptr offset, GLsizeiptr s
        IsBackgroundCapturing(m_State))
       return;
 
-    USE_SCRATCH_SERIALISER();
-    SCOPED_SERIALISE_CHUNK(gl_CurChunk);
-    Serialise_glNamedBufferSubDataEXT(ser, res.name, offset, size, data);
-
-    Chunk *chunk = scope.Get();
-
     if(IsActiveCapturing(m_State))
     {
-      GetContextRecord()->AddChunk(chunk);
       GetResourceManager()->MarkDirtyResource(record->GetResourceID());
       GetResourceManager()->MarkResourceFrameReferenced(record->GetResourceID(),
                                                         eFrameRef_ReadBeforeWrite);
+
+      // batch consecutive updates to the same buffer into one chunk. Anything else being
+      // recorded flushes the pending update, preserving ordering.
+      if(TryCoalesceBufferUpdate(record, res.name, offset, size, data))
+        return;
+
+      USE_SCRATCH_SERIALISER();
+      SCOPED_SERIALISE_CHUNK(gl_CurChunk);
+      Serialise_glNamedBufferSubDataEXT(ser, res.name, offset, size, data);
+
+      GetContextRecord()->AddChunk(scope.Get());
     }
     else
     {
-      record->AddChunk(chunk);
+      USE_SCRATCH_SERIALISER();
+      SCOPED_SERIALISE_CHUNK(gl_CurChunk);
+      Serialise_glNamedBufferSubDataEXT(ser, res.name, offset, size, data);
+
+      record->AddChunk(scope.Get());
       record->UpdateCount++;
 
       if(record->UpdateCount > 10)
@@ -4851,6 +4932,10 @@ void WrappedOpenGL::glDeleteBuffers(GLsizei n, const GLuint *buffers)
       GLResourceRecord *record = GetResourceManager()->GetResourceRecord(res);
       if(record)
       {
+        // flush any coalesced pending update to this buffer before its record disappears
+        if(m_PendingBufferUpdate.record == record)
+          FlushPendingBufferUpdate();
+
         // if we have a persistent pointer, make sure to unmap it
         {
           m_PersistentMaps.erase(record);
@@ -31,6 +31,7 @@
 #include "../gl_driver.h"
 #include "../gl_resources.h"
 #include "driver/shaders/spirv/glslang_compile.h"
+#include "maths/formatpacking.h"
 
 namespace glEmulate
 {
@@ -2970,20 +2971,8 @@ void APIENTRY _glGetTexImage(GLenum target, GLint level, GLenum format, GLenum t
         // how big is a component (1/2/4 bytes)
         size_t compSize = GetByteSize(1, 1, 1, eGL_RED, type);
 
-        byte *src = readback;
-
-        // for each pixel
-        for(GLint i = 0; i < width * height; i++)
-        {
-          // copy RGB
-          memcpy(dst, src, compSize * 3);
-
-          // advance dst by RGB
-          dst += compSize * 3;
-
-          // advance src by RGBA
-          src += compSize * 4;
-        }
+        // copy each pixel's RGB and skip the alpha
+        ConvertRGBAToRGB(dst, readback, compSize, size_t(width) * size_t(height));
 
         delete[] readback;
 
@@ -3002,9 +2991,7 @@ void APIENTRY _glGetTexImage(GLenum target, GLint level, GLenum format, GLenum t
     if(fixBGRA)
     {
       // since we read back the texture with RGBA format, we have to flip the R and B components
-      byte *b = dst;
-      for(GLint i = 0, n = width * height; i < n; ++i, b += 4)
-        std::swap(*b, *(b + 2));
+      SwapRedBlue8(dst, size_t(width) * size_t(height));
     }
   }
 
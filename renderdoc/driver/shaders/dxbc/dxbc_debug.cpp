@@ -1293,7 +1293,7 @@ void ThreadState::SetDst(ShaderDebugState *state, const Operand &dstoper, const
   {
     state->flags |= flags;
     change.after = *changeVar;
-    state->changes.push_back(change);
+    state->changes.push_back(std::move(change));
   }
 }
 
@@ -1934,6 +1934,9 @@ void ThreadState::StepNext(ShaderDebugState *state, DebugAPIWrapper *apiWrapper,
 
   const Operation &op = program->GetInstruction((size_t)nextInstruction);
 
+  // remember the instruction being processed, for the control flow jumps below
+  const uint32_t instructionIdx = nextInstruction;
+
   apiWrapper->SetCurrentInstruction(nextInstruction);
   nextInstruction++;
 
@@ -4120,33 +4123,18 @@ void ThreadState::StepNext(ShaderDebugState *state, DebugAPIWrapper *apiWrapper,
     case OPCODE_CONTINUEC:
     case OPCODE_ENDLOOP:
     {
-      int depth = 0;
-
       int32_t test = op.operation == OPCODE_CONTINUEC ? GetSrc(op.operands[0], op).value.i.x : 0;
 
-      if(op.operation == OPCODE_CONTINUE || op.operation == OPCODE_CONTINUEC)
-        depth = 1;
-
       if((test == 0 && !op.nonzero) || (test != 0 && op.nonzero) ||
          op.operation == OPCODE_CONTINUE || op.operation == OPCODE_ENDLOOP)
       {
-        // skip back one to the endloop that we're processing
-        nextInstruction--;
-
-        for(; nextInstruction >= 0; nextInstruction--)
-        {
-          if(program->GetInstruction(nextInstruction).operation == OPCODE_ENDLOOP)
-            depth++;
-          if(program->GetInstruction(nextInstruction).operation == OPCODE_LOOP)
-            depth--;
+        // jump back to the matching loop header, precomputed once for the program
+        uint32_t target = global.jumpTargets[instructionIdx];
 
-          if(depth == 0)
-          {
-            break;
-          }
-        }
+        RDCASSERT(target != ~0U);
 
-        RDCASSERT(nextInstruction >= 0);
+        if(target != ~0U)
+          nextInstruction = target;
       }
 
       break;
@@ -4158,29 +4146,13 @@ void ThreadState::StepNext(ShaderDebugState *state, DebugAPIWrapper *apiWrapper,
 
       if((test == 0 && !op.nonzero) || (test != 0 && op.nonzero) || op.operation == OPCODE_BREAK)
       {
-        // break out (jump to next endloop/endswitch)
-        int depth = 1;
-
-        for(; nextInstruction < (int)program->GetNumInstructions(); nextInstruction++)
-        {
-          if(program->GetInstruction(nextInstruction).operation == OPCODE_LOOP ||
-             program->GetInstruction(nextInstruction).operation == OPCODE_SWITCH)
-            depth++;
-          if(program->GetInstruction(nextInstruction).operation == OPCODE_ENDLOOP ||
-             program->GetInstruction(nextInstruction).operation == OPCODE_ENDSWITCH)
-            depth--;
-
-          if(depth == 0)
-          {
-            break;
-          }
-        }
+        // break out past the enclosing endloop/endswitch, precomputed once for the program
+        uint32_t target = global.jumpTargets[instructionIdx];
 
-        RDCASSERT(program->GetInstruction(nextInstruction).operation == OPCODE_ENDLOOP ||
-                  program->GetInstruction(nextInstruction).operation == OPCODE_ENDSWITCH);
+        RDCASSERT(target != ~0U);
 
-        // don't want to process the endloop and jump again!
-        nextInstruction++;
+        if(target != ~0U)
+          nextInstruction = target;
       }
 
       break;
@@ -4195,61 +4167,27 @@ void ThreadState::StepNext(ShaderDebugState *state, DebugAPIWrapper *apiWrapper,
       }
       else
       {
-        // jump to after the next matching else/endif
-        int depth = 0;
-
-        // skip back one to the if that we're processing
-        nextInstruction--;
-
-        for(; nextInstruction < (int)program->GetNumInstructions(); nextInstruction++)
-        {
-          if(program->GetInstruction(nextInstruction).operation == OPCODE_IF)
-            depth++;
-          // only step out on an else if it's the matching depth to our starting if (depth == 1)
-          if(depth == 1 && program->GetInstruction(nextInstruction).operation == OPCODE_ELSE)
-            depth--;
-          if(program->GetInstruction(nextInstruction).operation == OPCODE_ENDIF)
-            depth--;
-
-          if(depth == 0)
-          {
-            break;
-          }
-        }
+        // jump past the matching else/endif, precomputed once for the program
+        uint32_t target = global.jumpTargets[instructionIdx];
 
-        RDCASSERT(program->GetInstruction(nextInstruction).operation == OPCODE_ELSE ||
-                  program->GetInstruction(nextInstruction).operation == OPCODE_ENDIF);
+        RDCASSERT(target != ~0U);
 
-        // step to next instruction after the else/endif (processing an else would skip that block)
-        nextInstruction++;
+        if(target != ~0U)
+          nextInstruction = target;
       }
 
       break;
     }
     case OPCODE_ELSE:
     {
-      // if we hit an else then we've just processed the if() bracket and need to break out (jump to
-      // next endif)
-      int depth = 1;
+      // if we hit an else then we've just processed the if() bracket and need to break out (jump
+      // past the matching endif, precomputed once for the program)
+      uint32_t target = global.jumpTargets[instructionIdx];
 
-      for(; nextInstruction < (int)program->GetNumInstructions(); nextInstruction++)
-      {
-        if(program->GetInstruction(nextInstruction).operation == OPCODE_IF)
-          depth++;
-        if(program->GetInstruction(nextInstruction).operation == OPCODE_ENDIF)
-          depth--;
-
-        if(depth == 0)
-        {
-          break;
-        }
-      }
-
-      RDCASSERT(program->GetInstruction(nextInstruction).operation == OPCODE_ENDIF);
+      RDCASSERT(target != ~0U);
 
-      // step to next instruction after the else/endif (for consistency with handling in the if
-      // block)
-      nextInstruction++;
+      if(target != ~0U)
+        nextInstruction = target;
 
       break;
     }
@@ -4360,6 +4298,139 @@ void GlobalState::PopulateGroupshared(const DXBCBytecode::Program *pBytecode)
   }
 }
 
+void GlobalState::PrecomputeJumpTargets(const DXBCBytecode::Program *pBytecode)
+{
+  // the control flow instructions below jump by scanning the program for their matching label -
+  // e.g. an endloop scans backwards for its loop, a failed if scans forwards for its else/endif.
+  // Stepping through a long loop redoes those scans on every iteration, so precompute the targets
+  // once here with a scope stack instead. The table is indexed by instruction and shared by every
+  // thread in the workgroup. switch isn't included since its target depends on the value tested.
+
+  const size_t numInstructions = pBytecode->GetNumInstructions();
+
+  jumpTargets.clear();
+  jumpTargets.fill(numInstructions, ~0U);
+
+  struct Scope
+  {
+    OpcodeType type;
+    uint32_t startIndex;
+    uint32_t elseIndex;
+    rdcarray<uint32_t> breaks;
+  };
+
+  rdcarray<Scope> scopes;
+
+  for(uint32_t i = 0; i < (uint32_t)numInstructions; i++)
+  {
+    OpcodeType operation = pBytecode->GetInstruction(i).operation;
+
+    switch(operation)
+    {
+      case OPCODE_LOOP:
+      case OPCODE_SWITCH:
+      case OPCODE_IF:
+      {
+        Scope scope;
+        scope.type = operation;
+        scope.startIndex = i;
+        scope.elseIndex = ~0U;
+        scopes.push_back(scope);
+        break;
+      }
+      case OPCODE_ELSE:
+      {
+        if(!scopes.empty() && scopes.back().type == OPCODE_IF && scopes.back().elseIndex == ~0U)
+          scopes.back().elseIndex = i;
+        else
+          RDCERR("Unexpected else at instruction %u", i);
+        break;
+      }
+      case OPCODE_ENDIF:
+      {
+        if(!scopes.empty() && scopes.back().type == OPCODE_IF)
+        {
+          const Scope &scope = scopes.back();
+
+          // a failed if jumps past its else if it has one, otherwise past the endif. Reaching an
+          // else means the if side was taken, so it jumps past the endif.
+          jumpTargets[scope.startIndex] = (scope.elseIndex != ~0U ? scope.elseIndex : i) + 1;
+          if(scope.elseIndex != ~0U)
+            jumpTargets[scope.elseIndex] = i + 1;
+
+          scopes.pop_back();
+        }
+        else
+        {
+          RDCERR("Unexpected endif at instruction %u", i);
+        }
+        break;
+      }
+      case OPCODE_ENDLOOP:
+      case OPCODE_ENDSWITCH:
+      {
+        OpcodeType open = operation == OPCODE_ENDLOOP ? OPCODE_LOOP : OPCODE_SWITCH;
+
+        if(!scopes.empty() && scopes.back().type == open)
+        {
+          const Scope &scope = scopes.back();
+
+          // the endloop jumps back to its loop header
+          if(operation == OPCODE_ENDLOOP)
+            jumpTargets[i] = scope.startIndex;
+
+          // breaks jump past the end of the scope they belong to
+          for(uint32_t b : scope.breaks)
+            jumpTargets[b] = i + 1;
+
+          scopes.pop_back();
+        }
+        else
+        {
+          RDCERR("Unmatched scope close at instruction %u", i);
+        }
+        break;
+      }
+      case OPCODE_BREAK:
+      case OPCODE_BREAKC:
+      {
+        // belongs to the innermost enclosing loop or switch
+        size_t s = scopes.size();
+        while(s > 0)
+        {
+          s--;
+          if(scopes[s].type != OPCODE_IF)
+          {
+            scopes[s].breaks.push_back(i);
+            break;
+          }
+        }
+        break;
+      }
+      case OPCODE_CONTINUE:
+      case OPCODE_CONTINUEC:
+      {
+        // jumps back to the innermost enclosing loop header
+        size_t s = scopes.size();
+        while(s > 0)
+        {
+          s--;
+          if(scopes[s].type == OPCODE_LOOP)
+          {
+            jumpTargets[i] = scopes[s].startIndex;
+            break;
+          }
+        }
+        break;
+      }
+      default: break;
+    }
+  }
+
+  if(!scopes.empty())
+    RDCERR("%zu unmatched control flow scopes in program", scopes.size());
+}
+
 uint32_t GetLogicalIdentifierForBindingSlot(const DXBCBytecode::Program &program,
                                             OperandType declType, const DXBCDebug::BindingSlot &slot)
 {
@@ -5013,6 +5084,8 @@ ShaderDebugTrace *InterpretDebugger::BeginDebug(const DXBC::DXBCContainer *dxbcC
   if(dxbc->m_Type == DXBC::ShaderType::Compute)
     global.PopulateGroupshared(dxbc->GetDXBCByteCode());
 
+  global.PrecomputeJumpTargets(dxbc->GetDXBCByteCode());
+
   ThreadState &state = activeLane();
 
   int32_t maxReg = -1;
@@ -5465,7 +5538,7 @@ rdcarray<ShaderDebugState> InterpretDebugger::ContinueDebug(DXBCDebug::DebugAPIW
       initial.changes.push_back({ShaderVariable(), v});
     dxbc->FillStateInstructionInfo(initial);
 
-    ret.push_back(initial);
+    ret.push_back(std::move(initial));
 
     steps++;
   }
@@ -5501,7 +5574,7 @@ rdcarray<ShaderDebugState> InterpretDebugger::ContinueDebug(DXBCDebug::DebugAPIW
           state.stepIndex = steps;
           state.nextInstruction = workgroup[i].nextInstruction;
           dxbc->FillStateInstructionInfo(state);
-          ret.push_back(state);
+          ret.push_back(std::move(state));
         }
         else
         {
@@ -74,6 +74,7 @@ struct GlobalState
 public:
   GlobalState() {}
   void PopulateGroupshared(const DXBCBytecode::Program *pBytecode);
+  void PrecomputeJumpTargets(const DXBCBytecode::Program *pBytecode);
 
   struct ViewFmt
   {
@@ -138,6 +139,11 @@ public:
 
   rdcarray<groupsharedMem> groupshared;
 
+  // precomputed targets of control flow instructions, indexed by instruction with ~0U for
+  // instructions that don't jump. Shared by all threads in the workgroup, see
+  // PrecomputeJumpTargets().
+  rdcarray<uint32_t> jumpTargets;
+
   struct SampleEvalCacheKey
   {
     int32_t quadIndex = -1;              // index of this thread in the quad
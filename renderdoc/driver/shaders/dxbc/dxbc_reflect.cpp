@@ -24,7 +24,9 @@
 
 #include "dxbc_reflect.h"
 #include "common/formatting.h"
+#include "common/shader_cache.h"
 #include "core/core.h"
+#include "serialise/serialiser.h"
 #include "dxbc_container.h"
 
 static ShaderConstant MakeConstantBufferVariable(const DXBC::CBufferVariable &var);
@@ -322,3 +324,129 @@ void MakeShaderReflection(DXBC::DXBCContainer *dxbc, ShaderReflection *refl,
     refl->interfaces[dxbc->GetReflection()->Interfaces.variables[i].descriptor.offset] =
         dxbc->GetReflection()->Interfaces.variables[i].name;
 }
+
+/////////////////////////////////////////////////////////////////////////////
+// Persistent reflection cache
+//
+// Keyed on the hash embedded in the DXBC container, storing the serialised ShaderReflection and
+// ShaderBindpointMapping. The map key folds the hash to 32 bits to fit the common cache code, so
+// each entry stores the full hash and it's checked on fetch to reject collisions.
+
+static const uint32_t ReflCacheMagic = MAKE_FOURCC('R', 'E', 'F', 'L');
+
+// bump this version to invalidate the cache whenever the serialised reflection structures change,
+// or when MakeShaderReflection() changes what it fills out.
+static const uint32_t ReflCacheVersion = 1;
+
+struct ReflBlobCallbacks
+{
+  bool Create(uint32_t size, byte *data, bytebuf *ret) const
+  {
+    ret->assign(data, size);
+    return true;
+  }
+  void Destroy(const bytebuf &blob) const {}
+  uint32_t GetSize(const bytebuf &blob) const { return (uint32_t)blob.size(); }
+  const byte *GetData(const bytebuf &blob) const { return blob.data(); }
+} ReflCacheCallbacks;
+
+static Threading::CriticalSection reflCacheLock;
+static std::map<uint32_t, bytebuf> reflCache;
+static bool reflCacheLoaded = false;
+static bool reflCacheDirty = false;
+
+static void SaveReflectionCache()
+{
+  SCOPED_LOCK(reflCacheLock);
+
+  if(reflCacheDirty)
+    SaveShaderCache("dxbcrefl.cache", ReflCacheMagic, ReflCacheVersion, reflCache,
+                    ReflCacheCallbacks);
+
+  reflCache.clear();
+  reflCacheLoaded = false;
+  reflCacheDirty = false;
+}
+
+static void EnsureReflectionCacheLoaded()
+{
+  if(reflCacheLoaded)
+    return;
+
+  reflCacheLoaded = true;
+
+  // if loading fails the file is from another version or corrupt, so overwrite it with whatever
+  // we accumulate this session.
+  reflCacheDirty = !LoadShaderCache("dxbcrefl.cache", ReflCacheMagic, ReflCacheVersion, reflCache,
+                                    ReflCacheCallbacks);
+
+  RenderDoc::Inst().RegisterShutdownFunction(&SaveReflectionCache);
+}
+
+bool TryFetchCachedShaderReflection(const void *bytecode, size_t length, ShaderReflection *refl,
+                                    ShaderBindpointMapping *mapping)
+{
+  uint32_t hash[4] = {};
+  DXBC::DXBCContainer::GetHash(hash, bytecode, length);
+
+  // tools that don't sign their output leave the hash zeroed, which would collide all such
+  // shaders together, so treat them as uncacheable.
+  if(hash[0] == 0 && hash[1] == 0 && hash[2] == 0 && hash[3] == 0)
+    return false;
+
+  SCOPED_LOCK(reflCacheLock);
+
+  EnsureReflectionCacheLoaded();
+
+  auto it = reflCache.find(hash[0] ^ hash[1] ^ hash[2] ^ hash[3]);
+  if(it == reflCache.end())
+    return false;
+
+  ReadSerialiser ser(new StreamReader(it->second.data(), it->second.size()), Ownership::Stream);
+
+  uint32_t storedHash[4] = {};
+  ser.Serialise("hash"_lit, storedHash);
+
+  if(memcmp(hash, storedHash, sizeof(hash)) != 0)
+    return false;
+
+  ser.Serialise("refl"_lit, *refl);
+  ser.Serialise("mapping"_lit, *mapping);
+
+  if(ser.IsErrored())
+  {
+    // don't leave partially-deserialised results behind for the caller to build over
+    *refl = ShaderReflection();
+    *mapping = ShaderBindpointMapping();
+    return false;
+  }
+
+  return true;
+}
+
+void CacheShaderReflection(const void *bytecode, size_t length, ShaderReflection &refl,
+                           ShaderBindpointMapping &mapping)
+{
+  uint32_t hash[4] = {};
+  DXBC::DXBCContainer::GetHash(hash, bytecode, length);
+
+  if(hash[0] == 0 && hash[1] == 0 && hash[2] == 0 && hash[3] == 0)
+    return;
+
+  WriteSerialiser ser(new StreamWriter(4 * 1024), Ownership::Stream);
+
+  ser.Serialise("hash"_lit, hash);
+  ser.Serialise("refl"_lit, refl);
+  ser.Serialise("mapping"_lit, mapping);
+
+  if(ser.IsErrored())
+    return;
+
+  SCOPED_LOCK(reflCacheLock);
+
+  EnsureReflectionCacheLoaded();
+
+  reflCache[hash[0] ^ hash[1] ^ hash[2] ^ hash[3]].assign(ser.GetWriter()->GetData(),
+                                                          (size_t)ser.GetWriter()->GetOffset());
+  reflCacheDirty = true;
+}
@@ -36,3 +36,12 @@ struct ShaderBindpointMapping;
 
 void MakeShaderReflection(DXBC::DXBCContainer *dxbc, ShaderReflection *refl,
                           ShaderBindpointMapping *mapping);
+
+// reflection is a pure function of the shader bytecode and identical shaders recur across
+// captures, so we keep a persistent disk cache of serialised reflection data keyed on the
+// bytecode hash. On a hit the outputs are filled from the cache and the caller can avoid
+// parsing the DXBC container (and in particular any debug info chunks) entirely.
+bool TryFetchCachedShaderReflection(const void *bytecode, size_t length, ShaderReflection *refl,
+                                    ShaderBindpointMapping *mapping);
+void CacheShaderReflection(const void *bytecode, size_t length, ShaderReflection &refl,
+                           ShaderBindpointMapping &mapping);
@@ -549,7 +549,24 @@ Program::Program(const byte *bytes, size_t length)
   const byte *bitcode = ((const byte *)&header->DxilMagic) + header->BitcodeOffset;
   RDCASSERT(bitcode + header->BitcodeSize == ptr + length);
 
-  LLVMBC::BitcodeReader reader(bitcode, header->BitcodeSize);
+  m_Type = DXBC::ShaderType(header->ProgramType);
+  m_Major = (header->ProgramVersion & 0xf0) >> 4;
+  m_Minor = header->ProgramVersion & 0xf;
+
+  // nothing else is needed from the bitstream at load time - hold onto the bytes and only decode
+  // them if disassembly is actually requested. Decoding a large shader library eagerly here is
+  // very noticeable on capture load and is wasted work for every shader that's never inspected.
+  m_Bytecode.append(bitcode, header->BitcodeSize);
+}
+
+void Program::ParseBytecode()
+{
+  if(m_Parsed)
+    return;
+
+  m_Parsed = true;
+
+  LLVMBC::BitcodeReader reader(m_Bytecode.data(), m_Bytecode.size());
 
   LLVMBC::BlockOrRecord root = reader.ReadToplevelBlock();
 
@@ -559,10 +576,6 @@ Program::Program(const byte *bytes, size_t length)
   // we should have consumed all bits, only one top-level block
   RDCASSERT(reader.AtEndOfStream());
 
-  m_Type = DXBC::ShaderType(header->ProgramType);
-  m_Major = (header->ProgramVersion & 0xf0) >> 4;
-  m_Minor = header->ProgramVersion & 0xf;
-
   // Input signature and Output signature haven't changed.
   // Pipeline Runtime Information we have decoded just not implemented here
 
@@ -792,6 +805,8 @@ uint32_t Program::GetDisassemblyLine(uint32_t instruction) const
 
 void Program::MakeDisassemblyString()
 {
+  ParseBytecode();
+
   RDCERR("Unimplemented DXIL::Program::MakeDisassemblyString()");
 
   const char *shaderName[] = {
@@ -53,11 +53,17 @@ public:
   uint32_t GetDisassemblyLine(uint32_t instruction) const;
 
 private:
+  void ParseBytecode();
   void MakeDisassemblyString();
 
   DXBC::ShaderType m_Type;
   uint32_t m_Major, m_Minor;
 
+  // the bitcode bytes, kept so that the stream can be decoded on demand rather than on capture
+  // load - only the container header is needed for reflection purposes at the moment.
+  bytebuf m_Bytecode;
+  bool m_Parsed = false;
+
   rdcstr m_Triple, m_Datalayout;
 
   rdcstr m_Disassembly;
@@ -219,7 +219,7 @@ void ThreadState::WritePointerValue(Id pointer, const ShaderVariable &val)
       // if this is a write to a SSBO pointer, don't record any alias changes, just record a no-op
       // change to this pointer
       basechange.after = basechange.before = debugger.GetPointerValue(ids[pointer]);
-      m_State->changes.push_back(basechange);
+      m_State->changes.push_back(std::move(basechange));
       debugger.WriteThroughPointer(var, val);
       return;
     }
@@ -247,7 +247,7 @@ void ThreadState::WritePointerValue(Id pointer, const ShaderVariable &val)
 
     if(ptrIdx >= 0)
     {
-      m_State->changes.push_back(changes[ptrIdx]);
+      m_State->changes.push_back(std::move(changes[ptrIdx]));
       changes.erase(ptrIdx);
     }
 
@@ -261,7 +261,7 @@ void ThreadState::WritePointerValue(Id pointer, const ShaderVariable &val)
     // always add a change for the base storage variable written itself, even if that's a no-op.
     // This one is not included in any of the pointers lists above
     basechange.after = debugger.GetPointerValue(ids[ptrid]);
-    m_State->changes.push_back(basechange);
+    m_State->changes.push_back(std::move(basechange));
   }
 }
 
@@ -273,16 +273,21 @@ void ThreadState::SetDst(Id id, const ShaderVariable &val)
   ids[id] = val;
   ids[id].name = debugger.GetRawName(id);
 
+  // only insert into the sorted list if the id isn't already there. Ids re-assigned in a loop only
+  // die once, so without this check each iteration would add a duplicate and stepping would get
+  // slower and slower as the live list grows.
   auto it = std::lower_bound(live.begin(), live.end(), id);
-  live.insert(it - live.begin(), id);
+  if(it == live.end() || *it != id)
+    live.insert(it - live.begin(), id);
 
   if(m_State)
   {
     ShaderVariableChange change;
     change.after = debugger.GetPointerValue(ids[id]);
-    m_State->changes.push_back(change);
 
     debugger.AddSourceVars(sourceVars, change.after, id);
+
+    m_State->changes.push_back(std::move(change));
   }
 }
 
@@ -267,7 +267,7 @@ public:
   const DataType &GetType(Id typeId);
   const DataType &GetTypeForId(Id ssaId);
   const Decorations &GetDecorations(Id typeId);
-  rdcstr GetRawName(Id id) const;
+  const rdcstr &GetRawName(Id id) const;
   rdcstr GetHumanName(Id id);
   void AddSourceVars(rdcarray<SourceVariableMapping> &sourceVars, const ShaderVariable &var, Id id);
   void AllocateVariable(Id id, Id typeId, ShaderVariable &outVar);
@@ -332,6 +332,10 @@ private:
   };
 
   DenseIdMap<rdcstr> strings;
+
+  // pre-formatted raw names for every id, so that stepping doesn't format a string for each
+  // assignment on each thread
+  DenseIdMap<rdcstr> rawNames;
   rdcarray<MemberName> memberNames;
   std::map<rdcstr, Id> entryLookup;
 
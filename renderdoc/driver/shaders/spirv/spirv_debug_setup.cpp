@@ -1035,7 +1035,7 @@ rdcarray<ShaderDebugState> Debugger::ContinueDebug()
 
     active.FillCallstack(initial);
 
-    ret.push_back(initial);
+    ret.push_back(std::move(initial));
 
     steps++;
   }
@@ -1085,7 +1085,7 @@ rdcarray<ShaderDebugState> Debugger::ContinueDebug()
               thread.live.erase(l);
               ShaderVariableChange change;
               change.before = GetPointerValue(thread.ids[id]);
-              state.changes.push_back(change);
+              state.changes.push_back(std::move(change));
 
               rdcstr name = GetRawName(id);
 
@@ -1103,7 +1103,7 @@ rdcarray<ShaderDebugState> Debugger::ContinueDebug()
           state.stepIndex = steps;
           state.sourceVars = thread.sourceVars;
           thread.FillCallstack(state);
-          ret.push_back(state);
+          ret.push_back(std::move(state));
         }
         else
         {
@@ -1666,9 +1666,9 @@ void Debugger::WriteThroughPointer(const ShaderVariable &ptr, const ShaderVariab
   }
 }
 
-rdcstr Debugger::GetRawName(Id id) const
+const rdcstr &Debugger::GetRawName(Id id) const
 {
-  return StringFormat::Fmt("_%u", id.value());
+  return rawNames[id];
 }
 
 rdcstr Debugger::GetHumanName(Id id)
@@ -2137,6 +2137,10 @@ void Debugger::PreParse(uint32_t maxId)
   Processor::PreParse(maxId);
 
   strings.resize(idTypes.size());
+
+  rawNames.resize(idTypes.size());
+  for(size_t i = 0; i < rawNames.size(); i++)
+    rawNames[Id::fromWord(uint32_t(i))] = StringFormat::Fmt("_%u", uint32_t(i));
 }
 
 void Debugger::PostParse()
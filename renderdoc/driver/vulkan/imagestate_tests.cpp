@@ -730,6 +730,34 @@ TEST_CASE("Test ImageState type", "[imagestate]")
       CheckSubresourceState(it->state(), readSubstate);
     }
   };
+
+  SECTION("Merge recoalesces uniform states")
+  {
+    ImageState state(image, imageInfo, eFrameRef_None);
+
+    // read part of the image, fragmenting the map into per-level/layer/slice entries
+    ImageSubresourceRange range0 = imageInfo.FullRange();
+    range0.baseMipLevel = 1;
+    range0.levelCount = imageInfo.levelCount - 1;
+    range0.baseArrayLayer = 1;
+    range0.layerCount = imageInfo.layerCount - 1;
+    range0.baseDepthSlice = 1;
+    range0.sliceCount = imageInfo.extent.depth - 1;
+    state.RecordUse(range0, eFrameRef_Read, 0);
+
+    CheckSubresourceRanges(state, false, true, true, true);
+
+    // merge in a command buffer's state that read the whole image, making every subresource
+    // uniform again. The merge itself should coalesce back to a single entry, without an explicit
+    // Unsplit(), so subsequent merges don't iterate per-subresource.
+    ImageState cmdState(image, imageInfo, eFrameRef_None);
+    cmdState.RecordUse(imageInfo.FullRange(), eFrameRef_Read, 0);
+
+    state.Merge(cmdState, transitionInfo);
+
+    CheckSubresourceRanges(state, false, false, false, false);
+    CheckSubresourceState(state.subresourceStates.begin()->state(), readSubstate);
+  };
 };
 
 #endif    // ENABLED(ENABLE_UNIT_TESTS)
@@ -533,6 +533,17 @@ void VulkanReplay::ClearFeedbackCache()
   m_BindlessFeedback.Usage.clear();
 }
 
+void VulkanReplay::InvalidateFeedbackForPipelines(const rdcarray<ResourceId> &pipes)
+{
+  for(auto it = m_BindlessFeedback.Usage.begin(); it != m_BindlessFeedback.Usage.end();)
+  {
+    if(pipes.contains(it->second.pipe))
+      it = m_BindlessFeedback.Usage.erase(it);
+    else
+      ++it;
+  }
+}
+
 void VulkanReplay::FetchShaderFeedback(uint32_t eventId)
 {
   if(m_BindlessFeedback.Usage.find(eventId) != m_BindlessFeedback.Usage.end())
@@ -566,6 +577,10 @@ void VulkanReplay::FetchShaderFeedback(uint32_t eventId)
   if(pipe.pipeline == ResourceId())
     return;
 
+  // tag the entry with the pipeline it's fetched with, so a shader edit only invalidates the
+  // entries for affected pipelines
+  result.pipe = pipe.pipeline;
+
   const VulkanCreationInfo::Pipeline &pipeInfo = creationInfo.m_Pipeline[pipe.pipeline];
 
   VkDeviceSize feedbackStorageSize = 0;
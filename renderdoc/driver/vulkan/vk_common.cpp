@@ -321,6 +321,21 @@ bool VkInitParams::IsSupportedVersion(uint64_t ver)
   if(ver == CurrentVersion)
     return true;
 
+  // 0x13 -> 0x14 - tiny high-frequency commands are recorded as compact chunks, with no per-chunk
+  // metadata or trailing alignment padding
+  if(ver == 0x13)
+    return true;
+
+  // 0x12 -> 0x13 - strings in the frame capture section may be stored as references into a
+  // separate string table section
+  if(ver == 0x12)
+    return true;
+
+  // 0x11 -> 0x12 - descriptor set initial contents only serialise the written prefix of each
+  // binding's array instead of every slot
+  if(ver == 0x11)
+    return true;
+
   // 0x10 -> 0x11 - non-breaking changes to image state serialization
   if(ver == 0x10)
     return true;
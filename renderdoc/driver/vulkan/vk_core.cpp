@@ -25,6 +25,7 @@
 #include "vk_core.h"
 #include <ctype.h>
 #include <algorithm>
+#include "common/threading.h"
 #include "driver/ihv/amd/amd_rgp.h"
 #include "driver/shaders/spirv/spirv_compile.h"
 #include "jpeg-compressor/jpge.h"
@@ -190,6 +191,11 @@ WrappedVulkan::~WrappedVulkan()
   for(size_t i = 0; i < m_ThreadSerialisers.size(); i++)
     delete m_ThreadSerialisers[i];
 
+  // all chunks have been freed above along with the records that owned them, so the allocators
+  // backing their data can now be destroyed
+  for(size_t i = 0; i < m_ThreadChunkAllocators.size(); i++)
+    delete m_ThreadChunkAllocators[i];
+
   for(size_t i = 0; i < m_ThreadTempMem.size(); i++)
   {
     delete[] m_ThreadTempMem[i]->memory;
@@ -247,7 +253,8 @@ void WrappedVulkan::AddPendingCommandBuffer(VkCommandBuffer cmd)
 }
 
 void WrappedVulkan::SubmitCmds(VkSemaphore *unwrappedWaitSemaphores,
-                               VkPipelineStageFlags *waitStageMask, uint32_t waitSemaphoreCount)
+                               VkPipelineStageFlags *waitStageMask, uint32_t waitSemaphoreCount,
+                               VkFence unwrappedFence)
 {
   // nothing to do
   if(m_InternalCmds.pendingcmds.empty())
@@ -257,6 +264,28 @@ void WrappedVulkan::SubmitCmds(VkSemaphore *unwrappedWaitSemaphores,
   for(size_t i = 0; i < cmds.size(); i++)
     cmds[i] = Unwrap(cmds[i]);
 
+  SubmittedCmdBatch batch;
+
+  // if the caller didn't pass a fence, attach an internal one so the batch can be recycled by
+  // TrimQ() as soon as it completes, rather than waiting for a full FlushQ().
+  if(unwrappedFence == VK_NULL_HANDLE && m_Queue != VK_NULL_HANDLE)
+  {
+    if(!m_InternalCmds.freefences.empty())
+    {
+      batch.fence = m_InternalCmds.freefences.back();
+      m_InternalCmds.freefences.pop_back();
+    }
+    else
+    {
+      VkFenceCreateInfo fenceInfo = {VK_STRUCTURE_TYPE_FENCE_CREATE_INFO};
+      VkResult vkr =
+          ObjDisp(m_Device)->CreateFence(Unwrap(m_Device), &fenceInfo, NULL, &batch.fence);
+      RDCASSERTEQUAL(vkr, VK_SUCCESS);
+    }
+
+    unwrappedFence = batch.fence;
+  }
+
   VkSubmitInfo submitInfo = {
       VK_STRUCTURE_TYPE_SUBMIT_INFO,
       m_SubmitChain,
@@ -274,7 +303,7 @@ void WrappedVulkan::SubmitCmds(VkSemaphore *unwrappedWaitSemaphores,
   // skip the submit
   if(m_Queue != VK_NULL_HANDLE)
   {
-    VkResult vkr = ObjDisp(m_Queue)->QueueSubmit(Unwrap(m_Queue), 1, &submitInfo, VK_NULL_HANDLE);
+    VkResult vkr = ObjDisp(m_Queue)->QueueSubmit(Unwrap(m_Queue), 1, &submitInfo, unwrappedFence);
     RDCASSERTEQUAL(vkr, VK_SUCCESS);
   }
 
@@ -282,8 +311,17 @@ void WrappedVulkan::SubmitCmds(VkSemaphore *unwrappedWaitSemaphores,
   FlushQ();
 #endif
 
-  m_InternalCmds.submittedcmds.append(m_InternalCmds.pendingcmds);
+  batch.cmds = m_InternalCmds.pendingcmds;
   m_InternalCmds.pendingcmds.clear();
+
+  // any staging objects queued for cleanup were last used by this batch or an earlier one on the
+  // same queue, so tie their destruction to this batch's completion.
+  batch.uploadCleanups.swap(m_PendingUploadCleanups);
+  batch.transientArrayCleanups.swap(m_PendingTransientArrayCleanups);
+  batch.prepareBufferCleanups.swap(m_PendingPrepareBufferCleanups);
+  batch.prepareImageCleanups.swap(m_PendingPrepareImageCleanups);
+
+  m_InternalCmds.submittedcmds.push_back(batch);
 }
 
 VkSemaphore WrappedVulkan::GetNextSemaphore()
@@ -329,7 +367,9 @@ void WrappedVulkan::FlushQ()
   // commands until N presents later, or something, or checking on fences.
   // If we do so, then check each use for FlushQ to see if it needs a
   // CPU-GPU sync or whether it is just looking to recycle command buffers
-  // (Particularly the one in vkQueuePresentKHR drawing the overlay)
+  // (Particularly the one in vkQueuePresentKHR drawing the overlay).
+  // Callers that only need to bound outstanding internal work can already
+  // use TrimQ() instead, which waits on per-batch fences.
 
   // see comment in SubmitQ()
   if(m_Queue != VK_NULL_HANDLE)
@@ -349,7 +389,8 @@ void WrappedVulkan::FlushQ()
 
   if(!m_InternalCmds.submittedcmds.empty())
   {
-    m_InternalCmds.freecmds.append(m_InternalCmds.submittedcmds);
+    for(SubmittedCmdBatch &batch : m_InternalCmds.submittedcmds)
+      RecycleCmdBatch(batch);
     m_InternalCmds.submittedcmds.clear();
   }
 
@@ -358,6 +399,133 @@ void WrappedVulkan::FlushQ()
     m_InternalCmds.freesems.append(m_InternalCmds.submittedsems);
     m_InternalCmds.submittedsems.clear();
   }
+
+  // now that the queue has idled, any staging buffers whose uploads were submitted without an
+  // accompanying wait are safe to destroy.
+  if(!m_PendingUploadCleanups.empty())
+  {
+    for(size_t i = 0; i < m_PendingUploadCleanups.size(); i++)
+    {
+      vkDestroyBuffer(m_Device, m_PendingUploadCleanups[i].first, NULL);
+      FreeMemoryAllocation(m_PendingUploadCleanups[i].second);
+    }
+
+    m_PendingUploadCleanups.clear();
+  }
+
+  // likewise any array images recreated transiently for over-budget MSAA initial contents.
+  if(!m_PendingTransientArrayCleanups.empty())
+  {
+    for(size_t i = 0; i < m_PendingTransientArrayCleanups.size(); i++)
+    {
+      vkDestroyImage(m_Device, m_PendingTransientArrayCleanups[i].first, NULL);
+      FreeMemoryAllocation(m_PendingTransientArrayCleanups[i].second);
+    }
+
+    m_PendingTransientArrayCleanups.clear();
+  }
+
+  // same for the temporary readback objects from initial state prepares at capture start. These
+  // were created unwrapped and manually wrapped, so they're destroyed the same way.
+  if(!m_PendingPrepareBufferCleanups.empty() || !m_PendingPrepareImageCleanups.empty())
+  {
+    for(VkBuffer buf : m_PendingPrepareBufferCleanups)
+    {
+      ObjDisp(m_Device)->DestroyBuffer(Unwrap(m_Device), Unwrap(buf), NULL);
+      GetResourceManager()->ReleaseWrappedResource(buf);
+    }
+
+    for(VkImage img : m_PendingPrepareImageCleanups)
+    {
+      ObjDisp(m_Device)->DestroyImage(Unwrap(m_Device), Unwrap(img), NULL);
+      GetResourceManager()->ReleaseWrappedResource(img);
+    }
+
+    m_PendingPrepareBufferCleanups.clear();
+    m_PendingPrepareImageCleanups.clear();
+  }
+}
+
+void WrappedVulkan::RecycleCmdBatch(SubmittedCmdBatch &batch)
+{
+  // the GPU is known to be finished with everything in this batch, either because its fence
+  // signalled or because the whole queue idled.
+  if(batch.fence != VK_NULL_HANDLE)
+  {
+    ObjDisp(m_Device)->ResetFences(Unwrap(m_Device), 1, &batch.fence);
+    m_InternalCmds.freefences.push_back(batch.fence);
+    batch.fence = VK_NULL_HANDLE;
+  }
+
+  m_InternalCmds.freecmds.append(batch.cmds);
+  batch.cmds.clear();
+
+  for(size_t i = 0; i < batch.uploadCleanups.size(); i++)
+  {
+    vkDestroyBuffer(m_Device, batch.uploadCleanups[i].first, NULL);
+    FreeMemoryAllocation(batch.uploadCleanups[i].second);
+  }
+  batch.uploadCleanups.clear();
+
+  for(size_t i = 0; i < batch.transientArrayCleanups.size(); i++)
+  {
+    vkDestroyImage(m_Device, batch.transientArrayCleanups[i].first, NULL);
+    FreeMemoryAllocation(batch.transientArrayCleanups[i].second);
+  }
+  batch.transientArrayCleanups.clear();
+
+  // the prepare objects were created unwrapped and manually wrapped, so they're destroyed the
+  // same way.
+  for(VkBuffer buf : batch.prepareBufferCleanups)
+  {
+    ObjDisp(m_Device)->DestroyBuffer(Unwrap(m_Device), Unwrap(buf), NULL);
+    GetResourceManager()->ReleaseWrappedResource(buf);
+  }
+  batch.prepareBufferCleanups.clear();
+
+  for(VkImage img : batch.prepareImageCleanups)
+  {
+    ObjDisp(m_Device)->DestroyImage(Unwrap(m_Device), Unwrap(img), NULL);
+    GetResourceManager()->ReleaseWrappedResource(img);
+  }
+  batch.prepareImageCleanups.clear();
+}
+
+void WrappedVulkan::TrimQ(size_t maxInFlight)
+{
+  // opportunistically recycle any leading batches that have already completed - when we're called
+  // from a submission loop the oldest batches have usually long since finished.
+  while(!m_InternalCmds.submittedcmds.empty())
+  {
+    SubmittedCmdBatch &batch = m_InternalCmds.submittedcmds.front();
+
+    if(batch.fence == VK_NULL_HANDLE ||
+       ObjDisp(m_Device)->GetFenceStatus(Unwrap(m_Device), batch.fence) != VK_SUCCESS)
+      break;
+
+    RecycleCmdBatch(batch);
+    m_InternalCmds.submittedcmds.erase(0);
+  }
+
+  // if more batches than that are still outstanding, wait on the oldest fences until we're back
+  // under budget. This bounds the command buffers and staging memory held by in-flight batches
+  // while still letting CPU recording overlap GPU execution, where FlushQ() serialises the two
+  // completely.
+  while(m_InternalCmds.submittedcmds.size() > maxInFlight)
+  {
+    SubmittedCmdBatch &batch = m_InternalCmds.submittedcmds.front();
+
+    // batches submitted with an external fence can only be recycled by a full FlushQ()
+    if(batch.fence == VK_NULL_HANDLE)
+      break;
+
+    VkResult vkr =
+        ObjDisp(m_Device)->WaitForFences(Unwrap(m_Device), 1, &batch.fence, VK_TRUE, UINT64_MAX);
+    RDCASSERTEQUAL(vkr, VK_SUCCESS);
+
+    RecycleCmdBatch(batch);
+    m_InternalCmds.submittedcmds.erase(0);
+  }
 }
 
 VkCommandBuffer WrappedVulkan::GetExtQueueCmd(uint32_t queueFamilyIdx) const
@@ -627,6 +795,38 @@ byte *WrappedVulkan::GetTempMemory(size_t s)
   return newmem->memory;
 }
 
+// high-frequency tiny state-setting and bind commands - in typical applications these are the
+// overwhelming majority of recorded commands, so they're written as compact chunks with no
+// per-chunk metadata or alignment padding. Draws and dispatches deliberately keep the full form,
+// their timing metadata is worth the few extra bytes.
+static bool IsCompactCommandChunk(uint32_t chunkType)
+{
+  switch((VulkanChunk)chunkType)
+  {
+    case VulkanChunk::vkCmdBindPipeline:
+    case VulkanChunk::vkCmdSetViewport:
+    case VulkanChunk::vkCmdSetScissor:
+    case VulkanChunk::vkCmdSetLineWidth:
+    case VulkanChunk::vkCmdSetDepthBias:
+    case VulkanChunk::vkCmdSetBlendConstants:
+    case VulkanChunk::vkCmdSetDepthBounds:
+    case VulkanChunk::vkCmdSetStencilCompareMask:
+    case VulkanChunk::vkCmdSetStencilWriteMask:
+    case VulkanChunk::vkCmdSetStencilReference:
+    case VulkanChunk::vkCmdBindDescriptorSets:
+    case VulkanChunk::vkCmdBindVertexBuffers:
+    case VulkanChunk::vkCmdBindIndexBuffer:
+    case VulkanChunk::vkCmdPushConstants:
+    case VulkanChunk::vkCmdSetDeviceMask:
+    case VulkanChunk::vkCmdSetSampleLocationsEXT:
+    case VulkanChunk::vkCmdSetDiscardRectangleEXT:
+    case VulkanChunk::vkCmdSetLineStippleEXT: return true;
+    default: break;
+  }
+
+  return false;
+}
+
 WriteSerialiser &WrappedVulkan::GetThreadSerialiser()
 {
   WriteSerialiser *ser = (WriteSerialiser *)Threading::GetTLSValue(threadSerialiserTLSSlot);
@@ -636,8 +836,11 @@ WriteSerialiser &WrappedVulkan::GetThreadSerialiser()
   // slow path, but rare
   ser = new WriteSerialiser(new StreamWriter(1024), Ownership::Stream);
 
-  uint32_t flags = WriteSerialiser::ChunkDuration | WriteSerialiser::ChunkTimestamp |
-                   WriteSerialiser::ChunkThreadID;
+  uint32_t flags = 0;
+
+  if(!RenderDoc::Inst().GetCaptureOptions().stripChunkMetadata)
+    flags = WriteSerialiser::ChunkDuration | WriteSerialiser::ChunkTimestamp |
+            WriteSerialiser::ChunkThreadID;
 
   if(RenderDoc::Inst().GetCaptureOptions().captureCallstacks)
     flags |= WriteSerialiser::ChunkCallstack;
@@ -646,11 +849,26 @@ WriteSerialiser &WrappedVulkan::GetThreadSerialiser()
   ser->SetUserData(GetResourceManager());
   ser->SetVersion(VkInitParams::CurrentVersion);
 
+  // capture-side recording serialisers share the process-wide string table, so strings repeated
+  // across chunks are stored by id and written once in their own section of the capture
+  if(!RenderDoc::Inst().IsReplayApp())
+  {
+    ser->ConfigureStringTable(&m_StringTable);
+    ser->SetCompactChunkFilter(&IsCompactCommandChunk);
+  }
+
+  // each thread serialiser gets its own chunk allocator, so allocating chunk data on the capture
+  // hot path never contends with other recording threads. Chunks remember their allocator, so
+  // frees (which can happen on any thread) still go to the right place.
+  ChunkAllocator *alloc = new ChunkAllocator;
+  ser->SetChunkAllocator(alloc);
+
   Threading::SetTLSValue(threadSerialiserTLSSlot, (void *)ser);
 
   {
     SCOPED_LOCK(m_ThreadSerialisersLock);
     m_ThreadSerialisers.push_back(ser);
+    m_ThreadChunkAllocators.push_back(alloc);
   }
 
   return *ser;
@@ -1627,6 +1845,8 @@ bool WrappedVulkan::EndFrameCapture(void *dev, void *wnd)
   if(!IsActiveCapturing(m_State))
     return true;
 
+  PROFILE_ZONE("WrappedVulkan::EndFrameCapture");
+
   VkSwapchainKHR swap = VK_NULL_HANDLE;
 
   if(wnd)
@@ -1927,13 +2147,22 @@ bool WrappedVulkan::EndFrameCapture(void *dev, void *wnd)
     captureWriter = new StreamWriter(StreamWriter::InvalidStream);
   }
 
+  rdcarray<WriteSerialiser::ChunkIndexEntry> chunkIndex;
+
   {
     WriteSerialiser ser(captureWriter, Ownership::Stream);
 
     ser.SetChunkMetadataRecording(GetThreadSerialiser().GetChunkMetadataRecording());
 
+    // record where each chunk lands in the uncompressed stream, to write an index section below
+    ser.SetChunkIndexing(true);
+
     ser.SetUserData(GetResourceManager());
 
+    // deliberately no string table on this serialiser - the DriverInit chunk must stay readable
+    // on its own before any other section is loaded (see Vulkan_CreateReplayDevice). Chunks baked
+    // by the recording serialisers already contain their table references.
+
     {
       SCOPED_SERIALISE_CHUNK(SystemChunk::DriverInit, m_InitParams.GetSerialiseSize());
 
@@ -2004,6 +2233,54 @@ bool WrappedVulkan::EndFrameCapture(void *dev, void *wnd)
 
       RDCDEBUG("Done");
     }
+
+    chunkIndex.swap(ser.GetChunkIndex());
+  }
+
+  // write the chunk index out as its own uncompressed section, so readers can seek directly to a
+  // chunk in the frame capture stream without walking it from the start.
+  if(rdc && !chunkIndex.empty())
+  {
+    SectionProperties props;
+
+    props.flags = SectionFlags::NoFlags;
+    props.version = m_SectionVersion;
+    props.type = SectionType::FrameCaptureIndex;
+
+    StreamWriter *indexWriter = rdc->WriteSection(props);
+
+    uint64_t count = chunkIndex.size();
+    indexWriter->Write(count);
+
+    for(const WriteSerialiser::ChunkIndexEntry &entry : chunkIndex)
+    {
+      indexWriter->Write(entry.chunkID);
+      indexWriter->Write(entry.offset);
+    }
+
+    indexWriter->Finish();
+
+    delete indexWriter;
+  }
+
+  // write the string table referenced by recorded chunks as its own section. The full table is
+  // written every capture - it accumulates for the process lifetime, so that ids baked into
+  // record chunks during background capture stay valid from one capture to the next.
+  if(rdc && !m_StringTable.IsEmpty())
+  {
+    SectionProperties props;
+
+    props.flags = SectionFlags::LZ4Compressed;
+    props.version = m_SectionVersion;
+    props.type = SectionType::StringTable;
+
+    StreamWriter *tableWriter = rdc->WriteSection(props);
+
+    m_StringTable.Write(tableWriter);
+
+    tableWriter->Finish();
+
+    delete tableWriter;
   }
 
   RDCLOG("Captured Vulkan frame with %f MB capture section in %f seconds",
@@ -2148,8 +2425,164 @@ void WrappedVulkan::AddResourceCurChunk(ResourceId id)
   AddResourceCurChunk(GetReplay()->GetResourceDesc(id));
 }
 
+// accumulates the statistics that can be read directly off a single chunk without any replay
+// state. Bind-state dependent statistics (descriptor contents, redundancy detection etc) would
+// need the stateful replay and aren't gathered.
+static void GatherChunkStatistics(const SDChunk *chunk, FrameStatistics &stats)
+{
+  auto childUInt = [chunk](const char *name) -> uint64_t {
+    const SDObject *obj = chunk->FindChild(name);
+    return obj ? obj->AsUInt64() : 0;
+  };
+
+  switch((VulkanChunk)chunk->metadata.chunkID)
+  {
+    case VulkanChunk::vkCmdDraw:
+    case VulkanChunk::vkCmdDrawIndexed:
+    {
+      uint32_t instanceCount = (uint32_t)childUInt("instanceCount");
+
+      stats.draws.calls++;
+      if(instanceCount > 1)
+        stats.draws.instanced++;
+      stats.draws.counts[BucketForRecord<DrawcallStats>::Get(instanceCount)]++;
+      break;
+    }
+    case VulkanChunk::vkCmdDrawIndirect:
+    case VulkanChunk::vkCmdDrawIndexedIndirect:
+    case VulkanChunk::vkCmdDrawIndirectCount:
+    case VulkanChunk::vkCmdDrawIndexedIndirectCount:
+    case VulkanChunk::vkCmdDrawIndirectByteCountEXT:
+      stats.draws.calls++;
+      stats.draws.indirect++;
+      break;
+    case VulkanChunk::vkCmdDispatch:
+    case VulkanChunk::vkCmdDispatchBase: stats.dispatches.calls++; break;
+    case VulkanChunk::vkCmdDispatchIndirect:
+      stats.dispatches.calls++;
+      stats.dispatches.indirect++;
+      break;
+    case VulkanChunk::vkCmdUpdateBuffer:
+    case VulkanChunk::vkCmdFillBuffer:
+      stats.updates.calls++;
+      stats.updates.servers++;
+      stats.updates.sizes[BucketForRecord<ResourceUpdateStats>::Get(childUInt("dataSize"))]++;
+      break;
+    case VulkanChunk::vkUnmapMemory:
+    case VulkanChunk::vkFlushMappedMemoryRanges:
+      stats.updates.calls++;
+      stats.updates.clients++;
+      break;
+    case VulkanChunk::vkCmdBindIndexBuffer:
+      stats.indices.calls++;
+      stats.indices.sets++;
+      break;
+    case VulkanChunk::vkCmdBindVertexBuffers:
+    {
+      uint32_t bindingCount = (uint32_t)childUInt("bindingCount");
+
+      stats.vertices.calls++;
+      stats.vertices.sets += bindingCount;
+      stats.vertices.bindslots[RDCMIN((size_t)bindingCount, stats.vertices.bindslots.size() - 1)]++;
+      break;
+    }
+    case VulkanChunk::vkCmdSetViewport:
+    {
+      uint32_t viewportCount = (uint32_t)childUInt("viewportCount");
+
+      stats.rasters.calls++;
+      stats.rasters.sets++;
+      stats.rasters.viewports[RDCMIN((size_t)viewportCount, stats.rasters.viewports.size() - 1)]++;
+      break;
+    }
+    case VulkanChunk::vkCmdSetScissor:
+    {
+      uint32_t scissorCount = (uint32_t)childUInt("scissorCount");
+
+      stats.rasters.calls++;
+      stats.rasters.sets++;
+      stats.rasters.rects[RDCMIN((size_t)scissorCount, stats.rasters.rects.size() - 1)]++;
+      break;
+    }
+    default: break;
+  }
+}
+
+void WrappedVulkan::GatherFrameStatistics()
+{
+  FrameStatistics &stats = GetReplay()->WriteFrameRecord().frameInfo.stats;
+
+  // the stats were erased to empty in Serialise_CaptureScope, so this only zeroes the counters
+  RDCEraseEl(stats);
+  stats.recorded = true;
+
+  stats.draws.counts.resize(DrawcallStats::BucketCount);
+  stats.updates.types.resize(uint32_t(TextureType::Count));
+  stats.updates.sizes.resize(ResourceUpdateStats::BucketCount);
+  // sized for the highest vertex binding / viewport counts we expect to see, with the last slot
+  // catching anything above that
+  stats.vertices.bindslots.resize(32 + 1);
+  stats.rasters.viewports.resize(16 + 1);
+  stats.rasters.rects.resize(16 + 1);
+
+  const rdcarray<SDChunk *> &chunks = m_StoredStructuredData.chunks;
+
+  // reduce over ranges of chunks in parallel, with each range accumulating into its own private
+  // copy of the statistics, then merge the copies serially. On captures with millions of calls a
+  // serial pass over every chunk is long enough to notice during load.
+  size_t numRanges = RDCMIN(Threading::JobWorkerCount() + 1, chunks.size() / 1024 + 1);
+
+  rdcarray<FrameStatistics> partials;
+  partials.resize(numRanges);
+  for(FrameStatistics &partial : partials)
+    partial = stats;
+
+  Threading::ParallelFor(numRanges, [&chunks, &partials, numRanges](size_t range) {
+    size_t start = (chunks.size() * range) / numRanges;
+    size_t end = (chunks.size() * (range + 1)) / numRanges;
+
+    for(size_t i = start; i < end; i++)
+      GatherChunkStatistics(chunks[i], partials[range]);
+  });
+
+  auto mergeCounts = [](rdcarray<uint32_t> &dst, const rdcarray<uint32_t> &src) {
+    for(size_t i = 0; i < dst.size(); i++)
+      dst[i] += src[i];
+  };
+
+  for(const FrameStatistics &partial : partials)
+  {
+    stats.draws.calls += partial.draws.calls;
+    stats.draws.instanced += partial.draws.instanced;
+    stats.draws.indirect += partial.draws.indirect;
+    mergeCounts(stats.draws.counts, partial.draws.counts);
+
+    stats.dispatches.calls += partial.dispatches.calls;
+    stats.dispatches.indirect += partial.dispatches.indirect;
+
+    stats.updates.calls += partial.updates.calls;
+    stats.updates.clients += partial.updates.clients;
+    stats.updates.servers += partial.updates.servers;
+    mergeCounts(stats.updates.sizes, partial.updates.sizes);
+
+    stats.indices.calls += partial.indices.calls;
+    stats.indices.sets += partial.indices.sets;
+
+    stats.vertices.calls += partial.vertices.calls;
+    stats.vertices.sets += partial.vertices.sets;
+    mergeCounts(stats.vertices.bindslots, partial.vertices.bindslots);
+
+    stats.rasters.calls += partial.rasters.calls;
+    stats.rasters.sets += partial.rasters.sets;
+    mergeCounts(stats.rasters.viewports, partial.rasters.viewports);
+    mergeCounts(stats.rasters.rects, partial.rasters.rects);
+  }
+}
+
 ReplayStatus WrappedVulkan::ReadLogInitialisation(RDCFile *rdc, bool storeStructuredBuffers)
 {
+  PROFILE_ZONE("WrappedVulkan::ReadLogInitialisation");
+
   int sectionIdx = rdc->SectionIndex(SectionType::FrameCapture);
 
   GetResourceManager()->SetState(m_State);
@@ -2165,9 +2598,19 @@ ReplayStatus WrappedVulkan::ReadLogInitialisation(RDCFile *rdc, bool storeStruct
     return ReplayStatus::FileIOFailed;
   }
 
+  // load the string table section if present, so chunks can resolve strings stored by id
+  int stringTableIdx = rdc->SectionIndex(SectionType::StringTable);
+  if(stringTableIdx >= 0)
+  {
+    StreamReader *tableReader = rdc->ReadSection(stringTableIdx);
+    m_StringTable.Read(tableReader);
+    delete tableReader;
+  }
+
   ReadSerialiser ser(reader, Ownership::Stream);
 
   ser.SetStringDatabase(&m_StringDB);
+  ser.ConfigureStringTable(&m_StringTable);
   ser.SetUserData(GetResourceManager());
 
   ser.ConfigureStructuredExport(&GetChunkName, storeStructuredBuffers);
@@ -2287,6 +2730,9 @@ ReplayStatus WrappedVulkan::ReadLogInitialisation(RDCFile *rdc, bool storeStruct
 
   SAFE_DELETE(sink);
 
+  // any shader modules not consumed by pipeline creation may still be parsing
+  m_ShaderParseJobs.Wait();
+
 #if ENABLED(RDOC_DEVEL)
   for(auto it = chunkInfos.begin(); it != chunkInfos.end(); ++it)
   {
@@ -2307,6 +2753,8 @@ ReplayStatus WrappedVulkan::ReadLogInitialisation(RDCFile *rdc, bool storeStruct
   // and in future use this file.
   m_StructuredFile = &m_StoredStructuredData;
 
+  GatherFrameStatistics();
+
   GetReplay()->WriteFrameRecord().frameInfo.uncompressedFileSize =
       rdc->GetSectionProperties(sectionIdx).uncompressedSize;
   GetReplay()->WriteFrameRecord().frameInfo.compressedFileSize =
@@ -2349,6 +2797,7 @@ ReplayStatus WrappedVulkan::ContextReplayLog(CaptureState readType, uint32_t sta
   ReadSerialiser ser(m_FrameReader, Ownership::Nothing);
 
   ser.SetStringDatabase(&m_StringDB);
+  ser.ConfigureStringTable(&m_StringTable);
   ser.SetUserData(GetResourceManager());
   ser.SetVersion(m_SectionVersion);
 
@@ -2461,6 +2910,22 @@ ReplayStatus WrappedVulkan::ContextReplayLog(CaptureState readType, uint32_t sta
     if(!success)
       return m_FailedReplayStatus;
 
+    if(IsLoading(m_State))
+    {
+      // record where each baked command buffer's serialised commands end, so that during active
+      // replay we can jump over all of them when re-using a cached re-recording.
+      if(chunktype == VulkanChunk::vkEndCommandBuffer && m_LastCmdBufferID != ResourceId())
+        m_BakedCmdBufferInfo[m_LastCmdBufferID].postEndChunkOffset = ser.GetReader()->GetOffset();
+    }
+    else if(m_RerecordSkipOffset > 0)
+    {
+      // the vkBeginCommandBuffer chunk re-used a cached re-recording of its command buffer, so
+      // there's nothing to do for any of its commands - skip the reader past the whole range,
+      // including the vkEndCommandBuffer chunk.
+      ser.GetReader()->SetOffset(m_RerecordSkipOffset);
+      m_RerecordSkipOffset = 0;
+    }
+
     RenderDoc::Inst().SetProgress(
         LoadProgress::FrameEventsRead,
         float(m_CurChunkOffset - startOffset) / float(ser.GetReader()->GetSize()));
@@ -2554,9 +3019,22 @@ ReplayStatus WrappedVulkan::ContextReplayLog(CaptureState readType, uint32_t sta
   m_RerecordCmds.clear();
   m_RerecordCmdList.clear();
 
+  // these should only persist within a replay - if a cacheable command buffer's recording never
+  // completed we mustn't mistake a future replay's recording for it.
+  m_RerecordCachePending = ResourceId();
+  m_RerecordSkipOffset = 0;
+
   return ReplayStatus::Succeeded;
 }
 
+void WrappedVulkan::FreeRerecordCache()
+{
+  for(auto it = m_RerecordCachedCmds.begin(); it != m_RerecordCachedCmds.end(); ++it)
+    vkFreeCommandBuffers(GetDev(), it->second.first, 1, &it->second.second);
+
+  m_RerecordCachedCmds.clear();
+}
+
 void WrappedVulkan::ApplyInitialContents()
 {
   VkMarkerRegion region("ApplyInitialContents");
@@ -3041,6 +3519,12 @@ bool WrappedVulkan::ProcessChunk(ReadSerialiser &ser, VulkanChunk chunk)
     {
       return Serialise_InitialState(ser, ResourceId(), NULL, NULL);
     }
+    else if(system == SystemChunk::InitialContentsReference)
+    {
+      GetResourceManager()->CreateInitialContentsReference(ser);
+
+      SERIALISE_CHECK_READ_ERRORS();
+    }
     else if(system == SystemChunk::CaptureScope)
     {
       return Serialise_CaptureScope(ser);
@@ -3118,6 +3602,8 @@ void WrappedVulkan::AddFrameTerminator(uint64_t queueMarkerTag)
 
 void WrappedVulkan::ReplayLog(uint32_t startEventID, uint32_t endEventID, ReplayLogType replayType)
 {
+  PROFILE_ZONE("WrappedVulkan::ReplayLog");
+
   bool partial = true;
 
   if(startEventID == 0 && (replayType == eReplay_WithoutDraw || replayType == eReplay_Full))
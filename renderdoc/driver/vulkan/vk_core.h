@@ -53,7 +53,7 @@ struct VkInitParams
   uint64_t GetSerialiseSize();
 
   // check if a frame capture section version is supported
-  static const uint64_t CurrentVersion = 0x11;
+  static const uint64_t CurrentVersion = 0x14;
   static bool IsSupportedVersion(uint64_t ver);
 };
 
@@ -109,6 +109,9 @@ struct VkIndirectPatchData
 {
   VkIndirectPatchType type = VkIndirectPatchType::NoPatch;
   MemoryAllocation alloc;
+  // size of the readback buffer. The allocation may be larger due to alignment requirements, and
+  // the count (if present) sits relative to the end of the buffer, not the allocation.
+  VkDeviceSize size = 0;
   VkBuffer buf;
   uint32_t count;
   uint32_t stride;
@@ -178,7 +181,9 @@ struct VulkanDrawcallTreeNode
     ret.resize(children.size());
     for(size_t i = 0; i < children.size(); i++)
     {
-      ret[i] = children[i].draw;
+      // the tree is thrown away after baking, so move the draws out rather than deep-copying
+      // every name and child array
+      ret[i] = std::move(children[i].draw);
       ret[i].children = children[i].Bake();
     }
 
@@ -186,6 +191,15 @@ struct VulkanDrawcallTreeNode
   }
 };
 
+// Note on idle overhead: the bookkeeping below runs even when no capture is queued, and can't be
+// swapped for a plain pass-through dispatch in that state. Command buffers recorded before a
+// capture begins can legally be submitted during the captured frame, so their commands must
+// already have been serialised into the command buffer's record at record time - likewise
+// creation and binding data that a future capture will reference. Skipping that work while idle
+// would leave records empty and corrupt the next capture. The always-on cost is kept down
+// piecemeal instead: compact chunk encoding for high-frequency commands, per-thread chunk
+// allocators, and the shared string table all shrink this path without losing the ability to
+// capture an arbitrary upcoming frame.
 #define SERIALISE_TIME_CALL(...)                                                          \
   {                                                                                       \
     WriteSerialiser &ser = GetThreadSerialiser();                                         \
@@ -305,6 +319,13 @@ private:
   Threading::CriticalSection m_ThreadSerialisersLock;
   rdcarray<WriteSerialiser *> m_ThreadSerialisers;
 
+  // per-thread page allocators for chunk data, so capturing API calls doesn't do a heap
+  // allocation per chunk. Each thread serialiser gets its own allocator so that many app threads
+  // recording commands at once never contend on a shared lock to allocate - only cross-thread
+  // frees touch another thread's allocator. Destroyed after all the resource records and their
+  // chunks are released.
+  rdcarray<ChunkAllocator *> m_ThreadChunkAllocators;
+
   uint64_t tempMemoryTLSSlot;
   struct TempMem
   {
@@ -325,6 +346,11 @@ private:
 
   std::set<rdcstr> m_StringDB;
 
+  // interned strings referenced by id from chunks, written as its own section of the capture and
+  // loaded before the frame capture section is read. Shared by all recording thread serialisers -
+  // it only grows, so ids in chunks baked during background capture stay valid across captures.
+  StringTable m_StringTable;
+
   VkResourceRecord *m_FrameCaptureRecord;
   Chunk *m_HeaderChunk;
 
@@ -478,6 +504,23 @@ private:
   VkCommandBuffer m_IndirectCommandBuffer = VK_NULL_HANDLE;
   bool m_IndirectDraw = false;
 
+  // a group of command buffers submitted in one SubmitCmds() call, together with the internal
+  // fence passed to that submission and any staging objects that were queued for cleanup before
+  // the submission happened. Fences on a queue signal in submission order, so when this batch's
+  // fence has signalled everything submitted earlier - including whichever batch last used the
+  // staging objects - is known to be finished, and the batch can be recycled without idling the
+  // queue. The fence is unwrapped, and is VK_NULL_HANDLE when the caller of SubmitCmds() passed
+  // its own fence - those batches are only recycled by a full FlushQ().
+  struct SubmittedCmdBatch
+  {
+    VkFence fence = VK_NULL_HANDLE;
+    rdcarray<VkCommandBuffer> cmds;
+    rdcarray<rdcpair<VkBuffer, MemoryAllocation>> uploadCleanups;
+    rdcarray<rdcpair<VkImage, MemoryAllocation>> transientArrayCleanups;
+    rdcarray<VkBuffer> prepareBufferCleanups;
+    rdcarray<VkImage> prepareImageCleanups;
+  };
+
   struct
   {
     void Reset()
@@ -486,6 +529,7 @@ private:
       freecmds.clear();
       pendingcmds.clear();
       submittedcmds.clear();
+      freefences.clear();
 
       freesems.clear();
       pendingsems.clear();
@@ -498,8 +542,11 @@ private:
     // -> GetNextCmd() ->
     rdcarray<VkCommandBuffer> pendingcmds;
     // -> SubmitCmds() ->
-    rdcarray<VkCommandBuffer> submittedcmds;
-    // -> FlushQ() ------back to freecmds------^
+    rdcarray<SubmittedCmdBatch> submittedcmds;
+    // -> FlushQ()/TrimQ() --back to freecmds--^
+
+    // internal unwrapped fences not currently attached to a submitted batch
+    rdcarray<VkFence> freefences;
 
     rdcarray<VkSemaphore> freesems;
     // -> GetNextSemaphore() ->
@@ -532,6 +579,26 @@ private:
   rdcarray<VkEvent> m_CleanupEvents;
   rdcarray<VkEvent> m_PersistentEvents;
 
+  // staging buffers with GPU uploads submitted but not yet waited on, so that initial contents
+  // uploads during capture load can overlap with reading/decompressing subsequent chunks on the
+  // CPU. The buffers can only be destroyed once the GPU has consumed them, which is deferred to
+  // the next FlushQ().
+  rdcarray<rdcpair<VkBuffer, MemoryAllocation>> m_PendingUploadCleanups;
+
+  // the capture-side equivalent: temporary objects from initial contents prepares whose readback
+  // copies were submitted without a wait, so the GPU copies while the CPU prepares the next dirty
+  // resource at capture start. Destroyed on the next FlushQ() once the GPU has finished with them.
+  rdcarray<VkBuffer> m_PendingPrepareBufferCleanups;
+  rdcarray<VkImage> m_PendingPrepareImageCleanups;
+
+  // GPU-local memory held by resident initial contents (the MSAA array images), checked against
+  // Vulkan_ReplayGPUInitStateBudgetMB when deciding whether further ones stay resident.
+  uint64_t m_InitStateResidentGPUBytes = 0;
+
+  // array images recreated transiently for over-budget MSAA initial contents during an apply,
+  // destroyed on the next FlushQ() once the GPU has finished with them.
+  rdcarray<rdcpair<VkImage, MemoryAllocation>> m_PendingTransientArrayCleanups;
+
   const VkFormatProperties &GetFormatProperties(VkFormat f)
   {
     return m_PhysicalDeviceData.fmtprops[f];
@@ -560,6 +627,11 @@ private:
     uint32_t beginChunk = 0;
     uint32_t endChunk = 0;
 
+    // the file offset just after this command buffer's vkEndCommandBuffer chunk, recorded while
+    // loading. During active replay we skip the reader straight to this offset when re-using a
+    // cached re-recording, since none of the commands need to be processed.
+    uint64_t postEndChunkOffset = 0;
+
     VkCommandBufferLevel level;
     VkCommandBufferUsageFlags beginFlags;
 
@@ -676,6 +748,23 @@ private:
   // above map
   rdcarray<rdcpair<VkCommandPool, VkCommandBuffer>> m_RerecordCmdList;
 
+  // command buffers that are completely within the replayed range (i.e. not the partial one being
+  // truncated) re-record identically on every replay, so we keep them here across replays instead
+  // of re-recording them from the serialised commands each time we scrub. Keyed by bake ID. The
+  // cache is flushed whenever resource replacements change, since the recorded commands bake in
+  // the current pipelines.
+  std::map<ResourceId, rdcpair<VkCommandPool, VkCommandBuffer>> m_RerecordCachedCmds;
+
+  // the bake ID of a cacheable command buffer that's currently re-recording. It only moves into
+  // the cache above once its vkEndCommandBuffer completes the recording.
+  ResourceId m_RerecordCachePending;
+
+  // when non-zero, the replay loop skips the reader ahead to this offset after the current chunk.
+  // Set when re-using a cached re-recording, to jump over the command buffer's serialised commands.
+  uint64_t m_RerecordSkipOffset = 0;
+
+  void FreeRerecordCache();
+
   // There is only a state while currently partially replaying, it's
   // undefined/empty otherwise.
   // All IDs are original IDs, not live.
@@ -772,6 +861,11 @@ private:
   // immutable creation data
   VulkanCreationInfo m_CreationInfo;
 
+  // outstanding SPIR-V parse jobs kicked off by shader module creation during capture load.
+  // Declared after m_CreationInfo so that the destructor's implicit Wait() happens before the
+  // creation info the jobs write to is destroyed.
+  Threading::TaskGroup m_ShaderParseJobs;
+
   std::map<ResourceId, rdcarray<EventUsage>> m_ResourceUses;
   std::map<uint32_t, EventFlags> m_EventFlags;
 
@@ -804,6 +898,7 @@ private:
                                         VkDeviceSize counterOffset = 0);
   void ExecuteIndirectReadback(VkCommandBuffer commandBuffer,
                                const VkIndirectRecordData &indirectcopy);
+  void GetIndirectReadbackData(const VkIndirectPatchData &indirectPatch, bytebuf &argbuf);
 
   WriteSerialiser &GetThreadSerialiser();
   template <typename SerialiserType>
@@ -854,6 +949,9 @@ private:
   bool Apply_SparseInitialState(WrappedVkBuffer *buf, const VkInitialContents &contents);
   bool Apply_SparseInitialState(WrappedVkImage *im, const VkInitialContents &contents);
 
+  VkImage CreateInitialContentsArrayImage(ResourceId liveid, VkBuffer uploadBuf,
+                                          VkCommandBuffer cmd, MemoryAllocation &arrayMem);
+
   void ApplyInitialContents();
 
   rdcarray<APIEvent> m_RootEvents, m_Events;
@@ -892,6 +990,7 @@ private:
   }
 
   bool ProcessChunk(ReadSerialiser &ser, VulkanChunk chunk);
+  void GatherFrameStatistics();
   ReplayStatus ContextReplayLog(CaptureState readType, uint32_t startEventID, uint32_t endEventID,
                                 bool partial);
   bool ContextProcessChunk(ReadSerialiser &ser, VulkanChunk chunk);
@@ -963,6 +1062,7 @@ public:
   VulkanReplay *GetReplay() { return m_Replay; }
   // replay interface
   bool Prepare_InitialState(WrappedVkRes *res);
+  bool Hash_InitialState(ResourceId id, const VkInitialContents &initial, uint64_t &hash);
   uint64_t GetSize_InitialState(ResourceId id, const VkInitialContents &initial);
   uint64_t GetSize_SparseInitialState(ResourceId id, const VkInitialContents &initial);
   template <typename SerialiserType>
@@ -1009,7 +1109,15 @@ public:
   void ChooseMemoryIndices();
 
   EventFlags GetEventFlags(uint32_t eid) { return m_EventFlags[eid]; }
-  rdcarray<EventUsage> GetUsage(ResourceId id) { return m_ResourceUses[id]; }
+  rdcarray<EventUsage> GetUsage(ResourceId id)
+  {
+    // the usage index is fully built during the loading replay, so look up without inserting
+    // empty entries for resources that were never used
+    auto it = m_ResourceUses.find(id);
+    if(it == m_ResourceUses.end())
+      return rdcarray<EventUsage>();
+    return it->second;
+  }
   // return the pre-selected device and queue
   VkDevice GetDev()
   {
@@ -1036,10 +1144,13 @@ public:
   void RemovePendingCommandBuffer(VkCommandBuffer cmd);
   void AddPendingCommandBuffer(VkCommandBuffer cmd);
   void SubmitCmds(VkSemaphore *unwrappedWaitSemaphores = NULL,
-                  VkPipelineStageFlags *waitStageMask = NULL, uint32_t waitSemaphoreCount = 0);
+                  VkPipelineStageFlags *waitStageMask = NULL, uint32_t waitSemaphoreCount = 0,
+                  VkFence unwrappedFence = VK_NULL_HANDLE);
   VkSemaphore GetNextSemaphore();
   void SubmitSemaphores();
   void FlushQ();
+  void TrimQ(size_t maxInFlight);
+  void RecycleCmdBatch(SubmittedCmdBatch &batch);
 
   bool SeparateDepthStencil() const { return m_SeparateDepthStencil; }
   VulkanRenderState &GetRenderState() { return m_RenderState; }
@@ -113,6 +113,8 @@ void VulkanReplay::convertKhrCounterResult(CounterResult &rdcResult,
 
 rdcarray<GPUCounter> VulkanReplay::EnumerateCounters()
 {
+  InitIHVCounters();
+
   rdcarray<GPUCounter> ret;
 
   VkPhysicalDeviceFeatures availableFeatures = m_pDriver->GetDeviceFeatures();
@@ -465,6 +467,8 @@ rdcarray<CounterResult> VulkanReplay::FetchCountersAMD(const rdcarray<GPUCounter
 
   for(uint32_t i = 0; i < passCount; i++)
   {
+    RenderDoc::Inst().SetProgress(CounterProgress::FetchPass, float(i) / float(passCount));
+
     m_pAMDCounters->BeginPass();
 
     uint32_t eventStartID = 0;
@@ -478,6 +482,8 @@ rdcarray<CounterResult> VulkanReplay::FetchCountersAMD(const rdcarray<GPUCounter
     m_pAMDCounters->EndPass();
   }
 
+  RenderDoc::Inst().SetProgress(CounterProgress::FetchPass, 1.0f);
+
   m_pAMDCounters->EndSesssion(sessionID);
 
   rdcarray<CounterResult> ret =
@@ -641,6 +647,8 @@ rdcarray<CounterResult> VulkanReplay::FetchCountersKHR(const rdcarray<GPUCounter
   // replay the events to perform all the queries
   for(uint32_t i = 0; i < passCount; i++)
   {
+    RenderDoc::Inst().SetProgress(CounterProgress::FetchPass, float(i) / float(passCount));
+
     VkPerformanceQuerySubmitInfoKHR perfSubmitInfo = {
         VK_STRUCTURE_TYPE_PERFORMANCE_QUERY_SUBMIT_INFO_KHR, NULL, i};
 
@@ -651,6 +659,8 @@ rdcarray<CounterResult> VulkanReplay::FetchCountersKHR(const rdcarray<GPUCounter
     m_pDriver->SetSubmitChain(NULL);
   }
 
+  RenderDoc::Inst().SetProgress(CounterProgress::FetchPass, 1.0f);
+
   rdcarray<VkPerformanceCounterResultKHR> perfResults;
   perfResults.resize(cb.m_Results.size() * counters.size());
 
@@ -736,7 +736,18 @@ VulkanDebugManager::VulkanDebugManager(WrappedVulkan *driver)
 
   // we only need this during replay, so don't create otherwise.
   if(RenderDoc::Inst().IsReplayApp())
+  {
     m_ReadbackWindow.Create(driver, dev, STAGE_BUFFER_BYTE_SIZE, 1, GPUBuffer::eGPUBufferReadback);
+
+    VkFenceCreateInfo fenceInfo = {VK_STRUCTURE_TYPE_FENCE_CREATE_INFO, NULL, 0};
+
+    // unwrapped fences - they only ever pass through the internal submit path
+    for(size_t i = 0; i < ARRAY_COUNT(m_ReadbackFence); i++)
+    {
+      VkResult vkr = ObjDisp(dev)->CreateFence(Unwrap(dev), &fenceInfo, NULL, &m_ReadbackFence[i]);
+      RDCASSERTEQUAL(vkr, VK_SUCCESS);
+    }
+  }
 }
 
 VulkanDebugManager::~VulkanDebugManager()
@@ -747,6 +758,11 @@ VulkanDebugManager::~VulkanDebugManager()
 
   m_ReadbackWindow.Destroy();
 
+  m_PatchedIB.Destroy();
+
+  for(size_t i = 0; i < ARRAY_COUNT(m_ReadbackFence); i++)
+    ObjDisp(dev)->DestroyFence(Unwrap(dev), m_ReadbackFence[i], NULL);
+
   for(auto it = m_CachedMeshPipelines.begin(); it != m_CachedMeshPipelines.end(); ++it)
     for(uint32_t i = 0; i < VKMeshDisplayPipelines::ePipe_Count; i++)
       m_pDriver->vkDestroyPipeline(dev, it->second.pipes[i], NULL);
@@ -1046,12 +1062,33 @@ uint32_t VulkanReplay::PickVertex(uint32_t eventId, int32_t w, int32_t h, const
 
   uint32_t numIndices = cfg.position.numIndices;
 
+  // if the same mesh data is already uploaded to the pick buffers from a previous pick on this
+  // draw, skip the buffer readback, conversion to uint32/float4 and re-upload below and just
+  // re-run the dispatch with the new ray - on big draws the data preparation dominates the cost
+  // of a pick.
+  const bool cached =
+      m_VertexPick.CacheValid && m_VertexPick.CachedEventId == eventId &&
+      m_VertexPick.CachedPosition.indexResourceId == cfg.position.indexResourceId &&
+      m_VertexPick.CachedPosition.indexByteOffset == cfg.position.indexByteOffset &&
+      m_VertexPick.CachedPosition.indexByteStride == cfg.position.indexByteStride &&
+      m_VertexPick.CachedPosition.baseVertex == cfg.position.baseVertex &&
+      m_VertexPick.CachedPosition.restartIndex == cfg.position.restartIndex &&
+      m_VertexPick.CachedPosition.allowRestart == cfg.position.allowRestart &&
+      m_VertexPick.CachedPosition.topology == cfg.position.topology &&
+      m_VertexPick.CachedPosition.vertexResourceId == cfg.position.vertexResourceId &&
+      m_VertexPick.CachedPosition.vertexByteOffset == cfg.position.vertexByteOffset &&
+      m_VertexPick.CachedPosition.vertexByteStride == cfg.position.vertexByteStride &&
+      m_VertexPick.CachedPosition.format == cfg.position.format &&
+      m_VertexPick.CachedPosition.numIndices == cfg.position.numIndices;
+
+  m_VertexPick.CacheValid = false;
+
   bytebuf idxs;
 
   uint32_t minIndex = 0;
   uint32_t maxIndex = cfg.position.numIndices;
 
-  if(cfg.position.indexByteStride && cfg.position.indexResourceId != ResourceId())
+  if(!cached && cfg.position.indexByteStride && cfg.position.indexResourceId != ResourceId())
     GetBufferData(cfg.position.indexResourceId, cfg.position.indexByteOffset, 0, idxs);
 
   uint32_t idxclamp = 0;
@@ -1183,7 +1220,13 @@ uint32_t VulkanReplay::PickVertex(uint32_t eventId, int32_t w, int32_t h, const
     m_VertexPick.IBUpload.Unmap();
   }
 
+  const bool useIndices = cached ? m_VertexPick.CachedUseIndices : !idxs.empty();
+
+  if(cached)
+    numIndices = m_VertexPick.CachedNumIndices;
+
   // unpack and linearise the data
+  if(!cached)
   {
     bytebuf oldData;
     GetBufferData(cfg.position.vertexResourceId, cfg.position.vertexByteOffset, 0, oldData);
@@ -1290,7 +1333,7 @@ uint32_t VulkanReplay::PickVertex(uint32_t eventId, int32_t w, int32_t h, const
        VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, NULL, &ibInfo, NULL},
   };
 
-  if(!idxs.empty())
+  if(useIndices)
     vt->UpdateDescriptorSets(Unwrap(m_Device), 2, writes, 0, NULL);
   else
     vt->UpdateDescriptorSets(Unwrap(m_Device), 1, writes, 0, NULL);
@@ -1322,8 +1365,10 @@ uint32_t VulkanReplay::PickVertex(uint32_t eventId, int32_t w, int32_t h, const
   // wait for zero to be written to atomic counter before using in shader
   DoPipelineBarrier(cmd, 1, &bufBarrier);
 
-  // copy uploaded VB and if needed IB
-  if(!idxs.empty())
+  // copy uploaded VB and if needed IB. On a cache hit the pick buffers already hold the right
+  // data from the previous pick, which has completed - we flush and wait below before reading
+  // results back.
+  if(!cached && !idxs.empty())
   {
     // wait for writes
     bufBarrier.buffer = Unwrap(m_VertexPick.IBUpload.buf);
@@ -1343,22 +1388,25 @@ uint32_t VulkanReplay::PickVertex(uint32_t eventId, int32_t w, int32_t h, const
     DoPipelineBarrier(cmd, 1, &bufBarrier);
   }
 
-  // wait for writes
-  bufBarrier.buffer = Unwrap(m_VertexPick.VBUpload.buf);
-  bufBarrier.srcAccessMask = VK_ACCESS_HOST_WRITE_BIT;
-  bufBarrier.dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
-  DoPipelineBarrier(cmd, 1, &bufBarrier);
+  if(!cached)
+  {
+    // wait for writes
+    bufBarrier.buffer = Unwrap(m_VertexPick.VBUpload.buf);
+    bufBarrier.srcAccessMask = VK_ACCESS_HOST_WRITE_BIT;
+    bufBarrier.dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
+    DoPipelineBarrier(cmd, 1, &bufBarrier);
 
-  // do copy
-  bufCopy.size = m_VertexPick.VBSize;
-  vt->CmdCopyBuffer(Unwrap(cmd), Unwrap(m_VertexPick.VBUpload.buf), Unwrap(m_VertexPick.VB.buf), 1,
-                    &bufCopy);
+    // do copy
+    bufCopy.size = m_VertexPick.VBSize;
+    vt->CmdCopyBuffer(Unwrap(cmd), Unwrap(m_VertexPick.VBUpload.buf), Unwrap(m_VertexPick.VB.buf),
+                      1, &bufCopy);
 
-  // wait for copy
-  bufBarrier.buffer = Unwrap(m_VertexPick.VB.buf);
-  bufBarrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
-  bufBarrier.dstAccessMask = VK_ACCESS_UNIFORM_READ_BIT;
-  DoPipelineBarrier(cmd, 1, &bufBarrier);
+    // wait for copy
+    bufBarrier.buffer = Unwrap(m_VertexPick.VB.buf);
+    bufBarrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+    bufBarrier.dstAccessMask = VK_ACCESS_UNIFORM_READ_BIT;
+    DoPipelineBarrier(cmd, 1, &bufBarrier);
+  }
 
   vt->CmdBindPipeline(Unwrap(cmd), VK_PIPELINE_BIND_POINT_COMPUTE, Unwrap(m_VertexPick.Pipeline));
   vt->CmdBindDescriptorSets(Unwrap(cmd), VK_PIPELINE_BIND_POINT_COMPUTE, Unwrap(m_VertexPick.Layout),
@@ -1463,6 +1511,12 @@ uint32_t VulkanReplay::PickVertex(uint32_t eventId, int32_t w, int32_t h, const
 
   m_VertexPick.ResultReadback.Unmap();
 
+  m_VertexPick.CacheValid = true;
+  m_VertexPick.CachedEventId = eventId;
+  m_VertexPick.CachedPosition = cfg.position;
+  m_VertexPick.CachedNumIndices = numIndices;
+  m_VertexPick.CachedUseIndices = useIndices;
+
   VkMarkerRegion::Set(StringFormat::Fmt("Result is %u", ret));
 
   VkMarkerRegion::End();
@@ -1623,22 +1677,41 @@ void VulkanDebugManager::GetBufferData(ResourceId buff, uint64_t offset, uint64_
   m_pDriver->SubmitCmds();
 #endif
 
+  // double-buffer the chunked readback: the window is split in half, and while the GPU copies
+  // chunk N into one half we read chunk N-1 back out of the other. The per-half fences give us a
+  // wait on just the chunk we want to read, where FlushQ() would serialise the CPU against the
+  // whole queue going idle on every chunk.
+  const VkDeviceSize windowSize = STAGE_BUFFER_BYTE_SIZE / 2;
+
+  byte *pData = NULL;
+  vkr = vt->MapMemory(Unwrap(dev), Unwrap(m_ReadbackWindow.mem), 0, VK_WHOLE_SIZE, 0,
+                      (void **)&pData);
+  RDCASSERTEQUAL(vkr, VK_SUCCESS);
+
+  RDCASSERT(pData != NULL);
+
+  uint32_t chunkIdx = 0;
+
+  VkDeviceSize prevChunkSize = 0;
+  size_t prevDstOffset = 0;
+
   while(sizeRemaining > 0)
   {
-    VkDeviceSize chunkSize = RDCMIN(sizeRemaining, STAGE_BUFFER_BYTE_SIZE);
+    VkDeviceSize chunkSize = RDCMIN(sizeRemaining, windowSize);
+    VkDeviceSize windowOffset = (chunkIdx & 1) * windowSize;
 
     cmd = m_pDriver->GetNextCmd();
 
     vkr = vt->BeginCommandBuffer(Unwrap(cmd), &beginInfo);
     RDCASSERTEQUAL(vkr, VK_SUCCESS);
 
-    VkBufferCopy region = {srcoffset, 0, chunkSize};
+    VkBufferCopy region = {srcoffset, windowOffset, chunkSize};
     vt->CmdCopyBuffer(Unwrap(cmd), Unwrap(srcBuf), Unwrap(m_ReadbackWindow.buf), 1, &region);
 
     bufBarrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
     bufBarrier.dstAccessMask = VK_ACCESS_HOST_READ_BIT;
     bufBarrier.buffer = Unwrap(m_ReadbackWindow.buf);
-    bufBarrier.offset = 0;
+    bufBarrier.offset = windowOffset;
     bufBarrier.size = chunkSize;
 
     // wait for transfer to happen before we read
@@ -1647,12 +1720,45 @@ void VulkanDebugManager::GetBufferData(ResourceId buff, uint64_t offset, uint64_
     vkr = vt->EndCommandBuffer(Unwrap(cmd));
     RDCASSERTEQUAL(vkr, VK_SUCCESS);
 
-    m_pDriver->SubmitCmds();
-    m_pDriver->FlushQ();
+    m_pDriver->SubmitCmds(NULL, NULL, 0, m_ReadbackFence[chunkIdx & 1]);
+
+    // with this chunk's copy in flight, read back the previous chunk from the other half
+    if(chunkIdx > 0)
+    {
+      VkFence prevFence = m_ReadbackFence[(chunkIdx - 1) & 1];
+
+      vkr = vt->WaitForFences(Unwrap(dev), 1, &prevFence, VK_TRUE, UINT64_MAX);
+      RDCASSERTEQUAL(vkr, VK_SUCCESS);
+      vkr = vt->ResetFences(Unwrap(dev), 1, &prevFence);
+      RDCASSERTEQUAL(vkr, VK_SUCCESS);
+
+      VkMappedMemoryRange range = {
+          VK_STRUCTURE_TYPE_MAPPED_MEMORY_RANGE, NULL, Unwrap(m_ReadbackWindow.mem), 0,
+          VK_WHOLE_SIZE,
+      };
+
+      vkr = vt->InvalidateMappedMemoryRanges(Unwrap(dev), 1, &range);
+      RDCASSERTEQUAL(vkr, VK_SUCCESS);
+
+      memcpy(&ret[prevDstOffset], pData + ((chunkIdx - 1) & 1) * windowSize, (size_t)prevChunkSize);
+    }
+
+    prevChunkSize = chunkSize;
+    prevDstOffset = dstoffset;
+
+    srcoffset += chunkSize;
+    dstoffset += (size_t)chunkSize;
+    sizeRemaining -= chunkSize;
+    chunkIdx++;
+  }
+
+  // the last chunk is still in flight - wait for it and read it back
+  {
+    VkFence lastFence = m_ReadbackFence[(chunkIdx - 1) & 1];
 
-    byte *pData = NULL;
-    vkr = vt->MapMemory(Unwrap(dev), Unwrap(m_ReadbackWindow.mem), 0, VK_WHOLE_SIZE, 0,
-                        (void **)&pData);
+    vkr = vt->WaitForFences(Unwrap(dev), 1, &lastFence, VK_TRUE, UINT64_MAX);
+    RDCASSERTEQUAL(vkr, VK_SUCCESS);
+    vkr = vt->ResetFences(Unwrap(dev), 1, &lastFence);
     RDCASSERTEQUAL(vkr, VK_SUCCESS);
 
     VkMappedMemoryRange range = {
@@ -1662,15 +1768,13 @@ void VulkanDebugManager::GetBufferData(ResourceId buff, uint64_t offset, uint64_
     vkr = vt->InvalidateMappedMemoryRanges(Unwrap(dev), 1, &range);
     RDCASSERTEQUAL(vkr, VK_SUCCESS);
 
-    RDCASSERT(pData != NULL);
-    memcpy(&ret[dstoffset], pData, (size_t)chunkSize);
+    memcpy(&ret[prevDstOffset], pData + ((chunkIdx - 1) & 1) * windowSize, (size_t)prevChunkSize);
+  }
 
-    srcoffset += chunkSize;
-    dstoffset += (size_t)chunkSize;
-    sizeRemaining -= chunkSize;
+  vt->UnmapMemory(Unwrap(dev), Unwrap(m_ReadbackWindow.mem));
 
-    vt->UnmapMemory(Unwrap(dev), Unwrap(m_ReadbackWindow.mem));
-  }
+  // recycle the submitted command buffers now all the fences have been waited on
+  m_pDriver->FlushQ();
 
   vt->DeviceWaitIdle(Unwrap(dev));
 }
@@ -1727,6 +1831,16 @@ void VulkanReplay::CreateResources()
   m_ShaderDebugData.Init(m_pDriver, m_General.DescriptorPool);
 
   RenderDoc::Inst().SetProgress(LoadProgress::DebugManagerInit, 1.0f);
+}
+
+void VulkanReplay::InitIHVCounters()
+{
+  // only try once, and only after the UI first asks for counters - GPUPerfAPI can take seconds to
+  // load and initialise, which we don't want to pay on every capture open.
+  if(m_IHVCountersTried)
+    return;
+
+  m_IHVCountersTried = true;
 
   GPA_vkContextOpenInfo context = {Unwrap(m_pDriver->GetInstance()),
                                    Unwrap(m_pDriver->GetPhysDev()), Unwrap(m_pDriver->GetDev())};
@@ -2675,8 +2789,9 @@ void VulkanReplay::PixelPicking::Init(WrappedVulkan *driver, VkDescriptorPool de
   vkr = driver->vkCreateFramebuffer(driver->GetDev(), &fbinfo, NULL, &FB);
   RDCASSERTEQUAL(vkr, VK_SUCCESS);
 
-  // since we always sync for readback, doesn't need to be ring'd
-  ReadbackBuffer.Create(driver, driver->GetDev(), sizeof(float) * 4, 1,
+  // since we always sync for readback, doesn't need to be ring'd. Two slots so that the depth and
+  // stencil passes of a pick can land in one submit and be read back with a single map.
+  ReadbackBuffer.Create(driver, driver->GetDev(), sizeof(float) * 4 * 2, 1,
                         GPUBuffer::eGPUBufferReadback);
 }
 
@@ -85,8 +85,7 @@ public:
 
   void PatchOutputLocation(VkShaderModule &mod, BuiltinShader shaderType, uint32_t framebufferIndex);
   void PatchFixedColShader(VkShaderModule &mod, float col[4]);
-  void PatchLineStripIndexBuffer(const DrawcallDescription *draw, GPUBuffer &indexBuffer,
-                                 uint32_t &indexCount);
+  void PatchLineStripIndexBuffer(const DrawcallDescription *draw, uint32_t &indexCount);
 
   bool PixelHistorySetupResources(PixelHistoryResources &resources, VkImage targetImage,
                                   VkExtent3D extent, VkFormat format, VkSampleCountFlagBits samples,
@@ -111,6 +110,14 @@ public:
 private:
   // GetBufferData
   GPUBuffer m_ReadbackWindow;
+  // unwrapped fences, one per half of the readback window, so chunked readbacks can wait on just
+  // the chunk they want to read instead of flushing the whole queue.
+  VkFence m_ReadbackFence[2] = {VK_NULL_HANDLE, VK_NULL_HANDLE};
+
+  // PatchLineStripIndexBuffer. Cached and grown on demand rather than allocated per overlay
+  // render, since the wireframe fallback path runs every time the overlay refreshes.
+  GPUBuffer m_PatchedIB;
+  VkDeviceSize m_PatchedIBSize = 0;
 
   // CacheMeshDisplayPipelines
   std::map<uint64_t, VKMeshDisplayPipelines> m_CachedMeshPipelines;
@@ -420,6 +420,15 @@ inline FrameRefType ImageSubresourceMap::Merge(const ImageSubresourceMap &other,
       }
     }
   }
+
+  // merging happens for every image touched by every submission, and splits are sticky - once an
+  // image fragments into per-subresource entries it would otherwise pay the per-subresource cost
+  // on every merge for the rest of the capture, even long after its states became uniform again.
+  // Re-coalesce any dimensions that ended up uniform; Unsplit() bails out of its scan as soon as
+  // no dimension can be collapsed, so persistently-fragmented images only pay a short prefix scan.
+  if(m_values.size() > 1)
+    Unsplit();
+
   return maxRefType;
 }
 
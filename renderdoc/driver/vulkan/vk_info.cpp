@@ -1045,17 +1045,22 @@ void VulkanCreationInfo::ImageView::Init(VulkanResourceManager *resourceMan, Vul
 void VulkanCreationInfo::ShaderModule::Init(VulkanResourceManager *resourceMan,
                                             VulkanCreationInfo &info,
                                             const VkShaderModuleCreateInfo *pCreateInfo)
+{
+  RDCASSERT(pCreateInfo->codeSize % sizeof(uint32_t) == 0);
+  Init(rdcarray<uint32_t>((uint32_t *)(pCreateInfo->pCode),
+                          pCreateInfo->codeSize / sizeof(uint32_t)));
+}
+
+void VulkanCreationInfo::ShaderModule::Init(const rdcarray<uint32_t> &spirvCode)
 {
   const uint32_t SPIRVMagic = 0x07230203;
-  if(pCreateInfo->codeSize < 4 || memcmp(pCreateInfo->pCode, &SPIRVMagic, sizeof(SPIRVMagic)) != 0)
+  if(spirvCode.empty() || spirvCode[0] != SPIRVMagic)
   {
     RDCWARN("Shader not provided with SPIR-V");
   }
   else
   {
-    RDCASSERT(pCreateInfo->codeSize % sizeof(uint32_t) == 0);
-    spirv.Parse(rdcarray<uint32_t>((uint32_t *)(pCreateInfo->pCode),
-                                   pCreateInfo->codeSize / sizeof(uint32_t)));
+    spirv.Parse(spirvCode);
   }
 }
 
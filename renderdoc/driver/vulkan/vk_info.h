@@ -524,6 +524,7 @@ struct VulkanCreationInfo
   {
     void Init(VulkanResourceManager *resourceMan, VulkanCreationInfo &info,
               const VkShaderModuleCreateInfo *pCreateInfo);
+    void Init(const rdcarray<uint32_t> &spirvCode);
 
     ShaderModuleReflection &GetReflection(const rdcstr &entry, ResourceId pipe)
     {
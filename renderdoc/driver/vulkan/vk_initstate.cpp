@@ -22,9 +22,18 @@
  * THE SOFTWARE.
  ******************************************************************************/
 
+#include "core/settings.h"
 #include "vk_core.h"
 #include "vk_debug.h"
 
+#include "zstd/xxhash.h"
+
+RDOC_CONFIG(uint64_t, Vulkan_ReplayGPUInitStateBudgetMB, 0,
+            "Budget in MB for initial contents kept in GPU-local memory on replay - currently the "
+            "intermediate array images for MSAA textures, everything else stays host-visible. "
+            "Once over budget further initial states keep only their host upload buffer and are "
+            "re-uploaded transiently each time they are applied. 0 means unlimited.");
+
 // VKTODOLOW there's a lot of duplicated code in this file for creating a buffer to do
 // a memory copy and saving to disk.
 
@@ -61,10 +70,15 @@ bool WrappedVulkan::Prepare_InitialState(WrappedVkRes *res)
       uint32_t e = 0;
       for(size_t i = 0; i < layout.bindings.size(); i++)
       {
-        for(uint32_t b = 0; b < layout.bindings[i].descriptorCount; b++)
-        {
-          initialContents.descriptorSlots[e++] = record->descInfo->descBindings[i][b];
-        }
+        // only copy slots that have ever been written - the tail of large bindless arrays is
+        // commonly untouched, and the whole array was zeroed above so the tail stays empty.
+        uint32_t written =
+            RDCMIN(record->descInfo->writtenHighWater[i], layout.bindings[i].descriptorCount);
+
+        memcpy(&initialContents.descriptorSlots[e], record->descInfo->descBindings[i],
+               sizeof(DescriptorSetSlot) * written);
+
+        e += layout.bindings[i].descriptorCount;
       }
     }
     else
@@ -415,18 +429,40 @@ bool WrappedVulkan::Prepare_InitialState(WrappedVkRes *res)
     vkr = ObjDisp(d)->EndCommandBuffer(Unwrap(cmd));
     RDCASSERTEQUAL(vkr, VK_SUCCESS);
 
-    SubmitAndFlushImageStateBarriers(m_setupImageBarriers);
-    SubmitCmds();
-    FlushQ();
-    SubmitAndFlushImageStateBarriers(m_cleanupImageBarriers);
+    // INITSTATEBATCH
+    // in the common case the layout transitions were inlined into cmd above and the cross-family
+    // barrier lists are empty, so we can submit the readback without waiting on it and let the GPU
+    // copy while the CPU prepares the next dirty resource - this is most of the capture-trigger
+    // hitch for texture-heavy applications. The temporary objects are destroyed once their
+    // batch's fence signals, and TrimQ() bounds how much work and readback memory can be
+    // outstanding without serialising against the GPU.
+    if(m_setupImageBarriers.empty() && m_cleanupImageBarriers.empty())
+    {
+      SubmitCmds();
 
-    ObjDisp(d)->DestroyBuffer(Unwrap(d), Unwrap(dstBuf), NULL);
-    GetResourceManager()->ReleaseWrappedResource(dstBuf);
+      m_PendingPrepareBufferCleanups.push_back(dstBuf);
+      if(arrayIm != VK_NULL_HANDLE)
+        m_PendingPrepareImageCleanups.push_back(arrayIm);
 
-    if(arrayIm != VK_NULL_HANDLE)
+      TrimQ(8);
+    }
+    else
     {
-      ObjDisp(d)->DestroyImage(Unwrap(d), Unwrap(arrayIm), NULL);
-      GetResourceManager()->ReleaseWrappedResource(arrayIm);
+      // images shared with external/foreign queue families need their transitions submitted and
+      // waited on either side of the copy, so for those we keep the conservative flush.
+      SubmitAndFlushImageStateBarriers(m_setupImageBarriers);
+      SubmitCmds();
+      FlushQ();
+      SubmitAndFlushImageStateBarriers(m_cleanupImageBarriers);
+
+      ObjDisp(d)->DestroyBuffer(Unwrap(d), Unwrap(dstBuf), NULL);
+      GetResourceManager()->ReleaseWrappedResource(dstBuf);
+
+      if(arrayIm != VK_NULL_HANDLE)
+      {
+        ObjDisp(d)->DestroyImage(Unwrap(d), Unwrap(arrayIm), NULL);
+        GetResourceManager()->ReleaseWrappedResource(arrayIm);
+      }
     }
 
     GetResourceManager()->SetInitialContents(id, VkInitialContents(type, readbackmem));
@@ -516,13 +552,15 @@ bool WrappedVulkan::Prepare_InitialState(WrappedVkRes *res)
     RDCASSERTEQUAL(vkr, VK_SUCCESS);
 
     // INITSTATEBATCH
+    // submit the copy without waiting on it, so the GPU reads back this memory while the CPU
+    // prepares the next dirty resource. The temporary buffers are destroyed once their batch's
+    // fence signals, and TrimQ() bounds outstanding work without serialising against the GPU.
     SubmitCmds();
-    FlushQ();
 
-    ObjDisp(d)->DestroyBuffer(Unwrap(d), Unwrap(srcBuf), NULL);
-    ObjDisp(d)->DestroyBuffer(Unwrap(d), Unwrap(dstBuf), NULL);
-    GetResourceManager()->ReleaseWrappedResource(srcBuf);
-    GetResourceManager()->ReleaseWrappedResource(dstBuf);
+    m_PendingPrepareBufferCleanups.push_back(srcBuf);
+    m_PendingPrepareBufferCleanups.push_back(dstBuf);
+
+    TrimQ(8);
 
     GetResourceManager()->SetInitialContents(id, VkInitialContents(type, readbackmem));
 
@@ -536,6 +574,43 @@ bool WrappedVulkan::Prepare_InitialState(WrappedVkRes *res)
   return false;
 }
 
+bool WrappedVulkan::Hash_InitialState(ResourceId id, const VkInitialContents &initial,
+                                      uint64_t &hash)
+{
+  // only hash plain device memory contents sitting in a readback buffer. Other types either have
+  // no raw blob to hash, or bake per-resource creation information into their serialised
+  // contents so identical bytes wouldn't mean interchangeable chunks.
+  if(initial.type != eResDeviceMemory || initial.tag != VkInitialContents::BufferCopy ||
+     initial.mem.mem == VK_NULL_HANDLE || initial.mem.type != MemoryType::Readback ||
+     initial.mem.size == 0)
+    return false;
+
+  VkDevice d = GetDev();
+
+  byte *Contents = NULL;
+  VkResult vkr = ObjDisp(d)->MapMemory(Unwrap(d), Unwrap(initial.mem.mem), initial.mem.offs,
+                                       initial.mem.size, 0, (void **)&Contents);
+
+  if(vkr != VK_SUCCESS || Contents == NULL)
+    return false;
+
+  // invalidate the cpu cache for this memory range to avoid reading stale data
+  VkMappedMemoryRange range = {
+      VK_STRUCTURE_TYPE_MAPPED_MEMORY_RANGE, NULL, Unwrap(initial.mem.mem), initial.mem.offs,
+      initial.mem.size,
+  };
+
+  vkr = ObjDisp(d)->InvalidateMappedMemoryRanges(Unwrap(d), 1, &range);
+  RDCASSERTEQUAL(vkr, VK_SUCCESS);
+
+  // seed with the size so only blobs of the same length can collide
+  hash = XXH64(Contents, (size_t)initial.mem.size, initial.mem.size);
+
+  ObjDisp(d)->UnmapMemory(Unwrap(d), Unwrap(initial.mem.mem));
+
+  return true;
+}
+
 uint64_t WrappedVulkan::GetSize_InitialState(ResourceId id, const VkInitialContents &initial)
 {
   if(initial.type == eResDescriptorSet)
@@ -550,7 +625,8 @@ uint64_t WrappedVulkan::GetSize_InitialState(ResourceId id, const VkInitialConte
     for(size_t i = 0; i < layout.bindings.size(); i++)
       NumBindings += layout.bindings[i].descriptorCount;
 
-    return 32 + NumBindings * sizeof(DescriptorSetSlot);
+    // upper bound - only the written prefix of each binding is serialised
+    return 32 + layout.bindings.size() * sizeof(uint32_t) + NumBindings * sizeof(DescriptorSetSlot);
   }
   else if(initial.type == eResBuffer)
   {
@@ -583,6 +659,150 @@ static rdcliteral NameOfType(VkResourceType type)
   return "VkResource"_lit;
 }
 
+// creates the intermediate 1-sample array image used to upload MSAA initial contents, and records
+// into cmd the copies from the tightly-packed upload buffer, leaving the image in
+// SHADER_READ_ONLY_OPTIMAL ready for the array-to-MSAA copy in apply. The caller owns the returned
+// image and its allocation, which is returned in arrayMem.
+VkImage WrappedVulkan::CreateInitialContentsArrayImage(ResourceId liveid, VkBuffer uploadBuf,
+                                                       VkCommandBuffer cmd, MemoryAllocation &arrayMem)
+{
+  VkDevice d = GetDev();
+  VkResult vkr = VK_SUCCESS;
+
+  VulkanCreationInfo::Image &c = m_CreationInfo.m_Image[liveid];
+
+  int numLayers = c.arrayLayers * (int)c.samples;
+
+  VkImageCreateInfo arrayInfo = {
+      VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO,
+      NULL,
+      VK_IMAGE_CREATE_MUTABLE_FORMAT_BIT,
+      VK_IMAGE_TYPE_2D,
+      c.format,
+      c.extent,
+      (uint32_t)c.mipLevels,
+      (uint32_t)numLayers,
+      VK_SAMPLE_COUNT_1_BIT,
+      VK_IMAGE_TILING_OPTIMAL,
+      VK_IMAGE_USAGE_SAMPLED_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT,
+      VK_SHARING_MODE_EXCLUSIVE,
+      0,
+      NULL,
+      VK_IMAGE_LAYOUT_UNDEFINED,
+  };
+
+  VkImage arrayIm;
+
+  vkr = vkCreateImage(d, &arrayInfo, NULL, &arrayIm);
+  RDCASSERTEQUAL(vkr, VK_SUCCESS);
+
+  arrayMem = AllocateMemoryForResource(arrayIm, MemoryScope::InitialContents, MemoryType::GPULocal);
+
+  vkr = vkBindImageMemory(d, arrayIm, arrayMem.mem, arrayMem.offs);
+  RDCASSERTEQUAL(vkr, VK_SUCCESS);
+
+  VkExtent3D extent = c.extent;
+
+  VkFormat fmt = c.format;
+  VkImageAspectFlags aspectFlags = FormatImageAspects(fmt);
+
+  VkImageMemoryBarrier dstimBarrier = {
+      VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER,
+      NULL,
+      0,
+      0,
+      VK_IMAGE_LAYOUT_UNDEFINED,
+      VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+      VK_QUEUE_FAMILY_IGNORED,
+      VK_QUEUE_FAMILY_IGNORED,
+      Unwrap(arrayIm),
+      {aspectFlags, 0, VK_REMAINING_MIP_LEVELS, 0, VK_REMAINING_ARRAY_LAYERS}};
+
+  DoPipelineBarrier(cmd, 1, &dstimBarrier);
+
+  VkDeviceSize bufOffset = 0;
+
+  // must ensure offset remains valid. Must be multiple of block size, or 4, depending on
+  // format
+  VkDeviceSize bufAlignment = 4;
+  if(IsBlockFormat(fmt))
+    bufAlignment = (VkDeviceSize)GetByteSize(1, 1, 1, fmt, 0);
+
+  rdcarray<VkBufferImageCopy> mainCopies, stencilCopies;
+
+  // copy each slice/mip individually
+  for(int a = 0; a < numLayers; a++)
+  {
+    extent = c.extent;
+
+    for(int m = 0; m < c.mipLevels; m++)
+    {
+      VkBufferImageCopy region = {
+          0,
+          0,
+          0,
+          {aspectFlags, (uint32_t)m, (uint32_t)a, 1},
+          {
+              0, 0, 0,
+          },
+          extent,
+      };
+
+      bufOffset = AlignUp(bufOffset, bufAlignment);
+
+      region.bufferOffset = bufOffset;
+
+      // for depth/stencil copies, copy depth first
+      if(aspectFlags == (VK_IMAGE_ASPECT_DEPTH_BIT | VK_IMAGE_ASPECT_STENCIL_BIT))
+        region.imageSubresource.aspectMask = VK_IMAGE_ASPECT_DEPTH_BIT;
+
+      VkFormat sizeFormat = GetDepthOnlyFormat(fmt);
+
+      // pass 0 for mip since we've already pre-downscaled extent
+      bufOffset += GetByteSize(extent.width, extent.height, extent.depth, sizeFormat, 0);
+
+      mainCopies.push_back(region);
+
+      if(aspectFlags == (VK_IMAGE_ASPECT_DEPTH_BIT | VK_IMAGE_ASPECT_STENCIL_BIT))
+      {
+        // if it's a depth/stencil format, copy stencil now
+        bufOffset = AlignUp(bufOffset, bufAlignment);
+
+        region.bufferOffset = bufOffset;
+        region.imageSubresource.aspectMask = VK_IMAGE_ASPECT_STENCIL_BIT;
+
+        bufOffset += GetByteSize(extent.width, extent.height, extent.depth, VK_FORMAT_S8_UINT, 0);
+
+        stencilCopies.push_back(region);
+      }
+
+      // update the extent for the next mip
+      extent.width = RDCMAX(extent.width >> 1, 1U);
+      extent.height = RDCMAX(extent.height >> 1, 1U);
+      extent.depth = RDCMAX(extent.depth >> 1, 1U);
+    }
+  }
+
+  ObjDisp(cmd)->CmdCopyBufferToImage(Unwrap(cmd), Unwrap(uploadBuf), Unwrap(arrayIm),
+                                     VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                                     (uint32_t)mainCopies.size(), &mainCopies[0]);
+
+  if(!stencilCopies.empty())
+    ObjDisp(cmd)->CmdCopyBufferToImage(Unwrap(cmd), Unwrap(uploadBuf), Unwrap(arrayIm),
+                                       VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                                       (uint32_t)stencilCopies.size(), &stencilCopies[0]);
+
+  // once transfers complete, get ready for copy array->ms
+  dstimBarrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+  dstimBarrier.newLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+  dstimBarrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+  dstimBarrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+
+  DoPipelineBarrier(cmd, 1, &dstimBarrier);
+
+  return arrayIm;
+}
+
 template <typename SerialiserType>
 bool WrappedVulkan::Serialise_InitialState(SerialiserType &ser, ResourceId id,
                                            VkResourceRecord *record, const VkInitialContents *initial)
@@ -602,6 +822,16 @@ bool WrappedVulkan::Serialise_InitialState(SerialiserType &ser, ResourceId id,
     DescriptorSetSlot *Bindings = NULL;
     uint32_t NumBindings = 0;
 
+    // from version 0x12 only the written prefix of each binding's array is serialised, since
+    // giant bindless arrays are typically mostly empty. BindingsWritten holds the number of
+    // slots serialised for each binding, and Bindings is tightly packed in binding order.
+    uint32_t *BindingsWritten = NULL;
+    uint32_t NumLayoutBindings = 0;
+    uint32_t NumWrittenBindings = 0;
+
+    rdcarray<uint32_t> writtenCounts;
+    rdcarray<DescriptorSetSlot> packedBindings;
+
     // while writing, fetching binding information from prepared initial contents
     if(ser.IsWriting())
     {
@@ -612,9 +842,46 @@ bool WrappedVulkan::Serialise_InitialState(SerialiserType &ser, ResourceId id,
 
       for(size_t i = 0; i < layout.bindings.size(); i++)
         NumBindings += layout.bindings[i].descriptorCount;
+
+      NumLayoutBindings = (uint32_t)layout.bindings.size();
+
+      writtenCounts.resize(layout.bindings.size());
+
+      for(size_t i = 0; i < layout.bindings.size(); i++)
+      {
+        writtenCounts[i] =
+            RDCMIN(record->descInfo->writtenHighWater[i], layout.bindings[i].descriptorCount);
+        NumWrittenBindings += writtenCounts[i];
+      }
+
+      // pack the written prefixes tightly, dropping each binding's untouched tail
+      packedBindings.resize(NumWrittenBindings);
+
+      DescriptorSetSlot *dst = packedBindings.data();
+      const DescriptorSetSlot *src = initial->descriptorSlots;
+
+      for(size_t i = 0; i < layout.bindings.size(); i++)
+      {
+        memcpy(dst, src, sizeof(DescriptorSetSlot) * writtenCounts[i]);
+        dst += writtenCounts[i];
+        src += layout.bindings[i].descriptorCount;
+      }
+
+      BindingsWritten = writtenCounts.data();
     }
 
-    SERIALISE_ELEMENT_ARRAY(Bindings, NumBindings);
+    if(ser.VersionAtLeast(0x12))
+    {
+      if(ser.IsWriting())
+        Bindings = packedBindings.data();
+
+      SERIALISE_ELEMENT_ARRAY(BindingsWritten, NumLayoutBindings);
+      SERIALISE_ELEMENT_ARRAY(Bindings, NumWrittenBindings);
+    }
+    else
+    {
+      SERIALISE_ELEMENT_ARRAY(Bindings, NumBindings);
+    }
     SERIALISE_ELEMENT(NumBindings);
 
     SERIALISE_CHECK_READ_ERRORS();
@@ -662,6 +929,11 @@ bool WrappedVulkan::Serialise_InitialState(SerialiserType &ser, ResourceId id,
         if(descriptorCount == 0)
           continue;
 
+        // newer captures only contain the written prefix of each binding's array
+        uint32_t srcCount = descriptorCount;
+        if(BindingsWritten && j < NumLayoutBindings)
+          srcCount = RDCMIN(descriptorCount, BindingsWritten[j]);
+
         writes[bind].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
         writes[bind].pNext = NULL;
 
@@ -677,7 +949,7 @@ bool WrappedVulkan::Serialise_InitialState(SerialiserType &ser, ResourceId id,
         ResourceId *immutableSamplers = layout.bindings[j].immutableSampler;
 
         DescriptorSetSlot *src = srcData;
-        srcData += descriptorCount;
+        srcData += srcCount;
 
         // will be cast to the appropriate type, we just need to increment
         // the dstData pointer by worst case size
@@ -700,6 +972,13 @@ bool WrappedVulkan::Serialise_InitialState(SerialiserType &ser, ResourceId id,
         // For the array case we batch up updates as much as possible, iterating along the array and
         // skipping any invalid descriptors.
 
+        // if no slots in this binding were ever written there's nothing to restore
+        if(srcCount == 0)
+        {
+          // do nothing - don't increment bind so that the same write descriptor is used next time.
+          continue;
+        }
+
         // quick check for slots that were completely uninitialised and so don't have valid data
         if(descriptorCount == 1 && src->texelBufferView == ResourceId() &&
            src->imageInfo.sampler == ResourceId() && src->imageInfo.imageView == ResourceId() &&
@@ -719,7 +998,7 @@ bool WrappedVulkan::Serialise_InitialState(SerialiserType &ser, ResourceId id,
             case VK_DESCRIPTOR_TYPE_STORAGE_IMAGE:
             case VK_DESCRIPTOR_TYPE_INPUT_ATTACHMENT:
             {
-              for(uint32_t d = 0; d < descriptorCount; d++)
+              for(uint32_t d = 0; d < srcCount; d++)
               {
                 if(writes[bind].descriptorType != VK_DESCRIPTOR_TYPE_SAMPLER &&
                    GetResourceManager()->HasLiveResource(src[d].imageInfo.imageView))
@@ -743,7 +1022,7 @@ bool WrappedVulkan::Serialise_InitialState(SerialiserType &ser, ResourceId id,
               // validity checking doesn't have to look them up.
               if(immutableSamplers && writes[bind].descriptorType != VK_DESCRIPTOR_TYPE_SAMPLER)
               {
-                for(uint32_t d = 0; d < descriptorCount; d++)
+                for(uint32_t d = 0; d < srcCount; d++)
                   dstImage[d].sampler =
                       GetResourceManager()->GetCurrentHandle<VkSampler>(immutableSamplers[d]);
               }
@@ -757,7 +1036,7 @@ bool WrappedVulkan::Serialise_InitialState(SerialiserType &ser, ResourceId id,
             case VK_DESCRIPTOR_TYPE_UNIFORM_TEXEL_BUFFER:
             case VK_DESCRIPTOR_TYPE_STORAGE_TEXEL_BUFFER:
             {
-              for(uint32_t d = 0; d < descriptorCount; d++)
+              for(uint32_t d = 0; d < srcCount; d++)
               {
                 if(GetResourceManager()->HasLiveResource(src[d].texelBufferView))
                   dstTexelBuffer[d] =
@@ -777,7 +1056,7 @@ bool WrappedVulkan::Serialise_InitialState(SerialiserType &ser, ResourceId id,
             case VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC:
             case VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC:
             {
-              for(uint32_t d = 0; d < descriptorCount; d++)
+              for(uint32_t d = 0; d < srcCount; d++)
               {
                 if(GetResourceManager()->HasLiveResource(src[d].bufferInfo.buffer))
                   dstBuffer[d].buffer =
@@ -803,7 +1082,7 @@ bool WrappedVulkan::Serialise_InitialState(SerialiserType &ser, ResourceId id,
 
           // iterate over all the descriptors coalescing valid writes. At all times writes[bind] is
           // the 'current' batched update
-          for(uint32_t d = 0; d < descriptorCount; d++)
+          for(uint32_t d = 0; d < srcCount; d++)
           {
             // is this array element in the write valid? Note that below when we encounter an
             // invalid write, the next one starts from a later point in the array, so we need to
@@ -1004,41 +1283,19 @@ bool WrappedVulkan::Serialise_InitialState(SerialiserType &ser, ResourceId id,
         {
           initialContents.buf = uploadBuf;
         }
+        else if(Vulkan_ReplayGPUInitStateBudgetMB > 0 &&
+                m_InitStateResidentGPUBytes >=
+                    uint64_t(Vulkan_ReplayGPUInitStateBudgetMB) * 1024 * 1024)
+        {
+          // MSAA textures normally keep a GPU-local array image resident, but we're over the
+          // budget for those - keep only the host-visible upload buffer, and the apply will
+          // recreate the array image transiently each time it's needed.
+          initialContents.buf = uploadBuf;
+        }
         else
         {
           // MSAA textures we upload into an array image, then the apply does an array-to-MSAA copy
           // instead of the usual buffer-to-image copies.
-          int numLayers = c.arrayLayers * (int)c.samples;
-
-          VkImageCreateInfo arrayInfo = {
-              VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO,
-              NULL,
-              VK_IMAGE_CREATE_MUTABLE_FORMAT_BIT,
-              VK_IMAGE_TYPE_2D,
-              c.format,
-              c.extent,
-              (uint32_t)c.mipLevels,
-              (uint32_t)numLayers,
-              VK_SAMPLE_COUNT_1_BIT,
-              VK_IMAGE_TILING_OPTIMAL,
-              VK_IMAGE_USAGE_SAMPLED_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT,
-              VK_SHARING_MODE_EXCLUSIVE,
-              0,
-              NULL,
-              VK_IMAGE_LAYOUT_UNDEFINED,
-          };
-
-          VkImage arrayIm;
-
-          vkr = vkCreateImage(d, &arrayInfo, NULL, &arrayIm);
-          RDCASSERTEQUAL(vkr, VK_SUCCESS);
-
-          MemoryAllocation arrayMem =
-              AllocateMemoryForResource(arrayIm, MemoryScope::InitialContents, MemoryType::GPULocal);
-
-          vkr = vkBindImageMemory(d, arrayIm, arrayMem.mem, arrayMem.offs);
-          RDCASSERTEQUAL(vkr, VK_SUCCESS);
-
           VkCommandBuffer cmd = GetNextCmd();
 
           VkCommandBufferBeginInfo beginInfo = {VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO, NULL,
@@ -1047,116 +1304,24 @@ bool WrappedVulkan::Serialise_InitialState(SerialiserType &ser, ResourceId id,
           vkr = ObjDisp(cmd)->BeginCommandBuffer(Unwrap(cmd), &beginInfo);
           RDCASSERTEQUAL(vkr, VK_SUCCESS);
 
-          VkExtent3D extent = c.extent;
-
-          VkFormat fmt = c.format;
-          VkImageAspectFlags aspectFlags = FormatImageAspects(fmt);
-
-          VkImageMemoryBarrier dstimBarrier = {
-              VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER,
-              NULL,
-              0,
-              0,
-              VK_IMAGE_LAYOUT_UNDEFINED,
-              VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
-              VK_QUEUE_FAMILY_IGNORED,
-              VK_QUEUE_FAMILY_IGNORED,
-              Unwrap(arrayIm),
-              {aspectFlags, 0, VK_REMAINING_MIP_LEVELS, 0, VK_REMAINING_ARRAY_LAYERS}};
-
-          DoPipelineBarrier(cmd, 1, &dstimBarrier);
-
-          VkDeviceSize bufOffset = 0;
-
-          // must ensure offset remains valid. Must be multiple of block size, or 4, depending on
-          // format
-          VkDeviceSize bufAlignment = 4;
-          if(IsBlockFormat(fmt))
-            bufAlignment = (VkDeviceSize)GetByteSize(1, 1, 1, fmt, 0);
-
-          rdcarray<VkBufferImageCopy> mainCopies, stencilCopies;
-
-          // copy each slice/mip individually
-          for(int a = 0; a < numLayers; a++)
-          {
-            extent = c.extent;
-
-            for(int m = 0; m < c.mipLevels; m++)
-            {
-              VkBufferImageCopy region = {
-                  0,
-                  0,
-                  0,
-                  {aspectFlags, (uint32_t)m, (uint32_t)a, 1},
-                  {
-                      0, 0, 0,
-                  },
-                  extent,
-              };
-
-              bufOffset = AlignUp(bufOffset, bufAlignment);
-
-              region.bufferOffset = bufOffset;
-
-              // for depth/stencil copies, copy depth first
-              if(aspectFlags == (VK_IMAGE_ASPECT_DEPTH_BIT | VK_IMAGE_ASPECT_STENCIL_BIT))
-                region.imageSubresource.aspectMask = VK_IMAGE_ASPECT_DEPTH_BIT;
-
-              VkFormat sizeFormat = GetDepthOnlyFormat(fmt);
-
-              // pass 0 for mip since we've already pre-downscaled extent
-              bufOffset += GetByteSize(extent.width, extent.height, extent.depth, sizeFormat, 0);
-
-              mainCopies.push_back(region);
-
-              if(aspectFlags == (VK_IMAGE_ASPECT_DEPTH_BIT | VK_IMAGE_ASPECT_STENCIL_BIT))
-              {
-                // if it's a depth/stencil format, copy stencil now
-                bufOffset = AlignUp(bufOffset, bufAlignment);
-
-                region.bufferOffset = bufOffset;
-                region.imageSubresource.aspectMask = VK_IMAGE_ASPECT_STENCIL_BIT;
-
-                bufOffset +=
-                    GetByteSize(extent.width, extent.height, extent.depth, VK_FORMAT_S8_UINT, 0);
-
-                stencilCopies.push_back(region);
-              }
-
-              // update the extent for the next mip
-              extent.width = RDCMAX(extent.width >> 1, 1U);
-              extent.height = RDCMAX(extent.height >> 1, 1U);
-              extent.depth = RDCMAX(extent.depth >> 1, 1U);
-            }
-          }
-
-          ObjDisp(cmd)->CmdCopyBufferToImage(Unwrap(cmd), Unwrap(uploadBuf), Unwrap(arrayIm),
-                                             VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
-                                             (uint32_t)mainCopies.size(), &mainCopies[0]);
-
-          if(!stencilCopies.empty())
-            ObjDisp(cmd)->CmdCopyBufferToImage(Unwrap(cmd), Unwrap(uploadBuf), Unwrap(arrayIm),
-                                               VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
-                                               (uint32_t)stencilCopies.size(), &stencilCopies[0]);
-
-          // once transfers complete, get ready for copy array->ms
-          dstimBarrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
-          dstimBarrier.newLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-          dstimBarrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
-          dstimBarrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
-
-          DoPipelineBarrier(cmd, 1, &dstimBarrier);
+          MemoryAllocation arrayMem;
+          VkImage arrayIm = CreateInitialContentsArrayImage(liveid, uploadBuf, cmd, arrayMem);
 
           vkr = ObjDisp(cmd)->EndCommandBuffer(Unwrap(cmd));
           RDCASSERTEQUAL(vkr, VK_SUCCESS);
 
           // INITSTATEBATCH
+          // submit the upload without waiting on it, so the GPU copies into the array image while
+          // the CPU reads and decompresses the next initial contents chunks. The staging buffer is
+          // destroyed once its batch's fence signals, and TrimQ() bounds how much staging memory
+          // can be outstanding without serialising against the GPU.
           SubmitCmds();
-          FlushQ();
 
-          // destroy the buffer as it's no longer needed.
-          vkDestroyBuffer(d, uploadBuf, NULL);
-          FreeMemoryAllocation(uploadMemory);
+          m_PendingUploadCleanups.push_back(make_rdcpair(uploadBuf, uploadMemory));
+
+          TrimQ(8);
+
+          m_InitStateResidentGPUBytes += arrayMem.size;
 
           initialContents.buf = VK_NULL_HANDLE;
           initialContents.img = arrayIm;
@@ -1407,6 +1572,17 @@ void WrappedVulkan::Apply_InitialState(WrappedVkRes *live, const VkInitialConten
       return;
     }
 
+    // if no subresource was modified during the frame then the contents from the previous replay
+    // are still valid, so there's nothing to restore - the same skip the device memory path makes
+    // below. Returning before recording any commands also avoids a pointless layout round-trip
+    // through TRANSFER_DST, since frame-start layouts are re-applied for every image after initial
+    // contents regardless of what we do here.
+    if(initialized && state->MaxInitReq(imageInfo.FullRange(), policy, initialized) == eInitReq_None)
+    {
+      RDCDEBUG("Apply_InitialState (Img %s): skipped", ToStr(orig).c_str());
+      return;
+    }
+
     // handle any 'created' initial states, without an actual image with contents
     if(initial.tag != VkInitialContents::BufferCopy)
     {
@@ -1504,6 +1680,13 @@ void WrappedVulkan::Apply_InitialState(WrappedVkRes *live, const VkInitialConten
       m_setupImageBarriers.Merge(setupBarriers);
 
       VkImage arrayIm = initial.img;
+      MemoryAllocation arrayMem;
+
+      // if this image was over the GPU initial contents budget its array image was never created -
+      // recreate it transiently from the host-visible upload buffer, and destroy it on the next
+      // FlushQ() once the GPU has consumed it.
+      if(arrayIm == VK_NULL_HANDLE)
+        arrayIm = CreateInitialContentsArrayImage(id, initial.buf, cmd, arrayMem);
 
       vkr = ObjDisp(cmd)->EndCommandBuffer(Unwrap(cmd));
       RDCASSERTEQUAL(vkr, VK_SUCCESS);
@@ -1512,6 +1695,9 @@ void WrappedVulkan::Apply_InitialState(WrappedVkRes *live, const VkInitialConten
                                             c.extent, (uint32_t)c.arrayLayers, (uint32_t)c.samples,
                                             fmt);
 
+      if(initial.img == VK_NULL_HANDLE)
+        m_PendingTransientArrayCleanups.push_back(make_rdcpair(arrayIm, arrayMem));
+
       cmd = GetNextCmd();
 
       vkr = ObjDisp(cmd)->BeginCommandBuffer(Unwrap(cmd), &beginInfo);
@@ -569,18 +569,35 @@ void VulkanResourceManager::MarkSparseMapReferenced(ResourceInfo *sparse)
     return;
   }
 
-  for(size_t i = 0; i < sparse->opaquemappings.size(); i++)
-    MarkMemoryFrameReferenced(GetResID(sparse->opaquemappings[i].memory),
-                              sparse->opaquemappings[i].memoryOffset,
-                              sparse->opaquemappings[i].size, eFrameRef_Read);
+  // sparse maps can reference thousands of tiny ranges, so accumulate them per memory object into
+  // flat arrays and apply each batch with a single pass over the interval map, rather than paying
+  // a map lookup and interval merge per range.
+  std::map<ResourceId, rdcarray<Intervals<FrameRefType>::RangeValue>> ranges;
+
+  for(auto it = sparse->opaquemappings.begin(); it != sparse->opaquemappings.end(); ++it)
+  {
+    if(it->value().memory == VK_NULL_HANDLE)
+      continue;
+
+    VkDeviceSize offset = it->value().memDelta + it->start();
+    VkDeviceSize size = RDCMIN(it->finish() - it->start(), UINT64_MAX - offset);
+    ranges[GetResID(it->value().memory)].push_back({offset, offset + size, eFrameRef_Read});
+  }
 
   for(int a = 0; a < NUM_VK_IMAGE_ASPECTS; a++)
   {
     VkDeviceSize totalSize =
         VkDeviceSize(sparse->imgdim.width) * sparse->imgdim.height * sparse->imgdim.depth;
     for(VkDeviceSize i = 0; sparse->pages[a] && i < totalSize; i++)
-      MarkMemoryFrameReferenced(GetResID(sparse->pages[a][i].first), 0, VK_WHOLE_SIZE,
-                                eFrameRef_Read);
+      ranges[GetResID(sparse->pages[a][i].first)].push_back({0, UINT64_MAX, eFrameRef_Read});
+  }
+
+  SCOPED_LOCK(m_Lock);
+
+  for(auto it = ranges.begin(); it != ranges.end(); ++it)
+  {
+    FrameRefType maxRef = MarkMemoryReferenced(m_MemFrameRefs, it->first, it->second);
+    MarkResourceFrameReferenced(it->first, maxRef, ComposeFrameRefsDisjoint);
   }
 }
 
@@ -822,24 +839,29 @@ void VulkanResourceManager::RecordBarriers(std::map<ResourceId, ImageState> &sta
 
 ResourceId VulkanResourceManager::GetFirstIDForHandle(uint64_t handle)
 {
-  for(auto it = m_CurrentResourceMap.begin(); it != m_CurrentResourceMap.end(); ++it)
+  for(ResourceShard &shard : m_CurrentResourceShards)
   {
-    WrappedVkRes *res = it->second;
+    SCOPED_LOCK(shard.lock);
 
-    if(!res)
-      continue;
-
-    if(IsDispatchableRes(res))
-    {
-      WrappedVkDispRes *disp = (WrappedVkDispRes *)res;
-      if(disp->real.handle == handle)
-        return IsReplayMode(m_State) ? GetOriginalID(disp->id) : disp->id;
-    }
-    else
+    for(auto it = shard.resources.begin(); it != shard.resources.end(); ++it)
     {
-      WrappedVkNonDispRes *nondisp = (WrappedVkNonDispRes *)res;
-      if(nondisp->real.handle == handle)
-        return IsReplayMode(m_State) ? GetOriginalID(nondisp->id) : nondisp->id;
+      WrappedVkRes *res = it->second;
+
+      if(!res)
+        continue;
+
+      if(IsDispatchableRes(res))
+      {
+        WrappedVkDispRes *disp = (WrappedVkDispRes *)res;
+        if(disp->real.handle == handle)
+          return IsReplayMode(m_State) ? GetOriginalID(disp->id) : disp->id;
+      }
+      else
+      {
+        WrappedVkNonDispRes *nondisp = (WrappedVkNonDispRes *)res;
+        if(nondisp->real.handle == handle)
+          return IsReplayMode(m_State) ? GetOriginalID(nondisp->id) : nondisp->id;
+      }
     }
   }
 
@@ -909,6 +931,12 @@ bool VulkanResourceManager::Prepare_InitialState(WrappedVkRes *res)
   return m_Core->Prepare_InitialState(res);
 }
 
+bool VulkanResourceManager::Hash_InitialState(ResourceId id, const VkInitialContents &initial,
+                                              uint64_t &hash)
+{
+  return m_Core->Hash_InitialState(id, initial, hash);
+}
+
 uint64_t VulkanResourceManager::GetSize_InitialState(ResourceId id, const VkInitialContents &initial)
 {
   return m_Core->GetSize_InitialState(id, initial);
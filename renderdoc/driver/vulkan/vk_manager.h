@@ -198,14 +198,18 @@ public:
     // we just have to leak ourselves.
     RDCASSERT(m_LiveResourceMap.empty());
     RDCASSERT(m_InitialContents.empty());
-    RDCASSERT(m_ResourceRecords.empty());
-    RDCASSERT(m_CurrentResourceMap.empty());
+    for(RecordShard &shard : m_RecordShards)
+      RDCASSERT(shard.records.empty());
+    for(ResourceShard &shard : m_CurrentResourceShards)
+      RDCASSERT(shard.resources.empty());
     RDCASSERT(m_WrapperMap.empty());
 
     m_LiveResourceMap.clear();
     m_InitialContents.clear();
-    m_ResourceRecords.clear();
-    m_CurrentResourceMap.clear();
+    for(RecordShard &shard : m_RecordShards)
+      shard.records.clear();
+    for(ResourceShard &shard : m_CurrentResourceShards)
+      shard.resources.clear();
     m_WrapperMap.clear();
   }
 
@@ -453,6 +457,7 @@ private:
   bool ResourceTypeRelease(WrappedVkRes *res);
 
   bool Prepare_InitialState(WrappedVkRes *res);
+  bool Hash_InitialState(ResourceId id, const VkInitialContents &initial, uint64_t &hash);
   uint64_t GetSize_InitialState(ResourceId id, const VkInitialContents &initial);
   bool Serialise_InitialState(WriteSerialiser &ser, ResourceId id, VkResourceRecord *record,
                               const VkInitialContents *initial);
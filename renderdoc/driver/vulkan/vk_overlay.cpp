@@ -200,8 +200,8 @@ struct VulkanQuadOverdrawCallback : public VulkanDrawcallCallback
         sh.pSpecializationInfo = NULL;
       }
 
-      vkr = m_pDriver->vkCreateGraphicsPipelines(dev, VK_NULL_HANDLE, 1, &pipeCreateInfo, NULL,
-                                                 &pipe.pipe);
+      vkr = m_pDriver->vkCreateGraphicsPipelines(dev, m_pDriver->GetShaderCache()->GetPipeCache(),
+                                                 1, &pipeCreateInfo, NULL, &pipe.pipe);
       RDCASSERTEQUAL(vkr, VK_SUCCESS);
 
       m_pDriver->vkDestroyShaderModule(dev, module, NULL);
@@ -386,7 +386,7 @@ void VulkanDebugManager::PatchFixedColShader(VkShaderModule &mod, float col[4])
 }
 
 void VulkanDebugManager::PatchLineStripIndexBuffer(const DrawcallDescription *draw,
-                                                   GPUBuffer &indexBuffer, uint32_t &indexCount)
+                                                   uint32_t &indexCount)
 {
   VulkanRenderState &rs = m_pDriver->m_RenderState;
 
@@ -415,16 +415,24 @@ void VulkanDebugManager::PatchLineStripIndexBuffer(const DrawcallDescription *dr
 
   ::PatchLineStripIndexBuffer(draw, idx8, idx16, idx32, patchedIndices);
 
-  indexBuffer.Create(m_pDriver, m_Device, patchedIndices.size() * sizeof(uint32_t), 1,
-                     GPUBuffer::eGPUBufferIBuffer);
+  // resize up on demand. Overlay renders are submitted and flushed before the next one starts, so
+  // the previous buffer is idle by the time we re-use or recreate it here.
+  if(m_PatchedIBSize < patchedIndices.size() * sizeof(uint32_t))
+  {
+    m_PatchedIB.Destroy();
+
+    m_PatchedIBSize = patchedIndices.size() * sizeof(uint32_t);
+
+    m_PatchedIB.Create(m_pDriver, m_Device, m_PatchedIBSize, 1, GPUBuffer::eGPUBufferIBuffer);
+  }
 
-  void *ptr = indexBuffer.Map(0, patchedIndices.size() * sizeof(uint32_t));
+  void *ptr = m_PatchedIB.Map(0, patchedIndices.size() * sizeof(uint32_t));
   memcpy(ptr, patchedIndices.data(), patchedIndices.size() * sizeof(uint32_t));
-  indexBuffer.Unmap();
+  m_PatchedIB.Unmap();
 
   rs.ibuffer.offs = 0;
   rs.ibuffer.bytewidth = 4;
-  rs.ibuffer.buf = GetResID(indexBuffer.buf);
+  rs.ibuffer.buf = GetResID(m_PatchedIB.buf);
 
   VkBufferMemoryBarrier uploadbarrier = {
       VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER,
@@ -433,9 +441,9 @@ void VulkanDebugManager::PatchLineStripIndexBuffer(const DrawcallDescription *dr
       VK_ACCESS_INDEX_READ_BIT,
       VK_QUEUE_FAMILY_IGNORED,
       VK_QUEUE_FAMILY_IGNORED,
-      Unwrap(indexBuffer.buf),
+      Unwrap(m_PatchedIB.buf),
       0,
-      indexBuffer.totalsize,
+      m_PatchedIB.totalsize,
   };
 
   VkCommandBuffer cmd = m_pDriver->GetNextCmd();
@@ -476,6 +484,17 @@ ResourceId VulkanReplay::RenderOverlay(ResourceId texid, const Subresource &sub,
       return GetResID(m_Overlay.Image);
   }
 
+  // the overlay image is only written here, so if the same overlay was last rendered for the same
+  // event and target and no replay has happened since, the image still holds the right result and
+  // we can skip re-executing the overlay pass.
+  if(m_Overlay.CacheValid && m_Overlay.Image != VK_NULL_HANDLE &&
+     m_Overlay.CachedEventId == eventId && m_Overlay.CachedOverlay == overlay &&
+     m_Overlay.CachedTexId == texid && m_Overlay.CachedSub == sub &&
+     m_Overlay.CachedTypeCast == typeCast && m_Overlay.CachedClearCol == clearCol)
+    return GetResID(m_Overlay.Image);
+
+  m_Overlay.CacheValid = false;
+
   VkCommandBuffer cmd = m_pDriver->GetNextCmd();
 
   VkCommandBufferBeginInfo beginInfo = {VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO, NULL,
@@ -800,7 +819,6 @@ ResourceId VulkanReplay::RenderOverlay(ResourceId texid, const Subresource &sub,
     }
 
     uint32_t patchedIndexCount = 0;
-    GPUBuffer patchedIB;
 
     if(overlay == DebugOverlay::Wireframe)
     {
@@ -836,7 +854,7 @@ ResourceId VulkanReplay::RenderOverlay(ResourceId texid, const Subresource &sub,
         // three lines, instead we have a single restart index after each triangle.
         ia->primitiveRestartEnable = true;
 
-        GetDebugManager()->PatchLineStripIndexBuffer(mainDraw, patchedIB, patchedIndexCount);
+        GetDebugManager()->PatchLineStripIndexBuffer(mainDraw, patchedIndexCount);
       }
       else
       {
@@ -902,8 +920,9 @@ ResourceId VulkanReplay::RenderOverlay(ResourceId texid, const Subresource &sub,
 
     VkPipeline pipe = VK_NULL_HANDLE;
 
-    vkr = m_pDriver->vkCreateGraphicsPipelines(m_Device, VK_NULL_HANDLE, 1, &pipeCreateInfo, NULL,
-                                               &pipe);
+    vkr = m_pDriver->vkCreateGraphicsPipelines(m_Device,
+                                               m_pDriver->GetShaderCache()->GetPipeCache(), 1,
+                                               &pipeCreateInfo, NULL, &pipe);
     RDCASSERTEQUAL(vkr, VK_SUCCESS);
 
     // modify state
@@ -964,8 +983,6 @@ ResourceId VulkanReplay::RenderOverlay(ResourceId texid, const Subresource &sub,
     // restore state
     m_pDriver->m_RenderState = prevstate;
 
-    patchedIB.Destroy();
-
     m_pDriver->vkDestroyPipeline(m_Device, pipe, NULL);
     m_pDriver->vkDestroyShaderModule(m_Device, mod, NULL);
   }
@@ -1238,15 +1255,17 @@ ResourceId VulkanReplay::RenderOverlay(ResourceId texid, const Subresource &sub,
     vkr = vt->EndCommandBuffer(Unwrap(cmd));
     RDCASSERTEQUAL(vkr, VK_SUCCESS);
 
-    vkr = m_pDriver->vkCreateGraphicsPipelines(m_Device, VK_NULL_HANDLE, 1, &pipeCreateInfo, NULL,
-                                               &pipe[0]);
+    vkr = m_pDriver->vkCreateGraphicsPipelines(m_Device,
+                                               m_pDriver->GetShaderCache()->GetPipeCache(), 1,
+                                               &pipeCreateInfo, NULL, &pipe[0]);
     RDCASSERTEQUAL(vkr, VK_SUCCESS);
 
     fragShader->module = mod[1];
     rs->cullMode = origCullMode;
 
-    vkr = m_pDriver->vkCreateGraphicsPipelines(m_Device, VK_NULL_HANDLE, 1, &pipeCreateInfo, NULL,
-                                               &pipe[1]);
+    vkr = m_pDriver->vkCreateGraphicsPipelines(m_Device,
+                                               m_pDriver->GetShaderCache()->GetPipeCache(), 1,
+                                               &pipeCreateInfo, NULL, &pipe[1]);
     RDCASSERTEQUAL(vkr, VK_SUCCESS);
 
     // modify state
@@ -1521,8 +1540,9 @@ ResourceId VulkanReplay::RenderOverlay(ResourceId texid, const Subresource &sub,
       pipeCreateInfo.renderPass = m_Overlay.NoDepthRP;
     }
 
-    vkr = m_pDriver->vkCreateGraphicsPipelines(m_Device, VK_NULL_HANDLE, 1, &pipeCreateInfo, NULL,
-                                               &passpipe);
+    vkr = m_pDriver->vkCreateGraphicsPipelines(m_Device,
+                                               m_pDriver->GetShaderCache()->GetPipeCache(), 1,
+                                               &pipeCreateInfo, NULL, &passpipe);
     RDCASSERTEQUAL(vkr, VK_SUCCESS);
 
     fragShader->module = failmod;
@@ -1539,8 +1559,9 @@ ResourceId VulkanReplay::RenderOverlay(ResourceId texid, const Subresource &sub,
     if(m_pDriver->GetDeviceFeatures().depthClamp)
       rs->depthClampEnable = true;
 
-    vkr = m_pDriver->vkCreateGraphicsPipelines(m_Device, VK_NULL_HANDLE, 1, &pipeCreateInfo, NULL,
-                                               &failpipe);
+    vkr = m_pDriver->vkCreateGraphicsPipelines(m_Device,
+                                               m_pDriver->GetShaderCache()->GetPipeCache(), 1,
+                                               &pipeCreateInfo, NULL, &failpipe);
     RDCASSERTEQUAL(vkr, VK_SUCCESS);
 
     // modify state
@@ -2321,8 +2342,9 @@ ResourceId VulkanReplay::RenderOverlay(ResourceId texid, const Subresource &sub,
 
             if(pipe == VK_NULL_HANDLE)
             {
-              vkr = m_pDriver->vkCreateGraphicsPipelines(m_Device, VK_NULL_HANDLE, 1,
-                                                         &pipeCreateInfo, NULL, &pipe);
+              vkr = m_pDriver->vkCreateGraphicsPipelines(
+                  m_Device, m_pDriver->GetShaderCache()->GetPipeCache(), 1, &pipeCreateInfo, NULL,
+                  &pipe);
               RDCASSERTEQUAL(vkr, VK_SUCCESS);
             }
 
@@ -2455,5 +2477,13 @@ ResourceId VulkanReplay::RenderOverlay(ResourceId texid, const Subresource &sub,
   m_pDriver->SubmitCmds();
 #endif
 
+  m_Overlay.CacheValid = true;
+  m_Overlay.CachedEventId = eventId;
+  m_Overlay.CachedOverlay = overlay;
+  m_Overlay.CachedTexId = texid;
+  m_Overlay.CachedSub = sub;
+  m_Overlay.CachedTypeCast = typeCast;
+  m_Overlay.CachedClearCol = clearCol;
+
   return GetResID(m_Overlay.Image);
 }
@@ -23,6 +23,7 @@
  ******************************************************************************/
 
 #include <float.h>
+#include <algorithm>
 #include "driver/shaders/spirv/spirv_editor.h"
 #include "driver/shaders/spirv/spirv_op_helpers.h"
 #include "maths/formatpacking.h"
@@ -38,6 +39,14 @@ bool isDirectWrite(ResourceUsage usage)
           usage == ResourceUsage::GenMips);
 }
 
+// the callbacks are queried for every event in the frame during replay, so when the pixel has a
+// long history a linear scan of the candidate event list for each draw adds up. The event lists
+// are built in eventId order, so binary search them.
+static bool ContainsEvent(const rdcarray<uint32_t> &events, uint32_t eid)
+{
+  return std::binary_search(events.begin(), events.end(), eid);
+}
+
 enum
 {
   TestEnabled_Culling = 1 << 0,
@@ -836,7 +845,7 @@ struct VulkanOcclusionCallback : public VulkanPixelHistoryCallback
 
   void PreDraw(uint32_t eid, VkCommandBuffer cmd)
   {
-    if(!m_Events.contains(eid))
+    if(!ContainsEvent(m_Events, eid))
       return;
     VulkanRenderState prevState = m_pDriver->GetCmdRenderState();
     VulkanRenderState &pipestate = m_pDriver->GetCmdRenderState();
@@ -963,8 +972,9 @@ private:
       }
     }
     VkPipeline pipe;
-    VkResult vkr = m_pDriver->vkCreateGraphicsPipelines(m_pDriver->GetDev(), VK_NULL_HANDLE, 1,
-                                                        &pipeCreateInfo, NULL, &pipe);
+    VkResult vkr = m_pDriver->vkCreateGraphicsPipelines(
+        m_pDriver->GetDev(), m_pDriver->GetShaderCache()->GetPipeCache(), 1, &pipeCreateInfo, NULL,
+        &pipe);
     RDCASSERTEQUAL(vkr, VK_SUCCESS);
     m_PipeCache.insert(std::make_pair(pipeline, pipe));
     return pipe;
@@ -998,7 +1008,7 @@ struct VulkanColorAndStencilCallback : public VulkanPixelHistoryCallback
 
   void PreDraw(uint32_t eid, VkCommandBuffer cmd)
   {
-    if(!m_Events.contains(eid) || !m_pDriver->IsCmdPrimary())
+    if(!ContainsEvent(m_Events, eid) || !m_pDriver->IsCmdPrimary())
       return;
 
     // TODO: can't end renderpass if we are not on the last subpass.
@@ -1095,7 +1105,7 @@ struct VulkanColorAndStencilCallback : public VulkanPixelHistoryCallback
 
   bool PostDraw(uint32_t eid, VkCommandBuffer cmd)
   {
-    if(!m_Events.contains(eid) || !m_pDriver->IsCmdPrimary())
+    if(!ContainsEvent(m_Events, eid) || !m_pDriver->IsCmdPrimary())
       return false;
 
     m_pDriver->GetCmdRenderState().EndRenderPass(cmd);
@@ -1196,7 +1206,7 @@ struct VulkanColorAndStencilCallback : public VulkanPixelHistoryCallback
 
   void PreDispatch(uint32_t eid, VkCommandBuffer cmd)
   {
-    if(!m_Events.contains(eid))
+    if(!ContainsEvent(m_Events, eid))
       return;
 
     size_t storeOffset = m_EventIndices.size() * sizeof(EventInfo);
@@ -1205,7 +1215,7 @@ struct VulkanColorAndStencilCallback : public VulkanPixelHistoryCallback
   }
   bool PostDispatch(uint32_t eid, VkCommandBuffer cmd)
   {
-    if(!m_Events.contains(eid))
+    if(!ContainsEvent(m_Events, eid))
       return false;
 
     size_t storeOffset = m_EventIndices.size() * sizeof(EventInfo);
@@ -1218,7 +1228,7 @@ struct VulkanColorAndStencilCallback : public VulkanPixelHistoryCallback
   void PreMisc(uint32_t eid, DrawFlags flags, VkCommandBuffer cmd) { PreDispatch(eid, cmd); }
   bool PostMisc(uint32_t eid, DrawFlags flags, VkCommandBuffer cmd)
   {
-    if(!m_Events.contains(eid))
+    if(!ContainsEvent(m_Events, eid))
       return false;
     if(flags & DrawFlags::BeginPass)
       m_pDriver->GetCmdRenderState().EndRenderPass(cmd);
@@ -1343,9 +1353,9 @@ private:
     }
 
     PipelineReplacements replacements = {};
-    VkResult vkr = m_pDriver->vkCreateGraphicsPipelines(m_pDriver->GetDev(), VK_NULL_HANDLE, 1,
-                                                        &pipeCreateInfo, NULL,
-                                                        &replacements.originalShaderStencil);
+    VkResult vkr = m_pDriver->vkCreateGraphicsPipelines(
+        m_pDriver->GetDev(), m_pDriver->GetShaderCache()->GetPipeCache(), 1, &pipeCreateInfo, NULL,
+        &replacements.originalShaderStencil);
     RDCASSERTEQUAL(vkr, VK_SUCCESS);
 
     for(uint32_t i = 0; i < pipeCreateInfo.stageCount; i++)
@@ -1358,7 +1368,8 @@ private:
       }
     }
 
-    vkr = m_pDriver->vkCreateGraphicsPipelines(m_pDriver->GetDev(), VK_NULL_HANDLE, 1,
+    vkr = m_pDriver->vkCreateGraphicsPipelines(m_pDriver->GetDev(),
+                                               m_pDriver->GetShaderCache()->GetPipeCache(), 1,
                                                &pipeCreateInfo, NULL,
                                                &replacements.fixedShaderStencil);
     RDCASSERTEQUAL(vkr, VK_SUCCESS);
@@ -1388,7 +1399,7 @@ struct TestsFailedCallback : public VulkanPixelHistoryCallback
   ~TestsFailedCallback() {}
   void PreDraw(uint32_t eid, VkCommandBuffer cmd)
   {
-    if(!m_Events.contains(eid))
+    if(!ContainsEvent(m_Events, eid))
       return;
 
     VulkanRenderState &pipestate = m_pDriver->GetCmdRenderState();
@@ -1818,8 +1829,8 @@ private:
     }
 
     VkPipeline pipe;
-    VkResult vkr = m_pDriver->vkCreateGraphicsPipelines(m_pDriver->GetDev(), VK_NULL_HANDLE, 1, &ci,
-                                                        NULL, &pipe);
+    VkResult vkr = m_pDriver->vkCreateGraphicsPipelines(
+        m_pDriver->GetDev(), m_pDriver->GetShaderCache()->GetPipeCache(), 1, &ci, NULL, &pipe);
     RDCASSERTEQUAL(vkr, VK_SUCCESS);
     m_PipeCache.insert(std::make_pair(pipeKey, pipe));
     return pipe;
@@ -2179,8 +2190,9 @@ struct VulkanPixelHistoryPerFragmentCallback : VulkanPixelHistoryCallback
     }
 
     Pipelines pipes = {};
-    VkResult vkr = m_pDriver->vkCreateGraphicsPipelines(m_pDriver->GetDev(), VK_NULL_HANDLE, 1,
-                                                        &pipeCreateInfo, NULL, &pipes.postModPipe);
+    VkResult vkr = m_pDriver->vkCreateGraphicsPipelines(
+        m_pDriver->GetDev(), m_pDriver->GetShaderCache()->GetPipeCache(), 1, &pipeCreateInfo, NULL,
+        &pipes.postModPipe);
     RDCASSERTEQUAL(vkr, VK_SUCCESS);
     m_PipesToDestroy.push_back(pipes.postModPipe);
 
@@ -2216,7 +2228,8 @@ struct VulkanPixelHistoryPerFragmentCallback : VulkanPixelHistoryCallback
       }
     }
 
-    vkr = m_pDriver->vkCreateGraphicsPipelines(m_pDriver->GetDev(), VK_NULL_HANDLE, 1,
+    vkr = m_pDriver->vkCreateGraphicsPipelines(m_pDriver->GetDev(),
+                                               m_pDriver->GetShaderCache()->GetPipeCache(), 1,
                                                &pipeCreateInfo, NULL, &pipes.shaderOutPipe);
     RDCASSERTEQUAL(vkr, VK_SUCCESS);
 
@@ -2250,7 +2263,8 @@ struct VulkanPixelHistoryPerFragmentCallback : VulkanPixelHistoryCallback
       pipeCreateInfo.pStages = stages.data();
     }
 
-    vkr = m_pDriver->vkCreateGraphicsPipelines(m_pDriver->GetDev(), VK_NULL_HANDLE, 1,
+    vkr = m_pDriver->vkCreateGraphicsPipelines(m_pDriver->GetDev(),
+                                               m_pDriver->GetShaderCache()->GetPipeCache(), 1,
                                                &pipeCreateInfo, NULL, &pipes.primitiveIdPipe);
     RDCASSERTEQUAL(vkr, VK_SUCCESS);
     m_PipesToDestroy.push_back(pipes.primitiveIdPipe);
@@ -2379,8 +2393,9 @@ struct VulkanPixelHistoryDiscardedFragmentsCallback : VulkanPixelHistoryCallback
     }
 
     VkPipeline newPipe;
-    VkResult vkr = m_pDriver->vkCreateGraphicsPipelines(m_pDriver->GetDev(), VK_NULL_HANDLE, 1,
-                                                        &pipeCreateInfo, NULL, &newPipe);
+    VkResult vkr = m_pDriver->vkCreateGraphicsPipelines(
+        m_pDriver->GetDev(), m_pDriver->GetShaderCache()->GetPipeCache(), 1, &pipeCreateInfo, NULL,
+        &newPipe);
     RDCASSERTEQUAL(vkr, VK_SUCCESS);
     m_PipesToDestroy.push_back(newPipe);
     return newPipe;
@@ -2868,15 +2883,7 @@ rdcarray<PixelModification> VulkanReplay::PixelHistory(rdcarray<EventUsage> even
   VkQueryPool occlusionPool;
   CreateOcclusionPool(m_pDriver, (uint32_t)events.size(), &occlusionPool);
 
-  PixelHistoryResources resources = {};
-  // TODO: perhaps should do this after making an occlusion query, since we will
-  // get a smaller subset of events that passed the occlusion query.
   VkImage targetImage = GetResourceManager()->GetCurrentHandle<VkImage>(target);
-  GetDebugManager()->PixelHistorySetupResources(resources, targetImage, imginfo.extent,
-                                                imginfo.format, imginfo.samples, sub,
-                                                (uint32_t)events.size());
-  if(multisampled)
-    UpdatePixelHistoryDescriptor(resources.targetImageView, resources.stagingImageView);
 
   PixelHistoryShaderCache *shaderCache = new PixelHistoryShaderCache(m_pDriver);
 
@@ -2891,14 +2898,9 @@ rdcarray<PixelModification> VulkanReplay::PixelHistory(rdcarray<EventUsage> even
   callbackInfo.x = x;
   callbackInfo.y = y;
   callbackInfo.sampleMask = sampleMask;
-  callbackInfo.subImage = resources.colorImage;
-  callbackInfo.subImageView = resources.colorImageView;
-  callbackInfo.stencilImage = resources.stencilImage;
-  callbackInfo.stencilImageView = resources.stencilImageView;
-  callbackInfo.dstBuffer = resources.dstBuffer;
-  callbackInfo.stagingImage = resources.stagingImage;
-  callbackInfo.stencilStagingImage = resources.stencilStagingImage;
 
+  // the occlusion query pass only needs the target image, so run it before creating the readback
+  // resources - that way if it culls every event we never pay for them at all.
   VulkanOcclusionCallback occlCb(m_pDriver, shaderCache, callbackInfo, occlusionPool, events);
   m_pDriver->ReplayLog(0, events.back().eventId, eReplay_Full);
   m_pDriver->SubmitCmds();
@@ -2934,6 +2936,32 @@ rdcarray<PixelModification> VulkanReplay::PixelHistory(rdcarray<EventUsage> even
     }
   }
 
+  if(modEvents.empty())
+  {
+    // if no event touched the pixel there is no history to gather, so don't pay for any of the
+    // remaining replay passes
+    ObjDisp(dev)->DestroyQueryPool(Unwrap(dev), occlusionPool, NULL);
+    delete shaderCache;
+    return history;
+  }
+
+  PixelHistoryResources resources = {};
+  // the readback buffer is still sized for all candidate events rather than just the surviving
+  // ones, since the per-fragment pass later re-uses it with one entry per fragment.
+  GetDebugManager()->PixelHistorySetupResources(resources, targetImage, imginfo.extent,
+                                                imginfo.format, imginfo.samples, sub,
+                                                (uint32_t)events.size());
+  if(multisampled)
+    UpdatePixelHistoryDescriptor(resources.targetImageView, resources.stagingImageView);
+
+  callbackInfo.subImage = resources.colorImage;
+  callbackInfo.subImageView = resources.colorImageView;
+  callbackInfo.stencilImage = resources.stencilImage;
+  callbackInfo.stencilImageView = resources.stencilImageView;
+  callbackInfo.dstBuffer = resources.dstBuffer;
+  callbackInfo.stagingImage = resources.stagingImage;
+  callbackInfo.stencilStagingImage = resources.stencilStagingImage;
+
   VulkanColorAndStencilCallback cb(m_pDriver, shaderCache, callbackInfo, modEvents);
   m_pDriver->ReplayLog(0, events.back().eventId, eReplay_Full);
   m_pDriver->SubmitCmds();
@@ -2960,7 +2988,7 @@ rdcarray<PixelModification> VulkanReplay::PixelHistory(rdcarray<EventUsage> even
     uint32_t eventId = events[ev].eventId;
     bool clear = (events[ev].usage == ResourceUsage::Clear);
     bool directWrite = isDirectWrite(events[ev].usage);
-    if(drawEvents.contains(events[ev].eventId) || clear || directWrite)
+    if(ContainsEvent(drawEvents, events[ev].eventId) || clear || directWrite)
     {
       PixelModification mod;
       RDCEraseEl(mod);
@@ -3138,3 +3166,10 @@ rdcarray<PixelModification> VulkanReplay::PixelHistory(rdcarray<EventUsage> even
 
   return history;
 }
+
+rdcarray<rdcarray<PixelModification>> VulkanReplay::PixelHistoryRegion(
+    rdcarray<EventUsage> events, ResourceId target, uint32_t x, uint32_t y, uint32_t width,
+    uint32_t height, const Subresource &sub, CompType typeCast)
+{
+  return StandardPixelHistoryRegion(this, events, target, x, y, width, height, sub, typeCast);
+}
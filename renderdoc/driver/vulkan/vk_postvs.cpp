@@ -25,6 +25,7 @@
 #include <float.h>
 #include <math.h>
 #include <algorithm>
+#include "core/settings.h"
 #include "driver/shaders/spirv/spirv_editor.h"
 #include "driver/shaders/spirv/spirv_op_helpers.h"
 #include "vk_core.h"
@@ -34,6 +35,10 @@
 
 #undef None
 
+RDOC_CONFIG(uint32_t, Vulkan_PostVSCacheBudgetMB, 1024,
+            "Budget in MB for post-VS geometry data kept resident on the GPU. Once over budget "
+            "the least recently used draws are evicted, and re-fetched on demand.");
+
 struct VkXfbQueryResult
 {
   uint64_t numPrimitivesWritten;
@@ -1196,28 +1201,119 @@ static void ConvertToMeshOutputCompute(const ShaderReflection &refl, const SPIRV
   }
 }
 
+static void DestroyPostVSBuffers(WrappedVulkan *driver, VkDevice dev, VulkanPostVSData &data)
+{
+  if(data.vsout.idxbuf != VK_NULL_HANDLE)
+  {
+    driver->vkDestroyBuffer(dev, data.vsout.idxbuf, NULL);
+    driver->vkFreeMemory(dev, data.vsout.idxbufmem, NULL);
+  }
+  driver->vkDestroyBuffer(dev, data.vsout.buf, NULL);
+  driver->vkFreeMemory(dev, data.vsout.bufmem, NULL);
+
+  if(data.gsout.buf != VK_NULL_HANDLE)
+  {
+    driver->vkDestroyBuffer(dev, data.gsout.buf, NULL);
+    driver->vkFreeMemory(dev, data.gsout.bufmem, NULL);
+  }
+}
+
 void VulkanReplay::ClearPostVSCache()
 {
   VkDevice dev = m_Device;
 
   for(auto it = m_PostVS.Data.begin(); it != m_PostVS.Data.end(); ++it)
+    DestroyPostVSBuffers(m_pDriver, dev, it->second);
+
+  m_PostVS.Data.clear();
+  m_PostVS.UsageOrder.clear();
+  m_PostVS.TotalBytes = 0;
+}
+
+void VulkanReplay::InvalidatePostVSForPipelines(const rdcarray<ResourceId> &pipes)
+{
+  VkDevice dev = m_Device;
+
+  for(auto it = m_PostVS.Data.begin(); it != m_PostVS.Data.end();)
+  {
+    if(pipes.contains(it->second.pipe))
+    {
+      DestroyPostVSBuffers(m_pDriver, dev, it->second);
+
+      m_PostVS.TotalBytes -= it->second.totalBytes;
+      m_PostVS.UsageOrder.removeOne(it->first);
+
+      it = m_PostVS.Data.erase(it);
+    }
+    else
+    {
+      ++it;
+    }
+  }
+}
+
+void VulkanReplay::TrimPostVSCache(uint32_t eventId)
+{
+  VkDevice dev = m_Device;
+
+  auto entry = m_PostVS.Data.find(eventId);
+
+  if(entry == m_PostVS.Data.end())
+    return;
+
+  VulkanPostVSData &data = entry->second;
+
+  // account the entry against the budget the first time we see it
+  if(!m_PostVS.UsageOrder.contains(eventId))
   {
-    if(it->second.vsout.idxbuf != VK_NULL_HANDLE)
+    VkMemoryRequirements mrq = {};
+
+    if(data.vsout.buf != VK_NULL_HANDLE)
+    {
+      m_pDriver->vkGetBufferMemoryRequirements(dev, data.vsout.buf, &mrq);
+      data.totalBytes += mrq.size;
+    }
+
+    if(data.vsout.idxbuf != VK_NULL_HANDLE)
     {
-      m_pDriver->vkDestroyBuffer(dev, it->second.vsout.idxbuf, NULL);
-      m_pDriver->vkFreeMemory(dev, it->second.vsout.idxbufmem, NULL);
+      m_pDriver->vkGetBufferMemoryRequirements(dev, data.vsout.idxbuf, &mrq);
+      data.totalBytes += mrq.size;
     }
-    m_pDriver->vkDestroyBuffer(dev, it->second.vsout.buf, NULL);
-    m_pDriver->vkFreeMemory(dev, it->second.vsout.bufmem, NULL);
 
-    if(it->second.gsout.buf != VK_NULL_HANDLE)
+    if(data.gsout.buf != VK_NULL_HANDLE)
     {
-      m_pDriver->vkDestroyBuffer(dev, it->second.gsout.buf, NULL);
-      m_pDriver->vkFreeMemory(dev, it->second.gsout.bufmem, NULL);
+      m_pDriver->vkGetBufferMemoryRequirements(dev, data.gsout.buf, &mrq);
+      data.totalBytes += mrq.size;
     }
+
+    m_PostVS.TotalBytes += data.totalBytes;
   }
 
-  m_PostVS.Data.clear();
+  // mark as most recently used
+  m_PostVS.UsageOrder.removeOne(eventId);
+  m_PostVS.UsageOrder.push_back(eventId);
+
+  const uint64_t budget = uint64_t(Vulkan_PostVSCacheBudgetMB) * 1024 * 1024;
+
+  // evict least recently used entries until we're back under budget. Evicted draws are re-fetched
+  // on demand if they're selected again. The entry just used always stays resident, even if it's
+  // over budget on its own.
+  while(m_PostVS.TotalBytes > budget && m_PostVS.UsageOrder.size() > 1)
+  {
+    uint32_t evict = m_PostVS.UsageOrder[0];
+
+    auto it = m_PostVS.Data.find(evict);
+
+    if(it != m_PostVS.Data.end())
+    {
+      DestroyPostVSBuffers(m_pDriver, dev, it->second);
+
+      m_PostVS.TotalBytes -= it->second.totalBytes;
+      m_PostVS.Data.erase(it);
+    }
+
+    m_PostVS.UsageOrder.erase(0);
+  }
 }
 
 void VulkanReplay::PatchReservedDescriptors(const VulkanStatePipeline &pipe,
@@ -2359,7 +2455,8 @@ void VulkanReplay::FetchVSOut(uint32_t eventId, VulkanRenderState &state)
 
   // create new pipeline
   VkPipeline pipe;
-  vkr = m_pDriver->vkCreateComputePipelines(m_Device, VK_NULL_HANDLE, 1, &compPipeInfo, NULL, &pipe);
+  vkr = m_pDriver->vkCreateComputePipelines(m_Device, m_pDriver->GetShaderCache()->GetPipeCache(),
+                                            1, &compPipeInfo, NULL, &pipe);
 
   if(vkr != VK_SUCCESS)
   {
@@ -2851,8 +2948,8 @@ void VulkanReplay::FetchTessGSOut(uint32_t eventId, VulkanRenderState &state)
   pipeCreateInfo.subpass = 0;
 
   VkPipeline pipe = VK_NULL_HANDLE;
-  vkr = m_pDriver->vkCreateGraphicsPipelines(m_Device, VK_NULL_HANDLE, 1, &pipeCreateInfo, NULL,
-                                             &pipe);
+  vkr = m_pDriver->vkCreateGraphicsPipelines(m_Device, m_pDriver->GetShaderCache()->GetPipeCache(),
+                                             1, &pipeCreateInfo, NULL, &pipe);
   RDCASSERTEQUAL(vkr, VK_SUCCESS);
 
   state.graphics.pipeline = GetResID(pipe);
@@ -3244,18 +3341,33 @@ void VulkanReplay::InitPostVSBuffers(uint32_t eventId, VulkanRenderState &state)
 
   VulkanCreationInfo &creationInfo = m_pDriver->m_CreationInfo;
 
+  // on the early-out paths below we insert a default entry, so that this event counts as fetched
+  // when checking whether a whole pass is cached - the same checks would just fail again.
   if(state.graphics.pipeline == ResourceId() || state.renderPass == ResourceId())
+  {
+    m_PostVS.Data.insert(std::make_pair(eventId, VulkanPostVSData()));
     return;
+  }
 
   const VulkanCreationInfo::Pipeline &pipeInfo = creationInfo.m_Pipeline[state.graphics.pipeline];
 
   if(pipeInfo.shaders[0].module == ResourceId())
+  {
+    m_PostVS.Data[eventId].pipe = state.graphics.pipeline;
     return;
+  }
 
   const DrawcallDescription *drawcall = m_pDriver->GetDrawcall(eventId);
 
   if(drawcall == NULL || drawcall->numIndices == 0 || drawcall->numInstances == 0)
+  {
+    m_PostVS.Data[eventId].pipe = state.graphics.pipeline;
     return;
+  }
+
+  // tag the entry with the pipeline it's fetched with, so that editing one of the pipeline's
+  // shaders invalidates just this entry rather than the whole cache
+  m_PostVS.Data[eventId].pipe = state.graphics.pipeline;
 
   VkMarkerRegion::Begin(StringFormat::Fmt("FetchVSOut for %u", eventId));
 
@@ -3265,18 +3377,80 @@ void VulkanReplay::InitPostVSBuffers(uint32_t eventId, VulkanRenderState &state)
 
   // if there's no tessellation or geometry shader active, bail out now
   if(pipeInfo.shaders[2].module == ResourceId() && pipeInfo.shaders[3].module == ResourceId())
+  {
+    TrimPostVSCache(eventId);
     return;
+  }
 
   VkMarkerRegion::Begin(StringFormat::Fmt("FetchTessGSOut for %u", eventId));
 
   FetchTessGSOut(eventId, state);
 
   VkMarkerRegion::End();
+
+  TrimPostVSCache(eventId);
 }
 
 void VulkanReplay::InitPostVSBuffers(uint32_t eventId)
 {
-  InitPostVSBuffers(eventId, m_pDriver->GetRenderState());
+  // go through any aliasing
+  uint32_t cacheEventId = eventId;
+  if(m_PostVS.Alias.find(eventId) != m_PostVS.Alias.end())
+    cacheEventId = m_PostVS.Alias[eventId];
+
+  if(m_PostVS.Data.find(cacheEventId) != m_PostVS.Data.end())
+    return;
+
+  // fetch the whole pass in one instrumented replay rather than just this draw, so that selecting
+  // other draws in the same pass hits the cache instead of re-running the fetch per draw.
+  rdcarray<uint32_t> passEvents = GetPassEvents(eventId);
+
+  passEvents.push_back(eventId);
+
+  // GetPassEvents only returns events before the one specified, so walk forwards collecting the
+  // rest of the pass as well. As in GetPassEvents, vkCmdNextSubpass has both Begin and End flags
+  // set so this stays within the current subpass.
+  const DrawcallDescription *draw = m_pDriver->GetDrawcall(eventId);
+
+  if(draw)
+  {
+    draw = draw->next;
+
+    while(draw)
+    {
+      if(draw->flags & (DrawFlags::BeginPass | DrawFlags::EndPass))
+        break;
+
+      if(draw->flags & DrawFlags::Drawcall)
+        passEvents.push_back(draw->eventId);
+
+      draw = draw->next;
+    }
+  }
+
+  // the list contains pass boundary events too, only the actual draws matter - a batched replay
+  // is pure overhead if this is the only draw in the pass.
+  size_t numDraws = 0;
+
+  for(uint32_t eid : passEvents)
+  {
+    draw = m_pDriver->GetDrawcall(eid);
+
+    if(draw && (draw->flags & DrawFlags::Drawcall))
+      numDraws++;
+  }
+
+  if(numDraws > 1)
+  {
+    InitPostVSBuffers(passEvents);
+
+    // the batched fetch replayed to the end of the pass, restore the state the caller expects
+    m_pDriver->ReplayLog(0, eventId, eReplay_WithoutDraw);
+  }
+  else
+  {
+    InitPostVSBuffers(eventId, m_pDriver->GetRenderState());
+  }
 }
 
 struct VulkanInitPostVSCallback : public VulkanDrawcallCallback
@@ -3325,6 +3499,31 @@ struct VulkanInitPostVSCallback : public VulkanDrawcallCallback
 
 void VulkanReplay::InitPostVSBuffers(const rdcarray<uint32_t> &events)
 {
+  // if every draw in the list has been fetched already - e.g. by the whole-pass batching above
+  // when one of them was first selected - skip the replay entirely.
+  bool allCached = true;
+
+  for(uint32_t eid : events)
+  {
+    const DrawcallDescription *draw = m_pDriver->GetDrawcall(eid);
+
+    // pass boundaries and other non-draw events never get fetched, ignore them
+    if(draw == NULL || !(draw->flags & DrawFlags::Drawcall))
+      continue;
+
+    if(m_PostVS.Alias.find(eid) != m_PostVS.Alias.end())
+      eid = m_PostVS.Alias[eid];
+
+    if(m_PostVS.Data.find(eid) == m_PostVS.Data.end())
+    {
+      allCached = false;
+      break;
+    }
+  }
+
+  if(allCached)
+    return;
+
   // first we must replay up to the first event without replaying it. This ensures any
   // non-command buffer calls like memory unmaps etc all happen correctly before this
   // command buffer
@@ -3349,8 +3548,14 @@ MeshFormat VulkanReplay::GetPostVSBuffers(uint32_t eventId, uint32_t instID, uin
   RDCEraseEl(postvs);
 
   if(m_PostVS.Data.find(eventId) != m_PostVS.Data.end())
+  {
     postvs = m_PostVS.Data[eventId];
 
+    // mark as most recently used, so it's the last to be evicted
+    m_PostVS.UsageOrder.removeOne(eventId);
+    m_PostVS.UsageOrder.push_back(eventId);
+  }
+
   const DrawcallDescription *drawcall = m_pDriver->GetDrawcall(eventId);
 
   uint32_t numInstances = 1;
@@ -600,14 +600,9 @@ void VulkanTextRenderer::BeginText(const TextPrintState &textstate)
 void VulkanTextRenderer::RenderText(const TextPrintState &textstate, float x, float y,
                                     const rdcstr &text)
 {
-  rdcarray<rdcstr> lines;
-  split(text, lines, '\n');
-
-  for(const rdcstr &line : lines)
-  {
-    RenderTextInternal(textstate, x, y, line);
-    y += 1.0f;
-  }
+  // the shader positions each character from a column and row in the string data, so the whole
+  // block - newlines included - goes through as a single draw rather than one per line.
+  RenderTextInternal(textstate, x, y, text);
 }
 
 void VulkanTextRenderer::RenderTextInternal(const TextPrintState &textstate, float x, float y,
@@ -616,6 +611,27 @@ void VulkanTextRenderer::RenderTextInternal(const TextPrintState &textstate, flo
   if(text.empty())
     return;
 
+  // lay the text out as a glyph, column and row per character, consuming newlines
+  rdcarray<Vec4u> glyphs;
+  glyphs.reserve(text.size());
+
+  uint32_t col = 0, row = 0;
+
+  for(const char c : text)
+  {
+    if(c == '\n')
+    {
+      col = 0;
+      row++;
+      continue;
+    }
+
+    glyphs.push_back(Vec4u(uint32_t(c - ' '), col++, row, 0));
+  }
+
+  if(glyphs.empty())
+    return;
+
   uint32_t offsets[2] = {0};
 
   FontUBOData *ubo = (FontUBOData *)m_TextGeneralUBO.Map(&offsets[0]);
@@ -634,23 +650,25 @@ void VulkanTextRenderer::RenderTextInternal(const TextPrintState &textstate, flo
 
   m_TextGeneralUBO.Unmap();
 
-  size_t len = text.size();
-
-  RDCASSERT(len <= MAX_SINGLE_LINE_LENGTH);
+  // draw in chunks if the block is too long for one string UBO slot
+  for(size_t start = 0; start < glyphs.size(); start += MAX_SINGLE_LINE_LENGTH)
+  {
+    size_t len = RDCMIN(glyphs.size() - start, (size_t)MAX_SINGLE_LINE_LENGTH);
 
-  // only map enough for our string
-  StringUBOData *stringData = (StringUBOData *)m_TextStringUBO.Map(&offsets[1], len * sizeof(Vec4u));
+    // only map enough for our string
+    StringUBOData *stringData =
+        (StringUBOData *)m_TextStringUBO.Map(&offsets[1], len * sizeof(Vec4u));
 
-  for(size_t i = 0; i < len; i++)
-    stringData->chars[i].x = uint32_t(text[i] - ' ');
+    memcpy(stringData->chars, glyphs.data() + start, len * sizeof(Vec4u));
 
-  m_TextStringUBO.Unmap();
+    m_TextStringUBO.Unmap();
 
-  ObjDisp(textstate.cmd)
-      ->CmdBindDescriptorSets(Unwrap(textstate.cmd), VK_PIPELINE_BIND_POINT_GRAPHICS,
-                              Unwrap(m_TextPipeLayout), 0, 1, UnwrapPtr(m_TextDescSet), 2, offsets);
+    ObjDisp(textstate.cmd)
+        ->CmdBindDescriptorSets(Unwrap(textstate.cmd), VK_PIPELINE_BIND_POINT_GRAPHICS,
+                                Unwrap(m_TextPipeLayout), 0, 1, UnwrapPtr(m_TextDescSet), 2, offsets);
 
-  ObjDisp(textstate.cmd)->CmdDraw(Unwrap(textstate.cmd), 6 * (uint32_t)len, 1, 0, 0);
+    ObjDisp(textstate.cmd)->CmdDraw(Unwrap(textstate.cmd), 6 * (uint32_t)len, 1, 0, 0);
+  }
 }
 
 void VulkanTextRenderer::EndText(const TextPrintState &textstate)
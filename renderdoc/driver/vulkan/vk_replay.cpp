@@ -204,6 +204,10 @@ ReplayStatus VulkanReplay::ReadLogInitialisation(RDCFile *rdc, bool storeStructu
 
 void VulkanReplay::ReplayLog(uint32_t endEventID, ReplayLogType replayType)
 {
+  // any requested replay can change the state the cached overlay and pick data were built from
+  m_Overlay.CacheValid = false;
+  m_VertexPick.CacheValid = false;
+
   m_pDriver->ReplayLog(0, endEventID, replayType);
 }
 
@@ -2010,7 +2014,14 @@ void VulkanReplay::PickPixel(ResourceId texture, uint32_t x, uint32_t y, const S
 
   bool isStencil = IsStencilFormat(iminfo.format);
 
-  // do a second pass to render the stencil, if needed
+  VkDevice dev = m_pDriver->GetDev();
+  const VkDevDispatchTable *vt = ObjDisp(dev);
+
+  VkResult vkr = VK_SUCCESS;
+
+  // do a second pass to render the stencil, if needed. Both passes are recorded into the same
+  // submission, copying to separate slots in the readback buffer, so that a pick only ever costs
+  // one synchronous round trip to the GPU - hover picking calls this for every mouse move.
   for(int pass = 0; pass < (isStencil ? 2 : 1); pass++)
   {
     // render picked pixel to readback F32 RGBA texture
@@ -2058,11 +2069,7 @@ void VulkanReplay::PickPixel(ResourceId texture, uint32_t x, uint32_t y, const S
                             eTexDisplay_32Render | eTexDisplay_MipShift);
     }
 
-    VkDevice dev = m_pDriver->GetDev();
     VkCommandBuffer cmd = m_pDriver->GetNextCmd();
-    const VkDevDispatchTable *vt = ObjDisp(dev);
-
-    VkResult vkr = VK_SUCCESS;
 
     {
       VkImageMemoryBarrier pickimBarrier = {VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER,
@@ -2090,9 +2097,10 @@ void VulkanReplay::PickPixel(ResourceId texture, uint32_t x, uint32_t y, const S
       pickimBarrier.oldLayout = pickimBarrier.newLayout;
       pickimBarrier.srcAccessMask = pickimBarrier.dstAccessMask;
 
-      // do copy
+      // do copy, to the slot in the readback buffer for this pass
       VkBufferImageCopy region = {
-          0, 128, 1, {VK_IMAGE_ASPECT_COLOR_BIT, 0, 0, 1}, {0, 0, 0}, {1, 1, 1},
+          sizeof(float) * 4 * pass, 128, 1, {VK_IMAGE_ASPECT_COLOR_BIT, 0, 0, 1},
+          {0, 0, 0},               {1, 1, 1},
       };
       vt->CmdCopyImageToBuffer(Unwrap(cmd), Unwrap(m_PixelPick.Image),
                                VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
@@ -2105,50 +2113,46 @@ void VulkanReplay::PickPixel(ResourceId texture, uint32_t x, uint32_t y, const S
 
       vt->EndCommandBuffer(Unwrap(cmd));
     }
+  }
 
-    // submit cmds and wait for idle so we can readback
-    m_pDriver->SubmitCmds();
-    m_pDriver->FlushQ();
-
-    float *pData = NULL;
-    vt->MapMemory(Unwrap(dev), Unwrap(m_PixelPick.ReadbackBuffer.mem), 0, VK_WHOLE_SIZE, 0,
-                  (void **)&pData);
+  // submit cmds and wait for idle so we can readback
+  m_pDriver->SubmitCmds();
+  m_pDriver->FlushQ();
 
-    VkMappedMemoryRange range = {
-        VK_STRUCTURE_TYPE_MAPPED_MEMORY_RANGE,
-        NULL,
-        Unwrap(m_PixelPick.ReadbackBuffer.mem),
-        0,
-        VK_WHOLE_SIZE,
-    };
+  float *pData = NULL;
+  vt->MapMemory(Unwrap(dev), Unwrap(m_PixelPick.ReadbackBuffer.mem), 0, VK_WHOLE_SIZE, 0,
+                (void **)&pData);
 
-    vkr = vt->InvalidateMappedMemoryRanges(Unwrap(dev), 1, &range);
-    RDCASSERTEQUAL(vkr, VK_SUCCESS);
+  VkMappedMemoryRange range = {
+      VK_STRUCTURE_TYPE_MAPPED_MEMORY_RANGE,
+      NULL,
+      Unwrap(m_PixelPick.ReadbackBuffer.mem),
+      0,
+      VK_WHOLE_SIZE,
+  };
 
-    RDCASSERT(pData != NULL);
+  vkr = vt->InvalidateMappedMemoryRanges(Unwrap(dev), 1, &range);
+  RDCASSERTEQUAL(vkr, VK_SUCCESS);
 
-    if(pData == NULL)
-    {
-      RDCERR("Failed ot map readback buffer memory");
-    }
-    else
-    {
-      // only write stencil to .y
-      if(pass == 1)
-      {
-        pixel[1] = ((uint32_t *)pData)[0] / 255.0f;
-      }
-      else
-      {
-        pixel[0] = pData[0];
-        pixel[1] = pData[1];
-        pixel[2] = pData[2];
-        pixel[3] = pData[3];
-      }
-    }
+  RDCASSERT(pData != NULL);
 
-    vt->UnmapMemory(Unwrap(dev), Unwrap(m_PixelPick.ReadbackBuffer.mem));
+  if(pData == NULL)
+  {
+    RDCERR("Failed ot map readback buffer memory");
   }
+  else
+  {
+    pixel[0] = pData[0];
+    pixel[1] = pData[1];
+    pixel[2] = pData[2];
+    pixel[3] = pData[3];
+
+    // the stencil pass lands in the second slot, and only writes to .y
+    if(isStencil)
+      pixel[1] = ((uint32_t *)pData)[4] / 255.0f;
+  }
+
+  vt->UnmapMemory(Unwrap(dev), Unwrap(m_PixelPick.ReadbackBuffer.mem));
 
   m_DebugWidth = oldW;
   m_DebugHeight = oldH;
@@ -3393,11 +3397,33 @@ void VulkanReplay::GetTextureData(ResourceId tex, const Subresource &sub,
                             VK_FORMAT_S8_UINT, s.mip);
   }
 
+  // for huge subresources we read back in bands of rows through a fixed-size staging buffer,
+  // rather than staging the whole subresource at once - something like a 16k x 16k page atlas
+  // remapped to RGBA32 would need a 4GB staging buffer, which stalls for ages if it doesn't
+  // outright fail to allocate. Only plain formats take this path: the special cases below
+  // (interleaving depth/stencil, remapped 3D slices) all want the whole image mapped at once, and
+  // block-compressed data is at least 4x smaller to begin with.
+  const uint32_t bandBudget = 64 * 1024 * 1024;
+
+  bool tiledReadback =
+      dataSize > bandBudget && !(isDepth && isStencil) &&
+      !(imInfo.type == VK_IMAGE_TYPE_3D && params.remap != RemapTexture::NoRemap) &&
+      !(params.remap == RemapTexture::RGBA32 && IsDepthAndStencilFormat(imInfo.format)) &&
+      MakeResourceFormat(imCreateInfo.format).type == ResourceFormatType::Regular;
+
+  uint32_t bandRowPitch = 0, bandRows = 0;
+
+  if(tiledReadback)
+  {
+    bandRowPitch = GetByteSize(copyregion[0].imageExtent.width, 1, 1, imCreateInfo.format, 0);
+    bandRows = RDCCLAMP(bandBudget / bandRowPitch, 1U, copyregion[0].imageExtent.height);
+  }
+
   VkBufferCreateInfo bufInfo = {
       VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO,
       NULL,
       0,
-      dataSize,
+      tiledReadback ? VkDeviceSize(bandRowPitch) * bandRows : dataSize,
       VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
   };
 
@@ -3410,7 +3436,7 @@ void VulkanReplay::GetTextureData(ResourceId tex, const Subresource &sub,
   vt->GetBufferMemoryRequirements(Unwrap(dev), readbackBuf, &mrq);
 
   VkMemoryAllocateInfo allocInfo = {
-      VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO, NULL, dataSize,
+      VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO, NULL, bufInfo.size,
       m_pDriver->GetReadbackMemoryIndex(mrq.memoryTypeBits),
   };
 
@@ -3445,7 +3471,7 @@ void VulkanReplay::GetTextureData(ResourceId tex, const Subresource &sub,
                                readbackBuf, 1, copyregion);
     }
   }
-  else
+  else if(!tiledReadback)
   {
     if(imInfo.type == VK_IMAGE_TYPE_3D)
       copyregion[0].imageSubresource.baseArrayLayer = 0;
@@ -3454,6 +3480,74 @@ void VulkanReplay::GetTextureData(ResourceId tex, const Subresource &sub,
     vt->CmdCopyImageToBuffer(Unwrap(cmd), srcImage, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
                              readbackBuf, 1, copyregion);
   }
+  else
+  {
+    // tiled readback: copy a band of rows at a time into the bounded staging buffer, draining the
+    // queue and streaming each band out to the destination before copying the next.
+    if(imInfo.type == VK_IMAGE_TYPE_3D)
+      copyregion[0].imageSubresource.baseArrayLayer = 0;
+
+    const uint32_t mipWidth = copyregion[0].imageExtent.width;
+    const uint32_t mipHeight = copyregion[0].imageExtent.height;
+    const uint32_t mipDepth = copyregion[0].imageExtent.depth;
+
+    data.resize(dataSize);
+
+    byte *pBandData = NULL;
+    vkr = vt->MapMemory(Unwrap(dev), readbackMem, 0, VK_WHOLE_SIZE, 0, (void **)&pBandData);
+    RDCASSERTEQUAL(vkr, VK_SUCCESS);
+
+    VkMappedMemoryRange bandRange = {
+        VK_STRUCTURE_TYPE_MAPPED_MEMORY_RANGE, NULL, readbackMem, 0, VK_WHOLE_SIZE,
+    };
+
+    VkBufferMemoryBarrier bandBarrier = {
+        VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER,
+        NULL,
+        VK_ACCESS_TRANSFER_WRITE_BIT,
+        VK_ACCESS_HOST_READ_BIT,
+        VK_QUEUE_FAMILY_IGNORED,
+        VK_QUEUE_FAMILY_IGNORED,
+        readbackBuf,
+        0,
+        VK_WHOLE_SIZE,
+    };
+
+    for(uint32_t z = 0; z < mipDepth; z++)
+    {
+      for(uint32_t y = 0; y < mipHeight; y += bandRows)
+      {
+        const uint32_t rows = RDCMIN(bandRows, mipHeight - y);
+
+        copyregion[0].imageOffset = {0, (int32_t)y, (int32_t)z};
+        copyregion[0].imageExtent = {mipWidth, rows, 1};
+
+        vt->CmdCopyImageToBuffer(Unwrap(cmd), srcImage, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+                                 readbackBuf, 1, copyregion);
+
+        // wait for the band to land before reading it back on the host
+        DoPipelineBarrier(cmd, 1, &bandBarrier);
+
+        vt->EndCommandBuffer(Unwrap(cmd));
+
+        m_pDriver->SubmitCmds();
+        m_pDriver->FlushQ();
+
+        vkr = vt->InvalidateMappedMemoryRanges(Unwrap(dev), 1, &bandRange);
+        RDCASSERTEQUAL(vkr, VK_SUCCESS);
+
+        memcpy(data.data() + (z * (size_t)mipHeight + y) * bandRowPitch, pBandData,
+               rows * (size_t)bandRowPitch);
+
+        cmd = m_pDriver->GetNextCmd();
+
+        vkr = vt->BeginCommandBuffer(Unwrap(cmd), &beginInfo);
+        RDCASSERTEQUAL(vkr, VK_SUCCESS);
+      }
+    }
+
+    vt->UnmapMemory(Unwrap(dev), readbackMem);
+  }
 
   // if we have no tmpImage, we're copying directly from the real image
   if(tmpImage == VK_NULL_HANDLE)
@@ -3488,7 +3582,7 @@ void VulkanReplay::GetTextureData(ResourceId tex, const Subresource &sub,
       VK_QUEUE_FAMILY_IGNORED,
       readbackBuf,
       0,
-      dataSize,
+      VK_WHOLE_SIZE,
   };
 
   // wait for copy to finish before reading back to host
@@ -3499,114 +3593,79 @@ void VulkanReplay::GetTextureData(ResourceId tex, const Subresource &sub,
   m_pDriver->SubmitCmds();
   m_pDriver->FlushQ();
 
-  // map the buffer and copy to return buffer
-  byte *pData = NULL;
-  vkr = vt->MapMemory(Unwrap(dev), readbackMem, 0, VK_WHOLE_SIZE, 0, (void **)&pData);
-  RDCASSERTEQUAL(vkr, VK_SUCCESS);
-
-  VkMappedMemoryRange range = {
-      VK_STRUCTURE_TYPE_MAPPED_MEMORY_RANGE, NULL, readbackMem, 0, VK_WHOLE_SIZE,
-  };
-
-  vkr = vt->InvalidateMappedMemoryRanges(Unwrap(dev), 1, &range);
-  RDCASSERTEQUAL(vkr, VK_SUCCESS);
+  // in the tiled path the data was already streamed out band by band above
+  if(!tiledReadback)
+  {
+    // map the buffer and copy to return buffer
+    byte *pData = NULL;
+    vkr = vt->MapMemory(Unwrap(dev), readbackMem, 0, VK_WHOLE_SIZE, 0, (void **)&pData);
+    RDCASSERTEQUAL(vkr, VK_SUCCESS);
 
-  RDCASSERT(pData != NULL);
+    VkMappedMemoryRange range = {
+        VK_STRUCTURE_TYPE_MAPPED_MEMORY_RANGE, NULL, readbackMem, 0, VK_WHOLE_SIZE,
+    };
 
-  data.resize(dataSize);
+    vkr = vt->InvalidateMappedMemoryRanges(Unwrap(dev), 1, &range);
+    RDCASSERTEQUAL(vkr, VK_SUCCESS);
 
-  if(params.remap == RemapTexture::RGBA32 && IsDepthAndStencilFormat(imInfo.format))
-  {
-    memcpy(data.data(), pData, dataSize);
+    RDCASSERT(pData != NULL);
 
-    Vec4f *output = (Vec4f *)data.data();
-    Vec4u *input = (Vec4u *)pData;
-    for(size_t i = 0; i < dataSize / sizeof(Vec4u); i++)
-      output[i].y = float(input[i].y) / 255.0f;
-  }
-  else if(isDepth && isStencil)
-  {
-    size_t pixelCount = std::max(1U, imCreateInfo.extent.width >> s.mip) *
-                        std::max(1U, imCreateInfo.extent.height >> s.mip) *
-                        std::max(1U, imCreateInfo.extent.depth >> s.mip);
+    data.resize(dataSize);
 
-    // for some reason reading direct from mapped memory here is *super* slow on android (1.5s to
-    // iterate over the image), so we memcpy to a temporary buffer.
-    rdcarray<byte> tmp;
-    tmp.resize((size_t)copyregion[1].bufferOffset + pixelCount * sizeof(uint8_t));
-    memcpy(tmp.data(), pData, tmp.size());
+    if(params.remap == RemapTexture::RGBA32 && IsDepthAndStencilFormat(imInfo.format))
+    {
+      memcpy(data.data(), pData, dataSize);
 
-    if(imCreateInfo.format == VK_FORMAT_D16_UNORM_S8_UINT)
+      Vec4f *output = (Vec4f *)data.data();
+      Vec4u *input = (Vec4u *)pData;
+      for(size_t i = 0; i < dataSize / sizeof(Vec4u); i++)
+        output[i].y = float(input[i].y) / 255.0f;
+    }
+    else if(isDepth && isStencil)
     {
-      uint16_t *dSrc = (uint16_t *)tmp.data();
-      uint8_t *sSrc = (uint8_t *)(tmp.data() + copyregion[1].bufferOffset);
+      size_t pixelCount = std::max(1U, imCreateInfo.extent.width >> s.mip) *
+                          std::max(1U, imCreateInfo.extent.height >> s.mip) *
+                          std::max(1U, imCreateInfo.extent.depth >> s.mip);
 
-      uint16_t *dDst = (uint16_t *)data.data();
-      uint16_t *sDst = dDst + 1;    // interleaved, next pixel
+      // for some reason reading direct from mapped memory here is *super* slow on android (1.5s to
+      // iterate over the image), so we memcpy to a temporary buffer.
+      rdcarray<byte> tmp;
+      tmp.resize((size_t)copyregion[1].bufferOffset + pixelCount * sizeof(uint8_t));
+      memcpy(tmp.data(), pData, tmp.size());
 
-      for(size_t i = 0; i < pixelCount; i++)
+      if(imCreateInfo.format == VK_FORMAT_D16_UNORM_S8_UINT)
       {
-        *dDst = *dSrc;
-        *sDst = *sSrc;
-
-        // increment source pointers by 1 since they're separate, and dest pointers by 2 since
-        // they're interleaved
-        dDst += 2;
-        sDst += 2;
+        uint16_t *dSrc = (uint16_t *)tmp.data();
+        uint8_t *sSrc = (uint8_t *)(tmp.data() + copyregion[1].bufferOffset);
 
-        sSrc++;
-        dSrc++;
+        InterleaveD16S8((uint16_t *)data.data(), dSrc, sSrc, pixelCount);
       }
-    }
-    else if(imCreateInfo.format == VK_FORMAT_D24_UNORM_S8_UINT)
-    {
-      // we can copy the depth from D24 as a 32-bit integer, since the remaining bits are garbage
-      // and we overwrite them with stencil
-      uint32_t *dSrc = (uint32_t *)tmp.data();
-      uint8_t *sSrc = (uint8_t *)(tmp.data() + copyregion[1].bufferOffset);
-
-      uint32_t *dst = (uint32_t *)data.data();
-
-      for(size_t i = 0; i < pixelCount; i++)
+      else if(imCreateInfo.format == VK_FORMAT_D24_UNORM_S8_UINT)
       {
+        // we can copy the depth from D24 as a 32-bit integer, since the remaining bits are garbage
+        // and we overwrite them with stencil
+        uint32_t *dSrc = (uint32_t *)tmp.data();
+        uint8_t *sSrc = (uint8_t *)(tmp.data() + copyregion[1].bufferOffset);
+
         // pack the data together again, stencil in top bits
-        *dst = (*dSrc & 0x00ffffff) | (uint32_t(*sSrc) << 24);
+        InterleaveD24S8((uint32_t *)data.data(), dSrc, sSrc, pixelCount);
+      }
+      else
+      {
+        uint32_t *dSrc = (uint32_t *)tmp.data();
+        uint8_t *sSrc = (uint8_t *)(tmp.data() + copyregion[1].bufferOffset);
 
-        dst++;
-        sSrc++;
-        dSrc++;
+        InterleaveD32S8((uint32_t *)data.data(), dSrc, sSrc, pixelCount);
       }
+      // need to manually copy to interleave pixels
     }
     else
     {
-      uint32_t *dSrc = (uint32_t *)tmp.data();
-      uint8_t *sSrc = (uint8_t *)(tmp.data() + copyregion[1].bufferOffset);
-
-      uint32_t *dDst = (uint32_t *)data.data();
-      uint32_t *sDst = dDst + 1;    // interleaved, next pixel
-
-      for(size_t i = 0; i < pixelCount; i++)
-      {
-        *dDst = *dSrc;
-        *sDst = *sSrc;
-
-        // increment source pointers by 1 since they're separate, and dest pointers by 2 since
-        // they're interleaved
-        dDst += 2;
-        sDst += 2;
-
-        sSrc++;
-        dSrc++;
-      }
+      memcpy(data.data(), pData, dataSize);
     }
-    // need to manually copy to interleave pixels
-  }
-  else
-  {
-    memcpy(data.data(), pData, dataSize);
-  }
 
-  vt->UnmapMemory(Unwrap(dev), readbackMem);
+    vt->UnmapMemory(Unwrap(dev), readbackMem);
+  }
 
   // clean up temporary objects
   vt->DestroyBuffer(Unwrap(dev), readbackBuf, NULL);
@@ -3737,19 +3796,28 @@ void VulkanReplay::BuildTargetShader(ShaderEncoding sourceEncoding, const bytebu
         return;
     }
 
-    rdcarray<rdcstr> sources;
-    sources.push_back(rdcstr((char *)source.begin(), source.size()));
-
     rdcspv::CompilationSettings settings(rdcspv::InputLanguage::VulkanGLSL, stage);
 
-    rdcstr output = rdcspv::Compile(settings, sources, spirv);
+    VulkanShaderCache *shaderCache = m_pDriver->GetShaderCache();
+
+    // go through the shader cache so that a standard set of custom shaders compiles once and then
+    // loads from disk on every subsequent capture open.
+    shaderCache->SetCaching(true);
+
+    SPIRVBlob blob = NULL;
+    rdcstr output =
+        shaderCache->GetSPIRVBlob(settings, rdcstr((char *)source.begin(), source.size()), blob);
+
+    shaderCache->SetCaching(false);
 
-    if(spirv.empty())
+    if(blob == NULL || blob->empty())
     {
       id = ResourceId();
       errors = output;
       return;
     }
+
+    spirv = *blob;
   }
   else
   {
@@ -3785,11 +3853,9 @@ void VulkanReplay::ReplaceResource(ResourceId from, ResourceId to)
   // replace the shader module
   m_pDriver->GetResourceManager()->ReplaceResource(from, to);
 
-  // now update any derived resources
+  // now update any derived resources. This also scrubs cached post-VS output and shader
+  // feedback, but only for the events that used an affected pipeline
   RefreshDerivedReplacements();
-
-  ClearPostVSCache();
-  ClearFeedbackCache();
 }
 
 void VulkanReplay::RemoveReplacement(ResourceId id)
@@ -3799,14 +3865,15 @@ void VulkanReplay::RemoveReplacement(ResourceId id)
     m_pDriver->GetResourceManager()->RemoveReplacement(id);
 
     RefreshDerivedReplacements();
-
-    ClearPostVSCache();
-    ClearFeedbackCache();
   }
 }
 
 void VulkanReplay::RefreshDerivedReplacements()
 {
+  // cached re-recorded command buffers bake in the current pipeline bindings, so they can't be
+  // re-used across a change in resource replacements.
+  m_pDriver->FreeRerecordCache();
+
   VkDevice dev = m_pDriver->GetDev();
 
   VulkanResourceManager *rm = m_pDriver->GetResourceManager();
@@ -3815,6 +3882,9 @@ void VulkanReplay::RefreshDerivedReplacements()
   // we're iterating
   rdcarray<VkPipeline> deletequeue;
 
+  // every pipeline we rebuild (or restore) here, for scoped invalidation of derived caches below
+  rdcarray<ResourceId> refreshedPipes;
+
   // remake and replace any pipelines that reference a replaced shader
   for(auto it = m_pDriver->m_CreationInfo.m_Pipeline.begin();
       it != m_pDriver->m_CreationInfo.m_Pipeline.end(); ++it)
@@ -3834,6 +3904,8 @@ void VulkanReplay::RefreshDerivedReplacements()
       deletequeue.push_back(rm->GetLiveHandle<VkPipeline>(origsrcid));
 
       rm->RemoveReplacement(origsrcid);
+
+      refreshedPipes.push_back(pipesrcid);
     }
 
     bool usesReplacedShader = false;
@@ -3873,9 +3945,10 @@ void VulkanReplay::RefreshDerivedReplacements()
                                    VK_PIPELINE_CREATE_CAPTURE_INTERNAL_REPRESENTATIONS_BIT_KHR);
         }
 
-        // create the new graphics pipeline
-        VkResult vkr = m_pDriver->vkCreateGraphicsPipelines(dev, VK_NULL_HANDLE, 1, &pipeCreateInfo,
-                                                            NULL, &pipe);
+        // create the new graphics pipeline, via the disk-persisted pipeline cache so that stages
+        // unchanged by the edit mostly skip driver compilation
+        VkResult vkr = m_pDriver->vkCreateGraphicsPipelines(
+            dev, m_pDriver->GetShaderCache()->GetPipeCache(), 1, &pipeCreateInfo, NULL, &pipe);
         RDCASSERTEQUAL(vkr, VK_SUCCESS);
       }
       else
@@ -3895,19 +3968,28 @@ void VulkanReplay::RefreshDerivedReplacements()
                                    VK_PIPELINE_CREATE_CAPTURE_INTERNAL_REPRESENTATIONS_BIT_KHR);
         }
 
-        // create the new compute pipeline
-        VkResult vkr = m_pDriver->vkCreateComputePipelines(dev, VK_NULL_HANDLE, 1, &pipeCreateInfo,
-                                                           NULL, &pipe);
+        // create the new compute pipeline, also via the disk-persisted pipeline cache
+        VkResult vkr = m_pDriver->vkCreateComputePipelines(
+            dev, m_pDriver->GetShaderCache()->GetPipeCache(), 1, &pipeCreateInfo, NULL, &pipe);
         RDCASSERTEQUAL(vkr, VK_SUCCESS);
       }
 
       // remove the replacements
       rm->ReplaceResource(origsrcid, GetResID(pipe));
+
+      if(refreshedPipes.empty() || refreshedPipes.back() != pipesrcid)
+        refreshedPipes.push_back(pipesrcid);
     }
   }
 
   for(VkPipeline pipe : deletequeue)
     m_pDriver->vkDestroyPipeline(dev, pipe, NULL);
+
+  // throw away cached post-VS output and shader feedback only for events that used the pipelines
+  // refreshed above. Everything else is unaffected by the edit and doesn't need re-fetching, which
+  // is most of what makes repeated edit-and-replay iterations cheap on large captures.
+  InvalidatePostVSForPipelines(refreshedPipes);
+  InvalidateFeedbackForPipelines(refreshedPipes);
 }
 
 ResourceId VulkanReplay::CreateProxyTexture(const TextureDescription &templateTex)
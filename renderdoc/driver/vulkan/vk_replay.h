@@ -177,6 +177,13 @@ struct VulkanPostVSData
     float farPlane;
   } vsin, vsout, gsout;
 
+  // total GPU memory held by the stage buffers above, used for cache budgeting
+  uint64_t totalBytes = 0;
+
+  // the (live) pipeline this data was fetched with, so a shader edit only invalidates the
+  // events that used an affected pipeline
+  ResourceId pipe;
+
   VulkanPostVSData()
   {
     RDCEraseEl(vsin);
@@ -201,6 +208,9 @@ struct DynamicUsedBinds
 {
   bool compute = false, valid = false;
   rdcarray<BindpointIndex> used;
+
+  // the (live) pipeline the feedback was fetched with, for scoped invalidation on shader edit
+  ResourceId pipe;
 };
 
 enum TexDisplayFlags
@@ -255,6 +265,7 @@ public:
 
   void CreateResources();
   void DestroyResources();
+  void InitIHVCounters();
 
   DriverInformation GetDriverInfo() { return m_DriverInfo; }
   rdcarray<GPUDevice> GetAvailableGPUs();
@@ -371,9 +382,15 @@ public:
 
   rdcarray<PixelModification> PixelHistory(rdcarray<EventUsage> events, ResourceId target, uint32_t x,
                                            uint32_t y, const Subresource &sub, CompType typeCast);
+  rdcarray<rdcarray<PixelModification>> PixelHistoryRegion(rdcarray<EventUsage> events,
+                                                           ResourceId target, uint32_t x, uint32_t y,
+                                                           uint32_t width, uint32_t height,
+                                                           const Subresource &sub, CompType typeCast);
   ShaderDebugTrace *DebugVertex(uint32_t eventId, uint32_t vertid, uint32_t instid, uint32_t idx);
   ShaderDebugTrace *DebugPixel(uint32_t eventId, uint32_t x, uint32_t y, uint32_t sample,
                                uint32_t primitive);
+  rdcarray<ShaderDebugTrace *> DebugPixels(uint32_t eventId,
+                                           const rdcarray<PixelDebugTarget> &targets);
   ShaderDebugTrace *DebugThread(uint32_t eventId, const uint32_t groupid[3],
                                 const uint32_t threadid[3]);
   rdcarray<ShaderDebugState> ContinueDebug(ShaderDebugger *debugger);
@@ -420,6 +437,7 @@ public:
 private:
   void FetchShaderFeedback(uint32_t eventId);
   void ClearFeedbackCache();
+  void InvalidateFeedbackForPipelines(const rdcarray<ResourceId> &pipes);
 
   void PatchReservedDescriptors(const VulkanStatePipeline &pipe, VkDescriptorPool &descpool,
                                 rdcarray<VkDescriptorSetLayout> &setLayouts,
@@ -430,7 +448,9 @@ private:
 
   void FetchVSOut(uint32_t eventId, VulkanRenderState &state);
   void FetchTessGSOut(uint32_t eventId, VulkanRenderState &state);
+  void TrimPostVSCache(uint32_t eventId);
   void ClearPostVSCache();
+  void InvalidatePostVSForPipelines(const rdcarray<ResourceId> &pipes);
 
   void RefreshDerivedReplacements();
 
@@ -602,6 +622,17 @@ private:
     VkImageView ImageView = VK_NULL_HANDLE;
     VkFramebuffer NoDepthFB = VK_NULL_HANDLE;
 
+    // key of the last rendered overlay, so an unchanged refresh (e.g. toggling UI panels) can
+    // return the image as-is instead of re-executing the whole overlay pass. Invalidated whenever
+    // a replay is requested, since that can change the state the overlay was rendered from.
+    bool CacheValid = false;
+    uint32_t CachedEventId = 0;
+    DebugOverlay CachedOverlay = DebugOverlay::NoOverlay;
+    ResourceId CachedTexId;
+    Subresource CachedSub;
+    CompType CachedTypeCast = CompType::Typeless;
+    FloatVector CachedClearCol;
+
     VkDescriptorSetLayout m_CheckerDescSetLayout = VK_NULL_HANDLE;
     VkPipelineLayout m_CheckerPipeLayout = VK_NULL_HANDLE;
     VkDescriptorSet m_CheckerDescSet = VK_NULL_HANDLE;
@@ -648,6 +679,16 @@ private:
     GPUBuffer VB;
     GPUBuffer VBUpload;
     uint32_t IBSize = 0, VBSize = 0;
+
+    // key of the mesh data currently uploaded to IB/VB, so that repeated picks on the same draw
+    // (the common mesh viewer workflow) skip the buffer readback, CPU format conversion and
+    // re-upload and only re-run the small picking dispatch. Invalidated whenever a replay is
+    // requested.
+    bool CacheValid = false;
+    uint32_t CachedEventId = 0;
+    MeshFormat CachedPosition;
+    uint32_t CachedNumIndices = 0;
+    bool CachedUseIndices = false;
     GPUBuffer Result, ResultReadback;
     VkDescriptorSetLayout DescSetLayout = VK_NULL_HANDLE;
     VkDescriptorSet DescSet = VK_NULL_HANDLE;
@@ -710,6 +751,11 @@ private:
 
     std::map<uint32_t, VulkanPostVSData> Data;
     std::map<uint32_t, uint32_t> Alias;
+
+    // running total of GPU memory held by Data, and eventIds from least to most recently used,
+    // for evicting old entries once over budget
+    uint64_t TotalBytes = 0;
+    rdcarray<uint32_t> UsageOrder;
   } m_PostVS;
 
   struct Feedback
@@ -754,6 +800,9 @@ private:
   rdcarray<CounterResult> FetchCountersAMD(const rdcarray<GPUCounter> &counters);
 
   AMDCounters *m_pAMDCounters = NULL;
+
+  // IHV counter libraries are loaded lazily on the first counter enumeration, not at replay init
+  bool m_IHVCountersTried = false;
   AMDRGPControl *m_RGP = NULL;
 
   VulkanAMDDrawCallback *m_pAMDDrawCallback = NULL;
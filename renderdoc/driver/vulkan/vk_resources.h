@@ -975,8 +975,31 @@ struct ResourceInfo
     RDCEraseEl(pages);
   }
 
-  // for buffers or non-sparse-resident images (bound with opaque mappings)
-  rdcarray<VkSparseMemoryBind> opaquemappings;
+  // value stored per interval of the opaque mapping table below. Rather than the memory offset
+  // itself we store the difference between memory offset and resource offset, so adjacent binds
+  // that map contiguous memory compare equal and coalesce into a single interval.
+  struct OpaqueBind
+  {
+    VkDeviceMemory memory = VK_NULL_HANDLE;
+    // memoryOffset - resourceOffset (mod 2^64), so memoryOffset = memDelta + interval start
+    uint64_t memDelta = 0;
+    VkSparseMemoryBindFlags flags = 0;
+
+    bool operator==(const OpaqueBind &o) const
+    {
+      return memory == o.memory && memDelta == o.memDelta && flags == o.flags;
+    }
+    bool operator!=(const OpaqueBind &o) const { return !(*this == o); }
+  };
+
+  // for buffers or non-sparse-resident images (bound with opaque mappings), stored as coalesced
+  // intervals over the resource's byte range so terrain-style workloads with tens of thousands of
+  // page bindings update in O(log n) instead of a linear splice. Unbound ranges hold the default
+  // value with a NULL memory.
+  Intervals<OpaqueBind> opaquemappings;
+
+  // flattens the coalesced intervals back to an API-style bind list, bound ranges only
+  rdcarray<VkSparseMemoryBind> GetOpaqueBinds() const;
 
   VkMemoryRequirements memreqs;
 
@@ -1053,6 +1076,13 @@ struct DescriptorSetData
   // create from the layout.
   rdcarray<DescriptorSetSlot *> descBindings;
 
+  // high water mark per binding of array elements that have ever been written. Giant bindless
+  // arrays are commonly allocated at a worst-case size and only partially filled, so initial
+  // contents preparation and serialisation only consider slots up to this count and skip the
+  // untouched tail. A single write to a high array element pays the worst case, but that's no
+  // worse than the previous behaviour of always snapshotting the whole binding.
+  rdcarray<uint32_t> writtenHighWater;
+
   // lock protecting bindFrameRefs and bindMemRefs
   Threading::CriticalSection refLock;
 
@@ -1090,6 +1120,10 @@ struct MemMapState
   bool mapCoherent;
   byte *mappedPtr;
   byte *refData;
+  // byte ranges within the map that OS write-watch reported as written but that haven't been
+  // serialised yet. Banked across submits because resetting the tracking is process-global, so a
+  // submit that doesn't reference this map must not throw its dirty pages away. See vkQueueSubmit.
+  rdcarray<rdcpair<size_t, size_t>> osDirtyRanges;
   Threading::CriticalSection mrLock;
 };
 
@@ -1967,6 +2001,12 @@ struct MemRefs
     return Update(offset, size, refType, ComposeFrameRefs);
   }
   template <typename Compose>
+  FrameRefType UpdateMany(rdcarray<Intervals<FrameRefType>::RangeValue> &ranges, Compose comp);
+  inline FrameRefType UpdateMany(rdcarray<Intervals<FrameRefType>::RangeValue> &ranges)
+  {
+    return UpdateMany(ranges, ComposeFrameRefs);
+  }
+  template <typename Compose>
   FrameRefType Merge(MemRefs &other, Compose comp);
   inline FrameRefType Merge(MemRefs &other) { return Merge(other, ComposeFrameRefs); }
 };
@@ -1986,6 +2026,19 @@ FrameRefType MemRefs::Update(VkDeviceSize offset, VkDeviceSize size, FrameRefTyp
   return maxRefType;
 }
 
+template <typename Compose>
+FrameRefType MemRefs::UpdateMany(rdcarray<Intervals<FrameRefType>::RangeValue> &ranges, Compose comp)
+{
+  FrameRefType maxRefType = eFrameRef_None;
+  rangeRefs.updateMany(ranges,
+                       [&maxRefType, comp](FrameRefType oldRef, FrameRefType newRef) -> FrameRefType {
+                         FrameRefType ref = comp(oldRef, newRef);
+                         maxRefType = ComposeFrameRefsDisjoint(maxRefType, ref);
+                         return ref;
+                       });
+  return maxRefType;
+}
+
 template <typename Compose>
 FrameRefType MemRefs::Merge(MemRefs &other, Compose comp)
 {
@@ -2042,6 +2095,19 @@ inline FrameRefType MarkMemoryReferenced(std::map<ResourceId, MemRefs> &memRefs,
   return MarkMemoryReferenced(memRefs, mem, offset, size, refType, ComposeFrameRefs);
 }
 
+// batch equivalent of MarkMemoryReferenced for callers that accumulate many small ranges against
+// the same memory object - applies the whole batch in one pass over the interval map.
+inline FrameRefType MarkMemoryReferenced(std::map<ResourceId, MemRefs> &memRefs, ResourceId mem,
+                                         rdcarray<Intervals<FrameRefType>::RangeValue> &ranges)
+{
+  if(ranges.empty())
+    return eFrameRef_None;
+  auto refs = memRefs.find(mem);
+  if(refs == memRefs.end())
+    refs = memRefs.insert(std::pair<ResourceId, MemRefs>(mem, MemRefs())).first;
+  return refs->second.UpdateMany(ranges);
+}
+
 struct DescUpdateTemplate;
 struct ImageLayouts;
 
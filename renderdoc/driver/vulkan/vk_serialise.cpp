@@ -225,6 +225,71 @@ bool OptionalResourcesEnabled()
 // struct that had optional objects... but that doesn't come up and seems unlikely.
 #define OPTIONAL_RESOURCES() auto opt__LINE__ = ScopedOptional(ser);
 
+// leaf structs whose DoSerialise below writes exactly their in-memory bytes: every member is a
+// fixed-size arithmetic/enum/flags type (or another struct declared here), serialised once in
+// declaration order, with no padding, pointers, handles, unions, sType/pNext or platform-size
+// members. Arrays of these - pRegions, pViewports, pAttachments and friends - then go through the
+// serialiser's bulk stream path in binary mode instead of walking every element.
+//
+// Note that qualifying is stricter than it looks: unions like VkClearValue serialise multiple
+// views so their wire format is wider than their memory layout, and structs with fixed array
+// members like VkImageBlit serialise an array count word, so neither can be declared here. The
+// size asserts guard the no-padding assumption across compilers.
+DECLARE_SERIALISE_LAYOUT_COMPATIBLE(VkOffset2D);
+DECLARE_SERIALISE_LAYOUT_COMPATIBLE(VkOffset3D);
+DECLARE_SERIALISE_LAYOUT_COMPATIBLE(VkExtent2D);
+DECLARE_SERIALISE_LAYOUT_COMPATIBLE(VkExtent3D);
+DECLARE_SERIALISE_LAYOUT_COMPATIBLE(VkRect2D);
+DECLARE_SERIALISE_LAYOUT_COMPATIBLE(VkClearRect);
+DECLARE_SERIALISE_LAYOUT_COMPATIBLE(VkViewport);
+DECLARE_SERIALISE_LAYOUT_COMPATIBLE(VkImageSubresource);
+DECLARE_SERIALISE_LAYOUT_COMPATIBLE(VkImageSubresourceLayers);
+DECLARE_SERIALISE_LAYOUT_COMPATIBLE(VkImageSubresourceRange);
+DECLARE_SERIALISE_LAYOUT_COMPATIBLE(VkBufferCopy);
+DECLARE_SERIALISE_LAYOUT_COMPATIBLE(VkBufferImageCopy);
+DECLARE_SERIALISE_LAYOUT_COMPATIBLE(VkImageCopy);
+DECLARE_SERIALISE_LAYOUT_COMPATIBLE(VkImageResolve);
+DECLARE_SERIALISE_LAYOUT_COMPATIBLE(VkAttachmentDescription);
+DECLARE_SERIALISE_LAYOUT_COMPATIBLE(VkSubpassDependency);
+DECLARE_SERIALISE_LAYOUT_COMPATIBLE(VkVertexInputBindingDescription);
+DECLARE_SERIALISE_LAYOUT_COMPATIBLE(VkVertexInputAttributeDescription);
+DECLARE_SERIALISE_LAYOUT_COMPATIBLE(VkPipelineColorBlendAttachmentState);
+DECLARE_SERIALISE_LAYOUT_COMPATIBLE(VkDescriptorPoolSize);
+DECLARE_SERIALISE_LAYOUT_COMPATIBLE(VkPushConstantRange);
+
+RDCCOMPILE_ASSERT(sizeof(VkOffset2D) == 8, "VkOffset2D is padded, can't bulk serialise");
+RDCCOMPILE_ASSERT(sizeof(VkOffset3D) == 12, "VkOffset3D is padded, can't bulk serialise");
+RDCCOMPILE_ASSERT(sizeof(VkExtent2D) == 8, "VkExtent2D is padded, can't bulk serialise");
+RDCCOMPILE_ASSERT(sizeof(VkExtent3D) == 12, "VkExtent3D is padded, can't bulk serialise");
+RDCCOMPILE_ASSERT(sizeof(VkRect2D) == 16, "VkRect2D is padded, can't bulk serialise");
+RDCCOMPILE_ASSERT(sizeof(VkClearRect) == 24, "VkClearRect is padded, can't bulk serialise");
+RDCCOMPILE_ASSERT(sizeof(VkViewport) == 24, "VkViewport is padded, can't bulk serialise");
+RDCCOMPILE_ASSERT(sizeof(VkImageSubresource) == 12,
+                  "VkImageSubresource is padded, can't bulk serialise");
+RDCCOMPILE_ASSERT(sizeof(VkImageSubresourceLayers) == 16,
+                  "VkImageSubresourceLayers is padded, can't bulk serialise");
+RDCCOMPILE_ASSERT(sizeof(VkImageSubresourceRange) == 20,
+                  "VkImageSubresourceRange is padded, can't bulk serialise");
+RDCCOMPILE_ASSERT(sizeof(VkBufferCopy) == 24, "VkBufferCopy is padded, can't bulk serialise");
+RDCCOMPILE_ASSERT(sizeof(VkBufferImageCopy) == 56,
+                  "VkBufferImageCopy is padded, can't bulk serialise");
+RDCCOMPILE_ASSERT(sizeof(VkImageCopy) == 68, "VkImageCopy is padded, can't bulk serialise");
+RDCCOMPILE_ASSERT(sizeof(VkImageResolve) == 68, "VkImageResolve is padded, can't bulk serialise");
+RDCCOMPILE_ASSERT(sizeof(VkAttachmentDescription) == 36,
+                  "VkAttachmentDescription is padded, can't bulk serialise");
+RDCCOMPILE_ASSERT(sizeof(VkSubpassDependency) == 28,
+                  "VkSubpassDependency is padded, can't bulk serialise");
+RDCCOMPILE_ASSERT(sizeof(VkVertexInputBindingDescription) == 12,
+                  "VkVertexInputBindingDescription is padded, can't bulk serialise");
+RDCCOMPILE_ASSERT(sizeof(VkVertexInputAttributeDescription) == 16,
+                  "VkVertexInputAttributeDescription is padded, can't bulk serialise");
+RDCCOMPILE_ASSERT(sizeof(VkPipelineColorBlendAttachmentState) == 32,
+                  "VkPipelineColorBlendAttachmentState is padded, can't bulk serialise");
+RDCCOMPILE_ASSERT(sizeof(VkDescriptorPoolSize) == 8,
+                  "VkDescriptorPoolSize is padded, can't bulk serialise");
+RDCCOMPILE_ASSERT(sizeof(VkPushConstantRange) == 12,
+                  "VkPushConstantRange is padded, can't bulk serialise");
+
 // serialisation of object handles via IDs.
 template <class SerialiserType, class type>
 void DoSerialiseViaResourceId(SerialiserType &ser, type &el)
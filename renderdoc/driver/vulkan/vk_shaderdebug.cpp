@@ -1004,6 +1004,26 @@ public:
                             uniformParams.offset.x, uniformParams.offset.y, uniformParams.offset.z));
     }
 
+    // the operation is now fully described by the pipeline parameters, the uniforms, and the
+    // descriptors we're about to bind, so if we've evaluated an identical operation before we can
+    // re-use its result instead of paying for another GPU round trip.
+    bytebuf cacheKey;
+    cacheKey.append((const byte *)&constParams, sizeof(constParams));
+    cacheKey.append((const byte *)&uniformParams, sizeof(uniformParams));
+
+    const uint64_t boundObjects[] = {
+        NON_DISP_TO_UINT64(sampler), NON_DISP_TO_UINT64(sampleView), NON_DISP_TO_UINT64(bufferView),
+        (uint64_t)layout,            (uint64_t)texType,
+    };
+    cacheKey.append((const byte *)boundObjects, sizeof(boundObjects));
+
+    auto cacheIt = sampleGatherCache.find(cacheKey);
+    if(cacheIt != sampleGatherCache.end())
+    {
+      memcpy(output.value.uv, &cacheIt->second, sizeof(Vec4f));
+      return true;
+    }
+
     VkPipeline pipe = MakePipe(constParams, uintTex, sintTex);
 
     VkDescriptorImageInfo samplerWriteInfo = {Unwrap(sampler), VK_NULL_HANDLE,
@@ -1113,6 +1133,8 @@ public:
 
     memcpy(output.value.uv, ret, sizeof(Vec4f));
 
+    sampleGatherCache[cacheKey] = *ret;
+
     m_DebugData.ReadbackBuffer.Unmap();
 
     return true;
@@ -1123,6 +1145,26 @@ public:
   {
     RDCASSERT(params.size() <= 3, params.size());
 
+    // the operation only depends on the pushed parameter values, so identical evaluations can
+    // re-use the previous result rather than paying for another GPU round trip.
+    bytebuf cacheKey;
+    const uint32_t op32 = (uint32_t)op;
+    cacheKey.append((const byte *)&op32, sizeof(op32));
+    for(const ShaderVariable &param : params)
+      cacheKey.append((const byte *)param.value.fv, sizeof(Vec4f));
+
+    auto cacheIt = mathOpCache.find(cacheKey);
+    if(cacheIt != mathOpCache.end())
+    {
+      memcpy(output.value.uv, &cacheIt->second, sizeof(Vec4f));
+
+      // these two operations change the type of the output
+      if(op == rdcspv::GLSLstd450::Length || op == rdcspv::GLSLstd450::Distance)
+        output.columns = 1;
+
+      return true;
+    }
+
     if(m_DebugData.MathPipe == VK_NULL_HANDLE)
     {
       ShaderConstParameters pipeParams = {};
@@ -1187,6 +1229,8 @@ public:
 
     memcpy(output.value.uv, ret, sizeof(Vec4f));
 
+    mathOpCache[cacheKey] = *ret;
+
     m_DebugData.ReadbackBuffer.Unmap();
 
     // these two operations change the type of the output
@@ -1240,6 +1284,13 @@ private:
 
   std::map<BindpointIndex, ImageData> imageCache;
 
+  // results of previously GPU-evaluated operations, keyed on the full set of inputs. These are
+  // pure functions of their inputs and long loops frequently re-evaluate them with loop-invariant
+  // parameters, and every miss costs a full submit and queue idle, so hits here save a lot of
+  // stepping latency on long traces.
+  std::map<bytebuf, Vec4f> sampleGatherCache;
+  std::map<bytebuf, Vec4f> mathOpCache;
+
   template <typename T>
   const T &GetDescriptor(const rdcstr &access, BindpointIndex index, bool &valid)
   {
@@ -3787,7 +3838,8 @@ ShaderDebugTrace *VulkanReplay::DebugPixel(uint32_t eventId, uint32_t x, uint32_
   // buffer, we'd still want to spec-constant the address when possible so we're always going to
   // have some varying value.
   VkPipeline inputsPipe;
-  vkr = m_pDriver->vkCreateGraphicsPipelines(dev, NULL, 1, &graphicsInfo, NULL, &inputsPipe);
+  vkr = m_pDriver->vkCreateGraphicsPipelines(dev, m_pDriver->GetShaderCache()->GetPipeCache(), 1,
+                                             &graphicsInfo, NULL, &inputsPipe);
   RDCASSERTEQUAL(vkr, VK_SUCCESS);
 
   // make copy of state to draw from
@@ -4072,6 +4124,12 @@ ShaderDebugTrace *VulkanReplay::DebugPixel(uint32_t eventId, uint32_t x, uint32_
   return ret;
 }
 
+rdcarray<ShaderDebugTrace *> VulkanReplay::DebugPixels(uint32_t eventId,
+                                                       const rdcarray<PixelDebugTarget> &targets)
+{
+  return StandardDebugPixels(this, eventId, targets);
+}
+
 ShaderDebugTrace *VulkanReplay::DebugThread(uint32_t eventId, const uint32_t groupid[3],
                                             const uint32_t threadid[3])
 {
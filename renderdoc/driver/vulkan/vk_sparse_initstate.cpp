@@ -81,11 +81,13 @@ bool WrappedVulkan::Prepare_SparseInitialState(WrappedVkBuffer *buf)
   // bound range.
   std::map<VkDeviceMemory, VkDeviceSize> boundMems;
 
+  rdcarray<VkSparseMemoryBind> opaqueBinds = buf->record->resInfo->GetOpaqueBinds();
+
   // value will be filled out later once all memories are added
-  for(size_t i = 0; i < buf->record->resInfo->opaquemappings.size(); i++)
-    boundMems[buf->record->resInfo->opaquemappings[i].memory] = 0;
+  for(size_t i = 0; i < opaqueBinds.size(); i++)
+    boundMems[opaqueBinds[i].memory] = 0;
 
-  uint32_t numElems = (uint32_t)buf->record->resInfo->opaquemappings.size();
+  uint32_t numElems = (uint32_t)opaqueBinds.size();
 
   VkInitialContents initContents;
 
@@ -97,7 +99,7 @@ bool WrappedVulkan::Prepare_SparseInitialState(WrappedVkBuffer *buf)
   initContents.sparseBuffer.numUniqueMems = (uint32_t)boundMems.size();
   initContents.sparseBuffer.memDataOffs = new MemIDOffset[boundMems.size()];
 
-  memcpy(initContents.sparseBuffer.binds, &buf->record->resInfo->opaquemappings[0],
+  memcpy(initContents.sparseBuffer.binds, opaqueBinds.data(),
          sizeof(VkSparseMemoryBind) * numElems);
 
   VkDevice d = GetDev();
@@ -207,9 +209,11 @@ bool WrappedVulkan::Prepare_SparseInitialState(WrappedVkImage *im)
   // bound range.
   std::map<VkDeviceMemory, VkDeviceSize> boundMems;
 
+  rdcarray<VkSparseMemoryBind> opaqueBinds = sparse->GetOpaqueBinds();
+
   // value will be filled out later once all memories are added
-  for(size_t i = 0; i < sparse->opaquemappings.size(); i++)
-    boundMems[sparse->opaquemappings[i].memory] = 0;
+  for(size_t i = 0; i < opaqueBinds.size(); i++)
+    boundMems[opaqueBinds[i].memory] = 0;
 
   uint32_t pagePerAspect = sparse->imgdim.width * sparse->imgdim.height * sparse->imgdim.depth;
 
@@ -223,7 +227,7 @@ bool WrappedVulkan::Prepare_SparseInitialState(WrappedVkImage *im)
     }
   }
 
-  uint32_t opaqueCount = (uint32_t)sparse->opaquemappings.size();
+  uint32_t opaqueCount = (uint32_t)opaqueBinds.size();
 
   VkInitialContents initContents;
 
@@ -240,7 +244,7 @@ bool WrappedVulkan::Prepare_SparseInitialState(WrappedVkImage *im)
   sparseInit.memDataOffs = new MemIDOffset[boundMems.size()];
 
   if(opaqueCount > 0)
-    memcpy(sparseInit.opaque, &sparse->opaquemappings[0], sizeof(VkSparseMemoryBind) * opaqueCount);
+    memcpy(sparseInit.opaque, opaqueBinds.data(), sizeof(VkSparseMemoryBind) * opaqueCount);
 
   for(uint32_t a = 0; a < NUM_VK_IMAGE_ASPECTS; a++)
   {
@@ -23,6 +23,11 @@
  ******************************************************************************/
 
 #include "../vk_core.h"
+#include "core/settings.h"
+
+RDOC_DEBUG_CONFIG(bool, Vulkan_Debug_DisableRerecordCaching, false,
+                  "Disable caching and re-use of fully re-recorded command buffers between "
+                  "replays, re-recording every command buffer from scratch on each replay.");
 
 static rdcstr ToHumanStr(const VkAttachmentLoadOp &el)
 {
@@ -811,7 +816,59 @@ bool WrappedVulkan::Serialise_vkBeginCommandBuffer(SerialiserType &ser, VkComman
         }
       }
 
-      if(rerecord)
+      // command buffers that are completely contained within the replayed range re-record
+      // identically on every replay, so we cache them across replays and when we see one again we
+      // re-use it and skip over its serialised commands entirely. We can't re-use recordings while
+      // a drawcall callback is registered, since callbacks modify the commands as they're recorded.
+      bool cacheable = rerecord && !partial && m_DrawcallCallback == NULL &&
+                       !Vulkan_Debug_DisableRerecordCaching &&
+                       m_BakedCmdBufferInfo[BakedCommandBuffer].postEndChunkOffset > 0;
+
+      // better still, if the application didn't record the command buffer as one-time submit and
+      // no resources are currently replaced, the baked command buffer recorded while loading can
+      // be submitted again verbatim - then even the first replay after a load doesn't need to
+      // re-record it.
+      bool reusable = cacheable &&
+                      (BeginInfo.flags & VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT) == 0 &&
+                      !GetResourceManager()->HasReplacements() &&
+                      GetResourceManager()->HasLiveResource(BakedCommandBuffer);
+
+      auto cachedIt =
+          cacheable ? m_RerecordCachedCmds.find(BakedCommandBuffer) : m_RerecordCachedCmds.end();
+
+      if(reusable || (cacheable && cachedIt != m_RerecordCachedCmds.end()))
+      {
+        VkCommandBuffer cmd =
+            reusable ? GetResourceManager()->GetLiveHandle<VkCommandBuffer>(BakedCommandBuffer)
+                     : cachedIt->second.second;
+
+#if ENABLED(VERBOSE_PARTIAL_REPLAY)
+        RDCDEBUG("vkBegin - re-using %s of %s -> %s as %s",
+                 reusable ? "baked command buffer" : "cached re-recording",
+                 ToStr(m_LastCmdBufferID).c_str(), ToStr(BakedCommandBuffer).c_str(),
+                 ToStr(GetResID(cmd)).c_str());
+#endif
+
+        // store under both baked and non baked ID, see below for reasoning
+        m_RerecordCmds[BakedCommandBuffer] = cmd;
+        m_RerecordCmds[m_LastCmdBufferID] = cmd;
+        InsertCommandQueueFamily(GetResID(cmd), FindCommandQueueFamily(m_LastCmdBufferID));
+
+        if(AllocateInfo.level == VK_COMMAND_BUFFER_LEVEL_SECONDARY)
+        {
+          if(BeginInfo.pInheritanceInfo->renderPass != VK_NULL_HANDLE)
+            m_BakedCmdBufferInfo[BakedCommandBuffer].state.renderPass =
+                GetResID(BeginInfo.pInheritanceInfo->renderPass);
+          if(BeginInfo.pInheritanceInfo->framebuffer != VK_NULL_HANDLE)
+            m_BakedCmdBufferInfo[BakedCommandBuffer].state.SetFramebuffer(
+                this, GetResID(BeginInfo.pInheritanceInfo->framebuffer));
+        }
+
+        // nothing needs re-recording, so tell the replay loop to jump the reader past all of this
+        // command buffer's chunks, including the vkEndCommandBuffer.
+        m_RerecordSkipOffset = m_BakedCmdBufferInfo[BakedCommandBuffer].postEndChunkOffset;
+      }
+      else if(rerecord)
       {
         VkCommandBuffer cmd = VK_NULL_HANDLE;
         VkCommandBufferAllocateInfo unwrappedInfo = AllocateInfo;
@@ -848,6 +905,15 @@ bool WrappedVulkan::Serialise_vkBeginCommandBuffer(SerialiserType &ser, VkComman
 
         m_RerecordCmdList.push_back({AllocateInfo.commandPool, cmd});
 
+        // if this recording can be re-used on subsequent replays, remember it. Once the recording
+        // completes in vkEndCommandBuffer it moves from the per-replay list above into the cache.
+        // Make sure it isn't recorded as one-time submit, as it will be submitted every replay.
+        if(cacheable)
+        {
+          m_RerecordCachePending = BakedCommandBuffer;
+          unwrappedBeginInfo.flags &= ~VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+        }
+
         m_BakedCmdBufferInfo[GetResID(cmd)].level = AllocateInfo.level;
         m_BakedCmdBufferInfo[GetResID(cmd)].beginFlags = BeginInfo.flags;
 
@@ -1136,6 +1202,17 @@ bool WrappedVulkan::Serialise_vkEndCommandBuffer(SerialiserType &ser, VkCommandB
 
         ObjDisp(commandBuffer)->EndCommandBuffer(Unwrap(commandBuffer));
 
+        // now that the recording has completed it's safe to re-use on subsequent replays, so move
+        // it from the per-replay list into the cache.
+        if(m_RerecordCachePending == BakedCommandBuffer && !m_RerecordCmdList.empty() &&
+           m_RerecordCmdList.back().second == commandBuffer)
+        {
+          m_RerecordCachedCmds[BakedCommandBuffer] = m_RerecordCmdList.back();
+          m_RerecordCmdList.pop_back();
+        }
+
+        m_RerecordCachePending = ResourceId();
+
         // TODO: preserve so that m_RenderState can be updated at the end
         // of replay.
         // if(m_Partial[Primary].partialParent == BakedCommandBuffer)
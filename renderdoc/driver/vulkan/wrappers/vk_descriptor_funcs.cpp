@@ -522,6 +522,7 @@ VkResult WrappedVulkan::vkAllocateDescriptorSets(VkDevice device,
       record->descInfo = new DescriptorSetData();
       record->descInfo->layout = layoutRecord->descInfo->layout;
       record->descInfo->layout->CreateBindingsArray(record->descInfo->descBindings);
+      record->descInfo->writtenHighWater.fill(record->descInfo->descBindings.size(), 0);
     }
     else
     {
@@ -1029,6 +1030,9 @@ void WrappedVulkan::vkUpdateDescriptorSets(VkDevice device, uint32_t writeCount,
 
       const DescSetLayout::Binding *layoutBinding = &layout.bindings[descWrite.dstBinding];
 
+      uint32_t bindIdx = descWrite.dstBinding;
+      rdcarray<uint32_t> &highWater = record->descInfo->writtenHighWater;
+
       FrameRefType ref = GetRefType(layoutBinding->descriptorType);
 
       // We need to handle the cases where these bindings are stale:
@@ -1066,9 +1070,12 @@ void WrappedVulkan::vkUpdateDescriptorSets(VkDevice device, uint32_t writeCount,
         {
           layoutBinding++;
           binding++;
+          bindIdx++;
           curIdx = 0;
         }
 
+        highWater[bindIdx] = RDCMAX(highWater[bindIdx], curIdx + 1);
+
         DescriptorSetSlot &bind = (*binding)[curIdx];
 
         bind.RemoveBindRefs(GetResourceManager(), record);
@@ -1129,6 +1136,9 @@ void WrappedVulkan::vkUpdateDescriptorSets(VkDevice device, uint32_t writeCount,
       DescriptorSetSlot **srcbinding =
           &srcrecord->descInfo->descBindings[pDescriptorCopies[i].srcBinding];
 
+      uint32_t dstBindIdx = pDescriptorCopies[i].dstBinding;
+      rdcarray<uint32_t> &dstHighWater = dstrecord->descInfo->writtenHighWater;
+
       const DescSetLayout::Binding *dstlayoutBinding =
           &dstlayout.bindings[pDescriptorCopies[i].dstBinding];
       const DescSetLayout::Binding *srclayoutBinding =
@@ -1147,6 +1157,7 @@ void WrappedVulkan::vkUpdateDescriptorSets(VkDevice device, uint32_t writeCount,
         {
           dstlayoutBinding++;
           dstbinding++;
+          dstBindIdx++;
           curDstIdx = 0;
         }
 
@@ -1158,6 +1169,8 @@ void WrappedVulkan::vkUpdateDescriptorSets(VkDevice device, uint32_t writeCount,
           curSrcIdx = 0;
         }
 
+        dstHighWater[dstBindIdx] = RDCMAX(dstHighWater[dstBindIdx], curDstIdx + 1);
+
         DescriptorSetSlot &bind = (*dstbinding)[curDstIdx];
 
         bind.RemoveBindRefs(GetResourceManager(), dstrecord);
@@ -1414,6 +1427,9 @@ void WrappedVulkan::vkUpdateDescriptorSetWithTemplate(
 
       const DescSetLayout::Binding *layoutBinding = &layout.bindings[entry.dstBinding];
 
+      uint32_t bindIdx = entry.dstBinding;
+      rdcarray<uint32_t> &highWater = record->descInfo->writtenHighWater;
+
       FrameRefType ref = GetRefType(layoutBinding->descriptorType);
 
       // start at the dstArrayElement
@@ -1436,9 +1452,12 @@ void WrappedVulkan::vkUpdateDescriptorSetWithTemplate(
         {
           layoutBinding++;
           binding++;
+          bindIdx++;
           curIdx = 0;
         }
 
+        highWater[bindIdx] = RDCMAX(highWater[bindIdx], curIdx + 1);
+
         const byte *src = (const byte *)pData + entry.offset + entry.stride * d;
 
         DescriptorSetSlot &bind = (*binding)[curIdx];
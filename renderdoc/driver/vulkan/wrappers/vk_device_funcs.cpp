@@ -791,6 +791,9 @@ void WrappedVulkan::Shutdown()
   SubmitSemaphores();
   FlushQ();
 
+  // return any cached re-recorded command buffers to their pools
+  FreeRerecordCache();
+
   // destroy any events we created for waiting on
   for(size_t i = 0; i < m_PersistentEvents.size(); i++)
     ObjDisp(GetDev())->DestroyEvent(Unwrap(GetDev()), m_PersistentEvents[i], NULL);
@@ -819,6 +822,10 @@ void WrappedVulkan::Shutdown()
     GetResourceManager()->ReleaseWrappedResource(m_InternalCmds.freesems[i]);
   }
 
+  // internal fences are unwrapped, destroy them directly
+  for(size_t i = 0; i < m_InternalCmds.freefences.size(); i++)
+    ObjDisp(m_Device)->DestroyFence(Unwrap(m_Device), m_InternalCmds.freefences[i], NULL);
+
   for(size_t i = 0; i < m_ExternalQueues.size(); i++)
   {
     if(m_ExternalQueues[i].buffer != VK_NULL_HANDLE)
@@ -3587,6 +3594,10 @@ void WrappedVulkan::vkDestroyDevice(VkDevice device, const VkAllocationCallbacks
     GetResourceManager()->ReleaseWrappedResource(m_InternalCmds.freesems[i]);
   }
 
+  // internal fences are unwrapped, destroy them directly
+  for(size_t i = 0; i < m_InternalCmds.freefences.size(); i++)
+    ObjDisp(m_Device)->DestroyFence(Unwrap(m_Device), m_InternalCmds.freefences[i], NULL);
+
   for(size_t i = 0; i < m_ExternalQueues.size(); i++)
   {
     if(m_ExternalQueues[i].buffer != VK_NULL_HANDLE)
@@ -121,6 +121,7 @@ VkIndirectPatchData WrappedVulkan::FetchIndirectData(VkIndirectPatchType type,
   VkIndirectPatchData indirectPatch;
   indirectPatch.type = type;
   indirectPatch.alloc = alloc;
+  indirectPatch.size = bufInfo.size;
   indirectPatch.count = count;
   indirectPatch.stride = stride;
   indirectPatch.buf = paramsbuf;
@@ -157,6 +158,35 @@ void WrappedVulkan::ExecuteIndirectReadback(VkCommandBuffer commandBuffer,
   }
 }
 
+void WrappedVulkan::GetIndirectReadbackData(const VkIndirectPatchData &indirectPatch, bytebuf &argbuf)
+{
+  // the copies recorded by FetchIndirectData have landed in host-visible readback memory by the
+  // time this is called, so we can map the allocation directly instead of doing a GPU round trip
+  // per indirect call through the debug manager.
+  const MemoryAllocation &alloc = indirectPatch.alloc;
+
+  argbuf.clear();
+
+  if(alloc.mem == VK_NULL_HANDLE)
+    return;
+
+  byte *ptr = NULL;
+  VkResult vkr = ObjDisp(m_Device)->MapMemory(Unwrap(m_Device), Unwrap(alloc.mem), alloc.offs,
+                                              alloc.size, 0, (void **)&ptr);
+  RDCASSERTEQUAL(vkr, VK_SUCCESS);
+
+  VkMappedMemoryRange range = {
+      VK_STRUCTURE_TYPE_MAPPED_MEMORY_RANGE, NULL, Unwrap(alloc.mem), alloc.offs, alloc.size,
+  };
+
+  vkr = ObjDisp(m_Device)->InvalidateMappedMemoryRanges(Unwrap(m_Device), 1, &range);
+  RDCASSERTEQUAL(vkr, VK_SUCCESS);
+
+  argbuf.assign(ptr, (size_t)indirectPatch.size);
+
+  ObjDisp(m_Device)->UnmapMemory(Unwrap(m_Device), Unwrap(alloc.mem));
+}
+
 bool WrappedVulkan::IsDrawInRenderPass()
 {
   BakedCmdBufferInfo &cmd = m_BakedCmdBufferInfo[m_LastCmdBufferID];
@@ -25,6 +25,13 @@
 #include <algorithm>
 #include "../vk_core.h"
 #include "../vk_debug.h"
+#include "common/threading.h"
+#include "core/settings.h"
+
+RDOC_CONFIG(bool, Vulkan_CoherentMapWriteWatch, true,
+            "Use OS dirty page tracking (where available) to narrow down the diffs of "
+            "persistently mapped coherent memory at capture time, instead of comparing the "
+            "whole mapping against a reference copy.");
 
 template <typename SerialiserType>
 bool WrappedVulkan::Serialise_vkGetDeviceQueue(SerialiserType &ser, VkDevice device,
@@ -254,6 +261,26 @@ bool WrappedVulkan::Serialise_vkQueueSubmit(SerialiserType &ser, VkQueue queue,
 
         ObjDisp(queue)->QueueSubmit(Unwrap(queue), 1, &unwrapped, VK_NULL_HANDLE);
 
+        // if any of these command buffers recorded indirect argument readbacks, wait for the
+        // submit once here. The arguments were batch-copied to host-visible memory by commands
+        // baked into the command buffers themselves, so after this single sync each indirect call
+        // just maps its results - no per-call GPU round trips while patching the draws below.
+        for(uint32_t c = 0; c < submitInfo.commandBufferCount; c++)
+        {
+          ResourceId cmd =
+              GetResourceManager()->GetOriginalID(GetResID(submitInfo.pCommandBuffers[c]));
+
+          bool hasIndirect = false;
+          for(const VulkanDrawcallTreeNode &n : m_BakedCmdBufferInfo[cmd].draw->children)
+            hasIndirect |= (n.indirectPatch.type != VkIndirectPatchType::NoPatch);
+
+          if(hasIndirect)
+          {
+            ObjDisp(queue)->QueueWaitIdle(Unwrap(queue));
+            break;
+          }
+        }
+
         AddEvent();
 
         // we're adding multiple events, need to increment ourselves
@@ -572,7 +599,7 @@ void WrappedVulkan::InsertDrawsAndRefreshIDs(BakedCmdBufferInfo &cmdBufInfo)
     {
       VkDispatchIndirectCommand unknown = {0};
       bytebuf argbuf;
-      GetDebugManager()->GetBufferData(GetResID(n.indirectPatch.buf), 0, 0, argbuf);
+      GetIndirectReadbackData(n.indirectPatch, argbuf);
       VkDispatchIndirectCommand *args = (VkDispatchIndirectCommand *)&argbuf[0];
 
       if(argbuf.size() < sizeof(VkDispatchIndirectCommand))
@@ -596,7 +623,7 @@ void WrappedVulkan::InsertDrawsAndRefreshIDs(BakedCmdBufferInfo &cmdBufInfo)
       bool hasCount = (n.indirectPatch.type == VkIndirectPatchType::DrawIndirectCount ||
                        n.indirectPatch.type == VkIndirectPatchType::DrawIndexedIndirectCount);
       bytebuf argbuf;
-      GetDebugManager()->GetBufferData(GetResID(n.indirectPatch.buf), 0, 0, argbuf);
+      GetIndirectReadbackData(n.indirectPatch, argbuf);
 
       byte *ptr = argbuf.begin(), *end = argbuf.end();
 
@@ -894,6 +921,11 @@ VkResult WrappedVulkan::vkQueueSubmit(VkQueue queue, uint32_t submitCount,
 
     std::set<ResourceId> refdIDs;
 
+    // memory frame refs of each submitted command buffer, gathered up so that large submits can
+    // be merged on worker threads below instead of serially interval-merging every command buffer
+    // into the resource manager.
+    rdcarray<std::map<ResourceId, MemRefs> *> cmdMemRefs;
+
     for(uint32_t s = 0; s < submitCount; s++)
     {
       for(uint32_t i = 0; i < pSubmits[s].commandBufferCount; i++)
@@ -974,7 +1006,7 @@ VkResult WrappedVulkan::vkQueueSubmit(VkQueue queue, uint32_t submitCount,
           record->bakedCommands->AddResourceReferences(GetResourceManager());
           record->bakedCommands->AddReferencedIDs(refdIDs);
 
-          GetResourceManager()->MergeReferencedMemory(record->bakedCommands->cmdInfo->memFrameRefs);
+          cmdMemRefs.push_back(&record->bakedCommands->cmdInfo->memFrameRefs);
 
           // ref the parent command buffer's alloc record, this will pull in the cmd buffer pool
           GetResourceManager()->MarkResourceFrameReferenced(
@@ -988,7 +1020,7 @@ VkResult WrappedVulkan::vkQueueSubmit(VkQueue queue, uint32_t submitCount,
             bakedSubcmds->AddResourceReferences(GetResourceManager());
             bakedSubcmds->AddReferencedIDs(refdIDs);
             UpdateImageStates(bakedSubcmds->cmdInfo->imageStates);
-            GetResourceManager()->MergeReferencedMemory(bakedSubcmds->cmdInfo->memFrameRefs);
+            cmdMemRefs.push_back(&bakedSubcmds->cmdInfo->memFrameRefs);
             GetResourceManager()->MarkResourceFrameReferenced(
                 subcmds[sub]->cmdInfo->allocRecord->GetResourceID(), eFrameRef_Read);
 
@@ -1011,15 +1043,80 @@ VkResult WrappedVulkan::vkQueueSubmit(VkQueue queue, uint32_t submitCount,
 
     if(capframe)
     {
+      // merge the gathered command buffer memory refs. For small submits do it directly, for
+      // large submits pre-merge the per-command buffer maps on the shared job workers so that
+      // only a handful of reduced maps have to be interval-merged into the resource manager.
+      const size_t parallelMergeThreshold = 16;
+
+      if(cmdMemRefs.size() < parallelMergeThreshold)
+      {
+        for(size_t i = 0; i < cmdMemRefs.size(); i++)
+          GetResourceManager()->MergeReferencedMemory(*cmdMemRefs[i]);
+      }
+      else
+      {
+        const size_t numMerges = 4;
+
+        std::map<ResourceId, MemRefs> mergedRefs[numMerges];
+
+        Threading::ParallelFor(numMerges, [numMerges, &mergedRefs, &cmdMemRefs](size_t t) {
+          std::map<ResourceId, MemRefs> &dst = mergedRefs[t];
+
+          for(size_t i = t; i < cmdMemRefs.size(); i += numMerges)
+          {
+            std::map<ResourceId, MemRefs> &src = *cmdMemRefs[i];
+
+            for(auto j = src.begin(); j != src.end(); ++j)
+            {
+              auto it = dst.find(j->first);
+              if(it == dst.end())
+                dst.insert(*j);
+              else
+                it->second.Merge(j->second);
+            }
+          }
+        });
+
+        for(size_t t = 0; t < numMerges; t++)
+          GetResourceManager()->MergeReferencedMemory(mergedRefs[t]);
+      }
+
       GetResourceManager()->MarkResourceFrameReferenced(GetResID(queue), eFrameRef_Read);
 
       if(fence != VK_NULL_HANDLE)
         GetResourceManager()->MarkResourceFrameReferenced(GetResID(fence), eFrameRef_Read);
 
+      bool writeWatch = Vulkan_CoherentMapWriteWatch && WriteWatch::Enable();
+
       rdcarray<VkResourceRecord *> maps;
       {
         SCOPED_LOCK(m_CoherentMapsLock);
         maps = m_CoherentMaps;
+
+        if(writeWatch)
+        {
+          // bank the OS-reported dirty ranges on every tracked map - referenced by this submit or
+          // not - then reset the tracking. The reset is process-global, so an unreferenced map's
+          // dirty pages must be remembered here for whichever later submit does reference it.
+          // Done under the coherent maps lock so a concurrent submit can't reset the tracking
+          // between our fetch and our bank.
+          for(VkResourceRecord *record : m_CoherentMaps)
+          {
+            MemMapState &state = *record->memMapState;
+
+            SCOPED_LOCK(state.mrLock);
+
+            if(state.mapCoherent && state.mappedPtr &&
+               !WriteWatch::Fetch(state.mappedPtr, (size_t)state.mapSize, state.osDirtyRanges))
+            {
+              // if the query failed we must treat the whole map as dirty
+              state.osDirtyRanges.clear();
+              state.osDirtyRanges.push_back(make_rdcpair((size_t)0, (size_t)state.mapSize));
+            }
+          }
+
+          WriteWatch::ResetAll();
+        }
       }
 
       for(auto it = maps.begin(); it != maps.end(); ++it)
@@ -1069,8 +1166,39 @@ VkResult WrappedVulkan::vkQueueSubmit(VkQueue queue, uint32_t submitCount,
           // if we have a previous set of data, compare.
           // otherwise just serialise it all
           if(state.refData)
-            found = FindDiffRange((byte *)state.mappedPtr, state.refData, (size_t)state.mapSize,
-                                  diffStart, diffEnd);
+          {
+            if(writeWatch)
+            {
+              // only the OS-reported dirty pages can have changed, so bound the diff by them and
+              // then narrow down to the exact changed bytes within that window. Note that a write
+              // landing between the fetch and the reset above can be lost, but the application is
+              // already racing the GPU if it writes memory this submit reads.
+              found = false;
+
+              if(!state.osDirtyRanges.empty())
+              {
+                size_t boundStart = state.osDirtyRanges[0].first;
+                size_t boundEnd = state.osDirtyRanges[0].second;
+
+                for(const rdcpair<size_t, size_t> &r : state.osDirtyRanges)
+                {
+                  boundStart = RDCMIN(boundStart, r.first);
+                  boundEnd = RDCMAX(boundEnd, r.second);
+                }
+
+                found = FindDiffRange((byte *)state.mappedPtr + boundStart,
+                                      state.refData + boundStart, boundEnd - boundStart, diffStart,
+                                      diffEnd);
+                diffStart += boundStart;
+                diffEnd += boundStart;
+              }
+            }
+            else
+            {
+              found = FindDiffRange((byte *)state.mappedPtr, state.refData, (size_t)state.mapSize,
+                                    diffStart, diffEnd);
+            }
+          }
           else
 #endif
             diffEnd = (size_t)state.mapSize;
@@ -1098,6 +1226,10 @@ VkResult WrappedVulkan::vkQueueSubmit(VkQueue queue, uint32_t submitCount,
             RDCDEBUG("Persistent map flush not needed for %s",
                      ToStr(record->GetResourceID()).c_str());
           }
+
+          // the map is now in sync with its reference data (either serialised above, or the dirty
+          // pages held identical bytes), so its banked dirty ranges are consumed
+          state.osDirtyRanges.clear();
         }
       }
 
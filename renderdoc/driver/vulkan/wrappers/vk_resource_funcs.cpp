@@ -801,7 +801,10 @@ bool WrappedVulkan::Serialise_vkFlushMappedMemoryRanges(SerialiserType &ser, VkD
 
     const byte *serialisedData = ser.GetWriter()->GetData() + offs;
 
-    memcpy(state->refData, serialisedData, (size_t)memRangeSize);
+    // the flush may only cover a subrange of the map, so copy to the matching offset in the
+    // reference data
+    memcpy(state->refData + (size_t)(MemRange.offset - state->mapOffset), serialisedData,
+           (size_t)memRangeSize);
   }
 
   return true;
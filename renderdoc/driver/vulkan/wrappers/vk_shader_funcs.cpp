@@ -23,6 +23,7 @@
  ******************************************************************************/
 
 #include "../vk_core.h"
+#include "../vk_shader_cache.h"
 #include "driver/shaders/spirv/spirv_reflect.h"
 
 template <>
@@ -255,7 +256,18 @@ bool WrappedVulkan::Serialise_vkCreateShaderModule(SerialiserType &ser, VkDevice
         live = GetResourceManager()->WrapResource(Unwrap(device), sh);
         GetResourceManager()->AddLiveResource(ShaderModule, sh);
 
-        m_CreationInfo.m_ShaderModule[live].Init(GetResourceManager(), m_CreationInfo, &CreateInfo);
+        // parsing the SPIR-V for reflection is pure CPU work and adds up over thousands of
+        // modules, so copy the code out of the chunk and parse on the shared job workers while
+        // loading continues. Consumers of the parsed module wait on this group first.
+        VulkanCreationInfo::ShaderModule *mod = &m_CreationInfo.m_ShaderModule[live];
+
+        rdcarray<uint32_t> *code = new rdcarray<uint32_t>(
+            (uint32_t *)CreateInfo.pCode, CreateInfo.codeSize / sizeof(uint32_t));
+
+        m_ShaderParseJobs.Add([mod, code]() {
+          mod->Init(*code);
+          delete code;
+        });
       }
     }
 
@@ -418,8 +430,10 @@ bool WrappedVulkan::Serialise_vkCreateGraphicsPipelines(
     VkRenderPass origRP = CreateInfo.renderPass;
     VkPipelineCache origCache = pipelineCache;
 
-    // don't use pipeline caches on replay
-    pipelineCache = VK_NULL_HANDLE;
+    // substitute our own pipeline cache for the application's. The app's cache contents aren't
+    // serialised, but ours is persisted to disk by the shader cache so a second load of the same
+    // capture skips most driver compilation.
+    pipelineCache = GetShaderCache()->GetPipeCache();
 
     // if we have pipeline executable properties, capture the data
     if(GetExtensions(NULL).ext_KHR_pipeline_executable_properties)
@@ -459,6 +473,9 @@ bool WrappedVulkan::Serialise_vkCreateGraphicsPipelines(
 
         VulkanCreationInfo::Pipeline &pipeInfo = m_CreationInfo.m_Pipeline[live];
 
+        // reflection against the pipeline's shader modules needs their SPIR-V parsed
+        m_ShaderParseJobs.Wait();
+
         pipeInfo.Init(GetResourceManager(), m_CreationInfo, live, &CreateInfo);
 
         ResourceId renderPassID = GetResID(CreateInfo.renderPass);
@@ -619,8 +636,8 @@ bool WrappedVulkan::Serialise_vkCreateComputePipelines(SerialiserType &ser, VkDe
 
     VkPipelineCache origCache = pipelineCache;
 
-    // don't use pipeline caches on replay
-    pipelineCache = VK_NULL_HANDLE;
+    // as with graphics pipelines, redirect creation through our own disk-persisted pipeline cache
+    pipelineCache = GetShaderCache()->GetPipeCache();
 
     // if we have pipeline executable properties, capture the data
     if(GetExtensions(NULL).ext_KHR_pipeline_executable_properties)
@@ -658,6 +675,9 @@ bool WrappedVulkan::Serialise_vkCreateComputePipelines(SerialiserType &ser, VkDe
         live = GetResourceManager()->WrapResource(Unwrap(device), pipe);
         GetResourceManager()->AddLiveResource(Pipeline, pipe);
 
+        // reflection against the pipeline's shader module needs its SPIR-V parsed
+        m_ShaderParseJobs.Wait();
+
         m_CreationInfo.m_Pipeline[live].Init(GetResourceManager(), m_CreationInfo, live, &CreateInfo);
       }
     }
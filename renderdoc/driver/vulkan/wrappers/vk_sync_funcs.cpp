@@ -830,8 +830,13 @@ bool WrappedVulkan::Serialise_vkCmdWaitEvents(
       else
         commandBuffer = VK_NULL_HANDLE;
 
-      // register to clean this event up once we're done replaying this section of the log
-      m_CleanupEvents.push_back(ev);
+      // if this command buffer's re-recording will be cached and re-used on later replays the
+      // event has to survive along with it, otherwise register to clean this event up once we're
+      // done replaying this section of the log
+      if(m_RerecordCachePending != ResourceId())
+        m_PersistentEvents.push_back(ev);
+      else
+        m_CleanupEvents.push_back(ev);
     }
     else
     {
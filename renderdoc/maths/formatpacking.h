@@ -106,3 +106,33 @@ typedef uint8_t byte;
 
 struct ResourceFormat;
 FloatVector ConvertComponents(const ResourceFormat &fmt, const byte *data);
+
+// batch equivalent of the above, decoding a whole stream of elements 'stride' bytes apart in one
+// pass. Equivalent to calling ConvertComponents() on each element, but with SIMD fast paths for
+// common formats - see the note on the batch half converters about NaN bit patterns.
+void ConvertComponents(const ResourceFormat &fmt, const byte *data, uint32_t stride, size_t count,
+                       FloatVector *dst);
+
+// repacking kernels shared by readback paths that have to fix up pixels on the CPU - e.g. the GLES
+// glGetTexImage emulation, which can often only read back RGBA8 and must strip or swizzle the
+// result afterwards.
+
+// strips the fourth component from tightly packed pixels with compByteWidth bytes per component,
+// e.g. converting an RGBA readback of an RGB texture. dst and src must not overlap.
+void ConvertRGBAToRGB(byte *dst, const byte *src, size_t compByteWidth, size_t count);
+
+// swaps the red and blue channels in-place in tightly packed 8-bit 4-component pixels.
+void SwapRedBlue8(byte *pixels, size_t count);
+
+// interleaving kernels for merging separately read-back depth and stencil planes into the packed
+// depth-stencil layout the rest of the code expects. dst must not overlap either source.
+
+// interleaves D16 and S8 planes into 32-bit pixels, with the stencil widened to 16 bits.
+void InterleaveD16S8(uint16_t *dst, const uint16_t *depth, const uint8_t *stencil, size_t count);
+
+// packs D24 planes (read as 32-bit values with garbage in the top bits) and S8 planes into packed
+// 32-bit pixels with stencil in the top 8 bits.
+void InterleaveD24S8(uint32_t *dst, const uint32_t *depth, const uint8_t *stencil, size_t count);
+
+// interleaves D32 and S8 planes into 64-bit pixels, with the stencil widened to 32 bits.
+void InterleaveD32S8(uint32_t *dst, const uint32_t *depth, const uint8_t *stencil, size_t count);
@@ -0,0 +1,158 @@
+/******************************************************************************
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019-2020 Baldur Karlsson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+#include "common/common.h"
+#include "half_convert.h"
+
+#if defined(__x86_64__) || defined(_M_X64)
+
+#include <immintrin.h>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+
+#define HALF_F16C 1
+
+#elif defined(__aarch64__) || defined(_M_ARM64)
+
+#include <arm_neon.h>
+
+#define HALF_NEON 1
+
+#endif
+
+#if defined(HALF_F16C)
+
+static bool HaveF16C()
+{
+  static int available = -1;
+
+  if(available < 0)
+  {
+    unsigned int ecx = 0;
+
+#if defined(_MSC_VER)
+    int regs[4] = {0, 0, 0, 0};
+    __cpuid(regs, 1);
+    ecx = (unsigned int)regs[2];
+#else
+    unsigned int eax = 0, ebx = 0, edx = 0;
+    __get_cpuid(1, &eax, &ebx, &ecx, &edx);
+#endif
+
+    // the conversion instructions are VEX encoded, so as well as F16C (bit 29) we need AVX
+    // (bit 28) and the OS to have enabled extended state saving (OSXSAVE, bit 27)
+    const unsigned int mask = 7U << 27;
+
+    available = (ecx & mask) == mask ? 1 : 0;
+  }
+
+  return available == 1;
+}
+
+#if !defined(_MSC_VER)
+__attribute__((target("f16c")))
+#endif
+static void
+ConvertFromHalfF16C(const uint16_t *src, float *dst, size_t count)
+{
+  for(; count >= 4; count -= 4, src += 4, dst += 4)
+    _mm_storeu_ps(dst, _mm_cvtph_ps(_mm_loadl_epi64((const __m128i *)src)));
+
+  for(; count > 0; count--)
+    *(dst++) = ConvertFromHalf(*(src++));
+}
+
+#if !defined(_MSC_VER)
+__attribute__((target("f16c")))
+#endif
+static void
+ConvertToHalfF16C(const float *src, uint16_t *dst, size_t count)
+{
+  for(; count >= 4; count -= 4, src += 4, dst += 4)
+    _mm_storel_epi64((__m128i *)dst,
+                     _mm_cvtps_ph(_mm_loadu_ps(src), _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC));
+
+  for(; count > 0; count--)
+    *(dst++) = ConvertToHalf(*(src++));
+}
+
+#elif defined(HALF_NEON)
+
+static void ConvertFromHalfNEON(const uint16_t *src, float *dst, size_t count)
+{
+  for(; count >= 4; count -= 4, src += 4, dst += 4)
+    vst1q_f32(dst, vcvt_f32_f16(vreinterpret_f16_u16(vld1_u16(src))));
+
+  for(; count > 0; count--)
+    *(dst++) = ConvertFromHalf(*(src++));
+}
+
+static void ConvertToHalfNEON(const float *src, uint16_t *dst, size_t count)
+{
+  for(; count >= 4; count -= 4, src += 4, dst += 4)
+    vst1_u16(dst, vreinterpret_u16_f16(vcvt_f16_f32(vld1q_f32(src))));
+
+  for(; count > 0; count--)
+    *(dst++) = ConvertToHalf(*(src++));
+}
+
+#endif
+
+void ConvertFromHalf(const uint16_t *src, float *dst, size_t count)
+{
+#if defined(HALF_F16C)
+  if(HaveF16C())
+  {
+    ConvertFromHalfF16C(src, dst, count);
+    return;
+  }
+#elif defined(HALF_NEON)
+  ConvertFromHalfNEON(src, dst, count);
+  return;
+#endif
+
+  for(size_t i = 0; i < count; i++)
+    dst[i] = ConvertFromHalf(src[i]);
+}
+
+void ConvertToHalf(const float *src, uint16_t *dst, size_t count)
+{
+#if defined(HALF_F16C)
+  if(HaveF16C())
+  {
+    ConvertToHalfF16C(src, dst, count);
+    return;
+  }
+#elif defined(HALF_NEON)
+  ConvertToHalfNEON(src, dst, count);
+  return;
+#endif
+
+  for(size_t i = 0; i < count; i++)
+    dst[i] = ConvertToHalf(src[i]);
+}
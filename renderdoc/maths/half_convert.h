@@ -34,6 +34,14 @@
 
 #pragma once
 
+#include <stddef.h>
+
+// batch conversions over arrays, using F16C/NEON conversion instructions where available with a
+// scalar fallback. Equivalent to calling the single-value converters per element, except that
+// NaNs may convert to a different (still NaN) bit pattern and negative zero is preserved.
+void ConvertFromHalf(const uint16_t *src, float *dst, size_t count);
+void ConvertToHalf(const float *src, uint16_t *dst, size_t count);
+
 inline uint16_t ConvertToHalf(float comp)
 {
   int *alias = (int *)&comp;
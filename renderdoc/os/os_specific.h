@@ -151,6 +151,7 @@ void SetCurrentThreadName(const rdcstr &name);
 typedef uint64_t ThreadHandle;
 ThreadHandle CreateThread(std::function<void()> entryFunc);
 uint64_t GetCurrentID();
+uint32_t GetCPUCoreCount();
 void JoinThread(ThreadHandle handle);
 void DetachThread(ThreadHandle handle);
 void CloseThread(ThreadHandle handle);
@@ -232,6 +233,42 @@ int64_t ExchAdd64(volatile int64_t *i, int64_t a);
 int32_t CmpExch32(volatile int32_t *dest, int32_t oldVal, int32_t newVal);
 };
 
+// OS-level dirty page tracking, used to narrow down diffs of large persistently mapped memory to
+// only the pages the application actually wrote. On linux this is backed by the kernel's
+// soft-dirty pagemap bits, which work on any mapping in the process. Not available everywhere -
+// callers must handle Enable() returning false and fall back to diffing whole ranges.
+namespace WriteWatch
+{
+// enables tracking for the whole process and verifies it actually works. Idempotent - subsequent
+// calls just return whether tracking is available.
+bool Enable();
+// appends to dirty the merged [start, end) byte offset ranges within [base, base+length) that have
+// been written since the last ResetAll() (or Enable()), expanded to page boundaries and clamped to
+// length. Returns false if tracking is unavailable or the query failed, in which case the caller
+// must assume the whole range is dirty.
+bool Fetch(void *base, size_t length, rdcarray<rdcpair<size_t, size_t>> &dirty);
+// resets tracking for the whole process. Per-range resets aren't possible, so callers must fetch
+// every range they care about before resetting.
+void ResetAll();
+
+// Per-allocation tracking, for memory we hand out ourselves (e.g. map intercept buffers). Unlike
+// the process-wide functions above this works on windows too, since GetWriteWatch() can track
+// allocations we make with MEM_WRITE_WATCH even though it can't track arbitrary memory.
+//
+// allocates size bytes of page-tracked memory, or returns NULL if per-allocation tracking isn't
+// available - callers fall back to a plain allocation and whole-range serialisation.
+byte *AllocTracked(size_t size);
+void FreeTracked(byte *ptr);
+// clears the write records for a tracked allocation, so subsequent fetches only report writes made
+// after this point.
+void ResetRange(void *base, size_t length);
+// appends to dirty the merged [start, end) byte offset ranges within [base, base+length) written
+// since the last reset, page-expanded and clamped as with Fetch(), and resets the records for the
+// range. base must point into an allocation from AllocTracked(). Returns false if the query
+// failed, in which case the caller must assume the whole range is dirty.
+bool FetchAndReset(void *base, size_t length, rdcarray<rdcpair<size_t, size_t>> &dirty);
+};
+
 namespace Callstack
 {
 class Stackwalk
@@ -266,6 +303,12 @@ void Init();
 Stackwalk *Collect();
 Stackwalk *Create();
 
+// cheap fixed-depth collection for the capture hot path: writes up to maxLevels return addresses
+// into addrs with no allocation, walking frame pointers where the full unwinder is too expensive.
+// Returns the number of levels written, which may be 0 if fast collection isn't available on this
+// platform or the frame chain isn't walkable - callers should fall back to Collect().
+size_t CollectFast(uint64_t *addrs, size_t maxLevels);
+
 StackResolver *MakeResolver(bool interactive, byte *moduleDB, size_t DBSize,
                             RENDERDOC_ProgressCallback);
 
@@ -318,6 +361,21 @@ bool feof(FILE *f);
 
 int fclose(FILE *f);
 
+// functions for memory-mapping a read-only view of a region of a file. The view shares pages with
+// any other process mapping the same file through the OS page cache. Returns NULL if mapping is
+// unsupported or fails for any reason - callers must fall back to buffered reads.
+struct FileMapping;
+FileMapping *map_region(FILE *f, uint64_t offset, uint64_t length);
+const byte *map_data(FileMapping *mapping);
+void map_close(FileMapping *mapping);
+
+// advisory hints about upcoming reads on a file, so the kernel can fetch data from disk while the
+// caller is busy decompressing or processing earlier data. Purely advisory and may be no-ops on
+// some platforms - correctness must never depend on them. A length of 0 means to the end of the
+// file.
+void fadvise_sequential(FILE *f, uint64_t offset, uint64_t length);
+void fadvise_willneed(FILE *f, uint64_t offset, uint64_t length);
+
 // functions for atomically appending to a log that may be in use in multiple
 // processes
 struct LogFileHandle;
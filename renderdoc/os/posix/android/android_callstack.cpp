@@ -67,6 +67,12 @@ Stackwalk *Create()
   return new AndroidCallstack(NULL, 0);
 }
 
+size_t CollectFast(uint64_t *addrs, size_t maxLevels)
+{
+  // callstack collection isn't supported on Android
+  return 0;
+}
+
 bool GetLoadedModules(byte *buf, size_t &size)
 {
   if(buf)
@@ -67,6 +67,12 @@ Stackwalk *Create()
   return new AndroidCallstack(NULL, 0);
 }
 
+size_t CollectFast(uint64_t *addrs, size_t maxLevels)
+{
+  // no fast collection implemented, callers fall back to the full Collect()
+  return 0;
+}
+
 bool GetLoadedModules(byte *buf, size_t &size)
 {
   if(buf)
@@ -115,6 +115,12 @@ Stackwalk *Create()
   return new GgpCallstack(NULL, 0);
 }
 
+size_t CollectFast(uint64_t *addrs, size_t maxLevels)
+{
+  // no fast collection implemented, callers fall back to the full Collect()
+  return 0;
+}
+
 bool GetLoadedModules(byte *buf, size_t &size)
 {
   // we just dump the whole file rather than pre-parsing, that way we can improve
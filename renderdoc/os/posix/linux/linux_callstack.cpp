@@ -29,16 +29,24 @@
 
 #include <execinfo.h>
 #include <link.h>
+#include <pthread.h>
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 #include <map>
 #include "common/common.h"
 #include "common/formatting.h"
 #include "os/os_specific.h"
+#include "strings/string_utils.h"
 
 void *renderdocBase = NULL;
 void *renderdocEnd = NULL;
 
+// per-thread stack bounds for validating frame pointers in CollectFast, cached because querying
+// them for the main thread means glibc parsing /proc/self/maps
+static uint64_t stackLowTLSSlot = 0;
+static uint64_t stackHighTLSSlot = 0;
+
 class LinuxCallstack : public Callstack::Stackwalk
 {
 public:
@@ -93,6 +101,9 @@ namespace Callstack
 {
 void Init()
 {
+  stackLowTLSSlot = Threading::AllocateTLSSlot();
+  stackHighTLSSlot = Threading::AllocateTLSSlot();
+
   // look for our own line
   FILE *f = FileIO::fopen("/proc/self/maps", "r");
 
@@ -125,6 +136,72 @@ Stackwalk *Create()
   return new LinuxCallstack(NULL, 0);
 }
 
+size_t CollectFast(uint64_t *addrs, size_t maxLevels)
+{
+  void *low = Threading::GetTLSValue(stackLowTLSSlot);
+  void *high = Threading::GetTLSValue(stackHighTLSSlot);
+
+  if(low == NULL)
+  {
+    pthread_attr_t attr;
+    if(pthread_getattr_np(pthread_self(), &attr) == 0)
+    {
+      void *stackaddr = NULL;
+      size_t stacksize = 0;
+      pthread_attr_getstack(&attr, &stackaddr, &stacksize);
+      pthread_attr_destroy(&attr);
+
+      low = stackaddr;
+      high = (byte *)stackaddr + stacksize;
+    }
+    else
+    {
+      // mark the bounds as unobtainable so we don't retry on every collection
+      low = high = (void *)(uintptr_t)1;
+    }
+
+    Threading::SetTLSValue(stackLowTLSSlot, low);
+    Threading::SetTLSValue(stackHighTLSSlot, high);
+  }
+
+  if(low == high)
+    return 0;
+
+  // walk the frame pointer chain directly rather than invoking the full unwinder. This depends
+  // on frame pointers being kept, so every frame is validated before it's dereferenced and we
+  // stop at the first one that looks suspicious rather than risk a crash.
+  byte *fp = (byte *)__builtin_frame_address(0);
+
+  size_t count = 0;
+
+  while(count < maxLevels)
+  {
+    // the frame must be aligned and far enough inside this thread's stack that reading two
+    // pointers from it can't fault
+    if(((uintptr_t)fp & (sizeof(void *) - 1)) != 0 || (void *)fp < low ||
+       (void *)(fp + 2 * sizeof(void *)) > high)
+      break;
+
+    byte *next = ((byte **)fp)[0];
+    void *ret = ((void **)fp)[1];
+
+    if(ret == NULL)
+      break;
+
+    // trim the levels of our own code at the start of the stack, as in Collect() above
+    if(count > 0 || ret < renderdocBase || ret >= renderdocEnd)
+      addrs[count++] = (uint64_t)ret;
+
+    // each frame must be strictly further up the stack
+    if(next <= fp)
+      break;
+
+    fp = next;
+  }
+
+  return count;
+}
+
 static int dl_iterate_callback(struct dl_phdr_info *info, size_t size, void *data)
 {
   if(info->dlpi_name == NULL)
@@ -194,7 +271,16 @@ struct LookupModule
 class LinuxResolver : public Callstack::StackResolver
 {
 public:
-  LinuxResolver(rdcarray<LookupModule> modules) { m_Modules = modules; }
+  LinuxResolver(rdcarray<LookupModule> modules)
+  {
+    m_Modules = modules;
+    m_ModuleCaches.resize(m_Modules.size());
+  }
+  ~LinuxResolver()
+  {
+    for(size_t i = 0; i < m_ModuleCaches.size(); i++)
+      SaveModuleCache(i);
+  }
   Callstack::AddressDetails GetAddr(uint64_t addr)
   {
     EnsureCached(addr);
@@ -203,6 +289,75 @@ public:
   }
 
 private:
+  // persistent per-module cache of addr2line results stored in the app folder, so repeat sessions
+  // on the same capture don't shell out for every address again.
+  struct ModuleCache
+  {
+    bool loaded = false;
+    bool dirty = false;
+    // keyed by module-relative address
+    std::map<uint64_t, Callstack::AddressDetails> entries;
+  };
+
+  rdcstr CacheFilename(size_t i)
+  {
+    rdcstr path = m_Modules[i].path;
+    return FileIO::GetAppFolderFilename(StringFormat::Fmt(
+        "symcache_%s_%08x.txt", get_basename(path).c_str(), strhash(path.c_str())));
+  }
+
+  void LoadModuleCache(size_t i)
+  {
+    ModuleCache &cache = m_ModuleCaches[i];
+
+    if(cache.loaded)
+      return;
+
+    cache.loaded = true;
+
+    rdcstr contents;
+    if(!FileIO::ReadAll(CacheFilename(i), contents))
+      return;
+
+    rdcarray<rdcstr> lines;
+    split(contents, lines, '\n');
+
+    for(const rdcstr &line : lines)
+    {
+      // relative address, line number, function, filename - tab separated since function
+      // signatures and paths can contain spaces
+      rdcarray<rdcstr> fields;
+      split(line, fields, '\t');
+
+      if(fields.size() != 4)
+        continue;
+
+      uint64_t relative = strtoull(fields[0].c_str(), NULL, 16);
+
+      Callstack::AddressDetails &details = cache.entries[relative];
+      details.line = (uint32_t)strtoul(fields[1].c_str(), NULL, 10);
+      details.function = fields[2];
+      details.filename = fields[3];
+    }
+
+    RDCLOG("Loaded %zu cached symbols for %s", cache.entries.size(), m_Modules[i].path);
+  }
+
+  void SaveModuleCache(size_t i)
+  {
+    ModuleCache &cache = m_ModuleCaches[i];
+
+    if(!cache.dirty)
+      return;
+
+    rdcstr contents;
+    for(auto it = cache.entries.begin(); it != cache.entries.end(); ++it)
+      contents += StringFormat::Fmt("%llx\t%u\t%s\t%s\n", it->first, it->second.line,
+                                    it->second.function.c_str(), it->second.filename.c_str());
+
+    FileIO::WriteAll(CacheFilename(i), contents.c_str(), contents.length());
+  }
+
   void EnsureCached(uint64_t addr)
   {
     auto it = m_Cache.insert(
@@ -220,9 +375,21 @@ private:
     {
       if(addr >= m_Modules[i].base && addr < m_Modules[i].end)
       {
+        uint64_t relative = addr - m_Modules[i].base + m_Modules[i].offset;
+
+        LoadModuleCache(i);
+
+        ModuleCache &cache = m_ModuleCaches[i];
+
+        auto cacheit = cache.entries.find(relative);
+        if(cacheit != cache.entries.end())
+        {
+          ret = cacheit->second;
+          return;
+        }
+
         RDCLOG("%llx relative to module %llx-%llx, with offset %llx", addr, m_Modules[i].base,
                m_Modules[i].end, m_Modules[i].offset);
-        uint64_t relative = addr - m_Modules[i].base + m_Modules[i].offset;
         rdcstr cmd = StringFormat::Fmt("addr2line -fCe \"%s\" 0x%llx", m_Modules[i].path, relative);
 
         RDCLOG(": %s", cmd.c_str());
@@ -267,12 +434,16 @@ private:
           ret.filename = line2;
         }
 
+        cache.entries[relative] = ret;
+        cache.dirty = true;
+
         break;
       }
     }
   }
 
   rdcarray<LookupModule> m_Modules;
+  rdcarray<ModuleCache> m_ModuleCaches;
   std::map<uint64_t, Callstack::AddressDetails> m_Cache;
 };
 
@@ -24,11 +24,13 @@
 
 #include <dlfcn.h>
 #include <errno.h>
+#include <fcntl.h>
 #include <limits.h>
 #include <pwd.h>
 #include <signal.h>
 #include <stdlib.h>
 #include <string.h>
+#include <sys/mman.h>
 #include <sys/types.h>
 #include <sys/wait.h>
 #include <unistd.h>
@@ -902,6 +904,160 @@ void Process::Shutdown()
   }
 }
 
+// Dirty page tracking via the kernel's soft-dirty mechanism: writing "4" to /proc/self/clear_refs
+// zeroes the soft-dirty flag on every page in the process, after which bit 55 of the matching
+// /proc/self/pagemap entry identifies pages that have been written. Only linux implements this -
+// on other posix platforms the /proc files don't exist and Enable() fails cleanly.
+namespace WriteWatch
+{
+static bool initialised = false;
+static bool available = false;
+
+static const uint64_t pagemapSoftDirtyBit = 1ULL << 55;
+
+static bool ClearSoftDirty()
+{
+  int fd = open("/proc/self/clear_refs", O_WRONLY);
+  if(fd < 0)
+    return false;
+
+  ssize_t written = write(fd, "4", 1);
+  close(fd);
+
+  return written == 1;
+}
+
+bool Fetch(void *base, size_t length, rdcarray<rdcpair<size_t, size_t>> &dirty)
+{
+  if(!available || length == 0)
+    return false;
+
+  int fd = open("/proc/self/pagemap", O_RDONLY);
+  if(fd < 0)
+    return false;
+
+  const uint64_t pageSize = (uint64_t)sysconf(_SC_PAGESIZE);
+  const uint64_t baseAddr = (uint64_t)(uintptr_t)base;
+
+  uint64_t firstPage = baseAddr / pageSize;
+  uint64_t lastPage = (baseAddr + length + pageSize - 1) / pageSize;
+
+  // append [start, end) in absolute addresses, clamped to [base, base+length) and converted to
+  // offsets from base
+  auto appendRange = [&dirty, baseAddr, length](uint64_t start, uint64_t end) {
+    size_t clampedStart = start < baseAddr ? 0 : size_t(start - baseAddr);
+    size_t clampedEnd = size_t(RDCMIN(end - baseAddr, (uint64_t)length));
+    dirty.push_back(make_rdcpair(clampedStart, clampedEnd));
+  };
+
+  bool success = true;
+
+  bool inRange = false;
+  uint64_t rangeStart = 0;
+
+  uint64_t entries[1024];
+
+  for(uint64_t page = firstPage; page < lastPage;)
+  {
+    uint64_t count = RDCMIN(lastPage - page, (uint64_t)ARRAY_COUNT(entries));
+
+    ssize_t numRead =
+        pread(fd, entries, size_t(count * sizeof(uint64_t)), off_t(page * sizeof(uint64_t)));
+    if(numRead != ssize_t(count * sizeof(uint64_t)))
+    {
+      success = false;
+      break;
+    }
+
+    for(uint64_t i = 0; i < count; i++)
+    {
+      bool pageDirty = (entries[i] & pagemapSoftDirtyBit) != 0;
+
+      if(pageDirty && !inRange)
+      {
+        inRange = true;
+        rangeStart = (page + i) * pageSize;
+      }
+      else if(!pageDirty && inRange)
+      {
+        inRange = false;
+        appendRange(rangeStart, (page + i) * pageSize);
+      }
+    }
+
+    page += count;
+  }
+
+  if(success && inRange)
+    appendRange(rangeStart, lastPage * pageSize);
+
+  close(fd);
+
+  return success;
+}
+
+bool Enable()
+{
+  if(initialised)
+    return available;
+
+  initialised = true;
+
+  if(!ClearSoftDirty())
+    return false;
+
+  // kernels built without CONFIG_MEM_SOFT_DIRTY accept the clear_refs write but never set the
+  // pagemap flag, which would make every page look permanently clean. Verify tracking actually
+  // works by dirtying a page and checking it's reported.
+  size_t pageSize = (size_t)sysconf(_SC_PAGESIZE);
+  byte *test =
+      (byte *)mmap(NULL, pageSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if(test == MAP_FAILED)
+    return false;
+
+  *test = 1;
+
+  rdcarray<rdcpair<size_t, size_t>> dirty;
+  available = true;
+  available = Fetch(test, pageSize, dirty) && !dirty.empty();
+
+  munmap(test, pageSize);
+
+  return available;
+}
+
+void ResetAll()
+{
+  if(!available)
+    return;
+
+  // if the reset fails the tracked state is stale and can't be trusted any more, so disable
+  // tracking entirely - Fetch() will fail and callers will fall back to whole-range diffs.
+  if(!ClearSoftDirty())
+    available = false;
+}
+
+// soft-dirty tracking works on any mapping but can only be reset process-wide, so we can't offer
+// the per-allocation reset semantics. Callers that need them fall back to plain allocations.
+byte *AllocTracked(size_t size)
+{
+  return NULL;
+}
+
+void FreeTracked(byte *ptr)
+{
+}
+
+void ResetRange(void *base, size_t length)
+{
+}
+
+bool FetchAndReset(void *base, size_t length, rdcarray<rdcpair<size_t, size_t>> &dirty)
+{
+  return false;
+}
+};    // namespace WriteWatch
+
 #if ENABLED(ENABLE_UNIT_TESTS)
 
 #include "catch/catch.hpp"
@@ -32,6 +32,7 @@
 #include <stdlib.h>
 #include <string.h>
 #include <sys/file.h>
+#include <sys/mman.h>
 #include <sys/stat.h>
 #include <sys/types.h>
 #include <time.h>
@@ -433,6 +434,91 @@ bool feof(FILE *f)
   return ::feof(f) != 0;
 }
 
+struct FileMapping
+{
+  void *base;
+  size_t length;
+  const byte *data;
+};
+
+FileMapping *map_region(FILE *f, uint64_t offset, uint64_t length)
+{
+  if(f == NULL || length == 0)
+    return NULL;
+
+  int fd = ::fileno(f);
+
+  if(fd < 0)
+    return NULL;
+
+  // mmap requires a page-aligned offset, so map from the previous page boundary and offset the
+  // data pointer within the view.
+  uint64_t pageSize = (uint64_t)sysconf(_SC_PAGESIZE);
+  uint64_t alignedOffset = AlignDown(offset, pageSize);
+  uint64_t delta = offset - alignedOffset;
+
+  void *base = ::mmap(NULL, (size_t)(length + delta), PROT_READ, MAP_SHARED, fd,
+                      (off_t)alignedOffset);
+
+  if(base == MAP_FAILED)
+    return NULL;
+
+  FileMapping *ret = new FileMapping;
+  ret->base = base;
+  ret->length = (size_t)(length + delta);
+  ret->data = (const byte *)base + delta;
+  return ret;
+}
+
+const byte *map_data(FileMapping *mapping)
+{
+  return mapping ? mapping->data : NULL;
+}
+
+void map_close(FileMapping *mapping)
+{
+  if(mapping == NULL)
+    return;
+
+  ::munmap(mapping->base, mapping->length);
+  delete mapping;
+}
+
+void fadvise_sequential(FILE *f, uint64_t offset, uint64_t length)
+{
+#if defined(POSIX_FADV_SEQUENTIAL)
+  if(f == NULL)
+    return;
+
+  int fd = ::fileno(f);
+
+  if(fd >= 0)
+    ::posix_fadvise(fd, (off_t)offset, (off_t)length, POSIX_FADV_SEQUENTIAL);
+#else
+  // posix_fadvise isn't available (e.g. apple) - the hint is advisory so just skip it
+  (void)f;
+  (void)offset;
+  (void)length;
+#endif
+}
+
+void fadvise_willneed(FILE *f, uint64_t offset, uint64_t length)
+{
+#if defined(POSIX_FADV_WILLNEED)
+  if(f == NULL)
+    return;
+
+  int fd = ::fileno(f);
+
+  if(fd >= 0)
+    ::posix_fadvise(fd, (off_t)offset, (off_t)length, POSIX_FADV_WILLNEED);
+#else
+  (void)f;
+  (void)offset;
+  (void)length;
+#endif
+}
+
 void ftruncateat(FILE *f, uint64_t length)
 {
   ::fflush(f);
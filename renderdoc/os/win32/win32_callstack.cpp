@@ -1094,6 +1094,28 @@ Stackwalk *Create()
   return new Win32Callstack(NULL, 0);
 }
 
+size_t CollectFast(uint64_t *addrs, size_t maxLevels)
+{
+  // RtlCaptureStackBackTrace is already cheap, so the fast path just avoids the Stackwalk heap
+  // allocations by capturing straight into the caller's buffer
+  PVOID stack[64];
+
+  USHORT num = RtlCaptureStackBackTrace(0, (DWORD)RDCMIN<size_t>(maxLevels, ARRAY_COUNT(stack)),
+                                        stack, NULL);
+
+  USHORT offs = 0;
+
+  // trim our own levels at the start of the stack, as in Win32Callstack::Collect()
+  while(offs < num && (uint64_t)stack[offs] >= (uint64_t)renderdocBase &&
+        (uint64_t)stack[offs] <= (uint64_t)renderdocBase + renderdocSize)
+    offs++;
+
+  for(USHORT i = offs; i < num; i++)
+    addrs[i - offs] = (uint64_t)stack[i];
+
+  return num - offs;
+}
+
 StackResolver *MakeResolver(bool interactive, byte *moduleDB, size_t DBSize,
                             RENDERDOC_ProgressCallback progress)
 {
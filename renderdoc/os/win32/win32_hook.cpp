@@ -152,22 +152,29 @@ struct CachedHookData
   {
     ownmodule = NULL;
     missedOrdinals = false;
-    RDCEraseEl(lowername);
   }
 
   std::map<rdcstr, DllHookset> DllHooks;
   HMODULE ownmodule;
   Threading::CriticalSection lock;
-  char lowername[512];
 
   std::set<rdcstr> ignores;
 
+  // modules we've scanned and found import none of the DLLs we hook. Import tables are static,
+  // so there's no reason to walk them again on every LoadLibrary call - in a process with
+  // thousands of modules that reprocessing dominates. Keyed by handle and path, since a handle
+  // can be re-used after an unload.
+  std::map<HMODULE, std::wstring> uninterestingModules;
+
   bool missedOrdinals;
 
   volatile int32_t posthooking = 0;
 
   void ApplyHooks(const char *modName, HMODULE module)
   {
+    // local so that the initial scan can process modules on several threads
+    char lowername[512] = {};
+
     {
       size_t i = 0;
       while(modName[i])
@@ -194,74 +201,78 @@ struct CachedHookData
        strstr(lowername, STRINGIZE(RDOC_DLL_FILE) ".dll") == lowername)
       return;
 
-    // set module pointer if we are hooking exports from this module
-    for(auto it = DllHooks.begin(); it != DllHooks.end(); ++it)
+    // set module pointer if we are hooking exports from this module. Lock since the module and
+    // altmodules members are mutated here and modules can be processed concurrently.
     {
-      if(!_stricmp(it->first.c_str(), modName))
+      SCOPED_LOCK(lock);
+      for(auto it = DllHooks.begin(); it != DllHooks.end(); ++it)
       {
-        if(it->second.module == NULL)
+        if(!_stricmp(it->first.c_str(), modName))
         {
-          it->second.module = module;
-
-          it->second.hooksfetched = true;
-
-          // fetch all function hooks here, since we want to fill out the original function pointer
-          // even in case nothing imports from that function (which means it would not get filled
-          // out through FunctionHook::ApplyHook)
-          for(FunctionHook &hook : it->second.FunctionHooks)
+          if(it->second.module == NULL)
           {
-            if(hook.orig && *hook.orig == NULL)
-              *hook.orig = GetProcAddress(module, hook.function.c_str());
-          }
+            it->second.module = module;
 
-          it->second.FetchOrdinalNames();
-        }
-        else if(it->second.module != module)
-        {
-          // if it's already in altmodules, bail
-          bool already = false;
+            it->second.hooksfetched = true;
 
-          for(size_t i = 0; i < it->second.altmodules.size(); i++)
-          {
-            if(it->second.altmodules[i] == module)
+            // fetch all function hooks here, since we want to fill out the original function pointer
+            // even in case nothing imports from that function (which means it would not get filled
+            // out through FunctionHook::ApplyHook)
+            for(FunctionHook &hook : it->second.FunctionHooks)
             {
-              already = true;
-              break;
+              if(hook.orig && *hook.orig == NULL)
+                *hook.orig = GetProcAddress(module, hook.function.c_str());
             }
+
+            it->second.FetchOrdinalNames();
           }
+          else if(it->second.module != module)
+          {
+            // if it's already in altmodules, bail
+            bool already = false;
 
-          if(already)
-            break;
+            for(size_t i = 0; i < it->second.altmodules.size(); i++)
+            {
+              if(it->second.altmodules[i] == module)
+              {
+                already = true;
+                break;
+              }
+            }
 
-          // check if the previous module is still valid
-          SetLastError(0);
-          char filename[MAX_PATH] = {};
-          GetModuleFileNameA(it->second.module, filename, MAX_PATH - 1);
-          DWORD err = GetLastError();
-          char *slash = strrchr(filename, L'\\');
+            if(already)
+              break;
 
-          rdcstr basename = slash ? strlower(rdcstr(slash + 1)) : "";
+            // check if the previous module is still valid
+            SetLastError(0);
+            char filename[MAX_PATH] = {};
+            GetModuleFileNameA(it->second.module, filename, MAX_PATH - 1);
+            DWORD err = GetLastError();
+            char *slash = strrchr(filename, L'\\');
 
-          if(err == 0 && basename == it->first)
-          {
-            // previous module is still loaded, add this to the alt modules list
-            it->second.altmodules.push_back(module);
-          }
-          else
-          {
-            // previous module is no longer loaded or there's a new file there now, add this as the
-            // new location
-            RDCWARN("%s moved from %p to %p, re-initialising orig pointers", it->first.c_str(),
-                    it->second.module, module);
+            rdcstr basename = slash ? strlower(rdcstr(slash + 1)) : "";
 
-            // we also need to re-initialise the hooks as the orig pointers are now stale
-            for(FunctionHook &hook : it->second.FunctionHooks)
+            if(err == 0 && basename == it->first)
             {
-              if(hook.orig)
-                *hook.orig = GetProcAddress(module, hook.function.c_str());
+              // previous module is still loaded, add this to the alt modules list
+              it->second.altmodules.push_back(module);
             }
+            else
+            {
+              // previous module is no longer loaded or there's a new file there now, add this as the
+              // new location
+              RDCWARN("%s moved from %p to %p, re-initialising orig pointers", it->first.c_str(),
+                      it->second.module, module);
 
-            it->second.module = module;
+              // we also need to re-initialise the hooks as the orig pointers are now stale
+              for(FunctionHook &hook : it->second.FunctionHooks)
+              {
+                if(hook.orig)
+                  *hook.orig = GetProcAddress(module, hook.function.c_str());
+              }
+
+              it->second.module = module;
+            }
           }
         }
       }
@@ -291,6 +302,14 @@ struct CachedHookData
     GetModuleFileNameW(module, modpath, 1023);
     if(modpath[0] == 0)
       return;
+
+    // if we've already scanned this module and it imports nothing we hook, skip it
+    {
+      SCOPED_LOCK(lock);
+      auto cached = uninterestingModules.find(module);
+      if(cached != uninterestingModules.end() && cached->second == modpath)
+        return;
+    }
     // increment the module reference count, so it doesn't disappear while we're processing it
     // there's a very small race condition here between if GetModuleFileName returns, the module is
     // unloaded then we load it again. The only way around that is inserting very scary locks
@@ -322,6 +341,8 @@ struct CachedHookData
     RDCDEBUG("=== import descriptors:");
 #endif
 
+    bool anyHookedImports = false;
+
     while(iatOffset && importDesc->FirstThunk)
     {
       const char *dllName = (const char *)(baseAddress + importDesc->Name);
@@ -336,6 +357,9 @@ struct CachedHookData
         if(!_stricmp(it->first.c_str(), dllName))
           hookset = &it->second;
 
+      if(hookset)
+        anyHookedImports = true;
+
       if(hookset && importDesc->OriginalFirstThunk > 0)
       {
         IMAGE_THUNK_DATA *origFirst =
@@ -497,6 +521,12 @@ struct CachedHookData
       importDesc++;
     }
 
+    if(!anyHookedImports)
+    {
+      SCOPED_LOCK(lock);
+      uninterestingModules[module] = modpath;
+    }
+
     FreeLibrary(refcountModHandle);
   }
 };
@@ -562,10 +592,48 @@ static void ForAllModules(std::function<void(const MODULEENTRY32 &me32)> callbac
   CloseHandle(hModuleSnap);
 }
 
-static void HookAllModules()
+static void HookAllModules(bool parallelScan = false)
 {
-  ForAllModules(
-      [](const MODULEENTRY32 &me32) { s_HookData->ApplyHooks(me32.szModule, me32.hModule); });
+  rdcarray<MODULEENTRY32> modules;
+
+  ForAllModules([&modules](const MODULEENTRY32 &me32) { modules.push_back(me32); });
+
+  // the initial scan at injection time can see thousands of modules, and walking each one's
+  // import table is independent work - spread it over a few threads. Later calls from the
+  // LoadLibrary hooks only ever see a handful of unscanned modules, so they stay serial.
+  uint32_t threadCount = RDCMIN(8U, Threading::GetCPUCoreCount());
+
+  if(parallelScan && threadCount >= 2 && modules.size() >= 64)
+  {
+    volatile int32_t nextModule = 0;
+
+    rdcarray<Threading::ThreadHandle> threads;
+    for(uint32_t t = 0; t < threadCount; t++)
+    {
+      threads.push_back(Threading::CreateThread([&modules, &nextModule]() {
+        for(;;)
+        {
+          int32_t i = Atomic::Inc32(&nextModule) - 1;
+
+          if(i >= (int32_t)modules.size())
+            break;
+
+          s_HookData->ApplyHooks(modules[i].szModule, modules[i].hModule);
+        }
+      }));
+    }
+
+    for(Threading::ThreadHandle t : threads)
+    {
+      Threading::JoinThread(t);
+      Threading::CloseThread(t);
+    }
+  }
+  else
+  {
+    for(const MODULEENTRY32 &me32 : modules)
+      s_HookData->ApplyHooks(me32.szModule, me32.hModule);
+  }
 
   // check if we're already in this section of code, and if so don't go in again.
   int32_t prev = Atomic::CmpExch32(&s_HookData->posthooking, 0, 1);
@@ -890,7 +958,7 @@ void LibraryHooks::EndHookRegistration()
   RDCDEBUG("Applying hooks");
 #endif
 
-  HookAllModules();
+  HookAllModules(true);
 
   if(s_HookData->missedOrdinals)
   {
@@ -900,7 +968,7 @@ void LibraryHooks::EndHookRegistration()
 
     // we need to do a second pass now that we know ordinal names to finally hook
     // some imports by ordinal only.
-    HookAllModules();
+    HookAllModules(true);
 
     s_HookData->missedOrdinals = false;
   }
@@ -1649,3 +1649,110 @@ void Process::Shutdown()
 {
   // nothing to do
 }
+
+namespace WriteWatch
+{
+// GetWriteWatch() only works on memory we allocated ourselves with MEM_WRITE_WATCH, and the large
+// persistent mappings we want to track are returned by external drivers, so there's no
+// process-wide tracking we can apply to them from outside. Report it as unavailable and let
+// callers fall back to whole-range diffs. Per-allocation tracking below does work, because there
+// we control the allocation.
+bool Enable()
+{
+  return false;
+}
+
+bool Fetch(void *base, size_t length, rdcarray<rdcpair<size_t, size_t>> &dirty)
+{
+  return false;
+}
+
+void ResetAll()
+{
+}
+
+byte *AllocTracked(size_t size)
+{
+  return (byte *)VirtualAlloc(NULL, size, MEM_RESERVE | MEM_COMMIT | MEM_WRITE_WATCH,
+                              PAGE_READWRITE);
+}
+
+void FreeTracked(byte *ptr)
+{
+  if(ptr)
+    VirtualFree(ptr, 0, MEM_RELEASE);
+}
+
+void ResetRange(void *base, size_t length)
+{
+  ResetWriteWatch(base, length);
+}
+
+bool FetchAndReset(void *base, size_t length, rdcarray<rdcpair<size_t, size_t>> &dirty)
+{
+  if(length == 0)
+    return false;
+
+  SYSTEM_INFO sysinfo = {};
+  GetSystemInfo(&sysinfo);
+
+  const size_t pageSize = (size_t)sysinfo.dwPageSize;
+  const uintptr_t baseAddr = (uintptr_t)base;
+
+  void *addresses[1024];
+  uintptr_t queryAddr = baseAddr;
+  size_t remaining = length;
+
+  bool inRange = false;
+  size_t rangeStart = 0, rangeEnd = 0;
+
+  // append [start, end) in byte offsets from base, clamped to length
+  auto appendRange = [&dirty, length](size_t start, size_t end) {
+    dirty.push_back(make_rdcpair(start, RDCMIN(end, length)));
+  };
+
+  while(remaining > 0)
+  {
+    ULONG_PTR count = ARRAY_COUNT(addresses);
+    DWORD granularity = 0;
+
+    UINT ret = GetWriteWatch(WRITE_WATCH_FLAG_RESET, (void *)queryAddr, remaining, addresses,
+                             &count, &granularity);
+
+    if(ret != 0)
+      return false;
+
+    for(ULONG_PTR i = 0; i < count; i++)
+    {
+      size_t pageOffs = ((uintptr_t)addresses[i] - baseAddr) & ~(pageSize - 1);
+
+      if(inRange && pageOffs == rangeEnd)
+      {
+        rangeEnd += pageSize;
+      }
+      else
+      {
+        if(inRange)
+          appendRange(rangeStart, rangeEnd);
+
+        inRange = true;
+        rangeStart = pageOffs;
+        rangeEnd = pageOffs + pageSize;
+      }
+    }
+
+    // if the output array filled up, continue the query from just past the last reported page
+    if(count < ARRAY_COUNT(addresses))
+      break;
+
+    uintptr_t next = ((uintptr_t)addresses[count - 1] & ~(uintptr_t(pageSize) - 1)) + pageSize;
+    remaining -= RDCMIN(remaining, size_t(next - queryAddr));
+    queryAddr = next;
+  }
+
+  if(inRange)
+    appendRange(rangeStart, rangeEnd);
+
+  return true;
+}
+};    // namespace WriteWatch
@@ -636,6 +636,81 @@ bool feof(FILE *f)
   return ::feof(f) != 0;
 }
 
+struct FileMapping
+{
+  void *base;
+  const byte *data;
+};
+
+FileMapping *map_region(FILE *f, uint64_t offset, uint64_t length)
+{
+  if(f == NULL || length == 0)
+    return NULL;
+
+  HANDLE file = (HANDLE)_get_osfhandle(::_fileno(f));
+
+  if(file == INVALID_HANDLE_VALUE)
+    return NULL;
+
+  HANDLE mapping = ::CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+
+  if(mapping == NULL)
+    return NULL;
+
+  // the view offset must be aligned to the allocation granularity, so map from the previous
+  // boundary and offset the data pointer within the view.
+  SYSTEM_INFO sysInfo = {};
+  GetSystemInfo(&sysInfo);
+
+  uint64_t alignedOffset = AlignDown(offset, (uint64_t)sysInfo.dwAllocationGranularity);
+  uint64_t delta = offset - alignedOffset;
+
+  void *base = ::MapViewOfFile(mapping, FILE_MAP_READ, (DWORD)(alignedOffset >> 32),
+                               (DWORD)(alignedOffset & 0xffffffff), (SIZE_T)(length + delta));
+
+  // the view holds its own reference on the mapping object, so we can close ours immediately
+  ::CloseHandle(mapping);
+
+  if(base == NULL)
+    return NULL;
+
+  FileMapping *ret = new FileMapping;
+  ret->base = base;
+  ret->data = (const byte *)base + delta;
+  return ret;
+}
+
+const byte *map_data(FileMapping *mapping)
+{
+  return mapping ? mapping->data : NULL;
+}
+
+void map_close(FileMapping *mapping)
+{
+  if(mapping == NULL)
+    return;
+
+  ::UnmapViewOfFile(mapping->base);
+  delete mapping;
+}
+
+void fadvise_sequential(FILE *f, uint64_t offset, uint64_t length)
+{
+  // windows has no fadvise equivalent for an already-open CRT file - sequential scan behaviour
+  // can only be requested at CreateFile time, and the cache manager's default readahead already
+  // ramps up on sequential access patterns.
+  (void)f;
+  (void)offset;
+  (void)length;
+}
+
+void fadvise_willneed(FILE *f, uint64_t offset, uint64_t length)
+{
+  (void)f;
+  (void)offset;
+  (void)length;
+}
+
 void ftruncateat(FILE *f, uint64_t length)
 {
   ::fflush(f);
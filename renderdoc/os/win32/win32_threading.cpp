@@ -355,4 +355,11 @@ void Sleep(uint32_t milliseconds)
 {
   ::Sleep((DWORD)milliseconds);
 }
+
+uint32_t GetCPUCoreCount()
+{
+  SYSTEM_INFO sysInfo = {};
+  GetSystemInfo(&sysInfo);
+  return sysInfo.dwNumberOfProcessors > 0 ? (uint32_t)sysInfo.dwNumberOfProcessors : 1;
+}
 };
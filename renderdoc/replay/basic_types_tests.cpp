@@ -508,17 +508,18 @@ TEST_CASE("Test array type", "[basictypes]")
     CHECK(valueConstructor == 1);
     // for the temporary going out of scope
     CHECK(destructor == 2);
-    // for the temporary being copied into the new element
-    CHECK(copyConstructor == 2);
+    // the temporary is an rvalue so it's moved, not copied, into the new element
+    CHECK(moveConstructor == 1);
+    CHECK(copyConstructor == 1);
 
     // previous value
     CHECK(constructor == 1);
 
     test.reserve(1000);
 
-    // single element in test was moved to new backing storage
+    // single element in test was copied to new backing storage
     CHECK(destructor == 3);
-    CHECK(copyConstructor == 3);
+    CHECK(copyConstructor == 2);
 
     // previous values
     CHECK(valueConstructor == 1);
@@ -532,7 +533,7 @@ TEST_CASE("Test array type", "[basictypes]")
     // previous values
     CHECK(valueConstructor == 1);
     CHECK(destructor == 3);
-    CHECK(copyConstructor == 3);
+    CHECK(copyConstructor == 2);
 
     test.clear();
 
@@ -542,15 +543,16 @@ TEST_CASE("Test array type", "[basictypes]")
     // previous values
     CHECK(constructor == 50);
     CHECK(valueConstructor == 1);
-    CHECK(copyConstructor == 3);
+    CHECK(copyConstructor == 2);
 
-    // still should have had no moves
-    CHECK(moveConstructor == 0);
+    // still only the one move, from push_back of the temporary above
+    CHECK(moveConstructor == 1);
 
     // reset counters
     constructor = 0;
     valueConstructor = 0;
     copyConstructor = 0;
+    moveConstructor = 0;
     destructor = 0;
 
     CHECK(constructor == 0);
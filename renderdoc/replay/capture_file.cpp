@@ -760,6 +760,14 @@ bool CaptureFile::HasCallstacks()
 
 bool CaptureFile::InitResolver(bool interactive, RENDERDOC_ProgressCallback progress)
 {
+  // already initialised, don't pay for loading symbols again
+  if(m_Resolver)
+  {
+    if(progress)
+      progress(1.0f);
+    return true;
+  }
+
   if(!HasCallstacks())
   {
     RDCERR("Capture has no callstacks - can't initialise resolver.");
@@ -28,6 +28,7 @@
 #include "api/replay/version.h"
 #include "common/common.h"
 #include "common/formatting.h"
+#include "common/threading.h"
 #include "core/core.h"
 #include "maths/camera.h"
 #include "maths/formatpacking.h"
@@ -423,6 +424,70 @@ extern "C" RENDERDOC_API void *RENDERDOC_CC RENDERDOC_AllocArrayMem(uint64_t sz)
   return ret;
 }
 
+// Pooled allocator for structured data objects. Generating structured data for a capture
+// allocates an SDObject for every element of every chunk - easily millions of identically-sized
+// allocations - so instead of hitting the heap each time, freed objects are kept on per-size
+// freelists and recycled. Freed blocks store the freelist link in their first pointer-size bytes.
+namespace
+{
+struct StructuredMemPool
+{
+  static const size_t BucketGranularity = 32;
+  static const size_t BucketCount = 8;
+
+  void *freelist[BucketCount] = {};
+  Threading::SpinLock lock;
+};
+};
+
+static StructuredMemPool sdPool;
+
+// not exported, these are called from SDObject's allocation functions in-module
+void *RENDERDOC_AllocStructuredMem(size_t sz)
+{
+  size_t bucket = (sz - 1) / StructuredMemPool::BucketGranularity;
+
+  if(sz > 0 && bucket < StructuredMemPool::BucketCount)
+  {
+    Threading::ScopedSpinLock scoped(sdPool.lock);
+
+    void *ret = sdPool.freelist[bucket];
+
+    if(ret)
+    {
+      sdPool.freelist[bucket] = *(void **)ret;
+      return ret;
+    }
+
+    // allocate the full bucket size so the block is reusable for anything in this bucket
+    sz = (bucket + 1) * StructuredMemPool::BucketGranularity;
+  }
+
+  void *ret = malloc(sz);
+  if(ret == NULL)
+    RENDERDOC_OutOfMemory(sz);
+  return ret;
+}
+
+void RENDERDOC_FreeStructuredMem(void *mem, size_t sz)
+{
+  if(mem == NULL)
+    return;
+
+  size_t bucket = (sz - 1) / StructuredMemPool::BucketGranularity;
+
+  if(sz > 0 && bucket < StructuredMemPool::BucketCount)
+  {
+    Threading::ScopedSpinLock scoped(sdPool.lock);
+
+    *(void **)mem = sdPool.freelist[bucket];
+    sdPool.freelist[bucket] = mem;
+    return;
+  }
+
+  free(mem);
+}
+
 extern "C" RENDERDOC_API uint32_t RENDERDOC_CC RENDERDOC_EnumerateRemoteTargets(const char *URL,
                                                                                 uint32_t nextIdent)
 {
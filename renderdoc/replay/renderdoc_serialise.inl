@@ -111,6 +111,7 @@ void DoSerialise(SerialiserType &ser, CaptureOptions &el)
   SERIALISE_MEMBER(refAllResources);
   SERIALISE_MEMBER(captureAllCmdLists);
   SERIALISE_MEMBER(debugOutputMute);
+  SERIALISE_MEMBER(stripChunkMetadata);
 
   SIZE_CHECK(20);
 }
@@ -777,6 +778,18 @@ void DoSerialise(SerialiserType &ser, FrameDescription &el)
   SIZE_CHECK(1512);
 }
 
+template <typename SerialiserType>
+void DoSerialise(SerialiserType &ser, FrameEventTimings &el)
+{
+  SERIALISE_MEMBER(replayTime);
+  SERIALISE_MEMBER(outputsTime);
+  SERIALISE_MEMBER(eventTime);
+  SERIALISE_MEMBER(pipelineTime);
+  SERIALISE_MEMBER(totalTime);
+
+  SIZE_CHECK(20);
+}
+
 template <typename SerialiserType>
 void DoSerialise(SerialiserType &ser, FrameRecord &el)
 {
@@ -900,6 +913,17 @@ void DoSerialise(SerialiserType &ser, PixelModification &el)
   SIZE_CHECK(100);
 }
 
+template <typename SerialiserType>
+void DoSerialise(SerialiserType &ser, PixelDebugTarget &el)
+{
+  SERIALISE_MEMBER(x);
+  SERIALISE_MEMBER(y);
+  SERIALISE_MEMBER(sample);
+  SERIALISE_MEMBER(primitive);
+
+  SIZE_CHECK(16);
+}
+
 template <typename SerialiserType>
 void DoSerialise(SerialiserType &ser, EventUsage &el)
 {
@@ -2309,6 +2333,7 @@ INSTANTIATE_SERIALISE_TYPE(RasterizationStats)
 INSTANTIATE_SERIALISE_TYPE(OutputTargetStats)
 INSTANTIATE_SERIALISE_TYPE(FrameStatistics)
 INSTANTIATE_SERIALISE_TYPE(FrameDescription)
+INSTANTIATE_SERIALISE_TYPE(FrameEventTimings)
 INSTANTIATE_SERIALISE_TYPE(FrameRecord)
 INSTANTIATE_SERIALISE_TYPE(MeshFormat)
 INSTANTIATE_SERIALISE_TYPE(FloatVector)
@@ -2317,6 +2342,7 @@ INSTANTIATE_SERIALISE_TYPE(CounterDescription)
 INSTANTIATE_SERIALISE_TYPE(PixelValue)
 INSTANTIATE_SERIALISE_TYPE(Subresource)
 INSTANTIATE_SERIALISE_TYPE(PixelModification)
+INSTANTIATE_SERIALISE_TYPE(PixelDebugTarget)
 INSTANTIATE_SERIALISE_TYPE(EventUsage)
 INSTANTIATE_SERIALISE_TYPE(CounterResult)
 INSTANTIATE_SERIALISE_TYPE(CounterValue)
@@ -27,6 +27,9 @@
 #include <string.h>
 #include <time.h>
 #include "common/dds_readwrite.h"
+#include "common/threading.h"
+#include "common/timing.h"
+#include "core/settings.h"
 #include "driver/ihv/amd/amd_isa.h"
 #include "driver/ihv/amd/amd_rgp.h"
 #include "jpeg-compressor/jpgd.h"
@@ -40,6 +43,9 @@
 #include "strings/string_utils.h"
 #include "tinyexr/tinyexr.h"
 
+RDOC_CONFIG(bool, Replay_Debug_LogFrameEventTimings, false,
+            "Output a log message with the per-stage timings after every SetFrameEvent.");
+
 static void fileWriteFunc(void *context, void *data, int size)
 {
   FileIO::fwrite(data, 1, size, (FILE *)context);
@@ -94,19 +100,51 @@ void ReplayController::SetFrameEvent(uint32_t eventId, bool force)
 
   if(eventId != m_EventID || force)
   {
+    PROFILE_ZONE("ReplayController::SetFrameEvent");
+
     m_EventID = eventId;
 
+    PerformanceTimer totalTimer, stageTimer;
+
     m_pDevice->ReplayLog(eventId, eReplay_WithoutDraw);
 
+    m_FrameEventTimings.replayTime = (float)stageTimer.GetMilliseconds();
+    stageTimer.Restart();
+
     for(size_t i = 0; i < m_Outputs.size(); i++)
       m_Outputs[i]->SetFrameEvent(eventId);
 
+    m_FrameEventTimings.outputsTime = (float)stageTimer.GetMilliseconds();
+    stageTimer.Restart();
+
     m_pDevice->ReplayLog(eventId, eReplay_OnlyDraw);
 
+    m_FrameEventTimings.eventTime = (float)stageTimer.GetMilliseconds();
+    stageTimer.Restart();
+
     FetchPipelineState(eventId);
+
+    m_FrameEventTimings.pipelineTime = (float)stageTimer.GetMilliseconds();
+    m_FrameEventTimings.totalTime = (float)totalTimer.GetMilliseconds();
+
+    if(Replay_Debug_LogFrameEventTimings)
+    {
+      RDCLOG("SetFrameEvent(%u): %.2fms replay, %.2fms outputs, %.2fms event, %.2fms pipeline "
+             "state, %.2fms total",
+             eventId, m_FrameEventTimings.replayTime, m_FrameEventTimings.outputsTime,
+             m_FrameEventTimings.eventTime, m_FrameEventTimings.pipelineTime,
+             m_FrameEventTimings.totalTime);
+    }
   }
 }
 
+FrameEventTimings ReplayController::GetFrameEventTimings()
+{
+  CHECK_REPLAY_THREAD();
+
+  return m_FrameEventTimings;
+}
+
 const D3D11Pipe::State *ReplayController::GetD3D11PipelineState()
 {
   CHECK_REPLAY_THREAD();
@@ -168,11 +206,29 @@ rdcstr ReplayController::DisassembleShader(ResourceId pipeline, const ShaderRefl
   if(refl == NULL)
     return "; Error: No shader specified";
 
+  for(const DisassemblyCacheEntry &e : m_DisassemblyCache)
+    if(e.pipeline == pipeline && e.shader == refl->resourceId && e.target == target)
+      return e.text;
+
+  rdcstr text;
+
+  bool gcn = false;
   for(const rdcstr &t : m_GCNTargets)
-    if(t == target)
-      return GCNISA::Disassemble(refl->encoding, refl->stage, refl->rawBytes, target);
+    gcn |= (t == target);
 
-  return m_pDevice->DisassembleShader(m_pDevice->GetLiveID(pipeline), refl, target);
+  if(gcn)
+    text = GCNISA::Disassemble(refl->encoding, refl->stage, refl->rawBytes, target);
+  else
+    text = m_pDevice->DisassembleShader(m_pDevice->GetLiveID(pipeline), refl, target);
+
+  DisassemblyCacheEntry entry;
+  entry.pipeline = pipeline;
+  entry.shader = refl->resourceId;
+  entry.target = target;
+  entry.text = text;
+  m_DisassemblyCache.push_back(entry);
+
+  return text;
 }
 
 FrameDescription ReplayController::GetFrameInfo()
@@ -338,7 +394,7 @@ void ReplayController::AddFakeMarkers()
     if(end - start < 2 || !draws[i].children.empty() || !draws[refdraw].children.empty())
     {
       for(int j = start; j <= end; j++)
-        ret.push_back(draws[j]);
+        ret.push_back(std::move(draws[j]));
 
       start = i;
       refdraw = i;
@@ -392,10 +448,12 @@ void ReplayController::AddFakeMarkers()
 
     mark.children.resize(end - start + 1);
 
+    // refdraw is reset past this run below so none of these draws are referenced again, meaning
+    // they can be moved into the marker rather than duplicating the whole run
     for(int j = start; j <= end; j++)
-      mark.children[j - start] = draws[j];
+      mark.children[j - start] = std::move(draws[j]);
 
-    ret.push_back(mark);
+    ret.push_back(std::move(mark));
 
     start = i;
     refdraw = i;
@@ -404,10 +462,10 @@ void ReplayController::AddFakeMarkers()
   if(start < draws.count())
   {
     for(int j = start; j < draws.count(); j++)
-      ret.push_back(draws[j]);
+      ret.push_back(std::move(draws[j]));
   }
 
-  m_FrameRecord.drawcallList = ret;
+  m_FrameRecord.drawcallList = std::move(ret);
 
   // re-configure the previous/next pointeres
   m_Drawcalls.clear();
@@ -488,6 +546,80 @@ rdcarray<EventUsage> ReplayController::GetUsage(ResourceId id)
   return m_pDevice->GetUsage(id);
 }
 
+uint32_t ReplayController::GetLastWriteEID(ResourceId liveId)
+{
+  auto usageit = m_UsageCache.find(liveId);
+  if(usageit == m_UsageCache.end())
+    usageit = m_UsageCache.insert(std::make_pair(liveId, m_pDevice->GetUsage(liveId))).first;
+
+  const rdcarray<EventUsage> &usage = usageit->second;
+
+  // no recorded usage - this could be a replay-created texture like custom shader output whose
+  // contents change without any capture-side usage, so report it as unknown rather than static.
+  if(usage.empty())
+    return ~0U;
+
+  uint32_t ret = 0;
+
+  for(size_t i = 0; i < usage.size(); i++)
+  {
+    if(usage[i].eventId > m_EventID)
+      continue;
+
+    switch(usage[i].usage)
+    {
+      case ResourceUsage::VertexBuffer:
+      case ResourceUsage::IndexBuffer:
+      case ResourceUsage::VS_Constants:
+      case ResourceUsage::HS_Constants:
+      case ResourceUsage::DS_Constants:
+      case ResourceUsage::GS_Constants:
+      case ResourceUsage::PS_Constants:
+      case ResourceUsage::CS_Constants:
+      case ResourceUsage::All_Constants:
+      case ResourceUsage::VS_Resource:
+      case ResourceUsage::HS_Resource:
+      case ResourceUsage::DS_Resource:
+      case ResourceUsage::GS_Resource:
+      case ResourceUsage::PS_Resource:
+      case ResourceUsage::CS_Resource:
+      case ResourceUsage::All_Resource:
+      case ResourceUsage::InputTarget:
+      case ResourceUsage::CopySrc:
+      case ResourceUsage::ResolveSrc:
+      case ResourceUsage::Barrier:
+      case ResourceUsage::Indirect:
+        // read-only, doesn't change the contents
+        continue;
+
+      case ResourceUsage::Unused:
+      case ResourceUsage::CPUWrite:
+      case ResourceUsage::StreamOut:
+      case ResourceUsage::VS_RWResource:
+      case ResourceUsage::HS_RWResource:
+      case ResourceUsage::DS_RWResource:
+      case ResourceUsage::GS_RWResource:
+      case ResourceUsage::PS_RWResource:
+      case ResourceUsage::CS_RWResource:
+      case ResourceUsage::All_RWResource:
+      case ResourceUsage::ColorTarget:
+      case ResourceUsage::DepthStencilTarget:
+      case ResourceUsage::Clear:
+      case ResourceUsage::Copy:
+      case ResourceUsage::CopyDst:
+      case ResourceUsage::Resolve:
+      case ResourceUsage::ResolveDst:
+      case ResourceUsage::GenMips:
+        // writing, or conservatively assumed to write
+        break;
+    }
+
+    ret = RDCMAX(ret, usage[i].eventId);
+  }
+
+  return ret;
+}
+
 MeshFormat ReplayController::GetPostVSData(uint32_t instID, uint32_t viewID, MeshDataStage stage)
 {
   CHECK_REPLAY_THREAD();
@@ -552,6 +684,8 @@ bool ReplayController::SaveTexture(const TextureSave &saveData, const char *path
 {
   CHECK_REPLAY_THREAD();
 
+  PROFILE_ZONE("ReplayController::SaveTexture");
+
   TextureSave sd = saveData;    // mutable copy
   ResourceId liveid = m_pDevice->GetLiveID(sd.resourceId);
 
@@ -836,6 +970,47 @@ bool ReplayController::SaveTexture(const TextureSave &saveData, const char *path
     slicePitch = rowPitch * td.height;
   }
 
+  // for DDS we can stream each subresource straight to disk as it's fetched instead of buffering
+  // the whole texture, since the file payload is in the same slice-major order we fetch in.
+  // Channel extraction rewrites the fetched data afterwards, so it forces the buffered path.
+  FILE *streamFile = NULL;
+
+  if(sd.destType == FileType::DDS && sd.channelExtract < 0)
+  {
+    dds_data ddsData = {};
+
+    ResourceFormat saveFmt = td.format;
+    // use typeCast to inform typeless saving, otherwise it will get lost
+    if(saveFmt.compType == CompType::Typeless)
+      saveFmt.compType = sd.typeCast;
+
+    ddsData.width = td.width;
+    ddsData.height = td.height;
+    ddsData.depth = td.depth;
+    ddsData.format = saveFmt;
+    ddsData.mips = numMips;
+    ddsData.slices = numSlices / td.depth;
+    ddsData.cubemap = td.cubemap && numSlices == 6;
+
+    if(singleSlice)
+      ddsData.depth = ddsData.slices = 1;
+
+    streamFile = FileIO::fopen(path, "wb");
+
+    if(!streamFile)
+    {
+      RDCERR("Couldn't write to path %s, error: %s", path, FileIO::ErrorString().c_str());
+      return false;
+    }
+
+    if(!write_dds_header(streamFile, ddsData))
+    {
+      FileIO::fclose(streamFile);
+      FileIO::Delete(path);
+      return false;
+    }
+  }
+
   // loop over fetching subresources
   for(uint32_t s = 0; s < numSlices; s++)
   {
@@ -865,9 +1040,38 @@ bool ReplayController::SaveTexture(const TextureSave &saveData, const char *path
         for(size_t i = 0; i < subdata.size(); i++)
           delete[] subdata[i];
 
+        if(streamFile)
+        {
+          FileIO::fclose(streamFile);
+          FileIO::Delete(path);
+        }
+
         return false;
       }
 
+      // when streaming to DDS, write this subresource straight out and discard it rather than
+      // keeping a copy
+      if(streamFile)
+      {
+        uint64_t subSize = dds_subresource_size(td.format, td.width, td.height, m);
+
+        if(td.depth > 1 && numSlices == 1)
+        {
+          // we only want one depth slice out of a 3D texture, pick it out of the fetched data
+          FileIO::fwrite(data.data() + subSize * sliceOffset, 1, (size_t)subSize, streamFile);
+        }
+        else
+        {
+          uint32_t d = RDCMAX(1U, td.depth >> m);
+
+          FileIO::fwrite(data.data(), 1, (size_t)(subSize * d), streamFile);
+
+          s += (d - 1);
+        }
+
+        continue;
+      }
+
       if(td.depth == 1)
       {
         byte *bytes = new byte[data.size()];
@@ -923,6 +1127,13 @@ bool ReplayController::SaveTexture(const TextureSave &saveData, const char *path
     }
   }
 
+  // if we were streaming to DDS then all the subresource data has already been written
+  if(streamFile)
+  {
+    FileIO::fclose(streamFile);
+    return true;
+  }
+
   // should have been handled above, but verify incoming data is RGBA8 or RGBA32
   if(sd.slice.slicesAsGrid && (td.format.compByteWidth == 1 || td.format.compByteWidth == 4) &&
      td.format.compCount == 4 && !td.format.Special())
@@ -943,28 +1154,26 @@ bool ReplayController::SaveTexture(const TextureSave &saveData, const char *path
 
     memset(combinedData, 0, td.width * td.height * pixelStride);
 
-    for(size_t i = 0; i < subdata.size(); i++)
-    {
-      uint32_t gridx = (uint32_t)i % sd.slice.sliceGridWidth;
-      uint32_t gridy = (uint32_t)i / sd.slice.sliceGridWidth;
+    // each slice writes to a disjoint grid cell, so composite them in parallel. Rows within a
+    // cell are contiguous in both source and destination and can be copied whole.
+    const uint32_t gridPitch = td.width;
+    Threading::ParallelFor(
+        subdata.size(), [&sd, &subdata, combinedData, sliceWidth, sliceHeight, pixelStride,
+                         gridPitch](size_t i) {
+          uint32_t gridx = (uint32_t)i % sd.slice.sliceGridWidth;
+          uint32_t gridy = (uint32_t)i / sd.slice.sliceGridWidth;
 
-      uint32_t yoffs = gridy * sliceHeight;
-      uint32_t xoffs = gridx * sliceWidth;
-
-      for(uint32_t y = 0; y < sliceHeight; y++)
-      {
-        for(uint32_t x = 0; x < sliceWidth; x++)
-        {
-          uint32_t *srcpix = (uint32_t *)&subdata[i][(y * sliceWidth + x) * pixelStride + 0];
-          uint32_t *dstpix =
-              (uint32_t *)&combinedData[((y + yoffs) * td.width + x + xoffs) * pixelStride + 0];
+          uint32_t yoffs = gridy * sliceHeight;
+          uint32_t xoffs = gridx * sliceWidth;
 
-          memcpy(dstpix, srcpix, pixelStride);
-        }
-      }
+          for(uint32_t y = 0; y < sliceHeight; y++)
+          {
+            memcpy(&combinedData[((y + yoffs) * gridPitch + xoffs) * pixelStride],
+                   &subdata[i][y * sliceWidth * pixelStride], sliceWidth * pixelStride);
+          }
 
-      delete[] subdata[i];
-    }
+          delete[] subdata[i];
+        });
 
     subdata.resize(1);
     subdata[0] = combinedData;
@@ -1005,25 +1214,22 @@ bool ReplayController::SaveTexture(const TextureSave &saveData, const char *path
     uint32_t gridx[6] = {2, 0, 1, 1, 1, 3};
     uint32_t gridy[6] = {1, 1, 0, 2, 1, 1};
 
-    for(size_t i = 0; i < subdata.size(); i++)
-    {
-      uint32_t yoffs = gridy[i] * sliceHeight;
-      uint32_t xoffs = gridx[i] * sliceWidth;
+    // as with the grid above, the six faces land in disjoint cells and rows are contiguous
+    const uint32_t crossPitch = td.width;
+    Threading::ParallelFor(
+        subdata.size(), [&subdata, &gridx, &gridy, combinedData, sliceWidth, sliceHeight,
+                         pixelStride, crossPitch](size_t i) {
+          uint32_t yoffs = gridy[i] * sliceHeight;
+          uint32_t xoffs = gridx[i] * sliceWidth;
 
-      for(uint32_t y = 0; y < sliceHeight; y++)
-      {
-        for(uint32_t x = 0; x < sliceWidth; x++)
-        {
-          uint32_t *srcpix = (uint32_t *)&subdata[i][(y * sliceWidth + x) * pixelStride + 0];
-          uint32_t *dstpix =
-              (uint32_t *)&combinedData[((y + yoffs) * td.width + x + xoffs) * pixelStride + 0];
-
-          memcpy(dstpix, srcpix, pixelStride);
-        }
-      }
+          for(uint32_t y = 0; y < sliceHeight; y++)
+          {
+            memcpy(&combinedData[((y + yoffs) * crossPitch + xoffs) * pixelStride],
+                   &subdata[i][y * sliceWidth * pixelStride], sliceWidth * pixelStride);
+          }
 
-      delete[] subdata[i];
-    }
+          delete[] subdata[i];
+        });
 
     subdata.resize(1);
     subdata[0] = combinedData;
@@ -1042,37 +1248,37 @@ bool ReplayController::SaveTexture(const TextureSave &saveData, const char *path
     uint32_t compWidth = td.format.compByteWidth;
     uint32_t compCount = td.format.compCount;
 
-    uint32_t val = 0;
-    uint32_t max = ~0U;
+    byte *chanData = subdata[0];
+    const uint32_t chanWidth = td.width;
+    const int32_t chan = sd.channelExtract;
 
-    for(uint32_t y = 0; y < td.height; y++)
-    {
-      for(uint32_t x = 0; x < td.width; x++)
+    // rows are independent, so splat the channel in parallel
+    Threading::ParallelFor(td.height, [chanData, chanWidth, pixelStride, compWidth, compCount,
+                                       chan](size_t y) {
+      uint32_t val = 0;
+      uint32_t max = ~0U;
+
+      for(uint32_t x = 0; x < chanWidth; x++)
       {
-        memcpy(&val, &subdata[0][(y * td.width + x) * pixelStride + sd.channelExtract * compWidth],
-               td.format.compByteWidth);
+        memcpy(&val, &chanData[(y * chanWidth + x) * pixelStride + chan * compWidth], compWidth);
 
         switch(compCount)
         {
           case 4:
-            memcpy(&subdata[0][(y * td.width + x) * pixelStride + 3 * compWidth], &max,
-                   td.format.compByteWidth);
+            memcpy(&chanData[(y * chanWidth + x) * pixelStride + 3 * compWidth], &max, compWidth);
             DELIBERATE_FALLTHROUGH();
           case 3:
-            memcpy(&subdata[0][(y * td.width + x) * pixelStride + 2 * compWidth], &val,
-                   td.format.compByteWidth);
+            memcpy(&chanData[(y * chanWidth + x) * pixelStride + 2 * compWidth], &val, compWidth);
             DELIBERATE_FALLTHROUGH();
           case 2:
-            memcpy(&subdata[0][(y * td.width + x) * pixelStride + 1 * compWidth], &val,
-                   td.format.compByteWidth);
+            memcpy(&chanData[(y * chanWidth + x) * pixelStride + 1 * compWidth], &val, compWidth);
             DELIBERATE_FALLTHROUGH();
           case 1:
-            memcpy(&subdata[0][(y * td.width + x) * pixelStride + 0 * compWidth], &val,
-                   td.format.compByteWidth);
+            memcpy(&chanData[(y * chanWidth + x) * pixelStride + 0 * compWidth], &val, compWidth);
             break;
         }
       }
-    }
+    });
   }
 
   // handle formats that don't support alpha
@@ -1080,17 +1286,24 @@ bool ReplayController::SaveTexture(const TextureSave &saveData, const char *path
   {
     byte *nonalpha = new byte[td.width * td.height * 3];
 
-    for(uint32_t y = 0; y < td.height; y++)
+    if(sd.alpha == AlphaMapping::Discard)
     {
-      for(uint32_t x = 0; x < td.width; x++)
-      {
-        byte r = subdata[0][(y * td.width + x) * 4 + 0];
-        byte g = subdata[0][(y * td.width + x) * 4 + 1];
-        byte b = subdata[0][(y * td.width + x) * 4 + 2];
-        byte a = subdata[0][(y * td.width + x) * 4 + 3];
+      // no blending needed, this is a straight RGBA8 to RGB8 repack
+      ConvertRGBAToRGB(nonalpha, subdata[0], 1, size_t(td.width) * size_t(td.height));
+    }
+    else
+    {
+      byte *rgba = subdata[0];
+      const uint32_t alphaWidth = td.width;
 
-        if(sd.alpha != AlphaMapping::Discard)
+      Threading::ParallelFor(td.height, [&sd, rgba, nonalpha, alphaWidth](size_t y) {
+        for(uint32_t x = 0; x < alphaWidth; x++)
         {
+          byte r = rgba[(y * alphaWidth + x) * 4 + 0];
+          byte g = rgba[(y * alphaWidth + x) * 4 + 1];
+          byte b = rgba[(y * alphaWidth + x) * 4 + 2];
+          byte a = rgba[(y * alphaWidth + x) * 4 + 3];
+
           Vec4f col = Vec4f(sd.alphaCol.x, sd.alphaCol.y, sd.alphaCol.z);
           if(sd.alpha == AlphaMapping::BlendToCheckerboard)
           {
@@ -1113,12 +1326,12 @@ bool ReplayController::SaveTexture(const TextureSave &saveData, const char *path
           r = byte(pixel.x * 255.0f);
           g = byte(pixel.y * 255.0f);
           b = byte(pixel.z * 255.0f);
-        }
 
-        nonalpha[(y * td.width + x) * 3 + 0] = r;
-        nonalpha[(y * td.width + x) * 3 + 1] = g;
-        nonalpha[(y * td.width + x) * 3 + 2] = b;
-      }
+          nonalpha[(y * alphaWidth + x) * 3 + 0] = r;
+          nonalpha[(y * alphaWidth + x) * 3 + 1] = g;
+          nonalpha[(y * alphaWidth + x) * 3 + 2] = b;
+        }
+      });
     }
 
     delete[] subdata[0];
@@ -1135,22 +1348,25 @@ bool ReplayController::SaveTexture(const TextureSave &saveData, const char *path
   {
     byte *rg0 = new byte[td.width * td.height * 3];
 
-    for(uint32_t y = 0; y < td.height; y++)
-    {
-      for(uint32_t x = 0; x < td.width; x++)
+    byte *rg = subdata[0];
+    const uint32_t rgWidth = td.width;
+    const bool greyscale = sd.channelExtract >= 0;
+
+    Threading::ParallelFor(td.height, [rg, rg0, rgWidth, greyscale](size_t y) {
+      for(uint32_t x = 0; x < rgWidth; x++)
       {
-        byte r = subdata[0][(y * td.width + x) * 2 + 0];
-        byte g = subdata[0][(y * td.width + x) * 2 + 1];
+        byte r = rg[(y * rgWidth + x) * 2 + 0];
+        byte g = rg[(y * rgWidth + x) * 2 + 1];
 
-        rg0[(y * td.width + x) * 3 + 0] = r;
-        rg0[(y * td.width + x) * 3 + 1] = g;
-        rg0[(y * td.width + x) * 3 + 2] = 0;
+        rg0[(y * rgWidth + x) * 3 + 0] = r;
+        rg0[(y * rgWidth + x) * 3 + 1] = g;
+        rg0[(y * rgWidth + x) * 3 + 2] = 0;
 
         // if we're greyscaling the image, then keep the greyscale here.
-        if(sd.channelExtract >= 0)
-          rg0[(y * td.width + x) * 3 + 2] = r;
+        if(greyscale)
+          rg0[(y * rgWidth + x) * 3 + 2] = r;
       }
-    }
+    });
 
     delete[] subdata[0];
 
@@ -1273,12 +1489,21 @@ bool ReplayController::SaveTexture(const TextureSave &saveData, const char *path
       if(saveFmt.compType == CompType::Depth && pixStride == 3)
         pixStride = 4;
 
-      for(uint32_t y = 0; y < td.height; y++)
-      {
-        for(uint32_t x = 0; x < td.width; x++)
+      // decode the whole image in one pass rather than pixel by pixel, the batch conversion is
+      // much cheaper for common formats like half float
+      rdcarray<FloatVector> decoded;
+      decoded.resize(td.width * td.height);
+
+      ConvertComponents(saveFmt, srcData, pixStride, decoded.size(), decoded.data());
+
+      const FloatVector *decodedPixels = decoded.data();
+      const uint32_t hdrWidth = td.width;
+
+      // rows write disjoint ranges of the output planes, so swizzle them in parallel
+      Threading::ParallelFor(td.height, [&sd, decodedPixels, hdrWidth, fldata, &abgr](size_t y) {
+        for(uint32_t x = 0; x < hdrWidth; x++)
         {
-          FloatVector pixel = ConvertComponents(saveFmt, srcData);
-          srcData += pixStride;
+          FloatVector pixel = decodedPixels[y * hdrWidth + x];
 
           // HDR can't represent negative values
           if(sd.destType == FileType::HDR)
@@ -1312,20 +1537,20 @@ bool ReplayController::SaveTexture(const TextureSave &saveData, const char *path
 
           if(fldata)
           {
-            fldata[(y * td.width + x) * 4 + 0] = pixel.x;
-            fldata[(y * td.width + x) * 4 + 1] = pixel.y;
-            fldata[(y * td.width + x) * 4 + 2] = pixel.z;
-            fldata[(y * td.width + x) * 4 + 3] = pixel.w;
+            fldata[(y * hdrWidth + x) * 4 + 0] = pixel.x;
+            fldata[(y * hdrWidth + x) * 4 + 1] = pixel.y;
+            fldata[(y * hdrWidth + x) * 4 + 2] = pixel.z;
+            fldata[(y * hdrWidth + x) * 4 + 3] = pixel.w;
           }
           else
           {
-            abgr[0][(y * td.width + x)] = pixel.w;
-            abgr[1][(y * td.width + x)] = pixel.z;
-            abgr[2][(y * td.width + x)] = pixel.y;
-            abgr[3][(y * td.width + x)] = pixel.x;
+            abgr[0][(y * hdrWidth + x)] = pixel.w;
+            abgr[1][(y * hdrWidth + x)] = pixel.z;
+            abgr[2][(y * hdrWidth + x)] = pixel.y;
+            abgr[3][(y * hdrWidth + x)] = pixel.x;
           }
         }
-      }
+      });
 
       if(sd.destType == FileType::HDR)
       {
@@ -1412,6 +1637,28 @@ rdcarray<PixelModification> ReplayController::PixelHistory(ResourceId target, ui
 {
   CHECK_REPLAY_THREAD();
 
+  return FetchPixelHistory(target, x, y, sub, typeCast, 0, m_EventID);
+}
+
+rdcarray<PixelModification> ReplayController::PixelHistoryRange(ResourceId target, uint32_t x,
+                                                                uint32_t y, const Subresource &sub,
+                                                                CompType typeCast,
+                                                                uint32_t firstEventId,
+                                                                uint32_t lastEventId)
+{
+  CHECK_REPLAY_THREAD();
+
+  // never include modifications after the current event, matching PixelHistory
+  return FetchPixelHistory(target, x, y, sub, typeCast, firstEventId,
+                           RDCMIN(lastEventId, m_EventID));
+}
+
+rdcarray<PixelModification> ReplayController::FetchPixelHistory(ResourceId target, uint32_t x,
+                                                                uint32_t y, const Subresource &sub,
+                                                                CompType typeCast,
+                                                                uint32_t firstEventId,
+                                                                uint32_t lastEventId)
+{
   rdcarray<PixelModification> ret;
 
   Subresource subresource = sub;
@@ -1456,7 +1703,7 @@ rdcarray<PixelModification> ReplayController::PixelHistory(ResourceId target, ui
 
   for(size_t i = 0; i < usage.size(); i++)
   {
-    if(usage[i].eventId > m_EventID)
+    if(usage[i].eventId < firstEventId || usage[i].eventId > lastEventId)
       continue;
 
     switch(usage[i].usage)
@@ -1515,7 +1762,8 @@ rdcarray<PixelModification> ReplayController::PixelHistory(ResourceId target, ui
 
   if(events.empty())
   {
-    RDCDEBUG("Target %s not written to before %u", ToStr(target).c_str(), m_EventID);
+    RDCDEBUG("Target %s not written to between %u and %u", ToStr(target).c_str(), firstEventId,
+             lastEventId);
     return ret;
   }
 
@@ -1556,8 +1804,45 @@ rdcpair<PixelValue, PixelValue> ReplayController::GetMinMax(ResourceId textureId
   PixelValue minval = {{0.0f, 0.0f, 0.0f, 0.0f}};
   PixelValue maxval = {{1.0f, 1.0f, 1.0f, 1.0f}};
 
-  m_pDevice->GetMinMax(m_pDevice->GetLiveID(textureId), sub, typeCast, &minval.floatValue[0],
-                       &maxval.floatValue[0]);
+  ResourceId liveId = m_pDevice->GetLiveID(textureId);
+
+  const uint32_t writeEID = GetLastWriteEID(liveId);
+
+  MinMaxCacheEntry *entry = NULL;
+
+  if(writeEID != ~0U)
+  {
+    for(size_t i = 0; i < m_MinMaxCache.size(); i++)
+    {
+      if(m_MinMaxCache[i].id == textureId && m_MinMaxCache[i].sub == sub &&
+         m_MinMaxCache[i].typeCast == typeCast)
+      {
+        if(m_MinMaxCache[i].writeEID == writeEID)
+          return m_MinMaxCache[i].result;
+
+        // stale result from before the last write, recompute and update it in place
+        entry = &m_MinMaxCache[i];
+        break;
+      }
+    }
+  }
+
+  m_pDevice->GetMinMax(liveId, sub, typeCast, &minval.floatValue[0], &maxval.floatValue[0]);
+
+  if(writeEID != ~0U)
+  {
+    if(entry == NULL)
+    {
+      m_MinMaxCache.push_back(MinMaxCacheEntry());
+      entry = &m_MinMaxCache.back();
+      entry->id = textureId;
+      entry->sub = sub;
+      entry->typeCast = typeCast;
+    }
+
+    entry->writeEID = writeEID;
+    entry->result = make_rdcpair(minval, maxval);
+  }
 
   return make_rdcpair(minval, maxval);
 }
@@ -1570,8 +1855,50 @@ rdcarray<uint32_t> ReplayController::GetHistogram(ResourceId textureId, const Su
 
   rdcarray<uint32_t> hist;
 
-  m_pDevice->GetHistogram(m_pDevice->GetLiveID(textureId), sub, typeCast, minval, maxval, channels,
-                          hist);
+  ResourceId liveId = m_pDevice->GetLiveID(textureId);
+
+  const uint32_t writeEID = GetLastWriteEID(liveId);
+
+  HistogramCacheEntry *entry = NULL;
+
+  if(writeEID != ~0U)
+  {
+    for(size_t i = 0; i < m_HistogramCache.size(); i++)
+    {
+      if(m_HistogramCache[i].id == textureId && m_HistogramCache[i].sub == sub &&
+         m_HistogramCache[i].typeCast == typeCast)
+      {
+        if(m_HistogramCache[i].writeEID == writeEID && m_HistogramCache[i].minval == minval &&
+           m_HistogramCache[i].maxval == maxval &&
+           memcmp(m_HistogramCache[i].channels, channels, sizeof(m_HistogramCache[i].channels)) == 0)
+          return m_HistogramCache[i].histogram;
+
+        // stale, or the range/channel selection changed - recompute and update it in place
+        entry = &m_HistogramCache[i];
+        break;
+      }
+    }
+  }
+
+  m_pDevice->GetHistogram(liveId, sub, typeCast, minval, maxval, channels, hist);
+
+  if(writeEID != ~0U)
+  {
+    if(entry == NULL)
+    {
+      m_HistogramCache.push_back(HistogramCacheEntry());
+      entry = &m_HistogramCache.back();
+      entry->id = textureId;
+      entry->sub = sub;
+      entry->typeCast = typeCast;
+    }
+
+    entry->writeEID = writeEID;
+    entry->minval = minval;
+    entry->maxval = maxval;
+    memcpy(entry->channels, channels, sizeof(entry->channels));
+    entry->histogram = hist;
+  }
 
   return hist;
 }
@@ -1599,6 +1926,18 @@ ShaderDebugTrace *ReplayController::DebugPixel(uint32_t x, uint32_t y, uint32_t
   return ret;
 }
 
+rdcarray<ShaderDebugTrace *> ReplayController::DebugPixels(const rdcarray<PixelDebugTarget> &targets)
+{
+  CHECK_REPLAY_THREAD();
+
+  rdcarray<ShaderDebugTrace *> ret = m_pDevice->DebugPixels(m_EventID, targets);
+
+  // only restore the replayed state once for the whole batch, instead of after every invocation
+  SetFrameEvent(m_EventID, true);
+
+  return ret;
+}
+
 ShaderDebugTrace *ReplayController::DebugThread(const uint32_t groupid[3], const uint32_t threadid[3])
 {
   CHECK_REPLAY_THREAD();
@@ -1940,6 +2279,12 @@ void ReplayController::ReplaceResource(ResourceId from, ResourceId to)
 
   m_pDevice->ReplaceResource(from, to);
 
+  // replacing a resource can change rendered contents without any change in recorded usage, so
+  // cached results can no longer be trusted.
+  m_MinMaxCache.clear();
+  m_HistogramCache.clear();
+  m_DisassemblyCache.clear();
+
   SetFrameEvent(m_EventID, true);
 
   for(size_t i = 0; i < m_Outputs.size(); i++)
@@ -1953,6 +2298,10 @@ void ReplayController::RemoveReplacement(ResourceId id)
 
   m_pDevice->RemoveReplacement(id);
 
+  m_MinMaxCache.clear();
+  m_HistogramCache.clear();
+  m_DisassemblyCache.clear();
+
   SetFrameEvent(m_EventID, true);
 
   for(size_t i = 0; i < m_Outputs.size(); i++)
@@ -2042,6 +2391,8 @@ void ReplayController::FetchPipelineState(uint32_t eventId)
 {
   CHECK_REPLAY_THREAD();
 
+  PROFILE_ZONE("ReplayController::FetchPipelineState");
+
   m_pDevice->SavePipelineState(eventId);
 
   m_D3D11PipelineState = m_pDevice->GetD3D11PipelineState();
@@ -25,10 +25,12 @@
 
 #pragma once
 
+#include <map>
 #include <set>
 #include "api/replay/renderdoc_replay.h"
 #include "common/common.h"
 #include "core/core.h"
+#include "maths/matrix.h"
 #include "replay/replay_driver.h"
 
 #define CHECK_REPLAY_THREAD() RDCASSERT(Threading::GetCurrentID() == m_ThreadID);
@@ -94,6 +96,11 @@ private:
     uint64_t outputID;
 
     bool dirty;
+
+    // for thumbnails - the last write to the texture at the event it was last displayed, so
+    // events that don't touch the texture don't force a re-render. ~0U means unknown/never
+    // displayed and the thumbnail is always considered stale.
+    uint32_t displayedWriteEID;
   } m_MainOutput;
 
   ResourceId m_OverlayResourceId;
@@ -119,6 +126,10 @@ private:
     MeshDisplay meshDisplay;
   } m_RenderData;
 
+  // the camera matrix when the mesh display was last stored. The camera mutates behind its
+  // pointer, so this is what lets SetMeshDisplay detect camera movement.
+  Matrix4f m_CamMat;
+
   friend struct ReplayController;
 };
 
@@ -136,6 +147,7 @@ public:
   void FileChanged();
 
   void SetFrameEvent(uint32_t eventId, bool force);
+  FrameEventTimings GetFrameEventTimings();
 
   const D3D11Pipe::State *GetD3D11PipelineState();
   const D3D12Pipe::State *GetD3D12PipelineState();
@@ -185,8 +197,12 @@ public:
                                   float minval, float maxval, bool channels[4]);
   rdcarray<PixelModification> PixelHistory(ResourceId target, uint32_t x, uint32_t y,
                                            const Subresource &sub, CompType typeCast);
+  rdcarray<PixelModification> PixelHistoryRange(ResourceId target, uint32_t x, uint32_t y,
+                                                const Subresource &sub, CompType typeCast,
+                                                uint32_t firstEventId, uint32_t lastEventId);
   ShaderDebugTrace *DebugVertex(uint32_t vertid, uint32_t instid, uint32_t idx);
   ShaderDebugTrace *DebugPixel(uint32_t x, uint32_t y, uint32_t sample, uint32_t primitive);
+  rdcarray<ShaderDebugTrace *> DebugPixels(const rdcarray<PixelDebugTarget> &targets);
   ShaderDebugTrace *DebugThread(const uint32_t groupid[3], const uint32_t threadid[3]);
   rdcarray<ShaderDebugState> ContinueDebug(ShaderDebugger *debugger);
   void FreeTrace(ShaderDebugTrace *trace);
@@ -226,6 +242,12 @@ private:
   bool ContainsMarker(const rdcarray<DrawcallDescription> &draws);
   bool PassEquivalent(const DrawcallDescription &a, const DrawcallDescription &b);
 
+  uint32_t GetLastWriteEID(ResourceId liveId);
+
+  rdcarray<PixelModification> FetchPixelHistory(ResourceId target, uint32_t x, uint32_t y,
+                                                const Subresource &sub, CompType typeCast,
+                                                uint32_t firstEventId, uint32_t lastEventId);
+
   IReplayDriver *GetDevice() { return m_pDevice; }
   FrameRecord m_FrameRecord;
   rdcarray<DrawcallDescription *> m_Drawcalls;
@@ -239,6 +261,7 @@ private:
   volatile int32_t m_ReplayLoopFinished = 0;
 
   uint32_t m_EventID;
+  FrameEventTimings m_FrameEventTimings;
 
   const D3D11Pipe::State *m_D3D11PipelineState;
   const D3D12Pipe::State *m_D3D12PipelineState;
@@ -257,5 +280,52 @@ private:
   std::set<ResourceId> m_TargetResources;
   std::set<ResourceId> m_CustomShaders;
 
+  // cached GetMinMax/GetHistogram results. The texture viewer's range control re-fetches these on
+  // every event change, but if no event in between writes to the texture the results can't have
+  // changed, so entries are keyed on the last write to the texture before the current event and
+  // scrubbing over events that don't touch it costs no GPU passes.
+  struct MinMaxCacheEntry
+  {
+    ResourceId id;
+    Subresource sub;
+    CompType typeCast;
+    uint32_t writeEID;
+
+    rdcpair<PixelValue, PixelValue> result;
+  };
+  rdcarray<MinMaxCacheEntry> m_MinMaxCache;
+
+  struct HistogramCacheEntry
+  {
+    ResourceId id;
+    Subresource sub;
+    CompType typeCast;
+    uint32_t writeEID;
+    float minval;
+    float maxval;
+    bool channels[4];
+
+    rdcarray<uint32_t> histogram;
+  };
+  rdcarray<HistogramCacheEntry> m_HistogramCache;
+
+  // usage doesn't change over the lifetime of a capture, so cache it to avoid a round-trip per
+  // lookup on remote replays.
+  std::map<ResourceId, rdcarray<EventUsage>> m_UsageCache;
+
+  // disassembly is a pure function of the shader, pipeline and target, but can take a while (and a
+  // round-trip on remote replays) to generate for large modules, and the UI re-requests it every
+  // time a shader view is opened. Cleared when shaders are replaced since edits change what a
+  // pipeline's live shader disassembles to.
+  struct DisassemblyCacheEntry
+  {
+    ResourceId pipeline;
+    ResourceId shader;
+    rdcstr target;
+
+    rdcstr text;
+  };
+  rdcarray<DisassemblyCacheEntry> m_DisassemblyCache;
+
   friend struct ReplayOutput;
 };
@@ -565,6 +565,32 @@ uint64_t CalcMeshOutputSize(uint64_t curSize, uint64_t requiredOutput)
   return curSize;
 }
 
+rdcarray<rdcarray<PixelModification>> StandardPixelHistoryRegion(
+    IRemoteDriver *driver, const rdcarray<EventUsage> &events, ResourceId target, uint32_t x,
+    uint32_t y, uint32_t width, uint32_t height, const Subresource &sub, CompType typeCast)
+{
+  rdcarray<rdcarray<PixelModification>> history;
+  history.reserve(width * height);
+
+  for(uint32_t py = 0; py < height; py++)
+    for(uint32_t px = 0; px < width; px++)
+      history.push_back(driver->PixelHistory(events, target, x + px, y + py, sub, typeCast));
+
+  return history;
+}
+
+rdcarray<ShaderDebugTrace *> StandardDebugPixels(IRemoteDriver *driver, uint32_t eventId,
+                                                 const rdcarray<PixelDebugTarget> &targets)
+{
+  rdcarray<ShaderDebugTrace *> traces;
+  traces.reserve(targets.size());
+
+  for(const PixelDebugTarget &t : targets)
+    traces.push_back(driver->DebugPixel(eventId, t.x, t.y, t.sample, t.primitive));
+
+  return traces;
+}
+
 FloatVector HighlightCache::InterpretVertex(const byte *data, uint32_t vert, const MeshDisplay &cfg,
                                             const byte *end, bool useidx, bool &valid)
 {
@@ -179,10 +179,24 @@ public:
   virtual rdcarray<PixelModification> PixelHistory(rdcarray<EventUsage> events, ResourceId target,
                                                    uint32_t x, uint32_t y, const Subresource &sub,
                                                    CompType typeCast) = 0;
+  // gathers the history of every pixel in a rectangular region, returned in row-major order.
+  // Drivers that can amortise the replay passes across the whole region override this, everything
+  // else falls back to gathering one pixel at a time.
+  virtual rdcarray<rdcarray<PixelModification>> PixelHistoryRegion(rdcarray<EventUsage> events,
+                                                                   ResourceId target, uint32_t x,
+                                                                   uint32_t y, uint32_t width,
+                                                                   uint32_t height,
+                                                                   const Subresource &sub,
+                                                                   CompType typeCast) = 0;
   virtual ShaderDebugTrace *DebugVertex(uint32_t eventId, uint32_t vertid, uint32_t instid,
                                         uint32_t idx) = 0;
   virtual ShaderDebugTrace *DebugPixel(uint32_t eventId, uint32_t x, uint32_t y, uint32_t sample,
                                        uint32_t primitive) = 0;
+  // debugs a batch of pixel shader invocations at the same event, returning one trace per target.
+  // Drivers that can share the input-gather replay between invocations override this, everything
+  // else falls back to debugging one pixel at a time.
+  virtual rdcarray<ShaderDebugTrace *> DebugPixels(uint32_t eventId,
+                                                   const rdcarray<PixelDebugTarget> &targets) = 0;
   virtual ShaderDebugTrace *DebugThread(uint32_t eventId, const uint32_t groupid[3],
                                         const uint32_t threadid[3]) = 0;
   virtual rdcarray<ShaderDebugState> ContinueDebug(ShaderDebugger *debugger) = 0;
@@ -295,6 +309,17 @@ void StandardFillCBufferVariable(ResourceId shader, const ShaderVariableDescript
 void StandardFillCBufferVariables(ResourceId shader, const rdcarray<ShaderConstant> &invars,
                                   rdcarray<ShaderVariable> &outvars, const bytebuf &data);
 
+// default implementation of PixelHistoryRegion for drivers with no way to share work between
+// pixels - just gathers each pixel's history individually.
+rdcarray<rdcarray<PixelModification>> StandardPixelHistoryRegion(
+    IRemoteDriver *driver, const rdcarray<EventUsage> &events, ResourceId target, uint32_t x,
+    uint32_t y, uint32_t width, uint32_t height, const Subresource &sub, CompType typeCast);
+
+// default implementation of DebugPixels for drivers with no way to share input-gathering between
+// invocations - just debugs each pixel individually.
+rdcarray<ShaderDebugTrace *> StandardDebugPixels(IRemoteDriver *driver, uint32_t eventId,
+                                                 const rdcarray<PixelDebugTarget> &targets);
+
 // simple cache for when we need buffer data for highlighting
 // vertices, typical use will be lots of vertices in the same
 // mesh, not jumping back and forth much between meshes.
@@ -24,6 +24,7 @@
  ******************************************************************************/
 
 #include "common/common.h"
+#include "maths/camera.h"
 #include "maths/formatpacking.h"
 #include "maths/matrix.h"
 #include "strings/string_utils.h"
@@ -103,6 +104,8 @@ ReplayOutput::ReplayOutput(ReplayController *parent, WindowingData window, Repla
 
   RDCEraseEl(m_RenderData);
 
+  m_CamMat = Matrix4f::Identity();
+
   m_PixelContext.outputID = 0;
   m_PixelContext.texture = ResourceId();
   m_PixelContext.depthMode = false;
@@ -193,8 +196,13 @@ void ReplayOutput::SetTextureDisplay(const TextureDisplay &o)
   }
   if(wasClearBeforeDraw && o.backgroundColor != m_RenderData.texDisplay.backgroundColor)
     m_OverlayDirty = true;
+
+  // only dirty the output if the display actually changed, so refresh ticks with identical
+  // settings don't re-render it
+  if(m_RenderData.texDisplay != o)
+    m_MainOutput.dirty = true;
+
   m_RenderData.texDisplay = o;
-  m_MainOutput.dirty = true;
 }
 
 void ReplayOutput::SetMeshDisplay(const MeshDisplay &o)
@@ -203,8 +211,16 @@ void ReplayOutput::SetMeshDisplay(const MeshDisplay &o)
 
   if(o.showWholePass != m_RenderData.meshDisplay.showWholePass)
     m_OverlayDirty = true;
+
+  // the camera mutates behind its pointer, so compare its matrix to catch camera movement as well
+  // as changes to the display config itself
+  Matrix4f camMat = o.cam ? ((Camera *)o.cam)->GetMatrix() : Matrix4f::Identity();
+
+  if(m_RenderData.meshDisplay != o || memcmp(&camMat, &m_CamMat, sizeof(camMat)) != 0)
+    m_MainOutput.dirty = true;
+
+  m_CamMat = camMat;
   m_RenderData.meshDisplay = o;
-  m_MainOutput.dirty = true;
 }
 
 void ReplayOutput::SetFrameEvent(int eventId)
@@ -217,7 +233,21 @@ void ReplayOutput::SetFrameEvent(int eventId)
   m_MainOutput.dirty = true;
 
   for(size_t i = 0; i < m_Thumbnails.size(); i++)
-    m_Thumbnails[i].dirty = true;
+  {
+    // only mark a thumbnail dirty if its texture has been written between the event it was last
+    // displayed at and the new event, so scrubbing doesn't re-render every thumbnail each step.
+    if(m_Thumbnails[i].displayedWriteEID == ~0U || m_Thumbnails[i].texture == ResourceId())
+    {
+      m_Thumbnails[i].dirty = true;
+      continue;
+    }
+
+    uint32_t writeEID =
+        m_pRenderer->GetLastWriteEID(m_pDevice->GetLiveID(m_Thumbnails[i].texture));
+
+    if(writeEID != m_Thumbnails[i].displayedWriteEID)
+      m_Thumbnails[i].dirty = true;
+  }
 
   RefreshOverlay();
 }
@@ -360,11 +390,18 @@ bool ReplayOutput::AddThumbnail(WindowingData window, ResourceId texID, const Su
   {
     if(m_Thumbnails[i].wndHandle == GetHandle(window))
     {
+      // if the binding is unchanged the previously displayed contents are still valid -
+      // SetFrameEvent will dirty it if the texture has been written since.
+      if(m_Thumbnails[i].texture == texID && m_Thumbnails[i].depthMode == depthMode &&
+         m_Thumbnails[i].sub == sub && m_Thumbnails[i].typeCast == typeCast)
+        return true;
+
       m_Thumbnails[i].texture = texID;
       m_Thumbnails[i].depthMode = depthMode;
       m_Thumbnails[i].sub = sub;
       m_Thumbnails[i].typeCast = typeCast;
       m_Thumbnails[i].dirty = true;
+      m_Thumbnails[i].displayedWriteEID = ~0U;
 
       return true;
     }
@@ -377,6 +414,7 @@ bool ReplayOutput::AddThumbnail(WindowingData window, ResourceId texID, const Su
   p.sub = sub;
   p.typeCast = typeCast;
   p.dirty = true;
+  p.displayedWriteEID = ~0U;
 
   RDCASSERT(p.outputID > 0);
 
@@ -666,6 +704,8 @@ void ReplayOutput::Display()
     m_pDevice->FlipOutputWindow(m_Thumbnails[i].outputID);
 
     m_Thumbnails[i].dirty = false;
+    // remember which write these contents reflect, so unrelated event changes don't re-render
+    m_Thumbnails[i].displayedWriteEID = m_pRenderer->GetLastWriteEID(disp.resourceId);
   }
 }
 
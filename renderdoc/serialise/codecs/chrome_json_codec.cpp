@@ -51,6 +51,10 @@ ReplayStatus exportChrome(const char *filename, const RDCFile &rdc, const SDFile
   int i = 0;
   int numChunks = structData.chunks.count();
 
+  // rather than building the whole document in memory - which for large captures can be many
+  // times the capture size - flush the accumulated string to disk whenever it passes this size.
+  const size_t flushThreshold = 1024 * 1024;
+
   for(const SDChunk *chunk : structData.chunks)
   {
     if(chunk->metadata.chunkID == (uint32_t)SystemChunk::FirstDriverChunk + 1)
@@ -75,6 +79,12 @@ ReplayStatus exportChrome(const char *filename, const RDCFile &rdc, const SDFile
         fmt, chunk->name.c_str(), category, chunk->metadata.timestampMicro, chunk->metadata.threadID,
         chunk->metadata.timestampMicro + chunk->metadata.durationMicro, chunk->metadata.threadID);
 
+    if(str.size() >= flushThreshold)
+    {
+      FileIO::fwrite(str.data(), 1, str.size(), f);
+      str.clear();
+    }
+
     if(progress)
       progress(float(i) / float(numChunks));
 
@@ -70,6 +70,13 @@ struct xml_file_writer : pugi::xml_writer
   void write(const void *data, size_t size) { stream.Write(data, size); }
 };
 
+struct xml_string_writer : pugi::xml_writer
+{
+  rdcstr buf;
+
+  void write(const void *data, size_t size) { buf.append((const char *)data, size); }
+};
+
 // avoid &, <, and > since they throw off the ascii alignment
 static constexpr bool IsXMLPrintable(const char c)
 {
@@ -274,6 +281,51 @@ static void Obj2XML(pugi::xml_node &parent, SDObject &child)
   }
 }
 
+// builds one chunk as its own small document, prints it to the writer at chunk depth, then
+// resets the document ready for the next chunk.
+static void Chunk2XML(pugi::xml_document &chunkDoc, const SDChunk *chunk, pugi::xml_writer &writer)
+{
+  pugi::xml_node xChunk = chunkDoc.append_child("chunk");
+
+  xChunk.append_attribute("id") = chunk->metadata.chunkID;
+  xChunk.append_attribute("name") = chunk->name.c_str();
+  xChunk.append_attribute("length") = chunk->metadata.length;
+  if(chunk->metadata.threadID)
+    xChunk.append_attribute("threadID") = chunk->metadata.threadID;
+  if(chunk->metadata.timestampMicro)
+    xChunk.append_attribute("timestamp") = chunk->metadata.timestampMicro;
+  if(chunk->metadata.durationMicro >= 0)
+    xChunk.append_attribute("duration") = chunk->metadata.durationMicro;
+  if(chunk->metadata.flags & SDChunkFlags::HasCallstack)
+  {
+    pugi::xml_node stack = xChunk.append_child("callstack");
+
+    for(size_t i = 0; i < chunk->metadata.callstack.size(); i++)
+    {
+      stack.append_child("address").text() = chunk->metadata.callstack[i];
+    }
+  }
+
+  if(chunk->metadata.flags & SDChunkFlags::OpaqueChunk)
+  {
+    xChunk.append_attribute("opaque") = true;
+
+    RDCASSERT(!chunk->data.children.empty());
+    pugi::xml_node opaque = xChunk.append_child("buffer");
+    opaque.append_attribute("byteLength") = chunk->data.children[0]->type.byteSize;
+    opaque.text() = chunk->data.children[0]->data.basic.u;
+  }
+  else
+  {
+    for(size_t o = 0; o < chunk->data.children.size(); o++)
+      Obj2XML(xChunk, *chunk->data.children[o]);
+  }
+
+  xChunk.print(writer, "\t", pugi::format_default, pugi::encoding_auto, 2);
+
+  chunkDoc.reset();
+}
+
 static ReplayStatus Structured2XML(const char *filename, const RDCFile &file, uint64_t version,
                                    const StructuredChunkList &chunks,
                                    RENDERDOC_ProgressCallback progress)
@@ -399,55 +451,120 @@ static ReplayStatus Structured2XML(const char *filename, const RDCFile &file, ui
   if(progress)
     progress(StructuredProgress(0.2f));
 
-  pugi::xml_node xChunks = xRoot.append_child("chunks");
+  // stream the document out rather than building the whole thing in memory first - captures with
+  // millions of chunks produce XML documents many times larger than the capture itself. The
+  // header and sections above are written from the document, then each chunk is built as its own
+  // small document, printed at the right depth, and thrown away.
+  xml_file_writer writer(filename);
+
+  writer.write("<?xml version=\"1.0\"?>\n<rdc>\n", 28);
+
+  for(pugi::xml_node child = xRoot.first_child(); child; child = child.next_sibling())
+    child.print(writer, "\t", pugi::format_default, pugi::encoding_auto, 1);
+
+  rdcstr chunksOpen = StringFormat::Fmt("\t<chunks version=\"%llu\">\n", version);
+  writer.write(chunksOpen.c_str(), chunksOpen.size());
 
-  xChunks.append_attribute("version") = version;
+  // chunks are independent of each other, so with spare cores we build their XML on worker
+  // threads and only do the file writes on this thread. With fewer than two spare cores the
+  // coordination costs more than it gains, so stay single-threaded - the output is
+  // byte-identical either way.
+  uint32_t threadCount = RDCMIN(8U, Threading::GetCPUCoreCount() - 1);
 
-  for(size_t c = 0; c < chunks.size(); c++)
+  if(threadCount >= 2 && chunks.size() >= 256)
   {
-    pugi::xml_node xChunk = xChunks.append_child("chunk");
-    SDChunk *chunk = chunks[c];
+    // each slot holds the printed XML for one chunk. Workers claim chunk indices from an atomic
+    // counter, and a slot can only be refilled once this thread has drained its previous chunk,
+    // so the slot ring bounds how far ahead the workers can run and keeps memory use fixed while
+    // the file is still written strictly in chunk order.
+    //
+    // slot state is the chunk index it will hold next: state == c means a worker may fill it
+    // with chunk c, state == ~c means chunk c is built and ready to be written out.
+    struct Slot
+    {
+      rdcstr xml;
+      volatile int32_t state;
+    };
+
+    rdcarray<Slot> slots;
+    slots.resize(threadCount * 4);
+
+    for(size_t i = 0; i < slots.size(); i++)
+      slots[i].state = (int32_t)i;
 
-    xChunk.append_attribute("id") = chunk->metadata.chunkID;
-    xChunk.append_attribute("name") = chunk->name.c_str();
-    xChunk.append_attribute("length") = chunk->metadata.length;
-    if(chunk->metadata.threadID)
-      xChunk.append_attribute("threadID") = chunk->metadata.threadID;
-    if(chunk->metadata.timestampMicro)
-      xChunk.append_attribute("timestamp") = chunk->metadata.timestampMicro;
-    if(chunk->metadata.durationMicro >= 0)
-      xChunk.append_attribute("duration") = chunk->metadata.durationMicro;
-    if(chunk->metadata.flags & SDChunkFlags::HasCallstack)
+    volatile int32_t nextChunk = 0;
+
+    const int32_t slotCount = (int32_t)slots.size();
+    const int32_t chunkCount = (int32_t)chunks.size();
+
+    rdcarray<Threading::ThreadHandle> threads;
+    threads.resize(threadCount);
+
+    for(size_t t = 0; t < threads.size(); t++)
     {
-      pugi::xml_node stack = xChunk.append_child("callstack");
+      threads[t] = Threading::CreateThread([&chunks, &slots, &nextChunk, slotCount, chunkCount]() {
+        pugi::xml_document chunkDoc;
 
-      for(size_t i = 0; i < chunk->metadata.callstack.size(); i++)
-      {
-        stack.append_child("address").text() = chunk->metadata.callstack[i];
-      }
+        for(;;)
+        {
+          int32_t c = Atomic::Inc32(&nextChunk) - 1;
+
+          if(c >= chunkCount)
+            break;
+
+          Slot &slot = slots[c % slotCount];
+
+          // wait for the writer to drain this slot's previous chunk
+          while(slot.state != c)
+            Threading::Sleep(0);
+
+          xml_string_writer stringWriter;
+          Chunk2XML(chunkDoc, chunks[c], stringWriter);
+          slot.xml.swap(stringWriter.buf);
+
+          Atomic::CmpExch32(&slot.state, c, ~c);
+        }
+      });
     }
 
-    if(chunk->metadata.flags & SDChunkFlags::OpaqueChunk)
+    for(int32_t c = 0; c < chunkCount; c++)
     {
-      xChunk.append_attribute("opaque") = true;
+      Slot &slot = slots[c % slotCount];
+
+      while(slot.state != ~c)
+        Threading::Sleep(0);
+
+      writer.write(slot.xml.c_str(), slot.xml.size());
 
-      RDCASSERT(!chunk->data.children.empty());
-      pugi::xml_node opaque = xChunk.append_child("buffer");
-      opaque.append_attribute("byteLength") = chunk->data.children[0]->type.byteSize;
-      opaque.text() = chunk->data.children[0]->data.basic.u;
+      slot.xml.clear();
+
+      // release the slot for the chunk that maps onto it next time around the ring
+      Atomic::CmpExch32(&slot.state, ~c, c + slotCount);
+
+      if(progress)
+        progress(StructuredProgress(0.2f + 0.8f * (float(c) / float(chunks.size()))));
     }
-    else
+
+    for(Threading::ThreadHandle thread : threads)
     {
-      for(size_t o = 0; o < chunk->data.children.size(); o++)
-        Obj2XML(xChunk, *chunk->data.children[o]);
+      Threading::JoinThread(thread);
+      Threading::CloseThread(thread);
     }
+  }
+  else
+  {
+    pugi::xml_document chunkDoc;
 
-    if(progress)
-      progress(StructuredProgress(0.2f + 0.8f * (float(c) / float(chunks.size()))));
+    for(size_t c = 0; c < chunks.size(); c++)
+    {
+      Chunk2XML(chunkDoc, chunks[c], writer);
+
+      if(progress)
+        progress(StructuredProgress(0.2f + 0.8f * (float(c) / float(chunks.size()))));
+    }
   }
 
-  xml_file_writer writer(filename);
-  doc.save(writer);
+  writer.write("\t</chunks>\n</rdc>\n", 18);
 
   return writer.stream.IsErrored() ? ReplayStatus::FileIOFailed : ReplayStatus::Succeeded;
 }
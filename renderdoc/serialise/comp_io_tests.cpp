@@ -190,4 +190,110 @@ TEST_CASE("Test ZSTD compression/decompression", "[streamio][zstd]")
   delete[] randomData;
 };
 
+TEST_CASE("Test ZSTD incompressible data storage", "[streamio][zstd]")
+{
+  StreamWriter buf(StreamWriter::DefaultScratchSize);
+
+  const uint64_t dataSize = 2 * 1024 * 1024;
+
+  byte *randomData = new byte[dataSize];
+
+  for(uint64_t i = 0; i < dataSize; i++)
+    randomData[i] = rand() & 0xff;
+
+  // write the data
+  {
+    StreamWriter writer(new ZSTDCompressor(&buf, Ownership::Nothing), Ownership::Stream);
+
+    writer.Write(randomData, dataSize);
+
+    CHECK_FALSE(writer.IsErrored());
+
+    writer.Finish();
+
+    CHECK_FALSE(writer.IsErrored());
+  }
+
+  // high-entropy pages are stored as raw blocks, so the output should be the input plus a few
+  // bytes of framing per 128KB page and nothing more
+  CHECK(buf.GetOffset() >= dataSize);
+  CHECK(buf.GetOffset() < dataSize + 4 * 1024);
+
+  // decompress it and check it round-tripped
+  {
+    StreamReader reader(
+        new ZSTDDecompressor(new StreamReader(buf.GetData(), buf.GetOffset()), Ownership::Stream),
+        dataSize, Ownership::Stream);
+
+    byte *readData = new byte[dataSize];
+
+    reader.Read(readData, dataSize);
+    CHECK_FALSE(memcmp(readData, randomData, (size_t)dataSize));
+
+    CHECK_FALSE(reader.IsErrored());
+    CHECK(reader.AtEnd());
+
+    delete[] readData;
+  }
+
+  delete[] randomData;
+};
+
+TEST_CASE("Test pipelined decompression", "[streamio][lz4]")
+{
+  StreamWriter buf(StreamWriter::DefaultScratchSize);
+
+  // enough data to lap the pipeline's block ring, so block recycling gets exercised
+  const uint64_t dataSize = 24 * 1024 * 1024;
+
+  byte *data = new byte[dataSize];
+
+  for(uint64_t i = 0; i < dataSize; i++)
+    data[i] = byte((i * 7) ^ (i >> 12));
+
+  // write the data
+  {
+    StreamWriter writer(new LZ4Compressor(&buf, Ownership::Nothing), Ownership::Stream);
+
+    writer.Write(data, dataSize);
+
+    CHECK_FALSE(writer.IsErrored());
+
+    writer.Finish();
+
+    CHECK_FALSE(writer.IsErrored());
+  }
+
+  // decompress it through the pipelined wrapper and check we get identical output
+  {
+    LZ4Decompressor *lz4 =
+        new LZ4Decompressor(new StreamReader(buf.GetData(), buf.GetOffset()), Ownership::Stream);
+
+    StreamReader reader(new PipelinedDecompressor(lz4, dataSize, Ownership::Stream), dataSize,
+                        Ownership::Stream);
+
+    byte *readData = new byte[dataSize];
+
+    // read in a size that doesn't divide the pipeline's blocks, so reads straddle block boundaries
+    const uint64_t readSize = 3 * 1024 * 1024 + 12345;
+
+    uint64_t offs = 0;
+    while(offs < dataSize)
+    {
+      uint64_t chunkSize = RDCMIN(readSize, dataSize - offs);
+      reader.Read(readData + offs, chunkSize);
+      offs += chunkSize;
+    }
+
+    CHECK_FALSE(memcmp(readData, data, (size_t)dataSize));
+
+    CHECK_FALSE(reader.IsErrored());
+    CHECK(reader.AtEnd());
+
+    delete[] readData;
+  }
+
+  delete[] data;
+};
+
 #endif    // ENABLED(ENABLE_UNIT_TESTS)
@@ -74,6 +74,14 @@ bool is_exr_file(FILE *f)
    uint8_t driverNameLength; // length in bytes of the driver name including null terminator
    char driverName[ driverNameLength ]; // the driver name in ASCII. Useful if the current
                                         // implementation doesn't recognise the driver ID above
+
+   // optional fixed-size capture summary, identified by checking that headerLength has room for
+   // it here and that the magic matches. Older files end the header at driverName.
+   uint32_t summaryMagic; // MAKE_FOURCC('S', 'U', 'M', 'M')
+   uint32_t frameNumber; // frame number the capture was made on
+   uint32_t frameTimeMicroseconds; // average frametime around the time of capture
+   uint32_t pad;
+   uint64_t captureTimeUnix; // unix timestamp when the capture was written
  }
 
  1 or more sections:
@@ -131,6 +139,7 @@ bool is_exr_file(FILE *f)
 */
 
 static const uint32_t MAGIC_HEADER = MAKE_FOURCC('R', 'D', 'O', 'C');
+static const uint32_t SUMMARY_MAGIC = MAKE_FOURCC('S', 'U', 'M', 'M');
 
 namespace
 {
@@ -183,6 +192,19 @@ struct CaptureMetaData
   char driverName[1] = {0};
 };
 
+struct BinaryCaptureSummary
+{
+  // guards against misinterpreting reserved header padding in files from other writers
+  uint32_t magic;
+  // frame number the capture was made on
+  uint32_t frameNumber;
+  // average frametime in microseconds around the time of capture
+  uint32_t frameTimeMicroseconds;
+  uint32_t pad;
+  // unix timestamp when the capture was written
+  uint64_t captureTimeUnix;
+};
+
 struct BinarySectionHeader
 {
   // 0x0
@@ -406,6 +428,22 @@ void RDCFile::Init(StreamReader &reader)
   delete[] thumbData;
   delete[] driverName;
 
+  // newer files append a fixed-size capture summary to the header, inside headerLength. Older
+  // files end the header at the driver name - check both the remaining header space and the
+  // magic before trusting it, and leave the defaults in place otherwise.
+  if(header.headerLength >= reader.GetOffset() + sizeof(BinaryCaptureSummary))
+  {
+    BinaryCaptureSummary summary = {};
+    reader.Read(summary);
+
+    if(!reader.IsErrored() && summary.magic == SUMMARY_MAGIC)
+    {
+      m_Summary.frameNumber = summary.frameNumber;
+      m_Summary.frameTimeMicroseconds = summary.frameTimeMicroseconds;
+      m_Summary.captureTimeUnix = summary.captureTimeUnix;
+    }
+  }
+
   if(reader.GetOffset() > header.headerLength)
   {
     RETURNERROR(ContainerError::FileIO, "I/O error seeking to end of header");
@@ -730,7 +768,8 @@ void RDCFile::Create(const char *filename)
   meta.driverNameLength = uint8_t(m_DriverName.size() + 1);
 
   header.headerLength = sizeof(FileHeader) + offsetof(BinaryThumbnail, data) + thumbHeader.length +
-                        offsetof(CaptureMetaData, driverName) + meta.driverNameLength;
+                        offsetof(CaptureMetaData, driverName) + meta.driverNameLength +
+                        sizeof(BinaryCaptureSummary);
 
   {
     StreamWriter writer(m_File, Ownership::Nothing);
@@ -745,6 +784,14 @@ void RDCFile::Create(const char *filename)
 
     writer.Write(m_DriverName.c_str(), meta.driverNameLength);
 
+    BinaryCaptureSummary summary = {};
+    summary.magic = SUMMARY_MAGIC;
+    summary.frameNumber = m_Summary.frameNumber;
+    summary.frameTimeMicroseconds = m_Summary.frameTimeMicroseconds;
+    summary.captureTimeUnix = m_Summary.captureTimeUnix;
+
+    writer.Write(summary);
+
     delete[] jpgBuffer;
     if(writer.IsErrored())
     {
@@ -803,27 +850,86 @@ StreamReader *RDCFile::ReadSection(int index) const
 
   const SectionProperties &props = m_Sections[index];
   SectionLocation offsetSize = m_SectionLocations[index];
+
+  // uncompressed sections can be read zero-copy out of a memory-mapped view - the pages are
+  // shared with any other process that has the same capture open, and nothing is copied onto the
+  // heap until (unless) it's actually read.
+  if(!(props.flags & (SectionFlags::LZ4Compressed | SectionFlags::ZstdCompressed)))
+  {
+    FileIO::FileMapping *mapping =
+        FileIO::map_region(m_File, offsetSize.dataOffset, offsetSize.diskLength);
+
+    if(mapping)
+      return new StreamReader(mapping, offsetSize.diskLength);
+
+    // otherwise fall back to buffered reads below
+  }
+
   FileIO::fseek64(m_File, offsetSize.dataOffset, SEEK_SET);
 
   StreamReader *fileReader = new StreamReader(m_File, offsetSize.diskLength, Ownership::Nothing);
 
-  StreamReader *compReader = NULL;
+  Decompressor *decomp = NULL;
 
   if(props.flags & SectionFlags::LZ4Compressed)
+    decomp = new LZ4Decompressor(fileReader, Ownership::Stream);
+  else if(props.flags & SectionFlags::ZstdCompressed)
+    decomp = new ZSTDDecompressor(fileReader, Ownership::Stream);
+
+  if(decomp)
   {
-    // the user will delete the compressed reader, and then it will delete the compressor and the
-    // file reader
-    compReader = new StreamReader(new LZ4Decompressor(fileReader, Ownership::Stream),
-                                  props.uncompressedSize, Ownership::Stream);
+    // large sections decompress on a worker thread a few blocks ahead of the consumer, so
+    // reading overlaps with parsing instead of alternating with it. Small sections aren't worth
+    // a thread.
+    if(props.uncompressedSize >= 16 * 1024 * 1024 && Threading::GetCPUCoreCount() >= 2)
+      decomp = new PipelinedDecompressor(decomp, props.uncompressedSize, Ownership::Stream);
+
+    // the user will delete the compressed reader, and then it will delete the decompressor and
+    // the file reader
+    return new StreamReader(decomp, props.uncompressedSize, Ownership::Stream);
   }
-  else if(props.flags & SectionFlags::ZstdCompressed)
+
+  // not compressed - return the file reader directly
+  return fileReader;
+}
+
+bool RDCFile::ReadFrameCaptureIndex(rdcarray<FrameCaptureIndexEntry> &index) const
+{
+  int sectionIdx = SectionIndex(SectionType::FrameCaptureIndex);
+
+  if(sectionIdx < 0)
+    return false;
+
+  StreamReader *reader = ReadSection(sectionIdx);
+
+  uint64_t count = 0;
+  reader->Read(count);
+
+  // sanity check the count against the section size so a corrupt count doesn't cause a huge
+  // allocation - each entry is a uint32 id and uint64 offset
+  if(count * (sizeof(uint32_t) + sizeof(uint64_t)) > reader->GetSize())
   {
-    compReader = new StreamReader(new ZSTDDecompressor(fileReader, Ownership::Stream),
-                                  props.uncompressedSize, Ownership::Stream);
+    RDCERR("Invalid chunk index count %llu in %llu byte section", count, reader->GetSize());
+    delete reader;
+    return false;
   }
 
-  // if we're compressing return that writer, otherwise return the file writer directly
-  return compReader ? compReader : fileReader;
+  index.resize((size_t)count);
+
+  for(FrameCaptureIndexEntry &entry : index)
+  {
+    reader->Read(entry.chunkID);
+    reader->Read(entry.offset);
+  }
+
+  bool success = !reader->IsErrored();
+
+  delete reader;
+
+  if(!success)
+    index.clear();
+
+  return success;
 }
 
 StreamWriter *RDCFile::WriteSection(const SectionProperties &props)
@@ -1021,9 +1127,6 @@ StreamWriter *RDCFile::WriteSection(const SectionProperties &props)
 
       RDCASSERT(index >= 0);
 
-      rdcarray<bytebuf> origSectionData;
-      rdcarray<uint64_t> origHeaderSizes;
-
       uint64_t overwriteLocation = m_SectionLocations[index].headerOffset;
       uint64_t oldLength = m_SectionLocations[index].diskLength;
 
@@ -1031,51 +1134,60 @@ StreamWriter *RDCFile::WriteSection(const SectionProperties &props)
       m_Sections.erase(index);
       m_SectionLocations.erase(index);
 
-      origSectionData.reserve(NumSections() - index);
-      origHeaderSizes.reserve(NumSections() - index);
+      // we move the subsequent sections up over where the old section used to be, so the newly
+      // written section is last in the file. This means if the same section is updated over and
+      // over, it doesn't require moving any sections once it's already at the end.
+      //
+      // the move goes through a bounded window rather than reading each section into memory
+      // wholesale - most sections are small but e.g. a callstack resolve database can run to
+      // hundreds of MB. The destination is always at or before the source, so copying forwards
+      // chunk by chunk never reads bytes that have already been overwritten.
+      uint64_t writeOffset = overwriteLocation;
+
+      bytebuf window;
+
+      if(index < NumSections())
+        window.resize(4 * 1024 * 1024);
 
-      // go through all subsequent sections after this one in the file, read them into memory.
-      // this could be optimised since we're going to write them back out below, we could do this
-      // just with an in-memory window large enough.
       for(int i = index; i < NumSections(); i++)
       {
-        const SectionLocation &loc = m_SectionLocations[i];
-
-        FileIO::fseek64(m_File, loc.headerOffset, SEEK_SET);
+        SectionLocation &loc = m_SectionLocations[i];
 
         uint64_t headerLen = loc.dataOffset - loc.headerOffset;
+        uint64_t readOffset = loc.headerOffset;
+        uint64_t remaining = headerLen + loc.diskLength;
 
-        // read header and data together
-        StreamReader reader(m_File, headerLen + loc.diskLength, Ownership::Nothing);
-
-        origHeaderSizes.push_back(headerLen);
-        origSectionData.push_back(bytebuf());
+        // update the offsets to where they are in the new file
+        loc.headerOffset = writeOffset;
+        loc.dataOffset = writeOffset + headerLen;
 
-        bytebuf &data = origSectionData.back();
-        data.resize((size_t)reader.GetSize());
-        reader.Read(data.data(), data.size());
-      }
+        while(remaining > 0)
+        {
+          uint64_t chunkSize = RDCMIN(remaining, (uint64_t)window.size());
 
-      // we write the sections now over where the old section used to be, so the newly written
-      // section is last in the file. This means if the same section is updated over and over, it
-      // doesn't require moving any sections once it's already at the end.
+          FileIO::fseek64(m_File, readOffset, SEEK_SET);
+          size_t io = FileIO::fread(window.data(), 1, (size_t)chunkSize, m_File);
 
-      // seek to write to where the removed section started
-      FileIO::fseek64(m_File, overwriteLocation, SEEK_SET);
+          FileIO::fseek64(m_File, writeOffset, SEEK_SET);
+          io += FileIO::fwrite(window.data(), 1, (size_t)chunkSize, m_File);
 
-      // write the old sections
-      for(size_t i = 0; i < origSectionData.size(); i++)
-      {
-        // update the offsets to where they are in the new file
-        m_SectionLocations[index + i].headerOffset = FileIO::ftell64(m_File);
-        m_SectionLocations[index + i].dataOffset =
-            m_SectionLocations[index + i].headerOffset + origHeaderSizes[i];
+          if(io != 2 * (size_t)chunkSize)
+          {
+            SETERROR(ContainerError::FileIO, "Error moving section %s, errno %d",
+                     m_Sections[i].name.c_str(), errno);
+            return new StreamWriter(StreamWriter::InvalidStream);
+          }
 
-        // write the data
-        StreamWriter writer(m_File, Ownership::Nothing);
-        writer.Write(origSectionData[i].data(), origSectionData[i].size());
+          readOffset += chunkSize;
+          writeOffset += chunkSize;
+          remaining -= chunkSize;
+        }
       }
 
+      // seek to write the new section after the moved sections, or over the removed section if
+      // it was already last
+      FileIO::fseek64(m_File, writeOffset, SEEK_SET);
+
       // after writing, we need to be sure to fixup the size (in case we wrote less data).
       modifySectionCallback = [this, oldLength]() {
         if(oldLength > m_SectionLocations.back().diskLength)
@@ -1127,8 +1239,10 @@ StreamWriter *RDCFile::WriteSection(const SectionProperties &props)
     return new StreamWriter(StreamWriter::InvalidStream);
   }
 
-  // create a writer for writing to disk. It shouldn't close the file
-  StreamWriter *fileWriter = new StreamWriter(m_File, Ownership::Nothing);
+  // create a writer for writing to disk. It shouldn't close the file. Writes are buffered and
+  // flushed from a background thread so that section writing isn't stalled on disk I/O.
+  StreamWriter *fileWriter =
+      new StreamWriter(m_File, Ownership::Nothing, StreamWriter::DefaultAsyncBufferSize);
 
   StreamWriter *compWriter = NULL;
 
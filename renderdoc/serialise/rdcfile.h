@@ -55,6 +55,28 @@ struct ExtThumbnailHeader
   FileType format;
 };
 
+// a small fixed-size summary written uncompressed into the file header at capture time, so capture
+// browsers can list many files without touching any compressed sections. The API and machine ident
+// already live in the main header - this adds the frame-level information. Fields are left at
+// their defaults when the writer didn't know them, e.g. in files saved by older versions.
+struct RDCCaptureSummary
+{
+  // frame number the capture was made on
+  uint32_t frameNumber = ~0U;
+  // average frametime in microseconds around the time of capture
+  uint32_t frameTimeMicroseconds = 0;
+  // unix timestamp when the capture was written
+  uint64_t captureTimeUnix = 0;
+};
+
+// an entry in the optional FrameCaptureIndex section - the offset of a chunk in the uncompressed
+// frame capture stream
+struct FrameCaptureIndexEntry
+{
+  uint32_t chunkID;
+  uint64_t offset;
+};
+
 class RDCFile
 {
 public:
@@ -80,6 +102,11 @@ public:
   void SetData(RDCDriver driver, const char *driverName, uint64_t machineIdent,
                const RDCThumb *thumb);
 
+  // Sets the capture summary written into the header. Must be called before Create() to land on
+  // disk - the summary is part of the file header, not a section.
+  void SetCaptureSummary(const RDCCaptureSummary &summary) { m_Summary = summary; }
+  const RDCCaptureSummary &GetCaptureSummary() const { return m_Summary; }
+
   // creates a new file with current properties, file will be overwritten if it already exists
   void Create(const char *filename);
 
@@ -96,6 +123,10 @@ public:
   StreamReader *ReadSection(int index) const;
   StreamWriter *WriteSection(const SectionProperties &props);
 
+  // reads and parses the FrameCaptureIndex section. Returns false if the file doesn't contain an
+  // index or it's corrupt, in which case callers walk the frame capture section linearly as before
+  bool ReadFrameCaptureIndex(rdcarray<FrameCaptureIndexEntry> &index) const;
+
   // Only valid if GetDriver returns RDCDriver::Image, passes over the underlying FILE * for use
   // loading the image directly, since the RDC container isn't there to read from a section.
   FILE *StealImageFileHandle(rdcstr &filename);
@@ -115,6 +146,7 @@ private:
   rdcstr m_DriverName;
   uint64_t m_MachineIdent = 0;
   RDCThumb m_Thumb;
+  RDCCaptureSummary m_Summary;
 
   ContainerError m_Error = ContainerError::NoError;
   rdcstr m_ErrorString;
@@ -27,7 +27,15 @@
 
 #include "serialiser.h"
 #include "core/core.h"
+#include "core/settings.h"
 #include "strings/string_utils.h"
+#include "zstd/xxhash.h"
+
+RDOC_CONFIG(bool, Capture_CallstackFastUnwind, false,
+            "Collect captured API call callstacks with a cheap fixed-depth frame pointer walk, "
+            "and only run the full unwinder once per unique stack. Requires frame pointers to be "
+            "kept in the application for full stacks, but makes callstack capture cheap enough "
+            "for everyday use.");
 
 #if ENABLED(RDOC_DEVEL)
 
@@ -36,6 +44,127 @@ int64_t Chunk::m_TotalMem = 0;
 
 #endif
 
+// out-of-line definitions for the table reference sentinels. They're passed to
+// StreamWriter::Write(const T &), which binds a reference and so ODR-uses them - without these
+// the library fails to link.
+const uint32_t StringTable::TableRef;
+const int32_t StringTable::TableRefSigned;
+
+ChunkAllocator::~ChunkAllocator()
+{
+  for(const Page &page : m_Pages)
+    FreeAlignedBuffer(page.base);
+}
+
+byte *ChunkAllocator::AllocChunkData(uint64_t size)
+{
+  // oversized allocations go straight to the heap rather than burning most of a page - FindPage
+  // will fail for them and FreeChunkData frees them individually.
+  if(size > PageSize / 2)
+    return AllocAlignedBuffer(size);
+
+  // keep each allocation 64-byte aligned within the page, matching AllocAlignedBuffer
+  size = AlignUp<uint64_t>(RDCMAX((uint64_t)1, size), 64);
+
+  Threading::ScopedSpinLock scoped(m_Lock);
+
+  if(m_Current >= 0 && m_Pages[m_Current].used + size <= PageSize)
+  {
+    Page &page = m_Pages[m_Current];
+
+    byte *ret = page.base + page.used;
+    page.used += size;
+    page.refcount++;
+    return ret;
+  }
+
+  // the current page is full (or doesn't exist) - grab a page off the free list, or allocate one.
+  // If everything on the page we're retiring was already freed it can be recycled immediately.
+  if(m_Current >= 0 && m_Pages[m_Current].refcount == 0)
+  {
+    m_Pages[m_Current].used = 0;
+    m_FreeBases.push_back(m_Pages[m_Current].base);
+  }
+
+  byte *base = NULL;
+
+  if(!m_FreeBases.empty())
+  {
+    base = m_FreeBases.back();
+    m_FreeBases.pop_back();
+
+    m_Current = FindPage(base);
+
+    Page &page = m_Pages[m_Current];
+    page.used = size;
+    page.refcount = 1;
+    return page.base;
+  }
+
+  base = AllocAlignedBuffer(PageSize);
+
+  Page page = {base, size, 1};
+
+  // insert sorted by base address so FindPage can binary search
+  int32_t idx = 0;
+  while(idx < m_Pages.count() && m_Pages[idx].base < base)
+    idx++;
+
+  m_Pages.insert(idx, page);
+  m_Current = idx;
+
+  return base;
+}
+
+void ChunkAllocator::FreeChunkData(byte *data)
+{
+  {
+    Threading::ScopedSpinLock scoped(m_Lock);
+
+    int32_t idx = FindPage(data);
+
+    if(idx >= 0)
+    {
+      Page &page = m_Pages[idx];
+
+      page.refcount--;
+      RDCASSERT(page.refcount >= 0);
+
+      // don't recycle the page we're still filling - it becomes reusable when it's retired and
+      // the last allocation on it is freed
+      if(page.refcount == 0 && idx != m_Current)
+      {
+        page.used = 0;
+        m_FreeBases.push_back(page.base);
+      }
+
+      return;
+    }
+  }
+
+  // not in any page - this was an oversized allocation
+  FreeAlignedBuffer(data);
+}
+
+int32_t ChunkAllocator::FindPage(byte *data)
+{
+  int32_t lo = 0, hi = m_Pages.count() - 1;
+
+  while(lo <= hi)
+  {
+    int32_t mid = (lo + hi) / 2;
+
+    if(data < m_Pages[mid].base)
+      hi = mid - 1;
+    else if(data >= m_Pages[mid].base + PageSize)
+      lo = mid + 1;
+    else
+      return mid;
+  }
+
+  return -1;
+}
+
 void DumpObject(FileIO::LogFileHandle *log, const rdcstr &indent, SDObject *obj)
 {
   if(obj->NumChildren() > 0)
@@ -113,6 +242,8 @@ uint32_t Serialiser<SerialiserMode::Reading>::BeginChunk(uint32_t, uint64_t)
 
   m_ChunkMetadata = SDChunkMetaData();
 
+  m_ChunkBase = m_Read->GetOffset();
+
   {
     uint32_t c = 0;
     bool success = m_Read->Read(c);
@@ -123,6 +254,8 @@ uint32_t Serialiser<SerialiserMode::Reading>::BeginChunk(uint32_t, uint64_t)
 
     chunkID = c & ChunkIndexMask;
 
+    m_ChunkCompact = (c & ChunkCompact) != 0;
+
     /////////////////
 
     m_ChunkMetadata.chunkID = chunkID;
@@ -295,8 +428,12 @@ void Serialiser<SerialiserMode::Reading>::EndChunk()
     }
   }
 
-  // align to the natural chunk alignment
-  m_Read->AlignTo<ChunkAlignment>();
+  // align to the natural chunk alignment, relative to where the chunk started - compact chunks
+  // carry no padding at all
+  if(!m_ChunkCompact)
+    m_Read->AlignTo<ChunkAlignment>(m_ChunkBase);
+
+  m_ChunkCompact = false;
 }
 
 /////////////////////////////////////////////////////////////
@@ -333,6 +470,10 @@ void Serialiser<SerialiserMode::Writing>::SetChunkMetadataRecording(uint32_t fla
 template <>
 uint32_t Serialiser<SerialiserMode::Writing>::BeginChunk(uint32_t chunkID, uint64_t byteLength)
 {
+  RecordChunkIndex(chunkID);
+
+  m_ChunkBase = m_Write->GetOffset();
+
   {
     // chunk index needs to be valid
     RDCASSERT(chunkID > 0);
@@ -345,6 +486,14 @@ uint32_t Serialiser<SerialiserMode::Writing>::BeginChunk(uint32_t chunkID, uint6
       if(byteLength > 0xffffffff)
         c |= Chunk64BitSize;
 
+      // chunks the filter marks as compact drop all their metadata and trailing padding - except
+      // when callstack capture is enabled, where every chunk keeps its callstack so the origin of
+      // even tiny state-setting calls stays available.
+      if(m_CompactChunks && !(m_ChunkFlags & ChunkCallstack) && m_CompactChunks(chunkID))
+        c = (chunkID & ChunkIndexMask) | (c & Chunk64BitSize) | ChunkCompact;
+
+      m_ChunkCompact = (c & ChunkCompact) != 0;
+
       m_ChunkMetadata.chunkID = chunkID;
 
       /////////////////
@@ -362,13 +511,46 @@ uint32_t Serialiser<SerialiserMode::Writing>::BeginChunk(uint32_t chunkID, uint6
 
           if(collect)
           {
-            Callstack::Stackwalk *stack = Callstack::Collect();
-            if(stack && stack->NumLevels() > 0)
+            // in fast-unwind mode we take a cheap fixed-depth frame pointer walk and use it as a
+            // key into a cache of full collections, so the expensive unwinder only runs once per
+            // unique call site. Stacks the frame pointer walk can't tell apart (e.g. differing
+            // only in frames without frame pointers) share a cache entry. This serialiser is
+            // per-thread on the capture path, so the cache needs no locking.
+            uint64_t fastAddrs[32];
+            size_t fastCount = 0;
+
+            if(Capture_CallstackFastUnwind)
+              fastCount = Callstack::CollectFast(fastAddrs, ARRAY_COUNT(fastAddrs));
+
+            if(fastCount > 0)
             {
-              m_ChunkMetadata.callstack.assign(stack->GetAddrs(), stack->NumLevels());
+              uint64_t hash = XXH64(fastAddrs, fastCount * sizeof(uint64_t), 0);
+
+              auto it = m_CallstackCache.find(hash);
+
+              if(it == m_CallstackCache.end())
+              {
+                it = m_CallstackCache.insert({hash, rdcarray<uint64_t>()}).first;
+
+                Callstack::Stackwalk *stack = Callstack::Collect();
+                if(stack && stack->NumLevels() > 0)
+                  it->second.assign(stack->GetAddrs(), stack->NumLevels());
+
+                SAFE_DELETE(stack);
+              }
+
+              m_ChunkMetadata.callstack = it->second;
             }
+            else
+            {
+              Callstack::Stackwalk *stack = Callstack::Collect();
+              if(stack && stack->NumLevels() > 0)
+              {
+                m_ChunkMetadata.callstack.assign(stack->GetAddrs(), stack->NumLevels());
+              }
 
-            SAFE_DELETE(stack);
+              SAFE_DELETE(stack);
+            }
           }
         }
 
@@ -530,8 +712,12 @@ void Serialiser<SerialiserMode::Writing>::EndChunk()
     }
   }
 
-  // align to the natural chunk alignment
-  m_Write->AlignTo<ChunkAlignment>();
+  // align to the natural chunk alignment, relative to where the chunk started - compact chunks
+  // carry no padding at all
+  if(!m_ChunkCompact)
+    m_Write->AlignTo<ChunkAlignment>(m_ChunkBase);
+
+  m_ChunkCompact = false;
 
   m_ChunkMetadata = SDChunkMetaData();
 
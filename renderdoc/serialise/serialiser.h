@@ -24,9 +24,11 @@
 
 #pragma once
 
+#include <map>
 #include <set>
 #include "api/replay/structured_data.h"
 #include "common/formatting.h"
+#include "common/threading.h"
 #include "streamio.h"
 
 // function to deallocate anything from a serialise. Default impl
@@ -50,6 +52,100 @@ void Deserialise(const T &el)
   template void DoSerialise(Serialiser<SerialiserMode::Reading> &, type &);
 
 typedef rdcstr (*ChunkLookup)(uint32_t chunkType);
+typedef bool (*CompactChunkFilter)(uint32_t chunkType);
+
+class ChunkAllocator;
+
+// A table of strings referenced by 32-bit id from serialised chunks, so that strings which repeat
+// in many chunks (debug names, shader entry points, file paths) are stored once in a separate
+// section of the capture instead of inline in every chunk, and read back without allocating each
+// time. When writing, recording serialisers on any thread intern strings as they are serialised
+// so the table is locked - the table only ever grows, keeping previously baked chunks valid. When
+// reading the table is loaded up front and is immutable, so lookups don't take the lock.
+class StringTable
+{
+public:
+  // sentinel written in place of a string's real length when the string is in the table and only
+  // its id follows. ~0U for unsigned lengths (rdcstr), -2 for signed lengths (char *, where -1
+  // already means a NULL string)
+  static const uint32_t TableRef = ~0U;
+  static const int32_t TableRefSigned = -2;
+
+  // a table reference costs 8 bytes on its own, so strings shorter than this stay inline - they
+  // don't repay the reference and the id lookup
+  static const uint32_t MinInternedLength = 8;
+
+  uint32_t Intern(const rdcstr &str)
+  {
+    SCOPED_LOCK(m_Lock);
+
+    auto it = m_Ids.find(str);
+    if(it != m_Ids.end())
+      return it->second;
+
+    uint32_t id = (uint32_t)m_Strings.size();
+    m_Strings.push_back(str);
+    m_Ids[str] = id;
+    return id;
+  }
+
+  const rdcstr &Lookup(uint32_t id) const
+  {
+    if(id < m_Strings.size())
+      return m_Strings[id];
+
+    RDCERR("Invalid string table id %u (table has %zu strings)", id, m_Strings.size());
+    return m_Invalid;
+  }
+
+  bool IsEmpty() const { return m_Strings.empty(); }
+  // writes the table as a count followed by each string's length and bytes, in id order. Locked
+  // because background recording on other threads can still be interning while a capture is saved
+  // - any id referenced by a chunk in this capture was interned before the chunk was flushed, so
+  // a consistent snapshot is all that's needed.
+  void Write(StreamWriter *w)
+  {
+    SCOPED_LOCK(m_Lock);
+
+    uint32_t count = (uint32_t)m_Strings.size();
+    w->Write(count);
+
+    for(const rdcstr &s : m_Strings)
+    {
+      uint32_t len = (uint32_t)s.size();
+      w->Write(len);
+      w->Write(s.c_str(), len);
+    }
+  }
+
+  void Read(StreamReader *r)
+  {
+    uint32_t count = 0;
+    r->Read(count);
+
+    m_Strings.reserve(count);
+
+    for(uint32_t i = 0; i < count && !r->IsErrored(); i++)
+    {
+      uint32_t len = 0;
+      r->Read(len);
+
+      rdcstr s;
+      s.resize((int)len);
+      if(len > 0)
+        r->Read(&s[0], len);
+
+      m_Strings.push_back(s);
+    }
+  }
+
+private:
+  Threading::CriticalSection m_Lock;
+  rdcarray<rdcstr> m_Strings;
+  // write-side reverse lookup, unused on read
+  std::map<rdcstr, uint32_t> m_Ids;
+  rdcstr m_Invalid;
+};
 
 enum class SerialiserFlags
 {
@@ -80,6 +176,26 @@ enum class SerialiserMode
 
 struct CompressedFileIO;
 
+// opt-in trait for structs whose member-by-member binary serialisation is bit-identical to their
+// in-memory representation: every member is a fixed-size arithmetic or enum type (or a struct that
+// itself qualifies), serialised exactly once in declaration order, with no internal padding and no
+// pointers, handles, unions or platform-size members. Declaring this is a statement about the wire
+// format, so only do it for types where that has been verified - arrays of qualifying structs then
+// take the bulk stream path in binary mode instead of walking each element, while structured
+// export continues to serialise member by member as before.
+template <typename T>
+struct SerialiseLayoutCompatible
+{
+  static const bool value = false;
+};
+
+#define DECLARE_SERIALISE_LAYOUT_COMPATIBLE(type) \
+  template <>                                     \
+  struct SerialiseLayoutCompatible<type>          \
+  {                                               \
+    static const bool value = true;               \
+  };
+
 template <SerialiserMode sertype>
 class Serialiser
 {
@@ -105,6 +221,9 @@ public:
     ChunkDuration = 0x00040000,
     ChunkTimestamp = 0x00080000,
     Chunk64BitSize = 0x00100000,
+    // the chunk carries no metadata and isn't padded to the chunk alignment afterwards, so tiny
+    // high-frequency chunks only pay for their header and payload
+    ChunkCompact = 0x00200000,
   };
 
   //////////////////////////////////////////
@@ -121,6 +240,30 @@ public:
   uint32_t GetChunkMetadataRecording() { return m_ChunkFlags; }
   void SetChunkMetadataRecording(uint32_t flags);
 
+  // optional recording of the stream offset where each chunk begins while writing, used to emit an
+  // index section so that readers can seek straight to a chunk instead of walking the whole stream
+  struct ChunkIndexEntry
+  {
+    uint32_t chunkID;
+    uint64_t offset;
+  };
+  void SetChunkIndexing(bool enabled) { m_ChunkIndexing = enabled; }
+  // optional filter marking chunk ids to write in compact form: no per-chunk metadata (thread ID,
+  // duration, timestamp) and no trailing alignment padding, cutting the fixed overhead for tiny
+  // high-frequency chunks from most of 100 bytes down to the 8 byte header. Ignored while
+  // callstack capture is enabled, so 'where was this call made' stays available on every chunk.
+  void SetCompactChunkFilter(CompactChunkFilter filter) { m_CompactChunks = filter; }
+  // sets the page allocator used for the data of chunks snapshotted from this serialiser. Chunks
+  // allocated this way must all be destroyed before the allocator is destroyed
+  void SetChunkAllocator(ChunkAllocator *alloc) { m_ChunkAllocator = alloc; }
+  ChunkAllocator *GetChunkAllocator() { return m_ChunkAllocator; }
+  rdcarray<ChunkIndexEntry> &GetChunkIndex() { return m_ChunkIndex; }
+  void RecordChunkIndex(uint32_t chunkID)
+  {
+    if(m_ChunkIndexing)
+      m_ChunkIndex.push_back({chunkID, m_Write->GetOffset()});
+  }
+
   // debug-only option to dump out (roughly) the data going through the serialiser as it happens
   void EnableDumping(FileIO::LogFileHandle *debugLog) { m_DebugDumpLog = debugLog; }
   SDChunkMetaData &ChunkMetadata() { return m_ChunkMetadata; }
@@ -131,6 +274,10 @@ public:
   void *GetUserData() { return m_pUserData; }
   void SetUserData(void *userData) { m_pUserData = userData; }
   void SetStringDatabase(std::set<rdcstr> *db) { m_ExtStringDB = db; }
+  // optional shared table of interned strings. When set on a writing serialiser, strings long
+  // enough to be worth it are stored as an id into the table instead of inline - the same table
+  // must then be provided to the reading serialiser to resolve them.
+  void ConfigureStringTable(StringTable *table) { m_StringTable = table; }
   // jumps to the byte after the current chunk, can be called any time after BeginChunk
   void SkipCurrentChunk();
 
@@ -279,7 +426,7 @@ public:
       if(IsWriting())
       {
         // ensure byte alignment
-        m_Write->AlignTo<ChunkAlignment>();
+        m_Write->AlignTo<ChunkAlignment>(m_ChunkBase);
 
         if(el)
           m_Write->Write(el, byteSize);
@@ -289,7 +436,7 @@ public:
       else if(IsReading())
       {
         // ensure byte alignment
-        m_Read->AlignTo<ChunkAlignment>();
+        m_Read->AlignTo<ChunkAlignment>(m_ChunkBase);
 
 // Coverity is unable to tie this allocation together with the automatic scoped deallocation in the
 // ScopedDeseralise* classes. We can verify with e.g. valgrind that there are no leaks, so to keep
@@ -388,13 +535,13 @@ public:
       if(IsWriting())
       {
         // ensure byte alignment
-        m_Write->AlignTo<ChunkAlignment>();
+        m_Write->AlignTo<ChunkAlignment>(m_ChunkBase);
         m_Write->Write(el.data(), count);
       }
       else if(IsReading())
       {
         // ensure byte alignment
-        m_Read->AlignTo<ChunkAlignment>();
+        m_Read->AlignTo<ChunkAlignment>(m_ChunkBase);
 
         el.resize((size_t)count);
 
@@ -543,13 +690,32 @@ public:
     }
     else
     {
-      for(size_t i = 0; i < N && i < count; i++)
-        SerialiseDispatch<Serialiser, T>::Do(*this, el[i]);
+      if(SerialiseBulkCopyable<T>::value)
+      {
+        const uint64_t num = RDCMIN((uint64_t)N, count);
+
+        if(IsWriting())
+          m_Write->Write(el, num * sizeof(T));
+        else if(IsReading())
+          m_Read->Read(el, num * sizeof(T));
 
-      for(size_t i = N; i < count; i++)
+        // if we have more data than the fixed sized array allows, discard the excess
+        for(uint64_t i = N; i < count; i++)
+        {
+          T dummy = T();
+          SerialiseDispatch<Serialiser, T>::Do(*this, dummy);
+        }
+      }
+      else
       {
-        T dummy = T();
-        SerialiseDispatch<Serialiser, T>::Do(*this, dummy);
+        for(size_t i = 0; i < N && i < count; i++)
+          SerialiseDispatch<Serialiser, T>::Do(*this, el[i]);
+
+        for(size_t i = N; i < count; i++)
+        {
+          T dummy = T();
+          SerialiseDispatch<Serialiser, T>::Do(*this, dummy);
+        }
       }
     }
 
@@ -669,8 +835,20 @@ public:
       }
 #endif
 
-      for(size_t i = 0; el && i < arrayCount; i++)
-        SerialiseDispatch<Serialiser, T>::Do(*this, el[i]);
+      if(SerialiseBulkCopyable<T>::value && el && arrayCount > 0)
+      {
+        // bulk path - the wire format for these types is identical to the in-memory layout, so the
+        // whole array can go through the stream in one operation.
+        if(IsWriting())
+          m_Write->Write(el, arrayCount * sizeof(T));
+        else if(IsReading())
+          m_Read->Read(el, arrayCount * sizeof(T));
+      }
+      else
+      {
+        for(size_t i = 0; el && i < arrayCount; i++)
+          SerialiseDispatch<Serialiser, T>::Do(*this, el[i]);
+      }
     }
 
     return *this;
@@ -740,8 +918,18 @@ public:
       if(IsReading())
         el.resize((int)size);
 
-      for(size_t i = 0; i < (size_t)size; i++)
-        SerialiseDispatch<Serialiser, U>::Do(*this, el[i]);
+      if(SerialiseBulkCopyable<U>::value && size > 0)
+      {
+        if(IsWriting())
+          m_Write->Write(el.data(), size * sizeof(U));
+        else if(IsReading())
+          m_Read->Read(el.data(), size * sizeof(U));
+      }
+      else
+      {
+        for(size_t i = 0; i < (size_t)size; i++)
+          SerialiseDispatch<Serialiser, U>::Do(*this, el[i]);
+      }
     }
 
     return *this;
@@ -932,7 +1120,7 @@ public:
     }
 
     // ensure byte alignment
-    m_Write->AlignTo<ChunkAlignment>();
+    m_Write->AlignTo<ChunkAlignment>(m_ChunkBase);
 
     StreamTransfer(m_Write, &stream, progress);
 
@@ -952,8 +1140,6 @@ public:
       m_InternalElement = false;
     }
 
-    size_t byteSize = (size_t)totalSize;
-
     byte *structBuf = NULL;
 
     if(ExportStructure())
@@ -989,7 +1175,7 @@ public:
     }
 
     // ensure byte alignment
-    m_Read->AlignTo<ChunkAlignment>();
+    m_Read->AlignTo<ChunkAlignment>(m_ChunkBase);
 
     if(totalSize > 0)
     {
@@ -1003,7 +1189,8 @@ public:
       if(totalSize % (uint64_t)bufSize > 0)
         numBufs++;
 
-      byte *buf = new byte[byteSize];
+      // only need one transfer buffer's worth, not the whole stream size
+      byte *buf = new byte[(size_t)bufSize];
 
       if(progress)
         progress(0.0001f);
@@ -1167,15 +1354,42 @@ public:
     if(IsReading())
     {
       m_Read->Read(len);
-      el.resize((int)len);
-      if(len > 0)
-        m_Read->Read(&el[0], len);
+      if(len == StringTable::TableRef)
+      {
+        uint32_t id = 0;
+        m_Read->Read(id);
+        if(m_StringTable)
+        {
+          el = m_StringTable->Lookup(id);
+        }
+        else
+        {
+          el.clear();
+          RDCERR("Chunk references the string table, but no string table was loaded");
+        }
+        len = (uint32_t)el.size();
+      }
+      else
+      {
+        el.resize((int)len);
+        if(len > 0)
+          m_Read->Read(&el[0], len);
+      }
     }
     else
     {
       len = (uint32_t)el.size();
-      m_Write->Write(len);
-      m_Write->Write(el.c_str(), len);
+      if(m_StringTable && len >= StringTable::MinInternedLength)
+      {
+        uint32_t id = m_StringTable->Intern(el);
+        m_Write->Write(StringTable::TableRef);
+        m_Write->Write(id);
+      }
+      else
+      {
+        m_Write->Write(len);
+        m_Write->Write(el.c_str(), len);
+      }
     }
 
     if(ExportStructure())
@@ -1199,6 +1413,18 @@ public:
       {
         el = NULL;
       }
+      else if(len == StringTable::TableRefSigned)
+      {
+        uint32_t id = 0;
+        m_Read->Read(id);
+        rdcstr str;
+        if(m_StringTable)
+          str = m_StringTable->Lookup(id);
+        else
+          RDCERR("Chunk references the string table, but no string table was loaded");
+        len = (int32_t)str.size();
+        el = (char *)StringDB(str);
+      }
       else
       {
         rdcstr str;
@@ -1211,9 +1437,18 @@ public:
     else
     {
       len = el ? (int32_t)strlen(el) : -1;
-      m_Write->Write(len);
-      if(len > 0)
-        m_Write->Write(el, len);
+      if(m_StringTable && len >= (int32_t)StringTable::MinInternedLength)
+      {
+        uint32_t id = m_StringTable->Intern(el);
+        m_Write->Write(StringTable::TableRefSigned);
+        m_Write->Write(id);
+      }
+      else
+      {
+        m_Write->Write(len);
+        if(len > 0)
+          m_Write->Write(el, len);
+      }
     }
 
     if(ExportStructure())
@@ -1241,6 +1476,19 @@ protected:
   void SetDummy(bool dummy) { m_Dummy = dummy; }
 private:
   static const uint64_t ChunkAlignment = 64;
+
+  // true for types where the binary serialised form is identical to the in-memory representation,
+  // so arrays of them can be read/written in one bulk stream operation instead of per-element.
+  // Structs only qualify when they've been explicitly verified and declared layout-compatible
+  // above - by default they serialise member by member, so their wire format doesn't match their
+  // memory layout even when they're trivially copyable.
+  template <typename T>
+  struct SerialiseBulkCopyable
+  {
+    static const bool value = std::is_arithmetic<T>::value || std::is_enum<T>::value ||
+                              SerialiseLayoutCompatible<T>::value;
+  };
+
   template <class SerialiserMode, typename T, bool isEnum = std::is_enum<T>::value>
   struct SerialiseDispatch
   {
@@ -1307,6 +1555,17 @@ private:
   uint64_t m_LastChunkOffset = 0;
   uint64_t m_ChunkFixup = 0;
 
+  // stream offset where the current chunk's header began. Chunk starts aren't guaranteed aligned
+  // in the stream (compact chunks aren't padded, and baked chunks are serialised at offset 0 then
+  // relocated wholesale), so all alignment inside a chunk is relative to this base - which is
+  // identical to absolute alignment in older captures, where every chunk started aligned.
+  uint64_t m_ChunkBase = 0;
+  // whether the current chunk is compact, i.e. has no trailing alignment padding
+  bool m_ChunkCompact = false;
+
+  // see SetCompactChunkFilter
+  CompactChunkFilter m_CompactChunks = NULL;
+
   bool m_ExportStructured = false;
   bool m_ExportBuffers = false;
   bool m_InternalElement = false;
@@ -1317,6 +1576,17 @@ private:
   uint32_t m_ChunkFlags = 0;
   SDChunkMetaData m_ChunkMetadata;
 
+  // see SetChunkIndexing
+  bool m_ChunkIndexing = false;
+  rdcarray<ChunkIndexEntry> m_ChunkIndex;
+
+  // see SetChunkAllocator
+  ChunkAllocator *m_ChunkAllocator = NULL;
+
+  // cache of full callstack collections keyed by a hash of the fast frame pointer walk, see
+  // BeginChunk. Only populated on writing serialisers with fast callstack collection enabled.
+  std::map<uint64_t, rdcarray<uint64_t>> m_CallstackCache;
+
   // a database of strings read from the file, useful when serialised structures
   // expect a char* to return and point to static memory
   std::set<rdcstr> m_StringDB;
@@ -1324,6 +1594,9 @@ private:
   // external storage - so the string storage can persist after the lifetime of the serialiser
   std::set<rdcstr> *m_ExtStringDB = NULL;
 
+  // see ConfigureStringTable
+  StringTable *m_StringTable = NULL;
+
   const char *StringDB(const rdcstr &s)
   {
     if(m_ExtStringDB)
@@ -1442,6 +1715,52 @@ DECLARE_STRINGISE_TYPE(SDObject *);
 
 class ScopedChunk;
 
+// Allocates chunk data storage out of large retained pages rather than with one heap allocation
+// per chunk, since a chunk is created for every wrapped API call on the capture hot path. Pages
+// are refcounted - once every chunk whose data lives on a page has been destroyed the page moves
+// to a free list for reuse, so the pool reaches a steady state while background capturing.
+//
+// Allocation and free are thread-safe, but all outstanding chunk data must be freed before the
+// allocator is destroyed.
+class ChunkAllocator
+{
+public:
+  ChunkAllocator() = default;
+  ~ChunkAllocator();
+
+  // no copies
+  ChunkAllocator(const ChunkAllocator &) = delete;
+  ChunkAllocator &operator=(const ChunkAllocator &) = delete;
+
+  byte *AllocChunkData(uint64_t size);
+  void FreeChunkData(byte *data);
+
+private:
+  static const uint64_t PageSize = 256 * 1024;
+
+  struct Page
+  {
+    byte *base;
+    uint64_t used;
+    int32_t refcount;
+  };
+
+  // finds the page containing the given pointer, or -1 if it's not from any page (i.e. an
+  // oversized allocation that went straight to the heap)
+  int32_t FindPage(byte *data);
+
+  // all allocated pages, sorted by base address so FindPage can binary search
+  rdcarray<Page> m_Pages;
+
+  // bases of pages whose refcount reached zero, ready for reuse
+  rdcarray<byte *> m_FreeBases;
+
+  // index in m_Pages of the page currently being filled, or -1
+  int32_t m_Current = -1;
+
+  Threading::SpinLock m_Lock;
+};
+
 // holds the memory, length and type for a given chunk, so that it can be
 // passed around and moved between owners before being serialised out
 class Chunk
@@ -1449,7 +1768,10 @@ class Chunk
 public:
   ~Chunk()
   {
-    FreeAlignedBuffer(m_Data);
+    if(m_Allocator)
+      m_Allocator->FreeChunkData(m_Data);
+    else
+      FreeAlignedBuffer(m_Data);
 
 #if ENABLED(RDOC_DEVEL)
     Atomic::Dec64(&m_LiveChunks);
@@ -1479,7 +1801,14 @@ public:
 
     m_ChunkType = chunkType;
 
-    m_Data = AllocAlignedBuffer(m_Length);
+    // on the capture hot path the serialiser has a page allocator attached so that we don't pay
+    // for a heap allocation on every wrapped API call
+    m_Allocator = ser.GetChunkAllocator();
+
+    if(m_Allocator)
+      m_Data = m_Allocator->AllocChunkData(m_Length);
+    else
+      m_Data = AllocAlignedBuffer(m_Length);
 
     memcpy(m_Data, ser.GetWriter()->GetData(), (size_t)m_Length);
 
@@ -1512,6 +1841,7 @@ public:
 
   void Write(Serialiser<SerialiserMode::Writing> &ser)
   {
+    ser.RecordChunkIndex(m_ChunkType);
     ser.GetWriter()->Write((const void *)m_Data, (size_t)m_Length);
   }
 
@@ -1527,6 +1857,9 @@ private:
   uint32_t m_Length;
   byte *m_Data;
 
+  // the allocator m_Data came from, or NULL if it was allocated on the heap
+  ChunkAllocator *m_Allocator = NULL;
+
 #if ENABLED(RDOC_DEVEL)
   static int64_t m_LiveChunks, m_TotalMem;
 #endif
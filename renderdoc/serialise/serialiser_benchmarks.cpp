@@ -0,0 +1,136 @@
+/******************************************************************************
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019-2020 Baldur Karlsson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+#include "serialiser.h"
+#include "zstdio.h"
+
+#if ENABLED(ENABLE_UNIT_TESTS)
+
+#include "catch/catch.hpp"
+
+// Throughput benchmarks for the serialisation hot paths, so that regressions in chunk write
+// speed or capture load speed show up before release. These have no pass/fail criteria and take
+// a while, so they're hidden from the default test run - execute them explicitly with:
+//
+//   renderdoccmd test unit "[benchmark]"
+
+TEST_CASE("Benchmark chunk write throughput", "[.][benchmark][serialiser]")
+{
+  WriteSerialiser ser(new StreamWriter(StreamWriter::DefaultScratchSize), Ownership::Stream);
+
+  // a plausible mix for a wrapped API call: a few scalars and a small array
+  uint64_t handle = 0x1234567812345678ULL;
+  uint32_t flags = 0x80;
+  int32_t counts[8] = {1, 2, 3, 4, 5, 6, 7, 8};
+  float depth = 0.5f;
+
+  BENCHMARK("small chunk write")
+  {
+    ser.WriteChunk(5);
+    SERIALISE_ELEMENT(handle);
+    SERIALISE_ELEMENT(flags);
+    SERIALISE_ELEMENT(counts);
+    SERIALISE_ELEMENT(depth);
+    ser.EndChunk();
+
+    ser.GetWriter()->Rewind();
+  }
+
+  bytebuf buffer;
+  buffer.resize(1024 * 1024);
+  for(size_t i = 0; i < buffer.size(); i++)
+    buffer[i] = byte(i * 37);
+
+  BENCHMARK("1MB buffer chunk write")
+  {
+    ser.WriteChunk(6);
+    SERIALISE_ELEMENT(buffer);
+    ser.EndChunk();
+
+    ser.GetWriter()->Rewind();
+  }
+}
+
+TEST_CASE("Benchmark chunk allocation rate", "[.][benchmark][serialiser][chunks]")
+{
+  WriteSerialiser ser(new StreamWriter(StreamWriter::DefaultScratchSize), Ownership::Stream);
+
+  uint64_t value = 42;
+
+  ser.WriteChunk(5);
+  SERIALISE_ELEMENT(value);
+  ser.EndChunk();
+
+  BENCHMARK("heap-allocated chunks")
+  {
+    Chunk *chunk = new Chunk(ser, 5);
+    delete chunk;
+  }
+
+  // rewrite the chunk data since snapshotting it rewound the writer
+  ser.WriteChunk(5);
+  SERIALISE_ELEMENT(value);
+  ser.EndChunk();
+
+  ChunkAllocator alloc;
+  ser.SetChunkAllocator(&alloc);
+
+  BENCHMARK("pooled chunks")
+  {
+    Chunk *chunk = new Chunk(ser, 5);
+    delete chunk;
+  }
+}
+
+TEST_CASE("Benchmark zstd decompression", "[.][benchmark][streamio]")
+{
+  // compressible but not degenerate input - a sawtooth with a slowly varying bias
+  bytebuf input;
+  input.resize(8 * 1024 * 1024);
+  for(size_t i = 0; i < input.size(); i++)
+    input[i] = byte((i % 192) + (i / 65536));
+
+  StreamWriter compressed(StreamWriter::DefaultScratchSize);
+
+  {
+    ZSTDCompressor comp(&compressed, Ownership::Nothing);
+    comp.Write(input.data(), input.size());
+    comp.Finish();
+  }
+
+  bytebuf output;
+  output.resize(input.size());
+
+  BENCHMARK("8MB zstd decompress")
+  {
+    StreamReader reader(compressed.GetData(), compressed.GetOffset());
+    ZSTDDecompressor decomp(&reader, Ownership::Nothing);
+
+    decomp.Read(output.data(), output.size());
+  }
+
+  CHECK(output == input);
+}
+
+#endif    // ENABLED(ENABLE_UNIT_TESTS)
@@ -672,6 +672,74 @@ TEST_CASE("Read/write chunk metadata", "[serialiser]")
   delete buf;
 };
 
+TEST_CASE("Chunk allocator page reuse", "[serialiser][chunks]")
+{
+  ChunkAllocator alloc;
+
+  SECTION("basic alloc and free")
+  {
+    byte *a = alloc.AllocChunkData(100);
+    byte *b = alloc.AllocChunkData(100);
+
+    REQUIRE(a != NULL);
+    REQUIRE(b != NULL);
+    CHECK(a != b);
+
+    // allocations should be 64-byte aligned like AllocAlignedBuffer
+    CHECK(uintptr_t(a) % 64 == 0);
+    CHECK(uintptr_t(b) % 64 == 0);
+
+    memset(a, 0xcd, 100);
+    memset(b, 0xab, 100);
+
+    CHECK(a[99] == 0xcd);
+    CHECK(b[0] == 0xab);
+
+    alloc.FreeChunkData(a);
+    alloc.FreeChunkData(b);
+  };
+
+  SECTION("oversized allocations fall back to the heap")
+  {
+    byte *big = alloc.AllocChunkData(4 * 1024 * 1024);
+
+    REQUIRE(big != NULL);
+
+    memset(big, 0x7c, 4 * 1024 * 1024);
+
+    alloc.FreeChunkData(big);
+  };
+
+  SECTION("pages are recycled once drained")
+  {
+    rdcarray<byte *> ptrs;
+
+    // allocate and free significantly more data than a single page holds - if pages weren't
+    // reused this would mean many distinct pages, so check for address reuse
+    std::set<byte *> seen;
+
+    for(int i = 0; i < 1000; i++)
+    {
+      byte *p = alloc.AllocChunkData(64 * 1024);
+      seen.insert(p);
+      ptrs.push_back(p);
+
+      if(ptrs.size() >= 8)
+      {
+        for(byte *q : ptrs)
+          alloc.FreeChunkData(q);
+        ptrs.clear();
+      }
+    }
+
+    for(byte *q : ptrs)
+      alloc.FreeChunkData(q);
+
+    // 1000 * 64kb = ~62.5MB of allocations should have been served from a handful of pages
+    CHECK(seen.size() < 100);
+  };
+};
+
 TEST_CASE("Verify multiple chunks can be merged", "[serialiser][chunks]")
 {
   StreamWriter *buf = new StreamWriter(StreamWriter::DefaultScratchSize);
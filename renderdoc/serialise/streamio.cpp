@@ -39,6 +39,138 @@ Decompressor::~Decompressor()
     delete m_Read;
 }
 
+// out-of-line definitions - BlockSize is passed by const reference through RDCMIN, which ODR-uses
+// it and leaves an undefined reference in unoptimised builds without these.
+const uint64_t PipelinedDecompressor::BlockSize;
+const int32_t PipelinedDecompressor::BlockCount;
+
+PipelinedDecompressor::PipelinedDecompressor(Decompressor *inner, uint64_t uncompressedSize,
+                                             Ownership own)
+    : Decompressor(NULL, Ownership::Nothing), m_Inner(inner), m_InnerOwnership(own)
+{
+  m_TotalSize = m_ConsumeRemaining = uncompressedSize;
+
+  for(int32_t i = 0; i < BlockCount; i++)
+  {
+    m_Blocks[i].data.resize((size_t)BlockSize);
+    m_Blocks[i].state = i;
+  }
+}
+
+PipelinedDecompressor::~PipelinedDecompressor()
+{
+  if(m_Thread)
+  {
+    // the worker checks this flag while it spins for a free block, and otherwise finishes
+    // naturally once it has decompressed the whole stream
+    Atomic::CmpExch32(&m_Stop, 0, 1);
+
+    Threading::JoinThread(m_Thread);
+    Threading::CloseThread(m_Thread);
+  }
+
+  if(m_InnerOwnership == Ownership::Stream && m_Inner)
+    delete m_Inner;
+}
+
+bool PipelinedDecompressor::Recompress(Compressor *comp)
+{
+  // recompressing reads the inner stream directly, which can't happen once the worker has
+  // started consuming it.
+  RDCASSERT(m_Thread == 0);
+
+  return m_Inner->Recompress(comp);
+}
+
+void PipelinedDecompressor::DecompressThread()
+{
+  uint64_t remaining = m_TotalSize;
+  int32_t b = 0;
+
+  while(remaining > 0)
+  {
+    Block &block = m_Blocks[b % BlockCount];
+
+    // wait for the consumer to drain whatever this block held last time around the ring
+    while(block.state != b)
+    {
+      if(m_Stop)
+        return;
+
+      Threading::Sleep(0);
+    }
+
+    if(m_Stop)
+      return;
+
+    uint64_t sz = RDCMIN(BlockSize, remaining);
+
+    if(!m_Inner->Read(block.data.data(), sz))
+    {
+      // flag the error, but still publish the block so the consumer wakes up and sees it
+      Atomic::CmpExch32(&m_Error, 0, 1);
+
+      block.size = sz;
+      Atomic::CmpExch32(&block.state, b, ~b);
+      return;
+    }
+
+    block.size = sz;
+    Atomic::CmpExch32(&block.state, b, ~b);
+
+    remaining -= sz;
+    b++;
+  }
+}
+
+bool PipelinedDecompressor::Read(void *data, uint64_t numBytes)
+{
+  if(numBytes == 0)
+    return true;
+
+  // reading past the declared uncompressed size would wait forever on a block that will never be
+  // filled, treat it as a stream error like the inner decompressor would.
+  if(numBytes > m_ConsumeRemaining)
+    return false;
+
+  if(m_Thread == 0)
+    m_Thread = Threading::CreateThread([this]() { DecompressThread(); });
+
+  byte *dest = (byte *)data;
+
+  while(numBytes > 0)
+  {
+    Block &block = m_Blocks[m_ConsumeBlock % BlockCount];
+
+    while(block.state != ~m_ConsumeBlock)
+      Threading::Sleep(0);
+
+    if(m_Error)
+      return false;
+
+    uint64_t copy = RDCMIN(block.size - m_ConsumeOffset, numBytes);
+
+    memcpy(dest, block.data.data() + m_ConsumeOffset, (size_t)copy);
+
+    dest += copy;
+    numBytes -= copy;
+    m_ConsumeOffset += copy;
+    m_ConsumeRemaining -= copy;
+
+    if(m_ConsumeOffset == block.size)
+    {
+      m_ConsumeOffset = 0;
+
+      // hand the block back for the one that maps onto this slot next time around the ring
+      Atomic::CmpExch32(&block.state, ~m_ConsumeBlock, m_ConsumeBlock + BlockCount);
+
+      m_ConsumeBlock++;
+    }
+  }
+
+  return true;
+}
+
 static const uint64_t initialBufferSize = 64 * 1024;
 const byte StreamWriter::empty[128] = {};
 
@@ -86,6 +218,25 @@ StreamReader::StreamReader(StreamDummyType)
   m_Dummy = true;
 }
 
+StreamReader::StreamReader(FileIO::FileMapping *mapping, uint64_t size)
+{
+  m_Mapping = mapping;
+
+  m_InputSize = m_BufferSize = size;
+
+  // we never write through this buffer so it's safe to cast away the const. The whole input is
+  // available immediately so reads are plain memcpys out of the view.
+  m_BufferHead = m_BufferBase = (byte *)FileIO::map_data(mapping);
+
+  m_Ownership = Ownership::Stream;
+
+  if(m_BufferBase == NULL)
+  {
+    m_InputSize = m_BufferSize = 0;
+    m_HasError = true;
+  }
+}
+
 StreamReader::StreamReader(Network::Socket *sock, Ownership own)
 {
   m_Sock = sock;
@@ -116,6 +267,10 @@ StreamReader::StreamReader(FILE *file, uint64_t fileSize, Ownership own)
   m_File = file;
   m_InputSize = fileSize;
 
+  // we read the file front-to-back, tell the kernel so it can read ahead of us while the caller is
+  // busy processing earlier data.
+  FileIO::fadvise_sequential(m_File, 0, 0);
+
   m_BufferSize = initialBufferSize;
   m_BufferHead = m_BufferBase = AllocAlignedBuffer(m_BufferSize);
 
@@ -143,6 +298,8 @@ StreamReader::StreamReader(FILE *file)
 
   m_File = file;
 
+  FileIO::fadvise_sequential(m_File, 0, 0);
+
   m_BufferSize = initialBufferSize;
   m_BufferHead = m_BufferBase = AllocAlignedBuffer(m_BufferSize);
 
@@ -179,7 +336,10 @@ StreamReader::~StreamReader()
   for(StreamCloseCallback cb : m_Callbacks)
     cb();
 
-  FreeAlignedBuffer(m_BufferBase);
+  if(m_Mapping)
+    FileIO::map_close(m_Mapping);
+  else
+    FreeAlignedBuffer(m_BufferBase);
 
   if(m_Ownership == Ownership::Stream)
   {
@@ -372,6 +532,11 @@ bool StreamReader::ReadFromExternal(void *buffer, uint64_t length)
   {
     uint64_t numRead = FileIO::fread(buffer, 1, (size_t)length, m_File);
     success = (numRead == length);
+
+    // for full buffer refills, ask the kernel to fetch the next window from disk while the caller
+    // processes this one. Small reads (e.g. the 128-byte tail preserve) don't issue a hint.
+    if(success && length >= initialBufferSize)
+      FileIO::fadvise_willneed(m_File, FileIO::ftell64(m_File), m_BufferSize);
   }
   else if(m_Sock)
   {
@@ -485,6 +650,29 @@ StreamWriter::StreamWriter(FILE *file, Ownership own)
   m_InMemory = false;
 }
 
+static const int32_t AsyncFree = 0;
+static const int32_t AsyncPending = 1;
+
+StreamWriter::StreamWriter(FILE *file, Ownership own, uint64_t bufferSize)
+{
+  m_BufferBase = m_BufferHead = m_BufferEnd = NULL;
+
+  m_File = file;
+
+  m_Ownership = own;
+  m_InMemory = false;
+
+  if(bufferSize > 0)
+  {
+    m_AsyncSize = bufferSize;
+
+    for(AsyncBuffer &buf : m_AsyncBuffers)
+      buf.data = AllocAlignedBuffer(bufferSize);
+
+    m_AsyncThread = Threading::CreateThread([this]() { AsyncWriteThreadEntry(); });
+  }
+}
+
 StreamWriter::StreamWriter(Compressor *compressor, Ownership own)
 {
   m_BufferBase = m_BufferHead = m_BufferEnd = NULL;
@@ -497,6 +685,21 @@ StreamWriter::StreamWriter(Compressor *compressor, Ownership own)
 
 StreamWriter::~StreamWriter()
 {
+  // ensure all outstanding writes have hit the disk before the close callbacks run, since they may
+  // seek around in the file to fix up headers.
+  if(m_AsyncThread)
+  {
+    DrainAsyncWrites();
+
+    Atomic::Inc32(&m_KillThread);
+    Threading::JoinThread(m_AsyncThread);
+    Threading::CloseThread(m_AsyncThread);
+    m_AsyncThread = 0;
+
+    for(AsyncBuffer &buf : m_AsyncBuffers)
+      FreeAlignedBuffer(buf.data);
+  }
+
   for(StreamCloseCallback cb : m_Callbacks)
     cb();
 
@@ -512,6 +715,111 @@ StreamWriter::~StreamWriter()
   }
 }
 
+bool StreamWriter::WriteFileData(const void *data, uint64_t numBytes)
+{
+  // synchronous path - write straight through to the file
+  if(m_AsyncSize == 0)
+  {
+    uint64_t written = (uint64_t)FileIO::fwrite(data, 1, (size_t)numBytes, m_File);
+    if(written != numBytes)
+    {
+      HandleError();
+      return false;
+    }
+
+    return true;
+  }
+
+  const byte *src = (const byte *)data;
+
+  while(numBytes > 0)
+  {
+    AsyncBuffer &buf = m_AsyncBuffers[m_CurAsync];
+
+    // wait for the background thread to finish with this buffer before filling it again
+    while(buf.state != AsyncFree)
+      Threading::Sleep(0);
+
+    const uint64_t copyBytes = RDCMIN(m_AsyncSize - buf.size, numBytes);
+
+    memcpy(buf.data + buf.size, src, (size_t)copyBytes);
+
+    buf.size += copyBytes;
+    src += copyBytes;
+    numBytes -= copyBytes;
+
+    if(buf.size == m_AsyncSize)
+      SubmitAsyncBuffer();
+  }
+
+  if(m_AsyncError)
+  {
+    HandleError();
+    return false;
+  }
+
+  return true;
+}
+
+void StreamWriter::SubmitAsyncBuffer()
+{
+  Atomic::CmpExch32(&m_AsyncBuffers[m_CurAsync].state, AsyncFree, AsyncPending);
+
+  // the background thread consumes buffers in the same alternating order that we submit them, so
+  // the file contents stay in submission order.
+  m_CurAsync = 1 - m_CurAsync;
+}
+
+void StreamWriter::DrainAsyncWrites()
+{
+  if(m_AsyncSize == 0)
+    return;
+
+  if(m_AsyncBuffers[m_CurAsync].size > 0)
+    SubmitAsyncBuffer();
+
+  for(AsyncBuffer &buf : m_AsyncBuffers)
+  {
+    while(buf.state != AsyncFree)
+      Threading::Sleep(0);
+  }
+
+  if(m_AsyncError)
+    HandleError();
+}
+
+void StreamWriter::AsyncWriteThreadEntry()
+{
+  Threading::SetCurrentThreadName("Stream Writer");
+
+  int idx = 0;
+
+  while(true)
+  {
+    AsyncBuffer &buf = m_AsyncBuffers[idx];
+
+    if(buf.state == AsyncPending)
+    {
+      uint64_t written = (uint64_t)FileIO::fwrite(buf.data, 1, (size_t)buf.size, m_File);
+      if(written != buf.size)
+        Atomic::Inc32(&m_AsyncError);
+
+      buf.size = 0;
+
+      // only release the buffer back to the caller once the data is written out
+      Atomic::CmpExch32(&buf.state, AsyncPending, AsyncFree);
+
+      idx = 1 - idx;
+      continue;
+    }
+
+    if(m_KillThread)
+      break;
+
+    Threading::Sleep(0);
+  }
+}
+
 bool StreamWriter::SendSocketData(const void *data, uint64_t numBytes)
 {
   // try to coalesce small writes without doing blocking sends, at least until we're flushed.
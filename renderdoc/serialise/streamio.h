@@ -66,6 +66,54 @@ protected:
   Ownership m_Ownership;
 };
 
+// Runs another decompressor on a worker thread, decompressing a bounded number of blocks ahead of
+// the consumer. Reading a compressed stream otherwise alternates between decompressing a buffer's
+// worth of data and parsing it, so on large sections this overlaps the two and roughly hides
+// whichever is cheaper. The worker is only started on the first Read() - a wrapped decompressor
+// that is only ever Recompress()'d never spawns a thread.
+class PipelinedDecompressor : public Decompressor
+{
+public:
+  // uncompressedSize must be the exact total number of bytes that will be read, as with the
+  // StreamReader decompressor constructor - the worker uses it to size its reads from the inner
+  // decompressor.
+  PipelinedDecompressor(Decompressor *inner, uint64_t uncompressedSize, Ownership own);
+  ~PipelinedDecompressor();
+  bool Recompress(Compressor *comp);
+  bool Read(void *data, uint64_t numBytes);
+
+private:
+  void DecompressThread();
+
+  static const uint64_t BlockSize = 4 * 1024 * 1024;
+  static const int32_t BlockCount = 4;
+
+  // block state follows the same scheme as other slot rings: state == b means the worker may fill
+  // it with block b, state == ~b means block b is decompressed and ready for the consumer.
+  struct Block
+  {
+    bytebuf data;
+    uint64_t size = 0;
+    volatile int32_t state = 0;
+  };
+
+  Block m_Blocks[BlockCount];
+
+  Decompressor *m_Inner;
+  Ownership m_InnerOwnership;
+
+  Threading::ThreadHandle m_Thread = 0;
+  volatile int32_t m_Stop = 0;
+  volatile int32_t m_Error = 0;
+
+  uint64_t m_TotalSize = 0;
+
+  // consumer-side position, only touched from Read()
+  int32_t m_ConsumeBlock = 0;
+  uint64_t m_ConsumeOffset = 0;
+  uint64_t m_ConsumeRemaining = 0;
+};
+
 class StreamReader
 {
 public:
@@ -86,6 +134,8 @@ public:
   StreamReader(Network::Socket *sock, Ownership own);
   StreamReader(FILE *file, uint64_t fileSize, Ownership own);
   StreamReader(FILE *file);
+  // reads zero-copy out of a memory-mapped file region, taking ownership of the mapping
+  StreamReader(FileIO::FileMapping *mapping, uint64_t size);
   StreamReader(StreamReader *reader, uint64_t bufferSize);
   StreamReader(Decompressor *decompressor, uint64_t uncompressedSize, Ownership own);
 
@@ -107,7 +157,14 @@ public:
   template <uint64_t alignment>
   bool AlignTo()
   {
-    uint64_t offs = GetOffset();
+    return AlignTo<alignment>(0);
+  }
+  // align relative to a base offset rather than the start of the stream, for data whose container
+  // isn't itself guaranteed to start on an aligned boundary
+  template <uint64_t alignment>
+  bool AlignTo(uint64_t base)
+  {
+    uint64_t offs = GetOffset() - base;
     uint64_t alignedOffs = AlignUp(offs, alignment);
 
     uint64_t bytesToAlign = alignedOffs - offs;
@@ -263,6 +320,10 @@ private:
   // the decompressor, if reading from it
   Decompressor *m_Decompressor = NULL;
 
+  // the file mapping backing m_BufferBase, if we're reading from a memory-mapped file. The buffer
+  // is unmapped rather than freed on destruction.
+  FileIO::FileMapping *m_Mapping = NULL;
+
   // the offset in the file/decompressor that corresponds to the start of m_BufferBase
   uint64_t m_ReadOffset = 0;
 
@@ -292,11 +353,15 @@ public:
   StreamWriter(StreamInvalidType);
   StreamWriter(uint64_t initialBufSize);
   StreamWriter(FILE *file, Ownership own);
+  // as above, but writes are double-buffered and flushed to the file from a background thread so
+  // that the caller isn't stalled on disk I/O. Each of the two buffers is bufferSize bytes.
+  StreamWriter(FILE *file, Ownership own, uint64_t bufferSize);
   StreamWriter(Network::Socket *file, Ownership own);
   StreamWriter(Compressor *compressor, Ownership own);
 
   bool IsErrored() { return m_HasError; }
   static const int DefaultScratchSize = 32 * 1024;
+  static const uint64_t DefaultAsyncBufferSize = 4 * 1024 * 1024;
 
   ~StreamWriter();
 
@@ -316,6 +381,13 @@ public:
   const byte *GetData() { return m_BufferBase; }
   template <uint64_t alignment>
   bool AlignTo()
+  {
+    return AlignTo<alignment>(0);
+  }
+  // align relative to a base offset rather than the start of the stream, for data whose container
+  // isn't itself guaranteed to start on an aligned boundary
+  template <uint64_t alignment>
+  bool AlignTo(uint64_t base)
   {
     uint64_t offs;
     if(m_InMemory)
@@ -323,6 +395,8 @@ public:
     else
       offs = GetOffset();
 
+    offs -= base;
+
     uint64_t alignedOffs = AlignUp(offs, alignment);
 
     uint64_t bytesToAlign = alignedOffs - offs;
@@ -365,14 +439,7 @@ public:
     }
     else if(m_File)
     {
-      uint64_t written = (uint64_t)FileIO::fwrite(data, 1, (size_t)numBytes, m_File);
-      if(written != numBytes)
-      {
-        HandleError();
-        return false;
-      }
-
-      return true;
+      return WriteFileData(data, numBytes);
     }
     else if(m_Sock)
     {
@@ -443,7 +510,10 @@ public:
     if(m_Compressor)
       return true;
     else if(m_File)
+    {
+      DrainAsyncWrites();
       return FileIO::fflush(m_File);
+    }
     else if(m_Sock)
       return FlushSocketData();
 
@@ -455,7 +525,10 @@ public:
     if(m_Compressor)
       return m_Compressor->Finish();
     else if(m_File)
+    {
+      DrainAsyncWrites();
       return FileIO::fflush(m_File);
+    }
     else if(m_Sock)
       return true;
 
@@ -491,6 +564,11 @@ private:
 
   void HandleError();
 
+  bool WriteFileData(const void *data, uint64_t numBytes);
+  void SubmitAsyncBuffer();
+  void DrainAsyncWrites();
+  void AsyncWriteThreadEntry();
+
   bool SendSocketData(const void *data, uint64_t numBytes);
   bool FlushSocketData();
 
@@ -512,6 +590,27 @@ private:
   // file pointer, if we're writing to a file
   FILE *m_File = NULL;
 
+  // double-buffered asynchronous file writes. While the background thread is flushing one buffer
+  // to disk the caller fills the other, alternating between them in strict order.
+  struct AsyncBuffer
+  {
+    byte *data = NULL;
+    uint64_t size = 0;
+    volatile int32_t state = 0;
+  };
+
+  AsyncBuffer m_AsyncBuffers[2];
+
+  // size of each async buffer. 0 means async writing is disabled and writes go straight to the file
+  uint64_t m_AsyncSize = 0;
+
+  // which buffer the caller is currently filling
+  int m_CurAsync = 0;
+
+  Threading::ThreadHandle m_AsyncThread = 0;
+  volatile int32_t m_KillThread = 0;
+  volatile int32_t m_AsyncError = 0;
+
   // the compressor, if writing to it
   Compressor *m_Compressor = NULL;
 
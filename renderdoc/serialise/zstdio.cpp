@@ -22,30 +22,234 @@
  * THE SOFTWARE.
  ******************************************************************************/
 
+#include <math.h>
+
 #define ZSTD_STATIC_LINKING_ONLY
 #include "zstdio.h"
 
 static const uint64_t zstdBlockSize = 128 * 1024;
 static const uint64_t compressBlockSize = ZSTD_compressBound(zstdBlockSize);
 
-ZSTDCompressor::ZSTDCompressor(StreamWriter *write, Ownership own) : Compressor(write, own)
+// states for ZSTDCompressor::Block::state
+static const int32_t BlockFree = 0;       // available for the calling thread to fill & submit
+static const int32_t BlockPending = 1;    // filled, waiting for a worker to pick it up
+static const int32_t BlockBusy = 2;       // claimed by a worker, compression in progress
+static const int32_t BlockDone = 3;       // compressed, waiting to be written out in order
+static const int32_t BlockErrored = 4;    // compression failed
+
+// the fixed level used when single-threaded, and the starting point when adapting
+static const int32_t zstdDefaultLevel = 7;
+
+// pages whose byte entropy is above this (in bits per byte, out of 8) are candidates for being
+// stored as raw blocks instead of compressed. Already-compressed resource data -
+// block-compressed textures, compressed animation - sits around 7.95+, and zstd grinds through
+// its match search on it for a ~1.00 ratio. The estimator can't see matches though (a sequential
+// byte ramp reads as entropy 8.0 but compresses massively), so a page over the threshold is only
+// stored raw once a cheap trial compression confirms it really doesn't shrink.
+static const float entropySkipThreshold = 7.9f;
+
+// bounds for the adaptive level. Even level 1 beats lz4-style codecs on ratio, and above 12 the
+// throughput cliff is steep enough that a stalled ring would take a long time to recover.
+static const int32_t zstdMinLevel = 1;
+static const int32_t zstdMaxLevel = 12;
+
+// Note on dictionaries: small chunky sections would compress better if each 128KB block were
+// primed with a shared dictionary, but every frame below is deliberately self-contained. A
+// dictionary - even a raw content one via ZSTD_initCStream_usingDict, which the vendored zstd
+// does expose - changes the frame bitstream, so readers would need to be told about it. The only
+// place to signal that is a new public SectionFlags bit, and older builds select this codec
+// purely from the existing flags, so they would misdecode such captures rather than cleanly
+// refusing them. The ZDICT training APIs aren't vendored either (we don't build dictBuilder).
+// If the capture container ever grows per-section codec parameters, revisit this.
+
+ZSTDCompressor::ZSTDCompressor(StreamWriter *write, Ownership own, bool multithreaded)
+    : Compressor(write, own)
 {
   m_Page = AllocAlignedBuffer(zstdBlockSize);
   m_CompressBuffer = AllocAlignedBuffer(compressBlockSize);
 
   m_PageOffset = 0;
 
+  m_Level = zstdDefaultLevel;
+
   m_Stream = ZSTD_createCStream();
+
+  // with fewer than two spare cores the thread ping-pong costs more than it gains, so stay
+  // single-threaded. The on-disk format is identical either way.
+  uint32_t threadCount = RDCMIN(8U, Threading::GetCPUCoreCount() - 1);
+
+  if(multithreaded && threadCount >= 2)
+  {
+    m_Blocks.resize(threadCount * 2);
+
+    for(Block &block : m_Blocks)
+    {
+      block.in = AllocAlignedBuffer(zstdBlockSize);
+      block.out = AllocAlignedBuffer(compressBlockSize);
+      block.inSize = 0;
+      block.outSize = 0;
+      block.state = BlockFree;
+    }
+
+    m_WorkerStreams.resize(threadCount);
+    m_Threads.resize(threadCount);
+
+    for(size_t i = 0; i < threadCount; i++)
+    {
+      m_WorkerStreams[i] = ZSTD_createCStream();
+      m_Threads[i] = Threading::CreateThread([this, i]() { WorkerEntry(i); });
+    }
+  }
 }
 
 ZSTDCompressor::~ZSTDCompressor()
 {
+  Atomic::Inc32(&m_Kill);
+
+  for(Threading::ThreadHandle thread : m_Threads)
+  {
+    Threading::JoinThread(thread);
+    Threading::CloseThread(thread);
+  }
+
+  for(ZSTD_CStream *stream : m_WorkerStreams)
+    ZSTD_freeCStream(stream);
+
+  for(Block &block : m_Blocks)
+  {
+    FreeAlignedBuffer(block.in);
+    FreeAlignedBuffer(block.out);
+  }
+
   ZSTD_freeCStream(m_Stream);
 
   FreeAlignedBuffer(m_Page);
   FreeAlignedBuffer(m_CompressBuffer);
 }
 
+void ZSTDCompressor::WorkerEntry(size_t threadIdx)
+{
+  ZSTD_CStream *stream = m_WorkerStreams[threadIdx];
+
+  while(m_Kill == 0)
+  {
+    bool found = false;
+
+    for(Block &block : m_Blocks)
+    {
+      if(Atomic::CmpExch32(&block.state, BlockPending, BlockBusy) != BlockPending)
+        continue;
+
+      found = true;
+
+      ZSTD_inBuffer in = {block.in, (size_t)block.inSize, 0};
+      ZSTD_outBuffer out = {block.out, (size_t)compressBlockSize, 0};
+
+      if(CompressZSTDFrame(stream, in, out, m_Level))
+      {
+        block.outSize = out.pos;
+        Atomic::CmpExch32(&block.state, BlockBusy, BlockDone);
+      }
+      else
+      {
+        SetError();
+        Atomic::CmpExch32(&block.state, BlockBusy, BlockErrored);
+      }
+    }
+
+    // if the ring was completely idle yield our timeslice rather than spinning hot - the calling
+    // thread is the producer so if it's starved we'll never get more work.
+    if(!found)
+      Threading::Sleep(0);
+  }
+}
+
+void ZSTDCompressor::SetError()
+{
+  Atomic::CmpExch32(&m_Error, 0, 1);
+}
+
+void ZSTDCompressor::AdaptLevel(bool stalled)
+{
+  if(stalled)
+  {
+    // the workers can't keep up with the rate we're producing data, trade ratio for speed
+    m_SmoothBlocks = 0;
+
+    if(m_Level > zstdMinLevel)
+      m_Level--;
+  }
+  else
+  {
+    // a long stretch of blocks retired without ever waiting means there's spare compression
+    // capacity - e.g. the disk is the bottleneck - so spend it on a better ratio. Much slower
+    // than the drop so a borderline machine settles low rather than oscillating.
+    m_SmoothBlocks++;
+
+    if(m_SmoothBlocks >= 64 && m_Level < zstdMaxLevel)
+    {
+      m_SmoothBlocks = 0;
+      m_Level++;
+    }
+  }
+}
+
+bool ZSTDCompressor::SubmitPage()
+{
+  Block &block = m_Blocks[m_Head % m_Blocks.size()];
+
+  // if the ring is full, retire the oldest block first to free up this slot
+  if(m_Head - m_Tail == (uint64_t)m_Blocks.size())
+  {
+    if(!DrainBlock(true))
+      return false;
+  }
+
+  std::swap(m_Page, block.in);
+  block.inSize = m_PageOffset;
+  m_PageOffset = 0;
+
+  Atomic::CmpExch32(&block.state, BlockFree, BlockPending);
+  m_Head++;
+
+  return m_Error == 0;
+}
+
+bool ZSTDCompressor::DrainBlock(bool adapt)
+{
+  Block &block = m_Blocks[m_Tail % m_Blocks.size()];
+
+  bool stalled = false;
+
+  // spin until a worker has finished with this block. Blocks are written strictly in submission
+  // order so the stream layout is the same as the single-threaded path.
+  while(block.state != BlockDone && block.state != BlockErrored)
+  {
+    stalled = true;
+    Threading::Sleep(0);
+  }
+
+  // only adapt while the producer is still running - waiting here during Finish() is expected
+  // and says nothing about throughput.
+  if(adapt)
+    AdaptLevel(stalled);
+
+  if(block.state == BlockErrored || m_Error != 0)
+    return false;
+
+  bool success = true;
+
+  // a bit redundant to write this but it means we can read the entire frame without
+  // doing multiple reads
+  success &= m_Write->Write((uint32_t)block.outSize);
+  success &= m_Write->Write(block.out, block.outSize);
+
+  Atomic::CmpExch32(&block.state, BlockDone, BlockFree);
+  m_Tail++;
+
+  return success;
+}
+
 bool ZSTDCompressor::Write(const void *data, uint64_t numBytes)
 {
   // if we encountered a stream error this will be NULL
@@ -65,7 +269,7 @@ bool ZSTDCompressor::Write(const void *data, uint64_t numBytes)
     memcpy(m_Page + m_PageOffset, data, (size_t)numBytes);
     m_PageOffset += numBytes;
 
-    return true;
+    return m_Error == 0;
   }
   else
   {
@@ -112,7 +316,13 @@ bool ZSTDCompressor::Finish()
   // only the last one can be smaller, so we only write a partial page when finishing.
   // Calling Write() after Finish() is illegal
 
-  return FlushPage();
+  bool success = FlushPage();
+
+  // retire any blocks still in flight on the workers, in order
+  while(success && m_Tail < m_Head)
+    success = DrainBlock(false);
+
+  return success && m_Error == 0;
 }
 
 bool ZSTDCompressor::FlushPage()
@@ -121,16 +331,22 @@ bool ZSTDCompressor::FlushPage()
   if(!m_CompressBuffer)
     return false;
 
+  // with a worker pool, hand the page off rather than compressing it here
+  if(!m_Blocks.empty())
+    return SubmitPage();
+
   ZSTD_inBuffer in = {m_Page, (size_t)m_PageOffset, 0};
   ZSTD_outBuffer out = {m_CompressBuffer, ZSTD_CStreamOutSize(), 0};
 
   bool success = true;
 
-  success &= CompressZSTDFrame(in, out);
+  success &= CompressZSTDFrame(m_Stream, in, out, zstdDefaultLevel);
 
-  // if there was an error, bail
-  if(!m_CompressBuffer)
+  if(!success)
+  {
+    SetError();
     return false;
+  }
 
   // a bit redundant to write this but it means we can read the entire frame without
   // doing multiple reads
@@ -143,16 +359,96 @@ bool ZSTDCompressor::FlushPage()
   return success;
 }
 
-bool ZSTDCompressor::CompressZSTDFrame(ZSTD_inBuffer &in, ZSTD_outBuffer &out)
+// Shannon entropy of the data's byte histogram, in bits per byte
+static float EstimateEntropy(const byte *data, size_t size)
 {
-  size_t err = ZSTD_initCStream(m_Stream, 7);
+  uint32_t hist[256] = {};
+
+  for(size_t i = 0; i < size; i++)
+    hist[data[i]]++;
+
+  float entropy = 0.0f;
+  const float invSize = 1.0f / float(size);
+
+  for(uint32_t count : hist)
+  {
+    if(count == 0)
+      continue;
+
+    float p = float(count) * invSize;
+    entropy -= p * log2f(p);
+  }
+
+  return entropy;
+}
+
+// writes the input into the output as a zstd frame of raw (stored) blocks. The result is a
+// standard frame - any zstd decoder accepts it, so the stream format doesn't change - it just
+// costs 9 bytes of frame header plus 3 bytes per 128KB block instead of a match search over data
+// that won't compress.
+static bool StoreRawZSTDFrame(ZSTD_inBuffer &in, ZSTD_outBuffer &out)
+{
+  const size_t maxBlockSize = 128 * 1024;
+
+  const byte *src = (const byte *)in.src;
+  byte *dst = (byte *)out.dst;
+  size_t pos = out.pos;
+
+  if(pos + 9 + 3 * (in.size / maxBlockSize + 1) + in.size > out.size)
+  {
+    RDCERR("Output buffer too small to store %zu bytes raw", in.size);
+    return false;
+  }
+
+  // frame magic number, little-endian
+  dst[pos++] = 0x28;
+  dst[pos++] = 0xB5;
+  dst[pos++] = 0x2F;
+  dst[pos++] = 0xFD;
+
+  // frame header descriptor: single segment, 4-byte frame content size
+  dst[pos++] = 0xA0;
+
+  dst[pos++] = byte(in.size & 0xff);
+  dst[pos++] = byte((in.size >> 8) & 0xff);
+  dst[pos++] = byte((in.size >> 16) & 0xff);
+  dst[pos++] = byte((in.size >> 24) & 0xff);
+
+  size_t remaining = in.size;
+
+  do
+  {
+    size_t blockSize = RDCMIN(maxBlockSize, remaining);
+
+    // 3-byte block header: bit 0 is the last-block flag, bits 1-2 the block type (0 = raw),
+    // bits 3+ the block size
+    uint32_t header = uint32_t(blockSize << 3) | (blockSize == remaining ? 1 : 0);
+
+    dst[pos++] = byte(header & 0xff);
+    dst[pos++] = byte((header >> 8) & 0xff);
+    dst[pos++] = byte((header >> 16) & 0xff);
+
+    memcpy(dst + pos, src, blockSize);
+
+    pos += blockSize;
+    src += blockSize;
+    remaining -= blockSize;
+  } while(remaining > 0);
+
+  in.pos = in.size;
+  out.pos = pos;
+
+  return true;
+}
+
+// compresses the input into the output as a single self-contained zstd frame
+static bool CompressFrame(ZSTD_CStream *stream, ZSTD_inBuffer &in, ZSTD_outBuffer &out, int level)
+{
+  size_t err = ZSTD_initCStream(stream, level);
 
   if(ZSTD_isError(err))
   {
     RDCERR("Error compressing: %s", ZSTD_getErrorName(err));
-    FreeAlignedBuffer(m_Page);
-    FreeAlignedBuffer(m_CompressBuffer);
-    m_Page = m_CompressBuffer = NULL;
     return false;
   }
 
@@ -162,7 +458,7 @@ bool ZSTDCompressor::CompressZSTDFrame(ZSTD_inBuffer &in, ZSTD_outBuffer &out)
     size_t inpos = in.pos;
     size_t outpos = out.pos;
 
-    err = ZSTD_compressStream(m_Stream, &out, &in);
+    err = ZSTD_compressStream(stream, &out, &in);
 
     if(ZSTD_isError(err) || (inpos == in.pos && outpos == out.pos))
     {
@@ -170,14 +466,11 @@ bool ZSTDCompressor::CompressZSTDFrame(ZSTD_inBuffer &in, ZSTD_outBuffer &out)
         RDCERR("Error compressing: %s", ZSTD_getErrorName(err));
       else
         RDCERR("Error compressing, no progress made");
-      FreeAlignedBuffer(m_Page);
-      FreeAlignedBuffer(m_CompressBuffer);
-      m_Page = m_CompressBuffer = NULL;
       return false;
     }
   }
 
-  err = ZSTD_endStream(m_Stream, &out);
+  err = ZSTD_endStream(stream, &out);
 
   if(ZSTD_isError(err) || err != 0)
   {
@@ -185,16 +478,44 @@ bool ZSTDCompressor::CompressZSTDFrame(ZSTD_inBuffer &in, ZSTD_outBuffer &out)
       RDCERR("Error compressing: %s", ZSTD_getErrorName(err));
     else
       RDCERR("Error compressing, couldn't end stream");
-    FreeAlignedBuffer(m_Page);
-    FreeAlignedBuffer(m_CompressBuffer);
-    m_Page = m_CompressBuffer = NULL;
     return false;
   }
 
   return true;
 }
 
-ZSTDDecompressor::ZSTDDecompressor(StreamReader *read, Ownership own) : Decompressor(read, own)
+bool ZSTDCompressor::CompressZSTDFrame(ZSTD_CStream *stream, ZSTD_inBuffer &in,
+                                       ZSTD_outBuffer &out, int level)
+{
+  // store pages of already-compressed data raw rather than burning time compressing them for
+  // nothing. The entropy estimate is only a pre-filter - tiny pages skip it since the histogram
+  // is too sparse to mean much and the time saved is negligible.
+  if(in.size >= 4096 && EstimateEntropy((const byte *)in.src, in.size) > entropySkipThreshold)
+  {
+    // confirm with a trial compression at the fastest level - periodic data like index buffers
+    // or byte ramps has a flat histogram but compresses fine, and must not be stored raw.
+    ZSTD_inBuffer trialIn = in;
+    ZSTD_outBuffer trialOut = out;
+
+    if(!CompressFrame(stream, trialIn, trialOut, zstdMinLevel))
+      return false;
+
+    // if even the trial shrank the page the estimator was wrong, keep the trial output
+    if(trialOut.pos - out.pos < in.size - in.pos)
+    {
+      in = trialIn;
+      out = trialOut;
+      return true;
+    }
+
+    return StoreRawZSTDFrame(in, out);
+  }
+
+  return CompressFrame(stream, in, out, level);
+}
+
+ZSTDDecompressor::ZSTDDecompressor(StreamReader *read, Ownership own, bool multithreaded)
+    : Decompressor(read, own)
 {
   m_Page = AllocAlignedBuffer(zstdBlockSize);
   m_CompressBuffer = AllocAlignedBuffer(compressBlockSize);
@@ -203,20 +524,110 @@ ZSTDDecompressor::ZSTDDecompressor(StreamReader *read, Ownership own) : Decompre
   m_PageLength = 0;
 
   m_Stream = ZSTD_createDStream();
+
+  // same heuristic as ZSTDCompressor - below two spare cores stay single-threaded
+  uint32_t threadCount = RDCMIN(8U, Threading::GetCPUCoreCount() - 1);
+
+  if(multithreaded && threadCount >= 2)
+  {
+    m_Blocks.resize(threadCount * 2);
+
+    for(Block &block : m_Blocks)
+    {
+      block.in = AllocAlignedBuffer(compressBlockSize);
+      block.out = AllocAlignedBuffer(zstdBlockSize);
+      block.inSize = 0;
+      block.outSize = 0;
+      block.state = BlockFree;
+    }
+
+    m_WorkerStreams.resize(threadCount);
+    m_Threads.resize(threadCount);
+
+    for(size_t i = 0; i < threadCount; i++)
+    {
+      m_WorkerStreams[i] = ZSTD_createDStream();
+      m_Threads[i] = Threading::CreateThread([this, i]() { WorkerEntry(i); });
+    }
+  }
 }
 
 ZSTDDecompressor::~ZSTDDecompressor()
 {
+  Atomic::Inc32(&m_Kill);
+
+  for(Threading::ThreadHandle thread : m_Threads)
+  {
+    Threading::JoinThread(thread);
+    Threading::CloseThread(thread);
+  }
+
+  for(ZSTD_DStream *stream : m_WorkerStreams)
+    ZSTD_freeDStream(stream);
+
+  for(Block &block : m_Blocks)
+  {
+    FreeAlignedBuffer(block.in);
+    FreeAlignedBuffer(block.out);
+  }
+
   ZSTD_freeDStream(m_Stream);
   FreeAlignedBuffer(m_Page);
   FreeAlignedBuffer(m_CompressBuffer);
 }
 
+void ZSTDDecompressor::WorkerEntry(size_t threadIdx)
+{
+  ZSTD_DStream *stream = m_WorkerStreams[threadIdx];
+
+  while(m_Kill == 0)
+  {
+    bool found = false;
+
+    for(Block &block : m_Blocks)
+    {
+      if(Atomic::CmpExch32(&block.state, BlockPending, BlockBusy) != BlockPending)
+        continue;
+
+      found = true;
+
+      ZSTD_inBuffer in = {block.in, (size_t)block.inSize, 0};
+      ZSTD_outBuffer out = {block.out, (size_t)zstdBlockSize, 0};
+
+      if(DecompressZSTDFrame(stream, in, out))
+      {
+        block.outSize = out.pos;
+        Atomic::CmpExch32(&block.state, BlockBusy, BlockDone);
+      }
+      else
+      {
+        SetError();
+        Atomic::CmpExch32(&block.state, BlockBusy, BlockErrored);
+      }
+    }
+
+    if(!found)
+      Threading::Sleep(0);
+  }
+}
+
+void ZSTDDecompressor::SetError()
+{
+  Atomic::CmpExch32(&m_Error, 0, 1);
+}
+
+bool ZSTDDecompressor::AtEnd()
+{
+  return m_Read->AtEnd() && m_Tail == m_Head;
+}
+
 bool ZSTDDecompressor::Recompress(Compressor *comp)
 {
   bool success = true;
 
-  while(success && !m_Read->AtEnd())
+  // can't use m_Read->AtEnd() directly - with worker threads, frames are read ahead of where
+  // they've been consumed, so the underlying stream hits its end while blocks are still in flight
+  while(success && !AtEnd())
   {
     success &= FillPage();
     if(success)
@@ -288,6 +699,10 @@ bool ZSTDDecompressor::Read(void *data, uint64_t numBytes)
 
 bool ZSTDDecompressor::FillPage()
 {
+  // with a worker pool, read frames ahead and consume decompressed blocks in order
+  if(!m_Blocks.empty())
+    return FillPageThreaded();
+
   uint32_t compSize = 0;
 
   bool success = true;
@@ -303,27 +718,101 @@ bool ZSTDDecompressor::FillPage()
     return false;
   }
 
-  size_t err = ZSTD_initDStream(m_Stream);
+  ZSTD_inBuffer in = {m_CompressBuffer, compSize, 0};
+  ZSTD_outBuffer out = {m_Page, zstdBlockSize, 0};
+
+  if(!DecompressZSTDFrame(m_Stream, in, out))
+  {
+    FreeAlignedBuffer(m_Page);
+    FreeAlignedBuffer(m_CompressBuffer);
+    m_Page = m_CompressBuffer = NULL;
+    return false;
+  }
+
+  m_PageOffset = 0;
+  m_PageLength = out.pos;
 
-  if(ZSTD_isError(err))
+  return success;
+}
+
+bool ZSTDDecompressor::FillPageThreaded()
+{
+  // top up the ring with compressed frames - the sequential read from the underlying stream is
+  // cheap compared to the decompression it feeds.
+  while(m_Head - m_Tail < (uint64_t)m_Blocks.size() && !m_Read->AtEnd() && m_Error == 0)
+  {
+    Block &block = m_Blocks[m_Head % m_Blocks.size()];
+
+    uint32_t compSize = 0;
+
+    bool success = true;
+
+    success &= m_Read->Read(compSize);
+    success &= m_Read->Read(block.in, compSize);
+
+    if(!success)
+    {
+      SetError();
+      break;
+    }
+
+    block.inSize = compSize;
+
+    Atomic::CmpExch32(&block.state, BlockFree, BlockPending);
+    m_Head++;
+  }
+
+  // nothing to consume means we read past the end of the stream, or a read failed above
+  if(m_Tail == m_Head || m_Error != 0)
   {
-    RDCERR("Error decompressing: %s", ZSTD_getErrorName(err));
     FreeAlignedBuffer(m_Page);
     FreeAlignedBuffer(m_CompressBuffer);
     m_Page = m_CompressBuffer = NULL;
     return false;
   }
 
-  ZSTD_inBuffer in = {m_CompressBuffer, compSize, 0};
-  ZSTD_outBuffer out = {m_Page, zstdBlockSize, 0};
+  Block &block = m_Blocks[m_Tail % m_Blocks.size()];
 
-  // keep calling compressStream until everything is consumed
+  // spin until a worker has finished with the next block in stream order
+  while(block.state != BlockDone && block.state != BlockErrored)
+    Threading::Sleep(0);
+
+  if(block.state == BlockErrored || m_Error != 0)
+  {
+    FreeAlignedBuffer(m_Page);
+    FreeAlignedBuffer(m_CompressBuffer);
+    m_Page = m_CompressBuffer = NULL;
+    return false;
+  }
+
+  std::swap(m_Page, block.out);
+  m_PageOffset = 0;
+  m_PageLength = block.outSize;
+
+  Atomic::CmpExch32(&block.state, BlockDone, BlockFree);
+  m_Tail++;
+
+  return true;
+}
+
+bool ZSTDDecompressor::DecompressZSTDFrame(ZSTD_DStream *stream, ZSTD_inBuffer &in,
+                                           ZSTD_outBuffer &out)
+{
+  size_t err = ZSTD_initDStream(stream);
+
+  if(ZSTD_isError(err))
+  {
+    RDCERR("Error decompressing: %s", ZSTD_getErrorName(err));
+    return false;
+  }
+
+  // keep calling decompressStream until everything is consumed
   while(in.pos < in.size)
   {
     size_t inpos = in.pos;
     size_t outpos = out.pos;
 
-    err = ZSTD_decompressStream(m_Stream, &out, &in);
+    err = ZSTD_decompressStream(stream, &out, &in);
 
     if(ZSTD_isError(err) || (inpos == in.pos && outpos == out.pos))
     {
@@ -331,15 +820,9 @@ bool ZSTDDecompressor::FillPage()
         RDCERR("Error decompressing: %s", ZSTD_getErrorName(err));
       else
         RDCERR("Error decompressing, no progress made");
-      FreeAlignedBuffer(m_Page);
-      FreeAlignedBuffer(m_CompressBuffer);
-      m_Page = m_CompressBuffer = NULL;
       return false;
     }
   }
 
-  m_PageOffset = 0;
-  m_PageLength = out.pos;
-
-  return success;
+  return true;
 }
@@ -30,35 +30,106 @@
 class ZSTDCompressor : public Compressor
 {
 public:
-  ZSTDCompressor(StreamWriter *write, Ownership own);
+  // multithreaded compression hands 128KB frames to a pool of workers. Pass false for
+  // short-lived streams where spinning up the pool costs more than it saves.
+  ZSTDCompressor(StreamWriter *write, Ownership own, bool multithreaded = true);
   ~ZSTDCompressor();
 
   bool Write(const void *data, uint64_t numBytes);
   bool Finish();
 
 private:
+  // each block in the stream is an independent zstd frame, so full blocks can be handed to a pool
+  // of worker threads and compressed out of order, as long as the resulting frames are written to
+  // the underlying stream in submission order.
+  struct Block
+  {
+    byte *in;
+    byte *out;
+    uint64_t inSize;
+    uint64_t outSize;
+    // one of BlockFree/BlockPending/BlockBusy/BlockDone/BlockErrored, transitioned with
+    // Atomic::CmpExch32
+    volatile int32_t state;
+  };
+
   bool FlushPage();
+  bool SubmitPage();
+  bool DrainBlock(bool adapt);
+
+  bool CompressZSTDFrame(ZSTD_CStream *stream, ZSTD_inBuffer &in, ZSTD_outBuffer &out, int level);
+
+  void WorkerEntry(size_t threadIdx);
 
-  bool CompressZSTDFrame(ZSTD_inBuffer &in, ZSTD_outBuffer &out);
+  void SetError();
+
+  void AdaptLevel(bool stalled);
 
   byte *m_Page;
   byte *m_CompressBuffer;
   uint64_t m_PageOffset;
 
   ZSTD_CStream *m_Stream;
+
+  // worker pool state, unused (empty/NULL) if we fell back to single-threaded compression
+  rdcarray<Block> m_Blocks;
+  rdcarray<Threading::ThreadHandle> m_Threads;
+  rdcarray<ZSTD_CStream *> m_WorkerStreams;
+
+  // next block sequence number to submit, and next to write out. Only touched by the calling
+  // thread - workers only look at Block::state. The block ring slot is the sequence % ring size.
+  uint64_t m_Head = 0;
+  uint64_t m_Tail = 0;
+
+  volatile int32_t m_Kill = 0;
+  volatile int32_t m_Error = 0;
+
+  // current compression level, adapted to the machine while writing. Every frame records its own
+  // parameters so the level can change freely mid-stream without affecting the reader. Read by
+  // the workers, only written by the calling thread in AdaptLevel.
+  volatile int32_t m_Level;
+
+  // consecutive blocks retired without waiting on a worker, used to ratchet the level back up
+  uint32_t m_SmoothBlocks = 0;
 };
 
 class ZSTDDecompressor : public Decompressor
 {
 public:
-  ZSTDDecompressor(StreamReader *read, Ownership own);
+  // multithreaded decompression reads compressed frames ahead of the consumer. Pass false when
+  // the underlying stream continues past the compressed data (e.g. a network stream carrying
+  // further traffic), since the single-threaded path only ever reads one frame at a time and so
+  // never consumes bytes beyond what the caller asks to decompress.
+  ZSTDDecompressor(StreamReader *read, Ownership own, bool multithreaded = true);
   ~ZSTDDecompressor();
 
   bool Recompress(Compressor *comp);
   bool Read(void *data, uint64_t numBytes);
 
 private:
+  // mirror of ZSTDCompressor::Block - every block in the stream is an independent frame, so the
+  // calling thread can read compressed frames ahead sequentially and decompress them out of order
+  // on a pool of workers, consuming the results in stream order.
+  struct Block
+  {
+    byte *in;
+    byte *out;
+    uint64_t inSize;
+    uint64_t outSize;
+    volatile int32_t state;
+  };
+
   bool FillPage();
+  bool FillPageThreaded();
+
+  // true once the underlying stream is exhausted and all in-flight blocks have been consumed
+  bool AtEnd();
+
+  bool DecompressZSTDFrame(ZSTD_DStream *stream, ZSTD_inBuffer &in, ZSTD_outBuffer &out);
+
+  void WorkerEntry(size_t threadIdx);
+
+  void SetError();
 
   byte *m_Page;
   byte *m_CompressBuffer;
@@ -66,4 +137,17 @@ private:
   uint64_t m_PageLength;
 
   ZSTD_DStream *m_Stream;
+
+  // worker pool state, unused (empty/NULL) if we fell back to single-threaded decompression
+  rdcarray<Block> m_Blocks;
+  rdcarray<Threading::ThreadHandle> m_Threads;
+  rdcarray<ZSTD_DStream *> m_WorkerStreams;
+
+  // next block sequence number to submit, and next to consume. Only touched by the calling
+  // thread - workers only look at Block::state. The block ring slot is the sequence % ring size.
+  uint64_t m_Head = 0;
+  uint64_t m_Tail = 0;
+
+  volatile int32_t m_Kill = 0;
+  volatile int32_t m_Error = 0;
 };
@@ -26,7 +26,14 @@
 #include "renderdoccmd.h"
 #include <app/renderdoc_app.h>
 #include <replay/version.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <mutex>
 #include <string>
+#include <thread>
 
 rdcstr conv(const std::string &s)
 {
@@ -295,6 +302,164 @@ public:
   }
 };
 
+struct BatchThumbCommand : public Command
+{
+private:
+  std::string indir;
+  std::string outdir;
+  std::string format;
+  uint32_t maxsize = 0;
+  uint32_t jobs = 0;
+
+public:
+  BatchThumbCommand() : Command() {}
+  virtual void AddOptions(cmdline::parser &parser)
+  {
+    parser.set_footer("<capture directory>");
+    parser.add<std::string>(
+        "out", 'o', "The directory to write thumbnails to. Defaults to the capture directory.",
+        false, "");
+    parser.add<std::string>("format", 'f', "The format of the output files.", false, "jpg",
+                            cmdline::oneof<std::string>("jpg", "png", "bmp", "tga"));
+    parser.add<uint32_t>(
+        "max-size", 's',
+        "The maximum dimension of the thumbnail. Default is 0, which is unlimited.", false, 0);
+    parser.add<uint32_t>("jobs", 'j',
+                         "The number of captures to process in parallel. Default is 0, which uses "
+                         "one per hardware thread.",
+                         false, 0);
+  }
+  virtual const char *Description()
+  {
+    return "Saves the embedded thumbnail of every capture in a directory to disk.";
+  }
+  virtual bool IsInternalOnly() { return false; }
+  virtual bool IsCaptureCommand() { return false; }
+  virtual bool Parse(cmdline::parser &parser, GlobalEnvironment &)
+  {
+    std::vector<std::string> rest = parser.rest();
+    if(rest.empty())
+    {
+      std::cerr << "Error: thumbs command requires a directory." << std::endl
+                << std::endl
+                << parser.usage();
+      return false;
+    }
+
+    indir = rest[0];
+
+    rest.erase(rest.begin());
+
+    parser.set_rest(rest);
+
+    outdir = parser.get<std::string>("out");
+    if(outdir.empty())
+      outdir = indir;
+    format = parser.get<std::string>("format");
+    maxsize = parser.get<uint32_t>("max-size");
+    jobs = parser.get<uint32_t>("jobs");
+
+    return true;
+  }
+
+  virtual int Execute(const CaptureOptions &)
+  {
+    FileType type = FileType::JPG;
+
+    if(format == "png")
+      type = FileType::PNG;
+    else if(format == "tga")
+      type = FileType::TGA;
+    else if(format == "bmp")
+      type = FileType::BMP;
+
+    std::vector<std::string> captures;
+
+    for(const std::string &file : ListDirFiles(indir))
+    {
+      if(file.size() > 4 && file.compare(file.size() - 4, 4, ".rdc") == 0)
+        captures.push_back(file);
+    }
+
+    if(captures.empty())
+    {
+      std::cerr << "No .rdc captures found in '" << indir << "'" << std::endl;
+      return 1;
+    }
+
+    uint32_t numThreads = jobs;
+    if(numThreads == 0)
+      numThreads = std::max(1u, std::thread::hardware_concurrency());
+    numThreads = std::min(numThreads, (uint32_t)captures.size());
+
+    // opening a capture here only parses the container and the thumbnail section - no replay is
+    // initialised and the frame capture section is never read - so each capture is cheap and
+    // independent, and a directory can be processed on as many threads as the machine has.
+    std::atomic<size_t> nextCapture(0);
+    std::atomic<uint32_t> failed(0);
+    std::mutex outputLock;
+
+    auto worker = [&]() {
+      for(;;)
+      {
+        size_t i = nextCapture.fetch_add(1);
+        if(i >= captures.size())
+          return;
+
+        const std::string &capture = captures[i];
+        std::string infile = indir + "/" + capture;
+        std::string outfile = outdir + "/" + capture.substr(0, capture.size() - 4) + "." + format;
+
+        bytebuf buf;
+
+        ICaptureFile *file = RENDERDOC_OpenCaptureFile();
+        ReplayStatus st = file->OpenFile(infile.c_str(), "rdc", NULL);
+        if(st == ReplayStatus::Succeeded)
+          buf = file->GetThumbnail(type, maxsize).data;
+        file->Shutdown();
+
+        if(st != ReplayStatus::Succeeded || buf.empty())
+        {
+          std::lock_guard<std::mutex> lock(outputLock);
+          if(st != ReplayStatus::Succeeded)
+            std::cerr << "Couldn't open '" << infile << "': " << ToStr(st) << std::endl;
+          else
+            std::cerr << "Couldn't fetch the thumbnail in '" << infile << "'" << std::endl;
+          failed++;
+          continue;
+        }
+
+        FILE *f = fopen(outfile.c_str(), "wb");
+
+        if(!f)
+        {
+          std::lock_guard<std::mutex> lock(outputLock);
+          std::cerr << "Couldn't open destination file '" << outfile << "'" << std::endl;
+          failed++;
+          continue;
+        }
+
+        fwrite(buf.data(), 1, buf.size(), f);
+        fclose(f);
+      }
+    };
+
+    std::vector<std::thread> threads;
+    for(uint32_t t = 0; t < numThreads; t++)
+      threads.push_back(std::thread(worker));
+
+    for(std::thread &t : threads)
+      t.join();
+
+    std::cout << "Wrote " << (captures.size() - failed) << " thumbnails to '" << outdir << "'";
+    if(failed > 0)
+      std::cout << ", " << failed << " failed";
+    std::cout << "." << std::endl;
+
+    return failed == 0 ? 0 : 1;
+  }
+};
+
 struct CaptureCommand : public Command
 {
 private:
@@ -524,6 +689,121 @@ private:
   uint32_t width = 0;
   uint32_t height = 0;
   uint32_t loops = 0;
+  bool benchmark = false;
+  uint32_t benchmark_events = 0;
+
+  void GatherEvents(const rdcarray<DrawcallDescription> &draws, std::vector<uint32_t> &eventIds,
+                    uint64_t &drawCount, uint64_t &dispatchCount)
+  {
+    for(const DrawcallDescription &d : draws)
+    {
+      if(!d.children.empty())
+      {
+        GatherEvents(d.children, eventIds, drawCount, dispatchCount);
+        continue;
+      }
+
+      if(d.flags & DrawFlags::Drawcall)
+        drawCount++;
+      if(d.flags & DrawFlags::Dispatch)
+        dispatchCount++;
+
+      eventIds.push_back(d.eventId);
+    }
+  }
+
+  int BenchmarkReplay(IReplayController *renderer, double loadTimeMs)
+  {
+    typedef std::chrono::high_resolution_clock Clock;
+    typedef std::chrono::duration<double, std::milli> DurationMS;
+
+    std::vector<uint32_t> eventIds;
+    uint64_t draws = 0, dispatches = 0;
+    GatherEvents(renderer->GetDrawcalls(), eventIds, draws, dispatches);
+
+    const uint64_t totalEvents = eventIds.size();
+
+    // if the user capped the number of events, sample them evenly across the frame so we still
+    // cover early and late events rather than just the start.
+    if(benchmark_events > 0 && eventIds.size() > benchmark_events)
+    {
+      std::vector<uint32_t> sampled;
+      sampled.reserve(benchmark_events);
+      for(uint32_t i = 0; i < benchmark_events; i++)
+        sampled.push_back(eventIds[(size_t)(((uint64_t)i * eventIds.size()) / benchmark_events)]);
+      eventIds.swap(sampled);
+    }
+
+    uint64_t memAfterLoad = RENDERDOC_GetCurrentProcessMemoryUsage();
+    uint64_t peakMem = memAfterLoad;
+
+    std::vector<double> latencies;
+    latencies.reserve(eventIds.size());
+
+    for(uint32_t eid : eventIds)
+    {
+      auto start = Clock::now();
+
+      renderer->SetFrameEvent(eid, true);
+
+      latencies.push_back(DurationMS(Clock::now() - start).count());
+
+      peakMem = std::max(peakMem, RENDERDOC_GetCurrentProcessMemoryUsage());
+    }
+
+    std::sort(latencies.begin(), latencies.end());
+
+    double mean = 0.0;
+    for(double ms : latencies)
+      mean += ms;
+    if(!latencies.empty())
+      mean /= double(latencies.size());
+
+    // nearest-rank percentile over the sorted latencies
+    auto percentile = [&latencies](double p) -> double {
+      if(latencies.empty())
+        return 0.0;
+      size_t idx = (size_t)(p * double(latencies.size() - 1) + 0.5);
+      return latencies[std::min(idx, latencies.size() - 1)];
+    };
+
+    FrameDescription frameInfo = renderer->GetFrameInfo();
+
+    std::ostringstream json;
+    json << std::fixed << std::setprecision(3);
+    json << "{" << std::endl;
+    json << "  \"capture\": \"" << filename << "\"," << std::endl;
+    json << "  \"loadTimeMs\": " << loadTimeMs << "," << std::endl;
+    json << "  \"events\": {" << std::endl;
+    json << "    \"total\": " << totalEvents << "," << std::endl;
+    json << "    \"replayed\": " << eventIds.size() << "," << std::endl;
+    json << "    \"draws\": " << draws << "," << std::endl;
+    json << "    \"dispatches\": " << dispatches << std::endl;
+    json << "  }," << std::endl;
+    json << "  \"setFrameEventMs\": {" << std::endl;
+    json << "    \"min\": " << (latencies.empty() ? 0.0 : latencies.front()) << "," << std::endl;
+    json << "    \"mean\": " << mean << "," << std::endl;
+    json << "    \"p50\": " << percentile(0.5) << "," << std::endl;
+    json << "    \"p90\": " << percentile(0.9) << "," << std::endl;
+    json << "    \"p99\": " << percentile(0.99) << "," << std::endl;
+    json << "    \"max\": " << (latencies.empty() ? 0.0 : latencies.back()) << std::endl;
+    json << "  }," << std::endl;
+    json << "  \"memoryBytes\": {" << std::endl;
+    json << "    \"afterLoad\": " << memAfterLoad << "," << std::endl;
+    json << "    \"peak\": " << peakMem << std::endl;
+    json << "  }," << std::endl;
+    json << "  \"captureBytes\": {" << std::endl;
+    json << "    \"compressed\": " << frameInfo.compressedFileSize << "," << std::endl;
+    json << "    \"uncompressed\": " << frameInfo.uncompressedFileSize << "," << std::endl;
+    json << "    \"persistent\": " << frameInfo.persistentSize << "," << std::endl;
+    json << "    \"initData\": " << frameInfo.initDataSize << std::endl;
+    json << "  }" << std::endl;
+    json << "}" << std::endl;
+
+    std::cout << json.str();
+
+    return 0;
+  }
 
 public:
   ReplayCommand() : Command() {}
@@ -537,6 +817,13 @@ public:
     parser.add<std::string>("remote-host", 0,
                             "Instead of replaying locally, replay on this host over the network.",
                             false);
+    parser.add("benchmark", 0,
+               "Instead of showing a preview window, replay a set of events and print "
+               "performance statistics as JSON on stdout.");
+    parser.add<uint32_t>("benchmark-events", 0,
+                         "The maximum number of events to replay in benchmark mode, sampled "
+                         "evenly across the frame, or 0 for all events.",
+                         false, 0);
   }
   virtual const char *Description()
   {
@@ -567,6 +854,16 @@ public:
     width = parser.get<uint32_t>("width");
     height = parser.get<uint32_t>("height");
     loops = parser.get<uint32_t>("loops");
+    benchmark = parser.exist("benchmark");
+    benchmark_events = parser.get<uint32_t>("benchmark-events");
+
+    if(benchmark && !remote_host.empty())
+    {
+      std::cerr << "Error: benchmark mode only supports local replay." << std::endl
+                << std::endl
+                << parser.usage();
+      return false;
+    }
 
     return true;
   }
@@ -610,7 +907,10 @@ public:
     }
     else
     {
-      std::cout << "Replaying '" << filename << "' locally.." << std::endl;
+      if(!benchmark)
+        std::cout << "Replaying '" << filename << "' locally.." << std::endl;
+
+      auto loadStart = std::chrono::high_resolution_clock::now();
 
       ICaptureFile *file = RENDERDOC_OpenCaptureFile();
 
@@ -626,8 +926,21 @@ public:
 
       file->Shutdown();
 
+      double loadTimeMs = std::chrono::duration<double, std::milli>(
+                              std::chrono::high_resolution_clock::now() - loadStart)
+                              .count();
+
       if(status == ReplayStatus::Succeeded)
       {
+        if(benchmark)
+        {
+          int ret = BenchmarkReplay(renderer, loadTimeMs);
+
+          renderer->Shutdown();
+
+          return ret;
+        }
+
         DisplayRendererPreview(renderer, width, height, loops);
 
         renderer->Shutdown();
@@ -642,6 +955,364 @@ public:
   }
 };
 
+struct AnalyseCommand : public Command
+{
+private:
+  std::string filename;
+  std::string outputDir;
+  std::string statsFile;
+
+  static std::string JSONEscape(const std::string &str)
+  {
+    std::string ret;
+    ret.reserve(str.size());
+    for(char c : str)
+    {
+      if(c == '"' || c == '\\')
+      {
+        ret.push_back('\\');
+        ret.push_back(c);
+      }
+      else if(c == '\n')
+      {
+        ret += "\\n";
+      }
+      else if((unsigned char)c >= 0x20)
+      {
+        ret.push_back(c);
+      }
+    }
+    return ret;
+  }
+
+  void AnalyseDraws(IReplayController *renderer, const rdcarray<DrawcallDescription> &draws,
+                    std::ostream &stats, bool &first)
+  {
+    for(const DrawcallDescription &d : draws)
+    {
+      if(!d.children.empty())
+      {
+        AnalyseDraws(renderer, d.children, stats, first);
+        continue;
+      }
+
+      auto start = std::chrono::high_resolution_clock::now();
+
+      // stepping forward action by action means each event in the frame is replayed exactly
+      // once - the replay core only replays the delta since the previous event, so the whole
+      // walk is a single forward pass rather than a whole-frame replay per step.
+      renderer->SetFrameEvent(d.eventId, false);
+
+      double ms =
+          std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start)
+              .count();
+
+      std::string saved;
+
+      if(!outputDir.empty() && d.outputs[0] != ResourceId())
+      {
+        TextureSave save;
+        save.resourceId = d.outputs[0];
+        save.destType = FileType::PNG;
+        save.mip = 0;
+        save.slice.sliceIndex = 0;
+
+        std::ostringstream path;
+        path << outputDir << "/" << d.eventId << ".png";
+
+        if(renderer->SaveTexture(save, path.str().c_str()))
+          saved = path.str();
+      }
+
+      if(!first)
+        stats << "," << std::endl;
+      first = false;
+
+      stats << "    {\"eventId\": " << d.eventId << ", \"name\": \"" << JSONEscape(conv(d.name))
+            << "\", \"replayMs\": " << ms;
+      if(!saved.empty())
+        stats << ", \"output\": \"" << JSONEscape(saved) << "\"";
+      stats << "}";
+    }
+  }
+
+public:
+  AnalyseCommand() : Command() {}
+  virtual void AddOptions(cmdline::parser &parser)
+  {
+    parser.set_footer("<capture.rdc>");
+    parser.add<std::string>("save-outputs", 'o',
+                            "Save the first colour output of each draw as <eventId>.png into "
+                            "this directory.",
+                            false, "");
+    parser.add<std::string>(
+        "stats", 's', "Write the JSON statistics to this file instead of stdout.", false, "");
+  }
+  virtual const char *Description()
+  {
+    return "Replays every event in a capture in a single forward pass, recording statistics and "
+           "optionally saving outputs.";
+  }
+  virtual bool IsInternalOnly() { return false; }
+  virtual bool IsCaptureCommand() { return false; }
+  virtual bool Parse(cmdline::parser &parser, GlobalEnvironment &)
+  {
+    std::vector<std::string> rest = parser.rest();
+    if(rest.empty())
+    {
+      std::cerr << "Error: analyse command requires a filename to load." << std::endl
+                << std::endl
+                << parser.usage();
+      return false;
+    }
+
+    filename = rest[0];
+
+    rest.erase(rest.begin());
+
+    parser.set_rest(rest);
+
+    outputDir = parser.get<std::string>("save-outputs");
+    statsFile = parser.get<std::string>("stats");
+
+    return true;
+  }
+  virtual int Execute(const CaptureOptions &)
+  {
+    ICaptureFile *file = RENDERDOC_OpenCaptureFile();
+
+    if(file->OpenFile(filename.c_str(), "rdc", NULL) != ReplayStatus::Succeeded)
+    {
+      std::cerr << "Couldn't load '" << filename << "'." << std::endl;
+      return 1;
+    }
+
+    IReplayController *renderer = NULL;
+    ReplayStatus status = ReplayStatus::InternalError;
+    rdctie(status, renderer) = file->OpenCapture(ReplayOptions(), NULL);
+
+    file->Shutdown();
+
+    if(status != ReplayStatus::Succeeded)
+    {
+      std::cerr << "Couldn't load and replay '" << filename << "': " << ToStr(status) << std::endl;
+      return 1;
+    }
+
+    std::ofstream outfile;
+    if(!statsFile.empty())
+    {
+      outfile.open(statsFile.c_str(), std::ios::out | std::ios::trunc);
+
+      if(!outfile.is_open())
+      {
+        std::cerr << "Couldn't open '" << statsFile << "' for write." << std::endl;
+        renderer->Shutdown();
+        return 1;
+      }
+    }
+
+    std::ostream &stats = statsFile.empty() ? std::cout : outfile;
+
+    stats << std::fixed << std::setprecision(3);
+    stats << "{" << std::endl;
+    stats << "  \"capture\": \"" << JSONEscape(filename) << "\"," << std::endl;
+    stats << "  \"events\": [" << std::endl;
+
+    bool first = true;
+    AnalyseDraws(renderer, renderer->GetDrawcalls(), stats, first);
+
+    stats << std::endl;
+    stats << "  ]" << std::endl;
+    stats << "}" << std::endl;
+
+    renderer->Shutdown();
+
+    return 0;
+  }
+};
+
+struct CaptureDiffCommand : public Command
+{
+private:
+  std::string filenameA;
+  std::string filenameB;
+  uint32_t threshold = 0;
+
+  // compares in large blocks so the exact-match fast path is a plain memcmp, which the C library
+  // vectorises. Only blocks that actually differ pay for the per-byte tolerance pass.
+  uint64_t CountDiffs(const bytebuf &a, const bytebuf &b)
+  {
+    const size_t blockSize = 4096;
+
+    uint64_t diffs = 0;
+
+    for(size_t offs = 0; offs < a.size(); offs += blockSize)
+    {
+      size_t len = std::min(blockSize, a.size() - offs);
+
+      if(memcmp(a.data() + offs, b.data() + offs, len) == 0)
+        continue;
+
+      for(size_t i = offs; i < offs + len; i++)
+      {
+        uint32_t delta = a[i] > b[i] ? uint32_t(a[i] - b[i]) : uint32_t(b[i] - a[i]);
+
+        if(delta > threshold)
+          diffs++;
+      }
+    }
+
+    return diffs;
+  }
+
+  IReplayController *Open(const std::string &filename)
+  {
+    ICaptureFile *file = RENDERDOC_OpenCaptureFile();
+
+    if(file->OpenFile(filename.c_str(), "rdc", NULL) != ReplayStatus::Succeeded)
+    {
+      std::cerr << "Couldn't load '" << filename << "'." << std::endl;
+      file->Shutdown();
+      return NULL;
+    }
+
+    IReplayController *renderer = NULL;
+    ReplayStatus status = ReplayStatus::InternalError;
+    rdctie(status, renderer) = file->OpenCapture(ReplayOptions(), NULL);
+
+    file->Shutdown();
+
+    if(status != ReplayStatus::Succeeded)
+    {
+      std::cerr << "Couldn't load and replay '" << filename << "': " << ToStr(status) << std::endl;
+      return NULL;
+    }
+
+    return renderer;
+  }
+
+  void GatherDraws(const rdcarray<DrawcallDescription> &draws,
+                   std::vector<const DrawcallDescription *> &flat)
+  {
+    for(const DrawcallDescription &d : draws)
+    {
+      if(!d.children.empty())
+      {
+        GatherDraws(d.children, flat);
+        continue;
+      }
+
+      flat.push_back(&d);
+    }
+  }
+
+public:
+  CaptureDiffCommand() : Command() {}
+  virtual void AddOptions(cmdline::parser &parser)
+  {
+    parser.set_footer("<before.rdc> <after.rdc>");
+    parser.add<uint32_t>("threshold", 't',
+                         "Per-byte tolerance - differences of this magnitude or less are "
+                         "ignored. Default is 0, an exact comparison.",
+                         false, 0);
+  }
+  virtual const char *Description()
+  {
+    return "Replays two captures and compares each draw's first colour output, reporting "
+           "differing events. Exits 0 if they match, 1 if they differ, 2 on error.";
+  }
+  virtual bool IsInternalOnly() { return false; }
+  virtual bool IsCaptureCommand() { return false; }
+  virtual bool Parse(cmdline::parser &parser, GlobalEnvironment &)
+  {
+    std::vector<std::string> rest = parser.rest();
+    if(rest.size() < 2)
+    {
+      std::cerr << "Error: capture-diff command requires two capture filenames." << std::endl
+                << std::endl
+                << parser.usage();
+      return false;
+    }
+
+    filenameA = rest[0];
+    filenameB = rest[1];
+
+    rest.erase(rest.begin(), rest.begin() + 2);
+
+    parser.set_rest(rest);
+
+    threshold = parser.get<uint32_t>("threshold");
+
+    return true;
+  }
+  virtual int Execute(const CaptureOptions &)
+  {
+    IReplayController *rendererA = Open(filenameA);
+    if(!rendererA)
+      return 2;
+
+    IReplayController *rendererB = Open(filenameB);
+    if(!rendererB)
+    {
+      rendererA->Shutdown();
+      return 2;
+    }
+
+    std::vector<const DrawcallDescription *> drawsA, drawsB;
+    GatherDraws(rendererA->GetDrawcalls(), drawsA);
+    GatherDraws(rendererB->GetDrawcalls(), drawsB);
+
+    if(drawsA.size() != drawsB.size())
+      std::cerr << "Captures have different event counts (" << drawsA.size() << " vs "
+                << drawsB.size() << "), comparing the events they have in common." << std::endl;
+
+    const size_t count = std::min(drawsA.size(), drawsB.size());
+
+    uint64_t differingEvents = 0;
+
+    for(size_t i = 0; i < count; i++)
+    {
+      const DrawcallDescription *a = drawsA[i];
+      const DrawcallDescription *b = drawsB[i];
+
+      if(a->outputs[0] == ResourceId() || b->outputs[0] == ResourceId())
+        continue;
+
+      rendererA->SetFrameEvent(a->eventId, false);
+      rendererB->SetFrameEvent(b->eventId, false);
+
+      bytebuf dataA = rendererA->GetTextureData(a->outputs[0], Subresource());
+      bytebuf dataB = rendererB->GetTextureData(b->outputs[0], Subresource());
+
+      if(dataA.size() != dataB.size())
+      {
+        std::cout << "EID " << a->eventId << ": output size differs (" << dataA.size() << " vs "
+                  << dataB.size() << " bytes)" << std::endl;
+        differingEvents++;
+        continue;
+      }
+
+      uint64_t diffs = CountDiffs(dataA, dataB);
+
+      if(diffs > 0)
+      {
+        std::cout << "EID " << a->eventId << ": " << diffs << " of " << dataA.size()
+                  << " bytes differ beyond threshold" << std::endl;
+        differingEvents++;
+      }
+    }
+
+    std::cout << differingEvents << " differing event(s) out of " << count << " compared."
+              << std::endl;
+
+    rendererA->Shutdown();
+    rendererB->Shutdown();
+
+    return differingEvents > 0 ? 1 : 0;
+  }
+};
+
 struct formats_reader
 {
   formats_reader(bool input)
@@ -843,6 +1514,7 @@ public:
 #endif
         " [... parameters to test framework ...]");
     parser.add("help", '\0', "print this message");
+    parser.add("benchmark", '\0', "run the performance benchmarks instead of correctness tests");
     parser.stop_at_rest(true);
   }
   virtual const char *Description() { return "Run internal tests such as unit tests."; }
@@ -879,6 +1551,26 @@ public:
     if(parser.exist("help"))
       rest.push_back("--help");
 
+    // the benchmark cases are hidden behind a tag so that plain unit test runs skip them. Accept
+    // the flag either before or after the framework name.
+    bool benchmark = parser.exist("benchmark");
+
+    for(auto it = rest.begin(); it != rest.end();)
+    {
+      if(*it == "--benchmark")
+      {
+        benchmark = true;
+        it = rest.erase(it);
+      }
+      else
+      {
+        ++it;
+      }
+    }
+
+    if(benchmark && mode == "unit")
+      rest.push_back("[benchmark]");
+
     args = convertArgs(rest);
 
     return true;
@@ -1252,6 +1944,338 @@ public:
   }
 };
 
+struct CompressBenchCommand : public Command
+{
+private:
+  std::string rdc;
+  std::string section;
+  uint32_t rounds = 0;
+  bool detail = false;
+
+  struct CodecResult
+  {
+    uint64_t compressedSize = 0;
+    double compressMs = 0.0;
+    double decompressMs = 0.0;
+  };
+
+  static double ThroughputMBps(uint64_t bytes, double ms)
+  {
+    if(ms <= 0.0)
+      return 0.0;
+    return (double(bytes) / (1024.0 * 1024.0)) / (ms / 1000.0);
+  }
+
+public:
+  CompressBenchCommand() : Command() {}
+  virtual void AddOptions(cmdline::parser &parser)
+  {
+    parser.set_footer("<capture.rdc>");
+    parser.add<std::string>(
+        "section", 's', "Benchmark only the named section, instead of every section.", false);
+    parser.add<uint32_t>(
+        "rounds", 'r', "How many times to repeat each measurement, keeping the best.", false, 3);
+    parser.add("detail", 0, "Print per-section results as well as the totals.");
+  }
+  virtual const char *Description()
+  {
+    return "Benchmark capture compression settings against a capture's own sections.";
+  }
+  virtual bool IsInternalOnly() { return false; }
+  virtual bool IsCaptureCommand() { return false; }
+  virtual bool Parse(cmdline::parser &parser, GlobalEnvironment &)
+  {
+    std::vector<std::string> rest = parser.rest();
+    if(rest.empty())
+    {
+      std::cerr << "Error: this command requires a filename to load." << std::endl
+                << std::endl
+                << parser.usage();
+      return false;
+    }
+
+    rdc = rest[0];
+
+    rest.erase(rest.begin());
+
+    parser.set_rest(rest);
+
+    section = parser.get<std::string>("section");
+    rounds = std::max(1U, parser.get<uint32_t>("rounds"));
+    detail = parser.exist("detail");
+
+    return true;
+  }
+  virtual int Execute(const CaptureOptions &)
+  {
+    typedef std::chrono::high_resolution_clock Clock;
+    typedef std::chrono::duration<double, std::milli> DurationMS;
+
+    ICaptureFile *capfile = RENDERDOC_OpenCaptureFile();
+
+    ReplayStatus status = capfile->OpenFile(rdc.c_str(), "", NULL);
+
+    if(status != ReplayStatus::Succeeded)
+    {
+      capfile->Shutdown();
+      std::cerr << "Couldn't load '" << rdc << "': " << ToStr(status) << std::endl;
+      return 1;
+    }
+
+    // grab the uncompressed contents of every section we're benchmarking, then close the capture -
+    // all the writing happens on a scratch copy so the original file is never modified.
+    std::vector<SectionProperties> sections;
+    std::vector<bytebuf> contents;
+
+    int num = capfile->GetSectionCount();
+
+    for(int i = 0; i < num; i++)
+    {
+      SectionProperties props = capfile->GetSectionProperties(i);
+
+      if(!section.empty() && conv(props.name) != section)
+        continue;
+
+      sections.push_back(props);
+      contents.push_back(capfile->GetSectionContents(i));
+    }
+
+    capfile->Shutdown();
+
+    if(sections.empty())
+    {
+      if(section.empty())
+        std::cerr << "'" << rdc << "' has no sections." << std::endl;
+      else
+        std::cerr << "'" << rdc << "' has no section called '" << section << "'" << std::endl;
+      return 1;
+    }
+
+    std::string scratch = rdc + ".compbench";
+
+    {
+      FILE *in = fopen(rdc.c_str(), "rb");
+      FILE *out = fopen(scratch.c_str(), "wb");
+
+      if(!in || !out)
+      {
+        if(in)
+          fclose(in);
+        if(out)
+          fclose(out);
+        std::cerr << "Couldn't copy '" << rdc << "' to scratch file '" << scratch << "'"
+                  << std::endl;
+        return 1;
+      }
+
+      char buf[65536];
+      size_t read = 0;
+      while((read = fread(buf, 1, sizeof(buf), in)) > 0)
+        fwrite(buf, 1, read, out);
+
+      fclose(in);
+      fclose(out);
+    }
+
+    struct Codec
+    {
+      const char *name;
+      SectionFlags flags;
+    };
+
+    const Codec codecs[] = {
+        {"uncompressed", SectionFlags::NoFlags},
+        {"lz4", SectionFlags::LZ4Compressed},
+        {"zstd", SectionFlags::ZstdCompressed},
+    };
+
+    const size_t numCodecs = sizeof(codecs) / sizeof(codecs[0]);
+
+    uint64_t totalUncompressed = 0;
+    for(const bytebuf &blob : contents)
+      totalUncompressed += blob.size();
+
+    std::cout << "Benchmarking " << sections.size() << " section(s), "
+              << (totalUncompressed >> 20) << " MB uncompressed, best of " << rounds << " round(s)."
+              << std::endl;
+    std::cout << "Timings are through the capture file API and include file I/O." << std::endl
+              << std::endl;
+
+    // per codec, per section
+    std::vector<std::vector<CodecResult>> results(numCodecs);
+
+    int ret = 0;
+
+    for(size_t c = 0; c < numCodecs; c++)
+    {
+      results[c].resize(sections.size());
+
+      // compression pass - rewrite each section into the scratch copy with this codec's flags,
+      // keeping the best time over the requested rounds. Writing a section with the same name
+      // replaces the previous copy.
+      capfile = RENDERDOC_OpenCaptureFile();
+
+      status = capfile->OpenFile(scratch.c_str(), "", NULL);
+
+      if(status != ReplayStatus::Succeeded)
+      {
+        capfile->Shutdown();
+        std::cerr << "Couldn't load scratch file '" << scratch << "': " << ToStr(status)
+                  << std::endl;
+        ret = 1;
+        break;
+      }
+
+      for(size_t i = 0; i < sections.size(); i++)
+      {
+        SectionProperties props = sections[i];
+        props.flags &= ~(SectionFlags::LZ4Compressed | SectionFlags::ZstdCompressed);
+        props.flags |= codecs[c].flags;
+
+        double best = 0.0;
+
+        for(uint32_t r = 0; r < rounds; r++)
+        {
+          auto start = Clock::now();
+
+          capfile->WriteSection(props, contents[i]);
+
+          double ms = DurationMS(Clock::now() - start).count();
+
+          if(r == 0 || ms < best)
+            best = ms;
+        }
+
+        results[c][i].compressMs = best;
+      }
+
+      capfile->Shutdown();
+
+      // decompression pass - reopen the scratch copy so reads come from the file rather than
+      // anything cached from writing, and time fetching each section's contents back.
+      capfile = RENDERDOC_OpenCaptureFile();
+
+      status = capfile->OpenFile(scratch.c_str(), "", NULL);
+
+      if(status != ReplayStatus::Succeeded)
+      {
+        capfile->Shutdown();
+        std::cerr << "Couldn't reopen scratch file '" << scratch << "': " << ToStr(status)
+                  << std::endl;
+        ret = 1;
+        break;
+      }
+
+      for(size_t i = 0; i < sections.size(); i++)
+      {
+        int idx = capfile->FindSectionByName(sections[i].name.c_str());
+
+        if(idx < 0)
+        {
+          std::cerr << "Section '" << conv(sections[i].name) << "' went missing from scratch file"
+                    << std::endl;
+          ret = 1;
+          continue;
+        }
+
+        results[c][i].compressedSize = capfile->GetSectionProperties(idx).compressedSize;
+
+        double best = 0.0;
+
+        for(uint32_t r = 0; r < rounds; r++)
+        {
+          auto start = Clock::now();
+
+          bytebuf blob = capfile->GetSectionContents(idx);
+
+          double ms = DurationMS(Clock::now() - start).count();
+
+          if(blob.size() != contents[i].size())
+          {
+            std::cerr << "Section '" << conv(sections[i].name) << "' didn't round-trip with "
+                      << codecs[c].name << std::endl;
+            ret = 1;
+            break;
+          }
+
+          if(r == 0 || ms < best)
+            best = ms;
+        }
+
+        results[c][i].decompressMs = best;
+      }
+
+      capfile->Shutdown();
+
+      if(ret != 0)
+        break;
+    }
+
+    if(ret == 0)
+    {
+      std::cout << std::fixed << std::setprecision(1);
+
+      uint64_t totalSize[numCodecs] = {};
+      double totalComp[numCodecs] = {}, totalDecomp[numCodecs] = {};
+
+      for(size_t c = 0; c < numCodecs; c++)
+      {
+        for(size_t i = 0; i < sections.size(); i++)
+        {
+          totalSize[c] += results[c][i].compressedSize;
+          totalComp[c] += results[c][i].compressMs;
+          totalDecomp[c] += results[c][i].decompressMs;
+        }
+      }
+
+      for(size_t c = 0; c < numCodecs; c++)
+      {
+        double ratio =
+            totalSize[c] > 0 ? double(totalUncompressed) / double(totalSize[c]) : 0.0;
+
+        std::cout << std::setw(12) << codecs[c].name << ": " << std::setw(8)
+                  << (totalSize[c] >> 20) << " MB  ratio " << std::setw(5) << ratio << "  write "
+                  << std::setw(7) << ThroughputMBps(totalUncompressed, totalComp[c])
+                  << " MB/s  read " << std::setw(7)
+                  << ThroughputMBps(totalUncompressed, totalDecomp[c]) << " MB/s" << std::endl;
+
+        if(detail)
+        {
+          for(size_t i = 0; i < sections.size(); i++)
+          {
+            const CodecResult &r = results[c][i];
+            std::cout << "    " << conv(sections[i].name) << ": " << r.compressedSize
+                      << " bytes  write "
+                      << ThroughputMBps(contents[i].size(), r.compressMs) << " MB/s  read "
+                      << ThroughputMBps(contents[i].size(), r.decompressMs) << " MB/s" << std::endl;
+          }
+        }
+      }
+
+      // recommend the compressed codec with the better ratio, unless reading it back is less than
+      // half the speed of the alternative - load time is what users feel every time they open the
+      // capture, while the size difference is paid once.
+      const size_t lz4Idx = 1, zstdIdx = 2;
+
+      size_t pick = totalSize[zstdIdx] < totalSize[lz4Idx] ? zstdIdx : lz4Idx;
+      size_t other = pick == zstdIdx ? lz4Idx : zstdIdx;
+
+      if(ThroughputMBps(totalUncompressed, totalDecomp[pick]) <
+         0.5 * ThroughputMBps(totalUncompressed, totalDecomp[other]))
+        pick = other;
+
+      std::cout << std::endl
+                << "Recommended: " << codecs[pick].name << " ("
+                << (totalSize[pick] >> 20) << " MB, reads at "
+                << ThroughputMBps(totalUncompressed, totalDecomp[pick]) << " MB/s)" << std::endl;
+    }
+
+    remove(scratch.c_str());
+
+    return ret;
+  }
+};
+
 struct VulkanRegisterCommand : public Command
 {
 private:
@@ -1550,15 +2574,20 @@ int renderdoccmd(GlobalEnvironment &env, std::vector<std::string> &argv)
 
     // add platform agnostic commands
     add_command("thumb", new ThumbCommand());
+    add_command("thumbs", new BatchThumbCommand());
     add_command("capture", new CaptureCommand());
     add_command("inject", new InjectCommand());
     add_command("remoteserver", new RemoteServerCommand());
     add_command("replay", new ReplayCommand());
+    add_command("analyse", new AnalyseCommand());
+    add_alias("analyze", "analyse");
+    add_command("capture-diff", new CaptureDiffCommand());
     add_command("capaltbit", new CapAltBitCommand());
     add_command("test", new TestCommand());
     add_command("convert", new ConvertCommand());
     add_command("embed", new EmbeddedSectionCommand(false));
     add_command("extract", new EmbeddedSectionCommand(true));
+    add_command("compress-bench", new CompressBenchCommand());
 
     if(argv.size() <= 1)
     {
@@ -58,3 +58,6 @@ void DisplayRendererPreview(IReplayController *renderer, TextureDisplay &display
                             uint32_t height, uint32_t numLoops);
 WindowingData DisplayRemoteServerPreview(bool active, const rdcarray<WindowingSystem> &systems);
 void Daemonise();
+// list the files (not subdirectories) directly inside 'path'. Returns filenames without any
+// directory prefix, in no particular order.
+std::vector<std::string> ListDirFiles(const std::string &path);
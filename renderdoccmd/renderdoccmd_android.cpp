@@ -26,6 +26,7 @@
 #include <EGL/egl.h>
 #include <GLES2/gl2.h>
 #include <GLES2/gl2ext.h>
+#include <dirent.h>
 #include <dlfcn.h>
 #include <locale.h>
 #include <string.h>
@@ -74,6 +75,28 @@ void Daemonise()
 {
 }
 
+std::vector<std::string> ListDirFiles(const std::string &path)
+{
+  std::vector<std::string> ret;
+
+  DIR *d = opendir(path.c_str());
+  if(!d)
+    return ret;
+
+  struct dirent *ent = NULL;
+  while((ent = readdir(d)) != NULL)
+  {
+    if(ent->d_type == DT_DIR)
+      continue;
+
+    ret.push_back(ent->d_name);
+  }
+
+  closedir(d);
+
+  return ret;
+}
+
 void DisplayGenericSplash()
 {
   ANDROID_LOG("Trying to splash");
@@ -23,6 +23,7 @@
  ******************************************************************************/
 
 #include "renderdoccmd.h"
+#include <dirent.h>
 #include <signal.h>
 #include <string.h>
 #include <unistd.h>
@@ -48,6 +49,28 @@ void Daemonise()
   daemon(1, 0);
 }
 
+std::vector<std::string> ListDirFiles(const std::string &path)
+{
+  std::vector<std::string> ret;
+
+  DIR *d = opendir(path.c_str());
+  if(!d)
+    return ret;
+
+  struct dirent *ent = NULL;
+  while((ent = readdir(d)) != NULL)
+  {
+    if(ent->d_type == DT_DIR)
+      continue;
+
+    ret.push_back(ent->d_name);
+  }
+
+  closedir(d);
+
+  return ret;
+}
+
 WindowingData DisplayRemoteServerPreview(bool active, const rdcarray<WindowingSystem> &systems)
 {
   static WindowingData remoteServerPreview = {WindowingSystem::Unknown};
@@ -24,6 +24,7 @@
  ******************************************************************************/
 
 #include "renderdoccmd.h"
+#include <dirent.h>
 #include <dlfcn.h>
 #include <iconv.h>
 #include <limits.h>
@@ -48,6 +49,28 @@ void Daemonise()
   daemon(1, 0);
 }
 
+std::vector<std::string> ListDirFiles(const std::string &path)
+{
+  std::vector<std::string> ret;
+
+  DIR *d = opendir(path.c_str());
+  if(!d)
+    return ret;
+
+  struct dirent *ent = NULL;
+  while((ent = readdir(d)) != NULL)
+  {
+    if(ent->d_type == DT_DIR)
+      continue;
+
+    ret.push_back(ent->d_name);
+  }
+
+  closedir(d);
+
+  return ret;
+}
+
 static Display *display = NULL;
 
 WindowingData DisplayRemoteServerPreview(bool active, const rdcarray<WindowingSystem> &systems)
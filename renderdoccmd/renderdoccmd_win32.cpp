@@ -130,6 +130,27 @@ void Daemonise()
   // nothing really to do, windows version of renderdoccmd is already 'detached'
 }
 
+std::vector<std::string> ListDirFiles(const std::string &path)
+{
+  std::vector<std::string> ret;
+
+  WIN32_FIND_DATAW findData = {};
+  HANDLE find = FindFirstFileW(conv(path + "/*").c_str(), &findData);
+
+  if(find == INVALID_HANDLE_VALUE)
+    return ret;
+
+  do
+  {
+    if((findData.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) == 0)
+      ret.push_back(conv(std::wstring(findData.cFileName)));
+  } while(FindNextFileW(find, &findData));
+
+  FindClose(find);
+
+  return ret;
+}
+
 WindowingData DisplayRemoteServerPreview(bool active, const rdcarray<WindowingSystem> &systems)
 {
   static WindowingData remoteServerPreview = {WindowingSystem::Unknown};